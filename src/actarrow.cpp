@@ -274,16 +274,17 @@ void actArrow(Entity* my)
 			Entity* parent = uidToEntity(my->parent);
 			if ( parent && parent->behavior == &actArrowTrap )
 			{
-				for ( node_t* node = map.creatures->first; node != nullptr; node = node->next )
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my);
+				for ( Entity* nearbyCreature : nearbyCreatures )
 				{
-					entity = (Entity*)node->element;
+					entity = nearbyCreature;
 					if ( entity && (entity->behavior == &actMonster || entity->behavior == &actPlayer) )
 					{
 						if ( entityInsideEntity(my, entity) )
 						{
 							arrowSpawnedInsideEntity = entity;
+							break;
 						}
-						break;
 					}
 				}
 			}
@@ -643,15 +644,20 @@ void actArrow(Entity* my)
 
 						// alert other monsters too
 						Entity* ohitentity = hit.entity;
-						for ( node = map.creatures->first; node != nullptr && alertAllies; node = node->next )
+						std::vector<Entity*> nearbyCreatures;
+						if ( alertAllies )
 						{
-							entity = (Entity*)node->element;
+							nearbyCreatures = CreatureIndex.getCreaturesWithinRange(ohitentity->x, ohitentity->y, 1024);
+						}
+						for ( Entity* nearbyCreature : nearbyCreatures )
+						{
+							entity = nearbyCreature;
 							if ( entity && entity->behavior == &actMonster && entity != ohitentity )
 							{
 								Stat* buddystats = entity->getStats();
 								if ( buddystats != nullptr )
 								{
-									if ( entity->checkFriend(hit.entity) )
+									if ( entity->checkFriend(ohitentity) )
 									{
 										if ( entity->monsterState == MONSTER_STATE_WAIT ) // monster is waiting
 										{
@@ -17,6 +17,7 @@
 #include "collision.hpp"
 #include "items.hpp"
 #include "net.hpp"
+#include "player.hpp"
 
 /*-------------------------------------------------------------------------------
 
@@ -151,10 +152,10 @@ void actArrowTrap(Entity* my)
 			}
 			ARROWTRAP_REFIRE = 0;
 			// misfire from a lockpick, try to find a nearby target.
-			for ( node_t* node = map.creatures->first; node != nullptr; node = node->next )
+			for ( int i = 0; i < MAXPLAYERS; ++i )
 			{
-				Entity* entity = (Entity*)node->element;
-				if ( entity && entity->behavior == &actPlayer && entityDist(my, entity) < TOUCHRANGE )
+				Entity* entity = players[i] ? players[i]->entity : nullptr;
+				if ( entity && entityDist(my, entity) < TOUCHRANGE )
 				{
 					targetToAutoHit = entity;
 					break;
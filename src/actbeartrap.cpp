@@ -99,10 +99,9 @@ void actBeartrap(Entity* my)
 	}
 
 	// launch beartrap
-	node_t* node;
-	for ( node = map.creatures->first; node != nullptr; node = node->next )
+	std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(my->x, my->y, 6.5);
+	for ( Entity* entity : nearbyCreatures )
 	{
-		Entity* entity = (Entity*)node->element;
 		if ( my->parent == entity->getUID() )
 		{
 			continue;
@@ -447,6 +447,7 @@ void actFountain(Entity* my)
 								}
 								stats[i]->mask->beatitude++;
 							}
+							stats[i]->invalidateDerivedStats();
 							if ( multiplayer == SERVER && i > 0 )
 							{
 								strcpy((char*)net_packet->data, "BLES");
@@ -531,6 +532,7 @@ void actFountain(Entity* my)
 									}
 								}
 								chosen.first->beatitude++;
+								stats[i]->invalidateDerivedStats();
 
 								if ( multiplayer == SERVER && i > 0 )
 								{
@@ -1274,9 +1274,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -1317,9 +1317,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -1401,6 +1401,7 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				int y2 = (result >> 24) & 0xFF;
 				if ( processOnAttachedEntity )
 				{
+					std::vector<Entity*> regionTargets = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
 					for ( auto entity : attachedEntities )
 					{
 						if ( entity->behavior != &actMonster )
@@ -1411,9 +1412,8 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 						real_t dist = 10000.f;
 						real_t sightrange = 256.0;
 						Entity* toAttack = nullptr;
-						for ( node_t* node = map.creatures->first; node; node = node->next )
+						for ( Entity* target : regionTargets )
 						{
-							Entity* target = (Entity*)node->element;
 							if ( (target->behavior == &actMonster || target->behavior == &actPlayer) && target != entity
 								&& entity->checkEnemy(target) )
 							{
@@ -1477,9 +1477,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -1520,9 +1520,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster && !entity->monsterAllyGetPlayerLeader() )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -1566,9 +1566,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster && !entity->monsterAllyGetPlayerLeader() )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -1676,9 +1676,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster && !entity->monsterAllyGetPlayerLeader() )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -1726,9 +1726,9 @@ void TextSourceScript::handleTextSourceScript(Entity& src, std::string input)
 				}
 				else
 				{
-					for ( node_t* node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> regionCreatures = CreatureIndex.getCreaturesOnTiles(x1, y1, x2, y2);
+					for ( Entity* entity : regionCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster && !entity->monsterAllyGetPlayerLeader() )
 						{
 							int findx = static_cast<int>(entity->x) >> 4;
@@ -62,10 +62,9 @@ void actItem(Entity* my)
 				}
 				else
 				{
-					node_t* node;
-					for ( node = map.creatures->first; node != nullptr; node = node->next )
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my);
+					for ( Entity* entity : nearbyCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity->behavior == &actPlayer || entity->behavior == &actMonster )
 						{
 							if ( entityInsideEntity(my, entity) )
@@ -79,10 +78,9 @@ void actItem(Entity* my)
 			}
 			else
 			{
-				node_t* node;
-				for ( node = map.creatures->first; node != nullptr; node = node->next )
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my);
+				for ( Entity* entity : nearbyCreatures )
 				{
-					Entity* entity = (Entity*)node->element;
 					if ( entity->behavior == &actPlayer || entity->behavior == &actMonster )
 					{
 						if ( entityInsideEntity(my, entity) )
@@ -378,21 +378,10 @@ void actWinningPortal(Entity* my)
 					return; // classic mode disabled.
 				}
 			}
-			node_t* node;
-			for ( node = map.creatures->first; node != nullptr; node = node->next )
+			Entity* lastMonster = nullptr;
+			if ( numMonsterTypeAliveOnMap(LICH, lastMonster) > 0 || numMonsterTypeAliveOnMap(DEVIL, lastMonster) > 0 )
 			{
-				Entity* entity = (Entity*)node->element;
-				if ( entity->behavior == &actMonster )
-				{
-					Stat* stats = entity->getStats();
-					if ( stats )
-					{
-						if ( stats->type == LICH || stats->type == DEVIL )
-						{
-							return;
-						}
-					}
-				}
+				return;
 			}
 			if ( my->skill[28] != 0 )
 			{
@@ -532,24 +521,10 @@ void Entity::actExpansionEndGamePortal()
 	{
 		if ( flags[INVISIBLE] )
 		{
-			node_t* node;
-			for ( node = map.creatures->first; node != nullptr; node = node->next )
+			Entity* lastMonster = nullptr;
+			if ( numMonsterTypeAliveOnMap(LICH_FIRE, lastMonster) > 0 || numMonsterTypeAliveOnMap(LICH_ICE, lastMonster) > 0 )
 			{
-				Entity* entity = (Entity*)node->element;
-				if ( entity )
-				{
-					if ( entity->behavior == &actMonster )
-					{
-						Stat* stats = entity->getStats();
-						if ( stats )
-						{
-							if ( stats->type == LICH_FIRE || stats->type == LICH_ICE )
-							{
-								return;
-							}
-						}
-					}
-				}
+				return;
 			}
 			if ( circuit_status != 0 )
 			{
@@ -684,24 +659,10 @@ void Entity::actMidGamePortal()
 					return; // classic mode enabled, don't process.
 				}
 			}
-			node_t* node;
-			for ( node = map.creatures->first; node != nullptr; node = node->next )
+			Entity* lastMonster = nullptr;
+			if ( numMonsterTypeAliveOnMap(LICH, lastMonster) > 0 || numMonsterTypeAliveOnMap(DEVIL, lastMonster) > 0 )
 			{
-				Entity* entity = (Entity*)node->element;
-				if ( entity )
-				{
-					if ( entity->behavior == &actMonster )
-					{
-						Stat* stats = entity->getStats();
-						if ( stats )
-						{
-							if ( stats->type == LICH || stats->type == DEVIL )
-							{
-								return;
-							}
-						}
-					}
-				}
+				return;
 			}
 			if ( circuit_status != 0 )
 			{
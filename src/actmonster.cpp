@@ -27,6 +27,7 @@
 #include "colors.hpp"
 #include "scores.hpp"
 #include "mod_tools.hpp"
+#include "line_of_sight.hpp"
 
 float limbs[NUMMONSTERS][20][3];
 
@@ -1196,6 +1197,40 @@ void sentrybotPickSpotNoise(Entity* my, Stat* myStats)
 	}
 }
 
+// for allies with nothing to do: the nearest hostile monster in sight range that my can see, or nullptr.
+// closest first, so the line traces stop at the first one in view. tangent is set to its direction
+static Entity* monsterAllyScanForEnemy(Entity* my, Stat* myStats, double& tangent)
+{
+	const real_t range = sightranges[myStats->type];
+	std::vector<std::pair<real_t, Entity*>> enemies;
+	std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(my->x, my->y, range);
+	for ( Entity* target : nearbyCreatures )
+	{
+		if ( target->behavior == &actMonster && my->checkEnemy(target) )
+		{
+			real_t dist = sqrt(pow(my->x - target->x, 2) + pow(my->y - target->y, 2));
+			if ( dist < range )
+			{
+				enemies.push_back(std::make_pair(dist, target));
+			}
+		}
+	}
+	std::stable_sort(enemies.begin(), enemies.end(), [](const std::pair<real_t, Entity*>& a, const std::pair<real_t, Entity*>& b)
+	{
+		return a.first < b.first;
+	});
+	for ( auto& enemy : enemies )
+	{
+		tangent = atan2(enemy.second->y - my->y, enemy.second->x - my->x);
+		lineTrace(my, my->x, my->y, tangent, range, 0, false);
+		if ( hit.entity == enemy.second )
+		{
+			return enemy.second;
+		}
+	}
+	return nullptr;
+}
+
 void actMonster(Entity* my)
 {
 	if (!my)
@@ -2286,10 +2321,10 @@ void actMonster(Entity* my)
 				my->monsterLichFireMeleeSeq = 0;
 				// acquire a new target.
 				lichDist = 1024;
-				for ( node = map.creatures->first; node != nullptr; node = node->next ) //Only creatures need to be targetted.
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Only players need to be targetted.
 				{
-					Entity* tempEntity = (Entity*)node->element;
-					if ( tempEntity->behavior == &actPlayer 
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
+					if ( tempEntity
 						&& (sqrt(pow(my->x - tempEntity->x, 2) + pow(my->y - tempEntity->y, 2)) < lichDist)
 						)
 					{
@@ -2314,10 +2349,10 @@ void actMonster(Entity* my)
 				my->monsterLichFireMeleeSeq = 0;
 				// acquire a new target.
 				lichDist = 1024;
-				for ( node = map.creatures->first; node != nullptr; node = node->next ) //Only creatures need to be targetted.
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Only players need to be targetted.
 				{
-					Entity* tempEntity = (Entity*)node->element;
-					if ( tempEntity && tempEntity->behavior == &actPlayer
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
+					if ( tempEntity
 						&& (sqrt(pow(my->x - tempEntity->x, 2) + pow(my->y - tempEntity->y, 2)) < lichDist)
 						)
 					{
@@ -2342,6 +2377,7 @@ void actMonster(Entity* my)
 	if ( !intro )
 	{
 		my->handleEffects(myStats);
+		myStats->invalidateDerivedStats(); // effect timers may have run out
 	}
 	if ( myStats->HP <= 0
 		&& my->monsterState != MONSTER_STATE_LICH_DEATH
@@ -2903,15 +2939,15 @@ void actMonster(Entity* my)
 	Entity* ringConflictHolder = nullptr;
 	if ( myStats->type != LICH_ICE && myStats->type != LICH_FIRE )
 	{
-		for ( node = map.creatures->first; node != nullptr; node = node->next ) //Only creatures can wear rings, so don't search map.entities.
+		int conflictRange = 5 * TOUCHRANGE;
+		std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(my->x, my->y, conflictRange); //Only creatures can wear rings, so don't search map.entities.
+		for ( Entity* tempentity : nearbyCreatures )
 		{
-			Entity* tempentity = (Entity*)node->element;
 			if ( tempentity != nullptr && tempentity != my )
 			{
 				Stat* tempstats = tempentity->getStats();
 				if ( tempstats && tempstats->ring && tempstats->ring->type == RING_CONFLICT )
 				{
-					int conflictRange = 5 * TOUCHRANGE;
 					if ( sqrt(pow(my->x - tempentity->x, 2) + pow(my->y - tempentity->y, 2)) < conflictRange )
 					{
 						tangent = atan2(tempentity->y - my->y, tempentity->x - my->x);
@@ -3419,6 +3455,15 @@ void actMonster(Entity* my)
 		//		state_string.c_str(), my->monsterAttack, my->monsterHitTime, MONSTER_ATTACKTIME, devilstate, devilacted, my->monsterSpecialTimer); //Debug message.
 		//}
 
+		// idle monsters far from the players think less often, see MonsterAILODHandler
+		int thinkInterval = 1;
+		bool myThink = MonsterAILOD.think(*my, *myStats, thinkInterval);
+		if ( myReflex && thinkInterval > 1 )
+		{
+			// reflexes are already once a second, spread them to once every thinkInterval seconds
+			myReflex = ((ticks / TICKS_PER_SECOND) + my->getUID()) % thinkInterval == 0;
+		}
+
 		//Begin state machine
 		if ( my->monsterState == MONSTER_STATE_WAIT ) //Begin wait state
 		{
@@ -3456,9 +3501,10 @@ void actMonster(Entity* my)
 					}
 				}
 
-				for ( node2 = map.creatures->first; node2 != nullptr; node2 = node2->next ) //So my concern is that this never explicitly checks for actMonster or actPlayer, instead it relies on there being stats. Now, only monsters and players have stats, so that's not a problem, except...actPlayerLimb can still return a stat from getStat()! D: Meh, if you can find the player's hand, you can find the actual player too, so it shouldn't be an issue.
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(my->x, my->y, sightranges[myStats->type]);
+				for ( Entity* nearbyCreature : nearbyCreatures ) //So my concern is that this never explicitly checks for actMonster or actPlayer, instead it relies on there being stats. Now, only monsters and players have stats, so that's not a problem, except...actPlayerLimb can still return a stat from getStat()! D: Meh, if you can find the player's hand, you can find the actual player too, so it shouldn't be an issue.
 				{
-					entity = (Entity*)node2->element;
+					entity = nearbyCreature;
 					if ( entity == my || entity->flags[PASSABLE] )
 					{
 						continue;
@@ -3504,6 +3550,10 @@ void actMonster(Entity* my)
 							}
 							if ( targetdist > TOUCHRANGE && targetdist > light )
 							{
+								if ( !LineOfSight.maySee(my->x, my->y, *entity) )
+								{
+									continue;
+								}
 								if ( !levitating )
 								{
 									lineTrace(my, my->x, my->y, tangent, monsterVisionRange, 0, true);
@@ -3543,7 +3593,7 @@ void actMonster(Entity* my)
 								}
 							}
 
-							if ( visiontest )   // vision cone
+							if ( visiontest && LineOfSight.maySee(my->x, my->y, *entity) )   // vision cone
 							{
 								if ( (myStats->type >= LICH && myStats->type < KOBOLD) || myStats->type == LICH_FIRE || myStats->type == LICH_ICE || myStats->type == SHADOW )
 								{
@@ -3604,9 +3654,10 @@ void actMonster(Entity* my)
 									}
 
 									// alert other monsters of this enemy's presence //TODO: Refactor into its own function.
-									for ( node = map.creatures->first; node != nullptr; node = node->next )
+									std::vector<Entity*> nearbyFriends = CreatureIndex.getCreaturesWithinRange(my->x, my->y, monsterVisionRange);
+									for ( Entity* nearbyFriend : nearbyFriends )
 									{
-										entity = (Entity*)node->element;
+										entity = nearbyFriend;
 										if ( entity->behavior == &actMonster )
 										{
 											hitstats = entity->getStats();
@@ -3816,8 +3867,12 @@ void actMonster(Entity* my)
 			}
 
 			// look
-			my->monsterLookTime++;
-			if ( my->monsterLookTime >= 120 
+			if ( myThink )
+			{
+				my->monsterLookTime += thinkInterval;
+			}
+			if ( myThink
+				&& my->monsterLookTime >= 120 
 				&& myStats->type != LICH 
 				&& myStats->type != DEVIL
 				&& myStats->type != LICH_FIRE
@@ -3853,32 +3908,17 @@ void actMonster(Entity* my)
 					}
 					else
 					{
-						real_t dist = sightranges[myStats->type];
-						for ( node = map.creatures->first; node != nullptr; node = node->next )
+						double tangent = 0.0;
+						if ( monsterAllyScanForEnemy(my, myStats, tangent) )
 						{
-							Entity* target = (Entity*)node->element;
-							if ( target->behavior == &actMonster && my->checkEnemy(target) )
+							//my->monsterLookTime = 1;
+							//my->monsterMoveTime = rand() % 10 + 1;
+							my->monsterLookDir = tangent;
+							if ( monsterIsImmobileTurret(my, myStats) )
 							{
-								real_t oldDist = dist;
-								dist = sqrt(pow(my->x - target->x, 2) + pow(my->y - target->y, 2));
-								if ( dist < sightranges[myStats->type] && dist <= oldDist )
+								if ( myStats->LVL >= 10 )
 								{
-									double tangent = atan2(target->y - my->y, target->x - my->x);
-									lineTrace(my, my->x, my->y, tangent, sightranges[myStats->type], 0, false);
-									if ( hit.entity == target )
-									{
-										//my->monsterLookTime = 1;
-										//my->monsterMoveTime = rand() % 10 + 1;
-										my->monsterLookDir = tangent;
-										if ( monsterIsImmobileTurret(my, myStats) )
-										{
-											if ( myStats->LVL >= 10 )
-											{
-												my->monsterHitTime = HITRATE * 2 - 20;
-											}
-										}
-										break;
-									}
+									my->monsterHitTime = HITRATE * 2 - 20;
 								}
 							}
 						}
@@ -3914,7 +3954,8 @@ void actMonster(Entity* my)
 					}
 				}
 			}
-			if ( my->monsterMoveTime == 0 
+			if ( myThink
+				&& my->monsterMoveTime == 0 
 				&& (uidToEntity(myStats->leader_uid) == NULL || my->monsterAllyState == ALLY_STATE_DEFEND)
 				&& !myStats->EFFECTS[EFF_FEAR] 
 				&& !myStats->EFFECTS[EFF_DISORIENTED]
@@ -4849,9 +4890,10 @@ timeToGoAgain:
 
 			if ( myReflex && (myStats->type != LICH || my->monsterSpecialTimer <= 0) )
 			{
-				for ( node2 = map.creatures->first; node2 != nullptr; node2 = node2->next ) //Stats only exist on a creature, so don't iterate all map.entities.
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(my->x, my->y, sightranges[myStats->type]);
+				for ( Entity* nearbyCreature : nearbyCreatures ) //Stats only exist on a creature, so don't iterate all map.entities.
 				{
-					entity = (Entity*)node2->element;
+					entity = nearbyCreature;
 					if ( entity == my || entity->flags[PASSABLE] )
 					{
 						continue;
@@ -4893,6 +4935,10 @@ timeToGoAgain:
 							}
 							if ( targetdist > TOUCHRANGE && targetdist > light )
 							{
+								if ( !LineOfSight.maySee(my->x, my->y, *entity) )
+								{
+									continue;
+								}
 								if ( !levitating )
 								{
 									lineTrace(my, my->x, my->y, tangent, monsterVisionRange, 0, true);
@@ -4942,7 +4988,7 @@ timeToGoAgain:
 									visiontest = true;
 								}
 							}
-							if ( visiontest )   // vision cone
+							if ( visiontest && LineOfSight.maySee(my->x + 1, my->y, *entity) )   // vision cone
 							{
 								lineTrace(my, my->x + 1, my->y, tangent, monsterVisionRange, 0, (levitating == false));
 								if ( hit.entity == entity )
@@ -5682,27 +5728,12 @@ timeToGoAgain:
 							{
 								//messagePlayer(0, "Sent a move to command, defending here!");
 								// scan for enemies after reaching move point.
-								real_t dist = sightranges[myStats->type];
-								for ( node = map.creatures->first; node != nullptr; node = node->next )
+								double tangent = 0.0;
+								if ( monsterAllyScanForEnemy(my, myStats, tangent) )
 								{
-									Entity* target = (Entity*)node->element;
-									if ( target->behavior == &actMonster && my->checkEnemy(target) )
-									{
-										real_t oldDist = dist;
-										dist = sqrt(pow(my->x - target->x, 2) + pow(my->y - target->y, 2));
-										if ( dist < sightranges[myStats->type] && dist <= oldDist )
-										{
-											double tangent = atan2(target->y - my->y, target->x - my->x);
-											lineTrace(my, my->x, my->y, tangent, sightranges[myStats->type], 0, false);
-											if ( hit.entity == target )
-											{
-												my->monsterLookTime = 1;
-												my->monsterMoveTime = rand() % 10 + 1;
-												my->monsterLookDir = tangent;
-												break;
-											}
-										}
-									}
+									my->monsterLookTime = 1;
+									my->monsterMoveTime = rand() % 10 + 1;
+									my->monsterLookDir = tangent;
 								}
 								my->monsterAllyState = ALLY_STATE_DEFEND;
 								my->createPathBoundariesNPC(5);
@@ -5718,27 +5749,12 @@ timeToGoAgain:
 						else if ( !target && my->monsterAllyGetPlayerLeader() )
 						{
 							// scan for enemies after reaching move point.
-							real_t dist = sightranges[myStats->type];
-							for ( node = map.creatures->first; node != nullptr; node = node->next )
+							double tangent = 0.0;
+							if ( monsterAllyScanForEnemy(my, myStats, tangent) )
 							{
-								Entity* target = (Entity*)node->element;
-								if ( target->behavior == &actMonster && my->checkEnemy(target) )
-								{
-									real_t oldDist = dist;
-									dist = sqrt(pow(my->x - target->x, 2) + pow(my->y - target->y, 2));
-									if ( dist < sightranges[myStats->type] && dist <= oldDist )
-									{
-										double tangent = atan2(target->y - my->y, target->x - my->x);
-										lineTrace(my, my->x, my->y, tangent, sightranges[myStats->type], 0, false);
-										if ( hit.entity == target )
-										{
-											my->monsterLookTime = 1;
-											my->monsterMoveTime = rand() % 10 + 1;
-											my->monsterLookDir = tangent;
-											break;
-										}
-									}
-								}
+								my->monsterLookTime = 1;
+								my->monsterMoveTime = rand() % 10 + 1;
+								my->monsterLookDir = tangent;
 							}
 						}
 					}
@@ -5808,27 +5824,12 @@ timeToGoAgain:
 						{
 							//messagePlayer(0, "Issued move command, defending here.");
 							// scan for enemies after reaching move point.
-							real_t dist = sightranges[myStats->type];
-							for ( node = map.creatures->first; node != nullptr; node = node->next )
+							double tangent = 0.0;
+							if ( monsterAllyScanForEnemy(my, myStats, tangent) )
 							{
-								Entity* target = (Entity*)node->element;
-								if ( target->behavior == &actMonster && my->checkEnemy(target) )
-								{
-									real_t oldDist = dist;
-									dist = sqrt(pow(my->x - target->x, 2) + pow(my->y - target->y, 2));
-									if ( dist < sightranges[myStats->type] && dist <= oldDist )
-									{
-										double tangent = atan2(target->y - my->y, target->x - my->x);
-										lineTrace(my, my->x, my->y, tangent, sightranges[myStats->type], 0, false);
-										if ( hit.entity == target )
-										{
-											my->monsterLookTime = 1;
-											my->monsterMoveTime = rand() % 10 + 1;
-											my->monsterLookDir = tangent;
-											break;
-										}
-									}
-								}
+								my->monsterLookTime = 1;
+								my->monsterMoveTime = rand() % 10 + 1;
+								my->monsterLookDir = tangent;
 							}
 							my->monsterAllyState = ALLY_STATE_DEFEND;
 							my->createPathBoundariesNPC(5);
@@ -6253,10 +6254,9 @@ timeToGoAgain:
 					{
 						my->flags[PASSABLE] = false;
 					}
-					node_t* node;
-					for ( node = map.creatures->first; node != nullptr; node = node->next ) //Since it only looks at entities that have stats, only creatures can have stats; don't iterate map.entities.
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my); //Since it only looks at entities that have stats, only creatures can have stats; don't iterate map.entities.
+					for ( Entity* entity : nearbyCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity == my )
 						{
 							continue;
@@ -6305,13 +6305,12 @@ timeToGoAgain:
 			}
 			else
 			{
-				node_t* tempNode;
 				Entity* playertotrack = nullptr;
-				for ( tempNode = map.creatures->first; tempNode != nullptr; tempNode = tempNode->next ) //Only inspects players, so don't iterate map.entities.
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Only inspects players.
 				{
-					Entity* tempEntity = (Entity*)tempNode->element;
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
 					double lowestdist = 5000;
-					if ( tempEntity->behavior == &actPlayer )
+					if ( tempEntity )
 					{
 						double disttoplayer = entityDist(my, tempEntity);
 						if ( disttoplayer < lowestdist )
@@ -6449,13 +6448,12 @@ timeToGoAgain:
 				serverUpdateEntitySkill(my, 9);
 				my->monsterSpecialTimer = 0;
 				my->monsterState = MONSTER_STATE_ATTACK;
-				node_t* tempNode;
 				Entity* playertotrack = nullptr;
-				for ( tempNode = map.creatures->first; tempNode != nullptr; tempNode = tempNode->next ) //Only inspects players, so don't iterate map.entities. Technically, only needs to iterate through the players[] array, eh?
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Only inspects players.
 				{
-					Entity* tempEntity = (Entity*)tempNode->element;
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
 					double lowestdist = 5000;
-					if ( tempEntity->behavior == &actPlayer )
+					if ( tempEntity )
 					{
 						double disttoplayer = entityDist(my, tempEntity);
 						if ( disttoplayer < lowestdist )
@@ -6758,13 +6756,12 @@ timeToGoAgain:
 				serverUpdateEntitySkill(my, 9);
 				my->monsterSpecialTimer = 0;
 				my->monsterState = MONSTER_STATE_ATTACK;
-				node_t* tempNode;
 				Entity* playertotrack = nullptr;
-				for ( tempNode = map.creatures->first; tempNode != nullptr; tempNode = tempNode->next ) //Iterate map.creatures, since only inspecting players, not all entities. Technically should just iterate over players[]?
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Only inspects players.
 				{
-					Entity* tempEntity = (Entity*)tempNode->element;
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
 					double lowestdist = 5000;
-					if ( tempEntity->behavior == &actPlayer )
+					if ( tempEntity )
 					{
 						double disttoplayer = entityDist(my, tempEntity);
 						if ( disttoplayer < lowestdist )
@@ -8627,13 +8624,13 @@ bool Entity::handleMonsterSpecialAttack(Stat* myStats, Entity* target, double di
 void getTargetsAroundEntity(Entity* my, Entity* originalTarget, double distToFind, real_t angleToSearch, int searchType, list_t** list)
 {
 	Entity* entity = nullptr;
-	node_t* node = nullptr;
 	node_t* node2 = nullptr;
 
 	// aoe
-	for ( node = map.creatures->first; node != nullptr; node = node->next ) //Only looks at monsters and players, don't iterate all entities (map.entities).
+	std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesInCone(my->x, my->y, distToFind, my->yaw, angleToSearch);
+	for ( Entity* nearbyCreature : nearbyCreatures ) //Only looks at monsters and players, don't iterate all entities (map.entities).
 	{
-		entity = (Entity*)node->element;
+		entity = nearbyCreature;
 		if ( (entity->behavior == &actMonster || entity->behavior == &actPlayer) && entity != originalTarget && entity != my )
 		{
 			if ( searchType == MONSTER_TARGET_ENEMY )
@@ -8777,22 +8774,348 @@ bool handleMonsterChatter(int monsterclicked, bool ringconflict, char namesays[6
 
 int numMonsterTypeAliveOnMap(Monster creature, Entity*& lastMonster)
 {
-	node_t* node = nullptr;
-	Entity* entity = nullptr;
-	int monsterCount = 0;
-	for ( node = map.creatures->first; node != nullptr; node = node->next )
+	return CreatureIndex.getNumMonsterType(creature, lastMonster);
+}
+
+list_t* CreatureIndexHandler::getCellList(real_t x, real_t y)
+{
+	int i = std::min(std::max(static_cast<int>(floor(x / kCellSize)), 0), kGridDimension - 1);
+	int j = std::min(std::max(static_cast<int>(floor(y / kCellSize)), 0), kGridDimension - 1);
+	return &gridCreatures[i][j];
+}
+
+node_t* CreatureIndexHandler::addEntity(Entity& entity)
+{
+	if ( entity.myCreatureGridNode )
+	{
+		return nullptr;
+	}
+
+	entity.myCreatureGridNode = list_AddNodeLast(getCellList(entity.x, entity.y));
+	entity.myCreatureGridNode->element = &entity;
+	entity.myCreatureGridNode->deconstructor = &emptyDeconstructor;
+	entity.myCreatureGridNode->size = sizeof(Entity);
+	return entity.myCreatureGridNode;
+}
+
+node_t* CreatureIndexHandler::updateEntity(Entity& entity)
+{
+	if ( !entity.myCreatureGridNode )
+	{
+		return nullptr;
+	}
+
+	list_t* cell = getCellList(entity.x, entity.y);
+	if ( entity.myCreatureGridNode->list == cell )
+	{
+		return entity.myCreatureGridNode;
+	}
+	list_RemoveNode(entity.myCreatureGridNode);
+	entity.myCreatureGridNode = list_AddNodeLast(cell);
+	entity.myCreatureGridNode->element = &entity;
+	entity.myCreatureGridNode->deconstructor = &emptyDeconstructor;
+	entity.myCreatureGridNode->size = sizeof(Entity);
+	return entity.myCreatureGridNode;
+}
+
+void CreatureIndexHandler::removeEntity(Entity& entity)
+{
+	if ( entity.myCreatureGridNode )
+	{
+		list_RemoveNode(entity.myCreatureGridNode);
+		entity.myCreatureGridNode = nullptr;
+	}
+}
+
+bool CreatureIndexHandler::useGrid() const
+{
+	return multiplayer != CLIENT;
+}
+
+void CreatureIndexHandler::addAllCreatures(std::vector<Entity*>& creatures)
+{
+	for ( node_t* node = map.creatures->first; node != nullptr; node = node->next )
+	{
+		creatures.push_back((Entity*)node->element);
+	}
+}
+
+void CreatureIndexHandler::addCellRange(std::vector<Entity*>& creatures, int x1, int y1, int x2, int y2)
+{
+	x1 = std::max(x1, 0);
+	x2 = std::min(x2, kGridDimension - 1);
+	y1 = std::max(y1, 0);
+	y2 = std::min(y2, kGridDimension - 1);
+	for ( int i = x1; i <= x2; ++i )
+	{
+		for ( int j = y1; j <= y2; ++j )
+		{
+			for ( node_t* node = gridCreatures[i][j].first; node != nullptr; node = node->next )
+			{
+				creatures.push_back((Entity*)node->element);
+			}
+		}
+	}
+}
+
+std::vector<Entity*> CreatureIndexHandler::getCreaturesWithinRange(real_t x, real_t y, real_t range)
+{
+	std::vector<Entity*> creatures;
+	if ( !useGrid() )
+	{
+		addAllCreatures(creatures);
+		return creatures;
+	}
+
+	range += kCellMargin;
+	addCellRange(creatures,
+		static_cast<int>(floor((x - range) / kCellSize)), static_cast<int>(floor((y - range) / kCellSize)),
+		static_cast<int>(floor((x + range) / kCellSize)), static_cast<int>(floor((y + range) / kCellSize)));
+	return creatures;
+}
+
+std::vector<Entity*> CreatureIndexHandler::getCreaturesInCone(real_t x, real_t y, real_t range, real_t yaw, real_t halfAngle)
+{
+	std::vector<Entity*> creatures = getCreaturesWithinRange(x, y, range);
+	auto outside = [&](Entity* entity)
 	{
-		entity = (Entity*)node->element;
+		if ( !entity )
+		{
+			return true;
+		}
+		real_t dx = entity->x - x;
+		real_t dy = entity->y - y;
+		if ( dx * dx + dy * dy > range * range )
+		{
+			return true;
+		}
+		if ( halfAngle >= PI || (dx == 0 && dy == 0) )
+		{
+			return false;
+		}
+		real_t angle = yaw - atan2(dy, dx);
+		while ( angle >= PI )
+		{
+			angle -= PI * 2;
+		}
+		while ( angle < -PI )
+		{
+			angle += PI * 2;
+		}
+		return abs(angle) > halfAngle;
+	};
+	creatures.erase(std::remove_if(creatures.begin(), creatures.end(), outside), creatures.end());
+	return creatures;
+}
+
+std::vector<Entity*> CreatureIndexHandler::getCreaturesOnTiles(int x1, int y1, int x2, int y2)
+{
+	std::vector<Entity*> creatures;
+	if ( !useGrid() )
+	{
+		addAllCreatures(creatures);
+		return creatures;
+	}
+
+	// tiles are 16 units, widened by the margin for creatures pushed out of their cell
+	addCellRange(creatures,
+		(x1 * 16 - kCellMargin) / kCellSize, (y1 * 16 - kCellMargin) / kCellSize,
+		((x2 + 1) * 16 + kCellMargin) / kCellSize, ((y2 + 1) * 16 + kCellMargin) / kCellSize);
+	return creatures;
+}
+
+std::vector<Entity*> CreatureIndexHandler::getCreaturesTouching(Entity& entity)
+{
+	std::vector<Entity*> creatures;
+	if ( !useGrid() )
+	{
+		addAllCreatures(creatures);
+		return creatures;
+	}
+
+	real_t reachx = entity.sizex + kMaxCreatureSize + kCellMargin;
+	real_t reachy = entity.sizey + kMaxCreatureSize + kCellMargin;
+	addCellRange(creatures,
+		static_cast<int>(floor((entity.x - reachx) / kCellSize)), static_cast<int>(floor((entity.y - reachy) / kCellSize)),
+		static_cast<int>(floor((entity.x + reachx) / kCellSize)), static_cast<int>(floor((entity.y + reachy) / kCellSize)));
+	return creatures;
+}
+
+void CreatureIndexHandler::rebuildRaceCounts()
+{
+	for ( int c = 0; c < NUMMONSTERS; ++c )
+	{
+		raceCount[c] = 0;
+		raceLastEntity[c] = nullptr;
+	}
+	for ( node_t* node = map.creatures->first; node != nullptr; node = node->next )
+	{
+		Entity* entity = (Entity*)node->element;
 		if ( entity )
 		{
-			if ( entity->getRace() == creature )
+			Monster race = entity->getRace();
+			if ( race >= 0 && race < NUMMONSTERS )
+			{
+				raceLastEntity[race] = entity;
+				++raceCount[race];
+			}
+		}
+	}
+	raceCountDirty = false;
+	raceCountTick = ticks;
+}
+
+int CreatureIndexHandler::getNumMonsterType(Monster creature, Entity*& lastMonster)
+{
+	if ( creature < 0 || creature >= NUMMONSTERS )
+	{
+		return 0;
+	}
+	if ( raceCountDirty || raceCountTick != ticks )
+	{
+		// races can change under polymorph without touching map.creatures, so never trust counts from an older tick.
+		rebuildRaceCounts();
+	}
+	if ( raceLastEntity[creature] )
+	{
+		lastMonster = raceLastEntity[creature];
+	}
+	return raceCount[creature];
+}
+
+int MonsterAILODHandler::getThinkInterval(Entity& my, Stat& myStats)
+{
+	if ( !enabled || multiplayer == CLIENT )
+	{
+		return 1;
+	}
+	if ( my.monsterState != MONSTER_STATE_WAIT
+		|| my.monsterTarget != 0
+		|| myStats.leader_uid != 0
+		|| myStats.EFFECTS[EFF_KNOCKBACK]
+		|| myStats.EFFECTS[EFF_FEAR]
+		|| myStats.EFFECTS[EFF_DISORIENTED] )
+	{
+		return 1;
+	}
+	switch ( myStats.type )
+	{
+		// these chase players across the map from the wait state
+		case MINOTAUR:
+		case LICH:
+		case LICH_FIRE:
+		case LICH_ICE:
+		case DEVIL:
+		case SHADOW:
+			return 1;
+		case AUTOMATON:
+			if ( strstr(myStats.name, "corrupted automaton") )
+			{
+				return 1;
+			}
+			break;
+		default:
+			break;
+	}
+	if ( strstr(map.name, "Boss") )
+	{
+		return 1;
+	}
+
+	real_t nearest = -1.0;
+	for ( int c = 0; c < MAXPLAYERS; ++c )
+	{
+		if ( players[c] && players[c]->entity )
+		{
+			real_t dx = players[c]->entity->x - my.x;
+			real_t dy = players[c]->entity->y - my.y;
+			real_t dist = dx * dx + dy * dy;
+			if ( nearest < 0.0 || dist < nearest )
 			{
-				lastMonster = entity;
-				++monsterCount;
+				nearest = dist;
 			}
 		}
 	}
-	return monsterCount;
+	if ( nearest < 0.0 )
+	{
+		return kMaxInterval; // nobody around to notice
+	}
+
+	real_t range = std::max<real_t>(sightranges[myStats.type], kMinAwarenessRange) + kAwarenessMargin;
+	for ( int interval = 1; interval < kMaxInterval; interval *= 2 )
+	{
+		if ( nearest <= range * range * interval * interval )
+		{
+			return interval;
+		}
+	}
+	return kMaxInterval;
+}
+
+void MonsterAILODHandler::countTick()
+{
+	if ( statsTick == ticks )
+	{
+		return;
+	}
+	if ( tickThinks + tickSkips > 0 )
+	{
+		totalThinks += tickThinks;
+		totalSkips += tickSkips;
+		worstTickThinks = std::max(worstTickThinks, tickThinks);
+		++ticksCounted;
+	}
+	tickThinks = 0;
+	tickSkips = 0;
+	statsTick = ticks;
+}
+
+bool MonsterAILODHandler::think(Entity& my, Stat& myStats, int& interval)
+{
+	countTick();
+	interval = getThinkInterval(my, myStats);
+	bool thinks = interval == 1 || (ticks + my.getUID()) % interval == 0;
+	if ( thinks )
+	{
+		++tickThinks;
+	}
+	else
+	{
+		++tickSkips;
+	}
+	++intervalCounts[interval];
+	return thinks;
+}
+
+void MonsterAILODHandler::logStatus()
+{
+	countTick();
+	if ( ticksCounted == 0 )
+	{
+		printlog("[AI]: no monster updates recorded%s", enabled ? "" : ", level of detail disabled");
+		return;
+	}
+	printlog("[AI]: %d ticks: %.2f monsters thinking per tick avg, %d worst, %.2f deferred per tick avg%s",
+		static_cast<int>(ticksCounted), totalThinks / static_cast<double>(ticksCounted), static_cast<int>(worstTickThinks),
+		totalSkips / static_cast<double>(ticksCounted), enabled ? "" : " (level of detail disabled)");
+	printlog("[AI]: think intervals 1: %llu, 2: %llu, 4: %llu, 8: %llu",
+		static_cast<unsigned long long>(intervalCounts[1]), static_cast<unsigned long long>(intervalCounts[2]),
+		static_cast<unsigned long long>(intervalCounts[4]), static_cast<unsigned long long>(intervalCounts[8]));
+}
+
+void MonsterAILODHandler::resetStats()
+{
+	statsTick = ticks;
+	tickThinks = 0;
+	tickSkips = 0;
+	totalThinks = 0;
+	totalSkips = 0;
+	worstTickThinks = 0;
+	ticksCounted = 0;
+	for ( int i = 0; i <= kMaxInterval; ++i )
+	{
+		intervalCounts[i] = 0;
+	}
 }
 
 void Entity::monsterMoveBackwardsAndPath()
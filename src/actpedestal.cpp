@@ -169,6 +169,7 @@ void Entity::actPedestalBase()
 		{
 			circuit_status = CIRCUIT_ON;
 		}
+		CircuitGraph.addPowerable(*this);
 	}
 
 	if ( pedestalHasOrb == pedestalOrbType )
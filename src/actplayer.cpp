@@ -1005,14 +1005,14 @@ void Player::PlayerMovement_t::handlePlayerMovement(bool useRefreshRateDelta)
 		messagePlayer(0, "X: %5.5f, Y: %5.5f", PLAYER_VELX, PLAYER_VELY);
 	}*/
 
-	for ( node_t* node = map.creatures->first; node != nullptr; node = node->next ) //Since looking for players only, don't search full entity list. Best idea would be to directly example players[] though.
+	for ( int c = 0; c < MAXPLAYERS; ++c ) //Looking for players only.
 	{
-		Entity* entity = (Entity*)node->element;
+		Entity* entity = players[c] ? players[c]->entity : nullptr;
 		if ( entity == my )
 		{
 			continue;
 		}
-		if ( entity->behavior == &actPlayer )
+		if ( entity )
 		{
 			if ( entityInsideEntity(my, entity) )
 			{
@@ -4066,6 +4066,7 @@ void actPlayer(Entity* my)
 		if ( !intro )
 		{
 			my->handleEffects(stats[PLAYER_NUM]); // hunger, regaining hp/mp, poison, etc.
+			stats[PLAYER_NUM]->invalidateDerivedStats(); // effect timers may have run out
 			
 			if ( client_disconnected[PLAYER_NUM] || stats[PLAYER_NUM]->HP <= 0 )
 			{
@@ -6283,6 +6284,10 @@ void actPlayerLimb(Entity* my)
 	int i;
 
 	Entity* parent = uidToEntity(my->parent);
+	if ( parent )
+	{
+		my->attachAsLimb();
+	}
 
 	if ( multiplayer == CLIENT )
 	{
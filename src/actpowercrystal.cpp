@@ -303,6 +303,7 @@ void Entity::powerCrystalCreateElectricityNodes()
 		node->size = sizeof(Entity*);
 
 		TileEntityList.addEntity(*entity); // make sure new nodes are added to the tile list to properly update neighbors.
+		CircuitGraph.addPowerable(*entity);
 
 		this->crystalGeneratedElectricityNodes = 1;
 	}
@@ -115,10 +115,9 @@ void actSpearTrap(Entity* my)
 			}
 			else if ( SPEARTRAP_OUTTIME == 1 )
 			{
-				node_t* node;
-				for ( node = map.creatures->first; node != nullptr; node = node->next ) //Searching explicitly for players and monsters, so search only creature list, not map.entities.
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my); //Searching explicitly for players and monsters, so search only creature list, not map.entities.
+				for ( Entity* entity : nearbyCreatures )
 				{
-					Entity* entity = (Entity*)node->element;
 					if ( entity->behavior == &actPlayer || entity->behavior == &actMonster )
 					{
 						Stat* stats = entity->getStats();
@@ -76,10 +76,9 @@ void actThrown(Entity* my)
 				}
 				else
 				{
-					node_t* node;
-					for ( node = map.creatures->first; node != nullptr; node = node->next ) //Since searching for players and monsters, don't search full map.entities.
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my); //Since searching for players and monsters, don't search full map.entities.
+					for ( Entity* entity : nearbyCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity->behavior == &actPlayer || entity->behavior == &actMonster )
 						{
 							if ( entityInsideEntity(my, entity) )
@@ -93,10 +92,9 @@ void actThrown(Entity* my)
 			}
 			else
 			{
-				node_t* node;
-				for ( node = map.creatures->first; node != nullptr; node = node->next ) //Monsters and players? Creature list, not entity list.
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesTouching(*my); //Monsters and players? Creature list, not entity list.
+				for ( Entity* entity : nearbyCreatures )
 				{
-					Entity* entity = (Entity*)node->element;
 					if ( entity->behavior == &actPlayer || entity->behavior == &actMonster )
 					{
 						if ( entityInsideEntity(my, entity) )
@@ -1308,13 +1306,16 @@ void actThrown(Entity* my)
 
 					// alert other monsters too
 					Entity* ohitentity = hit.entity;
-					node_t* node;
-					for ( node = map.creatures->first; node != nullptr && alertAllies && !targetHealed; node = node->next ) //Searching for monsters? Creature list, not entity list.
+					std::vector<Entity*> nearbyCreatures;
+					if ( alertAllies && !targetHealed )
+					{
+						nearbyCreatures = CreatureIndex.getCreaturesWithinRange(ohitentity->x, ohitentity->y, 1024); //Searching for monsters? Creature list, not entity list.
+					}
+					for ( Entity* entity : nearbyCreatures )
 					{
-						Entity* entity = (Entity*)node->element;
 						if ( entity && entity->behavior == &actMonster && entity != ohitentity && entity != polymorphedTarget )
 						{
-							if ( entity->checkFriend(hit.entity) )
+							if ( entity->checkFriend(ohitentity) )
 							{
 								if ( entity->monsterState == MONSTER_STATE_WAIT )
 								{
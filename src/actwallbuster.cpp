@@ -61,7 +61,7 @@ void actWallBuster(Entity* my)
 				sendPacketSafe(net_sock, -1, net_packet, c - 1);
 			}
 		}
-		generatePathMaps();
+		updatePathMaps(x, y);
 		list_RemoveNode(my->mynode);
 	}
 }
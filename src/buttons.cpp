@@ -548,11 +548,7 @@ void buttonNewConfirm(button_t* my)
 			}
 		}
 	}
-	if ( vismap != NULL )
-	{
-		free(vismap);
-	}
-	vismap = (bool*) malloc(sizeof(bool) * map.width * map.height);
+	vismap.resize(map.width, map.height);
 	if ( lightmap != NULL )
 	{
 		free(lightmap);
@@ -971,27 +967,11 @@ void buttonCut(button_t* my)
 void buttonCopy(button_t* my)
 {
 	menuVisible = 0;
-	int x, y;
 
 	// copy the selected tiles
 	if (selectedarea && !pasting)
 	{
-		copymap.width = selectedarea_x2 - selectedarea_x1 + 1;
-		copymap.height = selectedarea_y2 - selectedarea_y1 + 1;
-		if ( copymap.tiles != NULL )
-		{
-			free(copymap.tiles);
-		}
-		copymap.tiles = (Sint32*) malloc(sizeof(Sint32) * copymap.width * copymap.height * MAPLAYERS);
-		memset(copymap.tiles, 0, sizeof(Sint32)*copymap.width * copymap.height * MAPLAYERS);
-		for ( x = 0; x < copymap.width; x++ )
-		{
-			for ( y = 0; y < copymap.height; y++ )
-			{
-				copymap.tiles[drawlayer + y * MAPLAYERS + x * MAPLAYERS * copymap.height] = map.tiles[drawlayer + (y + selectedarea_y1) * MAPLAYERS + (x + selectedarea_x1) * MAPLAYERS * map.height];
-			}
-		}
-		copymap.name[0] = drawlayer;
+		editCopyRegion(selectedarea_x1, selectedarea_y1, selectedarea_x2, selectedarea_y2, drawlayer);
 	}
 	selectedarea = false;
 }
@@ -1023,14 +1003,7 @@ void buttonDelete(button_t* my)
 	if (selectedarea)
 	{
 		// delete all selected tiles
-		int x, y;
-		for ( x = selectedarea_x1; x <= selectedarea_x2; x++ )
-		{
-			for ( y = selectedarea_y1; y <= selectedarea_y2; y++ )
-			{
-				map.tiles[drawlayer + y * MAPLAYERS + x * MAPLAYERS * map.height] = 0;
-			}
-		}
+		editFillRegion(selectedarea_x1, selectedarea_y1, selectedarea_x2, selectedarea_y2, drawlayer, 0);
 		selectedarea = false;
 	}
 }
@@ -1458,11 +1431,7 @@ void buttonAttributesConfirm(button_t* my)
 	map.tiles = (int*) malloc(sizeof(int) * MAPLAYERS * map.height * map.width);
 	strcpy(map.name, nametext);
 	strcpy(map.author, authortext);
-	if ( vismap != NULL )
-	{
-		free(vismap);
-	}
-	vismap = (bool*) malloc(sizeof(bool) * map.width * map.height);
+	vismap.resize(map.width, map.height);
 	if ( lightmap != NULL )
 	{
 		free(lightmap);
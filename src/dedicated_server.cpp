@@ -0,0 +1,415 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: dedicated_server.cpp
+Desc: headless direct-connect host, see -dedicated in main()
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "game.hpp"
+#include "stat.hpp"
+#include "entity.hpp"
+#include "menu.hpp"
+#include "net.hpp"
+#include "player.hpp"
+#include "scores.hpp"
+#include "interface/interface.hpp"
+#include "dedicated_server.hpp"
+#include "net_simulator.hpp"
+
+#include <thread>
+
+DedicatedServer_t DedicatedServer;
+
+// ticks we're allowed to fall behind before dropping them instead of catching up
+static const int kMaxCatchupTicks = 5;
+// leave the last stretch of a sleep to a yield loop, SDL_Delay overshoots by a few ms
+static const double kSpinMarginMs = 2.0;
+
+/*-------------------------------------------------------------------------------
+
+	DedicatedServer_t::openSockets
+
+	does the direct-connect half of buttonHostLobby() without any of the
+	window setup. returns false if the port couldn't be opened.
+
+-------------------------------------------------------------------------------*/
+
+bool DedicatedServer_t::openSockets()
+{
+	closeNetworkInterfaces();
+
+	directConnect = true;
+	multiplayer = SERVER;
+	clientnum = 0;
+	portnumber = port;
+	for ( int c = 0; c < MAXPLAYERS; c++ )
+	{
+		client_disconnected[c] = (c != 0);
+		client_keepalive[c] = ticks;
+	}
+
+	if ( SDLNet_ResolveHost(&net_server, NULL, portnumber) == -1 )
+	{
+		printlog("[DEDICATED]: resolving host at localhost:%d has failed.\n", portnumber);
+		return false;
+	}
+	if ( !(net_sock = SDLNet_UDP_Open(portnumber)) )
+	{
+		printlog("[DEDICATED]: SDLNet_UDP_open has failed: %s\n", SDLNet_GetError());
+		return false;
+	}
+	if ( !(net_tcpsock = SDLNet_TCP_Open(&net_server)) )
+	{
+		printlog("[DEDICATED]: SDLNet_TCP_open has failed: %s\n", SDLNet_GetError());
+		return false;
+	}
+	tcpset = SDLNet_AllocSocketSet(MAXPLAYERS);
+	SDLNet_TCP_AddSocket(tcpset, net_tcpsock);
+
+	net_clients = (IPaddress*) malloc(sizeof(IPaddress) * MAXPLAYERS);
+	net_tcpclients = (TCPsocket*) malloc(sizeof(TCPsocket) * MAXPLAYERS);
+	for ( int c = 0; c < MAXPLAYERS; c++ )
+	{
+		net_tcpclients[c] = NULL;
+	}
+	if ( !(net_packet = SDLNet_AllocPacket(NET_PACKET_SIZE)) )
+	{
+		printlog("[DEDICATED]: packet allocation failed: %s\n", SDLNet_GetError());
+		return false;
+	}
+
+	if ( !strcmp(stats[0]->name, "") )
+	{
+		strcpy(stats[0]->name, "Server");
+	}
+	SafePacketHandler.reset();
+	return true;
+}
+
+int DedicatedServer_t::numConnectedClients() const
+{
+	int result = 0;
+	for ( int c = 1; c < MAXPLAYERS; c++ )
+	{
+		if ( !client_disconnected[c] )
+		{
+			++result;
+		}
+	}
+	return result;
+}
+
+void DedicatedServer_t::broadcastDisconnect(int player)
+{
+	client_disconnected[player] = true;
+	strncpy((char*)(net_packet->data), "PLAYERDISCONNECT", 16);
+	net_packet->data[16] = player;
+	net_packet->len = 17;
+	for ( int c = 1; c < MAXPLAYERS; c++ )
+	{
+		if ( client_disconnected[c] )
+		{
+			continue;
+		}
+		net_packet->address.host = net_clients[c - 1].host;
+		net_packet->address.port = net_clients[c - 1].port;
+		sendPacketSafe(net_sock, -1, net_packet, c - 1);
+	}
+	printlog("[DEDICATED]: player %d left the lobby.\n", player);
+}
+
+/*-------------------------------------------------------------------------------
+
+	DedicatedServer_t::handleLobbyPackets
+
+	the direct-connect subset of the lobby hosting code in handleMainMenu().
+
+-------------------------------------------------------------------------------*/
+
+void DedicatedServer_t::handleLobbyPackets()
+{
+	for ( int numpacket = 0; numpacket < PACKET_LIMIT; numpacket++ )
+	{
+		if ( !SDLNet_UDP_Recv(net_sock, net_packet) )
+		{
+			break;
+		}
+		NetTrafficStats.packetsReceived++;
+		NetTrafficStats.bytesReceived += net_packet->len;
+
+		if ( handleSafePacket() )
+		{
+			continue;
+		}
+		if ( !strncmp((char*)net_packet->data, "BARONY_JOIN_REQUEST", 19) )
+		{
+			int playerNum = MAXPLAYERS;
+			lobbyPlayerJoinRequest(playerNum);
+			if ( playerNum > 0 && playerNum < MAXPLAYERS && !client_disconnected[playerNum] )
+			{
+				client_keepalive[playerNum] = ticks;
+				lastJoinTicks = ticks;
+				printlog("[DEDICATED]: player %d joined (%d/%d).\n", playerNum, numConnectedClients(), playersToStart);
+			}
+		}
+		else if ( !strncmp((char*)net_packet->data, "CMSG", 4) )
+		{
+			for ( int c = 1; c < MAXPLAYERS; c++ )
+			{
+				if ( client_disconnected[c] )
+				{
+					continue;
+				}
+				net_packet->address.host = net_clients[c - 1].host;
+				net_packet->address.port = net_clients[c - 1].port;
+				sendPacketSafe(net_sock, -1, net_packet, c - 1);
+			}
+		}
+		else if ( !strncmp((char*)net_packet->data, "PLAYERDISCONNECT", 16) )
+		{
+			int player = net_packet->data[16];
+			if ( player > 0 && player < MAXPLAYERS )
+			{
+				broadcastDisconnect(player);
+			}
+		}
+		else if ( !strncmp((char*)net_packet->data, "SVFL", 4) )
+		{
+			SDLNet_Write32(svFlags, &net_packet->data[4]);
+			net_packet->len = 8;
+			for ( int c = 1; c < MAXPLAYERS; c++ )
+			{
+				if ( client_disconnected[c] )
+				{
+					continue;
+				}
+				net_packet->address.host = net_clients[c - 1].host;
+				net_packet->address.port = net_clients[c - 1].port;
+				sendPacketSafe(net_sock, -1, net_packet, c - 1);
+			}
+		}
+		else if ( !strncmp((char*)net_packet->data, "KEEPALIVE", 9) )
+		{
+			if ( net_packet->data[9] < MAXPLAYERS )
+			{
+				client_keepalive[net_packet->data[9]] = ticks;
+			}
+		}
+	}
+}
+
+void DedicatedServer_t::checkLobbyTimeouts()
+{
+	for ( int i = 1; i < MAXPLAYERS; i++ )
+	{
+		if ( !client_disconnected[i] && ticks - client_keepalive[i] > TICKS_PER_SECOND * 30 )
+		{
+			broadcastDisconnect(i);
+		}
+	}
+}
+
+void DedicatedServer_t::sendKeepalives()
+{
+	strcpy((char*)net_packet->data, "KEEPALIVE");
+	net_packet->data[9] = clientnum;
+	net_packet->len = 10;
+	for ( int i = 1; i < MAXPLAYERS; i++ )
+	{
+		if ( client_disconnected[i] )
+		{
+			continue;
+		}
+		net_packet->address.host = net_clients[i - 1].host;
+		net_packet->address.port = net_clients[i - 1].port;
+		sendPacketSafe(net_sock, -1, net_packet, i - 1);
+	}
+}
+
+void DedicatedServer_t::startGame()
+{
+	printlog("[DEDICATED]: starting game with %d player(s).\n", numConnectedClients());
+	buttonStartServer(nullptr);
+	doNewGame(true);
+	stage = STAGE_INGAME;
+	lastClientSeenTicks = ticks;
+}
+
+/*-------------------------------------------------------------------------------
+
+	DedicatedServer_t::sleepUntil
+
+	SDL_Delay for the coarse part of the wait, then yield until the deadline.
+
+-------------------------------------------------------------------------------*/
+
+void DedicatedServer_t::sleepUntil(Clock::time_point deadline)
+{
+	Clock::time_point now = Clock::now();
+	double remainingMs = std::chrono::duration<double, std::milli>(deadline - now).count();
+	if ( remainingMs > kSpinMarginMs )
+	{
+		SDL_Delay(static_cast<Uint32>(remainingMs - kSpinMarginMs));
+	}
+	while ( (now = Clock::now()) < deadline )
+	{
+		std::this_thread::yield();
+	}
+	tickStats.oversleepMs += std::chrono::duration<double, std::milli>(now - deadline).count();
+}
+
+void DedicatedServer_t::printStats()
+{
+	Clock::time_point now = Clock::now();
+	double seconds = std::chrono::duration<double>(now - lastStatsTime).count();
+	if ( seconds <= 0.0 )
+	{
+		return;
+	}
+	NetTrafficStats_t& traffic = NetTrafficStats;
+	const Uint32 tickCount = std::max<Uint32>(tickStats.ticks, 1);
+	printf("[DEDICATED] t=%u players=%d | ticks=%u avg=%.2fms max=%.2fms late=%u dropped=%u oversleep=%.2fms | "
+		"in %llu pkts %.1f KB/s, out %llu pkts %.1f KB/s\n",
+		ticks / TICKS_PER_SECOND, numConnectedClients(),
+		tickStats.ticks, tickStats.totalMs / tickCount, tickStats.maxMs,
+		tickStats.lateTicks, tickStats.droppedTicks, tickStats.oversleepMs / tickCount,
+		(unsigned long long)(traffic.packetsReceived - lastTraffic.packetsReceived),
+		(traffic.bytesReceived - lastTraffic.bytesReceived) / 1024.0 / seconds,
+		(unsigned long long)(traffic.packetsSent - lastTraffic.packetsSent),
+		(traffic.bytesSent - lastTraffic.bytesSent) / 1024.0 / seconds);
+	fflush(stdout);
+
+	tickStats = TickStats_t();
+	lastTraffic = traffic;
+	lastStatsTime = now;
+}
+
+/*-------------------------------------------------------------------------------
+
+	DedicatedServer_t::run
+
+	fixed-step loop at TICKS_PER_SECOND. replaces the SDL timer and the main
+	loop in main(): network messages are handled first, then one gameLogic()
+	per elapsed tick.
+
+-------------------------------------------------------------------------------*/
+
+int DedicatedServer_t::run()
+{
+	if ( !openSockets() )
+	{
+		closeNetworkInterfaces();
+		return 1;
+	}
+	printlog("[DEDICATED]: listening on port %d, waiting for %d player(s).\n", port, playersToStart);
+	printf("[DEDICATED] listening on port %d\n", port);
+	fflush(stdout);
+
+	const Clock::duration tickLength = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / TICKS_PER_SECOND));
+	Clock::time_point nextTick = Clock::now();
+	lastStatsTime = nextTick;
+	lastTraffic = NetTrafficStats;
+	stage = STAGE_LOBBY;
+
+	while ( mainloop && stage != STAGE_DONE )
+	{
+		SDL_Event event;
+		while ( SDL_PollEvent(&event) )
+		{
+			if ( event.type == SDL_QUIT )
+			{
+				mainloop = 0;
+			}
+		}
+
+		if ( stage == STAGE_INGAME )
+		{
+			lastGameTickCount = SDL_GetPerformanceCounter();
+			framerateAccumulatedTime = 0.f;
+			serverHandleMessages(TICKS_PER_SECOND * 2);
+		}
+		else
+		{
+			handleLobbyPackets();
+		}
+
+		// run every tick that has come due, dropping the backlog if we're too far behind
+		Clock::time_point now = Clock::now();
+		if ( now - nextTick > tickLength * kMaxCatchupTicks )
+		{
+			Uint32 behind = static_cast<Uint32>((now - nextTick) / tickLength);
+			tickStats.droppedTicks += behind;
+			nextTick += tickLength * behind;
+		}
+		while ( nextTick <= now && stage != STAGE_DONE )
+		{
+			if ( now - nextTick >= tickLength )
+			{
+				++tickStats.lateTicks;
+			}
+			Clock::time_point tickStart = Clock::now();
+
+			ticks++;
+			if ( stage == STAGE_LOBBY )
+			{
+				SafePacketHandler.update();
+				NetSimulator.update();
+				if ( ticks % TICKS_PER_SECOND == 0 )
+				{
+					sendKeepalives();
+				}
+				checkLobbyTimeouts();
+				if ( numConnectedClients() >= playersToStart && playersToStart > 0
+					&& ticks - lastJoinTicks >= static_cast<Uint32>(lobbyGracePeriod * TICKS_PER_SECOND) )
+				{
+					startGame();
+				}
+			}
+			else
+			{
+				if ( !loading && !intro && numConnectedClients() > 0 )
+				{
+					completionTime++;
+				}
+				gameLogic();
+
+				if ( numConnectedClients() > 0 )
+				{
+					lastClientSeenTicks = ticks;
+				}
+				else if ( ticks - lastClientSeenTicks > TICKS_PER_SECOND * 5 )
+				{
+					printlog("[DEDICATED]: all players have left, shutting down.\n");
+					stage = STAGE_DONE;
+				}
+			}
+
+			double tickMs = std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count();
+			++tickStats.ticks;
+			tickStats.totalMs += tickMs;
+			tickStats.maxMs = std::max(tickStats.maxMs, tickMs);
+			nextTick += tickLength;
+		}
+
+		if ( statsInterval > 0 && Clock::now() - lastStatsTime >= std::chrono::seconds(statsInterval) )
+		{
+			printStats();
+		}
+		if ( stage != STAGE_DONE )
+		{
+			sleepUntil(nextTick);
+		}
+	}
+
+	if ( statsInterval > 0 )
+	{
+		printStats();
+	}
+	closeNetworkInterfaces();
+	return 0;
+}
@@ -0,0 +1,76 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: dedicated_server.hpp
+Desc: header for dedicated_server.cpp (headless direct-connect host)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <chrono>
+
+/*-------------------------------------------------------------------------------
+
+	DedicatedServer_t
+
+	runs a direct-connect host with no window, renderer or audio. started
+	with -dedicated[=port] on the command line, see main(). the host keeps
+	player slot 0 as the server itself, but assignActions() doesn't spawn an
+	avatar for it so only the connected clients play.
+
+	the session waits in the lobby until -dedicatedplayers=N clients have
+	joined, plays until every client has left, then exits so a supervisor
+	can start a fresh process. tick timing and traffic are written to stdout
+	every -dedicatedstats=N seconds.
+
+-------------------------------------------------------------------------------*/
+
+class DedicatedServer_t
+{
+	typedef std::chrono::high_resolution_clock Clock;
+public:
+	Uint16 port = DEFAULT_PORT;
+	int playersToStart = 1; // clients to wait for before starting
+	int statsInterval = 10; // seconds between stats lines, 0 to disable
+	int lobbyGracePeriod = 3; // seconds to wait after the last join before starting
+
+	int run(); // returns the process exit code
+private:
+	enum ServerStages : int
+	{
+		STAGE_LOBBY,
+		STAGE_INGAME,
+		STAGE_DONE
+	};
+	ServerStages stage = STAGE_LOBBY;
+	Uint32 lastJoinTicks = 0;
+	Uint32 lastClientSeenTicks = 0;
+
+	// tick timing, reset every stats line
+	struct TickStats_t
+	{
+		Uint32 ticks = 0;
+		Uint32 lateTicks = 0; // started more than a tick behind schedule
+		Uint32 droppedTicks = 0; // skipped to catch up
+		double totalMs = 0.0;
+		double maxMs = 0.0;
+		double oversleepMs = 0.0;
+	} tickStats;
+	NetTrafficStats_t lastTraffic;
+	Clock::time_point lastStatsTime;
+
+	bool openSockets();
+	int numConnectedClients() const;
+	void handleLobbyPackets();
+	void checkLobbyTimeouts();
+	void sendKeepalives();
+	void broadcastDisconnect(int player);
+	void startGame();
+	void sleepUntil(Clock::time_point deadline);
+	void printStats();
+};
+extern DedicatedServer_t DedicatedServer;
@@ -15,6 +15,8 @@
 #include "hash.hpp"
 #include "entity.hpp"
 #include "player.hpp"
+#include "texture_atlas.hpp"
+#include "hud_cache.hpp"
 #include "magic/magic.hpp"
 #ifndef NINTENDO
 #include "editor.hpp"
@@ -274,6 +276,58 @@ void drawArcInvertedY(int x, int y, real_t radius, real_t angle1, real_t angle2,
 	glLineWidth(lineWidth);
 }
 
+/*-------------------------------------------------------------------------------
+
+	recordImage
+
+	adds a textured quad to the widget HudCache is recording instead of
+	drawing it. the size comes from pos when scaled, otherwise from src
+
+-------------------------------------------------------------------------------*/
+
+static void recordImage(SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, bool scaled, GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+{
+	SDL_Rect secondsrc;
+	if ( src == NULL )
+	{
+		secondsrc.x = 0;
+		secondsrc.y = 0;
+		secondsrc.w = image->w;
+		secondsrc.h = image->h;
+		src = &secondsrc;
+	}
+	const GLfloat w = scaled ? pos->w : src->w;
+	const GLfloat h = scaled ? pos->h : src->h;
+	const GLfloat s0 = (real_t)src->x / image->w;
+	const GLfloat t0 = (real_t)src->y / image->h;
+	const GLfloat s1 = ((real_t)src->x + src->w) / image->w;
+	const GLfloat t1 = ((real_t)src->y + src->h) / image->h;
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
+	const GLfloat xy[8] = {
+		(GLfloat)pos->x, (GLfloat)(yres - pos->y),
+		(GLfloat)pos->x, yres - pos->y - h,
+		pos->x + w, yres - pos->y - h,
+		pos->x + w, (GLfloat)(yres - pos->y)
+	};
+	const GLfloat st[8] = {
+		uv.u(s0), uv.v(t0),
+		uv.u(s0), uv.v(t1),
+		uv.u(s1), uv.v(t1),
+		uv.u(s1), uv.v(t0)
+	};
+	const GLfloat rgba[4] = { r, g, b, a };
+	HudCache.addQuad(image->refcount, xy, st, rgba);
+}
+
+static void recordImageColor(SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, bool scaled, Uint32 color)
+{
+	recordImage(image, src, pos, scaled,
+		((Uint8)(color >> mainsurface->format->Rshift)) / 255.f,
+		((Uint8)(color >> mainsurface->format->Gshift)) / 255.f,
+		((Uint8)(color >> mainsurface->format->Bshift)) / 255.f,
+		((Uint8)(color >> mainsurface->format->Ashift)) / 255.f);
+}
+
 /*-------------------------------------------------------------------------------
 
 	drawLine
@@ -284,6 +338,18 @@ void drawArcInvertedY(int x, int y, real_t radius, real_t angle1, real_t angle2,
 
 void drawLine( int x1, int y1, int x2, int y2, Uint32 color, Uint8 alpha )
 {
+	if ( HudCache.recording() )
+	{
+		const GLfloat rgba[4] = {
+			((Uint8)(color >> mainsurface->format->Rshift)) / 255.f,
+			((Uint8)(color >> mainsurface->format->Gshift)) / 255.f,
+			((Uint8)(color >> mainsurface->format->Bshift)) / 255.f,
+			alpha / 255.f
+		};
+		HudCache.addLine(x1 + 1, yres - y1, x2 + 1, yres - y2, rgba);
+		return;
+	}
+
 	// update projection
 	glDisable(GL_DEPTH_TEST);
 	glDisable(GL_LIGHTING);
@@ -323,6 +389,30 @@ void drawLine( int x1, int y1, int x2, int y2, Uint32 color, Uint8 alpha )
 
 int drawRect( SDL_Rect* src, Uint32 color, Uint8 alpha )
 {
+	if ( HudCache.recording() )
+	{
+		SDL_Rect screen = { 0, 0, xres, yres };
+		if ( src == NULL )
+		{
+			src = &screen;
+		}
+		const GLfloat xy[8] = {
+			(GLfloat)src->x, (GLfloat)(yres - src->y),
+			(GLfloat)src->x, (GLfloat)(yres - src->y - src->h),
+			(GLfloat)(src->x + src->w), (GLfloat)(yres - src->y - src->h),
+			(GLfloat)(src->x + src->w), (GLfloat)(yres - src->y)
+		};
+		const GLfloat st[8] = { 0.f };
+		const GLfloat rgba[4] = {
+			((Uint8)(color >> mainsurface->format->Rshift)) / 255.f,
+			((Uint8)(color >> mainsurface->format->Gshift)) / 255.f,
+			((Uint8)(color >> mainsurface->format->Bshift)) / 255.f,
+			alpha / 255.f
+		};
+		HudCache.addQuad(-1, xy, st, rgba);
+		return 0;
+	}
+
 	SDL_Rect secondsrc;
 
 	// update projection
@@ -447,15 +537,16 @@ void drawImageRotatedAlpha( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, re
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	glColor4f(1, 1, 1, alpha / 255.1);
 	glBegin(GL_QUADS);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(-src->w / 2, src->h / 2);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(-src->w / 2, -src->h / 2);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(src->w / 2, -src->h / 2);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(src->w / 2, src->h / 2);
 	glEnd();
 	glPopMatrix();
@@ -472,6 +563,12 @@ void drawImageRotatedAlpha( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, re
 
 void drawImageColor( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint32 color )
 {
+	if ( HudCache.recording() )
+	{
+		recordImageColor(image, src, pos, false, color);
+		return;
+	}
+
 	SDL_Rect secondsrc;
 
 	// update projection
@@ -496,6 +593,7 @@ void drawImageColor( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint32 co
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	real_t r = ((Uint8)(color >> mainsurface->format->Rshift)) / 255.f;
 	real_t g = ((Uint8)(color >> mainsurface->format->Gshift)) / 255.f;
 	real_t b = ((Uint8)(color >> mainsurface->format->Bshift)) / 255.f;
@@ -503,13 +601,13 @@ void drawImageColor( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint32 co
 	glColor4f(r, g, b, a);
 	glPushMatrix();
 	glBegin(GL_QUADS);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x, yres - pos->y);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x + src->w, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x + src->w, yres - pos->y);
 	glEnd();
 	glPopMatrix();
@@ -526,6 +624,12 @@ void drawImageColor( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint32 co
 
 void drawImageAlpha( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint8 alpha )
 {
+	if ( HudCache.recording() )
+	{
+		recordImage(image, src, pos, false, 1.f, 1.f, 1.f, alpha / 255.1);
+		return;
+	}
+
 	SDL_Rect secondsrc;
 
 	// update projection
@@ -550,16 +654,17 @@ void drawImageAlpha( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint8 alp
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	glColor4f(1, 1, 1, alpha / 255.1);
 	glPushMatrix();
 	glBegin(GL_QUADS);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x, yres - pos->y);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x + src->w, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x + src->w, yres - pos->y);
 	glEnd();
 	glPopMatrix();
@@ -576,6 +681,12 @@ void drawImageAlpha( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint8 alp
 
 void drawImage( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos )
 {
+	if ( HudCache.recording() )
+	{
+		recordImage(image, src, pos, false, 1.f, 1.f, 1.f, 1.f);
+		return;
+	}
+
 	SDL_Rect secondsrc;
 
 	// update projection
@@ -600,16 +711,17 @@ void drawImage( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos )
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	glColor4f(1, 1, 1, 1);
 	glPushMatrix();
 	glBegin(GL_QUADS);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x, yres - pos->y);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x + src->w, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x + src->w, yres - pos->y);
 	glEnd();
 	glPopMatrix();
@@ -752,6 +864,11 @@ void drawImageScaled( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos )
 	{
 		return;
 	}
+	if ( HudCache.recording() )
+	{
+		recordImage(image, src, pos, true, 1.f, 1.f, 1.f, 1.f);
+		return;
+	}
 
 	// update projection
 	glPushMatrix();
@@ -775,19 +892,20 @@ void drawImageScaled( SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos )
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	glColor4f(1, 1, 1, 1);
 	glPushMatrix();
 	glBegin(GL_QUADS);
 
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	glVertex2f(pos->x, yres - pos->y);
-	glTexCoord2f(1.0 * ((real_t)src->x / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * ((real_t)src->x / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x, yres - pos->y - pos->h);
 	//glVertex2f(pos->x, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * (((real_t)src->y + src->h) / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * (((real_t)src->y + src->h) / image->h)));
 	glVertex2f(pos->x + pos->w, yres - pos->y - pos->h);
 	//glVertex2f(pos->x + src->w, yres - pos->y - src->h);
-	glTexCoord2f(1.0 * (((real_t)src->x + src->w) / image->w), 1.0 * ((real_t)src->y / image->h));
+	glTexCoord2f(uv.u(1.0 * (((real_t)src->x + src->w) / image->w)), uv.v(1.0 * ((real_t)src->y / image->h)));
 	//glVertex2f(pos->x + src->w, yres - pos->y);
 	glVertex2f(pos->x + pos->w, yres - pos->y);
 
@@ -843,19 +961,20 @@ void drawImageScaledPartial(SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, fl
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	glColor4f(1, 1, 1, 1);
 	glPushMatrix();
 	glBegin(GL_QUADS);
-	glTexCoord2f(0.f, 1.f - 1.f * percentY); // top left. 
+	glTexCoord2f(uv.u(0.f), uv.v(1.f - 1.f * percentY)); // top left. 
 	glVertex2f(pos->x, yres - pos->y - pos->h + pos->h * percentY);
 
-	glTexCoord2f(0.f, 1.f); // bottom left
+	glTexCoord2f(uv.u(0.f), uv.v(1.f)); // bottom left
 	glVertex2f(pos->x, yres - pos->y - pos->h);
 
-	glTexCoord2f(1.f, 1.f); // bottom right
+	glTexCoord2f(uv.u(1.f), uv.v(1.f)); // bottom right
 	glVertex2f(pos->x + pos->w, yres - pos->y - pos->h);
 
-	glTexCoord2f(1.f, 1.f - 1.f * percentY); // top right
+	glTexCoord2f(uv.u(1.f), uv.v(1.f - 1.f * percentY)); // top right
 	glVertex2f(pos->x + pos->w, yres - pos->y - pos->h + pos->h * percentY);
 	glEnd();
 	glPopMatrix();
@@ -882,6 +1001,13 @@ blits an image in either an opengl or SDL context while colorizing and scaling i
 
 void drawImageScaledColor(SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint32 color)
 {
+	if ( HudCache.recording() )
+	{
+		// like the immediate path below, this always draws the whole image
+		recordImageColor(image, nullptr, pos, true, color);
+		return;
+	}
+
 	SDL_Rect secondsrc;
 
 	// update projection
@@ -906,6 +1032,7 @@ void drawImageScaledColor(SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	real_t r = ((Uint8)(color >> mainsurface->format->Rshift)) / 255.f;
 	real_t g = ((Uint8)(color >> mainsurface->format->Gshift)) / 255.f;
 	real_t b = ((Uint8)(color >> mainsurface->format->Bshift)) / 255.f;
@@ -913,13 +1040,13 @@ void drawImageScaledColor(SDL_Surface* image, SDL_Rect* src, SDL_Rect* pos, Uint
 	glColor4f(r, g, b, a);
 	glPushMatrix();
 	glBegin(GL_QUADS);
-	glTexCoord2f(0.f, 0.f);
+	glTexCoord2f(uv.u(0.f), uv.v(0.f));
 	glVertex2f(pos->x, yres - pos->y);
-	glTexCoord2f(0.f, 1.f);
+	glTexCoord2f(uv.u(0.f), uv.v(1.f));
 	glVertex2f(pos->x, yres - pos->y - pos->h);
-	glTexCoord2f(1.f, 1.f);
+	glTexCoord2f(uv.u(1.f), uv.v(1.f));
 	glVertex2f(pos->x + pos->w, yres - pos->y - pos->h);
-	glTexCoord2f(1.f, 0.f);
+	glTexCoord2f(uv.u(1.f), uv.v(0.f));
 	glVertex2f(pos->x + pos->w, yres - pos->y);
 	glEnd();
 	glPopMatrix();
@@ -1002,6 +1129,7 @@ void drawImageFancy( SDL_Surface* image, Uint32 color, real_t angle, SDL_Rect* s
 
 	// draw a textured quad
 	glBindTexture(GL_TEXTURE_2D, texid[image->refcount]);
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(image);
 	real_t r = ((Uint8)(color >> mainsurface->format->Rshift)) / 255.f;
 	real_t g = ((Uint8)(color >> mainsurface->format->Gshift)) / 255.f;
 	real_t b = ((Uint8)(color >> mainsurface->format->Bshift)) / 255.f;
@@ -1009,13 +1137,13 @@ void drawImageFancy( SDL_Surface* image, Uint32 color, real_t angle, SDL_Rect* s
 	glColor4f(r, g, b, a);
 	glPushMatrix();
 	glBegin(GL_QUADS);
-	glTexCoord2f(((real_t)src->x) / ((real_t)image->w), ((real_t)src->y) / ((real_t)image->h));
+	glTexCoord2f(uv.u(((real_t)src->x) / ((real_t)image->w)), uv.v(((real_t)src->y) / ((real_t)image->h)));
 	glVertex2f(0, 0);
-	glTexCoord2f(((real_t)src->x) / ((real_t)image->w), ((real_t)(src->y + src->h)) / ((real_t)image->h));
+	glTexCoord2f(uv.u(((real_t)src->x) / ((real_t)image->w)), uv.v(((real_t)(src->y + src->h)) / ((real_t)image->h)));
 	glVertex2f(0, -pos->h);
-	glTexCoord2f(((real_t)(src->x + src->w)) / ((real_t)image->w), ((real_t)(src->y + src->h)) / ((real_t)image->h));
+	glTexCoord2f(uv.u(((real_t)(src->x + src->w)) / ((real_t)image->w)), uv.v(((real_t)(src->y + src->h)) / ((real_t)image->h)));
 	glVertex2f(pos->w, -pos->h);
-	glTexCoord2f(((real_t)(src->x + src->w)) / ((real_t)image->w), ((real_t)src->y) / ((real_t)image->h));
+	glTexCoord2f(uv.u(((real_t)(src->x + src->w)) / ((real_t)image->w)), uv.v(((real_t)src->y) / ((real_t)image->h)));
 	glVertex2f(pos->w, 0);
 	glEnd();
 	glPopMatrix();
@@ -1149,6 +1277,10 @@ void drawForeground(long camx, long camy)
 
 void drawClearBuffers()
 {
+	if ( headless )
+	{
+		return;
+	}
 	// empty video and input buffers
 	if ( zbuffer != NULL )
 	{
@@ -1158,14 +1290,7 @@ void drawClearBuffers()
 	{
 		memset( clickmap, 0, xres * yres * sizeof(Entity*) );
 	}
-	if ( vismap != NULL )
-	{
-		int c, i = map.width * map.height;
-		for ( c = 0; c < i; c++ )
-		{
-			vismap[c] = false;
-		}
-	}
+	vismap.clear();
 
 	// clear the screen
 	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
@@ -1177,7 +1302,7 @@ void drawClearBuffers()
 	raycast
 
 	Performs raycasting from the given camera's position through the
-	environment to update minimap and vismap
+	environment to update minimap and the view's visibility map
 
 -------------------------------------------------------------------------------*/
 
@@ -1209,9 +1334,15 @@ void raycast(view_t* camera, int mode, bool updateVismap)
 	rx = cos(camera->ang - wfov / 2.f);
 	ry = sin(camera->ang - wfov / 2.f);
 
-	if ( updateVismap && posx >= 0 && posy >= 0 && posx < map.width && posy < map.height )
+	// the view's own tiles, merged into vismap where they're drawn
+	VisibilityMap& view = viewVismap(camera);
+	if ( updateVismap )
 	{
-		vismap[posy + posx * map.height] = true;
+		view.resize(map.width, map.height);
+		if ( posx >= 0 && posy >= 0 && posx < map.width && posy < map.height )
+		{
+			view.set(posx, posy);
+		}
 	}
 	for ( sx = 0; sx < camera->winw; sx++ )   // for every column of the screen
 	{
@@ -1287,7 +1418,7 @@ void raycast(view_t* camera, int mode, bool updateVismap)
 			{
 				if ( updateVismap )
 				{
-					vismap[iny + inx * map.height] = true;
+					view.set(inx, iny);
 				}
 				for ( z = 0; z < MAPLAYERS; z++ )
 				{
@@ -1381,6 +1512,9 @@ void drawEntities3D(view_t* camera, int mode)
 		return;
 	}
 
+	// glDrawWorld() has normally merged this view in already, merging is idempotent
+	vismap.merge(viewVismap(camera));
+
 	glEnable(GL_SCISSOR_TEST);
 	glScissor(camera->winx, yres - camera->winh - camera->winy, camera->winw, camera->winh);
 	node_t* nextnode = nullptr;
@@ -1456,7 +1590,7 @@ void drawEntities3D(view_t* camera, int mode)
 		y = entity->y / 16;
 		if ( x >= 0 && y >= 0 && x < map.width && y < map.height )
 		{
-			if ( vismap[y + x * map.height] || entity->flags[OVERDRAW] || entity->monsterEntityRenderAsTelepath == 1 )
+			if ( vismap.test(x, y) || entity->flags[OVERDRAW] || entity->monsterEntityRenderAsTelepath == 1 )
 			{
 				if ( entity->flags[SPRITE] == false )
 				{
@@ -2298,6 +2432,11 @@ SDL_Rect errorRect = { 0 };
 
 SDL_Rect ttfPrintTextColor( TTF_Font* font, int x, int y, Uint32 color, bool outline, const char* str )
 {
+	if ( headless )
+	{
+		SDL_Rect pos = { x, y, 0, 0 };
+		return pos;
+	}
 #ifdef NINTENDO
 	if (font == ttf8)
 	{
@@ -2353,6 +2492,7 @@ SDL_Rect ttfPrintTextColor( TTF_Font* font, int x, int y, Uint32 color, bool out
 			list_FreeAll(&ttfTextHash[i]);
 		}
 		printlog("notice: stored hash limit exceeded, clearing ttfTextHash...");
+		HudCache.invalidate();
 	}
 
 	// retrieve text surface
@@ -19,6 +19,7 @@
 #include "files.hpp"
 #include "init.hpp"
 #include <sys/stat.h>
+#include <memory>
 #define EDITOR
 
 #ifdef STEAMWORKS
@@ -906,236 +907,560 @@ Uint32 timerCallback(Uint32 interval, void* param)
 
 	editFill
 
-	Fills a region of the map with a certain tile
+	Fills a region of the map with a certain tile. Works a column at a
+	time: each span of matching tiles is filled in one pass and seeds the
+	spans beside it in the neighbouring columns, so every tile is visited
+	a constant number of times.
 
 -------------------------------------------------------------------------------*/
 
 void editFill(int x, int y, int layer, int type)
 {
-	int repeat = 1;
-	int fillspot;
-
-	if ( type == map.tiles[layer + y * MAPLAYERS + x * MAPLAYERS * map.height] )
+	Sint32* tiles = map.tiles;
+	const int height = map.height;
+	const int columnStride = MAPLAYERS * height;
+	auto tileAt = [&](int tx, int ty) -> Sint32& {
+		return tiles[layer + ty * MAPLAYERS + tx * columnStride];
+	};
+
+	const Sint32 fillspot = tileAt(x, y);
+	if ( type == fillspot )
 	{
 		return;
 	}
 
-	fillspot = map.tiles[layer + y * MAPLAYERS + x * MAPLAYERS * map.height];
-	map.tiles[layer + y * MAPLAYERS + x * MAPLAYERS * map.height] = type + numtiles;
-
-	while ( repeat )
+	std::vector<std::pair<int, int>> seeds;
+	seeds.push_back(std::make_pair(x, y));
+	while ( !seeds.empty() )
 	{
-		repeat = 0;
-		for ( x = 0; x < map.width; x++ )
+		x = seeds.back().first;
+		y = seeds.back().second;
+		seeds.pop_back();
+		if ( tileAt(x, y) != fillspot )
+		{
+			continue;
+		}
+
+		// extend the span up and down the column
+		int y1 = y;
+		while ( y1 > 0 && tileAt(x, y1 - 1) == fillspot )
+		{
+			--y1;
+		}
+		int y2 = y;
+		while ( y2 < height - 1 && tileAt(x, y2 + 1) == fillspot )
+		{
+			++y2;
+		}
+		for ( y = y1; y <= y2; ++y )
+		{
+			tileAt(x, y) = type;
+		}
+
+		// one seed for each run of matching tiles beside the span
+		for ( int nx = x - 1; nx <= x + 1; nx += 2 )
 		{
-			for ( y = 0; y < map.height; y++ )
+			if ( nx < 0 || nx >= static_cast<int>(map.width) )
 			{
-				if ( map.tiles[layer + y * MAPLAYERS + x * MAPLAYERS * map.height] == type + numtiles )
+				continue;
+			}
+			bool inRun = false;
+			for ( y = y1; y <= y2; ++y )
+			{
+				if ( tileAt(nx, y) == fillspot )
 				{
-					if ( x < map.width - 1 )
-					{
-						if ( map.tiles[layer + y * MAPLAYERS + (x + 1)*MAPLAYERS * map.height] == fillspot )
-						{
-							map.tiles[layer + y * MAPLAYERS + (x + 1)*MAPLAYERS * map.height] = type + numtiles;
-							repeat = 1;
-						}
-					}
-					if ( x > 0 )
-					{
-						if ( map.tiles[layer + y * MAPLAYERS + (x - 1)*MAPLAYERS * map.height] == fillspot )
-						{
-							map.tiles[layer + y * MAPLAYERS + (x - 1)*MAPLAYERS * map.height] = type + numtiles;
-							repeat = 1;
-						}
-					}
-					if ( y < map.height - 1 )
-					{
-						if ( map.tiles[layer + (y + 1)*MAPLAYERS + x * MAPLAYERS * map.height] == fillspot )
-						{
-							map.tiles[layer + (y + 1)*MAPLAYERS + x * MAPLAYERS * map.height] = type + numtiles;
-							repeat = 1;
-						}
-					}
-					if ( y > 0 )
+					if ( !inRun )
 					{
-						if ( map.tiles[layer + (y - 1)*MAPLAYERS + x * MAPLAYERS * map.height] == fillspot )
-						{
-							map.tiles[layer + (y - 1)*MAPLAYERS + x * MAPLAYERS * map.height] = type + numtiles;
-							repeat = 1;
-						}
+						seeds.push_back(std::make_pair(nx, y));
+						inRun = true;
 					}
 				}
+				else
+				{
+					inRun = false;
+				}
 			}
 		}
 	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	editFillRegion / editReplaceRegion
+
+	Sets every tile of a layer inside the given rectangle, or only the
+	ones matching a certain tile. Corners are inclusive and clamped to the
+	map. editReplaceRegion returns the number of tiles changed
+
+-------------------------------------------------------------------------------*/
+
+static bool clampRegion(int& x1, int& y1, int& x2, int& y2)
+{
+	if ( x1 > x2 )
+	{
+		std::swap(x1, x2);
+	}
+	if ( y1 > y2 )
+	{
+		std::swap(y1, y2);
+	}
+	x1 = std::max(x1, 0);
+	y1 = std::max(y1, 0);
+	x2 = std::min(x2, static_cast<int>(map.width) - 1);
+	y2 = std::min(y2, static_cast<int>(map.height) - 1);
+	return x1 <= x2 && y1 <= y2;
+}
 
-	for ( x = 0; x < map.width; x++ )
+void editFillRegion(int x1, int y1, int x2, int y2, int layer, int type)
+{
+	if ( !clampRegion(x1, y1, x2, y2) )
 	{
-		for ( y = 0; y < map.height; y++ )
+		return;
+	}
+	for ( int x = x1; x <= x2; ++x )
+	{
+		Sint32* column = &map.tiles[layer + x * MAPLAYERS * map.height];
+		for ( int y = y1; y <= y2; ++y )
 		{
-			if ( map.tiles[layer + y * MAPLAYERS + x * MAPLAYERS * map.height] == type + numtiles )
+			column[y * MAPLAYERS] = type;
+		}
+	}
+}
+
+int editReplaceRegion(int x1, int y1, int x2, int y2, int layer, int oldType, int newType)
+{
+	if ( oldType == newType || !clampRegion(x1, y1, x2, y2) )
+	{
+		return 0;
+	}
+	int replaced = 0;
+	for ( int x = x1; x <= x2; ++x )
+	{
+		Sint32* column = &map.tiles[layer + x * MAPLAYERS * map.height];
+		for ( int y = y1; y <= y2; ++y )
+		{
+			if ( column[y * MAPLAYERS] == oldType )
 			{
-				map.tiles[layer + y * MAPLAYERS + x * MAPLAYERS * map.height] = type;
+				column[y * MAPLAYERS] = newType;
+				++replaced;
 			}
 		}
 	}
+	return replaced;
 }
 
 /*-------------------------------------------------------------------------------
 
-	makeUndo
+	editCopyRegion / editPasteRegion
 
-	adds an undomap to the undolist
+	Copies a rectangle of one layer into copymap, and stamps copymap back
+	onto a layer with its top left corner at x, y. Empty tiles in copymap
+	leave the map untouched
 
 -------------------------------------------------------------------------------*/
 
-#define MAXUNDOS 10
-
-node_t* undospot = nullptr;
-node_t* redospot = nullptr;
-list_t undolist;
-void makeUndo()
+void editCopyRegion(int x1, int y1, int x2, int y2, int layer)
 {
-	node_t* node, *nextnode;
-
-	// eliminate any undo nodes beyond the one we are currently on
-	if ( undospot != nullptr )
+	if ( !clampRegion(x1, y1, x2, y2) )
+	{
+		return;
+	}
+	copymap.width = x2 - x1 + 1;
+	copymap.height = y2 - y1 + 1;
+	if ( copymap.tiles != nullptr )
 	{
-		for ( node = undospot->next; node != nullptr; node = nextnode )
+		free(copymap.tiles);
+	}
+	copymap.tiles = (Sint32*) calloc(copymap.width * copymap.height * MAPLAYERS, sizeof(Sint32));
+	for ( int x = 0; x < static_cast<int>(copymap.width); ++x )
+	{
+		const Sint32* src = &map.tiles[layer + y1 * MAPLAYERS + (x + x1) * MAPLAYERS * map.height];
+		Sint32* dest = &copymap.tiles[layer + x * MAPLAYERS * copymap.height];
+		for ( int y = 0; y < static_cast<int>(copymap.height); ++y )
 		{
-			nextnode = node->next;
-			list_RemoveNode(node);
+			dest[y * MAPLAYERS] = src[y * MAPLAYERS];
 		}
 	}
-	else
+	copymap.name[0] = layer;
+}
+
+void editPasteRegion(int x, int y, int layer)
+{
+	if ( copymap.tiles == nullptr )
+	{
+		return;
+	}
+	const int srcLayer = copymap.name[0];
+	const int x1 = std::max(0, -x);
+	const int y1 = std::max(0, -y);
+	const int x2 = std::min(static_cast<int>(copymap.width), static_cast<int>(map.width) - x);
+	const int y2 = std::min(static_cast<int>(copymap.height), static_cast<int>(map.height) - y);
+	for ( int cx = x1; cx < x2; ++cx )
 	{
-		if ( redospot )
+		const Sint32* src = &copymap.tiles[srcLayer + cx * MAPLAYERS * copymap.height];
+		Sint32* dest = &map.tiles[layer + y * MAPLAYERS + (x + cx) * MAPLAYERS * map.height];
+		for ( int cy = y1; cy < y2; ++cy )
 		{
-			list_FreeAll(&undolist);
+			if ( src[cy * MAPLAYERS] )
+			{
+				dest[cy * MAPLAYERS] = src[cy * MAPLAYERS];
+			}
 		}
 	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	makeUndo
+
+	records whatever changed since the last call as one undo step. it's
+	called before every edit, so the step recorded is the previous edit.
 
-	// copy all the current map data
-	map_t* undomap = (map_t*) malloc(sizeof(map_t));
-	strcpy(undomap->author, map.author);
-	strcpy(undomap->name, map.name);
-	undomap->skybox = map.skybox;
-	undomap->width = map.width;
-	undomap->height = map.height;
-	for ( int c = 0; c < MAPFLAGS; c++ )
+	the journal keeps a shadow of the map as of the newest step: its tiles
+	and a clone of every entity. a step holds only the tiles that differ
+	from the shadow, plus the run of entities between the first and last
+	ones that differ, so recording, undoing and redoing an edit costs as
+	much as the edit itself. the oldest steps are dropped once the journal
+	grows past kUndoMemoryBudget
+
+-------------------------------------------------------------------------------*/
+
+static const size_t kUndoMemoryBudget = 64 * 1024 * 1024;
+
+struct UndoTile_t
+{
+	Uint32 index;
+	Sint32 before;
+	Sint32 after;
+};
+
+struct UndoStep_t
+{
+	std::vector<UndoTile_t> tiles;
+
+	// only used when the map was resized, every tile before and after
+	bool resized = false;
+	Uint32 widthBefore = 0;
+	Uint32 heightBefore = 0;
+	Uint32 widthAfter = 0;
+	Uint32 heightAfter = 0;
+	std::vector<Sint32> tilesBefore;
+	std::vector<Sint32> tilesAfter;
+
+	// map.entities from entityIndex on: entitiesBefore was replaced by entitiesAfter
+	Uint32 entityIndex = 0;
+	list_t entitiesBefore;
+	list_t entitiesAfter;
+
+	size_t bytes = 0;
+
+	UndoStep_t()
 	{
-		undomap->flags[c] = map.flags[c];
+		memset(&entitiesBefore, 0, sizeof(list_t));
+		memset(&entitiesAfter, 0, sizeof(list_t));
 	}
-	undomap->tiles = (Sint32*) malloc(sizeof(Sint32) * undomap->width * undomap->height * MAPLAYERS);
-	memcpy(undomap->tiles, map.tiles, sizeof(Sint32)*undomap->width * undomap->height * MAPLAYERS);
-	undomap->entities = (list_t*) malloc(sizeof(list_t));
-	undomap->entities->first = nullptr;
-	undomap->entities->last = nullptr;
-	undomap->creatures = nullptr;
-	undomap->worldUI = nullptr;
-	for ( node = map.entities->first; node != nullptr; node = node->next )
+	~UndoStep_t()
 	{
-		Entity* entity = newEntity(((Entity*)node->element)->sprite, 1, undomap->entities, nullptr);
+		list_FreeAll(&entitiesBefore);
+		list_FreeAll(&entitiesAfter);
+	}
+	UndoStep_t(const UndoStep_t&) = delete;
+	UndoStep_t& operator=(const UndoStep_t&) = delete;
+};
+
+static std::vector<std::unique_ptr<UndoStep_t>> undoSteps;
+static size_t undoPosition = 0; // steps before this can be undone, the rest redone
+static size_t undoBytes = 0;
 
-		setSpriteAttributes(entity, (Entity*)node->element, (Entity*)node->element);
+static bool undoShadowValid = false;
+static Uint32 shadowWidth = 0;
+static Uint32 shadowHeight = 0;
+static std::vector<Sint32> shadowTiles;
+static list_t shadowEntities;
+
+// a copy of src placed at the given position in list
+static Entity* undoCloneEntity(Entity* src, list_t* list, Uint32 index)
+{
+	Entity* entity = newEntity(src->sprite, 1, list, nullptr);
+	setSpriteAttributes(entity, src, src);
+	entity->z = src->z;
+	entity->yaw = src->yaw;
+	entity->pitch = src->pitch;
+	entity->roll = src->roll;
+	memcpy(entity->skill, src->skill, sizeof(entity->skill));
+	memcpy(entity->fskill, src->fskill, sizeof(entity->fskill));
+
+	if ( index + 1 < list_Size(list) )
+	{
+		// newEntity() appended it, move the node into place
+		entity->mynode->deconstructor = &emptyDeconstructor;
+		list_RemoveNode(entity->mynode);
+		node_t* node = list_AddNode(list, index);
+		node->element = entity;
+		node->deconstructor = &entityDeconstructor;
+		node->size = sizeof(Entity);
+		entity->mynode = node;
 	}
+	return entity;
+}
 
-	// add the new node to the undo list
-	node = list_AddNodeLast(&undolist);
-	node->element = undomap;
-	node->deconstructor = &mapDeconstructor;
-	if ( list_Size(&undolist) > MAXUNDOS + 1 )
+// compares everything the editor can change and saveMap() writes
+static bool undoEntitiesMatch(Entity* a, Entity* b)
+{
+	if ( a->sprite != b->sprite || a->x != b->x || a->y != b->y || a->z != b->z
+		|| a->yaw != b->yaw || a->pitch != b->pitch || a->roll != b->roll )
+	{
+		return false;
+	}
+	if ( memcmp(a->skill, b->skill, sizeof(a->skill)) || memcmp(a->fskill, b->fskill, sizeof(a->fskill)) )
 	{
-		list_RemoveNode(undolist.first);
+		return false;
 	}
-	undospot = node;
-	redospot = nullptr;
+	if ( checkSpriteType(a->sprite) != 1 )
+	{
+		return true;
+	}
+	Stat* statsA = a->getStats();
+	Stat* statsB = b->getStats();
+	if ( !statsA || !statsB )
+	{
+		return statsA == statsB;
+	}
+	const Sint32 attributesA[] = {
+		statsA->HP, statsA->MAXHP, statsA->OLDHP, statsA->MP, statsA->MAXMP,
+		statsA->STR, statsA->DEX, statsA->CON, statsA->INT, statsA->PER, statsA->CHR,
+		statsA->LVL, statsA->GOLD,
+		statsA->RANDOM_MAXHP, statsA->RANDOM_HP, statsA->RANDOM_MAXMP, statsA->RANDOM_MP,
+		statsA->RANDOM_STR, statsA->RANDOM_CON, statsA->RANDOM_DEX, statsA->RANDOM_INT,
+		statsA->RANDOM_PER, statsA->RANDOM_CHR, statsA->RANDOM_LVL, statsA->RANDOM_GOLD
+	};
+	const Sint32 attributesB[] = {
+		statsB->HP, statsB->MAXHP, statsB->OLDHP, statsB->MP, statsB->MAXMP,
+		statsB->STR, statsB->DEX, statsB->CON, statsB->INT, statsB->PER, statsB->CHR,
+		statsB->LVL, statsB->GOLD,
+		statsB->RANDOM_MAXHP, statsB->RANDOM_HP, statsB->RANDOM_MAXMP, statsB->RANDOM_MP,
+		statsB->RANDOM_STR, statsB->RANDOM_CON, statsB->RANDOM_DEX, statsB->RANDOM_INT,
+		statsB->RANDOM_PER, statsB->RANDOM_CHR, statsB->RANDOM_LVL, statsB->RANDOM_GOLD
+	};
+	return statsA->sex == statsB->sex
+		&& !strcmp(statsA->name, statsB->name)
+		&& !memcmp(attributesA, attributesB, sizeof(attributesA))
+		&& !memcmp(statsA->EDITOR_ITEMS, statsB->EDITOR_ITEMS, sizeof(statsA->EDITOR_ITEMS))
+		&& !memcmp(statsA->MISC_FLAGS, statsB->MISC_FLAGS, sizeof(statsA->MISC_FLAGS));
 }
 
-void clearUndos()
+// removes count entities from index on and puts clones of replacement there
+static void undoReplaceEntities(list_t* list, Uint32 index, Uint32 count, list_t* replacement)
 {
-	list_FreeAll(&undolist);
-	undospot = nullptr;
-	redospot = nullptr;
+	node_t* node = list_Node(list, index);
+	for ( Uint32 c = 0; c < count && node != nullptr; ++c )
+	{
+		node_t* nextnode = node->next;
+		list_RemoveNode(node);
+		node = nextnode;
+	}
+	for ( node = replacement->first; node != nullptr; node = node->next, ++index )
+	{
+		undoCloneEntity((Entity*)node->element, list, index);
+	}
 }
 
-/*-------------------------------------------------------------------------------
+static void undoResetShadow()
+{
+	shadowWidth = map.width;
+	shadowHeight = map.height;
+	shadowTiles.assign(map.tiles, map.tiles + map.width * map.height * MAPLAYERS);
+	list_FreeAll(&shadowEntities);
+	Uint32 index = 0;
+	for ( node_t* node = map.entities->first; node != nullptr; node = node->next, ++index )
+	{
+		undoCloneEntity((Entity*)node->element, &shadowEntities, index);
+	}
+	undoShadowValid = true;
+}
 
-	undo() / redo()
+static void undoCommitPending()
+{
+	if ( !undoShadowValid )
+	{
+		// first edit since the map was opened, nothing to record yet
+		undoResetShadow();
+		return;
+	}
 
-	self explanatory
+	std::unique_ptr<UndoStep_t> step(new UndoStep_t());
+	const size_t numTiles = map.width * map.height * MAPLAYERS;
+	if ( map.width != shadowWidth || map.height != shadowHeight )
+	{
+		step->resized = true;
+		step->widthBefore = shadowWidth;
+		step->heightBefore = shadowHeight;
+		step->widthAfter = map.width;
+		step->heightAfter = map.height;
+		step->tilesBefore.swap(shadowTiles);
+		step->tilesAfter.assign(map.tiles, map.tiles + numTiles);
+		shadowTiles = step->tilesAfter;
+		shadowWidth = map.width;
+		shadowHeight = map.height;
+		step->bytes += (step->tilesBefore.size() + step->tilesAfter.size()) * sizeof(Sint32);
+	}
+	else
+	{
+		for ( size_t i = 0; i < numTiles; ++i )
+		{
+			if ( map.tiles[i] != shadowTiles[i] )
+			{
+				UndoTile_t tile;
+				tile.index = static_cast<Uint32>(i);
+				tile.before = shadowTiles[i];
+				tile.after = map.tiles[i];
+				step->tiles.push_back(tile);
+				shadowTiles[i] = map.tiles[i];
+			}
+		}
+		step->bytes += step->tiles.size() * sizeof(UndoTile_t);
+	}
 
--------------------------------------------------------------------------------*/
+	// entities: skip the matching runs at either end of the list
+	const Uint32 liveCount = list_Size(map.entities);
+	const Uint32 shadowCount = list_Size(&shadowEntities);
+	Uint32 prefix = 0;
+	node_t* live = map.entities->first;
+	node_t* shadow = shadowEntities.first;
+	while ( live && shadow && undoEntitiesMatch((Entity*)live->element, (Entity*)shadow->element) )
+	{
+		live = live->next;
+		shadow = shadow->next;
+		++prefix;
+	}
+	Uint32 suffix = 0;
+	const Uint32 maxSuffix = std::min(liveCount, shadowCount) - prefix;
+	node_t* liveEnd = map.entities->last;
+	node_t* shadowEnd = shadowEntities.last;
+	while ( suffix < maxSuffix && undoEntitiesMatch((Entity*)liveEnd->element, (Entity*)shadowEnd->element) )
+	{
+		liveEnd = liveEnd->prev;
+		shadowEnd = shadowEnd->prev;
+		++suffix;
+	}
+	const Uint32 numBefore = shadowCount - prefix - suffix;
+	const Uint32 numAfter = liveCount - prefix - suffix;
+	if ( numBefore > 0 || numAfter > 0 )
+	{
+		step->entityIndex = prefix;
+		Uint32 c = 0;
+		for ( node_t* node = shadow; c < numBefore; node = node->next, ++c )
+		{
+			undoCloneEntity((Entity*)node->element, &step->entitiesBefore, c);
+		}
+		c = 0;
+		for ( node_t* node = live; c < numAfter; node = node->next, ++c )
+		{
+			undoCloneEntity((Entity*)node->element, &step->entitiesAfter, c);
+		}
+		undoReplaceEntities(&shadowEntities, prefix, numBefore, &step->entitiesAfter);
+		step->bytes += (numBefore + numAfter) * sizeof(Entity);
+	}
 
-void undo()
-{
-	node_t* node;
-	if ( undospot == NULL )
+	if ( !step->resized && step->tiles.empty() && numBefore == 0 && numAfter == 0 )
 	{
 		return;
 	}
-	selectedEntity[0] = NULL;
-	if ( undospot == undolist.last )
+
+	// a new edit discards anything that could have been redone
+	while ( undoSteps.size() > undoPosition )
 	{
-		node_t* tempnode = undospot;
-		makeUndo();
-		undospot = tempnode;
+		undoBytes -= undoSteps.back()->bytes;
+		undoSteps.pop_back();
 	}
-	free(map.tiles);
-	map_t* undomap = (map_t*)undospot->element;
-	map.width = undomap->width;
-	map.height = undomap->height;
-	map.tiles = (Sint32*) malloc(sizeof(Sint32) * map.width * map.height * MAPLAYERS);
-	memcpy(map.tiles, undomap->tiles, sizeof(Sint32)*undomap->width * undomap->height * MAPLAYERS);
-	list_FreeAll(map.entities);
-	for ( node = undomap->entities->first; node != NULL; node = node->next )
+	undoBytes += step->bytes;
+	undoSteps.push_back(std::move(step));
+	++undoPosition;
+	while ( undoBytes > kUndoMemoryBudget && undoSteps.size() > 1 )
 	{
-		Entity* entity = newEntity(((Entity*)node->element)->sprite, 1, map.entities, nullptr);
+		undoBytes -= undoSteps.front()->bytes;
+		undoSteps.erase(undoSteps.begin());
+		--undoPosition;
+	}
+}
 
-		setSpriteAttributes(entity, (Entity*)node->element, (Entity*)node->element);
+static void undoApplyStep(UndoStep_t& step, bool forward)
+{
+	if ( step.resized )
+	{
+		const std::vector<Sint32>& tiles = forward ? step.tilesAfter : step.tilesBefore;
+		free(map.tiles);
+		map.width = forward ? step.widthAfter : step.widthBefore;
+		map.height = forward ? step.heightAfter : step.heightBefore;
+		map.tiles = (Sint32*) malloc(sizeof(Sint32) * map.width * map.height * MAPLAYERS);
+		memcpy(map.tiles, tiles.data(), sizeof(Sint32) * map.width * map.height * MAPLAYERS);
+		shadowTiles = tiles;
+		shadowWidth = map.width;
+		shadowHeight = map.height;
 	}
-	if ( redospot != NULL )
+	for ( const UndoTile_t& tile : step.tiles )
 	{
-		redospot = redospot->prev;
+		map.tiles[tile.index] = forward ? tile.after : tile.before;
+		shadowTiles[tile.index] = map.tiles[tile.index];
 	}
-	else
+
+	list_t* removed = forward ? &step.entitiesBefore : &step.entitiesAfter;
+	list_t* restored = forward ? &step.entitiesAfter : &step.entitiesBefore;
+	const Uint32 count = list_Size(removed);
+	if ( count > 0 || list_Size(restored) > 0 )
 	{
-		redospot = undospot->next;
+		undoReplaceEntities(map.entities, step.entityIndex, count, restored);
+		undoReplaceEntities(&shadowEntities, step.entityIndex, count, restored);
 	}
-	undospot = undospot->prev;
 }
 
-void redo()
+void makeUndo()
 {
-	node_t* node;
+	undoCommitPending();
+}
+
+void clearUndos()
+{
+	undoSteps.clear();
+	undoPosition = 0;
+	undoBytes = 0;
+	undoShadowValid = false;
+	shadowTiles.clear();
+	list_FreeAll(&shadowEntities);
+}
+
+/*-------------------------------------------------------------------------------
 
-	if ( redospot == NULL )
+	undo() / redo()
+
+	self explanatory
+
+-------------------------------------------------------------------------------*/
+
+void undo()
+{
+	// the edit in progress becomes the step being undone
+	undoCommitPending();
+	if ( undoPosition == 0 )
 	{
 		return;
 	}
 	selectedEntity[0] = NULL;
-	free(map.tiles);
-	map_t* undomap = (map_t*)redospot->element;
-	map.width = undomap->width;
-	map.height = undomap->height;
-	map.tiles = (Sint32*) malloc(sizeof(Sint32) * map.width * map.height * MAPLAYERS);
-	memcpy(map.tiles, undomap->tiles, sizeof(Sint32)*undomap->width * undomap->height * MAPLAYERS);
-	list_FreeAll(map.entities);
-	for ( node = undomap->entities->first; node != NULL; node = node->next )
-	{
-		Entity* entity = newEntity(((Entity*)node->element)->sprite, 1, map.entities, nullptr);
+	--undoPosition;
+	undoApplyStep(*undoSteps[undoPosition], false);
+}
 
-		setSpriteAttributes(entity, (Entity*)node->element, (Entity*)node->element);
-	}
-	if ( undospot != NULL )
-	{
-		undospot = undospot->next;
-	}
-	else
+void redo()
+{
+	// anything edited since the last undo discards the redo steps
+	undoCommitPending();
+	if ( undoPosition >= undoSteps.size() )
 	{
-		undospot = redospot->prev;
+		return;
 	}
-	redospot = redospot->next;
+	selectedEntity[0] = NULL;
+	undoApplyStep(*undoSteps[undoPosition], true);
+	++undoPosition;
 }
 
 void processCommandLine(int argc, char** argv)
@@ -1517,8 +1842,6 @@ int main(int argc, char** argv)
 	copymap.entities = nullptr;
 	copymap.creatures = nullptr;
 	copymap.worldUI = nullptr;
-	undolist.first = nullptr;
-	undolist.last = nullptr;
 
 	// Load Cursors
 	cursorArrow = SDL_GetCursor();
@@ -1572,7 +1895,7 @@ int main(int argc, char** argv)
 			}
 		}
 	}
-	vismap = (bool*) malloc(sizeof(bool) * map.width * map.height);
+	vismap.resize(map.width, map.height);
 	lightmap = (int*)malloc(sizeof(Sint32) * map.width * map.height);
 	lightmapSmoothed = (int*)malloc(sizeof(Sint32) * map.width * map.height);
 	for ( c = 0; c < map.width * map.height; c++ )
@@ -2265,20 +2588,7 @@ int main(int argc, char** argv)
 						{
 							// pasting from copymap
 							mousestatus[SDL_BUTTON_LEFT] = false;
-							for ( x = 0; x < copymap.width; x++ )
-							{
-								for ( y = 0; y < copymap.height; y++ )
-								{
-									if ( drawx + x >= 0 && drawx + x < map.width && drawy + y >= 0 && drawy + y < map.height )
-									{
-										z = copymap.name[0] + y * MAPLAYERS + x * MAPLAYERS * copymap.height;
-										if ( copymap.tiles[z] )
-										{
-											map.tiles[drawlayer + (drawy + y)*MAPLAYERS + (drawx + x)*MAPLAYERS * map.height] = copymap.tiles[z];
-										}
-									}
-								}
-							}
+							editPasteRegion(drawx, drawy, drawlayer);
 							pasting = false;
 						}
 					}
@@ -7586,6 +7896,12 @@ int main(int argc, char** argv)
 						spacing += 12;
 						strcpy(helptext, "Cycle Stacked Sprites:              C");
 						printTextFormatted(font8x8_bmp, textColumnLeft, pady + spacing, helptext);
+						spacing += 12;
+						strcpy(helptext, "Fill Selection With Tile:           F");
+						printTextFormatted(font8x8_bmp, textColumnLeft, pady + spacing, helptext);
+						spacing += 12;
+						strcpy(helptext, "Replace Tile Under Cursor in Sel.:  R");
+						printTextFormatted(font8x8_bmp, textColumnLeft, pady + spacing, helptext);
 
 						spacing += 16;
 
@@ -8167,6 +8483,26 @@ int main(int argc, char** argv)
 					buttonDelete(NULL);
 					groupedEntities.clear();
 				}
+				if ( keystatus[SDL_SCANCODE_F] && selectedarea )
+				{
+					// fill the selection with the current tile
+					keystatus[SDL_SCANCODE_F] = 0;
+					makeUndo();
+					editFillRegion(selectedarea_x1, selectedarea_y1, selectedarea_x2, selectedarea_y2, drawlayer, selectedTile);
+				}
+				if ( keystatus[SDL_SCANCODE_R] && selectedarea )
+				{
+					// replace the tile under the cursor with the current tile throughout the selection
+					keystatus[SDL_SCANCODE_R] = 0;
+					if ( drawx >= 0 && drawx < map.width && drawy >= 0 && drawy < map.height )
+					{
+						makeUndo();
+						int replaced = editReplaceRegion(selectedarea_x1, selectedarea_y1, selectedarea_x2, selectedarea_y2, drawlayer,
+							map.tiles[drawlayer + drawy * MAPLAYERS + drawx * MAPLAYERS * map.height], selectedTile);
+						snprintf(message, sizeof(message), "Replaced %d tiles.", replaced);
+						messagetime = 60;
+					}
+				}
 				if ( keystatus[SDL_SCANCODE_C] )
 				{
 					keystatus[SDL_SCANCODE_C] = 0;
@@ -8603,7 +8939,7 @@ int main(int argc, char** argv)
 	{
 		free(copymap.tiles);
 	}
-	list_FreeAll(&undolist);
+	clearUndos();
 	saveTilePalettes();
 	return deinitApp();
 }
@@ -8675,7 +9011,7 @@ void reselectEntityGroup()
 	}
 }
 
-int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int> mapParameters)
+int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int> mapParameters, StagedLevel_t* staged)
 {
 	return 0; // dummy function
 }
\ No newline at end of file
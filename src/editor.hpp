@@ -126,7 +126,6 @@ extern int selectedarea_y1, selectedarea_y2;
 extern bool selectedarea;
 extern bool pasting;
 extern map_t copymap;
-extern list_t undolist;
 
 // fps
 extern bool showfps;
@@ -143,6 +142,13 @@ void clearUndos();
 void undo();
 void redo();
 
+// tile region funcs, corners inclusive
+void editFill(int x, int y, int layer, int type);
+void editFillRegion(int x1, int y1, int x2, int y2, int layer, int type);
+int editReplaceRegion(int x1, int y1, int x2, int y2, int layer, int oldType, int newType);
+void editCopyRegion(int x1, int y1, int x2, int y2, int layer); // into copymap
+void editPasteRegion(int x, int y, int layer); // from copymap
+
 // function prototypes for buttons.c:
 void buttonExit(button_t* my);
 void buttonExitConfirm(button_t* my);
@@ -30,6 +30,7 @@ See LICENSE for details.
 #include "scores.hpp"
 #include "menu.hpp"
 #include "mod_tools.hpp"
+#include "level_prefetch.hpp"
 #ifdef __ARM_NEON__
 #include <arm_neon.h>
 #endif
@@ -362,6 +363,9 @@ Entity::Entity(Sint32 in_sprite, Uint32 pos, list_t* entlist, list_t* creatureli
 	}
 	myWorldUIListNode = nullptr;
 	myTileListNode = nullptr;
+	myCreatureGridNode = nullptr;
+	attachedLimb = false;
+	bodypartsPendingUpdate = 0;
 
 	// now reset all of my data elements
 	lastupdate = 0;
@@ -423,7 +427,7 @@ Entity::Entity(Sint32 in_sprite, Uint32 pos, list_t* entlist, list_t* creatureli
 			uid = -2;
 		}
 	}
-	else
+	else if ( !LevelPrefetch.stagedEntityUid(entlist, uid) ) // the next floor, being built by the level prefetch worker
 	{
 		uid = -2;
 	}
@@ -478,11 +482,19 @@ Entity::~Entity()
 	}
 	}*/
 
+	// the level prefetch worker only destroys entities of the floor it's
+	// building, which nothing outside it can refer to
+	const bool prefetched = LevelPrefetch.onWorkerThread();
+
 	//Remove me from the
 	if ( myCreatureListNode )
 	{
 		list_RemoveNode(myCreatureListNode);
 		myCreatureListNode = nullptr;
+		if ( !prefetched )
+		{
+			CreatureIndex.markRaceCountsDirty();
+		}
 	}
 	if ( myWorldUIListNode )
 	{
@@ -494,6 +506,14 @@ Entity::~Entity()
 		list_RemoveNode(myTileListNode);
 		myTileListNode = nullptr;
 	}
+	if ( myCreatureGridNode )
+	{
+		CreatureIndex.removeEntity(*this);
+	}
+	if ( circuit_status && !prefetched )
+	{
+		CircuitGraph.removePowerable(*this);
+	}
 
 	// alert clients of the entity's deletion
 	if ( multiplayer == SERVER && !loading )
@@ -534,7 +554,7 @@ Entity::~Entity()
 	}
 
 	// set appropriate player pointer to NULL
-	for ( i = 0; i < MAXPLAYERS; ++i )
+	for ( i = 0; i < MAXPLAYERS && !prefetched; ++i )
 	{
 		if ( this == players[i]->entity )
 		{
@@ -545,9 +565,12 @@ Entity::~Entity()
 	// destroy my children
 	list_FreeAll(&this->children);
 
-	node = list_AddNodeLast(&entitiesdeleted);
-	node->element = this;
-	node->deconstructor = &emptyDeconstructor;
+	if ( !prefetched )
+	{
+		node = list_AddNodeLast(&entitiesdeleted);
+		node->element = this;
+		node->deconstructor = &emptyDeconstructor;
+	}
 
 	if ( clientStats )
 	{
@@ -4790,7 +4813,7 @@ Sint32 Entity::getSTR()
 	return statGetSTR(entitystats, this);
 }
 
-Sint32 statGetSTR(Stat* entitystats, Entity* my)
+static Sint32 statComputeSTR(Stat* entitystats, Entity* my)
 {
 	Sint32 STR;
 
@@ -4922,7 +4945,7 @@ Sint32 Entity::getDEX()
 	return statGetDEX(entitystats, this);
 }
 
-Sint32 statGetDEX(Stat* entitystats, Entity* my)
+static Sint32 statComputeDEX(Stat* entitystats, Entity* my)
 {
 	Sint32 DEX;
 
@@ -5152,7 +5175,7 @@ Sint32 Entity::getCON()
 	return statGetCON(entitystats, this);
 }
 
-Sint32 statGetCON(Stat* entitystats, Entity* my)
+static Sint32 statComputeCON(Stat* entitystats, Entity* my)
 {
 	Sint32 CON;
 
@@ -5235,7 +5258,7 @@ Sint32 Entity::getINT()
 	return statGetINT(entitystats, this);
 }
 
-Sint32 statGetINT(Stat* entitystats, Entity* my)
+static Sint32 statComputeINT(Stat* entitystats, Entity* my)
 {
 	Sint32 INT;
 
@@ -5326,7 +5349,7 @@ Sint32 Entity::getPER()
 	return statGetPER(entitystats, this);
 }
 
-Sint32 statGetPER(Stat* entitystats, Entity* my)
+static Sint32 statComputePER(Stat* entitystats, Entity* my)
 {
 	Sint32 PER;
 
@@ -5466,7 +5489,7 @@ Sint32 Entity::getCHR()
 	return statGetCHR(entitystats, this);
 }
 
-Sint32 statGetCHR(Stat* entitystats, Entity* my)
+static Sint32 statComputeCHR(Stat* entitystats, Entity* my)
 {
 	Sint32 CHR;
 
@@ -5523,6 +5546,78 @@ Sint32 statGetCHR(Stat* entitystats, Entity* my)
 
 /*-------------------------------------------------------------------------------
 
+statGetCached
+
+returns a derived attribute from the Stat's cache, computing it if the
+entry is missing, from an older tick, for a different entity, base value
+or hunger, or if any effect or effect timer has been written since.
+equipping items and changing their beatitude invalidate the cache early.
+
+-------------------------------------------------------------------------------*/
+
+static Sint32 statGetCached(Stat* entitystats, Entity* my, int derived, Sint32 base, Sint32 (*compute)(Stat*, Entity*))
+{
+	Stat::DerivedStatCache& cache = entitystats->derivedStats[derived];
+	if ( cache.valid && cache.tick == ticks && cache.entity == my && cache.base == base
+		&& cache.hunger == entitystats->HUNGER
+		&& cache.effectsVersion == entitystats->EFFECTS.getVersion()
+		&& cache.timersVersion == entitystats->EFFECTS_TIMERS.getVersion() )
+	{
+		if ( Stat::debugCheckDerivedStats )
+		{
+			Sint32 value = (*compute)(entitystats, my);
+			if ( value != cache.value )
+			{
+				printlog("[STAT CACHE]: stale derived stat %d for type %d: cached %d, actual %d", derived, entitystats->type, cache.value, value);
+				cache.value = value;
+			}
+		}
+		return cache.value;
+	}
+
+	cache.value = (*compute)(entitystats, my);
+	cache.tick = ticks;
+	cache.entity = my;
+	cache.base = base;
+	cache.hunger = entitystats->HUNGER;
+	cache.effectsVersion = entitystats->EFFECTS.getVersion();
+	cache.timersVersion = entitystats->EFFECTS_TIMERS.getVersion();
+	cache.valid = true;
+	return cache.value;
+}
+
+Sint32 statGetSTR(Stat* entitystats, Entity* my)
+{
+	return statGetCached(entitystats, my, Stat::DERIVED_STR, entitystats->STR, &statComputeSTR);
+}
+
+Sint32 statGetDEX(Stat* entitystats, Entity* my)
+{
+	return statGetCached(entitystats, my, Stat::DERIVED_DEX, entitystats->DEX, &statComputeDEX);
+}
+
+Sint32 statGetCON(Stat* entitystats, Entity* my)
+{
+	return statGetCached(entitystats, my, Stat::DERIVED_CON, entitystats->CON, &statComputeCON);
+}
+
+Sint32 statGetINT(Stat* entitystats, Entity* my)
+{
+	return statGetCached(entitystats, my, Stat::DERIVED_INT, entitystats->INT, &statComputeINT);
+}
+
+Sint32 statGetPER(Stat* entitystats, Entity* my)
+{
+	return statGetCached(entitystats, my, Stat::DERIVED_PER, entitystats->PER, &statComputePER);
+}
+
+Sint32 statGetCHR(Stat* entitystats, Entity* my)
+{
+	return statGetCached(entitystats, my, Stat::DERIVED_CHR, entitystats->CHR, &statComputeCHR);
+}
+
+/*-------------------------------------------------------------------------------
+
 Entity::isBlind
 
 returns true if the given entity is blind, and false if it is not
@@ -6946,15 +7041,19 @@ void Entity::attack(int pose, int charge, Entity* target)
 
 						// alert other monsters too
 						Entity* ohitentity = hit.entity;
-						for ( node = map.creatures->first; node != nullptr && alertTarget; node = node->next ) //Only searching for monsters, so don't iterate full map.entities.
+						std::vector<Entity*> nearbyCreatures;
+						if ( alertTarget )
+						{
+							nearbyCreatures = CreatureIndex.getCreaturesWithinRange(ohitentity->x, ohitentity->y, 1024); //Only searching for monsters, so don't iterate full map.entities.
+						}
+						for ( Entity* entity : nearbyCreatures )
 						{
-							Entity* entity = (Entity*)node->element;
 							if ( entity && entity->behavior == &actMonster && entity != ohitentity )
 							{
 								Stat* buddystats = entity->getStats();
 								if ( buddystats != nullptr )
 								{
-									if ( entity->checkFriend(hit.entity) )
+									if ( entity->checkFriend(ohitentity) )
 									{
 										if ( entity->monsterState == MONSTER_STATE_WAIT )
 										{
@@ -9269,12 +9368,12 @@ void Entity::attack(int pose, int charge, Entity* target)
 									if ( bleedStatusInflicted ) // from sword capstone
 									{
 										// 5 seconds bleeding minimum
-										hitstats->EFFECTS_TIMERS[EFF_BLEEDING] = std::max(hitstats->EFFECTS_TIMERS[EFF_BLEEDING], 250); 
+										hitstats->EFFECTS_TIMERS[EFF_BLEEDING] = std::max<Sint32>(hitstats->EFFECTS_TIMERS[EFF_BLEEDING], 250); 
 									}
 									else if ( myStats->weapon && myStats->weapon->type == TOOL_WHIP )
 									{
 										// 5 seconds bleeding minimum
-										hitstats->EFFECTS_TIMERS[EFF_BLEEDING] = std::max(hitstats->EFFECTS_TIMERS[EFF_BLEEDING], 250);
+										hitstats->EFFECTS_TIMERS[EFF_BLEEDING] = std::max<Sint32>(hitstats->EFFECTS_TIMERS[EFF_BLEEDING], 250);
 										spawnMagicEffectParticles(hit.entity->x, hit.entity->y, hit.entity->z, 643);
 										for ( int gibs = 0; gibs < 5; ++gibs )
 										{
@@ -9786,7 +9885,7 @@ void Entity::attack(int pose, int charge, Entity* target)
 									}
 								}
 								// Update the paths so that monsters know they can walk through it
-								generatePathMaps();
+								updatePathMaps(hit.mapx, hit.mapy);
 							}
 							int chance = 2 + (myStats->type == GOBLIN ? 2 : 0);
 							if ( rand() % chance && degradePickaxe )
@@ -9895,26 +9994,9 @@ Returns armor class value from a Stat instance
 
 -------------------------------------------------------------------------------*/
 
-int AC(Stat* stat)
+static Sint32 statComputeAC(Stat* stat, Entity* playerEntity)
 {
-	if ( !stat )
-	{
-		return 0;
-	}
-
-	Entity* playerEntity = nullptr;
-	for ( int i = 0; i < MAXPLAYERS; ++i )
-	{
-		if ( stat && stats[i] == stat )
-		{
-			if ( players[i] && players[i]->entity )
-			{
-				playerEntity = players[i]->entity;
-				break;
-			}
-		}
-	}
-	int armor = statGetCON(stat, playerEntity);
+	Sint32 armor = statGetCON(stat, playerEntity);
 
 	if ( stat->helmet )
 	{
@@ -9970,6 +10052,30 @@ int AC(Stat* stat)
 	return armor;
 }
 
+int AC(Stat* stat)
+{
+	if ( !stat )
+	{
+		return 0;
+	}
+
+	Entity* playerEntity = nullptr;
+	for ( int i = 0; i < MAXPLAYERS; ++i )
+	{
+		if ( stat && stats[i] == stat )
+		{
+			if ( players[i] && players[i]->entity )
+			{
+				playerEntity = players[i]->entity;
+				break;
+			}
+		}
+	}
+
+	// defending is toggled from input every frame, so it is part of the cache key.
+	return statGetCached(stat, playerEntity, Stat::DERIVED_AC, stat->defending ? 1 : 0, &statComputeAC);
+}
+
 /*-------------------------------------------------------------------------------
 
 Entity::teleport
@@ -10440,14 +10546,14 @@ void Entity::awardXP(Entity* src, bool share, bool root)
 
 		// find other players to divide shares with
 		node_t* node;
-		for ( node = map.creatures->first; node != nullptr; node = node->next ) //Since only looking at players, this should just iterate over players[]
+		for ( int i = 0; i < MAXPLAYERS; ++i ) //Only looking at players.
 		{
-			Entity* entity = (Entity*)node->element;
+			Entity* entity = players[i] ? players[i]->entity : nullptr;
 			if ( entity == this )
 			{
 				continue;
 			}
-			if ( entity && entity->behavior == &actPlayer )
+			if ( entity )
 			{
 				if ( entityDist(this, entity) < shareRange )
 				{
@@ -14191,6 +14297,7 @@ bool Entity::setEffect(int effect, bool value, int duration, bool updateClients,
 	}
 	myStats->EFFECTS[effect] = value;
 	myStats->EFFECTS_TIMERS[effect] = duration;
+	myStats->invalidateDerivedStats();
 
 	int player = -1;
 	for ( int i = 0; i < MAXPLAYERS; ++i )
@@ -17461,6 +17568,14 @@ void Entity::addToCreatureList(list_t *list)
 		myCreatureListNode->deconstructor = &emptyDeconstructor;
 		myCreatureListNode->size = sizeof(Entity);
 		//printlog("Added dennis to creature list.");
+		if ( myCreatureGridNode )
+		{
+			CreatureIndex.removeEntity(*this); // re-added from the game loop if this is map.creatures
+		}
+		if ( !LevelPrefetch.onWorkerThread() )
+		{
+			CreatureIndex.markRaceCountsDirty(); // applyStagedLevel() marks it for the staged floor
+		}
 	}
 }
 
@@ -17617,7 +17732,7 @@ bool monsterNameIsGeneric(Stat& monsterStats)
 
 node_t* TileEntityListHandler::addEntity(Entity& entity)
 {
-	if ( entity.myTileListNode )
+	if ( entity.myTileListNode || entity.attachedLimb )
 	{
 		return nullptr;
 	}
@@ -17644,6 +17759,10 @@ node_t* TileEntityListHandler::addEntity(Entity& entity)
 
 node_t* TileEntityListHandler::updateEntity(Entity& entity)
 {
+	if ( entity.myCreatureGridNode )
+	{
+		CreatureIndex.updateEntity(entity);
+	}
 	if ( !entity.myTileListNode )
 	{
 		return nullptr;
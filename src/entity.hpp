@@ -42,6 +42,7 @@ struct spell_t;
 // entity class
 class Entity
 {
+	friend class CircuitGraphHandler; // reads and sets circuit_status for whole wire networks
 	Sint32& char_gonnavomit;
 	Sint32& char_heal;
 	Sint32& char_energize;
@@ -511,6 +512,16 @@ public:
 	node_t* myCreatureListNode;
 	node_t* myTileListNode;
 	node_t* myWorldUIListNode;
+	node_t* myCreatureGridNode; // location in CreatureIndex, only set for members of map.creatures
+
+	// set by limbs once they've run their behavior. attached limbs follow their
+	// parent every tick and are always PASSABLE, so they stay out of TileEntityList.
+	// they are otherwise still full entities in map.entities: drawEntities3D() draws
+	// them from there, the selection buffer and BDYI address them by uid, and torches
+	// and lanterns hang their light off them
+	bool attachedLimb;
+	Uint32 bodypartsPendingUpdate; // bitmask of children awaiting serverUpdateEntityBodypart()
+	void attachAsLimb();
 
 	list_t* path; // pathfinding stuff. Most of the code currently stuffs that into children, but the magic code makes use of this variable instead.
 
@@ -624,7 +635,6 @@ public:
 	void mechanismPowerOff(); //Called when a circuit or switch next to a mechanism powers on.
 	void toggleSwitch(); //Called when a player flips a switch (lever).
 	void switchUpdateNeighbors(); //Run each time actSwitch() is called to make sure the network is online if any one switch connected to it is still set to the on position.
-	list_t* getPowerableNeighbors(); //Returns a list of all circuits and mechanisms this entity can influence.
 
 	//Chest/container functions.
 	void closeChest();
@@ -984,7 +994,6 @@ void actSink(Entity* my);
 //--- Mechanism functions ---
 void actCircuit(Entity* my);
 void actSwitch(Entity* my); //Needs to be called periodically to ensure network's powered state is correct.
-void getPowerablesOnTile(int x, int y, list_t** list); //Stores a list of all circuits and mechanisms, on the tile (in map coordinates), in list.
 void actGate(Entity* my);
 void actArrowTrap(Entity* my);
 void actTrap(Entity* my);
@@ -999,6 +1008,58 @@ void actSwitchWithTimer(Entity* my);
  * * Mechanism only: If skill[28] == 3, it's powered on and the entity already processed it. Sort of combining a mechanism->powered and mechanism->powered_last_frame variable into one. Not sure if it's necessary, but I thought it did when I came up with this, so there you have it.
  */
 
+/*
+ * Wires (actCircuit) grouped into connected components, with the powerables each
+ * component touches. Built from map.entities the first time power moves after a
+ * level loads, then kept up to date as powerables are added and removed, so a
+ * switch powers a whole network with one pass over its component.
+ * Powerables are assumed not to move once placed.
+ */
+class CircuitGraphHandler
+{
+private:
+	struct TileNode_t
+	{
+		Entity* entity;
+		int component; // -1 if this isn't a wire
+	};
+	struct Component_t
+	{
+		std::vector<Entity*> wires;
+		std::vector<Entity*> mechanisms; // powerables next to a wire, signal timers only from their input side
+	};
+
+	bool dirty = true;
+	int width = 0;
+	int height = 0;
+	std::vector<std::vector<TileNode_t>> tiles;
+	std::vector<Component_t> components;
+	std::vector<int> freeComponents;
+	std::vector<int> staleComponents; // lost a wire, flooded again before power next moves
+	std::vector<Entity*> floodStack;
+
+	void build();
+	void refloodStaleComponents();
+	void prepare();
+	std::vector<TileNode_t>* getTile(int x, int y);
+	TileNode_t* findNode(Entity& entity);
+	int newComponent();
+	void floodComponent(int id, Entity& start);
+	void attachMechanism(Entity& mechanism);
+	void attachMechanismToWire(Entity& mechanism, const TileNode_t& wire);
+public:
+	void reset() { dirty = true; } // called when a new level is loaded
+	void addPowerable(Entity& entity);
+	void removePowerable(Entity& entity);
+
+	// sets every wire in the wire's component and notifies everything attached to it
+	void powerWire(Entity& wire, bool powerOn);
+	// powers the source's tile and the four next to it, like a switch does
+	void powerNeighbors(Entity& source, bool powerOn, bool onlyUnpowered);
+	void powerTile(Entity& source, int x, int y, bool powerOn, bool onlyUnpowered);
+};
+extern CircuitGraphHandler CircuitGraph;
+
 //---Chest/container functions---
 void actChest(Entity* my);
 void actChestLid(Entity* my);
@@ -1068,7 +1129,7 @@ int setGloveSprite(Stat * myStats, Entity* ent, int spriteOffset);
 bool isLevitating(Stat * myStats);
 int getWeaponSkill(Item* weapon);
 int getStatForProficiency(int skill);
-void setSpriteAttributes(Entity* entityToSet, Entity* entityToCopy, Entity* entityStatToCopy);
+void setSpriteAttributes(Entity* entityToSet, Entity* entityToCopy, Entity* entityStatToCopy, const StatRolls_t* statRolls = nullptr);
 bool monsterIsImmobileTurret(Entity* my, Stat* myStats);
 bool monsterChangesColorWhenAlly(Stat* myStats, Entity* entity = nullptr);
 int monsterTinkeringConvertHPToAppearance(Stat* myStats);
@@ -327,6 +327,7 @@ Entity::Entity(Sint32 in_sprite, Uint32 pos, list_t* entlist, list_t* creatureli
 	mynode->size = sizeof(Entity);
 
 	myCreatureListNode = nullptr;
+	myCreatureGridNode = nullptr;
 
 	// now reset all of my data elements
 	lastupdate = 0;
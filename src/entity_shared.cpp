@@ -1288,7 +1288,7 @@ int canWearEquip(Entity* entity, int category)
 	return 0;
 }
 
-void setSpriteAttributes(Entity* entityNew, Entity* entityToCopy, Entity* entityStatToCopy)
+void setSpriteAttributes(Entity* entityNew, Entity* entityToCopy, Entity* entityStatToCopy, const StatRolls_t* statRolls)
 {
 	Stat* tmpStats = nullptr;
 	if ( !entityNew )
@@ -1324,7 +1324,7 @@ void setSpriteAttributes(Entity* entityNew, Entity* entityToCopy, Entity* entity
 			else
 			{
 				// if the previous sprite did not have stats initialised, or creating a new entity.
-				myStats = new Stat(entityNew->sprite);
+				myStats = new Stat(entityNew->sprite, statRolls);
 				node2->element = myStats;
 				node2->size = sizeof(myStats);
 			}
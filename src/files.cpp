@@ -26,6 +26,8 @@
 #include "items.hpp"
 #include "interface/interface.hpp"
 #include "mod_tools.hpp"
+#include "texture_atlas.hpp"
+#include "level_prefetch.hpp"
 
 std::vector<int> gamemods_modelsListModifiedIndexes;
 std::vector<std::pair<SDL_Surface**, std::string>> systemResourceImagesToReload;
@@ -480,6 +482,14 @@ const std::vector<std::string> officialSecretlevelsTxtOrder =
 
 void glLoadTexture(SDL_Surface* image, int texnum)
 {
+	if ( headless )
+	{
+		return; // keep the surface, there's no GL context to upload to
+	}
+	if ( !image->pixels )
+	{
+		return; // pixels were dropped after packing, see TextureAtlasHandler::rebuild()
+	}
 	SDL_LockSurface(image);
 	glEnable(GL_TEXTURE_2D);
 	glBindTexture(GL_TEXTURE_2D, texid[texnum]);
@@ -666,6 +676,116 @@ voxel_t* loadVoxel(char* filename)
 	}
 }
 
+/*-------------------------------------------------------------------------------
+
+	resetMapState
+
+	resets everything sized by or tied to the level in the global map:
+	lightmap, vismap, minimap, cameras, shop tiles and so on. called once
+	a level is in the global map, whether loadMap() read it or the level
+	prefetch worker built it
+
+-------------------------------------------------------------------------------*/
+
+void resetMapState(const char* oldmapname)
+{
+	Uint32 c;
+	Sint32 x, y;
+
+	nummonsters = 0;
+	minotaurlevel = 0;
+
+#if defined (USE_FMOD) || defined(USE_OPENAL)
+	if ( strcmp(oldmapname, map.name) )
+	{
+		if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT )
+		{
+			levelmusicplaying = false;
+		}
+	}
+#endif
+
+	// create new lightmap
+	if ( lightmap != NULL )
+	{
+		free(lightmap);
+	}
+	if ( lightmapSmoothed )
+	{
+		free(lightmapSmoothed);
+	}
+
+	lightmap = (int*) malloc(sizeof(Sint32) * map.width * map.height);
+	lightmapSmoothed = (int*)malloc(sizeof(Sint32) * map.width * map.height);
+	if ( strncmp(map.name, "Hell", 4) )
+	{
+		for (c = 0; c < map.width * map.height; c++ )
+		{
+			lightmap[c] = 0;
+			lightmapSmoothed[c] = 0;
+		}
+	}
+	else
+	{
+		for (c = 0; c < map.width * map.height; c++ )
+		{
+			lightmap[c] = 32;
+			lightmapSmoothed[c] = 32;
+		}
+	}
+
+
+	// create a new vismap
+	vismap.resize(map.width, map.height);
+
+	// reset minimap
+	for ( x = 0; x < MINIMAP_MAX_DIMENSION; x++ )
+	{
+		for ( y = 0; y < MINIMAP_MAX_DIMENSION; y++ )
+		{
+			minimap[y][x] = 0;
+		}
+	}
+
+	// reset cameras
+	for (int c = 0; c < MAXPLAYERS; ++c) {
+		auto& camera = cameras[c];
+		if ( game )
+		{
+			camera.x = -32;
+			camera.y = -32;
+			camera.z = 0;
+			camera.ang = 3 * PI / 2;
+			camera.vang = 0;
+		}
+		else
+		{
+			camera.x = 2;
+			camera.y = 2;
+			camera.z = 0;
+			camera.ang = 0;
+			camera.vang = 0;
+		}
+	}
+
+	// shoparea
+	if ( shoparea )
+	{
+		free(shoparea);
+	}
+	shoparea = (bool*) malloc(sizeof(bool) * map.width * map.height);
+	for ( x = 0; x < map.width; x++ )
+		for ( y = 0; y < map.height; y++ )
+		{
+			shoparea[y + x * map.height] = false;
+		}
+
+	for ( c = 0; c < 512; c++ )
+	{
+		keystatus[c] = 0;
+	}
+}
+
 /*-------------------------------------------------------------------------------
 
 	loadMap
@@ -674,7 +794,7 @@ voxel_t* loadVoxel(char* filename)
 
 -------------------------------------------------------------------------------*/
 
-int loadMap(const char* filename2, map_t* destmap, list_t* entlist, list_t* creatureList, int *checkMapHash)
+int loadMap(const char* filename2, map_t* destmap, list_t* entlist, list_t* creatureList, int *checkMapHash, const StatRolls_t* statRolls)
 {
 	File* fp;
 	char valid_data[16];
@@ -694,8 +814,13 @@ int loadMap(const char* filename2, map_t* destmap, list_t* entlist, list_t* crea
 		*checkMapHash = 0;
 	}
 
-	char oldmapname[64];
-	strcpy(oldmapname, map.name);
+	// the global map is only ours to read when it's the one being loaded,
+	// the level prefetch worker loads floors alongside the game
+	char oldmapname[64] = "";
+	if ( destmap == &map )
+	{
+		strcpy(oldmapname, map.name);
+	}
 
 	printlog("LoadMap %s", filename2);
 
@@ -895,7 +1020,7 @@ int loadMap(const char* filename2, map_t* destmap, list_t* entlist, list_t* crea
 							node2->element = NULL;
 							node2->deconstructor = &emptyDeconstructor;
 
-							myStats = new Stat(entity->sprite);
+							myStats = new Stat(entity->sprite, statRolls);
 							node2 = list_AddNodeLast(&entity->children);
 							node2->element = myStats;
 							node2->size = sizeof(myStats);
@@ -949,7 +1074,7 @@ int loadMap(const char* filename2, map_t* destmap, list_t* entlist, list_t* crea
 						//Read dummy values to move fp for the client
 						else
 						{
-							dummyStats = new Stat(entity->sprite);
+							dummyStats = new Stat(entity->sprite, statRolls);
 							fp->read(&dummyStats->sex, sizeof(sex_t), 1);
 							fp->read(&dummyStats->name, sizeof(char[128]), 1);
 							fp->read(&dummyStats->HP, sizeof(Sint32), 1);
@@ -1202,105 +1327,9 @@ int loadMap(const char* filename2, map_t* destmap, list_t* entlist, list_t* crea
 
 	if ( destmap == &map )
 	{
-		nummonsters = 0;
-		minotaurlevel = 0;
-
-#if defined (USE_FMOD) || defined(USE_OPENAL)
-		if ( strcmp(oldmapname, map.name) )
-		{
-			if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT )
-			{
-				levelmusicplaying = false;
-			}
-		}
-#endif
-
-		// create new lightmap
-		if ( lightmap != NULL )
-		{
-			free(lightmap);
-		}
-		if ( lightmapSmoothed )
-		{
-			free(lightmapSmoothed);
-		}
-
-		lightmap = (int*) malloc(sizeof(Sint32) * destmap->width * destmap->height);
-		lightmapSmoothed = (int*)malloc(sizeof(Sint32) * destmap->width * destmap->height);
-		if ( strncmp(map.name, "Hell", 4) )
-		{
-			for (c = 0; c < destmap->width * destmap->height; c++ )
-			{
-				lightmap[c] = 0;
-				lightmapSmoothed[c] = 0;
-			}
-		}
-		else
-		{
-			for (c = 0; c < destmap->width * destmap->height; c++ )
-			{
-				lightmap[c] = 32;
-				lightmapSmoothed[c] = 32;
-			}
-		}
-
-
-		// create a new vismap
-		if (vismap != NULL)
-		{
-			free(vismap);
-		}
-		vismap = (bool*) calloc(destmap->width * destmap->height, sizeof(bool));
-
-		// reset minimap
-		for ( x = 0; x < MINIMAP_MAX_DIMENSION; x++ )
-		{
-			for ( y = 0; y < MINIMAP_MAX_DIMENSION; y++ )
-			{
-				minimap[y][x] = 0;
-			}
-		}
-
-		// reset cameras
-		for (int c = 0; c < MAXPLAYERS; ++c) {
-			auto& camera = cameras[c];
-			if ( game )
-			{
-				camera.x = -32;
-				camera.y = -32;
-				camera.z = 0;
-				camera.ang = 3 * PI / 2;
-				camera.vang = 0;
-			}
-			else
-			{
-				camera.x = 2;
-				camera.y = 2;
-				camera.z = 0;
-				camera.ang = 0;
-				camera.vang = 0;
-			}
-		}
-
-		// shoparea
-		if ( shoparea )
-		{
-			free(shoparea);
-		}
-		shoparea = (bool*) malloc(sizeof(bool) * destmap->width * destmap->height);
-		for ( x = 0; x < destmap->width; x++ )
-			for ( y = 0; y < destmap->height; y++ )
-			{
-				shoparea[y + x * destmap->height] = false;
-			}
+		resetMapState(oldmapname);
 	}
 
-	for ( c = 0; c < 512; c++ )
-	{
-		keystatus[c] = 0;
-	}
-
-
 	if ( checkMapHash != nullptr )
 	{
 		std::string mapShortName = filename2;
@@ -1741,133 +1770,172 @@ std::vector<std::string> getLinesFromDataFile(std::string filename)
 	return lines;
 }
 
-int physfsLoadMapFile(int levelToLoad, Uint32 seed, bool useRandSeed, int* checkMapHash)
+/*-------------------------------------------------------------------------------
+
+	physfsLevelLine
+
+	returns the levels.txt (or secretlevels.txt) line describing the given
+	floor, or "map: " and the custom map a portal is sending the party to.
+	the last line of the list is used for every floor past its end
+
+-------------------------------------------------------------------------------*/
+
+std::string physfsLevelLine(int levelToLoad, bool secret, const std::string& customMap)
 {
-	std::string mapsDirectory; // store the full file path here.
-	std::string line = "";
-	if ( loadCustomNextMap.compare("") != 0 )
+	if ( !customMap.empty() )
 	{
-		line = "map: " + loadCustomNextMap;
-		loadCustomNextMap = "";
+		return "map: " + customMap;
 	}
-	else
+	const char* levelsFile = secret ? SECRETLEVELSFILE : LEVELSFILE;
+	const char* realDir = PHYSFS_getRealDir(levelsFile);
+	if ( !realDir )
+	{
+		printlog("error: couldn't find %s", levelsFile);
+		return "";
+	}
+	std::string mapsDirectory = realDir; // store the full file path here.
+	mapsDirectory.append(PHYSFS_getDirSeparator()).append(levelsFile);
+	printlog("Maps directory: %s", mapsDirectory.c_str());
+	std::vector<std::string> levelsList = getLinesFromDataFile(mapsDirectory);
+	if ( levelsList.empty() )
+	{
+		return "";
+	}
+	// if level == 0, then load up the first map.
+	return levelsList[std::min<size_t>(std::max(levelToLoad, 0), levelsList.size() - 1)];
+}
+
+/*-------------------------------------------------------------------------------
+
+	physfsParseLevelLine
+
+	splits a line from physfsLevelLine() into its type ("map:" or "gen:"),
+	the map or level set name, and the parameters of a "gen:" line
+
+-------------------------------------------------------------------------------*/
+
+bool physfsParseLevelLine(const std::string& line, std::string& mapType, std::string& mapName, std::tuple<int, int, int, int>& mapParameters)
+{
+	mapParameters = std::make_tuple(-1, -1, -1, 0);
+	std::size_t found = line.find(' ');
+	if ( found == std::string::npos )
 	{
-		if ( !secretlevel )
+		return false;
+	}
+	mapType = line.substr(0, found);
+	mapName = line.substr(found + 1, line.find('\n'));
+	std::size_t carriageReturn = mapName.find('\r');
+	if ( carriageReturn != std::string::npos )
+	{
+		mapName.erase(carriageReturn);
+		printlog("%s", mapName.c_str());
+	}
+	if ( mapType.compare("gen:") == 0 )
+	{
+		std::size_t secretChanceFound = mapName.find(" secret%: ");
+		std::size_t darkmapChanceFound = mapName.find(" darkmap%: ");
+		std::size_t minotaurChanceFound = mapName.find(" minotaur%: ");
+		std::size_t disableNormalExitFound = mapName.find(" noexit");
+		std::string parameterStr = "";
+		if ( secretChanceFound != std::string::npos )
 		{
-			mapsDirectory = PHYSFS_getRealDir(LEVELSFILE);
-			mapsDirectory.append(PHYSFS_getDirSeparator()).append(LEVELSFILE);
+			// found a percentage for secret levels to spawn.
+			parameterStr = mapName.substr(secretChanceFound + strlen(" secret%: "));
+			parameterStr = parameterStr.substr(0, parameterStr.find_first_of(" \0"));
+			std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) = std::stoi(parameterStr);
+			if ( std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) < 0 || std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) > 100 )
+			{
+				std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) = -1;
+			}
 		}
-		else
+		if ( darkmapChanceFound != std::string::npos )
 		{
-			mapsDirectory = PHYSFS_getRealDir(SECRETLEVELSFILE);
-			mapsDirectory.append(PHYSFS_getDirSeparator()).append(SECRETLEVELSFILE);
+			// found a percentage for secret levels to spawn.
+			parameterStr = mapName.substr(darkmapChanceFound + strlen(" darkmap%: "));
+			parameterStr = parameterStr.substr(0, parameterStr.find_first_of(" \0"));
+			std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) = std::stoi(parameterStr);
+			if ( std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) < 0 || std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) > 100 )
+			{
+				std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) = -1;
+			}
 		}
-		printlog("Maps directory: %s", mapsDirectory.c_str());
-		std::vector<std::string> levelsList = getLinesFromDataFile(mapsDirectory);
-		line = levelsList.front();
-		int levelsCounted = 0;
-		if ( levelToLoad > 0 ) // if level == 0, then load up the first map.
+		if ( minotaurChanceFound != std::string::npos )
 		{
-			for ( std::vector<std::string>::const_iterator i = levelsList.begin(); i != levelsList.end() && levelsCounted <= levelToLoad; ++i )
+			// found a percentage for secret levels to spawn.
+			parameterStr = mapName.substr(minotaurChanceFound + strlen(" minotaur%: "));
+			parameterStr = parameterStr.substr(0, parameterStr.find_first_of(" \0"));
+			std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) = std::stoi(parameterStr);
+			if ( std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) < 0 || std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) > 100 )
 			{
-				// process i, iterate through all the map levels until currentlevel.
-				line = *i;
-				if ( line[0] == '\n' )
-				{
-					continue;
-				}
-				++levelsCounted;
+				std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) = -1;
 			}
 		}
+		if ( disableNormalExitFound != std::string::npos )
+		{
+			std::get<LEVELPARAM_DISABLE_NORMAL_EXIT>(mapParameters) = 1;
+		}
+		mapName = mapName.substr(0, mapName.find_first_of(" \0"));
 	}
-	std::size_t found = line.find(' ');
+	return true;
+}
+
+int physfsLoadMapFile(int levelToLoad, Uint32 seed, bool useRandSeed, int* checkMapHash)
+{
+	std::string line = physfsLevelLine(levelToLoad, secretlevel, loadCustomNextMap);
+	loadCustomNextMap = "";
+
+	// the prefetch worker may have built this floor already
+	int result = 0;
+	if ( useRandSeed )
+	{
+		LevelPrefetch.cancel();
+	}
+	else if ( LevelPrefetch.applyStagedLevel(line, seed, levelToLoad, secretlevel, checkMapHash, result) )
+	{
+		LevelPrefetch.start(levelToLoad + 1, secretlevel);
+		return result;
+	}
+
+	std::string mapType;
+	std::string mapName;
+	std::tuple<int, int, int, int> mapParameters;
 	char tempstr[1024];
-	if ( found != std::string::npos )
+	if ( physfsParseLevelLine(line, mapType, mapName, mapParameters) )
 	{
-		std::string mapType = line.substr(0, found);
-		std::string mapName;
-		mapName = line.substr(found + 1, line.find('\n'));
-		std::size_t carriageReturn = mapName.find('\r');
-		if ( carriageReturn != std::string::npos )
-		{
-			mapName.erase(carriageReturn);
-			printlog("%s", mapName.c_str());
-		}
 		if ( mapType.compare("map:") == 0 )
 		{
 			strncpy(tempstr, mapName.c_str(), mapName.length());
 			tempstr[mapName.length()] = '\0';
 			mapName = physfsFormatMapName(tempstr);
-			if ( checkMapHash )
-			{
-				return loadMap(mapName.c_str(), &map, map.entities, map.creatures, checkMapHash);
-			}
-			else
-			{
-				return loadMap(mapName.c_str(), &map, map.entities, map.creatures);
-			}
+#ifndef EDITOR
+			// roll the creatures' stats the way the prefetch worker would have
+			PrngStream_t statRng;
+			seedStatRolls(statRng, useRandSeed ? rand() : seed);
+			const StatRolls_t statRolls = statRollsFrom(statRng);
+			result = loadMap(mapName.c_str(), &map, map.entities, map.creatures, checkMapHash, &statRolls);
+#else
+			result = loadMap(mapName.c_str(), &map, map.entities, map.creatures, checkMapHash);
+#endif
 		}
 		else if ( mapType.compare("gen:") == 0 )
 		{
-			std::size_t secretChanceFound = mapName.find(" secret%: ");
-			std::size_t darkmapChanceFound = mapName.find(" darkmap%: ");
-			std::size_t minotaurChanceFound = mapName.find(" minotaur%: ");
-			std::size_t disableNormalExitFound = mapName.find(" noexit");
-			std::string parameterStr = "";
-			std::tuple<int, int, int, int> mapParameters = std::make_tuple(-1, -1, -1, 0);
-			if ( secretChanceFound != std::string::npos )
-			{
-				// found a percentage for secret levels to spawn.
-				parameterStr = mapName.substr(secretChanceFound + strlen(" secret%: "));
-				parameterStr = parameterStr.substr(0, parameterStr.find_first_of(" \0"));
-				std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) = std::stoi(parameterStr);
-				if ( std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) < 0 || std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) > 100 )
-				{
-					std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) = -1;
-				}
-			}
-			if ( darkmapChanceFound != std::string::npos )
-			{
-				// found a percentage for secret levels to spawn.
-				parameterStr = mapName.substr(darkmapChanceFound + strlen(" darkmap%: "));
-				parameterStr = parameterStr.substr(0, parameterStr.find_first_of(" \0"));
-				std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) = std::stoi(parameterStr);
-				if ( std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) < 0 || std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) > 100 )
-				{
-					std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) = -1;
-				}
-			}
-			if ( minotaurChanceFound != std::string::npos )
-			{
-				// found a percentage for secret levels to spawn.
-				parameterStr = mapName.substr(minotaurChanceFound + strlen(" minotaur%: "));
-				parameterStr = parameterStr.substr(0, parameterStr.find_first_of(" \0"));
-				std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) = std::stoi(parameterStr);
-				if ( std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) < 0 || std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) > 100 )
-				{
-					std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) = -1;
-				}
-			}
-			if ( disableNormalExitFound != std::string::npos )
-			{
-				std::get<LEVELPARAM_DISABLE_NORMAL_EXIT>(mapParameters) = 1;
-			}
-			mapName = mapName.substr(0, mapName.find_first_of(" \0"));
-
 			strncpy(tempstr, mapName.c_str(), mapName.length());
 			tempstr[mapName.length()] = '\0';
 			if ( useRandSeed )
 			{
-				return generateDungeon(tempstr, rand(), mapParameters);
+				result = generateDungeon(tempstr, rand(), mapParameters);
 			}
 			else
 			{
-				return generateDungeon(tempstr, seed, mapParameters);
+				result = generateDungeon(tempstr, seed, mapParameters);
 			}
 		}
 		//printlog("%s", mapName.c_str());
 	}
-	return 0;
+
+	// start on the following floor while this one is played
+	LevelPrefetch.start(levelToLoad + 1, secretlevel);
+	return result;
 }
 
 std::list<std::string> physfsGetFileNamesInDirectory(const char* dir)
@@ -2216,6 +2284,7 @@ void physfsReloadSprites(bool reloadAll) //TODO: NX PORT: Any changes needed her
 				char fullname[PATH_MAX];
 				strncpy(fullname, spriteFile.c_str(), PATH_MAX - 1);
 				sprites[c] = loadImage(fullname);
+				TextureAtlas.add(&sprites[c], fullname, false);
 				if ( nullptr != sprites[c]  )
 				{
 					//Whee
@@ -2234,6 +2303,7 @@ void physfsReloadSprites(bool reloadAll) //TODO: NX PORT: Any changes needed her
 		}
 	}
 	FileIO::close(fp);
+	TextureAtlas.build();
 }
 
 bool physfsSearchTilesToUpdate()
@@ -2286,6 +2356,7 @@ void physfsReloadTiles(bool reloadAll)
 				char fullname[PATH_MAX];
 				strncpy(fullname, tileFile.c_str(), PATH_MAX - 1);
 				tiles[c] = loadImage(fullname);
+				TextureAtlas.add(&tiles[c], fullname, false);
 				animatedtiles[c] = false;
 				lavatiles[c] = false;
 				swimmingtiles[c] = false;
@@ -2323,6 +2394,7 @@ void physfsReloadTiles(bool reloadAll)
 		}
 	}
 	FileIO::close(fp);
+	TextureAtlas.build();
 }
 
 bool physfsIsMapLevelListModded()
@@ -2487,6 +2559,7 @@ void physfsReloadItemSprites(bool reloadAll)
 			{
 				nextnode = node->next;
 				SDL_Surface** surface = (SDL_Surface**)node->element;
+				TextureAtlas.remove(surface);
 				if ( surface )
 				{
 					if ( *surface )
@@ -2521,9 +2594,11 @@ void physfsReloadItemSprites(bool reloadAll)
 				char imgFileChar[256];
 				strncpy(imgFileChar, itemImgDir.c_str(), 255);
 				*surface = loadImage(imgFileChar);
+				TextureAtlas.add(surface, imgFileChar, true);
 			}
 		}
 	}
+	TextureAtlas.build();
 }
 
 bool physfsSearchItemsTxtToUpdate()
@@ -19,6 +19,8 @@
 
 #include "main.hpp"
 
+struct StatRolls_t;
+
 //This class provides a common platform-independent interface for file accesses. Deriving classes must provide an implementation for all of these methods, but may make use of any common routines or common portions of routines.
 //Don't create a FileBase or derivative class directly, use FileIO::open to get one...
 class FileBase {
@@ -245,7 +247,8 @@ extern char outputdir[PATH_MAX];
 void glLoadTexture(SDL_Surface* image, int texnum);
 SDL_Surface* loadImage(char const * const filename);
 voxel_t* loadVoxel(char* filename2);
-int loadMap(const char* filename, map_t* destmap, list_t* entlist, list_t* creatureList, int *checkMapHash = nullptr);
+int loadMap(const char* filename, map_t* destmap, list_t* entlist, list_t* creatureList, int *checkMapHash = nullptr, const StatRolls_t* statRolls = nullptr);
+void resetMapState(const char* oldmapname);
 int loadConfig(char* filename);
 int loadDefaultConfig();
 int saveMap(const char* filename);
@@ -258,6 +261,8 @@ bool completePath(char *dest, const char * const path, const char *base = datadi
 void openLogFile();
 std::vector<std::string> getLinesFromDataFile(std::string filename);
 int loadMainMenuMap(bool blessedAdditionMaps, bool forceVictoryMap);
+std::string physfsLevelLine(int levelToLoad, bool secret, const std::string& customMap);
+bool physfsParseLevelLine(const std::string& line, std::string& mapType, std::string& mapName, std::tuple<int, int, int, int>& mapParameters);
 int physfsLoadMapFile(int levelToLoad, Uint32 seed, bool useRandSeed, int *checkMapHash = nullptr);
 std::list<std::string> physfsGetFileNamesInDirectory(const char* dir);
 std::string physfsFormatMapName(char const * const levelfilename);
@@ -38,6 +38,9 @@
 #include "player.hpp"
 #include "mod_tools.hpp"
 #include "lobbies.hpp"
+#include "dedicated_server.hpp"
+#include "net_simulator.hpp"
+#include "level_prefetch.hpp"
 #include "interface/ui.hpp"
 #include "ui/GameUI.hpp"
 #include <limits>
@@ -201,6 +204,8 @@ std::vector<std::string> randomPlayerNamesMale;
 std::vector<std::string> randomPlayerNamesFemale;
 std::vector<std::string> physFSFilesInDirectory;
 TileEntityListHandler TileEntityList;
+CreatureIndexHandler CreatureIndex;
+MonsterAILODHandler MonsterAILOD;
 // recommended for valgrind debugging:
 // res of 480x270
 // /nohud
@@ -437,28 +442,8 @@ void gameLogic(void)
 	}
 
 	// handle safe packets
-	if ( !(ticks % 4) )
-	{
-		j = 0;
-		for ( node = safePacketsSent.first; node != nullptr; node = nextnode )
-		{
-			nextnode = node->next;
-
-			packetsend_t* packet = (packetsend_t*)node->element;
-			//printlog("Packet resend: %d", packet->hostnum);
-			sendPacket(packet->sock, packet->channel, packet->packet, packet->hostnum, true);
-			packet->tries++;
-			if ( packet->tries >= MAXTRIES )
-			{
-				list_RemoveNode(node);
-			}
-			j++;
-			if ( j >= MAXDELETES )
-			{
-				break;
-			}
-		}
-	}
+	SafePacketHandler.update();
+	NetSimulator.update();
 
 	// spawn flame particles on burning objects
 	if ( !gamePaused || (multiplayer && !client_disconnected[0]) )
@@ -988,6 +973,15 @@ void gameLogic(void)
 							{
 								TileEntityList.addEntity(*entity);
 							}
+							if ( entity->myCreatureGridNode )
+							{
+								// catches knockback etc. applied during other entities' turns.
+								CreatureIndex.updateEntity(*entity);
+							}
+							else if ( entity->myCreatureListNode && entity->myCreatureListNode->list == map.creatures )
+							{
+								CreatureIndex.addEntity(*entity);
+							}
 
 							/*if ( entity->getUID() >= 0 && entity->behavior != &actFlame && !entity->flags[INVISIBLE]
 								&& entity->behavior != &actDoor && entity->behavior != &actDoorFrame
@@ -1172,6 +1166,7 @@ void gameLogic(void)
 
 					// show loading message
 					loading = true;
+					LevelPrefetch.wait(); // the worker reads state the level change is about to reset
 					drawClearBuffers();
 					int w, h;
 					getSizeOfText(ttf16, language[709], &w, &h);
@@ -1230,7 +1225,7 @@ void gameLogic(void)
 					}
 
 					// signal clients about level change
-					mapseed = rand();
+					mapseed = LevelPrefetch.nextMapSeed();
 					lastEntityUIDs = entity_uids;
 					if ( forceMapSeed > 0 )
 					{
@@ -1637,6 +1632,9 @@ void gameLogic(void)
 			DebugStats.eventsT4 = std::chrono::high_resolution_clock::now();
 			if ( multiplayer == SERVER )
 			{
+				// one packet per creature for the bodyparts its behavior changed this tick
+				serverSendPendingBodyparts();
+
 				// periodically remind clients of the current level
 				if ( ticks % (TICKS_PER_SECOND * 3) == 0 )
 				{
@@ -4654,6 +4652,23 @@ int main(int argc, char** argv)
 					{
 						no_sound = true;
 					}
+					else if ( !strncmp(argv[c], "-dedicated", 10) && (argv[c][10] == '\0' || argv[c][10] == '=') )
+					{
+						headless = true;
+						no_sound = true;
+						if ( argv[c][10] == '=' )
+						{
+							DedicatedServer.port = (Uint16)atoi(argv[c] + 11);
+						}
+					}
+					else if ( !strncmp(argv[c], "-dedicatedplayers=", 18) )
+					{
+						DedicatedServer.playersToStart = std::max(1, std::min(MAXPLAYERS - 1, atoi(argv[c] + 18)));
+					}
+					else if ( !strncmp(argv[c], "-dedicatedstats=", 16) )
+					{
+						DedicatedServer.statsInterval = std::max(0, atoi(argv[c] + 16));
+					}
 					else
 					{
 #ifdef USE_EOS
@@ -4766,6 +4781,15 @@ int main(int argc, char** argv)
 		// initialize player conducts
 		setDefaultPlayerConducts();
 
+		if ( headless )
+		{
+			// the dedicated server runs its own fixed-step loop instead of the timer and main loop below
+			c = DedicatedServer.run();
+			deinitGame();
+			deinitApp();
+			return c;
+		}
+
 		// instantiate a timer
 #ifdef NINTENDO
 		lastTick = std::chrono::steady_clock::now();
@@ -5176,6 +5200,8 @@ int main(int argc, char** argv)
 							shopInv[i] = (list_t*) malloc(sizeof(list_t));
 							shopInv[i]->first = NULL;
 							shopInv[i]->last = NULL;
+							shopInv[i]->flags = 0;
+							attachInventoryIndex(shopInv[i], &shopInvIndex[i]);
 						}
 					}
 				}
@@ -40,18 +40,6 @@ extern real_t mousespeed;
 void handleEvents(void);
 void startMessages();
 
-// net packet send
-typedef struct packetsend_t
-{
-	UDPsocket sock;
-	int channel;
-	UDPpacket* packet;
-	int num;
-	int tries;
-	int hostnum;
-} packetsend_t;
-extern list_t safePacketsSent;
-extern std::unordered_map<int, Uint32> safePacketsReceivedMap[MAXPLAYERS];
 extern bool receivedclientnum;
 
 extern Uint32 clientplayer;
@@ -388,6 +376,7 @@ public:
 extern TileEntityListHandler TileEntityList;
 
 extern float framerateAccumulatedTime;
+extern Uint64 lastGameTickCount;
 
 class DebugStatsClass
 {
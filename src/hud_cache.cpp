@@ -0,0 +1,223 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: hud_cache.cpp
+Desc: retained draw lists and frame timers for the HUD
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "hud_cache.hpp"
+
+HudCacheHandler HudCache;
+
+/*-------------------------------------------------------------------------------
+
+	HudCacheHandler::begin
+
+	submits the widget's cached draw list if it was recorded with the same
+	key, otherwise starts recording into it and returns false
+
+-------------------------------------------------------------------------------*/
+
+bool HudCacheHandler::begin(Widget_t& widget, const Key& key)
+{
+	if ( headless )
+	{
+		return true;
+	}
+	if ( widget.valid && widget.key == key.value() && widget.generation == generation && !current )
+	{
+		submit(widget);
+		++replays;
+		return true;
+	}
+	widget.vertices.clear();
+	widget.runs.clear();
+	widget.key = key.value();
+	widget.generation = generation;
+	widget.valid = false;
+	current = &widget;
+	return false;
+}
+
+void HudCacheHandler::end(Widget_t& widget)
+{
+	if ( current != &widget )
+	{
+		return;
+	}
+	current = nullptr;
+	++rebuilds;
+
+	// the text cache may have been flushed while recording, in which case
+	// the earlier text slots are gone. record again next frame
+	if ( widget.generation != generation )
+	{
+		return;
+	}
+	widget.valid = true;
+	submit(widget);
+}
+
+void HudCacheHandler::addVertices(int slot, GLenum mode, const Vertex_t* vertices, int count)
+{
+	Widget_t& widget = *current;
+	if ( widget.runs.empty() || widget.runs.back().slot != slot || widget.runs.back().mode != mode )
+	{
+		Run_t run;
+		run.slot = slot;
+		run.mode = mode;
+		run.first = static_cast<GLint>(widget.vertices.size());
+		run.count = 0;
+		widget.runs.push_back(run);
+	}
+	widget.vertices.insert(widget.vertices.end(), vertices, vertices + count);
+	widget.runs.back().count += count;
+}
+
+void HudCacheHandler::addQuad(int slot, const GLfloat xy[8], const GLfloat uv[8], const GLfloat rgba[4])
+{
+	Vertex_t quad[4];
+	for ( int c = 0; c < 4; ++c )
+	{
+		quad[c].x = xy[c * 2];
+		quad[c].y = xy[c * 2 + 1];
+		quad[c].u = uv[c * 2];
+		quad[c].v = uv[c * 2 + 1];
+		quad[c].r = rgba[0];
+		quad[c].g = rgba[1];
+		quad[c].b = rgba[2];
+		quad[c].a = rgba[3];
+	}
+	addVertices(slot, GL_QUADS, quad, 4);
+}
+
+void HudCacheHandler::addLine(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, const GLfloat rgba[4])
+{
+	Vertex_t line[2];
+	line[0] = { x1, y1, 0.f, 0.f, rgba[0], rgba[1], rgba[2], rgba[3] };
+	line[1] = { x2, y2, 0.f, 0.f, rgba[0], rgba[1], rgba[2], rgba[3] };
+	addVertices(-1, GL_LINES, line, 2);
+}
+
+/*-------------------------------------------------------------------------------
+
+	HudCacheHandler::submit
+
+	draws a widget with the same state drawImage() and drawLine() set up,
+	one glDrawArrays() per run
+
+-------------------------------------------------------------------------------*/
+
+void HudCacheHandler::submit(const Widget_t& widget) const
+{
+	if ( widget.vertices.empty() )
+	{
+		return;
+	}
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_LIGHTING);
+	glMatrixMode(GL_PROJECTION);
+	glViewport(0, 0, xres, yres);
+	glLoadIdentity();
+	glOrtho(0, xres, 0, yres, -1, 1);
+	glMatrixMode(GL_MODELVIEW);
+	glEnable(GL_BLEND);
+
+	// the arrays live in client memory, make sure no model buffers are bound
+	SDL_glBindVertexArray(0);
+	SDL_glBindBuffer(GL_ARRAY_BUFFER, 0);
+	const Vertex_t* vertices = widget.vertices.data();
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, sizeof(Vertex_t), &vertices->x);
+	glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex_t), &vertices->u);
+	glColorPointer(4, GL_FLOAT, sizeof(Vertex_t), &vertices->r);
+
+	for ( const Run_t& run : widget.runs )
+	{
+		glBindTexture(GL_TEXTURE_2D, run.slot >= 0 ? texid[run.slot] : 0);
+		if ( run.mode == GL_LINES )
+		{
+			GLint lineWidth;
+			glGetIntegerv(GL_LINE_WIDTH, &lineWidth);
+			glLineWidth(2);
+			glEnable(GL_LINE_SMOOTH);
+			glDrawArrays(GL_LINES, run.first, run.count);
+			glDisable(GL_LINE_SMOOTH);
+			glLineWidth(lineWidth);
+		}
+		else
+		{
+			glDrawArrays(GL_QUADS, run.first, run.count);
+		}
+	}
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glEnable(GL_DEPTH_TEST);
+}
+
+void HudCacheHandler::startPanel(int player, Panel panel)
+{
+	if ( player < 0 || player >= MAXPLAYERS )
+	{
+		return;
+	}
+	panels[player][panel].start = std::chrono::high_resolution_clock::now();
+}
+
+void HudCacheHandler::endPanel(int player, Panel panel)
+{
+	if ( player < 0 || player >= MAXPLAYERS )
+	{
+		return;
+	}
+	PanelTimer_t& timer = panels[player][panel];
+	double ms = 1000 * std::chrono::duration_cast<std::chrono::duration<double>>(
+		std::chrono::high_resolution_clock::now() - timer.start).count();
+	timer.totalMs += ms;
+	timer.worstMs = std::max(timer.worstMs, ms);
+	++timer.frames;
+}
+
+void HudCacheHandler::logStatus() const
+{
+	static const char* panelNames[PANEL_MAX] = { "status", "inventory", "charsheet", "messages" };
+	printlog("[HUD]: %d widget draws replayed, %d recorded", static_cast<int>(replays), static_cast<int>(rebuilds));
+	for ( int player = 0; player < MAXPLAYERS; ++player )
+	{
+		for ( int panel = 0; panel < PANEL_MAX; ++panel )
+		{
+			const PanelTimer_t& timer = panels[player][panel];
+			if ( timer.frames == 0 )
+			{
+				continue;
+			}
+			printlog("[HUD]: player %d %s: %.3f ms avg, %.3f ms worst over %d frames",
+				player, panelNames[panel], timer.totalMs / timer.frames, timer.worstMs, static_cast<int>(timer.frames));
+		}
+	}
+}
+
+void HudCacheHandler::resetStats()
+{
+	replays = 0;
+	rebuilds = 0;
+	for ( int player = 0; player < MAXPLAYERS; ++player )
+	{
+		for ( int panel = 0; panel < PANEL_MAX; ++panel )
+		{
+			panels[player][panel].totalMs = 0.0;
+			panels[player][panel].worstMs = 0.0;
+			panels[player][panel].frames = 0;
+		}
+	}
+}
@@ -0,0 +1,178 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: hud_cache.hpp
+Desc: header for hud_cache.cpp (retained draw lists and frame timers for
+	the HUD)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+/*-------------------------------------------------------------------------------
+
+	HudCacheHandler
+
+	a widget is a piece of HUD that only draws (no input handling) and whose
+	look depends on a handful of values, e.g. the HP bar. the widget hashes
+	those values into a key and wraps its drawing code in begin()/end():
+
+		if ( !HudCache.begin(widget, key) )
+		{
+			... draw as usual ...
+			HudCache.end(widget);
+		}
+
+	when the key matches the last frame, begin() submits the widget's cached
+	vertices and returns true. otherwise the draw functions record into the
+	widget instead of drawing until end(), which then submits the new list.
+	vertices are submitted as vertex arrays, one draw call per run of quads
+	sharing a texture, so text and bars packed in the same atlas page go out
+	together.
+
+	only drawRect(), drawLine(), drawImage(), drawImageAlpha(),
+	drawImageColor(), drawImageScaled() and drawImageScaledColor() record,
+	which covers ttfPrintText*() and printText*(). anything else called while
+	recording draws immediately and is lost on later frames.
+
+-------------------------------------------------------------------------------*/
+
+class HudCacheHandler
+{
+public:
+	enum Panel : int
+	{
+		PANEL_STATUS,
+		PANEL_INVENTORY,
+		PANEL_CHARACTER_SHEET,
+		PANEL_MESSAGES,
+		PANEL_MAX
+	};
+
+	class Key
+	{
+	public:
+		Key& add(Sint64 value)
+		{
+			for ( int c = 0; c < 8; ++c )
+			{
+				hash ^= static_cast<Uint8>(value >> (c * 8));
+				hash *= 1099511628211ULL;
+			}
+			return *this;
+		}
+		Key& addFloat(real_t value)
+		{
+			Sint64 bits = 0;
+			memcpy(&bits, &value, std::min(sizeof(bits), sizeof(value)));
+			return add(bits);
+		}
+		// strings hash their contents, a buffer can be reused for different text (or
+		// the same text moved) between frames
+		Key& add(const char* value)
+		{
+			if ( !value )
+			{
+				return add(static_cast<Sint64>(-1));
+			}
+			for ( ; *value; ++value )
+			{
+				hash ^= static_cast<Uint8>(*value);
+				hash *= 1099511628211ULL;
+			}
+			hash ^= 0xff; // terminator, so "ab" + "c" and "a" + "bc" differ
+			hash *= 1099511628211ULL;
+			return *this;
+		}
+		// identity only, for objects whose contents are hashed separately or never change (surfaces, fonts)
+		Key& add(const void* value) { return add(static_cast<Sint64>(reinterpret_cast<intptr_t>(value))); }
+		Uint64 value() const { return hash; }
+	private:
+		Uint64 hash = 14695981039346656037ULL;
+	};
+
+	struct Vertex_t
+	{
+		GLfloat x, y;
+		GLfloat u, v;
+		GLfloat r, g, b, a;
+	};
+	struct Run_t
+	{
+		int slot; // index into texid[], -1 for untextured
+		GLenum mode; // GL_QUADS or GL_LINES
+		GLint first;
+		GLsizei count;
+	};
+	class Widget_t
+	{
+		friend class HudCacheHandler;
+		std::vector<Vertex_t> vertices;
+		std::vector<Run_t> runs;
+		Uint64 key = 0;
+		Uint32 generation = 0;
+		bool valid = false;
+	};
+
+	bool begin(Widget_t& widget, const Key& key);
+	void end(Widget_t& widget);
+	bool recording() const { return current != nullptr; }
+
+	// called by the draw functions while recording, coordinates are GL's (y up)
+	void addQuad(int slot, const GLfloat xy[8], const GLfloat uv[8], const GLfloat rgba[4]);
+	void addLine(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, const GLfloat rgba[4]);
+
+	// cached lists refer to texture slots and atlas regions, so anything that
+	// reloads those (text cache flush, atlas build) invalidates every widget
+	void invalidate() { ++generation; }
+
+	void startPanel(int player, Panel panel);
+	void endPanel(int player, Panel panel);
+
+	void logStatus() const;
+	void resetStats();
+private:
+	struct PanelTimer_t
+	{
+		std::chrono::high_resolution_clock::time_point start;
+		double totalMs = 0.0;
+		double worstMs = 0.0;
+		Uint32 frames = 0;
+	};
+
+	Widget_t* current = nullptr;
+	Uint32 generation = 1;
+	Uint32 replays = 0;
+	Uint32 rebuilds = 0;
+	PanelTimer_t panels[MAXPLAYERS][PANEL_MAX];
+
+	void addVertices(int slot, GLenum mode, const Vertex_t* vertices, int count);
+	void submit(const Widget_t& widget) const;
+};
+extern HudCacheHandler HudCache;
+
+// times the enclosing scope into HudCache's panel counters
+class HudPanelTimer
+{
+public:
+	HudPanelTimer(int player, HudCacheHandler::Panel panel) :
+		player(player),
+		panel(panel)
+	{
+		HudCache.startPanel(player, panel);
+	}
+	~HudPanelTimer()
+	{
+		HudCache.endPanel(player, panel);
+	}
+private:
+	int player;
+	HudCacheHandler::Panel panel;
+};
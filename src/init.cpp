@@ -25,6 +25,8 @@
 #include "hash.hpp"
 #include "init.hpp"
 #include "net.hpp"
+#include "texture_atlas.hpp"
+#include "language_table.hpp"
 #ifndef NINTENDO
  #include "editor.hpp"
 #endif // NINTENDO
@@ -214,9 +216,15 @@ int initApp(char const * const title, int fullscreen)
 
 	window_title = title;
 	printlog("initializing SDL...\n");
-	if ( SDL_Init( SDL_INIT_VIDEO | SDL_INIT_TIMER 
-		| SDL_INIT_EVENTS | SDL_INIT_JOYSTICK 
-		| SDL_INIT_GAMECONTROLLER | SDL_INIT_HAPTIC) == -1 )
+	Uint32 sdlFlags = SDL_INIT_VIDEO | SDL_INIT_TIMER
+		| SDL_INIT_EVENTS | SDL_INIT_JOYSTICK
+		| SDL_INIT_GAMECONTROLLER | SDL_INIT_HAPTIC;
+	if ( headless )
+	{
+		sdlFlags = SDL_INIT_TIMER | SDL_INIT_EVENTS;
+		disablevbos = true;
+	}
+	if ( SDL_Init(sdlFlags) == -1 )
 	{
 		printlog("failed to initialize SDL: %s\n", SDL_GetError());
 		return 1;
@@ -296,14 +304,18 @@ int initApp(char const * const title, int fullscreen)
 	}
 
 	// hide cursor for game
-	if ( game )
+	if ( game && !headless )
 	{
 		SDL_ShowCursor(SDL_FALSE);
 	}
 	SDL_StopTextInput();
 
 	// initialize video
-	if ( !initVideo() )
+	if ( headless )
+	{
+		printlog("running headless, skipping video.\n");
+	}
+	else if ( !initVideo() )
 	{
 		return 3;
 	}
@@ -314,7 +326,7 @@ int initApp(char const * const title, int fullscreen)
 	// get pointers to opengl extensions
 #ifdef WINDOWS
 	bool noextensions = false;
-	if ( !softwaremode )
+	if ( !softwaremode && !headless )
 	{
 		if ( (SDL_glGenBuffers = (PFNGLGENBUFFERSPROC)SDL_GL_GetProcAddress("glGenBuffers")) == NULL )
 		{
@@ -383,7 +395,10 @@ int initApp(char const * const title, int fullscreen)
 	{
 		allsurfaces[c] = NULL;
 	}
-	glGenTextures(MAXTEXTURES, texid);
+	if ( !headless )
+	{
+		glGenTextures(MAXTEXTURES, texid);
+	}
 	//SDL_glGenVertexArrays(MAXBUFFERS, vaoid);
 	//SDL_glGenBuffers(MAXBUFFERS, vboid);
 
@@ -431,24 +446,8 @@ int initApp(char const * const title, int fullscreen)
 		return 5;
 	}
 
-	// cache language entries
-	bool cacheText = false;
-	if (cacheText) {
-		for (int c = 0; c < NUMLANGENTRIES; ++c) {
-			bool foundSpecialChar = false;
-			for (int i = 0; language[c][i] != '\0'; ++i) {
-				if (language[c][i] == '\\' || language[c][i] == '%') {
-					foundSpecialChar = true;
-				}
-			}
-			if (foundSpecialChar) {
-				continue;
-			}
-			ttfPrintText(ttf8, 0, -200, language[c]);
-			ttfPrintText(ttf12, 0, -200, language[c]);
-			ttfPrintText(ttf16, 0, -200, language[c]);
-		}
-	}
+	// language entries aren't pre-rendered, ttfPrintText() renders and caches
+	// each string in ttfTextHash the first time it's drawn
 
 	// print a loading message
 	drawClearBuffers();
@@ -480,6 +479,7 @@ int initApp(char const * const title, int fullscreen)
 	{
 		fp->gets2(name, 128);
 		sprites[c] = loadImage(name);
+		TextureAtlas.add(&sprites[c], name, false);
 		if ( sprites[c] == NULL )
 		{
 			printlog("warning: failed to load '%s' listed at line %d in sprites.txt\n", name, c + 1);
@@ -536,7 +536,7 @@ int initApp(char const * const title, int fullscreen)
 			}
 		}
 	}
-	if ( !softwaremode )
+	if ( !softwaremode && !headless )
 	{
 		generatePolyModels(0, nummodels, false);
 	}
@@ -576,6 +576,7 @@ int initApp(char const * const title, int fullscreen)
 	{
 		fp->gets2(name, 128);
 		tiles[c] = loadImage(name);
+		TextureAtlas.add(&tiles[c], name, false);
 		animatedtiles[c] = false;
 		lavatiles[c] = false;
 		swimmingtiles[c] = false;
@@ -611,6 +612,7 @@ int initApp(char const * const title, int fullscreen)
 		}
 	}
 	FileIO::close(fp);
+	TextureAtlas.build();
 
 	// print a loading message
 	drawClearBuffers();
@@ -718,8 +720,6 @@ int initApp(char const * const title, int fullscreen)
 int loadLanguage(char const * const lang)
 {
 	char filename[128] = { 0 };
-	File* fp;
-	int c;
 
 	// open log file
 	if ( !logfile )
@@ -833,104 +833,56 @@ int loadLanguage(char const * const lang)
 	TTF_SetFontKerning(ttf16, 0);
 	TTF_SetFontHinting(ttf16, TTF_HINTING_MONO);
 
-	// open language file
-	if ( (fp = openDataFile(langFilepath.c_str(), "r")) == NULL )
-	{
-		printlog("error: unable to load language file: '%s'", langFilepath.c_str());
-		return 1;
-	}
-
-	// free currently loaded language if any
-	freeLanguages();
-
-	// store the new language code
-	strcpy(languageCode, lang);
-
-	// allocate new language strings
-	language = (char**) calloc(NUMLANGENTRIES, sizeof(char*));
-
-	// Allocate an emptry string for each possible language entry
-	for (c = 0; c < NUMLANGENTRIES; c++)
+	// use the compiled table if it was built from this file, otherwise compile it
+	char sourcePath[PATH_MAX];
+	completePath(sourcePath, langFilepath.c_str());
+	Uint64 sourceSize = 0;
+	Sint64 sourceTime = 0;
+	struct stat sourceInfo;
+	if ( stat(sourcePath, &sourceInfo) == 0 )
 	{
-		language[c] = (char*)calloc(1, sizeof(char));
+		sourceSize = static_cast<Uint64>(sourceInfo.st_size);
+		sourceTime = static_cast<Sint64>(sourceInfo.st_mtime);
 	}
+	char tableName[64];
+	char tablePath[PATH_MAX];
+	snprintf(tableName, sizeof(tableName), "lang_%s.bin", lang);
+	completePath(tablePath, tableName, outputdir);
 
-	// read file
-	Uint32 line;
-	for ( line = 1; !fp->eof(); )
+	LanguageTable table;
+	if ( !table.load(tablePath, sourceSize, sourceTime) )
 	{
-		//printlog( "loading line %d...\n", line);
-		char data[1024];
-		int entry = NUMLANGENTRIES;
-
-		// read line from file
-		int i;
-		bool fileEnd = false;
-		for ( i = 0; ; i++ )
+		std::vector<std::string> entries;
+		if ( !LanguageTable::parse(langFilepath.c_str(), entries, NUMLANGENTRIES) )
 		{
-			data[i] = fp->getc();
-			if ( fp->eof() )
-			{
-				fileEnd = true;
-				break;
-			}
-
-			// blank or comment lines stop reading at a newline
-			if ( data[i] == '\n' )
-			{
-				line++;
-				if (data[0] == '\r' || data[0] == '\n' || data[0] == '#')
-				{
-					break;
-				}
-			}
-			if (data[i] == '#')
-			{
-				if (data[0] != '\n' && data[0] != '\r' && data[0] != '#')
-				{
-					break;
-				}
-			}
+			printlog("error: unable to load language file: '%s'", langFilepath.c_str());
+			return 1;
 		}
-		if ( fileEnd )
+		if ( LanguageTable::compile(entries, tablePath, sourceSize, sourceTime)
+			&& table.load(tablePath, sourceSize, sourceTime) )
 		{
-			break;
+			printlog("compiled language file '%s' to '%s'\n", langFilepath.c_str(), tablePath);
 		}
-
-		// skip blank and comment lines
-		if ( data[0] == '\r' || data[0] == '\n' || data[0] == '#' )
+		else if ( !table.load(LanguageTable::build(entries, sourceSize, sourceTime)) )
 		{
-			continue;
+			printlog("error: unable to load language file: '%s'", langFilepath.c_str());
+			return 1;
 		}
+	}
 
-		data[i] = 0;
+	// free currently loaded language if any
+	freeLanguages();
 
-		// process line
-		if ( (entry = atoi(data)) == 0 )
-		{
-			printlog( "warning: syntax error in '%s':%d\n bad syntax!\n", langFilepath.c_str(), line);
-			continue;
-		}
-		else if ( entry >= NUMLANGENTRIES || entry < 0 )
-		{
-			printlog( "warning: syntax error in '%s':%d\n invalid language entry!\n", langFilepath.c_str(), line);
-			continue;
-		}
-		//printlog( "loading entry %d...\n", entry);
-		char entryText[16] = { 0 };
-		snprintf(entryText, 15, "%d", entry);
-		if ( language[entry][0] )
-		{
-			printlog( "warning: duplicate entry %d in '%s':%d\n", entry, langFilepath.c_str(), line);
-			free(language[entry]);
-		}
-		language[entry] = (char*) calloc(strlen((char*)(data + strlen(entryText) + 1)) + 1, sizeof(char));
-		strcpy(language[entry], (char*)(data + strlen(entryText) + 1));
-	}
+	// store the new language code
+	strcpy(languageCode, lang);
 
-	// close file
-	FileIO::close(fp);
-	printlog( "successfully loaded language file '%s'\n", langFilepath.c_str());
+	// point the language strings into the table
+	languageTable.swap(table);
+	language = (char**) calloc(NUMLANGENTRIES, sizeof(char*));
+	languageTable.fill(language, NUMLANGENTRIES);
+
+	printlog( "successfully loaded language file '%s' (%s, %d KB)\n", langFilepath.c_str(),
+		languageTable.isMapped() ? "mapped" : "in memory", static_cast<int>(languageTable.bytes() / 1024));
 
 	// update item internal language entries.
 	for ( int c = 0; c < NUMITEMS; ++c )
@@ -984,20 +936,13 @@ int reloadLanguage()
 
 void freeLanguages()
 {
-	int c;
-
+	// the strings themselves live in languageTable
 	if ( language )
 	{
-		for ( c = 0; c < NUMLANGENTRIES; c++ )
-		{
-			char* entry = language[c];
-			if ( entry )
-			{
-				free(entry);
-			}
-		}
 		free(language);
+		language = nullptr;
 	}
+	languageTable.unload();
 }
 
 /*-------------------------------------------------------------------------------
@@ -2195,10 +2140,7 @@ int deinitApp()
 	{
 		free(lightmapSmoothed);
 	}
-	if ( vismap != NULL )
-	{
-		free(vismap);
-	}
+	vismap.resize(0, 0);
 
 	for ( c = 0; c < HASH_SIZE; c++ )
 	{
@@ -2323,13 +2265,17 @@ int deinitApp()
 #endif
 
 	// delete opengl buffers
+	TextureAtlas.clear();
 	if ( allsurfaces != NULL )
 	{
 		free(allsurfaces);
 	}
 	if ( texid != NULL )
 	{
-		glDeleteTextures(MAXTEXTURES, texid);
+		if ( !headless )
+		{
+			glDeleteTextures(MAXTEXTURES, texid);
+		}
 		free(texid);
 	}
 
@@ -2817,6 +2763,7 @@ bool changeVideoMode()
 	{
 		glLoadTexture(allsurfaces[c], c);
 	}
+	TextureAtlas.rebuild();
 
 	// regenerate vbos
 	if ( !disablevbos )
@@ -23,6 +23,8 @@
 #include "scores.hpp"
 #include "magic/magic.hpp"
 #include "monster.hpp"
+#include "texture_atlas.hpp"
+#include "level_prefetch.hpp"
 #include "net.hpp"
 #ifdef STEAMWORKS
 #include <steam/steam_api.h>
@@ -309,8 +311,10 @@ int initGame()
 			char imgFileChar[256];
 			strncpy(imgFileChar, itemImgDir.c_str(), 255);
 			*surface = loadImage(imgFileChar);
+			TextureAtlas.add(surface, imgFileChar, true); // item tooltips blit the icon
 		}
 	}
+	TextureAtlas.build();
 	FileIO::close(fp);
 	createBooks();
 	setupSpells();
@@ -402,12 +406,7 @@ int initGame()
 #endif
 	removedEntities.first = NULL;
 	removedEntities.last = NULL;
-	safePacketsSent.first = NULL;
-	safePacketsSent.last = NULL;
-	for ( c = 0; c < MAXPLAYERS; c++ )
-	{
-		safePacketsReceivedMap[c].clear();
-	}
+	SafePacketHandler.reset();
 	topscores.first = NULL;
 	topscores.last = NULL;
 	topscoresMultiplayer.first = NULL;
@@ -439,6 +438,7 @@ int initGame()
 		players[c]->init();
 		// Stat set to 0 as monster type not needed, values will be filled with default, then overwritten by savegame or the charclass.cpp file
 		stats[c] = new Stat(0);
+		attachInventoryIndex(&stats[c]->inventory, &stats[c]->inventoryIndex);
 		if (c > 0)
 		{
 			client_disconnected[c] = true;
@@ -667,6 +667,8 @@ void deinitGame()
 {
 	int c, x;
 
+	LevelPrefetch.cancel();
+
 	// send disconnect messages
 	if ( multiplayer == CLIENT )
 	{
@@ -711,27 +713,9 @@ void deinitGame()
 		{
 			serverHandleMessages(fpsLimit);
 		}
-		if ( !(SDL_GetTicks() % 25) && multiplayer )
+		if ( multiplayer )
 		{
-			int j = 0;
-			node_t* node, *nextnode;
-			for ( node = safePacketsSent.first; node != NULL; node = nextnode )
-			{
-				nextnode = node->next;
-
-				packetsend_t* packet = (packetsend_t*)node->element;
-				sendPacket(packet->sock, packet->channel, packet->packet, packet->hostnum);
-				packet->tries++;
-				if ( packet->tries >= MAXTRIES )
-				{
-					list_RemoveNode(node);
-				}
-				j++;
-				if ( j >= MAXDELETES )
-				{
-					break;
-				}
-			}
+			SafePacketHandler.update();
 		}
 	}
 
@@ -814,6 +798,7 @@ void deinitGame()
 			if ( shopInv[c] )
 			{
 				list_FreeAll(shopInv[c]);
+				detachInventoryIndex(shopInv[c]);
 				free(shopInv[c]);
 				shopInv[c] = NULL;
 			}
@@ -851,11 +836,7 @@ void deinitGame()
 	}
 	list_FreeAll(&command_history);
 
-	list_FreeAll(&safePacketsSent);
-	for ( c = 0; c < MAXPLAYERS; c++ )
-	{
-		safePacketsReceivedMap[c].clear();
-	}
+	SafePacketHandler.reset();
 #ifdef SOUND
 #ifdef USE_OPENAL
 #define FMOD_Channel_Stop OPENAL_Channel_Stop
@@ -981,6 +962,7 @@ void deinitGame()
 		{
 			nextnode = node->next;
 			SDL_Surface** surface = (SDL_Surface**)node->element;
+			TextureAtlas.remove(surface);
 			if ( surface )
 				if ( *surface )
 				{
@@ -20,12 +20,15 @@
 #include "../menu.hpp"
 #include "../monster.hpp"
 #include "../net.hpp"
+#include "../net_simulator.hpp"
 #include "../paths.hpp"
 #include "../player.hpp"
 #include "interface.hpp"
 #include "../scores.hpp"
 #include "../magic/magic.hpp"
 #include "../mod_tools.hpp"
+#include "../hud_cache.hpp"
+#include "../line_of_sight.hpp"
 #include "../collision.hpp"
 #include "../player.hpp"
 #include "../ui/GameUI.hpp"
@@ -39,128 +42,572 @@ bool autoLimbReload = false;
 
 /*-------------------------------------------------------------------------------
 
-	consoleCommand
+	ConsoleCommandRegistry
 
-	Takes a string and executes it as a game command
+	every console command, looked up in hash tables instead of down an
+	if/else chain. the commands that config files are made of match the
+	exact word, so /fov doesn't catch /fovsomething. the rest match on a
+	prefix of their name like the chain did, and are found by looking up
+	the start of the command once for each prefix length in use. where
+	more than one prefix matches, the command added first wins, which was
+	its place in the chain.
 
 -------------------------------------------------------------------------------*/
 
-void consoleCommand(char const * const command_str)
+ConsoleCommandRegistry ConsoleCommands;
+
+void ConsoleCommandRegistry::add(const char* name, Func func)
 {
-	node_t* node;
-	Entity* entity;
-	char name[64];
-	int c;
-	bool invalidcommand = false;
+	commands[name] = func;
+}
 
-	if ( !command_str )
+void ConsoleCommandRegistry::addPrefix(const char* name, size_t matchLength, Func func)
+{
+	PrefixCommand command;
+	command.func = func;
+	command.order = prefixCommands.size();
+	if ( !prefixCommands.emplace(std::string(name, matchLength), command).second )
 	{
-		return;
+		return; // an earlier command already takes everything this one would match
+	}
+	if ( std::find(prefixLengths.begin(), prefixLengths.end(), matchLength) == prefixLengths.end() )
+	{
+		prefixLengths.insert(std::upper_bound(prefixLengths.begin(), prefixLengths.end(), matchLength), matchLength);
+	}
+}
+
+bool ConsoleCommandRegistry::run(const char* command_str) const
+{
+	const size_t nameLength = strcspn(command_str, " \r\n");
+	auto find = commands.find(std::string(command_str, nameLength));
+	if ( find == commands.end() )
+	{
+		return runPrefix(command_str);
 	}
 
-	if ( !strncmp(command_str, "/ping", 5) )
+	std::string args;
+	if ( command_str[nameLength] == ' ' )
 	{
-		if ( multiplayer != CLIENT )
+		args = command_str + nameLength + 1;
+		while ( !args.empty() && (args.back() == '\n' || args.back() == '\r') )
 		{
-			messagePlayer(clientnum, language[1117], 0);
+			args.pop_back();
 		}
-		else
+	}
+	find->second(args.c_str());
+	return true;
+}
+
+bool ConsoleCommandRegistry::runPrefix(const char* command_str) const
+{
+	const size_t length = strlen(command_str);
+	const PrefixCommand* command = nullptr;
+	for ( size_t matchLength : prefixLengths )
+	{
+		if ( matchLength > length )
 		{
-			strcpy((char*)net_packet->data, "PING");
-			net_packet->data[4] = clientnum;
-			net_packet->address.host = net_server.host;
-			net_packet->address.port = net_server.port;
-			net_packet->len = 5;
-			sendPacketSafe(net_sock, -1, net_packet, 0);
-			pingtime = SDL_GetTicks();
+			break;
+		}
+		auto find = prefixCommands.find(std::string(command_str, matchLength));
+		if ( find != prefixCommands.end() && (!command || find->second.order < command->order) )
+		{
+			command = &find->second;
 		}
 	}
-	else if ( !strncmp(command_str, "/usemodelcache", 14) )
+	if ( !command )
 	{
-		useModelCache = true;
+		return false;
 	}
-	else if ( !strncmp(command_str, "/disablemodelcache", 14) )
+	command->func(command_str);
+	return true;
+}
+
+ConsoleCommandRegistry::ConsoleCommandRegistry()
+{
+	add("/usemodelcache", [](const char* args)
+	{
+		useModelCache = true;
+	});
+	add("/disablemodelcache", [](const char* args)
 	{
 		useModelCache = false;
-	}
-	else if (!strncmp(command_str, "/fov", 4))
+	});
+	add("/fov", [](const char* args)
 	{
-		fov = atoi(&command_str[5]);
+		fov = atoi(args);
 		fov = std::min(std::max<Uint32>(40, fov), 100u);
-	}
-	else if ( !strncmp(command_str, "/fps", 4) )
+	});
+	add("/fps", [](const char* args)
 	{
-		fpsLimit = atoi(&command_str[5]);
+		fpsLimit = atoi(args);
 		fpsLimit = std::min(std::max<Uint32>(30, fpsLimit), 144u);
-	}
-	else if (!strncmp(command_str, "/svflags ", 9))
+	});
+	add("/svflags", [](const char* args)
 	{
 		if ( multiplayer == CLIENT )
 		{
 			messagePlayer(clientnum, language[275]);
+			return;
 		}
-		else
+		svFlags = atoi(args);
+		messagePlayer(clientnum, language[276]);
+
+		if ( multiplayer == SERVER )
 		{
-			svFlags = atoi(&command_str[9]);
-			messagePlayer(clientnum, language[276]);
+			// update client flags
+			strcpy((char*)net_packet->data, "SVFL");
+			SDLNet_Write32(svFlags, &net_packet->data[4]);
+			net_packet->len = 8;
 
-			if ( multiplayer == SERVER )
+			for ( int c = 1; c < MAXPLAYERS; c++ )
 			{
-				// update client flags
-				strcpy((char*)net_packet->data, "SVFL");
-				SDLNet_Write32(svFlags, &net_packet->data[4]);
-				net_packet->len = 8;
-
-				for ( int c = 1; c < MAXPLAYERS; c++ )
+				if ( client_disconnected[c] )
 				{
-					if ( client_disconnected[c] )
-					{
-						continue;
-					}
-					net_packet->address.host = net_clients[c - 1].host;
-					net_packet->address.port = net_clients[c - 1].port;
-					sendPacketSafe(net_sock, -1, net_packet, c - 1);
-					messagePlayer(c, language[276]);
+					continue;
 				}
+				net_packet->address.host = net_clients[c - 1].host;
+				net_packet->address.port = net_clients[c - 1].port;
+				sendPacketSafe(net_sock, -1, net_packet, c - 1);
+				messagePlayer(c, language[276]);
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/lastname ", 10) )
+	});
+	add("/lastname", [](const char* args)
 	{
-		strcpy(name, command_str + 10);
-		lastname = (string)name;
-		lastname = lastname.substr(0, lastname.size() - 1);
-	}
-	else if ( !strncmp(command_str, "/lastcharacter ", 15) )
+		lastname = args;
+	});
+	add("/lastcharacter", [](const char* args)
+	{
+		sscanf(args, "%d %d %d %d", &lastCreatedCharacterSex, &lastCreatedCharacterClass,
+			&lastCreatedCharacterAppearance, &lastCreatedCharacterRace);
+	});
+	add("/res", [](const char* args)
+	{
+		xres = atoi(args);
+		const char* height = strchr(args, 'x');
+		if ( height )
+		{
+			yres = atoi(height + 1);
+		}
+	});
+	add("/smoothlighting", [](const char* args)
+	{
+		smoothlighting = (smoothlighting == 0);
+	});
+	add("/fullscreen", [](const char* args)
+	{
+		fullscreen = (fullscreen == 0);
+	});
+	add("/borderless", [](const char* args)
+	{
+		borderless = (!borderless);
+	});
+	add("/shaking", [](const char* args)
+	{
+		shaking = (shaking == 0);
+	});
+	add("/bobbing", [](const char* args)
+	{
+		bobbing = (bobbing == 0);
+	});
+	add("/sfxvolume", [](const char* args)
+	{
+		sfxvolume = atoi(args);
+	});
+	add("/sfxambientvolume", [](const char* args)
 	{
-		int loadedValues = 0;
-		for ( c = 0; c < strlen(command_str); ++c )
+		sfxAmbientVolume = atoi(args);
+	});
+	add("/sfxenvironmentvolume", [](const char* args)
+	{
+		sfxEnvironmentVolume = atoi(args);
+	});
+	add("/musvolume", [](const char* args)
+	{
+		musvolume = atoi(args);
+	});
+	add("/bind", [](const char* args)
+	{
+		// "/bind <key> IN_<impulse>"
+		const char* impulse = strchr(args, ' ');
+		if ( impulse && !strncmp(impulse + 1, "IN_", 3) )
 		{
-			if ( command_str[c] == ' ' )
+			for ( int c = 0; c < NUMIMPULSES; ++c )
 			{
-				switch ( loadedValues )
+				if ( !strcmp(impulse + 4, impulsenames[c]) )
 				{
-					case 0:
-						lastCreatedCharacterSex = atoi(&command_str[c + 1]);
-						break;
-					case 1:
-						lastCreatedCharacterClass = atoi(&command_str[c + 1]);
-						break;
-					case 2:
-						lastCreatedCharacterAppearance = atoi(&command_str[c + 1]);
-						break;
-					case 3:
-						lastCreatedCharacterRace = atoi(&command_str[c + 1]);
-						break;
-					default:
-						break;
+					impulses[c] = atoi(args);
+					printlog("Bound IN_%s: %d\n", impulsenames[c], impulses[c]);
+					return;
 				}
-				++loadedValues;
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/spawnitem ", 11) )
+		messagePlayer(clientnum, "Invalid binding.");
+	});
+	add("/joybind", [](const char* args)
+	{
+		// "/joybind <button> INJOY_<impulse>"
+		const char* impulse = strchr(args, ' ');
+		if ( impulse && !strncmp(impulse + 1, "INJOY_", 6) )
+		{
+			for ( int c = 0; c < NUM_JOY_IMPULSES; ++c )
+			{
+				if ( !strcmp(impulse + 7, joyimpulsenames[c]) )
+				{
+					joyimpulses[c] = atoi(args);
+					printlog("[GAMEPAD] Bound INJOY_%s: %d\n", joyimpulsenames[c], joyimpulses[c]);
+					return;
+				}
+			}
+		}
+		messagePlayer(clientnum, "Invalid binding.");
+	});
+	add("/mousespeed", [](const char* args)
+	{
+		mousespeed = atoi(args);
+	});
+	add("/reversemouse", [](const char* args)
+	{
+		reversemouse = (reversemouse == 0);
+	});
+	add("/smoothmouse", [](const char* args)
+	{
+		smoothmouse = (smoothmouse == false);
+	});
+	add("/disablemouserotationlimit", [](const char* args)
+	{
+		disablemouserotationlimit = (disablemouserotationlimit == false);
+	});
+	add("/ip", [](const char* args)
+	{
+		if ( args[0] != 0 )
+		{
+			strncpy(last_ip, args, sizeof(last_ip) - 1);
+			last_ip[sizeof(last_ip) - 1] = 0;
+		}
+	});
+	add("/port", [](const char* args)
+	{
+		if ( args[0] != 0 )
+		{
+			strncpy(last_port, args, sizeof(last_port) - 1);
+			last_port[sizeof(last_port) - 1] = 0;
+		}
+	});
+	add("/noblood", [](const char* args)
+	{
+		spawn_blood = (spawn_blood == false);
+	});
+	add("/nolightflicker", [](const char* args)
+	{
+		flickerLights = (flickerLights == false);
+	});
+	add("/vsync", [](const char* args)
+	{
+		verticalSync = (verticalSync == false);
+	});
+	add("/hidestatusicons", [](const char* args)
+	{
+		showStatusEffectIcons = (showStatusEffectIcons == false);
+	});
+	add("/muteping", [](const char* args)
+	{
+		minimapPingMute = (minimapPingMute == false);
+	});
+	add("/colorblind", [](const char* args)
+	{
+		colorblind = (colorblind == false);
+	});
+	add("/gamma", [](const char* args)
+	{
+		vidgamma = atof(args);
+	});
+	add("/capturemouse", [](const char* args)
+	{
+		capture_mouse = (capture_mouse == false);
+	});
+	add("/nocapturemouse", [](const char* args)
+	{
+		// saveConfig() writes this one when capture is off
+		capture_mouse = false;
+	});
+	add("/skipintro", [](const char* args)
+	{
+		skipintro = (skipintro == false);
+	});
+	add("/broadcast", [](const char* args)
+	{
+		broadcast = (broadcast == false);
+	});
+	add("/nohud", [](const char* args)
+	{
+		nohud = (nohud == false);
+	});
+	add("/disablehotbarnewitems", [](const char* args)
+	{
+		auto_hotbar_new_items = (auto_hotbar_new_items == false);
+	});
+	add("/hotbarenablecategory", [](const char* args)
+	{
+		int catIndex = 0;
+		int value = 0;
+		if ( sscanf(args, "%d %d", &catIndex, &value) == 2 && catIndex >= 0 && catIndex < NUM_HOTBAR_CATEGORIES )
+		{
+			auto_hotbar_categories[catIndex] = value;
+			printlog("Hotbar auto add category %d, value %d.", catIndex, value);
+		}
+	});
+	add("/autosortcategory", [](const char* args)
+	{
+		int catIndex = 0;
+		int value = 0;
+		if ( sscanf(args, "%d %d", &catIndex, &value) == 2 && catIndex >= 0 && catIndex < NUM_AUTOSORT_CATEGORIES )
+		{
+			autosort_inventory_categories[catIndex] = value;
+			printlog("Autosort inventory category %d, priority %d.", catIndex, value);
+		}
+	});
+	add("/quickaddtohotbar", [](const char* args)
 	{
+		hotbar_numkey_quick_add = !hotbar_numkey_quick_add;
+	});
+	add("/locksidebar", [](const char* args)
+	{
+		if ( players[clientnum] ) // warning - this doesn't exist when loadConfig() is called on init.
+		{
+			players[clientnum]->characterSheet.lock_right_sidebar = (players[clientnum]->characterSheet.lock_right_sidebar == false);
+			if ( players[clientnum]->characterSheet.lock_right_sidebar )
+			{
+				players[clientnum]->characterSheet.proficienciesPage = 1;
+			}
+		}
+	});
+	add("/showgametimer", [](const char* args)
+	{
+		show_game_timer_always = (show_game_timer_always == false);
+	});
+	add("/lang", [](const char* args)
+	{
+		char lang[3] = { 0 };
+		strncpy(lang, args, 2);
+		loadLanguage(lang);
+	});
+	add("/disablemessages", [](const char* args)
+	{
+		disable_messages = true;
+	});
+	add("/right_click_protect", [](const char* args)
+	{
+		right_click_protect = (right_click_protect == false);
+	});
+	add("/autoappraisenewitems", [](const char* args)
+	{
+		auto_appraise_new_items = true;
+	});
+	add("/startfloor", [](const char* args)
+	{
+		startfloor = atoi(args);
+		//Ensure its value is in range.
+		startfloor = std::max(startfloor, 0);
+		printlog("Start floor is %d.", startfloor);
+	});
+	add("/gamepad_deadzone", [](const char* args)
+	{
+		gamepad_deadzone = std::max(atoi(args), 0);
+		printlog("Controller deadzone is %d.", gamepad_deadzone);
+	});
+	add("/gamepad_trigger_deadzone", [](const char* args)
+	{
+		gamepad_trigger_deadzone = std::max(atoi(args), 0);
+		printlog("Controller trigger deadzone is %d.", gamepad_trigger_deadzone);
+	});
+	add("/gamepad_leftx_sensitivity", [](const char* args)
+	{
+		gamepad_leftx_sensitivity = std::max(atoi(args), 1);
+		printlog("Controller leftx sensitivity is %d.", gamepad_leftx_sensitivity);
+	});
+	add("/gamepad_lefty_sensitivity", [](const char* args)
+	{
+		gamepad_lefty_sensitivity = std::max(atoi(args), 1);
+		printlog("Controller lefty sensitivity is %d.", gamepad_lefty_sensitivity);
+	});
+	add("/gamepad_rightx_sensitivity", [](const char* args)
+	{
+		gamepad_rightx_sensitivity = std::max(atoi(args), 1);
+		printlog("Controller rightx sensitivity is %d.", gamepad_rightx_sensitivity);
+	});
+	add("/gamepad_righty_sensitivity", [](const char* args)
+	{
+		gamepad_righty_sensitivity = std::max(atoi(args), 1);
+		printlog("Controller righty sensitivity is %d.", gamepad_righty_sensitivity);
+	});
+	add("/gamepad_menux_sensitivity", [](const char* args)
+	{
+		gamepad_menux_sensitivity = std::max(atoi(args), 1);
+		printlog("Controller menux sensitivity is %d.", gamepad_menux_sensitivity);
+	});
+	add("/gamepad_menuy_sensitivity", [](const char* args)
+	{
+		gamepad_menuy_sensitivity = std::max(atoi(args), 1);
+		printlog("Controller menuy sensitivity is %d.", gamepad_menuy_sensitivity);
+	});
+	add("/gamepad_leftx_invert", [](const char* args)
+	{
+		gamepad_leftx_invert = true;
+	});
+	add("/gamepad_lefty_invert", [](const char* args)
+	{
+		gamepad_lefty_invert = true;
+	});
+	add("/gamepad_rightx_invert", [](const char* args)
+	{
+		gamepad_rightx_invert = true;
+	});
+	add("/gamepad_righty_invert", [](const char* args)
+	{
+		gamepad_righty_invert = true;
+	});
+	add("/gamepad_menux_invert", [](const char* args)
+	{
+		gamepad_menux_invert = true;
+	});
+	add("/gamepad_menuy_invert", [](const char* args)
+	{
+		gamepad_menuy_invert = true;
+	});
+	add("/loadmod", [](const char* args)
+	{
+		// "/loadmod dir:<directory> name:<name>[ fileid:<workshop id>]"
+		std::string cmd = args;
+		std::size_t dirfind = cmd.find("dir:");
+		std::size_t namefind = cmd.find("name:");
+		std::size_t fileidFind = cmd.find("fileid:");
+		if ( dirfind == std::string::npos || namefind == std::string::npos )
+		{
+			return;
+		}
+		std::string directory = cmd.substr(dirfind + 4, namefind - (dirfind + 5));
+		if ( fileidFind == std::string::npos )
+		{
+			std::string modname = cmd.substr(namefind + 5);
+			printlog("[Mods]: Adding mod \"%s\" in path \"%s\"", directory.c_str(), modname.c_str());
+			gamemods_mountedFilepaths.push_back(std::make_pair(directory, modname));
+			gamemods_modelsListRequiresReload = true;
+			gamemods_soundListRequiresReload = true;
+		}
+		else
+		{
+#ifdef STEAMWORKS
+			std::string modname = cmd.substr(namefind + 5, fileidFind - (namefind + 6));
+			printlog("[Mods]: Adding mod \"%s\" in path \"%s\"", directory.c_str(), modname.c_str());
+			gamemods_mountedFilepaths.push_back(std::make_pair(directory, modname));
+			gamemods_modelsListRequiresReload = true;
+			gamemods_soundListRequiresReload = true;
+
+			uint64 id = atoi(cmd.substr(fileidFind + 7).c_str());
+			gamemods_workshopLoadedFileIDMap.push_back(std::make_pair(modname, id));
+			printlog("[Mods]: Steam Workshop mod file ID added for previous entry:%lld", id);
+#endif
+		}
+	});
+	add("/muteaudiofocuslost", [](const char* args)
+	{
+		mute_audio_on_focus_lost = (mute_audio_on_focus_lost == false);
+	});
+	add("/muteplayermonstersounds", [](const char* args)
+	{
+		mute_player_monster_sounds = (mute_player_monster_sounds == false);
+	});
+	add("/minimaptransparencyfg", [](const char* args)
+	{
+		minimapTransparencyForeground = std::min(std::max<int>(0, atoi(args)), 100);
+	});
+	add("/minimaptransparencybg", [](const char* args)
+	{
+		minimapTransparencyBackground = std::min(std::max<int>(0, atoi(args)), 100);
+	});
+	add("/minimapscale", [](const char* args)
+	{
+		minimapScale = std::min(std::max<int>(2, atoi(args)), 16);
+	});
+	add("/minimapobjectzoom", [](const char* args)
+	{
+		minimapObjectZoom = std::min(std::max<int>(0, atoi(args)), 4);
+	});
+	add("/uiscale_inv", [](const char* args)
+	{
+		uiscale_inventory = atof(args);
+	});
+	add("/uiscale_hotbar", [](const char* args)
+	{
+		uiscale_hotbar = atof(args);
+	});
+	add("/uiscale_chatbox", [](const char* args)
+	{
+		uiscale_chatlog = atof(args);
+	});
+	add("/uiscale_playerbars", [](const char* args)
+	{
+		uiscale_playerbars = atof(args);
+	});
+	add("/uiscale_charsheet", [](const char* args)
+	{
+		uiscale_charactersheet = !uiscale_charactersheet;
+	});
+	add("/uiscale_skillsheet", [](const char* args)
+	{
+		uiscale_skillspage = !uiscale_skillspage;
+	});
+	add("/hidestatusbar", [](const char* args)
+	{
+		hide_statusbar = !hide_statusbar;
+	});
+	add("/hideplayertags", [](const char* args)
+	{
+		hide_playertags = !hide_playertags;
+	});
+	add("/showskillvalues", [](const char* args)
+	{
+		show_skill_values = !show_skill_values;
+	});
+	add("/disablenetworkmultithreading", [](const char* args)
+	{
+		disableMultithreadedSteamNetworking = true;
+	});
+	add("/disablenetcodefpslimit", [](const char* args)
+	{
+		disableFPSLimitOnNetworkMessages = !disableFPSLimitOnNetworkMessages;
+	});
+	add("/crossplay", [](const char* args)
+	{
+#if (defined STEAMWORKS && defined USE_EOS)
+		EOS.CrossplayAccountManager.autologin = true;
+#endif // USE_EOS
+	});
+
+	// the debug and cheat commands. each matches on as many characters of its name as it always has,
+	// so abbreviations like /man for /mana still work, and gets the whole command to read its arguments from
+	addPrefix("/ping", 5, [](const char* command_str)
+	{
+		if ( multiplayer != CLIENT )
+		{
+			messagePlayer(clientnum, language[1117], 0);
+		}
+		else
+		{
+			strcpy((char*)net_packet->data, "PING");
+			net_packet->data[4] = clientnum;
+			net_packet->address.host = net_server.host;
+			net_packet->address.port = net_server.port;
+			net_packet->len = 5;
+			sendPacketSafe(net_sock, -1, net_packet, 0);
+			pingtime = SDL_GetTicks();
+		}
+	});
+	addPrefix("/spawnitem ", 11, [](const char* command_str)
+	{
+		char name[64];
+		int c;
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -179,9 +626,11 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[278], name);
 		}
-	}
-	else if ( !strncmp(command_str, "/spawncursed ", 13) )
+	});
+	addPrefix("/spawncursed ", 13, [](const char* command_str)
 	{
+		char name[64];
+		int c;
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -200,9 +649,11 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[278], name);
 		}
-	}
-	else if ( !strncmp(command_str, "/spawnblessed ", 14) )
+	});
+	addPrefix("/spawnblessed ", 14, [](const char* command_str)
 	{
+		char name[64];
+		int c;
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -221,9 +672,11 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[278], name);
 		}
-	}
-	else if ( !strncmp(command_str, "/kick ", 6) )
+	});
+	addPrefix("/kick ", 6, [](const char* command_str)
 	{
+		char name[64];
+		int c;
 		strcpy(name, command_str + 6);
 		if ( multiplayer == SERVER )
 		{
@@ -258,9 +711,10 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[282]);
 		}
-	}
-	else if ( !strncmp(command_str, "/spawnbook ", 11) )
+	});
+	addPrefix("/spawnbook ", 11, [](const char* command_str)
 	{
+		char name[64];
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -269,16 +723,16 @@ void consoleCommand(char const * const command_str)
 
 		strcpy(name, command_str + 11);
 		dropItem(newItem(READABLE_BOOK, EXCELLENT, 0, 1, getBook(name), true, &stats[clientnum]->inventory), 0);
-	}
-	else if ( !strncmp(command_str, "/savemap ", 9) )
+	});
+	addPrefix("/savemap ", 9, [](const char* command_str)
 	{
 		if ( command_str[9] != 0 )
 		{
 			saveMap(command_str + 9);
 			messagePlayer(clientnum, language[283], command_str + 9);
 		}
-	}
-	else if ( !strncmp(command_str, "/nextlevel", 10) )
+	});
+	addPrefix("/nextlevel", 10, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -294,8 +748,8 @@ void consoleCommand(char const * const command_str)
 			messagePlayer(clientnum, language[285]);
 			loadnextlevel = true;
 		}
-	}
-	else if ( !strncmp(command_str, "/pos", 4) )
+	});
+	addPrefix("/pos", 4, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -303,31 +757,52 @@ void consoleCommand(char const * const command_str)
 			return;
 		}
 		messagePlayer(clientnum, language[286], (int)cameras[0].x, (int)cameras[0].y, (int)cameras[0].z, cameras[0].ang, cameras[0].vang);
-	}
-	else if ( !strncmp(command_str, "/pathmap", 4) )
+	});
+	addPrefix("/pathbench", 10, [](const char* command_str)
 	{
-		if (!(svFlags & SV_FLAG_CHEATS))
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
 			return;
 		}
-		if (players[clientnum] && players[clientnum]->entity)
+		if ( players[clientnum] && players[clientnum]->entity )
 		{
-			int x = std::min<int>(std::max<int>(0, floor(players[clientnum]->entity->x / 16)), map.width - 1);
-			int y = std::min<int>(std::max<int>(0, floor(players[clientnum]->entity->y / 16)), map.height - 1);
-			messagePlayer(clientnum, "pathMapGrounded value: %d", pathMapGrounded[y + x * map.height]);
+			int queries = atoi(&command_str[11]);
+			if ( queries <= 0 )
+			{
+				queries = 100;
+			}
+			PathGraphHandler::BenchmarkResult_t result = PathGraph.benchmark(players[clientnum]->entity, queries);
+			messagePlayer(clientnum, "%dx%d map, %d queries, graph built in %.2f ms", map.width, map.height, result.queries, result.msBuild);
+			messagePlayer(clientnum, "direct: %d found in %.2f ms", result.foundDirect, result.msDirect);
+			messagePlayer(clientnum, "hierarchical: %d found in %.2f ms", result.foundHierarchical, result.msHierarchical);
+			PathGraph.logStatus();
+		}
+	});
+	addPrefix("/pathmap", 4, [](const char* command_str)
+	{
+		if (!(svFlags & SV_FLAG_CHEATS))
+		{
+			messagePlayer(clientnum, language[277]);
+			return;
+		}
+		if (players[clientnum] && players[clientnum]->entity)
+		{
+			int x = std::min<int>(std::max<int>(0, floor(players[clientnum]->entity->x / 16)), map.width - 1);
+			int y = std::min<int>(std::max<int>(0, floor(players[clientnum]->entity->y / 16)), map.height - 1);
+			messagePlayer(clientnum, "pathMapGrounded value: %d", pathMapGrounded[y + x * map.height]);
 			messagePlayer(clientnum, "pathMapFlying value: %d", pathMapFlying[y + x * map.height]);
 		}
-	}
-	else if ( !strncmp(command_str, "/exit", 5) )
+	});
+	addPrefix("/exit", 5, [](const char* command_str)
 	{
 		mainloop = 0;
-	}
-	else if ( !strncmp(command_str, "/showfps", 8) )
+	});
+	addPrefix("/showfps", 8, [](const char* command_str)
 	{
 		showfps = (showfps == false);
-	}
-	else if ( !strncmp(command_str, "/noclip", 7) )
+	});
+	addPrefix("/noclip", 7, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -350,8 +825,8 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, language[289]);
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/god", 4) )
+	});
+	addPrefix("/god", 4, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -374,20 +849,20 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, language[292]);
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/spam", 5) )
+	});
+	addPrefix("/spam", 5, [](const char* command_str)
 	{
 		spamming = !(spamming);
-	}
-	else if ( !strncmp(command_str, "/logobstacle", 12) )
+	});
+	addPrefix("/logobstacle", 12, [](const char* command_str)
 	{
 		logCheckObstacle = !(logCheckObstacle);
-	}
-	else if ( !strncmp(command_str, "/showfirst", 10) )
+	});
+	addPrefix("/showfirst", 10, [](const char* command_str)
 	{
 		showfirst = !(showfirst);
-	}
-	else if ( !strncmp(command_str, "/buddha", 7) )
+	});
+	addPrefix("/buddha", 7, [](const char* command_str)
 	{
 		if ( multiplayer != SINGLE )
 		{
@@ -405,8 +880,8 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, language[295]);
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/friendly", 9) )
+	});
+	addPrefix("/friendly", 9, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -427,9 +902,11 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[297]);
 		}
-	}
-	else if ( !strncmp(command_str, "/dowse", 6) )
+	});
+	addPrefix("/dowse", 6, [](const char* command_str)
 	{
+		node_t* node;
+		Entity* entity;
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -443,8 +920,8 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, language[298], (int)(entity->x / 16), (int)(entity->y / 16));
 			}
 		}
-	}
-	else if (!strncmp(command_str, "/thirdperson", 12))
+	});
+	addPrefix("/thirdperson", 12, [](const char* command_str)
 	{
 		/*if (!(svFlags & SV_FLAG_CHEATS))
 		{
@@ -463,394 +940,12 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, "thirdperson OFF");
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/res ", 5) )
-	{
-		xres = atoi(&command_str[5]);
-		for ( c = 0; c < strlen(command_str); c++ )
-		{
-			if ( command_str[c] == 'x' )
-			{
-				yres = atoi(&command_str[c + 1]);
-				break;
-			}
-		}
-	}
-	else if ( !strncmp(command_str, "/rscale", 7) )
+	});
+	addPrefix("/rscale", 7, [](const char* command_str)
 	{
 		rscale = atoi(&command_str[8]);
-	}
-	else if ( !strncmp(command_str, "/smoothlighting", 15) )
-	{
-		smoothlighting = (smoothlighting == 0);
-	}
-	else if ( !strncmp(command_str, "/fullscreen", 11) )
-	{
-		fullscreen = (fullscreen == 0);
-	}
-	else if ( !strncmp(command_str, "/shaking", 8) )
-	{
-		shaking = (shaking == 0);
-	}
-	else if ( !strncmp(command_str, "/bobbing", 8) )
-	{
-		bobbing = (bobbing == 0);
-	}
-	else if ( !strncmp(command_str, "/sfxvolume", 10) )
-	{
-		sfxvolume = atoi(&command_str[11]);
-	}
-	else if ( !strncmp(command_str, "/musvolume", 10) )
-	{
-		musvolume = atoi(&command_str[11]);
-	}
-	else if ( !strncmp(command_str, "/bind", 5) )
-	{
-		if ( strstr(command_str, "IN_FORWARD") )
-		{
-			impulses[IN_FORWARD] = atoi(&command_str[6]);
-			printlog("Bound IN_FORWARD: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_LEFT") )
-		{
-			impulses[IN_LEFT] = atoi(&command_str[6]);
-			printlog("Bound IN_LEFT: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_BACK") )
-		{
-			impulses[IN_BACK] = atoi(&command_str[6]);
-			printlog("Bound IN_BACK: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_RIGHT") )
-		{
-			impulses[IN_RIGHT] = atoi(&command_str[6]);
-			printlog("Bound IN_RIGHT: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_TURNL") )
-		{
-			impulses[IN_TURNL] = atoi(&command_str[6]);
-			printlog("Bound IN_TURNL: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_TURNR") )
-		{
-			impulses[IN_TURNR] = atoi(&command_str[6]);
-			printlog("Bound IN_TURNR: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_UP") )
-		{
-			impulses[IN_UP] = atoi(&command_str[6]);
-			printlog("Bound IN_UP: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_DOWN") )
-		{
-			impulses[IN_DOWN] = atoi(&command_str[6]);
-			printlog("Bound IN_DOWN: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_CHAT") )
-		{
-			impulses[IN_CHAT] = atoi(&command_str[6]);
-			printlog("Bound IN_CHAT: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_COMMAND") )
-		{
-			impulses[IN_COMMAND] = atoi(&command_str[6]);
-			printlog("Bound IN_COMMAND: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_STATUS") )
-		{
-			impulses[IN_STATUS] = atoi(&command_str[6]);
-			printlog("Bound IN_STATUS: %d\n", atoi(&command_str[6]));
-		}
-		else if (strstr(command_str, "IN_SPELL_LIST"))
-		{
-			impulses[IN_SPELL_LIST] = atoi(&command_str[6]);
-			printlog( "Bound IN_SPELL_LIST: %d\n", atoi(&command_str[6]));
-		}
-		else if (strstr(command_str, "IN_CAST_SPELL"))
-		{
-			impulses[IN_CAST_SPELL] = atoi(&command_str[6]);
-			printlog( "Bound IN_CAST_SPELL: %d\n", atoi(&command_str[6]));
-		}
-		else if (strstr(command_str, "IN_DEFEND"))
-		{
-			impulses[IN_DEFEND] = atoi(&command_str[6]);
-			printlog( "Bound IN_DEFEND: %d\n", atoi(&command_str[6]));
-		}
-		else if (strstr(command_str, "IN_ATTACK"))
-		{
-			impulses[IN_ATTACK] = atoi(&command_str[6]);
-			printlog( "Bound IN_ATTACK: %d\n", atoi(&command_str[6]));
-		}
-		else if (strstr(command_str, "IN_USE"))
-		{
-			impulses[IN_USE] = atoi(&command_str[6]);
-			printlog( "Bound IN_USE: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_AUTOSORT") )
-		{
-			impulses[IN_AUTOSORT] = atoi(&command_str[6]);
-			printlog("Bound IN_AUTOSORT: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_MINIMAPSCALE") )
-		{
-			impulses[IN_MINIMAPSCALE] = atoi(&command_str[6]);
-			printlog("Bound IN_MINIMAPSCALE: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_TOGGLECHATLOG") )
-		{
-			impulses[IN_TOGGLECHATLOG] = atoi(&command_str[6]);
-			printlog("Bound IN_TOGGLECHATLOG: %d\n", atoi(&command_str[6]));
-		}
-		else if ( strstr(command_str, "IN_FOLLOWERMENU_OPEN") )
-		{
-			impulses[IN_FOLLOWERMENU] = atoi(&command_str[6]);
-			printlog("Bound IN_FOLLOWERMENU_OPEN: %d\n", impulses[IN_FOLLOWERMENU]);
-		}
-		else if ( strstr(command_str, "IN_FOLLOWERMENU_LASTCMD") )
-		{
-			impulses[IN_FOLLOWERMENU_LASTCMD] = atoi(&command_str[6]);
-			printlog("Bound IN_FOLLOWERMENU_LASTCMD: %d\n", impulses[IN_FOLLOWERMENU_LASTCMD]);
-		}
-		else if ( strstr(command_str, "IN_FOLLOWERMENU_CYCLENEXT") )
-		{
-			impulses[IN_FOLLOWERMENU_CYCLENEXT] = atoi(&command_str[6]);
-			printlog("Bound IN_FOLLOWERMENU_CYCLENEXT: %d\n", impulses[IN_FOLLOWERMENU_CYCLENEXT]);
-		}
-		else if ( strstr(command_str, "IN_HOTBAR_SCROLL_LEFT") )
-		{
-			impulses[IN_HOTBAR_SCROLL_LEFT] = atoi(&command_str[6]);
-			printlog("Bound IN_HOTBAR_SCROLL_LEFT: %d\n", impulses[IN_HOTBAR_SCROLL_LEFT]);
-		}
-		else if ( strstr(command_str, "IN_HOTBAR_SCROLL_RIGHT") )
-		{
-			impulses[IN_HOTBAR_SCROLL_RIGHT] = atoi(&command_str[6]);
-			printlog("Bound IN_HOTBAR_SCROLL_RIGHT: %d\n", impulses[IN_HOTBAR_SCROLL_RIGHT]);
-		}
-		else if ( strstr(command_str, "IN_HOTBAR_SCROLL_SELECT") )
-		{
-			impulses[IN_HOTBAR_SCROLL_SELECT] = atoi(&command_str[6]);
-			printlog("Bound IN_HOTBAR_SCROLL_SELECT: %d\n", impulses[IN_HOTBAR_SCROLL_SELECT]);
-		}
-		else
-		{
-			messagePlayer(clientnum, "Invalid binding.");
-		}
-	}
-	else if (!strncmp(command_str, "/joybind", 8))
-	{
-		if (strstr(command_str, "INJOY_STATUS"))
-		{
-			joyimpulses[INJOY_STATUS] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_STATUS: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_SPELL_LIST"))
-		{
-			joyimpulses[INJOY_SPELL_LIST] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_SPELL_LIST: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_CAST_SPELL"))
-		{
-			joyimpulses[INJOY_GAME_CAST_SPELL] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_CAST_SPELL: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_DEFEND"))
-		{
-			joyimpulses[INJOY_GAME_DEFEND] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_DEFEND: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_ATTACK"))
-		{
-			joyimpulses[INJOY_GAME_ATTACK] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_ATTACK: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_USE"))
-		{
-			joyimpulses[INJOY_GAME_USE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_USE: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_USE"))
-		{
-			joyimpulses[INJOY_MENU_USE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_USE: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_PAUSE_MENU"))
-		{
-			joyimpulses[INJOY_PAUSE_MENU] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_PAUSE_MENU: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_LEFT_CLICK"))
-		{
-			joyimpulses[INJOY_MENU_LEFT_CLICK] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_LEFT_CLICK: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_DPAD_LEFT"))
-		{
-			joyimpulses[INJOY_DPAD_LEFT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_DPAD_LEFT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_DPAD_RIGHT"))
-		{
-			joyimpulses[INJOY_DPAD_RIGHT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_DPAD_RIGHT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_DPAD_UP"))
-		{
-			joyimpulses[INJOY_DPAD_UP] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_DPAD_UP: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_DPAD_DOWN"))
-		{
-			joyimpulses[INJOY_DPAD_DOWN] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_DPAD_DOWN: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_NEXT"))
-		{
-			joyimpulses[INJOY_MENU_NEXT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_NEXT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_HOTBAR_NEXT"))
-		{
-			joyimpulses[INJOY_GAME_HOTBAR_NEXT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_HOTBAR_NEXT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_HOTBAR_PREV"))
-		{
-			joyimpulses[INJOY_GAME_HOTBAR_PREV] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_HOTBAR_PREV: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_GAME_HOTBAR_ACTIVATE"))
-		{
-			joyimpulses[INJOY_GAME_HOTBAR_ACTIVATE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_HOTBAR_ACTIVATE: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_GAME_HOTBAR_ACTIVATE") )
-		{
-			joyimpulses[INJOY_GAME_HOTBAR_ACTIVATE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_HOTBAR_ACTIVATE: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_GAME_MINIMAPSCALE") )
-		{
-			joyimpulses[INJOY_GAME_MINIMAPSCALE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_MINIMAPSCALE: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_GAME_TOGGLECHATLOG") )
-		{
-			joyimpulses[INJOY_GAME_TOGGLECHATLOG] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_TOGGLECHATLOG: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_GAME_FOLLOWERMENU_OPEN") )
-		{
-			joyimpulses[INJOY_GAME_FOLLOWERMENU] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_FOLLOWERMENU_OPEN: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_GAME_FOLLOWERMENU_LASTCMD") )
-		{
-			joyimpulses[INJOY_GAME_FOLLOWERMENU_LASTCMD] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_FOLLOWERMENU_LASTCMD: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_GAME_FOLLOWERMENU_CYCLENEXT") )
-		{
-			joyimpulses[INJOY_GAME_FOLLOWERMENU_CYCLE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_GAME_FOLLOWERMENU_CYCLENEXT: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_MENU_CHEST_GRAB_ALL"))
-		{
-			joyimpulses[INJOY_MENU_CHEST_GRAB_ALL] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_CHEST_GRAB_ALL: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_HOTBAR_CLEAR"))
-		{
-			joyimpulses[INJOY_MENU_HOTBAR_CLEAR] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_HOTBAR_CLEAR: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_REFRESH_LOBBY"))
-		{
-			joyimpulses[INJOY_MENU_REFRESH_LOBBY] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_REFRESH_LOBBY: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_DONT_LOAD_SAVE"))
-		{
-			joyimpulses[INJOY_MENU_DONT_LOAD_SAVE] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_DONT_LOAD_SAVE: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_RANDOM_CHAR"))
-		{
-			joyimpulses[INJOY_MENU_RANDOM_CHAR] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_RANDOM_CHAR: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_CANCEL"))
-		{
-			joyimpulses[INJOY_MENU_CANCEL] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_CANCEL: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_DROP_ITEM"))
-		{
-			joyimpulses[INJOY_MENU_DROP_ITEM] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_DROP_ITEM: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_CYCLE_SHOP_LEFT"))
-		{
-			joyimpulses[INJOY_MENU_CYCLE_SHOP_LEFT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_CYCLE_SHOP_LEFT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_CYCLE_SHOP_RIGHT"))
-		{
-			joyimpulses[INJOY_MENU_CYCLE_SHOP_RIGHT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_CYCLE_SHOP_RIGHT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_BOOK_NEXT"))
-		{
-			joyimpulses[INJOY_MENU_BOOK_NEXT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_BOOK_NEXT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_BOOK_PREV"))
-		{
-			joyimpulses[INJOY_MENU_BOOK_PREV] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_BOOK_PREV: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_SETTINGS_NEXT"))
-		{
-			joyimpulses[INJOY_MENU_SETTINGS_NEXT] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_SETTINGS_NEXT: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_SETTINGS_PREV"))
-		{
-			joyimpulses[INJOY_MENU_SETTINGS_PREV] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_SETTINGS_PREV: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_INVENTORY_TAB"))
-		{
-			joyimpulses[INJOY_MENU_INVENTORY_TAB] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_INVENTORY_TAB: %d\n", atoi(&command_str[9]));
-		}
-		else if (strstr(command_str, "INJOY_MENU_MAGIC_TAB"))
-		{
-			joyimpulses[INJOY_MENU_MAGIC_TAB] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_MAGIC_TAB: %d\n", atoi(&command_str[9]));
-		}
-		else if ( strstr(command_str, "INJOY_MENU_RANDOM_NAME") )
-		{
-			joyimpulses[INJOY_MENU_RANDOM_NAME] = atoi(&command_str[9]);
-			printlog("[GAMEPAD] Bound INJOY_MENU_RANDOM_NAME: %d\n", atoi(&command_str[9]));
-		}
-		else
-		{
-			messagePlayer(clientnum, "Invalid binding.");
-		}
-	}
-	else if ( !strncmp(command_str, "/mousespeed", 11) )
-	{
-		mousespeed = atoi(&command_str[12]);
-	}
-	else if ( !strncmp(command_str, "/reversemouse", 13) )
-	{
-		reversemouse = (reversemouse == 0);
-	}
-	else if ( !strncmp(command_str, "/smoothmouse", 12) )
-	{
-		smoothmouse = (smoothmouse == false);
-	}
-	else if ( !strncmp(command_str, "/mana", 4) )
+	});
+	addPrefix("/mana", 4, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -866,8 +961,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if ( !strncmp(command_str, "/heal", 4) )
+	});
+	addPrefix("/heal", 4, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -883,8 +978,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if ( !strncmp(command_str, "/damage ", 8) )
+	});
+	addPrefix("/damage ", 8, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -902,58 +997,8 @@ void consoleCommand(char const * const command_str)
 		players[clientnum]->entity->modHP(-amount);
 
 		messagePlayer(clientnum, "Damaging you by %d. New health: %d", amount, stats[clientnum]->HP);
-	}
-	else if (!strncmp(command_str, "/ip ", 4))
-	{
-		if ( command_str[4] != 0 )
-		{
-			strcpy(last_ip, command_str + 4);
-			last_ip[strlen(last_ip) - 1] = 0;
-		}
-	}
-	else if (!strncmp(command_str, "/port ", 6))
-	{
-		if (command_str[6] != 0)
-		{
-			strcpy(last_port, command_str + 6);
-			last_port[strlen(last_port) - 1] = 0;
-		}
-	}
-	else if (!strncmp(command_str, "/noblood", 8))
-	{
-		spawn_blood = (spawn_blood == false);
-	}
-	else if (!strncmp(command_str, "/nolightflicker", 15))
-	{
-		flickerLights = (flickerLights == false);
-	}
-	else if ( !strncmp(command_str, "/vsync", 6) )
-	{
-		verticalSync = (verticalSync == false);
-	}
-	else if ( !strncmp(command_str, "/hidestatusicons", 16) )
-	{
-		showStatusEffectIcons = (showStatusEffectIcons == false);
-	}
-	else if ( !strncmp(command_str, "/muteping", 9) )
-	{
-		minimapPingMute = (minimapPingMute == false);
-	}
-	else if (!strncmp(command_str, "/colorblind", 11))
-	{
-		colorblind = (colorblind == false);
-	}
-	else if (!strncmp(command_str, "/gamma", 6))
-	{
-		std::stringstream ss;
-		ss << command_str + 7;
-		ss >> vidgamma;
-	}
-	else if (!strncmp(command_str, "/capturemouse", 13))
-	{
-		capture_mouse = (capture_mouse == false);
-	}
-	else if (!strncmp(command_str, "/levelup", 8))
+	});
+	addPrefix("/levelup", 8, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -979,8 +1024,8 @@ void consoleCommand(char const * const command_str)
 			sendPacketSafe(net_sock, -1, net_packet, 0);
 			//messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if ( !strncmp(command_str, "/maxout2", 8) )
+	});
+	addPrefix("/maxout2", 8, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1019,8 +1064,8 @@ void consoleCommand(char const * const command_str)
 			}
 			//messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if ( !strncmp(command_str, "/jumplevel ", 11) )
+	});
+	addPrefix("/jumplevel ", 11, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1033,8 +1078,8 @@ void consoleCommand(char const * const command_str)
 			loadingSameLevelAsCurrent = true;
 		}
 		consoleCommand("/nextlevel");
-	}
-	else if ( !strncmp(command_str, "/maxout3", 8) )
+	});
+	addPrefix("/maxout3", 8, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1076,8 +1121,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if ( !strncmp(command_str, "/maxout4", 8) )
+	});
+	addPrefix("/maxout4", 8, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1124,8 +1169,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if (!strncmp(command_str, "/maxout", 7))
+	});
+	addPrefix("/maxout", 7, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1163,8 +1208,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if (!strncmp(command_str, "/hunger", 7))
+	});
+	addPrefix("/hunger", 7, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1184,8 +1229,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if (!strncmp(command_str, "/poison", 7))
+	});
+	addPrefix("/poison", 7, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1206,20 +1251,16 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if (!strncmp(command_str, "/testsound ", 11))
+	});
+	addPrefix("/testsound ", 11, [](const char* command_str)
 	{
 		int num = 0;
 		//snprintf((char *)(command_str + 11), strlen(command_str)-11, "%d", num);
 		//printlog( "Number is %d. Original is: \"%s\"\n", num, (char *)(&command_str[11]));
 		num = atoi((char*)(command_str + 11));
 		playSound(num, 256);
-	}
-	else if (!strncmp(command_str, "/skipintro", 10))
-	{
-		skipintro = (skipintro == false);
-	}
-	else if (!strncmp(command_str, "/levelmagic", 11))
+	});
+	addPrefix("/levelmagic", 11, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1240,20 +1281,20 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, language[299]);
 		}
-	}
-	else if (!strncmp(command_str, "/numentities", 12))
+	});
+	addPrefix("/numentities", 12, [](const char* command_str)
 	{
 		messagePlayer(clientnum, language[300], list_Size(map.entities));
-	}
-	else if ( !strncmp(command_str, "/nummonsters2", 13) )
+	});
+	addPrefix("/nummonsters2", 13, [](const char* command_str)
 	{
 		messagePlayer(clientnum, language[2353], list_Size(map.creatures));
-	}
-	else if ( !strncmp(command_str, "/nummonsters", 12) )
+	});
+	addPrefix("/nummonsters", 12, [](const char* command_str)
 	{
 		messagePlayer(clientnum, language[2353], nummonsters);
-	}
-	else if ( !strncmp(command_str, "/verifycreaturelist", strlen("/verifycreaturelist")) )
+	});
+	addPrefix("/verifycreaturelist", 19, [](const char* command_str)
 	{
 		//Make sure that the number of creatures in the creature list are the real count in the game world.
 		unsigned entcount = 0;
@@ -1280,9 +1321,11 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, "Nope, much problemo!");
 		}
-	}
-	else if ( !strncmp(command_str, "/loadmodels ", 12) )
+	});
+	addPrefix("/loadmodels ", 12, [](const char* command_str)
 	{
+		char name[64];
+		int c;
 		char name2[128];
 		char buf[16] = "";
 		int startIndex = 0;
@@ -1354,8 +1397,8 @@ void consoleCommand(char const * const command_str)
 		//messagePlayer(clientnum, language[2354]);
 		messagePlayer(clientnum, language[2355], startIndex, endIndex);
 		generatePolyModels(startIndex, endIndex, true);
-	}
-	else if (!strncmp(command_str, "/killmonsters", 13))
+	});
+	addPrefix("/killmonsters", 13, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -1382,8 +1425,8 @@ void consoleCommand(char const * const command_str)
 			}
 			messagePlayer(clientnum, language[301], c);
 		}
-	}
-	else if (!strncmp(command_str, "/die", 4))
+	});
+	addPrefix("/die", 4, [](const char* command_str)
 	{
 		if ( multiplayer == CLIENT )
 		{
@@ -1402,14 +1445,16 @@ void consoleCommand(char const * const command_str)
 				players[clientnum]->entity->setHP(0);
 			}
 		}
-	}
-	else if (!strncmp(command_str, "/segfault", 9))
+	});
+	addPrefix("/segfault", 9, [](const char* command_str)
 	{
 		int* potato = NULL;
 		(*potato) = 322; //Crash the game!
-	}
-	else if ( !(strncmp(command_str, "/flames", 7)) )
+	});
+	addPrefix("/flames", 7, [](const char* command_str)
 	{
+		Entity* entity;
+		int c;
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -1435,9 +1480,10 @@ void consoleCommand(char const * const command_str)
 			entity->vel_z = vel * sin(entity->pitch) * .2;
 			entity->skill[0] = 5 + rand() % 10;
 		}
-	}
-	else if ( !(strncmp(command_str, "/cure", 5)) )
+	});
+	addPrefix("/cure", 5, [](const char* command_str)
 	{
+		int c;
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
 			messagePlayer(clientnum, language[277]);
@@ -1463,9 +1509,10 @@ void consoleCommand(char const * const command_str)
 		{
 			players[clientnum]->entity->setEffect(EFF_WITHDRAWAL, false, EFFECT_WITHDRAWAL_BASE_TIME, true);
 		}
-	}
-	else if (!strncmp(command_str, "/summonall ", 11))
+	});
+	addPrefix("/summonall ", 11, [](const char* command_str)
 	{
+		char name[64];
 		if (!(svFlags & SV_FLAG_CHEATS))
 		{
 			messagePlayer(clientnum, language[277]);
@@ -1516,9 +1563,10 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, language[304], name);
 			}
 		}
-	}
-	else if (!strncmp(command_str, "/summon ", 8))
+	});
+	addPrefix("/summon ", 8, [](const char* command_str)
 	{
+		char name[64];
 		if (!(svFlags & SV_FLAG_CHEATS))
 		{
 			messagePlayer(clientnum, language[277]);
@@ -1648,8 +1696,8 @@ void consoleCommand(char const * const command_str)
 				messagePlayer(clientnum, language[304], name);
 			}
 		}
-	}
-	else if (!strncmp(command_str, "/summonchest", 12)) //MAGIC TEST FUNCTION WE NEEDED LONG AGO.
+	});
+	addPrefix("/summonchest", 12, [](const char* command_str) //MAGIC TEST FUNCTION WE NEEDED LONG AGO.
 	{
 		if (!(svFlags & SV_FLAG_CHEATS))
 		{
@@ -1667,90 +1715,28 @@ void consoleCommand(char const * const command_str)
 			//Spawn monster
 			Entity* chest = summonChest(players[clientnum]->entity->x + 32 * cos(players[clientnum]->entity->yaw), players[clientnum]->entity->y + 32 * sin(players[clientnum]->entity->yaw));
 		}
-	}
-	else if (!strncmp(command_str, "/broadcast", 10))
+	});
+	addPrefix("/mapseed", 8, [](const char* command_str)
 	{
-		broadcast = (broadcast == false);
-	}
-	else if (!strncmp(command_str, "/nohud", 6))
-	{
-		nohud = (nohud == false);
-	}
-	else if (!strncmp(command_str, "/disablehotbarnewitems", 15))
-	{
-		auto_hotbar_new_items = (auto_hotbar_new_items == false);
-	}
-	else if ( !strncmp(command_str, "/hotbarenablecategory ", 22) )
-	{
-		int catIndex = atoi(&command_str[22]);
-		int value = atoi(&command_str[24]);
-		auto_hotbar_categories[catIndex] = value;
-		printlog("Hotbar auto add category %d, value %d.", catIndex, value);
-	}
-	else if ( !strncmp(command_str, "/autosortcategory ", 18) )
-	{
-		int catIndex = atoi(&command_str[18]);
-		int value = atoi(&command_str[20]);
-		autosort_inventory_categories[catIndex] = value;
-		printlog("Autosort inventory category %d, priority %d.", catIndex, value);
-	}
-	else if ( !strncmp(command_str, "/quickaddtohotbar", 17) )
-	{
-		hotbar_numkey_quick_add = !hotbar_numkey_quick_add;
-	}
-	else if ( !strncmp(command_str, "/locksidebar", 12) )
+		messagePlayer(clientnum, "%d", mapseed);
+	});
+	addPrefix("/prngtest", 9, [](const char* command_str)
 	{
-		if ( players[clientnum] ) // warning - this doesn't exist when loadConfig() is called on init.
+		// "/prngtest record" rewrites the recorded dungeon hashes instead of checking them
+		if ( prng_selftest(strstr(command_str, "record") != nullptr) )
 		{
-			players[clientnum]->characterSheet.lock_right_sidebar = (players[clientnum]->characterSheet.lock_right_sidebar == false);
-			if ( players[clientnum]->characterSheet.lock_right_sidebar )
-			{
-				players[clientnum]->characterSheet.proficienciesPage = 1;
-			}
+			messagePlayer(clientnum, "prng self test passed.");
 		}
-	}
-	else if ( !strncmp(command_str, "/showgametimer", 14) )
-	{
-		show_game_timer_always = (show_game_timer_always == false);
-	}
-	else if (!strncmp(command_str, "/lang ", 6))
-	{
-		char *lang = strdup(command_str);
-		lang[8] = 0;
-		loadLanguage(lang + 6);
-		free(lang);
-	}
-	else if ( !strncmp(command_str, "/mapseed", 8) )
-	{
-		messagePlayer(clientnum, "%d", mapseed);
-	}
-	else if (!strncmp(command_str, "/reloadlang", 11))
+		else
+		{
+			messagePlayer(clientnum, "prng self test FAILED, see log.");
+		}
+	});
+	addPrefix("/reloadlang", 11, [](const char* command_str)
 	{
 		reloadLanguage();
-	}
-	else if (!strncmp(command_str, "/disablemessages", 15))
-	{
-		disable_messages = true;
-	}
-	else if (!strncmp(command_str, "/right_click_protect", 19))
-	{
-		right_click_protect = (right_click_protect == false);
-	}
-	else if (!strncmp(command_str, "/autoappraisenewitems", 21))
-	{
-		auto_appraise_new_items = true;
-	}
-	else if (!strncmp(command_str, "/startfloor ", 12))
-	{
-		startfloor = atoi(&command_str[12]);
-		//Ensure its value is in range.
-		startfloor = std::max(startfloor, 0);
-		//startfloor = std::min(startfloor, numlevels);
-		printlog("Start floor is %d.", startfloor);
-	}
-	else if ( !strncmp(command_str, "/splitscreen ", 13) 
-		|| !strncmp(command_str, "/splitscreen", 12)
-		|| !strncmp(command_str, "/splitscreen2vertical", 21) )
+	});
+	addPrefix("/splitscreen", 12, [](const char* command_str) // also /splitscreen2vertical
 	{
 		int numPlayers = 4;
 		bool verticalSplitscreen = !strncmp(command_str, "/splitscreen2vertical", 21);
@@ -1940,88 +1926,8 @@ void consoleCommand(char const * const command_str)
 				intro = oldIntro;
 			}
 		}
-	}
-	else if (!strncmp(command_str, "/gamepad_deadzone ", 18))
-	{
-		gamepad_deadzone = atoi(&command_str[18]);
-		//Ensure its value is in range.
-		gamepad_deadzone = std::max(gamepad_deadzone, 0);
-		printlog("Controller deadzone is %d.", gamepad_deadzone);
-	}
-	else if (!strncmp(command_str, "/gamepad_trigger_deadzone ", 26))
-	{
-		gamepad_trigger_deadzone = atoi(&command_str[26]);
-		//Ensure its value is in range.
-		gamepad_trigger_deadzone = std::max(gamepad_trigger_deadzone, 0);
-		printlog("Controller trigger deadzone is %d.", gamepad_trigger_deadzone);
-	}
-	else if (!strncmp(command_str, "/gamepad_leftx_sensitivity ", 27))
-	{
-		gamepad_leftx_sensitivity = atoi(&command_str[27]);
-		//Ensure its value is in range.
-		gamepad_leftx_sensitivity = std::max(gamepad_leftx_sensitivity, 1);
-		printlog("Controller leftx sensitivity is %d.", gamepad_leftx_sensitivity);
-	}
-	else if (!strncmp(command_str, "/gamepad_lefty_sensitivity ", 27))
-	{
-		gamepad_lefty_sensitivity = atoi(&command_str[27]);
-		//Ensure its value is in range.
-		gamepad_lefty_sensitivity = std::max(gamepad_lefty_sensitivity, 1);
-		printlog("Controller lefty sensitivity is %d.", gamepad_lefty_sensitivity);
-	}
-	else if (!strncmp(command_str, "/gamepad_rightx_sensitivity ", 28))
-	{
-		gamepad_rightx_sensitivity = atoi(&command_str[28]);
-		//Ensure its value is in range.
-		gamepad_rightx_sensitivity = std::max(gamepad_rightx_sensitivity, 1);
-		printlog("Controller rightx sensitivity is %d.", gamepad_rightx_sensitivity);
-	}
-	else if (!strncmp(command_str, "/gamepad_righty_sensitivity ", 28))
-	{
-		gamepad_righty_sensitivity = atoi(&command_str[28]);
-		//Ensure its value is in range.
-		gamepad_righty_sensitivity = std::max(gamepad_righty_sensitivity, 1);
-		printlog("Controller righty sensitivity is %d.", gamepad_righty_sensitivity);
-	}
-	else if (!strncmp(command_str, "/gamepad_menux_sensitivity ", 27))
-	{
-		gamepad_menux_sensitivity = atoi(&command_str[27]);
-		//Ensure its value is in range.
-		gamepad_menux_sensitivity = std::max(gamepad_menux_sensitivity, 1);
-		printlog("Controller menux sensitivity is %d.", gamepad_menux_sensitivity);
-	}
-	else if (!strncmp(command_str, "/gamepad_menuy_sensitivity ", 27))
-	{
-		gamepad_menuy_sensitivity = atoi(&command_str[27]);
-		//Ensure its value is in range.
-		gamepad_menuy_sensitivity = std::max(gamepad_menuy_sensitivity, 1);
-		printlog("Controller menuy sensitivity is %d.", gamepad_menuy_sensitivity);
-	}
-	else if (!strncmp(command_str, "/gamepad_leftx_invert", 21))
-	{
-		gamepad_leftx_invert = true;
-	}
-	else if (!strncmp(command_str, "/gamepad_lefty_invert", 21))
-	{
-		gamepad_lefty_invert = true;
-	}
-	else if (!strncmp(command_str, "/gamepad_rightx_invert", 22))
-	{
-		gamepad_rightx_invert = true;
-	}
-	else if (!strncmp(command_str, "/gamepad_righty_invert", 22))
-	{
-		gamepad_righty_invert = true;
-	}
-	else if (!strncmp(command_str, "/gamepad_menux_invert", 21))
-	{
-		gamepad_menux_invert = true;
-	}
-	else if (!strncmp(command_str, "/gamepad_menuy_invert", 21))
-	{
-		gamepad_menuy_invert = true;
-	}
-	else if ( !strncmp(command_str, "/numgold", 8) )
+	});
+	addPrefix("/numgold", 8, [](const char* command_str)
 	{
 		for ( unsigned i = 0; i < MAXPLAYERS; ++i )
 		{
@@ -2031,8 +1937,8 @@ void consoleCommand(char const * const command_str)
 			}
 			messagePlayer(clientnum, "Player %d has %d gold.", i, stats[i]->GOLD);
 		}
-	}
-	else if ( !strncmp(command_str, "/gold ", 5) )
+	});
+	addPrefix("/gold ", 5, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2050,9 +1956,10 @@ void consoleCommand(char const * const command_str)
 		stats[clientnum]->GOLD = std::max(stats[clientnum]->GOLD, 0);
 
 		messagePlayer(clientnum, "Giving %d gold pieces.", amount);
-	}
-	else if ( !strncmp(command_str, "/dropgold", 9) )
+	});
+	addPrefix("/dropgold", 9, [](const char* command_str)
 	{
+		Entity* entity;
 		int amount = 100;
 		if ( !stats[clientnum] )
 		{
@@ -2108,8 +2015,8 @@ void consoleCommand(char const * const command_str)
 		}
 
 		messagePlayer(clientnum, language[2594], amount);
-	}
-	else if (!strncmp(command_str, "/minotaurlevel", 14))
+	});
+	addPrefix("/minotaurlevel", 14, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2127,8 +2034,8 @@ void consoleCommand(char const * const command_str)
 			minotaurlevel = 1;
 			createMinotaurTimer(players[0]->entity, &map);
 		}
-	}
-	else if ( !strncmp(command_str, "/minotaurnow", 12) )
+	});
+	addPrefix("/minotaurnow", 12, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2155,8 +2062,8 @@ void consoleCommand(char const * const command_str)
 				}
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/levelskill ", 12) )
+	});
+	addPrefix("/levelskill ", 12, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2181,8 +2088,8 @@ void consoleCommand(char const * const command_str)
 				players[clientnum]->entity->increaseSkill(skill);
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/maplevel", 9) )
+	});
+	addPrefix("/maplevel", 9, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2199,8 +2106,8 @@ void consoleCommand(char const * const command_str)
 		printlog("Made it this far...");
 
 		mapLevel(clientnum);
-	}
-	else if ( !strncmp(command_str, "/drunky", 7) )
+	});
+	addPrefix("/drunky", 7, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2223,8 +2130,8 @@ void consoleCommand(char const * const command_str)
 			players[clientnum]->entity->getStats()->EFFECTS[EFF_DRUNK] = false;
 			players[clientnum]->entity->getStats()->EFFECTS_TIMERS[EFF_DRUNK] = 0;
 		}
-	}
-	else if ( !strncmp(command_str, "/maxskill ", 10) )
+	});
+	addPrefix("/maxskill ", 10, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2249,9 +2156,10 @@ void consoleCommand(char const * const command_str)
 				players[clientnum]->entity->increaseSkill(skill);
 			}
 		}
-	}
-	else if ( !strncmp(command_str, "/reloadlimbs", 12) )
+	});
+	addPrefix("/reloadlimbs", 12, [](const char* command_str)
 	{
+		int c;
 		int x;
 		File* fp;
 		bool success = true;
@@ -2322,8 +2230,8 @@ void consoleCommand(char const * const command_str)
 		{
 			messagePlayer(clientnum, "Successfully reloaded all limbs.txt!");
 		}
-	}
-	else if ( !strncmp(command_str, "/animspeed ", 10) )
+	});
+	addPrefix("/animspeed ", 10, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2339,8 +2247,8 @@ void consoleCommand(char const * const command_str)
 		int speed = atoi(&command_str[11]);
 		monsterGlobalAnimationMultiplier = speed;
 		messagePlayer(clientnum, "Changed animation speed multiplier to %f.", speed / 10.0);
-	}
-	else if ( !strncmp(command_str, "/atkspeed ", 9) )
+	});
+	addPrefix("/atkspeed ", 9, [](const char* command_str)
 	{
 		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
@@ -2356,931 +2264,981 @@ void consoleCommand(char const * const command_str)
 		int speed = atoi(&command_str[10]);
 		monsterGlobalAttackTimeMultiplier = speed;
 		messagePlayer(clientnum, "Changed attack speed multiplier to %d.", speed);
-	}
-	else if ( !strncmp(command_str, "/loadmod ", 9) )
+	});
+	addPrefix("/autolimbreload", 15, [](const char* command_str)
 	{
-		std::string cmd = command_str;
-		std::size_t dirfind = cmd.find("dir:");
-		std::size_t namefind = cmd.find("name:");
-		std::string modname;
-		std::size_t fileidFind = cmd.find("fileid:");
-		if ( dirfind != std::string::npos && namefind != std::string::npos && fileidFind == std::string::npos )
+		autoLimbReload = !autoLimbReload;
+	});
+	addPrefix("/togglesecretlevel", 18, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			std::string directory = cmd.substr(dirfind + 4, namefind - (dirfind + 5));
-			modname = cmd.substr(namefind + 5);
-			modname = modname.substr(0, modname.length() - 1);
-			printlog("[Mods]: Adding mod \"%s\" in path \"%s\"", directory.c_str(), modname.c_str());
-			gamemods_mountedFilepaths.push_back(std::make_pair(directory, modname));
-			gamemods_modelsListRequiresReload = true;
-			gamemods_soundListRequiresReload = true;
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		if ( dirfind != std::string::npos && namefind != std::string::npos && fileidFind != std::string::npos )
+		if ( multiplayer != SINGLE )
 		{
-#ifdef STEAMWORKS
-			std::string directory = cmd.substr(dirfind + 4, namefind - (dirfind + 5));
-			modname = cmd.substr(namefind + 5, fileidFind - (namefind + 6));
-			printlog("[Mods]: Adding mod \"%s\" in path \"%s\"", directory.c_str(), modname.c_str());
-			gamemods_mountedFilepaths.push_back(std::make_pair(directory, modname));
-			gamemods_modelsListRequiresReload = true;
-			gamemods_soundListRequiresReload = true;
-
-			uint64 id = atoi(cmd.substr(fileidFind + 7).c_str());
-			gamemods_workshopLoadedFileIDMap.push_back(std::make_pair(modname, id));
-			printlog("[Mods]: Steam Workshop mod file ID added for previous entry:%lld", id);
-#endif
+			messagePlayer(clientnum, language[299]);
+			return;
 		}
-	}
-	else
+		secretlevel = (secretlevel == false);
+	});
+	addPrefix("/seteffect ", 11, [](const char* command_str)
 	{
-		invalidcommand = true;
-	}
+		if ( !(svFlags & SV_FLAG_CHEATS) )
+		{
+			messagePlayer(clientnum, language[277]);
+			return;
+		}
+		if ( multiplayer != SINGLE )
+		{
+			messagePlayer(clientnum, language[299]);
+			return;
+		}
 
-	if ( invalidcommand ) // starting new if else block to get around compiler >128 statement limit.
+		int effect = atoi(&command_str[11]);
+		if ( effect >= NUMEFFECTS || effect < 0 )
+		{
+			return;
+		}
+		else
+		{
+			players[clientnum]->entity->setEffect(effect, true, 500, true);
+		}
+	});
+	addPrefix("/levelsummon", 12, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
+		{
+			messagePlayer(clientnum, language[277]);
+			return;
+		}
+		for ( node_t* node = map.creatures->first; node != nullptr; node = node->next )
+		{
+			Entity* entity = (Entity*)node->element;
+			if ( entity && entity->behavior == &actMonster && entity->monsterAllySummonRank != 0 )
+			{
+				Stat* entityStats = entity->getStats();
+				if ( entityStats )
+				{
+					entityStats->EXP += 100;
+				}
+			}
+		}
+		return;
+	});
+	addPrefix("/brawlermode", 12, [](const char* command_str)
 	{
-		if ( !strncmp(command_str, "/muteaudiofocuslost", 19) )
+		achievementBrawlerMode = !achievementBrawlerMode;
+		if ( achievementBrawlerMode && conductGameChallenges[CONDUCT_BRAWLER] )
 		{
-			mute_audio_on_focus_lost = (mute_audio_on_focus_lost == false);
+			messagePlayer(clientnum, language[2995]);
 		}
-		else if ( !strncmp(command_str, "/muteplayermonstersounds", 24) )
+		else if ( achievementBrawlerMode && !conductGameChallenges[CONDUCT_BRAWLER] )
 		{
-			mute_player_monster_sounds = (mute_player_monster_sounds == false);
+			messagePlayer(clientnum, language[2998]);
 		}
-		else if ( !strncmp(command_str, "/minimaptransparencyfg", 22) )
+		else if ( !achievementBrawlerMode )
 		{
-			minimapTransparencyForeground = atoi(&command_str[23]);
-			minimapTransparencyForeground = std::min(std::max<int>(0, minimapTransparencyForeground), 100);
-
+			messagePlayer(clientnum, language[2996]);
 		}
-		else if ( !strncmp(command_str, "/minimaptransparencybg", 22) )
+	});
+	addPrefix("/rangermode", 11, [](const char* command_str)
+	{
+		int player = -1;
+		if ( !strncmp(command_str, "/rangermode ", 12) )
+		{
+			player = std::min(std::max(0, atoi(&command_str[12])), MAXPLAYERS);
+		}
+		else
+		{
+			player = 0;
+		}
+
+		if ( multiplayer == CLIENT )
 		{
-			minimapTransparencyBackground = atoi(&command_str[23]);
-			minimapTransparencyBackground = std::min(std::max<int>(0, minimapTransparencyBackground), 100);
+			messagePlayer(clientnum, language[284]);
+			return;
+		}
 
+		achievementRangedMode[player] = !achievementRangedMode[player];
+		if ( multiplayer == SERVER )
+		{
+			if ( player != clientnum )
+			{
+				if ( achievementRangedMode[player] )
+				{
+					messagePlayer(clientnum, language[3926], player);
+				}
+				else
+				{
+					messagePlayer(clientnum, language[3925], player);
+				}
+			}
 		}
-		else if ( !strncmp(command_str, "/minimapscale", 13) )
+		if ( achievementRangedMode[player] && !playerFailedRangedOnlyConduct[player] )
 		{
-			minimapScale = atoi(&command_str[14]);
-			minimapScale = std::min(std::max<int>(2, minimapScale), 16);
+			messagePlayer(player, language[3921]);
 		}
-		else if ( !strncmp(command_str, "/minimapobjectzoom", 18) )
+		else if ( achievementRangedMode[player] && playerFailedRangedOnlyConduct[player] )
 		{
-			minimapObjectZoom = atoi(&command_str[19]);
-			minimapObjectZoom = std::min(std::max<int>(0, minimapObjectZoom), 4);
+			messagePlayer(player, language[3924]);
 		}
-		else if ( !strncmp(command_str, "/uiscale_inv", 12) )
+		else if ( !achievementRangedMode[player] )
 		{
-			std::stringstream ss;
-			ss << command_str + 13;
-			ss >> uiscale_inventory;
+			messagePlayer(player, language[3922]);
 		}
-		else if ( !strncmp(command_str, "/uiscale_hotbar", 15) )
+	});
+	addPrefix("/gimmepotions", 13, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			std::stringstream ss;
-			ss << command_str + 16;
-			ss >> uiscale_hotbar;
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/uiscale_chatbox", 16) )
+
+		if ( multiplayer != SINGLE )
 		{
-			std::stringstream ss;
-			ss << command_str + 17;
-			ss >> uiscale_chatlog;
+			messagePlayer(clientnum, language[299]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/uiscale_playerbars", 19) )
+
+		std::vector<int> potionChances =
+		{
+			1,	//POTION_WATER,
+			1,	//POTION_BOOZE,
+			1,	//POTION_JUICE,
+			1,	//POTION_SICKNESS,
+			1,	//POTION_CONFUSION,
+			1,	//POTION_EXTRAHEALING,
+			1,	//POTION_HEALING,
+			1,	//POTION_CUREAILMENT,
+			1,	//POTION_BLINDNESS,
+			1,	//POTION_RESTOREMAGIC,
+			1,	//POTION_INVISIBILITY,
+			1,	//POTION_LEVITATION,
+			1,	//POTION_SPEED,
+			1,	//POTION_ACID,
+			1,	//POTION_PARALYSIS,
+			1,	//POTION_POLYMORPH
+		};
+
+		std::discrete_distribution<> potionDistribution(potionChances.begin(), potionChances.end());
+		for ( int i = 0; i < 10; ++i )
+		{
+			auto generatedPotion = potionStandardAppearanceMap.at(potionDistribution(fountainSeed));
+			Item* potion = newItem(static_cast<ItemType>(generatedPotion.first), static_cast<Status>(SERVICABLE + rand() % 2),
+				0, 1, generatedPotion.second, true, nullptr);
+			itemPickup(clientnum, potion);
+			//free(potion);
+		}
+	});
+	addPrefix("/hungoverstats", 14, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			std::stringstream ss;
-			ss << command_str + 20;
-			ss >> uiscale_playerbars;
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/uiscale_charsheet", 18) )
+
+		if ( multiplayer != SINGLE )
 		{
-			uiscale_charactersheet = !uiscale_charactersheet;
+			messagePlayer(clientnum, language[299]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/uiscale_skillsheet", 19) )
+
+		messagePlayer(clientnum, "Hungover Active: %d, Time to go: %d, Drunk Active: %d, Drunk time: %d",
+			static_cast<int>(stats[clientnum]->EFFECTS[EFF_WITHDRAWAL]), static_cast<int>(stats[clientnum]->EFFECTS_TIMERS[EFF_WITHDRAWAL]),
+			static_cast<int>(stats[clientnum]->EFFECTS[EFF_DRUNK]), static_cast<int>(stats[clientnum]->EFFECTS_TIMERS[EFF_DRUNK]));
+		return;
+	});
+	addPrefix("/debugtimers", 12, [](const char* command_str)
+	{
+		logCheckMainLoopTimers = !logCheckMainLoopTimers;
+	});
+	addPrefix("/debugstatcache", 15, [](const char* command_str)
+	{
+		Stat::debugCheckDerivedStats = !Stat::debugCheckDerivedStats;
+		messagePlayer(clientnum, "Derived stat cache checks: %s", Stat::debugCheckDerivedStats ? "on" : "off");
+	});
+	addPrefix("/netstats", 9, [](const char* command_str)
+	{
+		SafePacketHandler.logStats();
+		messagePlayer(clientnum, "Safe packet stats written to log.");
+	});
+	addPrefix("/netsim", 7, [](const char* command_str)
+	{
+		char option[32] = "";
+		char value[32] = "";
+		sscanf(&command_str[7], "%31s %31s", option, value);
+		if ( !strcmp(option, "off") )
 		{
-			uiscale_skillspage = !uiscale_skillspage;
+			NetSimulator.conditions = NetSimulator_t::Conditions_t();
 		}
-		else if ( !strncmp(command_str, "/hidestatusbar", 14) )
+		else if ( !strcmp(option, "latency") )
 		{
-			hide_statusbar = !hide_statusbar;
+			NetSimulator.conditions.latency = std::max(0, atoi(value));
 		}
-		else if ( !strncmp(command_str, "/hideplayertags", 15) )
+		else if ( !strcmp(option, "jitter") )
 		{
-			hide_playertags = !hide_playertags;
+			NetSimulator.conditions.jitter = std::max(0, atoi(value));
 		}
-		else if ( !strncmp(command_str, "/showskillvalues", 16) )
+		else if ( !strcmp(option, "loss") )
 		{
-			show_skill_values = !show_skill_values;
+			NetSimulator.conditions.loss = std::min(100.0, std::max(0.0, atof(value)));
 		}
-		else if ( !strncmp(command_str, "/disablenetworkmultithreading", 29) )
+		else if ( !strcmp(option, "duplicate") )
 		{
-			disableMultithreadedSteamNetworking = true;// !disableMultithreadedSteamNetworking;
+			NetSimulator.conditions.duplicate = std::min(100.0, std::max(0.0, atof(value)));
 		}
-		else if ( !strncmp(command_str, "/autolimbreload", 15) )
+		else if ( !strcmp(option, "reorder") )
 		{
-			autoLimbReload = !autoLimbReload;
+			NetSimulator.conditions.reorder = std::min(100.0, std::max(0.0, atof(value)));
 		}
-		else if ( !strncmp(command_str, "/togglesecretlevel", 18) )
+		else if ( !strcmp(option, "direction") )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			if ( multiplayer != SINGLE )
-			{
-				messagePlayer(clientnum, language[299]);
-				return;
-			}
-			secretlevel = (secretlevel == false);
+			NetSimulator.conditions.incoming = strcmp(value, "out") != 0;
+			NetSimulator.conditions.outgoing = strcmp(value, "in") != 0;
 		}
-		else if ( !strncmp(command_str, "/seteffect ", 11) )
+		else if ( !strcmp(option, "seed") )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			if ( multiplayer != SINGLE )
-			{
-				messagePlayer(clientnum, language[299]);
-				return;
-			}
-
-			int effect = atoi(&command_str[11]);
-			if ( effect >= NUMEFFECTS || effect < 0 )
-			{
-				return;
-			}
-			else
-			{
-				players[clientnum]->entity->setEffect(effect, true, 500, true);
-			}
+			NetSimulator.setSeed(static_cast<Uint32>(strtoul(value, nullptr, 10)));
 		}
-		else if ( !strncmp(command_str, "/levelsummon", 12) )
+		else if ( strcmp(option, "") )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			for ( node_t* node = map.creatures->first; node != nullptr; node = node->next )
-			{
-				Entity* entity = (Entity*)node->element;
-				if ( entity && entity->behavior == &actMonster && entity->monsterAllySummonRank != 0 )
-				{
-					Stat* entityStats = entity->getStats();
-					if ( entityStats )
-					{
-						entityStats->EXP += 100;
-					}
-				}
-			}
+			messagePlayer(clientnum, "usage: /netsim [off|latency ms|jitter ms|loss %%|duplicate %%|reorder %%|direction in/out/both|seed n]");
 			return;
 		}
-		else if ( !strncmp(command_str, "/brawlermode", 12) )
+		NetSimulator.logStatus();
+		messagePlayer(clientnum, "Network simulator: %dms +/- %dms, %.1f%% loss, %.1f%% duplicate, %.1f%% reorder",
+			NetSimulator.conditions.latency, NetSimulator.conditions.jitter, NetSimulator.conditions.loss,
+			NetSimulator.conditions.duplicate, NetSimulator.conditions.reorder);
+	});
+	addPrefix("/netrecord", 10, [](const char* command_str)
+	{
+		char filename[64] = "";
+		sscanf(&command_str[10], "%63s", filename);
+		if ( !strcmp(filename, "") || NetSimulator.isRecording() )
 		{
-			achievementBrawlerMode = !achievementBrawlerMode;
-			if ( achievementBrawlerMode && conductGameChallenges[CONDUCT_BRAWLER] )
-			{
-				messagePlayer(clientnum, language[2995]);
-			}
-			else if ( achievementBrawlerMode && !conductGameChallenges[CONDUCT_BRAWLER] )
-			{
-				messagePlayer(clientnum, language[2998]);
-			}
-			else if ( !achievementBrawlerMode )
-			{
-				messagePlayer(clientnum, language[2996]);
-			}
+			NetSimulator.stopRecording();
+			messagePlayer(clientnum, "Stopped packet recording.");
 		}
-		else if ( !strncmp(command_str, "/rangermode", 11) )
+		else if ( NetSimulator.startRecording(filename) )
 		{
-			int player = -1;
-			if ( !strncmp(command_str, "/rangermode ", 12) )
-			{
-				player = std::min(std::max(0, atoi(&command_str[12])), MAXPLAYERS);
-			}
-			else
-			{
-				player = 0;
-			}
-
-			if ( multiplayer == CLIENT )
-			{
-				messagePlayer(clientnum, language[284]);
-				return;
-			}
-
-			achievementRangedMode[player] = !achievementRangedMode[player];
-			if ( multiplayer == SERVER )
-			{
-				if ( player != clientnum )
-				{
-					if ( achievementRangedMode[player] )
-					{
-						messagePlayer(clientnum, language[3926], player);
-					}
-					else
-					{
-						messagePlayer(clientnum, language[3925], player);
-					}
-				}
-			}
-			if ( achievementRangedMode[player] && !playerFailedRangedOnlyConduct[player] )
-			{
-				messagePlayer(player, language[3921]);
-			}
-			else if ( achievementRangedMode[player] && playerFailedRangedOnlyConduct[player] )
-			{
-				messagePlayer(player, language[3924]);
-			}
-			else if ( !achievementRangedMode[player] )
-			{
-				messagePlayer(player, language[3922]);
-			}
+			messagePlayer(clientnum, "Recording incoming packets to %s", filename);
 		}
-		else if ( !strncmp(command_str, "/gimmepotions", 13) )
+		else
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-
-			if ( multiplayer != SINGLE )
-			{
-				messagePlayer(clientnum, language[299]);
-				return;
-			}
-
-			std::vector<int> potionChances =
-			{
-				1,	//POTION_WATER,
-				1,	//POTION_BOOZE,
-				1,	//POTION_JUICE,
-				1,	//POTION_SICKNESS,
-				1,	//POTION_CONFUSION,
-				1,	//POTION_EXTRAHEALING,
-				1,	//POTION_HEALING,
-				1,	//POTION_CUREAILMENT,
-				1,	//POTION_BLINDNESS,
-				1,	//POTION_RESTOREMAGIC,
-				1,	//POTION_INVISIBILITY,
-				1,	//POTION_LEVITATION,
-				1,	//POTION_SPEED,
-				1,	//POTION_ACID,
-				1,	//POTION_PARALYSIS,
-				1,	//POTION_POLYMORPH
-			};
-
-			std::discrete_distribution<> potionDistribution(potionChances.begin(), potionChances.end());
-			for ( int i = 0; i < 10; ++i )
-			{
-				auto generatedPotion = potionStandardAppearanceMap.at(potionDistribution(fountainSeed));
-				Item* potion = newItem(static_cast<ItemType>(generatedPotion.first), static_cast<Status>(SERVICABLE + rand() % 2),
-					0, 1, generatedPotion.second, true, nullptr);
-				itemPickup(clientnum, potion);
-				//free(potion);
-			}
+			messagePlayer(clientnum, "Failed to open %s for recording.", filename);
+		}
+	});
+	addPrefix("/netreplay", 10, [](const char* command_str)
+	{
+		char filename[64] = "";
+		sscanf(&command_str[10], "%63s", filename);
+		if ( !strcmp(filename, "") )
+		{
+			messagePlayer(clientnum, "usage: /netreplay <file>");
 		}
-		else if ( !strncmp(command_str, "/hungoverstats", 14) )
+		else if ( NetSimulator.replay(filename) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-
-			if ( multiplayer != SINGLE )
-			{
-				messagePlayer(clientnum, language[299]);
-				return;
-			}
-
-			messagePlayer(clientnum, "Hungover Active: %d, Time to go: %d, Drunk Active: %d, Drunk time: %d",
-				stats[clientnum]->EFFECTS[EFF_WITHDRAWAL], stats[clientnum]->EFFECTS_TIMERS[EFF_WITHDRAWAL],
-				stats[clientnum]->EFFECTS[EFF_DRUNK], stats[clientnum]->EFFECTS_TIMERS[EFF_DRUNK]);
+			messagePlayer(clientnum, "Replayed %s, results written to log.", filename);
+		}
+		else
+		{
+			messagePlayer(clientnum, "Failed to replay %s, see log.", filename);
+		}
+	});
+	addPrefix("/entityfreeze", 13, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
+		{
+			messagePlayer(clientnum, language[277]);
 			return;
 		}
-		else if ( !strncmp(command_str, "/debugtimers", 12) )
+		gameloopFreezeEntities = !gameloopFreezeEntities;
+	});
+	addPrefix("/tickrate", 9, [](const char* command_str)
+	{
+		networkTickrate = atoi(&command_str[10]);
+		networkTickrate = std::max<Uint32>(1, networkTickrate);
+		messagePlayer(clientnum, "Set tickrate to %d, network processing allowed %3.0f percent of frame limit interval. Default value 2.", 
+			networkTickrate, 100.f / networkTickrate);
+	});
+	addPrefix("/allspells", 10, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			logCheckMainLoopTimers = !logCheckMainLoopTimers;
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/entityfreeze", 13) )
+
+		for ( auto it = allGameSpells.begin(); it != allGameSpells.end(); ++it )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			gameloopFreezeEntities = !gameloopFreezeEntities;
+			spell_t* spell = *it;
+			bool learned = addSpell(spell->ID, clientnum, true);
 		}
-		else if ( !strncmp(command_str, "/tickrate", 9) )
+		return;
+	});
+	addPrefix("/setmapseed ", 12, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			networkTickrate = atoi(&command_str[10]);
-			networkTickrate = std::max<Uint32>(1, networkTickrate);
-			messagePlayer(clientnum, "Set tickrate to %d, network processing allowed %3.0f percent of frame limit interval. Default value 2.", 
-				networkTickrate, 100.f / networkTickrate);
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/disablenetcodefpslimit", 23) )
+		if ( multiplayer == CLIENT )
 		{
-			disableFPSLimitOnNetworkMessages = !disableFPSLimitOnNetworkMessages;
+			messagePlayer(clientnum, language[284]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/allspells", 10) )
+		
+		Uint32 newseed = atoi(&command_str[12]);
+		forceMapSeed = newseed;
+		messagePlayer(clientnum, "Set next map seed to: %d", forceMapSeed);
+		return;
+	});
+	addPrefix("/greaseme", 9, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-
-			for ( auto it = allGameSpells.begin(); it != allGameSpells.end(); ++it )
-			{
-				spell_t* spell = *it;
-				bool learned = addSpell(spell->ID, clientnum, true);
-			}
+			messagePlayer(clientnum, language[277]);
 			return;
 		}
-		else if ( !strncmp(command_str, "/setmapseed ", 12) )
+		if ( multiplayer == CLIENT )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			if ( multiplayer == CLIENT )
-			{
-				messagePlayer(clientnum, language[284]);
-				return;
-			}
-			
-			Uint32 newseed = atoi(&command_str[12]);
-			forceMapSeed = newseed;
-			messagePlayer(clientnum, "Set next map seed to: %d", forceMapSeed);
+			messagePlayer(clientnum, language[284]);
 			return;
 		}
-		else if ( !strncmp(command_str, "/greaseme", 9) )
+		if ( players[clientnum] && players[clientnum]->entity )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			if ( multiplayer == CLIENT )
-			{
-				messagePlayer(clientnum, language[284]);
-				return;
-			}
-			if ( players[clientnum] && players[clientnum]->entity )
-			{
-				players[clientnum]->entity->setEffect(EFF_GREASY, true, TICKS_PER_SECOND * 20, false);
-			}
+			players[clientnum]->entity->setEffect(EFF_GREASY, true, TICKS_PER_SECOND * 20, false);
 		}
-		else if ( !strncmp(command_str, "/gimmearrows", 12) )
+	});
+	addPrefix("/gimmearrows", 12, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			for ( int i = QUIVER_SILVER; i <= QUIVER_HUNTING; ++i )
-			{
-				dropItem(newItem(static_cast<ItemType>(i), EXCELLENT, 0, 25 + rand() % 26, rand(), true, &stats[clientnum]->inventory), 0);
-			}
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/gimmescrap", 11) )
+		for ( int i = QUIVER_SILVER; i <= QUIVER_HUNTING; ++i )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			dropItem(newItem(TOOL_METAL_SCRAP, EXCELLENT, 0, 100, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_MAGIC_SCRAP, EXCELLENT, 0, 100, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_TINKERING_KIT, EXCELLENT, 0, 1, rand(), true, &stats[clientnum]->inventory), 0);
+			dropItem(newItem(static_cast<ItemType>(i), EXCELLENT, 0, 25 + rand() % 26, rand(), true, &stats[clientnum]->inventory), 0);
 		}
-		else if ( !strncmp(command_str, "/gimmerobots", 12) )
+	});
+	addPrefix("/gimmescrap", 11, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			dropItem(newItem(TOOL_GYROBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_DUMMYBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_SENTRYBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_SPELLBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/toggletinkeringlimits", 22) )
+		dropItem(newItem(TOOL_METAL_SCRAP, EXCELLENT, 0, 100, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_MAGIC_SCRAP, EXCELLENT, 0, 100, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_TINKERING_KIT, EXCELLENT, 0, 1, rand(), true, &stats[clientnum]->inventory), 0);
+	});
+	addPrefix("/gimmerobots", 12, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			overrideTinkeringLimit = !overrideTinkeringLimit;
-			if ( overrideTinkeringLimit )
-			{
-				messagePlayer(clientnum, "Disabled tinkering bot limit");
-			}
-			else
-			{
-				messagePlayer(clientnum, "Re-enabled tinkering bot limit");
-			}
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/setdecoyrange ", 15) )
+		dropItem(newItem(TOOL_GYROBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_DUMMYBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_SENTRYBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_SPELLBOT, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+	});
+	addPrefix("/toggletinkeringlimits", 22, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			if ( multiplayer == CLIENT )
-			{
-				messagePlayer(clientnum, language[284]);
-				return;
-			}
-			decoyBoxRange = atoi(&command_str[15]);
-			messagePlayer(clientnum, "Set decoy range to %d", decoyBoxRange);
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/gimmegoblinbooks", 17) )
+		overrideTinkeringLimit = !overrideTinkeringLimit;
+		if ( overrideTinkeringLimit )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			for ( int i = 0; i < NUM_SPELLS; ++i )
-			{
-				int spellbook = getSpellbookFromSpellID(i);
-				dropItem(newItem(static_cast<ItemType>(spellbook), DECREPIT, -1, 1, rand(), true, &stats[clientnum]->inventory), 0);
-			}
+			messagePlayer(clientnum, "Disabled tinkering bot limit");
 		}
-		else if ( !strncmp(command_str, "/unsetdlc2achievements", 22) )
+		else
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-#ifdef STEAMWORKS
-			steamUnsetAchievement("BARONY_ACH_TAKING_WITH");
-			steamUnsetAchievement("BARONY_ACH_TELEFRAG");
-			steamUnsetAchievement("BARONY_ACH_FASCIST");
-			steamUnsetAchievement("BARONY_ACH_REAL_BOY");
-			steamUnsetAchievement("BARONY_ACH_OVERCLOCKED");
-			steamUnsetAchievement("BARONY_ACH_TRASH_COMPACTOR");
-			steamUnsetAchievement("BARONY_ACH_BOILERPLATE_BARON");
-			steamUnsetAchievement("BARONY_ACH_PIMPIN");
-			steamUnsetAchievement("BARONY_ACH_BAD_BEAUTIFUL");
-			steamUnsetAchievement("BARONY_ACH_SERIAL_THRILLA");
-			steamUnsetAchievement("BARONY_ACH_TRADITION");
-			steamUnsetAchievement("BARONY_ACH_BAD_BOY_BARON");
-			steamUnsetAchievement("BARONY_ACH_POP_QUIZ");
-			steamUnsetAchievement("BARONY_ACH_DYSLEXIA");
-			steamUnsetAchievement("BARONY_ACH_SAVAGE");
-			steamUnsetAchievement("BARONY_ACH_TRIBE_SUBSCRIBE");
-			steamUnsetAchievement("BARONY_ACH_BAYOU_BARON");
-			steamUnsetAchievement("BARONY_ACH_GASTRIC_BYPASS");
-			steamUnsetAchievement("BARONY_ACH_BOOKWORM");
-			steamUnsetAchievement("BARONY_ACH_FLUTTERSHY");
-			steamUnsetAchievement("BARONY_ACH_MONARCH");
-			steamUnsetAchievement("BARONY_ACH_BUGGAR_BARON");
-			steamUnsetAchievement("BARONY_ACH_TIME_TO_PLAN");
-			steamUnsetAchievement("BARONY_ACH_WONDERFUL_TOYS");
-			steamUnsetAchievement("BARONY_ACH_SUPER_SHREDDER");
-			steamUnsetAchievement("BARONY_ACH_UTILITY_BELT");
-			steamUnsetAchievement("BARONY_ACH_FIXER_UPPER");
-			steamUnsetAchievement("BARONY_ACH_TORCHERER");
-			steamUnsetAchievement("BARONY_ACH_LEVITANT_LACKEY");
-			steamUnsetAchievement("BARONY_ACH_GOODNIGHT_SWEET_PRINCE");
-			steamUnsetAchievement("BARONY_ACH_MANY_PEDI_PALP");
-			steamUnsetAchievement("BARONY_ACH_5000_SECOND_RULE");
-			steamUnsetAchievement("BARONY_ACH_FORUM_TROLL");
-			steamUnsetAchievement("BARONY_ACH_SOCIAL_BUTTERFLY");
-			steamUnsetAchievement("BARONY_ACH_ROLL_THE_BONES");
-			steamUnsetAchievement("BARONY_ACH_COWBOY_FROM_HELL");
-			steamUnsetAchievement("BARONY_ACH_IRONIC_PUNISHMENT");
-			steamUnsetAchievement("BARONY_ACH_SELF_FLAGELLATION");
-			steamUnsetAchievement("BARONY_ACH_OHAI_MARK");
-			steamUnsetAchievement("BARONY_ACH_CHOPPING_BLOCK");
-			steamUnsetAchievement("BARONY_ACH_ITS_A_LIVING");
-			steamUnsetAchievement("BARONY_ACH_ARSENAL");
-			steamUnsetAchievement("BARONY_ACH_IF_YOU_LOVE_SOMETHING");
-			steamUnsetAchievement("BARONY_ACH_GUDIPARIAN_BAZI");
-			steamUnsetAchievement("BARONY_ACH_STRUNG_OUT");
-			steamUnsetAchievement("BARONY_ACH_FELL_BEAST");
-			steamUnsetAchievement("BARONY_ACH_PLEASE_HOLD");
-			steamUnsetAchievement("BARONY_ACH_SWINGERS");
-			steamUnsetAchievement("BARONY_ACH_COLD_BLOODED");
-			steamUnsetAchievement("BARONY_ACH_SOULLESS");
-			steamUnsetAchievement("BARONY_ACH_TRIBAL");
-			steamUnsetAchievement("BARONY_ACH_MANAGEMENT_TEAM");
-			steamUnsetAchievement("BARONY_ACH_SOCIOPATHS");
-			steamUnsetAchievement("BARONY_ACH_FACES_OF_DEATH");
-			steamUnsetAchievement("BARONY_ACH_SURVIVALISTS");
-			steamUnsetAchievement("BARONY_ACH_I_WANT_IT_ALL");
-			steamUnsetAchievement("BARONY_ACH_RUST_IN_PEACE");
-			steamUnsetAchievement("BARONY_ACH_MACHINE_HEAD");
-			steamUnsetAchievement("BARONY_ACH_RAGE_AGAINST");
-			steamUnsetAchievement("BARONY_ACH_GUERILLA_RADIO");
-			steamUnsetAchievement("BARONY_ACH_BOMBTRACK");
-			steamUnsetAchievement("BARONY_ACH_CALM_LIKE_A_BOMB");
-			steamUnsetAchievement("BARONY_ACH_CAUGHT_IN_A_MOSH");
-			steamUnsetAchievement("BARONY_ACH_SPICY");
-			for ( int i = STEAM_STAT_TRASH_COMPACTOR; i < 43; ++i )
-			{
-				g_SteamStats[i].m_iValue = 0;
-				SteamUserStats()->SetStat(g_SteamStats[i].m_pchStatName, 0);
-			}
-			SteamUserStats()->StoreStats();
-#endif // STEAMWORKS
+			messagePlayer(clientnum, "Re-enabled tinkering bot limit");
 		}
-		else if ( !strncmp(command_str, "/gimmebombs", 11) )
+	});
+	addPrefix("/setdecoyrange ", 15, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			dropItem(newItem(TOOL_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_FREEZE_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_TELEPORT_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
-			dropItem(newItem(TOOL_SLEEP_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/showhunger", 11) )
+		if ( multiplayer == CLIENT )
 		{
-			if ( !(svFlags & SV_FLAG_CHEATS) )
-			{
-				messagePlayer(clientnum, language[277]);
-				return;
-			}
-			messagePlayer(clientnum, "Hunger value: %d", stats[clientnum]->HUNGER);
+			messagePlayer(clientnum, language[284]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/disablemouserotationlimit", 26) )
+		decoyBoxRange = atoi(&command_str[15]);
+		messagePlayer(clientnum, "Set decoy range to %d", decoyBoxRange);
+	});
+	addPrefix("/gimmegoblinbooks", 17, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			disablemouserotationlimit = (disablemouserotationlimit == false);
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/usecamerasmoothing", 19) )
+		for ( int i = 0; i < NUM_SPELLS; ++i )
 		{
-			usecamerasmoothing = (usecamerasmoothing == false);
+			int spellbook = getSpellbookFromSpellID(i);
+			dropItem(newItem(static_cast<ItemType>(spellbook), DECREPIT, -1, 1, rand(), true, &stats[clientnum]->inventory), 0);
 		}
-		else if ( !strncmp(command_str, "/lightupdate ", 13) )
+	});
+	addPrefix("/unsetdlc2achievements", 22, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			globalLightSmoothingRate = atoi(&command_str[13]);
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/dumpnetworkdata", 16) )
+#ifdef STEAMWORKS
+		steamUnsetAchievement("BARONY_ACH_TAKING_WITH");
+		steamUnsetAchievement("BARONY_ACH_TELEFRAG");
+		steamUnsetAchievement("BARONY_ACH_FASCIST");
+		steamUnsetAchievement("BARONY_ACH_REAL_BOY");
+		steamUnsetAchievement("BARONY_ACH_OVERCLOCKED");
+		steamUnsetAchievement("BARONY_ACH_TRASH_COMPACTOR");
+		steamUnsetAchievement("BARONY_ACH_BOILERPLATE_BARON");
+		steamUnsetAchievement("BARONY_ACH_PIMPIN");
+		steamUnsetAchievement("BARONY_ACH_BAD_BEAUTIFUL");
+		steamUnsetAchievement("BARONY_ACH_SERIAL_THRILLA");
+		steamUnsetAchievement("BARONY_ACH_TRADITION");
+		steamUnsetAchievement("BARONY_ACH_BAD_BOY_BARON");
+		steamUnsetAchievement("BARONY_ACH_POP_QUIZ");
+		steamUnsetAchievement("BARONY_ACH_DYSLEXIA");
+		steamUnsetAchievement("BARONY_ACH_SAVAGE");
+		steamUnsetAchievement("BARONY_ACH_TRIBE_SUBSCRIBE");
+		steamUnsetAchievement("BARONY_ACH_BAYOU_BARON");
+		steamUnsetAchievement("BARONY_ACH_GASTRIC_BYPASS");
+		steamUnsetAchievement("BARONY_ACH_BOOKWORM");
+		steamUnsetAchievement("BARONY_ACH_FLUTTERSHY");
+		steamUnsetAchievement("BARONY_ACH_MONARCH");
+		steamUnsetAchievement("BARONY_ACH_BUGGAR_BARON");
+		steamUnsetAchievement("BARONY_ACH_TIME_TO_PLAN");
+		steamUnsetAchievement("BARONY_ACH_WONDERFUL_TOYS");
+		steamUnsetAchievement("BARONY_ACH_SUPER_SHREDDER");
+		steamUnsetAchievement("BARONY_ACH_UTILITY_BELT");
+		steamUnsetAchievement("BARONY_ACH_FIXER_UPPER");
+		steamUnsetAchievement("BARONY_ACH_TORCHERER");
+		steamUnsetAchievement("BARONY_ACH_LEVITANT_LACKEY");
+		steamUnsetAchievement("BARONY_ACH_GOODNIGHT_SWEET_PRINCE");
+		steamUnsetAchievement("BARONY_ACH_MANY_PEDI_PALP");
+		steamUnsetAchievement("BARONY_ACH_5000_SECOND_RULE");
+		steamUnsetAchievement("BARONY_ACH_FORUM_TROLL");
+		steamUnsetAchievement("BARONY_ACH_SOCIAL_BUTTERFLY");
+		steamUnsetAchievement("BARONY_ACH_ROLL_THE_BONES");
+		steamUnsetAchievement("BARONY_ACH_COWBOY_FROM_HELL");
+		steamUnsetAchievement("BARONY_ACH_IRONIC_PUNISHMENT");
+		steamUnsetAchievement("BARONY_ACH_SELF_FLAGELLATION");
+		steamUnsetAchievement("BARONY_ACH_OHAI_MARK");
+		steamUnsetAchievement("BARONY_ACH_CHOPPING_BLOCK");
+		steamUnsetAchievement("BARONY_ACH_ITS_A_LIVING");
+		steamUnsetAchievement("BARONY_ACH_ARSENAL");
+		steamUnsetAchievement("BARONY_ACH_IF_YOU_LOVE_SOMETHING");
+		steamUnsetAchievement("BARONY_ACH_GUDIPARIAN_BAZI");
+		steamUnsetAchievement("BARONY_ACH_STRUNG_OUT");
+		steamUnsetAchievement("BARONY_ACH_FELL_BEAST");
+		steamUnsetAchievement("BARONY_ACH_PLEASE_HOLD");
+		steamUnsetAchievement("BARONY_ACH_SWINGERS");
+		steamUnsetAchievement("BARONY_ACH_COLD_BLOODED");
+		steamUnsetAchievement("BARONY_ACH_SOULLESS");
+		steamUnsetAchievement("BARONY_ACH_TRIBAL");
+		steamUnsetAchievement("BARONY_ACH_MANAGEMENT_TEAM");
+		steamUnsetAchievement("BARONY_ACH_SOCIOPATHS");
+		steamUnsetAchievement("BARONY_ACH_FACES_OF_DEATH");
+		steamUnsetAchievement("BARONY_ACH_SURVIVALISTS");
+		steamUnsetAchievement("BARONY_ACH_I_WANT_IT_ALL");
+		steamUnsetAchievement("BARONY_ACH_RUST_IN_PEACE");
+		steamUnsetAchievement("BARONY_ACH_MACHINE_HEAD");
+		steamUnsetAchievement("BARONY_ACH_RAGE_AGAINST");
+		steamUnsetAchievement("BARONY_ACH_GUERILLA_RADIO");
+		steamUnsetAchievement("BARONY_ACH_BOMBTRACK");
+		steamUnsetAchievement("BARONY_ACH_CALM_LIKE_A_BOMB");
+		steamUnsetAchievement("BARONY_ACH_CAUGHT_IN_A_MOSH");
+		steamUnsetAchievement("BARONY_ACH_SPICY");
+		for ( int i = STEAM_STAT_TRASH_COMPACTOR; i < 43; ++i )
+		{
+			g_SteamStats[i].m_iValue = 0;
+			SteamUserStats()->SetStat(g_SteamStats[i].m_pchStatName, 0);
+		}
+		SteamUserStats()->StoreStats();
+#endif // STEAMWORKS
+	});
+	addPrefix("/gimmebombs", 11, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			for ( auto element : DebugStats.networkPackets )
-			{
-				printlog("Packet: %s | %d", element.second.first.c_str(), element.second.second);
-			}
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/dumpentudata", 13) )
+		dropItem(newItem(TOOL_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_FREEZE_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_TELEPORT_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+		dropItem(newItem(TOOL_SLEEP_BOMB, EXCELLENT, 0, 10, rand(), true, &stats[clientnum]->inventory), 0);
+	});
+	addPrefix("/showhunger", 11, [](const char* command_str)
+	{
+		if ( !(svFlags & SV_FLAG_CHEATS) )
 		{
-			for ( auto element : DebugStats.entityUpdatePackets )
-			{
-				printlog("Sprite: %d | %d", element.first, element.second);
-			}
+			messagePlayer(clientnum, language[277]);
+			return;
 		}
-		else if ( !strncmp(command_str, "/borderless", 11) )
+		messagePlayer(clientnum, "Hunger value: %d", stats[clientnum]->HUNGER);
+	});
+	addPrefix("/usecamerasmoothing", 19, [](const char* command_str)
+	{
+		usecamerasmoothing = (usecamerasmoothing == false);
+	});
+	addPrefix("/lightupdate ", 13, [](const char* command_str)
+	{
+		globalLightSmoothingRate = atoi(&command_str[13]);
+	});
+	addPrefix("/dumpnetworkdata", 16, [](const char* command_str)
+	{
+		for ( auto element : DebugStats.networkPackets )
 		{
-			borderless = (!borderless);
+			printlog("Packet: %s | %d", element.second.first.c_str(), element.second.second);
 		}
-		else if ( !strncmp(command_str, "/jsonexportmonster ", 19) )
+	});
+	addPrefix("/dumpentudata", 13, [](const char* command_str)
+	{
+		for ( auto element : DebugStats.entityUpdatePackets )
 		{
-			strcpy(name, command_str + 19);
-			int creature = NOTHING;
+			printlog("Sprite: %d | %d", element.first, element.second);
+		}
+	});
+	addPrefix("/jsonexportmonster ", 19, [](const char* command_str)
+	{
+		char name[64];
+		strcpy(name, command_str + 19);
+		int creature = NOTHING;
 
-			for ( int i = 1; i < NUMMONSTERS; ++i )   //Start at 1 because 0 is a nothing.
+		for ( int i = 1; i < NUMMONSTERS; ++i )   //Start at 1 because 0 is a nothing.
+		{
+			if ( i < KOBOLD ) //Search original monsters
 			{
-				if ( i < KOBOLD ) //Search original monsters
+				if ( strstr(language[90 + i], name) )
 				{
-					if ( strstr(language[90 + i], name) )
-					{
-						creature = i;
-						break;
-					}
+					creature = i;
+					break;
 				}
-				else if ( i >= KOBOLD ) //Search additional monsters
+			}
+			else if ( i >= KOBOLD ) //Search additional monsters
+			{
+				if ( strstr(language[2000 + (i - KOBOLD)], name) )
 				{
-					if ( strstr(language[2000 + (i - KOBOLD)], name) )
-					{
-						creature = i;
-						break;
-					}
+					creature = i;
+					break;
 				}
-
 			}
 
-			if ( creature != NOTHING )
-			{
-				Stat* monsterStats = new Stat(1000 + creature);
-				monsterStatCustomManager.writeAllFromStats(monsterStats);
-				delete monsterStats;
-			}
 		}
-		else if ( !strncmp(command_str, "/jsonexportfromcursor", 21) )
+
+		if ( creature != NOTHING )
 		{
-			Entity* target = entityClicked(nullptr, true, clientnum, EntityClickType::ENTITY_CLICK_USE);
-			if ( target )
+			Stat* monsterStats = new Stat(1000 + creature);
+			monsterStatCustomManager.writeAllFromStats(monsterStats);
+			delete monsterStats;
+		}
+	});
+	addPrefix("/jsonexportfromcursor", 21, [](const char* command_str)
+	{
+		Entity* target = entityClicked(nullptr, true, clientnum, EntityClickType::ENTITY_CLICK_USE);
+		if ( target )
+		{
+			Entity* parent = uidToEntity(target->skill[2]);
+			if ( target->behavior == &actMonster || (parent && parent->behavior == &actMonster) )
 			{
-				Entity* parent = uidToEntity(target->skill[2]);
-				if ( target->behavior == &actMonster || (parent && parent->behavior == &actMonster) )
+				// see if we selected a limb
+				if ( parent )
 				{
-					// see if we selected a limb
-					if ( parent )
-					{
-						target = parent;
-					}
+					target = parent;
 				}
-				monsterStatCustomManager.writeAllFromStats(target->getStats());
 			}
+			monsterStatCustomManager.writeAllFromStats(target->getStats());
 		}
-		else if ( !strncmp(command_str, "/newui", 6) ) {
-			newui = !newui;
+	});
+	addPrefix("/newui", 6, [](const char* command_str)
+	{
+		newui = !newui;
+	});
+	addPrefix("/jsonexportgameplaymodifiers", 28, [](const char* command_str)
+	{
+		gameplayCustomManager.writeAllToDocument();
+	});
+	addPrefix("/jsonexportmonstercurve", 23, [](const char* command_str)
+	{
+		monsterCurveCustomManager.writeSampleToDocument();
+	});
+	addPrefix("/jsoncache", 10, [](const char* command_str)
+	{
+		if ( !strncmp(command_str, "/jsoncache clear", 16) )
+		{
+			jsonFileCache.clear();
+			messagePlayer(clientnum, "Cleared cached json files.");
 		}
-		else if ( !strncmp(command_str, "/jsonexportgameplaymodifiers", 28) )
+		jsonFileCache.logStatus();
+		monsterStatCustomManager.logStatus();
+	});
+	addPrefix("/hudstats", 9, [](const char* command_str)
+	{
+		HudCache.logStatus();
+		if ( !strncmp(command_str, "/hudstats reset", 15) )
 		{
-			gameplayCustomManager.writeAllToDocument();
+			HudCache.resetStats();
+			messagePlayer(clientnum, "Reset HUD timers.");
 		}
-		else if ( !strncmp(command_str, "/jsonexportmonstercurve", 23) )
+	});
+	addPrefix("/aistats", 8, [](const char* command_str)
+	{
+		if ( !strncmp(command_str, "/aistats reset", 14) )
 		{
-			monsterCurveCustomManager.writeSampleToDocument();
+			MonsterAILOD.resetStats();
+			LineOfSight.resetStats();
+			messagePlayer(clientnum, "Reset monster AI stats.");
 		}
-		else if ( !strncmp(command_str, "/crossplay", 10) )
+		else if ( !strncmp(command_str, "/aistats lod", 12) )
 		{
-#if (defined STEAMWORKS && defined USE_EOS)
-			EOS.CrossplayAccountManager.autologin = true;
-#endif // USE_EOS
+			MonsterAILOD.enabled = !MonsterAILOD.enabled;
+			MonsterAILOD.resetStats();
+			messagePlayer(clientnum, "Monster AI level of detail %s.", MonsterAILOD.enabled ? "enabled" : "disabled");
+		}
+		else
+		{
+			MonsterAILOD.logStatus();
+			LineOfSight.logStatus();
+		}
+	});
+	addPrefix("/benchmarkfilehelper", 20, [](const char* command_str)
+	{
+		int iterations = 50;
+		if ( !strncmp(command_str, "/benchmarkfilehelper ", 21) )
+		{
+			iterations = std::max(1, atoi(&command_str[21]));
+		}
+		FileHelper::benchmark(iterations);
+		messagePlayer(clientnum, "[JSON]: Benchmark results written to log.");
+	});
+	addPrefix("/benchmarklist", 14, [](const char* command_str)
+	{
+		int numNodes = 1000;
+		if ( !strncmp(command_str, "/benchmarklist ", 15) )
+		{
+			numNodes = std::max(1, atoi(&command_str[15]));
+		}
+		list_Benchmark(numNodes, 10000);
+		messagePlayer(clientnum, "[LIST]: Benchmark results written to log.");
+	});
+	addPrefix("/benchmarkvismap", 16, [](const char* command_str)
+	{
+		int iterations = 1000;
+		if ( !strncmp(command_str, "/benchmarkvismap ", 17) )
+		{
+			iterations = std::max(1, atoi(&command_str[17]));
 		}
+		VisibilityMap::benchmark(iterations);
+		messagePlayer(clientnum, "[VISMAP]: Benchmark results written to log.");
+	});
+	addPrefix("/benchmarknet", 13, [](const char* command_str)
+	{
+		int numPackets = 10000;
+		if ( !strncmp(command_str, "/benchmarknet ", 14) )
+		{
+			numPackets = std::max(1, atoi(&command_str[14]));
+		}
+		netLoopbackBenchmark(numPackets);
+		messagePlayer(clientnum, "[NET]: Benchmark results written to log.");
+	});
+	addPrefix("/togglenetworkthread", 20, [](const char* command_str)
+	{
+		disableDirectConnectNetworkThread = !disableDirectConnectNetworkThread;
+		messagePlayer(clientnum, "Direct-connect network thread: %s (takes effect next game)", disableDirectConnectNetworkThread ? "off" : "on");
+	});
 #if (defined SOUND)
-		else if ( !strncmp(command_str, "/sfxambientvolume", 17) )
+	addPrefix("/sfxambientdynamic", 18, [](const char* command_str)
+	{
+		sfxUseDynamicAmbientVolume = !sfxUseDynamicAmbientVolume;
+		if ( sfxUseDynamicAmbientVolume )
 		{
-			sfxAmbientVolume = atoi(&command_str[18]);
+			messagePlayer(clientnum, "Dynamic ambient volume ON");
 		}
-		else if ( !strncmp(command_str, "/sfxambientdynamic", 18) )
+		else
 		{
-			sfxUseDynamicAmbientVolume = !sfxUseDynamicAmbientVolume;
-			if ( sfxUseDynamicAmbientVolume )
-			{
-				messagePlayer(clientnum, "Dynamic ambient volume ON");
-			}
-			else
-			{
-				messagePlayer(clientnum, "Dynamic ambient volume OFF");
-			}
+			messagePlayer(clientnum, "Dynamic ambient volume OFF");
 		}
-		else if ( !strncmp(command_str, "/sfxenvironmentdynamic", 22) )
+	});
+	addPrefix("/sfxenvironmentdynamic", 22, [](const char* command_str)
+	{
+		sfxUseDynamicEnvironmentVolume = !sfxUseDynamicEnvironmentVolume;
+		if ( sfxUseDynamicEnvironmentVolume )
 		{
-			sfxUseDynamicEnvironmentVolume = !sfxUseDynamicEnvironmentVolume;
-			if ( sfxUseDynamicEnvironmentVolume )
-			{
-				messagePlayer(clientnum, "Dynamic environment volume ON");
-			}
-			else
-			{
-				messagePlayer(clientnum, "Dynamic environment volume OFF");
-			}
+			messagePlayer(clientnum, "Dynamic environment volume ON");
 		}
-		else if ( !strncmp(command_str, "/sfxenvironmentvolume", 21) )
+		else
 		{
-			sfxEnvironmentVolume = atoi(&command_str[22]);
+			messagePlayer(clientnum, "Dynamic environment volume OFF");
 		}
+	});
 #endif
-		else if ( !strncmp(command_str, "/cyclekeyboard", 14) )
+	addPrefix("/cyclekeyboard", 14, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
+				if ( i + 1 >= MAXPLAYERS )
 				{
-					if ( i + 1 >= MAXPLAYERS )
-					{
-						inputs.setPlayerIDAllowedKeyboard(0);
-						messagePlayer(clientnum, "Keyboard controlled by player %d", 0);
-					}
-					else
-					{
-						inputs.setPlayerIDAllowedKeyboard(i + 1);
-						messagePlayer(clientnum, "Keyboard controlled by player %d", i + 1);
-					}
-					break;
+					inputs.setPlayerIDAllowedKeyboard(0);
+					messagePlayer(clientnum, "Keyboard controlled by player %d", 0);
 				}
-			}
-		}
-		else if ( !strncmp(command_str, "/cyclegamepad", 13) )
-		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
-			{
-				if ( inputs.hasController(i) )
+				else
 				{
-					int id = inputs.getControllerID(i);
-					inputs.removeControllerWithDeviceID(id);
-					if ( i + 1 >= MAXPLAYERS )
-					{
-						inputs.setControllerID(0, id);
-					}
-					else
-					{
-						inputs.setControllerID(i + 1, id);
-					}
-					break;
+					inputs.setPlayerIDAllowedKeyboard(i + 1);
+					messagePlayer(clientnum, "Keyboard controlled by player %d", i + 1);
 				}
+				break;
 			}
 		}
-		else if ( !strncmp(command_str, "/cycledeadzoneleft", 18) )
+	});
+	addPrefix("/cyclegamepad", 13, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.hasController(i) )
 			{
-				if ( inputs.hasController(i) )
+				int id = inputs.getControllerID(i);
+				inputs.removeControllerWithDeviceID(id);
+				if ( i + 1 >= MAXPLAYERS )
 				{
-					switch ( inputs.getController(i)->leftStickDeadzoneType )
-					{
-						case GameController::DEADZONE_PER_AXIS:
-							inputs.getController(i)->leftStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_LINEAR;
-							messagePlayer(i, "Using radial deadzone on left stick.");
-							break;
-						case GameController::DEADZONE_MAGNITUDE_LINEAR:
-							inputs.getController(i)->leftStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_HALFPIPE;
-							messagePlayer(i, "Using curved radial deadzone on left stick.");
-							break;
-						case GameController::DEADZONE_MAGNITUDE_HALFPIPE:
-							inputs.getController(i)->leftStickDeadzoneType = GameController::DEADZONE_PER_AXIS;
-							messagePlayer(i, "Using per-axis deadzone on left stick.");
-							break;
-					}
+					inputs.setControllerID(0, id);
 				}
-			}
-		}
-		else if ( !strncmp(command_str, "/cycledeadzoneright", 19) )
-		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
-			{
-				if ( inputs.hasController(i) )
+				else
 				{
-					switch ( inputs.getController(i)->rightStickDeadzoneType )
-					{
-						case GameController::DEADZONE_PER_AXIS:
-							inputs.getController(i)->rightStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_LINEAR;
-							messagePlayer(i, "Using radial deadzone on right stick.");
-							break;
-						case GameController::DEADZONE_MAGNITUDE_LINEAR:
-							inputs.getController(i)->rightStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_HALFPIPE;
-							messagePlayer(i, "Using curved radial deadzone on right stick.");
-							break;
-						case GameController::DEADZONE_MAGNITUDE_HALFPIPE:
-							inputs.getController(i)->rightStickDeadzoneType = GameController::DEADZONE_PER_AXIS;
-							messagePlayer(i, "Using per-axis deadzone on right stick.");
-							break;
-					}
+					inputs.setControllerID(i + 1, id);
 				}
+				break;
 			}
 		}
-		else if ( !strncmp(command_str, "/vibration", 10) )
+	});
+	addPrefix("/cycledeadzoneleft", 18, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.hasController(i) )
 			{
-				if ( inputs.hasController(i) )
+				switch ( inputs.getController(i)->leftStickDeadzoneType )
 				{
-					inputs.getController(i)->haptics.vibrationEnabled = !inputs.getController(i)->haptics.vibrationEnabled;
-					if ( inputs.getController(i)->haptics.vibrationEnabled )
-					{
-						messagePlayer(i, "Controller vibration is enabled.");
-					}
-					else
-					{
-						messagePlayer(i, "Controller vibration is disabled.");
-					}
+					case GameController::DEADZONE_PER_AXIS:
+						inputs.getController(i)->leftStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_LINEAR;
+						messagePlayer(i, "Using radial deadzone on left stick.");
+						break;
+					case GameController::DEADZONE_MAGNITUDE_LINEAR:
+						inputs.getController(i)->leftStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_HALFPIPE;
+						messagePlayer(i, "Using curved radial deadzone on left stick.");
+						break;
+					case GameController::DEADZONE_MAGNITUDE_HALFPIPE:
+						inputs.getController(i)->leftStickDeadzoneType = GameController::DEADZONE_PER_AXIS;
+						messagePlayer(i, "Using per-axis deadzone on left stick.");
+						break;
 				}
 			}
 		}
-		else if ( !strncmp(command_str, "/tooltipoffset ", 15) )
-		{
-			int offset = atoi((char*)(command_str + 15));
-			Player::WorldUI_t::tooltipHeightOffsetZ = static_cast<real_t>(offset) / 10.0;
-			messagePlayer(clientnum, "Tooltip Z offset set to: %.1f", Player::WorldUI_t::tooltipHeightOffsetZ);
-		}
-		else if ( !strncmp(command_str, "/radialhotbar", 13) )
-		{
-			players[clientnum]->hotbar.useHotbarRadialMenu = !players[clientnum]->hotbar.useHotbarRadialMenu;
-		}
-		else if ( !strncmp(command_str, "/radialhotslots ", 16) )
-		{
-			int slots = atoi((char*)(command_str + 16));
-			players[clientnum]->hotbar.radialHotbarSlots = slots;
-			messagePlayer(clientnum, "Slots in use: %d", slots);
-		}
-		else if ( !strncmp(command_str, "/facehotbar", 11) )
+	});
+	addPrefix("/cycledeadzoneright", 19, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.hasController(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
+				switch ( inputs.getController(i)->rightStickDeadzoneType )
 				{
-					players[i]->hotbar.useHotbarFaceMenu = !players[i]->hotbar.useHotbarFaceMenu;
-					messagePlayer(i, "Face button hotbar: %d", players[i]->hotbar.useHotbarFaceMenu ? 1 : 0);
+					case GameController::DEADZONE_PER_AXIS:
+						inputs.getController(i)->rightStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_LINEAR;
+						messagePlayer(i, "Using radial deadzone on right stick.");
+						break;
+					case GameController::DEADZONE_MAGNITUDE_LINEAR:
+						inputs.getController(i)->rightStickDeadzoneType = GameController::DEADZONE_MAGNITUDE_HALFPIPE;
+						messagePlayer(i, "Using curved radial deadzone on right stick.");
+						break;
+					case GameController::DEADZONE_MAGNITUDE_HALFPIPE:
+						inputs.getController(i)->rightStickDeadzoneType = GameController::DEADZONE_PER_AXIS;
+						messagePlayer(i, "Using per-axis deadzone on right stick.");
+						break;
 				}
 			}
 		}
-		else if ( !strncmp(command_str, "/facebarinvert", 14) )
+	});
+	addPrefix("/vibration", 10, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.hasController(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
+				inputs.getController(i)->haptics.vibrationEnabled = !inputs.getController(i)->haptics.vibrationEnabled;
+				if ( inputs.getController(i)->haptics.vibrationEnabled )
 				{
-					players[i]->hotbar.faceMenuInvertLayout = !players[i]->hotbar.faceMenuInvertLayout;
-					messagePlayer(i, "Face button invert position: %d", players[i]->hotbar.faceMenuInvertLayout ? 1 : 0);
+					messagePlayer(i, "Controller vibration is enabled.");
 				}
-			}
-		}
-		else if ( !strncmp(command_str, "/facebarquickcast", 17) )
-		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
-			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
+				else
 				{
-					players[i]->hotbar.faceMenuQuickCastEnabled = !players[i]->hotbar.faceMenuQuickCastEnabled;
-					messagePlayer(i, "Face button quickcast: %d", players[i]->hotbar.faceMenuQuickCastEnabled ? 1 : 0);
+					messagePlayer(i, "Controller vibration is disabled.");
 				}
 			}
 		}
-		else if ( !strncmp(command_str, "/paperdoll", 10) )
+	});
+	addPrefix("/tooltipoffset ", 15, [](const char* command_str)
+	{
+		int offset = atoi((char*)(command_str + 15));
+		Player::WorldUI_t::tooltipHeightOffsetZ = static_cast<real_t>(offset) / 10.0;
+		messagePlayer(clientnum, "Tooltip Z offset set to: %.1f", Player::WorldUI_t::tooltipHeightOffsetZ);
+	});
+	addPrefix("/radialhotbar", 13, [](const char* command_str)
+	{
+		players[clientnum]->hotbar.useHotbarRadialMenu = !players[clientnum]->hotbar.useHotbarRadialMenu;
+	});
+	addPrefix("/radialhotslots ", 16, [](const char* command_str)
+	{
+		int slots = atoi((char*)(command_str + 16));
+		players[clientnum]->hotbar.radialHotbarSlots = slots;
+		messagePlayer(clientnum, "Slots in use: %d", slots);
+	});
+	addPrefix("/facehotbar", 11, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
-				{
-					players[i]->paperDoll.enabled = !players[i]->paperDoll.enabled;
-					messagePlayer(i, "Paper doll: %d", players[i]->paperDoll.enabled ? 1 : 0);
-				}
+				players[i]->hotbar.useHotbarFaceMenu = !players[i]->hotbar.useHotbarFaceMenu;
+				messagePlayer(i, "Face button hotbar: %d", players[i]->hotbar.useHotbarFaceMenu ? 1 : 0);
 			}
 		}
-		else if ( !strncmp(command_str, "/facebaralternate", 17) )
+	});
+	addPrefix("/facebarinvert", 14, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
-				{
-					players[i]->hotbar.faceMenuAlternateLayout = !players[i]->hotbar.faceMenuAlternateLayout;
-					messagePlayer(i, "Face button alternate: %d", players[i]->hotbar.faceMenuAlternateLayout ? 1 : 0);
-				}
+				players[i]->hotbar.faceMenuInvertLayout = !players[i]->hotbar.faceMenuInvertLayout;
+				messagePlayer(i, "Face button invert position: %d", players[i]->hotbar.faceMenuInvertLayout ? 1 : 0);
 			}
 		}
-		else if ( !strncmp(command_str, "/inventorynew", 13) )
+	});
+	addPrefix("/facebarquickcast", 17, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
-				{
-					players[i]->inventoryUI.bNewInventoryLayout = !players[i]->inventoryUI.bNewInventoryLayout;
-					players[i]->inventoryUI.resetInventory();
-					messagePlayer(i, "New Inventory layout: %d", players[i]->inventoryUI.bNewInventoryLayout ? 1 : 0);
-				}
+				players[i]->hotbar.faceMenuQuickCastEnabled = !players[i]->hotbar.faceMenuQuickCastEnabled;
+				messagePlayer(i, "Face button quickcast: %d", players[i]->hotbar.faceMenuQuickCastEnabled ? 1 : 0);
 			}
 		}
-		else if ( !strncmp(command_str, "/worldui", 8) )
+	});
+	addPrefix("/paperdoll", 10, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				if ( inputs.bPlayerUsingKeyboardControl(i) )
-				{
-					if ( players[i]->worldUI.isEnabled() )
-					{
-						players[i]->worldUI.disable();
-					}
-					else
-					{
-						players[i]->worldUI.enable();
-					}
-				}
+				players[i]->paperDoll.enabled = !players[i]->paperDoll.enabled;
+				messagePlayer(i, "Paper doll: %d", players[i]->paperDoll.enabled ? 1 : 0);
 			}
 		}
-		else if ( !strncmp(command_str, "/ircconnect", 11) )
+	});
+	addPrefix("/facebaralternate", 17, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			if ( IRCHandler.connect() )
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				messagePlayer(clientnum, "[IRC]: Connected.");
+				players[i]->hotbar.faceMenuAlternateLayout = !players[i]->hotbar.faceMenuAlternateLayout;
+				messagePlayer(i, "Face button alternate: %d", players[i]->hotbar.faceMenuAlternateLayout ? 1 : 0);
 			}
-			else
+		}
+	});
+	addPrefix("/inventorynew", 13, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
+		{
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
 			{
-				IRCHandler.disconnect();
-				messagePlayer(clientnum, "[IRC]: Error connecting.");
+				players[i]->inventoryUI.bNewInventoryLayout = !players[i]->inventoryUI.bNewInventoryLayout;
+				players[i]->inventoryUI.resetInventory();
+				messagePlayer(i, "New Inventory layout: %d", players[i]->inventoryUI.bNewInventoryLayout ? 1 : 0);
 			}
 		}
-		else if ( !strncmp(command_str, "/ircdisconnect", 14) )
+	});
+	addPrefix("/worldui", 8, [](const char* command_str)
+	{
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			IRCHandler.disconnect();
-			messagePlayer(clientnum, "[IRC]: Disconnected.");
+			if ( inputs.bPlayerUsingKeyboardControl(i) )
+			{
+				if ( players[i]->worldUI.isEnabled() )
+				{
+					players[i]->worldUI.disable();
+				}
+				else
+				{
+					players[i]->worldUI.enable();
+				}
+			}
 		}
-		else if ( !strncmp(command_str, "/irc ", 5) )
+	});
+	addPrefix("/ircconnect", 11, [](const char* command_str)
+	{
+		if ( IRCHandler.connect() )
 		{
-			std::string message = command_str + 5;
-			message.append("\r\n");
-			IRCHandler.packetSend(message);
-			messagePlayer(clientnum, "[IRC]: Sent message.");
+			messagePlayer(clientnum, "[IRC]: Connected.");
 		}
 		else
 		{
-			messagePlayer(clientnum, language[305], command_str);
+			IRCHandler.disconnect();
+			messagePlayer(clientnum, "[IRC]: Error connecting.");
 		}
+	});
+	addPrefix("/ircdisconnect", 14, [](const char* command_str)
+	{
+		IRCHandler.disconnect();
+		messagePlayer(clientnum, "[IRC]: Disconnected.");
+	});
+	addPrefix("/irc ", 5, [](const char* command_str)
+	{
+		std::string message = command_str + 5;
+		message.append("\r\n");
+		IRCHandler.packetSend(message);
+		messagePlayer(clientnum, "[IRC]: Sent message.");
+	});
+}
+
+/*-------------------------------------------------------------------------------
+
+	consoleCommand
+
+	Takes a string and executes it as a game command
+
+-------------------------------------------------------------------------------*/
+
+void consoleCommand(char const * const command_str)
+{
+	if ( !command_str )
+	{
+		return;
+	}
+	if ( !ConsoleCommands.run(command_str) )
+	{
+		messagePlayer(clientnum, language[305], command_str);
 	}
 }
@@ -21,6 +21,7 @@
 #include "../player.hpp"
 #include "interface.hpp"
 #include "../colors.hpp"
+#include "../hud_cache.hpp"
 
 //char enemy_name[128];
 //Sint32 enemy_hp = 0, enemy_maxhp = 0, enemy_oldhp = 0;
@@ -373,8 +374,28 @@ void warpMouseToSelectedHotbarSlot(const int player)
 	inputs.warpMouse(player, pos.x, pos.y, flags);
 }
 
+// widgets of the status bar that only change with the values they show, see hud_cache.hpp
+static HudCacheHandler::Widget_t chatlogWidget[MAXPLAYERS];
+static HudCacheHandler::Widget_t healthBarWidget[MAXPLAYERS];
+static HudCacheHandler::Widget_t magicBarWidget[MAXPLAYERS];
+static Uint32 chatlogWraps = 0; // bumped when a message is wrapped, which moves the lines above it
+
+// whether the regen effect outline is showing, it blinks as it runs out
+static bool regenOutlineVisible(int player, int effect)
+{
+	if ( !stats[player] || stats[player]->HP <= 0 || !stats[player]->EFFECTS[effect] )
+	{
+		return false;
+	}
+	bool lowDurationFlash = !((ticks % 50) - (ticks % 25));
+	bool lowDuration = stats[player]->EFFECTS_TIMERS[effect] > 0 &&
+		(stats[player]->EFFECTS_TIMERS[effect] < TICKS_PER_SECOND * 5);
+	return (lowDuration && !lowDurationFlash) || !lowDuration;
+}
+
 void drawStatus(int player)
 {
+	HudPanelTimer panelTimer(player, HudCacheHandler::PANEL_STATUS);
 	SDL_Rect pos, initial_position;
 	Sint32 x, y, z, c, i;
 	node_t* node;
@@ -433,74 +454,82 @@ void drawStatus(int player)
 		x = players[player]->statusBarUI.getStartX() + 24 * uiscale_chatlog;
 		y = players[player]->camera_y2();
 		textscroll = std::max(std::min<Uint32>(list_Size(&messages) - 3, textscroll), 0u);
-		c = 0;
-		for ( node = messages.last; node != NULL; node = node->prev )
+		HudCacheHandler::Key chatlogKey;
+		chatlogKey.add(messages.version).add(list_Size(&messages)).add(textscroll).add(chatlogWraps)
+			.add(x).add(y).add(xres).add(yres).addFloat(uiscale_chatlog);
+		if ( !HudCache.begin(chatlogWidget[player], chatlogKey) )
 		{
-			c++;
-			if ( c <= textscroll )
-			{
-				continue;
-			}
-			string = (string_t*)node->element;
-			if ( uiscale_chatlog >= 1.5 )
+			c = 0;
+			for ( node = messages.last; node != NULL; node = node->prev )
 			{
-				y -= TTF16_HEIGHT * string->lines;
-				if ( y < y2 - (status_bmp->h * uiscale_chatlog) + 8 * uiscale_chatlog )
+				c++;
+				if ( c <= textscroll )
 				{
-					break;
+					continue;
 				}
-			}
-			else if ( uiscale_chatlog != 1.f )
-			{
-				y -= TTF12_HEIGHT * string->lines;
-				if ( y < y2 - status_bmp->h * 1.1 + 4 )
-				{
-					break;
-				}
-			}
-			else
-			{
-				y -= TTF12_HEIGHT * string->lines;
-				if ( y < y2 - status_bmp->h + 4 )
+				string = (string_t*)node->element;
+				if ( uiscale_chatlog >= 1.5 )
 				{
-					break;
+					y -= TTF16_HEIGHT * string->lines;
+					if ( y < y2 - (status_bmp->h * uiscale_chatlog) + 8 * uiscale_chatlog )
+					{
+						break;
+					}
 				}
-			}
-			z = 0;
-			for ( i = 0; i < strlen(string->data); i++ )
-			{
-				if ( string->data[i] != 10 )   // newline
+				else if ( uiscale_chatlog != 1.f )
 				{
-					z++;
+					y -= TTF12_HEIGHT * string->lines;
+					if ( y < y2 - status_bmp->h * 1.1 + 4 )
+					{
+						break;
+					}
 				}
 				else
 				{
-					z = 0;
+					y -= TTF12_HEIGHT * string->lines;
+					if ( y < y2 - status_bmp->h + 4 )
+					{
+						break;
+					}
 				}
-				if ( z == 65 )
+				z = 0;
+				for ( i = 0; i < strlen(string->data); i++ )
 				{
-					if ( string->data[i] != 10 )
+					if ( string->data[i] != 10 )   // newline
+					{
+						z++;
+					}
+					else
 					{
-						char* tempString = (char*)malloc(sizeof(char) * (strlen(string->data) + 2));
-						strcpy(tempString, string->data);
-						strcpy((char*)(tempString + i + 1), (char*)(string->data + i));
-						tempString[i] = 10;
-						free(string->data);
-						string->data = tempString;
-						string->lines++;
+						z = 0;
+					}
+					if ( z == 65 )
+					{
+						if ( string->data[i] != 10 )
+						{
+							char* tempString = (char*)malloc(sizeof(char) * (strlen(string->data) + 2));
+							strcpy(tempString, string->data);
+							strcpy((char*)(tempString + i + 1), (char*)(string->data + i));
+							tempString[i] = 10;
+							free(string->data);
+							string->data = tempString;
+							string->lines++;
+							++chatlogWraps;
+						}
+						z = 0;
 					}
-					z = 0;
+				}
+				Uint32 color = SDL_MapRGBA(mainsurface->format, 0, 0, 0, 255); // black color
+				if ( uiscale_chatlog >= 1.5 )
+				{
+					ttfPrintTextColor(ttf16, x, y, color, false, string->data);
+				}
+				else
+				{
+					ttfPrintTextColor(ttf12, x, y, color, false, string->data);
 				}
 			}
-			Uint32 color = SDL_MapRGBA(mainsurface->format, 0, 0, 0, 255); // black color
-			if ( uiscale_chatlog >= 1.5 )
-			{
-				ttfPrintTextColor(ttf16, x, y, color, false, string->data);
-			}
-			else
-			{
-				ttfPrintTextColor(ttf12, x, y, color, false, string->data);
-			}
+			HudCache.end(chatlogWidget[player]);
 		}
 		if ( inputs.bMouseLeft(player) )
 		{
@@ -623,20 +652,24 @@ void drawStatus(int player)
 	int playerStatusBarWidth = 38 * uiscale_playerbars;
 	int playerStatusBarHeight = 156 * uiscale_playerbars;
 
-	// PLAYER HEALTH BAR
-	// Display Health bar border
-	pos.x = x1 + 38 + 38 * uiscale_playerbars;
-	pos.w = playerStatusBarWidth;
-	pos.h = playerStatusBarHeight;
-	pos.y = y2 - (playerStatusBarHeight + 12);
-	drawTooltip(&pos);
-	if ( stats[player] && stats[player]->HP > 0
-		&& stats[player]->EFFECTS[EFF_HP_REGEN] )
+	const bool hpRegenOutline = regenOutlineVisible(player, EFF_HP_REGEN);
+	HudCacheHandler::Key healthBarKey;
+	healthBarKey.add(stats[player] != nullptr).add(x1).add(y2).add(xres).add(yres)
+		.addFloat(uiscale_playerbars).add(colorblind).add(hpRegenOutline).add(language[306]);
+	if ( stats[player] )
 	{
-		bool lowDurationFlash = !((ticks % 50) - (ticks % 25));
-		bool lowDuration = stats[player]->EFFECTS_TIMERS[EFF_HP_REGEN] > 0 &&
-			(stats[player]->EFFECTS_TIMERS[EFF_HP_REGEN] < TICKS_PER_SECOND * 5);
-		if ( (lowDuration && !lowDurationFlash) || !lowDuration )
+		healthBarKey.add(stats[player]->HP).add(stats[player]->MAXHP).add(stats[player]->EFFECTS[EFF_POISONED]);
+	}
+	if ( !HudCache.begin(healthBarWidget[player], healthBarKey) )
+	{
+		// PLAYER HEALTH BAR
+		// Display Health bar border
+		pos.x = x1 + 38 + 38 * uiscale_playerbars;
+		pos.w = playerStatusBarWidth;
+		pos.h = playerStatusBarHeight;
+		pos.y = y2 - (playerStatusBarHeight + 12);
+		drawTooltip(&pos);
+		if ( hpRegenOutline )
 		{
 			if ( colorblind )
 			{
@@ -647,24 +680,17 @@ void drawStatus(int player)
 				drawTooltip(&pos, SDL_MapRGB(mainsurface->format, 0, 255, 0)); // green
 			}
 		}
-	}
 
-	// Display "HP" at top of Health bar
-	ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[306]);
-
-	// Display border between actual Health bar and "HP"
-	//pos.x = 76;
-	pos.w = playerStatusBarWidth;
-	pos.h = 0;
-	pos.y = y2 - (playerStatusBarHeight - 9);
-	drawTooltip(&pos);
-	if ( stats[player] && stats[player]->HP > 0
-		&& stats[player]->EFFECTS[EFF_HP_REGEN] )
-	{
-		bool lowDurationFlash = !((ticks % 50) - (ticks % 25));
-		bool lowDuration = stats[player]->EFFECTS_TIMERS[EFF_HP_REGEN] > 0 &&
-			(stats[player]->EFFECTS_TIMERS[EFF_HP_REGEN] < TICKS_PER_SECOND * 5);
-		if ( (lowDuration && !lowDurationFlash) || !lowDuration )
+		// Display "HP" at top of Health bar
+		ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[306]);
+
+		// Display border between actual Health bar and "HP"
+		//pos.x = 76;
+		pos.w = playerStatusBarWidth;
+		pos.h = 0;
+		pos.y = y2 - (playerStatusBarHeight - 9);
+		drawTooltip(&pos);
+		if ( hpRegenOutline )
 		{
 			if ( colorblind )
 			{
@@ -675,78 +701,84 @@ void drawStatus(int player)
 				drawTooltip(&pos, SDL_MapRGB(mainsurface->format, 0, 255, 0)); // green
 			}
 		}
-	}
 
-	// Display the actual Health bar's faint background
-	pos.x = x1 + 42 + 38 * uiscale_playerbars;
-	pos.w = playerStatusBarWidth - 5;
-	pos.h = playerStatusBarHeight - 27;
-	pos.y = y2 - 15 - pos.h;
+		// Display the actual Health bar's faint background
+		pos.x = x1 + 42 + 38 * uiscale_playerbars;
+		pos.w = playerStatusBarWidth - 5;
+		pos.h = playerStatusBarHeight - 27;
+		pos.y = y2 - 15 - pos.h;
 
-	// Change the color depending on if you are poisoned
-	Uint32 color = 0;
-	if ( stats[player] && stats[player]->EFFECTS[EFF_POISONED] )
-	{
-		if ( colorblind )
+		// Change the color depending on if you are poisoned
+		Uint32 color = 0;
+		if ( stats[player] && stats[player]->EFFECTS[EFF_POISONED] )
 		{
-			color = SDL_MapRGB(mainsurface->format, 0, 0, 48); // Display blue
+			if ( colorblind )
+			{
+				color = SDL_MapRGB(mainsurface->format, 0, 0, 48); // Display blue
+			}
+			else
+			{
+				color = SDL_MapRGB(mainsurface->format, 0, 48, 0); // Display green
+			}
 		}
 		else
 		{
-			color = SDL_MapRGB(mainsurface->format, 0, 48, 0); // Display green
+			color = SDL_MapRGB(mainsurface->format, 48, 0, 0); // Display red
 		}
-	}
-	else
-	{
-		color = SDL_MapRGB(mainsurface->format, 48, 0, 0); // Display red
-	}
-
-	// Draw the actual Health bar's faint background with specified color
-	drawRect(&pos, color, 255);
 
-	// If the Player is alive, base the size of the actual Health bar off remaining HP
-	if ( stats[player] && stats[player]->HP > 0 )
-	{
-		//pos.x = 80;
-		pos.w = playerStatusBarWidth - 5;
-		pos.h = (playerStatusBarHeight - 27) * (static_cast<double>(stats[player]->HP) / stats[player]->MAXHP);
-		pos.y = y2 - 15 - pos.h;
+		// Draw the actual Health bar's faint background with specified color
+		drawRect(&pos, color, 255);
 
-		if ( stats[player]->EFFECTS[EFF_POISONED] )
+		// If the Player is alive, base the size of the actual Health bar off remaining HP
+		if ( stats[player] && stats[player]->HP > 0 )
 		{
-			if ( !colorblind )
+			//pos.x = 80;
+			pos.w = playerStatusBarWidth - 5;
+			pos.h = (playerStatusBarHeight - 27) * (static_cast<double>(stats[player]->HP) / stats[player]->MAXHP);
+			pos.y = y2 - 15 - pos.h;
+
+			if ( stats[player]->EFFECTS[EFF_POISONED] )
 			{
-				color = SDL_MapRGB(mainsurface->format, 0, 128, 0);
+				if ( !colorblind )
+				{
+					color = SDL_MapRGB(mainsurface->format, 0, 128, 0);
+				}
+				else
+				{
+					color = SDL_MapRGB(mainsurface->format, 0, 0, 128);
+				}
 			}
 			else
 			{
-				color = SDL_MapRGB(mainsurface->format, 0, 0, 128);
+				color = SDL_MapRGB(mainsurface->format, 128, 0, 0);
 			}
+
+			// Only draw the actual Health bar if the Player is alive
+			drawRect(&pos, color, 255);
+		}
+
+		// Print out the amount of HP the Player currently has
+		if ( stats[player] )
+		{
+			snprintf(tempstr, 4, "%d", stats[player]->HP);
 		}
 		else
 		{
-			color = SDL_MapRGB(mainsurface->format, 128, 0, 0);
+			snprintf(tempstr, 4, "%d", 0);
 		}
-
-		// Only draw the actual Health bar if the Player is alive
-		drawRect(&pos, color, 255);
+		if ( uiscale_playerbars >= 1.5 )
+		{
+			pos.x += uiscale_playerbars * 2;
+		}
+		printTextFormatted(font12x12_bmp, pos.x + 16 * uiscale_playerbars - strlen(tempstr) * 6, y2 - (playerStatusBarHeight / 2 + 8), tempstr);
+		HudCache.end(healthBarWidget[player]);
 	}
 
-	// Print out the amount of HP the Player currently has
-	if ( stats[player] )
-	{
-		snprintf(tempstr, 4, "%d", stats[player]->HP);
-	}
-	else
-	{
-		snprintf(tempstr, 4, "%d", 0);
-	}
+	int xoffset = x1 + 42 + 38 * uiscale_playerbars; // where the health bar ends up
 	if ( uiscale_playerbars >= 1.5 )
 	{
-		pos.x += uiscale_playerbars * 2;
+		xoffset += uiscale_playerbars * 2;
 	}
-	printTextFormatted(font12x12_bmp, pos.x + 16 * uiscale_playerbars - strlen(tempstr) * 6, y2 - (playerStatusBarHeight / 2 + 8), tempstr);
-	int xoffset = pos.x;
 
 	// hunger icon
 	if ( stats[player] && stats[player]->type != AUTOMATON
@@ -805,20 +837,25 @@ void drawStatus(int player)
 	}
 
 
-	// PLAYER MAGIC BAR
-	// Display the Magic bar border
-	pos.x = x1 + 12 * uiscale_playerbars;
-	pos.w = playerStatusBarWidth;
-	pos.h = playerStatusBarHeight;
-	pos.y = y2 - (playerStatusBarHeight + 12);
-	drawTooltip(&pos);
-	if ( stats[player] && stats[player]->HP > 0
-		&& stats[player]->EFFECTS[EFF_MP_REGEN] )
+	const bool mpRegenOutline = regenOutlineVisible(player, EFF_MP_REGEN);
+	HudCacheHandler::Key magicBarKey;
+	magicBarKey.add(stats[player] != nullptr).add(x1).add(y2).add(xres).add(yres)
+		.addFloat(uiscale_playerbars).add(colorblind).add(mpRegenOutline).add(language[307]);
+	if ( stats[player] )
+	{
+		magicBarKey.add(stats[player]->MP).add(stats[player]->MAXMP).add(stats[player]->type)
+			.add(stats[player]->playerRace).add(stats[player]->appearance);
+	}
+	if ( !HudCache.begin(magicBarWidget[player], magicBarKey) )
 	{
-		bool lowDurationFlash = !((ticks % 50) - (ticks % 25));
-		bool lowDuration = stats[player]->EFFECTS_TIMERS[EFF_MP_REGEN] > 0 &&
-			(stats[player]->EFFECTS_TIMERS[EFF_MP_REGEN] < TICKS_PER_SECOND * 5);
-		if ( (lowDuration && !lowDurationFlash) || !lowDuration )
+		// PLAYER MAGIC BAR
+		// Display the Magic bar border
+		pos.x = x1 + 12 * uiscale_playerbars;
+		pos.w = playerStatusBarWidth;
+		pos.h = playerStatusBarHeight;
+		pos.y = y2 - (playerStatusBarHeight + 12);
+		drawTooltip(&pos);
+		if ( mpRegenOutline )
 		{
 			if ( colorblind )
 			{
@@ -829,40 +866,33 @@ void drawStatus(int player)
 				drawTooltip(&pos, SDL_MapRGB(mainsurface->format, 0, 255, 0)); // green
 			}
 		}
-	}
-	Uint32 mpColorBG = SDL_MapRGB(mainsurface->format, 0, 0, 48);
-	Uint32 mpColorFG = SDL_MapRGB(mainsurface->format, 0, 24, 128);
-	if ( stats[player] && stats[player]->playerRace == RACE_INSECTOID && stats[player]->appearance == 0 )
-	{
-		ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[3768]);
-		mpColorBG = SDL_MapRGB(mainsurface->format, 32, 48, 0);
-		mpColorFG = SDL_MapRGB(mainsurface->format, 92, 192, 0);
-	}
-	else if ( stats[player] && stats[player]->type == AUTOMATON )
-	{
-		ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[3474]);
-		mpColorBG = SDL_MapRGB(mainsurface->format, 64, 32, 0);
-		mpColorFG = SDL_MapRGB(mainsurface->format, 192, 92, 0);
-	}
-	else
-	{
-		// Display "MP" at the top of Magic bar
-		ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[307]);
-	}
+		Uint32 mpColorBG = SDL_MapRGB(mainsurface->format, 0, 0, 48);
+		Uint32 mpColorFG = SDL_MapRGB(mainsurface->format, 0, 24, 128);
+		if ( stats[player] && stats[player]->playerRace == RACE_INSECTOID && stats[player]->appearance == 0 )
+		{
+			ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[3768]);
+			mpColorBG = SDL_MapRGB(mainsurface->format, 32, 48, 0);
+			mpColorFG = SDL_MapRGB(mainsurface->format, 92, 192, 0);
+		}
+		else if ( stats[player] && stats[player]->type == AUTOMATON )
+		{
+			ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[3474]);
+			mpColorBG = SDL_MapRGB(mainsurface->format, 64, 32, 0);
+			mpColorFG = SDL_MapRGB(mainsurface->format, 192, 92, 0);
+		}
+		else
+		{
+			// Display "MP" at the top of Magic bar
+			ttfPrintText(ttf12, pos.x + (playerStatusBarWidth / 2 - 10), pos.y + 6, language[307]);
+		}
 
-	// Display border between actual Magic bar and "MP"
-	//pos.x = 12;
-	pos.w = playerStatusBarWidth;
-	pos.h = 0;
-	pos.y = y2 - (playerStatusBarHeight - 9);
-	drawTooltip(&pos);
-	if ( stats[player] && stats[player]->HP > 0
-		&& stats[player]->EFFECTS[EFF_MP_REGEN] )
-	{
-		bool lowDurationFlash = !((ticks % 50) - (ticks % 25));
-		bool lowDuration = stats[player]->EFFECTS_TIMERS[EFF_MP_REGEN] > 0 &&
-			(stats[player]->EFFECTS_TIMERS[EFF_MP_REGEN] < TICKS_PER_SECOND * 5);
-		if ( (lowDuration && !lowDurationFlash) || !lowDuration )
+		// Display border between actual Magic bar and "MP"
+		//pos.x = 12;
+		pos.w = playerStatusBarWidth;
+		pos.h = 0;
+		pos.y = y2 - (playerStatusBarHeight - 9);
+		drawTooltip(&pos);
+		if ( mpRegenOutline )
 		{
 			if ( colorblind )
 			{
@@ -873,39 +903,40 @@ void drawStatus(int player)
 				drawTooltip(&pos, SDL_MapRGB(mainsurface->format, 0, 255, 0)); // green
 			}
 		}
-	}
-
-	// Display the actual Magic bar's faint background
-	pos.x = x1 + 4 + 12 * uiscale_playerbars;
-	pos.w = playerStatusBarWidth - 5;
-	pos.h = playerStatusBarHeight - 27;
-	pos.y = y2 - 15 - pos.h;
-
-	// Draw the actual Magic bar's faint background
-	drawRect(&pos, mpColorBG, 255); // Display blue
 
-	// If the Player has MP, base the size of the actual Magic bar off remaining MP
-	if ( stats[player] && stats[player]->MP > 0 )
-	{
-		//pos.x = 16;
+		// Display the actual Magic bar's faint background
+		pos.x = x1 + 4 + 12 * uiscale_playerbars;
 		pos.w = playerStatusBarWidth - 5;
-		pos.h = (playerStatusBarHeight - 27) * (static_cast<double>(stats[player]->MP) / stats[player]->MAXMP);
+		pos.h = playerStatusBarHeight - 27;
 		pos.y = y2 - 15 - pos.h;
 
-		// Only draw the actual Magic bar if the Player has MP
-		drawRect(&pos, mpColorFG, 255); // Display blue
-	}
+		// Draw the actual Magic bar's faint background
+		drawRect(&pos, mpColorBG, 255); // Display blue
 
-	// Print out the amount of MP the Player currently has
-	if ( stats[player] )
-	{
-		snprintf(tempstr, 4, "%d", stats[player]->MP);
-	}
-	else
-	{
-		snprintf(tempstr, 4, "%d", 0);
+		// If the Player has MP, base the size of the actual Magic bar off remaining MP
+		if ( stats[player] && stats[player]->MP > 0 )
+		{
+			//pos.x = 16;
+			pos.w = playerStatusBarWidth - 5;
+			pos.h = (playerStatusBarHeight - 27) * (static_cast<double>(stats[player]->MP) / stats[player]->MAXMP);
+			pos.y = y2 - 15 - pos.h;
+
+			// Only draw the actual Magic bar if the Player has MP
+			drawRect(&pos, mpColorFG, 255); // Display blue
+		}
+
+		// Print out the amount of MP the Player currently has
+		if ( stats[player] )
+		{
+			snprintf(tempstr, 4, "%d", stats[player]->MP);
+		}
+		else
+		{
+			snprintf(tempstr, 4, "%d", 0);
+		}
+		printTextFormatted(font12x12_bmp, x1 + 32 * uiscale_playerbars - strlen(tempstr) * 6, y2 - (playerStatusBarHeight / 2 + 8), tempstr);
+		HudCache.end(magicBarWidget[player]);
 	}
-	printTextFormatted(font12x12_bmp, x1 + 32 * uiscale_playerbars - strlen(tempstr) * 6, y2 - (playerStatusBarHeight / 2 + 8), tempstr);
 
 	// draw action prompts.
 	if ( players[player]->hud.bShowActionPrompts )
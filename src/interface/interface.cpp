@@ -9,6 +9,7 @@
 
 -------------------------------------------------------------------------------*/
 
+#include <sys/stat.h>
 #include "../main.hpp"
 #include "../files.hpp"
 #include "../game.hpp"
@@ -30,6 +31,8 @@
 #include "../scores.hpp"
 #include "../scrolls.hpp"
 #include "../lobbies.hpp"
+#include "../init.hpp"
+#include "../json.hpp"
 
 Uint32 svFlags = 30;
 Uint32 settings_svFlags = svFlags;
@@ -867,7 +870,7 @@ void defaultConfig()
 	return;
 }
 
-static char impulsenames[NUMIMPULSES][23] =
+char impulsenames[NUMIMPULSES][23] =
 {
 	"FORWARD",
 	"LEFT",
@@ -896,7 +899,7 @@ static char impulsenames[NUMIMPULSES][23] =
 	"HOTBAR_SCROLL_SELECT"
 };
 
-static char joyimpulsenames[NUM_JOY_IMPULSES][30] =
+char joyimpulsenames[NUM_JOY_IMPULSES][30] =
 {
 	//Bi-functional:
 	"STATUS",
@@ -956,6 +959,288 @@ void saveCommand(char* content)
 	newString(&command_history, 0xFFFFFFFF, content);
 }
 
+/*-------------------------------------------------------------------------------
+
+	ConfigSettings_t
+
+	the settings saveConfig() writes to the .cfg as console commands, kept
+	as one json object in a .json beside it. loadConfig() reads the .json
+	in a single pass instead of running every line of the .cfg through
+	consoleCommand(), unless the .cfg has been edited since.
+
+-------------------------------------------------------------------------------*/
+
+// for the settings that are ints but only ever on or off
+static void configFlag(FileInterface* file, const char* name, int& v)
+{
+	bool on = (v != 0);
+	file->property(name, on);
+	v = on ? 1 : 0;
+}
+
+template<int Count, int NameLength>
+struct ConfigBinds_t
+{
+	Uint32 (&values)[Count];
+	char (&names)[Count][NameLength];
+
+	void serialize(FileInterface* file)
+	{
+		for ( int c = 0; c < Count; ++c )
+		{
+			file->property(names[c], values[c]);
+		}
+	}
+};
+
+template<typename T, int Size>
+static void configArray(FileInterface* file, const char* name, T (&v)[Size])
+{
+	// fixed size arrays must match exactly when read, these may gain categories between versions
+	std::vector<Sint32> values(v, v + Size);
+	file->property(name, values);
+	for ( int c = 0; c < Size && c < static_cast<int>(values.size()); ++c )
+	{
+		v[c] = static_cast<T>(values[c]);
+	}
+}
+
+struct ConfigMod_t
+{
+	std::string dir;
+	std::string name;
+	std::string fileid; // steam workshop id, empty if not from the workshop
+
+	void serialize(FileInterface* file)
+	{
+		file->property("dir", dir);
+		file->property("name", name);
+		file->property("fileid", fileid);
+	}
+};
+
+struct ConfigSettings_t
+{
+	void serialize(FileInterface* file)
+	{
+		const bool reading = file->isReading();
+		int version = 1;
+		file->property("version", version);
+
+		std::string lang = languageCode;
+		file->property("lang", lang);
+		file->property("xres", xres);
+		file->property("yres", yres);
+		file->property("gamma", vidgamma);
+		file->property("fov", fov);
+		file->property("fps", fpsLimit);
+		file->property("svflags", svFlags);
+		file->property("lastname", lastname);
+		file->property("smoothlighting", smoothlighting);
+		configFlag(file, "fullscreen", fullscreen);
+		file->property("borderless", borderless);
+		configFlag(file, "shaking", shaking);
+		configFlag(file, "bobbing", bobbing);
+		file->property("sfxvolume", sfxvolume);
+		file->property("sfxambientvolume", sfxAmbientVolume);
+		file->property("sfxenvironmentvolume", sfxEnvironmentVolume);
+		file->property("musvolume", musvolume);
+
+		ConfigBinds_t<NUMIMPULSES, 23> binds = { impulses, impulsenames };
+		file->property("bind", binds);
+		ConfigBinds_t<NUM_JOY_IMPULSES, 30> joybinds = { joyimpulses, joyimpulsenames };
+		file->property("joybind", joybinds);
+
+		file->property("mousespeed", mousespeed);
+		configFlag(file, "reversemouse", reversemouse);
+		file->property("smoothmouse", smoothmouse);
+		file->property("disablemouserotationlimit", disablemouserotationlimit);
+		std::string ip = last_ip;
+		file->property("ip", ip, static_cast<Uint32>(sizeof(last_ip) - 1));
+		std::string port = last_port;
+		file->property("port", port, static_cast<Uint32>(sizeof(last_port) - 1));
+		file->property("blood", spawn_blood);
+		file->property("lightflicker", flickerLights);
+		file->property("vsync", verticalSync);
+		file->property("statusicons", showStatusEffectIcons);
+		file->property("muteping", minimapPingMute);
+		file->property("muteaudiofocuslost", mute_audio_on_focus_lost);
+		file->property("muteplayermonstersounds", mute_player_monster_sounds);
+		file->property("colorblind", colorblind);
+		file->property("capturemouse", capture_mouse);
+		file->property("broadcast", broadcast);
+		file->property("nohud", nohud);
+		file->property("hotbarnewitems", auto_hotbar_new_items);
+		configArray(file, "hotbarenablecategory", auto_hotbar_categories);
+		configArray(file, "autosortcategory", autosort_inventory_categories);
+		file->property("quickaddtohotbar", hotbar_numkey_quick_add);
+		bool locksidebar = players[clientnum] && players[clientnum]->characterSheet.lock_right_sidebar;
+		file->property("locksidebar", locksidebar);
+		file->property("showgametimer", show_game_timer_always);
+		file->property("disablemessages", disable_messages);
+		file->property("right_click_protect", right_click_protect);
+		file->property("autoappraisenewitems", auto_appraise_new_items);
+		file->property("startfloor", startfloor);
+		file->property("usemodelcache", useModelCache);
+		file->property("lastcharactersex", lastCreatedCharacterSex);
+		file->property("lastcharacterclass", lastCreatedCharacterClass);
+		file->property("lastcharacterappearance", lastCreatedCharacterAppearance);
+		file->property("lastcharacterrace", lastCreatedCharacterRace);
+
+		file->property("gamepad_deadzone", gamepad_deadzone);
+		file->property("gamepad_trigger_deadzone", gamepad_trigger_deadzone);
+		file->property("gamepad_leftx_sensitivity", gamepad_leftx_sensitivity);
+		file->property("gamepad_lefty_sensitivity", gamepad_lefty_sensitivity);
+		file->property("gamepad_rightx_sensitivity", gamepad_rightx_sensitivity);
+		file->property("gamepad_righty_sensitivity", gamepad_righty_sensitivity);
+		file->property("gamepad_menux_sensitivity", gamepad_menux_sensitivity);
+		file->property("gamepad_menuy_sensitivity", gamepad_menuy_sensitivity);
+		file->property("gamepad_leftx_invert", gamepad_leftx_invert);
+		file->property("gamepad_lefty_invert", gamepad_lefty_invert);
+		file->property("gamepad_rightx_invert", gamepad_rightx_invert);
+		file->property("gamepad_righty_invert", gamepad_righty_invert);
+		file->property("gamepad_menux_invert", gamepad_menux_invert);
+		file->property("gamepad_menuy_invert", gamepad_menuy_invert);
+
+		bool skip = true; // the .cfg has always saved /skipintro
+		file->property("skipintro", skip);
+		file->property("minimaptransparencyfg", minimapTransparencyForeground);
+		file->property("minimaptransparencybg", minimapTransparencyBackground);
+		file->property("minimapscale", minimapScale);
+		file->property("minimapobjectzoom", minimapObjectZoom);
+		file->property("uiscale_charsheet", uiscale_charactersheet);
+		file->property("uiscale_skillsheet", uiscale_skillspage);
+		file->property("uiscale_inv", uiscale_inventory);
+		file->property("uiscale_hotbar", uiscale_hotbar);
+		file->property("uiscale_chatbox", uiscale_chatlog);
+		file->property("uiscale_playerbars", uiscale_playerbars);
+		file->property("hideplayertags", hide_playertags);
+		file->property("hidestatusbar", hide_statusbar);
+		file->property("showskillvalues", show_skill_values);
+		file->property("disablenetworkmultithreading", disableMultithreadedSteamNetworking);
+		file->property("disablenetcodefpslimit", disableFPSLimitOnNetworkMessages);
+#ifdef USE_EOS
+		bool crossplay = LobbyHandler.crossplayEnabled;
+		file->property("crossplay", crossplay);
+#endif // USE_EOS
+
+		std::vector<ConfigMod_t> mods;
+		if ( !reading )
+		{
+			for ( auto& mounted : gamemods_mountedFilepaths )
+			{
+				ConfigMod_t mod;
+				mod.dir = mounted.first;
+				mod.name = mounted.second;
+#ifdef STEAMWORKS
+				for ( auto& loaded : gamemods_workshopLoadedFileIDMap )
+				{
+					if ( loaded.first.compare(mounted.second) == 0 )
+					{
+						mod.fileid = std::to_string(loaded.second);
+					}
+				}
+#endif // STEAMWORKS
+				mods.push_back(mod);
+			}
+		}
+		file->property("mods", mods);
+
+		if ( !reading )
+		{
+			return;
+		}
+
+		// the same limits the console commands put on these
+		fov = std::min(std::max<Uint32>(40, fov), 100u);
+		fpsLimit = std::min(std::max<Uint32>(30, fpsLimit), 144u);
+		startfloor = std::max(startfloor, 0);
+		gamepad_deadzone = std::max(gamepad_deadzone, 0);
+		gamepad_trigger_deadzone = std::max(gamepad_trigger_deadzone, 0);
+		gamepad_leftx_sensitivity = std::max(gamepad_leftx_sensitivity, 1);
+		gamepad_lefty_sensitivity = std::max(gamepad_lefty_sensitivity, 1);
+		gamepad_rightx_sensitivity = std::max(gamepad_rightx_sensitivity, 1);
+		gamepad_righty_sensitivity = std::max(gamepad_righty_sensitivity, 1);
+		gamepad_menux_sensitivity = std::max(gamepad_menux_sensitivity, 1);
+		gamepad_menuy_sensitivity = std::max(gamepad_menuy_sensitivity, 1);
+		minimapTransparencyForeground = std::min(std::max<int>(0, minimapTransparencyForeground), 100);
+		minimapTransparencyBackground = std::min(std::max<int>(0, minimapTransparencyBackground), 100);
+		minimapScale = std::min(std::max<int>(2, minimapScale), 16);
+		minimapObjectZoom = std::min(std::max<int>(0, minimapObjectZoom), 4);
+
+		loadLanguage(lang.substr(0, 2).c_str());
+		strcpy(last_ip, ip.c_str());
+		strcpy(last_port, port.c_str());
+		skipintro = skip;
+		if ( players[clientnum] ) // warning - this doesn't exist when loadConfig() is called on init.
+		{
+			players[clientnum]->characterSheet.lock_right_sidebar = locksidebar;
+			if ( locksidebar )
+			{
+				players[clientnum]->characterSheet.proficienciesPage = 1;
+			}
+		}
+#if (defined STEAMWORKS && defined USE_EOS)
+		if ( crossplay )
+		{
+			EOS.CrossplayAccountManager.autologin = true;
+		}
+#endif // USE_EOS
+
+		for ( auto& mod : mods )
+		{
+			if ( mod.fileid.empty() )
+			{
+				printlog("[Mods]: Adding mod \"%s\" in path \"%s\"", mod.dir.c_str(), mod.name.c_str());
+				gamemods_mountedFilepaths.push_back(std::make_pair(mod.dir, mod.name));
+				gamemods_modelsListRequiresReload = true;
+				gamemods_soundListRequiresReload = true;
+			}
+			else
+			{
+#ifdef STEAMWORKS
+				printlog("[Mods]: Adding mod \"%s\" in path \"%s\"", mod.dir.c_str(), mod.name.c_str());
+				gamemods_mountedFilepaths.push_back(std::make_pair(mod.dir, mod.name));
+				gamemods_modelsListRequiresReload = true;
+				gamemods_soundListRequiresReload = true;
+
+				uint64 id = strtoull(mod.fileid.c_str(), nullptr, 10);
+				gamemods_workshopLoadedFileIDMap.push_back(std::make_pair(mod.name, id));
+				printlog("[Mods]: Steam Workshop mod file ID added for previous entry:%lld", id);
+#endif // STEAMWORKS
+			}
+		}
+	}
+};
+
+// the .json that goes with a .cfg
+static std::string configJsonPath(const char* filename)
+{
+	std::string path = filename;
+	const size_t extension = path.rfind(".cfg");
+	if ( extension != std::string::npos )
+	{
+		path.erase(extension);
+	}
+	return path + ".json";
+}
+
+static bool configModifiedTime(const char* path, time_t& modified)
+{
+#ifdef WINDOWS
+	struct _stat fileInfo;
+	if ( _stat(path, &fileInfo) != 0 )
+#else
+	struct stat fileInfo;
+	if ( stat(path, &fileInfo) != 0 )
+#endif
+	{
+		return false;
+	}
+	modified = fileInfo.st_mtime;
+	return true;
+}
+
 /*-------------------------------------------------------------------------------
 
 	loadConfig
@@ -984,24 +1269,47 @@ int loadConfig(char* filename)
 		strcat(filename, ".cfg");
 	}
 
-	// open the config file
-	if ( (fp = FileIO::open(filename, "rb")) == NULL )
+	// saveConfig() writes the .json after the .cfg, so a .cfg newer than it has been edited by hand
+	bool loadedJson = false;
+	std::string jsonPath = configJsonPath(filename);
+	time_t cfgModified = 0;
+	time_t jsonModified = 0;
+	if ( configModifiedTime(jsonPath.c_str(), jsonModified)
+		&& (!configModifiedTime(filename, cfgModified) || jsonModified >= cfgModified) )
 	{
-		printlog("warning: config file '%s' does not exist!\n", filename);
-		defaultConfig(); //Set up the game with the default config.
-		return 0;
+		ConfigSettings_t settings;
+		loadedJson = FileHelper::readObject(jsonPath.c_str(), settings);
+		if ( !loadedJson )
+		{
+			printlog("warning: failed to read config file '%s', falling back to '%s'\n", jsonPath.c_str(), filename);
+		}
 	}
 
-	// read commands from it
-	while ( fp->gets(str, 1024) != NULL )
+	if ( !loadedJson )
 	{
-		if ( str[0] != '#' && str[0] != '\n' && str[0] != '\r' )   // if this line is not white space or a comment
+		// open the config file
+		if ( (fp = FileIO::open(filename, "rb")) == NULL )
 		{
-			// execute command
-			consoleCommand(str);
+			printlog("warning: config file '%s' does not exist!\n", filename);
+			if ( mallocd )
+			{
+				free(filename);
+			}
+			defaultConfig(); //Set up the game with the default config.
+			return 0;
+		}
+
+		// read commands from it
+		while ( fp->gets(str, 1024) != NULL )
+		{
+			if ( str[0] != '#' && str[0] != '\n' && str[0] != '\r' )   // if this line is not white space or a comment
+			{
+				// execute command
+				consoleCommand(str);
+			}
 		}
+		FileIO::close(fp);
 	}
-	FileIO::close(fp);
 	if ( mallocd )
 	{
 		free(filename);
@@ -1336,6 +1644,13 @@ int saveConfig(char const * const _filename)
 	}
 
 	FileIO::close(fp);
+
+	ConfigSettings_t settings;
+	std::string jsonPath = configJsonPath(path);
+	if ( !FileHelper::writeObject(jsonPath.c_str(), EFileFormat::Json, settings) )
+	{
+		printlog("ERROR: failed to save config file '%s'!\n", jsonPath.c_str());
+	}
 	free(filename);
 	return 0;
 }
@@ -4621,6 +4936,7 @@ void GenericGUIMenu::uncurseItem(Item* item)
 	}
 
 	item->beatitude = 0; //0 = uncursed. > 0 = blessed.
+	stats[gui_player]->invalidateDerivedStats();
 	messagePlayer(gui_player, language[348], item->description());
 
 	closeGUI();
@@ -129,6 +129,38 @@ extern int dragoffset_x[MAXPLAYERS];
 extern int dragoffset_y[MAXPLAYERS];
 extern int buttonclick;
 
+// console commands looked up by name with hash tables. consoleCommand() runs everything through this.
+// the settings saveConfig() writes match the whole word, the debug and cheat commands match a prefix.
+class ConsoleCommandRegistry
+{
+public:
+	// for add(), the text after the command's name and a space, without the line ending config files leave on.
+	// for addPrefix(), the whole command, which the handler reads its arguments from
+	typedef void (*Func)(const char* args);
+
+	ConsoleCommandRegistry();
+	void add(const char* name, Func func);
+	// matches any command whose first matchLength characters are the same as name's
+	void addPrefix(const char* name, size_t matchLength, Func func);
+	// runs command_str if it's a registered command, otherwise returns false
+	bool run(const char* command_str) const;
+private:
+	struct PrefixCommand
+	{
+		Func func;
+		size_t order; // the first command added wins when several match
+	};
+	std::unordered_map<std::string, Func> commands;
+	std::unordered_map<std::string, PrefixCommand> prefixCommands; // keyed by the first matchLength characters
+	std::vector<size_t> prefixLengths; // every matchLength in prefixCommands, ascending
+
+	bool runPrefix(const char* command_str) const;
+};
+extern ConsoleCommandRegistry ConsoleCommands;
+
+extern char impulsenames[NUMIMPULSES][23];
+extern char joyimpulsenames[NUM_JOY_IMPULSES][30];
+
 // function prototypes
 void takeScreenshot();
 bool loadInterfaceResources();
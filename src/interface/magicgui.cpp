@@ -211,7 +211,7 @@ void drawSustainedSpells(const int player)
 	{
 		//Alright, so, the list should be right-aligned.
 		//Meaning, it draws alongside the right side of the screen.
-		node_t* node = list_Node(&items[SPELL_ITEM].surfaces, 1); //Use any old sprite icon as a reference to calculate the position.
+		node_t* node = list_NodeIndexed(&items[SPELL_ITEM].surfaces, 1); //Use any old sprite icon as a reference to calculate the position.
 		if (!node)
 		{
 			return;
@@ -255,7 +255,7 @@ void drawSustainedSpells(const int player)
 				if ( players[player]->entity->creatureShadowTaggedThisUid != 0
 					&& uidToEntity(players[player]->entity->creatureShadowTaggedThisUid) )
 				{
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_SHADOW_TAG);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_SHADOW_TAG);
 					Entity* tagged = uidToEntity(players[player]->entity->creatureShadowTaggedThisUid);
 					if ( tagged->behavior == &actMonster )
 					{
@@ -289,36 +289,36 @@ void drawSustainedSpells(const int player)
 			switch ( i )
 			{
 				case EFF_SLOW:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_SLOW);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_SLOW);
 					tooltipText = language[3384];
 					break;
 				case EFF_BLEEDING:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_BLEED);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_BLEED);
 					tooltipText = language[3385];
 					break;
 				case EFF_ASLEEP:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_SLEEP);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_SLEEP);
 					tooltipText = language[3386];
 					break;
 				case EFF_CONFUSED:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_CONFUSE);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_CONFUSE);
 					tooltipText = language[3387];
 					break;
 				case EFF_PACIFY:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_CHARM_MONSTER);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_CHARM_MONSTER);
 					tooltipText = language[3388];
 					break;
 				case EFF_FEAR:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_FEAR);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_FEAR);
 					tooltipText = language[3861];
 					break;
 				case EFF_WEBBED:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_SPRAY_WEB);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_SPRAY_WEB);
 					tooltipText = language[3859];
 					break;
 				case EFF_MAGICAMPLIFY:
 				{
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_AMPLIFY_MAGIC);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_AMPLIFY_MAGIC);
 					node_t* node = channeledSpells[player].first;
 					for ( ; node != nullptr; node = node->next )
 					{
@@ -333,15 +333,15 @@ void drawSustainedSpells(const int player)
 					break;
 				}
 				case EFF_TROLLS_BLOOD:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_TROLLS_BLOOD);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_TROLLS_BLOOD);
 					tooltipText = language[3492];
 					break;
 				case EFF_FLUTTER:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_FLUTTER);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_FLUTTER);
 					tooltipText = language[3766];
 					break;
 				case EFF_FAST:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_SPEED);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_SPEED);
 					tooltipText = language[3493];
 					break;
 				case EFF_SHAPESHIFT:
@@ -350,19 +350,19 @@ void drawSustainedSpells(const int player)
 						switch ( players[player]->entity->effectShapeshift )
 						{
 							case RAT:
-								effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_RAT_FORM);
+								effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_RAT_FORM);
 								tooltipText = language[3854];
 								break;
 							case TROLL:
-								effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_TROLL_FORM);
+								effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_TROLL_FORM);
 								tooltipText = language[3855];
 								break;
 							case SPIDER:
-								effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_SPIDER_FORM);
+								effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_SPIDER_FORM);
 								tooltipText = language[3856];
 								break;
 							case CREATURE_IMP:
-								effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_IMP_FORM);
+								effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_IMP_FORM);
 								tooltipText = language[3857];
 								break;
 							default:
@@ -372,7 +372,7 @@ void drawSustainedSpells(const int player)
 					break;
 				case EFF_VAMPIRICAURA:
 				{
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_VAMPIRIC_AURA);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_VAMPIRIC_AURA);
 					tooltipText = language[3389];
 					node_t* node = channeledSpells[player].first;
 					for ( ; node != nullptr; node = node->next )
@@ -387,7 +387,7 @@ void drawSustainedSpells(const int player)
 					break;
 				}
 				case EFF_PARALYZED:
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_LIGHTNING);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_LIGHTNING);
 					tooltipText = language[3391];
 					break;
 				case EFF_DRUNK:
@@ -417,7 +417,7 @@ void drawSustainedSpells(const int player)
 					break;
 				case EFF_LEVITATING:
 				{
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_LEVITATION);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_LEVITATION);
 					node_t* node = channeledSpells[player].first;
 					for ( ; node != nullptr; node = node->next )
 					{
@@ -433,7 +433,7 @@ void drawSustainedSpells(const int player)
 				}
 				case EFF_INVISIBLE:
 				{
-					effectImageNode = list_Node(&items[SPELL_ITEM].surfaces, SPELL_INVISIBILITY);
+					effectImageNode = list_NodeIndexed(&items[SPELL_ITEM].surfaces, SPELL_INVISIBILITY);
 					node_t* node = channeledSpells[player].first;
 					for ( ; node != nullptr; node = node->next )
 					{
@@ -573,7 +573,7 @@ void drawSustainedSpells(const int player)
 			tooltipText = language[3398];
 		}
 
-		node_t* node = list_Node(&items[SPELL_ITEM].surfaces, spell->ID);
+		node_t* node = list_NodeIndexed(&items[SPELL_ITEM].surfaces, spell->ID);
 		if (!node)
 		{
 			break;
@@ -20,6 +20,7 @@
 #include "../magic/magic.hpp"
 #include "../menu.hpp"
 #include "../player.hpp"
+#include "../hud_cache.hpp"
 #include "interface.hpp"
 #ifdef STEAMWORKS
 #include <steam/steam_api.h>
@@ -1010,8 +1011,30 @@ void drawBlueInventoryBorder(const int player, const Item& item, int x, int y)
 	drawBox(&pos, color, 127);
 }
 
+// the grid and the item slots of the inventory, see hud_cache.hpp. input is handled
+// around them, so only the parts that just draw are cached
+static HudCacheHandler::Widget_t inventoryGridWidget[MAXPLAYERS];
+static HudCacheHandler::Widget_t inventorySlotsWidget[MAXPLAYERS];
+
+// what updatePlayerInventory() draws for one item, worked out before drawing
+struct InventorySlotDraw_t
+{
+	const Item* item = nullptr;
+	bool grabbed = false; // only the blue border is drawn, at the item's grid slot
+	int x = 0;
+	int y = 0;
+	int slotSize = 0;
+	bool onPaperDoll = false;
+	bool contextMenu = false;
+	bool greyedOut = false;
+	SDL_Surface* sprite = nullptr;
+	SDL_Surface* icon = nullptr; // equipped or broken
+};
+static std::vector<InventorySlotDraw_t> inventorySlotDraws[MAXPLAYERS];
+
 void updatePlayerInventory(const int player)
 {
+	HudPanelTimer panelTimer(player, HudCacheHandler::PANEL_INVENTORY);
 	bool disableMouseDisablingHotbarFocus = false;
 	SDL_Rect pos, mode_pos;
 	node_t* node, *nextnode;
@@ -1030,13 +1053,6 @@ void updatePlayerInventory(const int player)
 
 	const int inventorySlotSize = players[player]->inventoryUI.getSlotSize();
 
-	// draw translucent box
-	pos.x = x;
-	pos.y = y;
-	pos.w = players[player]->inventoryUI.getSizeX() * inventorySlotSize;
-	pos.h = players[player]->inventoryUI.getSizeY() * inventorySlotSize;
-	drawRect(&pos, 0, 224);
-
 	bool& toggleclick = inputs.getUIInteraction(player)->toggleclick;
 	bool& itemMenuOpen = inputs.getUIInteraction(player)->itemMenuOpen;
 	Uint32& itemMenuItem = inputs.getUIInteraction(player)->itemMenuItem;
@@ -1137,20 +1153,27 @@ void updatePlayerInventory(const int player)
 		playSound(139, 64);
 	}
 
-	// draw grid
+	// draw translucent box and grid. nothing above draws, so the box can go here with the grid
 	pos.x = x;
 	pos.y = y;
 	pos.w = players[player]->inventoryUI.getSizeX() * inventorySlotSize;
 	pos.h = players[player]->inventoryUI.getSizeY() * inventorySlotSize;
-	drawLine(pos.x, pos.y, pos.x, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
-	drawLine(pos.x, pos.y, pos.x + pos.w, pos.y, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
-	for ( x = 0; x <= players[player]->inventoryUI.getSizeX(); x++ )
-	{
-		drawLine(pos.x + x * inventorySlotSize, pos.y, pos.x + x * inventorySlotSize, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
-	}
-	for ( y = 0; y <= players[player]->inventoryUI.getSizeY(); y++ )
+	HudCacheHandler::Key gridKey;
+	gridKey.add(xres).add(yres).add(pos.x).add(pos.y).add(pos.w).add(pos.h).add(inventorySlotSize);
+	if ( !HudCache.begin(inventoryGridWidget[player], gridKey) )
 	{
-		drawLine(pos.x, pos.y + y * inventorySlotSize, pos.x + pos.w, pos.y + y * inventorySlotSize, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
+		drawRect(&pos, 0, 224);
+		drawLine(pos.x, pos.y, pos.x, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
+		drawLine(pos.x, pos.y, pos.x + pos.w, pos.y, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
+		for ( x = 0; x <= players[player]->inventoryUI.getSizeX(); x++ )
+		{
+			drawLine(pos.x + x * inventorySlotSize, pos.y, pos.x + x * inventorySlotSize, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
+		}
+		for ( y = 0; y <= players[player]->inventoryUI.getSizeY(); y++ )
+		{
+			drawLine(pos.x, pos.y + y * inventorySlotSize, pos.x + pos.w, pos.y + y * inventorySlotSize, SDL_MapRGB(mainsurface->format, 150, 150, 150), 255);
+		}
+		HudCache.end(inventoryGridWidget[player]);
 	}
 
 	if ( !itemMenuOpen 
@@ -1191,14 +1214,21 @@ void updatePlayerInventory(const int player)
 
 	players[player]->paperDoll.drawSlots();
 	
-	// draw contents of each slot
+	// draw contents of each slot. the slots are worked out first, then drawn
+	// from a cached list unless one of them (or the layout) changed
 	x = players[player]->inventoryUI.getStartX();
 	y = players[player]->inventoryUI.getStartY();
+	std::vector<InventorySlotDraw_t>& slotDraws = inventorySlotDraws[player];
+	slotDraws.clear();
+	HudCacheHandler::Key slotsKey;
+	slotsKey.add(xres).add(yres).add(x).add(y).add(inventorySlotSize).addFloat(uiscale_inventory).add(colorblind);
 	for ( node = stats[player]->inventory.first; node != NULL; node = nextnode )
 	{
 		nextnode = node->next;
 		Item* item = (Item*)node->element;
 
+		InventorySlotDraw_t slot;
+		slot.item = item;
 		if ( item == selectedItem 
 			|| (players[player]->inventory_mode == INVENTORY_MODE_ITEM && itemCategory(item) == SPELL_CAT) 
 			|| (players[player]->inventory_mode == INVENTORY_MODE_SPELL && itemCategory(item) != SPELL_CAT) )
@@ -1210,173 +1240,189 @@ void updatePlayerInventory(const int player)
 				if ( item == selectedItem )
 				{
 					//Draw blue border around the slot if it's the currently grabbed item.
-					drawBlueInventoryBorder(player, *item, x, y);
+					slot.grabbed = true;
+					slotDraws.push_back(slot);
+					slotsKey.add(true).add(item->x).add(item->y);
 				}
 			}
 			continue;
 		}
 
-		int itemDrawnSlotSize = inventorySlotSize;
-		int itemCoordX = x + item->x * itemDrawnSlotSize;
-		int itemCoordY = y + item->y * itemDrawnSlotSize;
+		slot.slotSize = inventorySlotSize;
+		slot.x = x + item->x * slot.slotSize;
+		slot.y = y + item->y * slot.slotSize;
 
-		bool itemOnPaperDoll = false;
 		if ( players[player]->paperDoll.enabled && itemIsEquipped(item, player) )
 		{
 			auto slotType = players[player]->paperDoll.getSlotForItem(*item);
 			if ( slotType != Player::PaperDoll_t::SLOT_MAX )
 			{
-				itemOnPaperDoll = true;
+				slot.onPaperDoll = true;
 				auto& paperDollSlot = players[player]->paperDoll.dollSlots[slotType];
-				itemCoordX = paperDollSlot.pos.x;
-				itemCoordY = paperDollSlot.pos.y;
-				itemDrawnSlotSize = paperDollSlot.pos.w;
+				slot.x = paperDollSlot.pos.x;
+				slot.y = paperDollSlot.pos.y;
+				slot.slotSize = paperDollSlot.pos.w;
 			}
 		}
 
-		pos.x = itemCoordX + 2;
-		if ( itemOnPaperDoll )
-		{
-			pos.x -= 1; // outline here is thinner
-		}
+		slot.contextMenu = itemMenuOpen && item == uidToItem(itemMenuItem);
+		slot.sprite = itemSprite(item);
 
-		pos.y = itemCoordY + 1;
-		pos.w = (itemDrawnSlotSize) - 2;
-		pos.h = (itemDrawnSlotSize) - 2;
-
-		if (!item->identified)
+		if ( players[player] && players[player]->entity && players[player]->entity->effectShapeshift != NOTHING )
 		{
-			// give it a yellow background if it is unidentified
-			drawRect(&pos, SDL_MapRGB(mainsurface->format, 128, 128, 0), 125); //31875
+			// shape shifted, disable some items
+			if ( !item->usableWhileShapeshifted(stats[player]) )
+			{
+				slot.greyedOut = true;
+			}
 		}
-		else if (item->beatitude < 0)
+		if ( !slot.greyedOut && client_classes[player] == CLASS_SHAMAN
+			&& item->type == SPELL_ITEM && !(playerUnlockedShamanSpell(player, item)) )
 		{
-			// give it a red background if cursed
-			drawRect(&pos, SDL_MapRGB(mainsurface->format, 128, 0, 0), 125);
+			slot.greyedOut = true;
 		}
-		else if (item->beatitude > 0)
+
+		// item equipped
+		if ( itemCategory(item) != SPELL_CAT )
 		{
-			// give it a green background if blessed (light blue if colorblind mode)
-			if (colorblind)
+			if ( itemIsEquipped(item, player) )
 			{
-				drawRect(&pos, SDL_MapRGB(mainsurface->format, 100, 245, 255), 65);
+				if ( !slot.onPaperDoll )
+				{
+					slot.icon = equipped_bmp;
+				}
 			}
-			else
+			else if ( item->status == BROKEN )
 			{
-				drawRect(&pos, SDL_MapRGB(mainsurface->format, 0, 255, 0), 65);
+				slot.icon = itembroken_bmp;
 			}
 		}
-		if ( item->status == BROKEN )
+		else
 		{
-			drawRect(&pos, SDL_MapRGB(mainsurface->format, 160, 160, 160), 64);
+			spell_t* spell = getSpellFromItem(player, item);
+			if ( players[player]->magic.selectedSpell() == spell 
+				&& (players[player]->magic.selected_spell_last_appearance == item->appearance || players[player]->magic.selected_spell_last_appearance == -1) )
+			{
+				slot.icon = equipped_bmp;
+			}
 		}
 
-		if ( itemMenuOpen && item == uidToItem(itemMenuItem) )
+		slotDraws.push_back(slot);
+		slotsKey.add(false).add(item->x).add(item->y).add(slot.x).add(slot.y).add(slot.slotSize).add(slot.onPaperDoll)
+			.add(slot.contextMenu).add(slot.greyedOut).add(slot.sprite).add(slot.sprite ? slot.sprite->refcount : 0).add(slot.icon)
+			.add(item->identified).add(item->beatitude).add(item->status).add(item->count);
+	}
+	if ( !HudCache.begin(inventorySlotsWidget[player], slotsKey) )
+	{
+		for ( const InventorySlotDraw_t& slot : slotDraws )
 		{
-			//Draw blue border around the slot if it's the currently context menu'd item.
-			drawBlueInventoryBorder(player, *item, x, y);
-		}
+			const Item* item = slot.item;
+			if ( slot.grabbed )
+			{
+				drawBlueInventoryBorder(player, *item, x, y);
+				continue;
+			}
 
-		// draw item
-		real_t itemUIScale = uiscale_inventory;
-		if ( itemOnPaperDoll )
-		{
-			itemUIScale = 1.0;
-		}
+			pos.x = slot.x + 2;
+			if ( slot.onPaperDoll )
+			{
+				pos.x -= 1; // outline here is thinner
+			}
 
-		pos.x = itemCoordX + 4 * itemUIScale;
-		pos.y = itemCoordY + 4 * itemUIScale;
-		if ( !itemOnPaperDoll )
-		{
-			pos.w = (32) * itemUIScale;
-			pos.h = (32) * itemUIScale;
-		}
-		else
-		{
-			pos.w = (itemDrawnSlotSize * 0.8) * itemUIScale;
-			pos.h = (itemDrawnSlotSize * 0.8) * itemUIScale;
-		}
-		if ( itemSprite(item) )
-		{
-			drawImageScaled(itemSprite(item), NULL, &pos);
-		}
+			pos.y = slot.y + 1;
+			pos.w = (slot.slotSize) - 2;
+			pos.h = (slot.slotSize) - 2;
 
-		bool greyedOut = false;
-		if ( players[player] && players[player]->entity && players[player]->entity->effectShapeshift != NOTHING )
-		{
-			// shape shifted, disable some items
-			if ( !item->usableWhileShapeshifted(stats[player]) )
+			if (!item->identified)
 			{
-				SDL_Rect greyBox;
-				greyBox.x = itemCoordX + 2;
-				greyBox.y = itemCoordY + 1;
-				greyBox.w = (itemDrawnSlotSize) - 2;
-				greyBox.h = (itemDrawnSlotSize) - 2;
-				drawRect(&greyBox, SDL_MapRGB(mainsurface->format, 64, 64, 64), 144);
-				greyedOut = true;
+				// give it a yellow background if it is unidentified
+				drawRect(&pos, SDL_MapRGB(mainsurface->format, 128, 128, 0), 125); //31875
+			}
+			else if (item->beatitude < 0)
+			{
+				// give it a red background if cursed
+				drawRect(&pos, SDL_MapRGB(mainsurface->format, 128, 0, 0), 125);
+			}
+			else if (item->beatitude > 0)
+			{
+				// give it a green background if blessed (light blue if colorblind mode)
+				if (colorblind)
+				{
+					drawRect(&pos, SDL_MapRGB(mainsurface->format, 100, 245, 255), 65);
+				}
+				else
+				{
+					drawRect(&pos, SDL_MapRGB(mainsurface->format, 0, 255, 0), 65);
+				}
+			}
+			if ( item->status == BROKEN )
+			{
+				drawRect(&pos, SDL_MapRGB(mainsurface->format, 160, 160, 160), 64);
 			}
-		}
-		if ( !greyedOut && client_classes[player] == CLASS_SHAMAN
-			&& item->type == SPELL_ITEM && !(playerUnlockedShamanSpell(player, item)) )
-		{
-			SDL_Rect greyBox;
-			greyBox.x = itemCoordX + 2;
-			greyBox.y = itemCoordY + 1;
-			greyBox.w = (itemDrawnSlotSize) - 2;
-			greyBox.h = (itemDrawnSlotSize) - 2;
-			drawRect(&greyBox, SDL_MapRGB(mainsurface->format, 64, 64, 64), 144);
-			greyedOut = true;
-		}
 
-		// item count
-		if ( item->count > 1 )
-		{
-			if ( itemUIScale < 1.5 )
+			if ( slot.contextMenu )
 			{
-				printTextFormatted(font8x8_bmp, pos.x + pos.w - 8 * itemUIScale, pos.y + pos.h - 8 * itemUIScale, "%d", item->count);
+				//Draw blue border around the slot if it's the currently context menu'd item.
+				drawBlueInventoryBorder(player, *item, x, y);
+			}
+
+			// draw item
+			real_t itemUIScale = uiscale_inventory;
+			if ( slot.onPaperDoll )
+			{
+				itemUIScale = 1.0;
+			}
+
+			pos.x = slot.x + 4 * itemUIScale;
+			pos.y = slot.y + 4 * itemUIScale;
+			if ( !slot.onPaperDoll )
+			{
+				pos.w = (32) * itemUIScale;
+				pos.h = (32) * itemUIScale;
 			}
 			else
 			{
-				printTextFormatted(font12x12_bmp, pos.x + pos.w - 12, pos.y + pos.h - 12, "%d", item->count);
+				pos.w = (slot.slotSize * 0.8) * itemUIScale;
+				pos.h = (slot.slotSize * 0.8) * itemUIScale;
+			}
+			if ( slot.sprite )
+			{
+				drawImageScaled(slot.sprite, NULL, &pos);
 			}
-		}
 
-		// item equipped
-		if ( itemCategory(item) != SPELL_CAT )
-		{
-			if ( itemIsEquipped(item, player) )
+			if ( slot.greyedOut )
 			{
-				if ( !itemOnPaperDoll )
-				{
-					pos.x = itemCoordX + 2;
-					pos.y = itemCoordY + itemDrawnSlotSize - 18;
-					pos.w = 16;
-					pos.h = 16;
-					drawImage(equipped_bmp, NULL, &pos);
-				}
+				SDL_Rect greyBox;
+				greyBox.x = slot.x + 2;
+				greyBox.y = slot.y + 1;
+				greyBox.w = (slot.slotSize) - 2;
+				greyBox.h = (slot.slotSize) - 2;
+				drawRect(&greyBox, SDL_MapRGB(mainsurface->format, 64, 64, 64), 144);
 			}
-			else if ( item->status == BROKEN )
+
+			// item count
+			if ( item->count > 1 )
 			{
-				pos.x = itemCoordX + 2;
-				pos.y = itemCoordY + itemDrawnSlotSize - 18;
-				pos.w = 16;
-				pos.h = 16;
-				drawImage(itembroken_bmp, NULL, &pos);
+				if ( itemUIScale < 1.5 )
+				{
+					printTextFormatted(font8x8_bmp, pos.x + pos.w - 8 * itemUIScale, pos.y + pos.h - 8 * itemUIScale, "%d", item->count);
+				}
+				else
+				{
+					printTextFormatted(font12x12_bmp, pos.x + pos.w - 12, pos.y + pos.h - 12, "%d", item->count);
+				}
 			}
-		}
-		else
-		{
-			spell_t* spell = getSpellFromItem(player, item);
-			if ( players[player]->magic.selectedSpell() == spell 
-				&& (players[player]->magic.selected_spell_last_appearance == item->appearance || players[player]->magic.selected_spell_last_appearance == -1) )
+
+			if ( slot.icon )
 			{
-				pos.x = itemCoordX + 2;
-				pos.y = itemCoordY + itemDrawnSlotSize - 18;
+				pos.x = slot.x + 2;
+				pos.y = slot.y + slot.slotSize - 18;
 				pos.w = 16;
 				pos.h = 16;
-				drawImage(equipped_bmp, NULL, &pos);
+				drawImage(slot.icon, NULL, &pos);
 			}
 		}
+		HudCache.end(inventorySlotsWidget[player]);
 	}
 	// autosort button
 	mode_pos.x = players[player]->inventoryUI.getStartX() + players[player]->inventoryUI.getSizeX() * inventorySlotSize + inventory_mode_item_img->w * uiscale_inventory + 2;
@@ -3170,14 +3216,33 @@ bool autoAddHotbarFilter(const Item& item)
 
 void quickStackItems(int player)
 {
+	InventoryIndex* index = getInventoryIndex(&stats[player]->inventory);
+	std::vector<node_t*> sameType;
 	for ( node_t* node = stats[player]->inventory.first; node != NULL; node = node->next )
 	{
 		Item* itemToStack = (Item*)node->element;
 		if ( itemToStack && itemToStack->shouldItemStack(player) )
 		{
-			for ( node_t* node = stats[player]->inventory.first; node != NULL; node = node->next )
+			// itemCompare() only matches items of the same type. the nodes are copied out
+			// first since stacking removes nodes, which rebuilds the index's tables
+			sameType.clear();
+			if ( index )
 			{
-				Item* item2 = (Item*)node->element;
+				for ( int position : index->positionsOfType(stats[player]->inventory, itemToStack->type) )
+				{
+					sameType.push_back(index->nodeAt(position));
+				}
+			}
+			else
+			{
+				for ( node_t* node2 = stats[player]->inventory.first; node2 != NULL; node2 = node2->next )
+				{
+					sameType.push_back(node2);
+				}
+			}
+			for ( node_t* node2 : sameType )
+			{
+				Item* item2 = (Item*)node2->element;
 				// if items are the same, check to see if they should stack
 				if ( item2 && item2 != itemToStack && !itemCompare(itemToStack, item2, false) )
 				{
@@ -3549,31 +3614,31 @@ bool playerLearnedSpellbook(int player, Item* current_item)
 	{
 		return false;
 	}
-	for ( node_t* node = stats[player]->inventory.first; node && current_item->identified; node = node->next )
+	if ( !current_item->identified )
 	{
-		Item* item = static_cast<Item*>(node->element);
-		if ( !item )
-		{
-			continue;
-		}
-		//Search player's inventory for the special spell item.
-		if ( itemCategory(item) != SPELL_CAT )
-		{
-			continue;
-		}
-		if ( item->appearance >= 1000 )
+		return false;
+	}
+	auto learnedFrom = [player, current_item](const Item& item)
+	{
+		if ( item.appearance >= 1000 )
 		{
 			// special shaman racial spells, don't count this as being learnt
-			continue;
-		}
-		spell_t *spell = getSpellFromItem(player, item); //Do not free or delete this.
-		if ( !spell )
-		{
-			continue;
+			return false;
 		}
-		if ( current_item->type == getSpellbookFromSpellID(spell->ID) )
+		spell_t *spell = getSpellFromItem(player, const_cast<Item*>(&item)); //Do not free or delete this.
+		// learned spell, default option is now equip spellbook.
+		return spell && current_item->type == getSpellbookFromSpellID(spell->ID);
+	};
+	//Search player's inventory for the special spell item.
+	if ( InventoryIndex* index = getInventoryIndex(&stats[player]->inventory) )
+	{
+		return index->findFirstInCategory(stats[player]->inventory, SPELL_CAT, learnedFrom) != nullptr;
+	}
+	for ( node_t* node = stats[player]->inventory.first; node; node = node->next )
+	{
+		Item* item = static_cast<Item*>(node->element);
+		if ( item && itemCategory(item) == SPELL_CAT && learnedFrom(*item) )
 		{
-			// learned spell, default option is now equip spellbook.
 			return true;
 		}
 	}
@@ -29,172 +29,140 @@ bool hideItemFromShopView(Item& item)
 	return false;
 }
 
-void rebuildShopInventory(const int player)
+// categories on each shop tab, tab 7 shows everything
+static const std::vector<int> shopTabCategories[] =
 {
-	bool mysteriousShopkeeper = (shopkeepertype[player] == 10);
-	bool mysteriousShopkeeperGreenOrb = false;
-	bool mysteriousShopkeeperBlueOrb = false;
-	bool mysteriousShopkeeperRedOrb = false;
+	{ WEAPON, THROWN },
+	{ ARMOR },
+	{ AMULET, RING },
+	{ SPELLBOOK, MAGICSTAFF, SCROLL },
+	{ GEM },
+	{ FOOD, POTION },
+	{ TOOL, BOOK }
+};
+static const int NUM_SHOP_TAB_CATEGORIES = sizeof(shopTabCategories) / sizeof(shopTabCategories[0]);
+
+static bool shopHasItemOfType(const int player, InventoryIndex* index, ItemType type)
+{
+	if ( index )
+	{
+		return !index->positionsOfType(*shopInv[player], type).empty();
+	}
+	for ( node_t* node = shopInv[player]->first; node != NULL; node = node->next )
+	{
+		Item* item = (Item*)node->element;
+		if ( item && item->type == type )
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/*-------------------------------------------------------------------------------
+
+	getShopTabItems
+
+	fills shown with the items on the player's current shop tab, in list
+	order. the shop list has an InventoryIndex attached (see
+	startTradingServer() and the client's shopInv), so a tab only visits
+	the items in its categories instead of the whole stock.
+
+-------------------------------------------------------------------------------*/
+
+static void getShopTabItems(const int player, std::vector<Item*>& shown)
+{
+	shown.clear();
+	InventoryIndex* index = getInventoryIndex(shopInv[player]);
+	const bool mysteriousShopkeeper = (shopkeepertype[player] == 10);
+	const ItemType orbs[3] = { ARTIFACT_ORB_BLUE, ARTIFACT_ORB_GREEN, ARTIFACT_ORB_RED };
+	bool missingOrb[3] = { false, false, false };
 	if ( mysteriousShopkeeper )
 	{
-		for ( node_t* node = shopInv[player]->first; node != NULL; node = node->next )
+		for ( int c = 0; c < 3; ++c )
 		{
-			Item* item = (Item*)node->element;
-			if ( item )
-			{
-				if ( item->type == ARTIFACT_ORB_BLUE )
-				{
-					mysteriousShopkeeperBlueOrb = true;
-				}
-				else if ( item->type == ARTIFACT_ORB_RED )
-				{
-					mysteriousShopkeeperRedOrb = true;
-				}
-				else if ( item->type == ARTIFACT_ORB_GREEN )
-				{
-					mysteriousShopkeeperGreenOrb = true;
-				}
-			}
+			missingOrb[c] = !shopHasItemOfType(player, index, orbs[c]);
 		}
 	}
 
-	//Count number of items.
-	int c = 0;
-	node_t* node = nullptr;
-	for ( node = shopInv[player]->first; node != NULL; node = node->next )
+	auto addItem = [&](Item* item)
 	{
-		Item* item = (Item*) node->element;
-		if ( item )
+		if ( !item || hideItemFromShopView(*item) )
 		{
-			if ( mysteriousShopkeeper )
-			{
-				if ( !mysteriousShopkeeperBlueOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_BLUE].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_BLUE].end() )
-				{
-					continue;
-				}
-				if ( !mysteriousShopkeeperGreenOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_GREEN].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_GREEN].end() )
-				{
-					continue;
-				}
-				if ( !mysteriousShopkeeperRedOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_RED].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_RED].end() )
-				{
-					continue;
-				}
-			}
-			if ( hideItemFromShopView(*item) )
-			{
-				continue;
-			}
-			if ( shopinventorycategory[player] == 0 && itemCategory(item) != WEAPON && itemCategory(item) != THROWN )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 1 && itemCategory(item) != ARMOR )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 2 && itemCategory(item) != AMULET && itemCategory(item) != RING )
+			return;
+		}
+		for ( int c = 0; c < 3; ++c )
+		{
+			// the mysterious shopkeeper's stock for each orb stays hidden until the orb is traded in
+			if ( missingOrb[c] && shopkeeperMysteriousItems[orbs[c]].find(item->type) != shopkeeperMysteriousItems[orbs[c]].end() )
 			{
-				continue;
+				return;
 			}
-			else if ( shopinventorycategory[player] == 3 && itemCategory(item) != SPELLBOOK && itemCategory(item) != MAGICSTAFF && itemCategory(item) != SCROLL )
+		}
+		shown.push_back(item);
+	};
+
+	const int tab = shopinventorycategory[player];
+	if ( tab >= 0 && tab < NUM_SHOP_TAB_CATEGORIES )
+	{
+		if ( index )
+		{
+			std::vector<int> positions;
+			for ( int cat : shopTabCategories[tab] )
 			{
-				continue;
+				const std::vector<int>& inCategory = index->positionsInCategory(*shopInv[player], cat);
+				positions.insert(positions.end(), inCategory.begin(), inCategory.end());
 			}
-			else if ( shopinventorycategory[player] == 4 && itemCategory(item) != GEM )
+			std::sort(positions.begin(), positions.end());
+			for ( int position : positions )
 			{
-				continue;
+				addItem((Item*)index->nodeAt(position)->element);
 			}
-			else if ( shopinventorycategory[player] == 5 && itemCategory(item) != FOOD && itemCategory(item) != POTION )
+			return;
+		}
+		for ( node_t* node = shopInv[player]->first; node != NULL; node = node->next )
+		{
+			Item* item = (Item*)node->element;
+			if ( !item )
 			{
 				continue;
 			}
-			else if ( shopinventorycategory[player] == 6 && itemCategory(item) != TOOL && itemCategory(item) != BOOK )
+			const int cat = itemCategory(item);
+			for ( int tabCat : shopTabCategories[tab] )
 			{
-				continue;
+				if ( cat == tabCat )
+				{
+					addItem(item);
+					break;
+				}
 			}
 		}
-		c++;
+		return;
+	}
+
+	for ( node_t* node = shopInv[player]->first; node != NULL; node = node->next )
+	{
+		addItem((Item*)node->element);
 	}
+}
+
+void rebuildShopInventory(const int player)
+{
+	static std::vector<Item*> shown;
+	getShopTabItems(player, shown);
+
 	//Sanitize item scroll.
-	shopitemscroll[player] = std::max(0, std::min(shopitemscroll[player], c - NUM_SHOP_GUI_SLOTS));
+	shopitemscroll[player] = std::max(0, std::min(shopitemscroll[player], static_cast<int>(shown.size()) - NUM_SHOP_GUI_SLOTS));
 	//Clear out currently displayed items.
-	for ( c = 0; c < 4; c++ )
+	for ( int c = 0; c < 4; c++ )
 	{
 		shopinvitems[player][c] = NULL;
 	}
 
 	//Display the items.
-	c = 0;
-	for ( node = shopInv[player]->first; node != NULL; node = node->next )
+	for ( int c = 0; c < NUM_SHOP_GUI_SLOTS && shopitemscroll[player] + c < static_cast<int>(shown.size()); c++ )
 	{
-		Item* item = (Item*) node->element;
-		if (item)
-		{
-			if ( mysteriousShopkeeper )
-			{
-				if ( !mysteriousShopkeeperBlueOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_BLUE].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_BLUE].end() )
-				{
-					continue;
-				}
-				if ( !mysteriousShopkeeperGreenOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_GREEN].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_GREEN].end() )
-				{
-					continue;
-				}
-				if ( !mysteriousShopkeeperRedOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_RED].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_RED].end() )
-				{
-					continue;
-				}
-			}
-			if ( hideItemFromShopView(*item) )
-			{
-				continue;
-			}
-			if ( shopinventorycategory[player] == 0 && itemCategory(item) != WEAPON && itemCategory(item) != THROWN )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 1 && itemCategory(item) != ARMOR )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 2 && itemCategory(item) != AMULET && itemCategory(item) != RING )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 3 && itemCategory(item) != SPELLBOOK && itemCategory(item) != MAGICSTAFF && itemCategory(item) != SCROLL )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 4 && itemCategory(item) != GEM )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 5 && itemCategory(item) != FOOD && itemCategory(item) != POTION )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 6 && itemCategory(item) != TOOL && itemCategory(item) != BOOK )
-			{
-				continue;
-			}
-			c++;
-			if ( c <= shopitemscroll[player] )
-			{
-				continue;
-			}
-			shopinvitems[player][c - shopitemscroll[player] - 1] = item;
-			if ( c > 3 + shopitemscroll[player] )
-			{
-				break;
-			}
-		}
+		shopinvitems[player][c] = shown[shopitemscroll[player] + c];
 	}
 }
 
@@ -320,7 +288,6 @@ void warpMouseToSelectedShopSlot(const int player)
 void updateShopWindow(const int player)
 {
 	SDL_Rect pos;
-	node_t* node;
 	int c;
 
 	if ( player < 0 )
@@ -452,95 +419,14 @@ void updateShopWindow(const int player)
 
 	rebuildShopInventory(player);
 
+	// rebuildShopInventory() has already picked the visible items
 	int y3 = y + 22;
 	bool mysteriousShopkeeper = (shopkeepertype[player] == 10);
-	bool mysteriousShopkeeperGreenOrb = false;
-	bool mysteriousShopkeeperBlueOrb = false;
-	bool mysteriousShopkeeperRedOrb = false;
-	if ( mysteriousShopkeeper )
+	for ( c = 0; c < NUM_SHOP_GUI_SLOTS; c++ )
 	{
-		for ( node = shopInv[player]->first; node != NULL; node = node->next )
-		{
-			Item* item = (Item*)node->element;
-			if ( item )
-			{
-				if ( item->type == ARTIFACT_ORB_BLUE )
-				{
-					mysteriousShopkeeperBlueOrb = true;
-				}
-				else if ( item->type == ARTIFACT_ORB_RED )
-				{
-					mysteriousShopkeeperRedOrb = true;
-				}
-				else if ( item->type == ARTIFACT_ORB_GREEN )
-				{
-					mysteriousShopkeeperGreenOrb = true;
-				}
-			}
-		}
-	}
-
-	c = 0;
-	for ( node = shopInv[player]->first; node != NULL; node = node->next )
-	{
-		Item* item = (Item*) node->element;
-		if (item)
+		Item* item = shopinvitems[player][c];
+		if ( item )
 		{
-			if ( mysteriousShopkeeper )
-			{
-				if ( !mysteriousShopkeeperBlueOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_BLUE].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_BLUE].end() )
-				{
-					continue;
-				}
-				if ( !mysteriousShopkeeperGreenOrb 
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_GREEN].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_GREEN].end() )
-				{
-					continue;
-				}
-				if ( !mysteriousShopkeeperRedOrb
-					&& shopkeeperMysteriousItems[ARTIFACT_ORB_RED].find(item->type) != shopkeeperMysteriousItems[ARTIFACT_ORB_RED].end() )
-				{
-					continue;
-				}
-			}
-			if ( hideItemFromShopView(*item) )
-			{
-				continue;
-			}
-			if ( shopinventorycategory[player] == 0 && itemCategory(item) != WEAPON && itemCategory(item) != THROWN )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 1 && itemCategory(item) != ARMOR )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 2 && itemCategory(item) != AMULET && itemCategory(item) != RING )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 3 && itemCategory(item) != SPELLBOOK && itemCategory(item) != MAGICSTAFF && itemCategory(item) != SCROLL )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 4 && itemCategory(item) != GEM )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 5 && itemCategory(item) != FOOD && itemCategory(item) != POTION )
-			{
-				continue;
-			}
-			else if ( shopinventorycategory[player] == 6 && itemCategory(item) != TOOL && itemCategory(item) != BOOK )
-			{
-				continue;
-			}
-			c++;
-			if ( c <= shopitemscroll[player] )
-			{
-				continue;
-			}
 			char tempstr[64] = { 0 };
 			strncpy(tempstr, item->description(), 42);
 			if ( strlen(tempstr) == 42 )
@@ -558,7 +444,7 @@ void updateShopWindow(const int player)
 			if ( mysteriousShopkeeper )
 			{
 				pos.x = x + 12 + (348);
-				pos.y = y + 17 + 18 * (c - shopitemscroll[player] - 1);
+				pos.y = y + 17 + 18 * c;
 				pos.w = 16;
 				pos.h = 16;
 
@@ -577,15 +463,11 @@ void updateShopWindow(const int player)
 			}
 
 			pos.x = x + 12 + 16;
-			pos.y = y + 17 + 18 * (c - shopitemscroll[player] - 1);
+			pos.y = y + 17 + 18 * c;
 			pos.w = 16;
 			pos.h = 16;
 			drawImageScaled(itemSprite(item), NULL, &pos);
 			y3 += 18;
-			if ( c > 3 + shopitemscroll[player] )
-			{
-				break;
-			}
 		}
 	}
 
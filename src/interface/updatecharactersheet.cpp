@@ -22,6 +22,7 @@
 #include "../menu.hpp"
 #include "../net.hpp"
 #include "../scores.hpp"
+#include "../hud_cache.hpp"
 
 void statsHoverText(const int player, Stat* tmpStat);
 
@@ -33,8 +34,12 @@ void statsHoverText(const int player, Stat* tmpStat);
 
 -------------------------------------------------------------------------------*/
 
+// the name, level and attribute text on the character sheet, see hud_cache.hpp
+static HudCacheHandler::Widget_t characterSheetStatsWidget[MAXPLAYERS];
+
 void updateCharacterSheet(const int player)
 {
+	HudPanelTimer panelTimer(player, HudCacheHandler::PANEL_CHARACTER_SHEET);
 	int i = 0;
 	int x = 0;
 	SDL_Rect pos;
@@ -228,13 +233,6 @@ void updateCharacterSheet(const int player)
 		fontWidth = TTF16_WIDTH;
 	}
 	text_y = statWindowBox.y + 6;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, "%s", stats[player]->name);
-	text_y += pad_y;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[359], stats[player]->LVL, playerClassLangEntry(client_classes[player], player));
-	text_y += pad_y;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[360], stats[player]->EXP);
-	text_y += pad_y;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[361], currentlevel);
 
 	Entity* playerEntity = nullptr;
 	if ( players[player] )
@@ -242,50 +240,17 @@ void updateCharacterSheet(const int player)
 		playerEntity = players[player]->entity;
 	}
 
-	// attributes
-	Sint32 statModifier = 0;
-	char statText[64] = "";
-	//Uint32 statColor = uint32ColorWhite(*mainsurface);
-	text_y += pad_y * 2;
-	snprintf(statText, 64, language[1200], stats[player]->STR);
-	ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
-	printStatBonus(fontStat, stats[player]->STR, statGetSTR(stats[player], playerEntity), text_x + longestline(statText) * fontWidth, text_y);
-
-	text_y += pad_y;
-	snprintf(statText, 64, language[1201], stats[player]->DEX);
-	ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
-	printStatBonus(fontStat, stats[player]->DEX, statGetDEX(stats[player], playerEntity), text_x + longestline(statText) * fontWidth, text_y);
-
-	text_y += pad_y;
-	snprintf(statText, 64, language[1202], stats[player]->CON);
-	ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
-	printStatBonus(fontStat, stats[player]->CON, statGetCON(stats[player], playerEntity), text_x + longestline(statText) * fontWidth, text_y);
-
-	text_y += pad_y;
-	snprintf(statText, 64, language[1203], stats[player]->INT);
-	ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
-	printStatBonus(fontStat, stats[player]->INT, statGetINT(stats[player], playerEntity), text_x + longestline(statText) * fontWidth, text_y);
-
-	text_y += pad_y;
-	snprintf(statText, 64, language[1204], stats[player]->PER);
-	ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
-	printStatBonus(fontStat, stats[player]->PER, statGetPER(stats[player], playerEntity), text_x + longestline(statText) * fontWidth, text_y);
-
-	text_y += pad_y;
-	snprintf(statText, 64, language[1205], stats[player]->CHR);
-	ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
-	printStatBonus(fontStat, stats[player]->CHR, statGetCHR(stats[player], playerEntity), text_x + longestline(statText) * fontWidth, text_y);
-
-	// armor, gold, and weight
+	// the text only changes with the values it shows, so it's drawn from a cached list.
+	// the values are still worked out every frame for the key and the hover text
+	const char* className = playerClassLangEntry(client_classes[player], player);
+	const Sint32 baseStats[NUMSTATS] = { stats[player]->STR, stats[player]->DEX, stats[player]->CON,
+		stats[player]->INT, stats[player]->PER, stats[player]->CHR };
+	const Sint32 modifiedStats[NUMSTATS] = { statGetSTR(stats[player], playerEntity), statGetDEX(stats[player], playerEntity),
+		statGetCON(stats[player], playerEntity), statGetINT(stats[player], playerEntity),
+		statGetPER(stats[player], playerEntity), statGetCHR(stats[player], playerEntity) };
 	int attackInfo[6] = { 0 };
-	text_y += pad_y * 2;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[2542], displayAttackPower(player, attackInfo));
-
-	text_y += pad_y;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[371], AC(stats[player]));
-
-	text_y += pad_y;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[370], stats[player]->GOLD);
+	const Sint32 attackPower = displayAttackPower(player, attackInfo);
+	const Sint32 armorClass = AC(stats[player]);
 	Uint32 weight = 0;
 	for ( node = stats[player]->inventory.first; node != NULL; node = node->next )
 	{
@@ -298,8 +263,60 @@ void updateCharacterSheet(const int player)
 		weight += itemWeight;
 	}
 	weight += stats[player]->GOLD / 100;
-	text_y += pad_y;
-	ttfPrintTextFormatted(fontStat, text_x, text_y, language[372], weight);
+
+	HudCacheHandler::Key statsKey;
+	statsKey.add(xres).add(yres).add(text_x).add(text_y).add(uiscale_charactersheet)
+		.add(stats[player]->name).add(stats[player]->LVL).add(className).add(stats[player]->EXP).add(currentlevel)
+		.add(attackPower).add(armorClass).add(stats[player]->GOLD).add(weight);
+	for ( c = 0; c < NUMSTATS; ++c )
+	{
+		statsKey.add(baseStats[c]).add(modifiedStats[c]).add(language[1200 + c]);
+	}
+	const int statsLanguage[] = { 359, 360, 361, 2542, 371, 370, 372 };
+	for ( int entry : statsLanguage )
+	{
+		statsKey.add(language[entry]);
+	}
+
+	const int statsTextTop = text_y;
+	if ( !HudCache.begin(characterSheetStatsWidget[player], statsKey) )
+	{
+		ttfPrintTextFormatted(fontStat, text_x, text_y, "%s", stats[player]->name);
+		text_y += pad_y;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[359], stats[player]->LVL, className);
+		text_y += pad_y;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[360], stats[player]->EXP);
+		text_y += pad_y;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[361], currentlevel);
+
+		// attributes
+		char statText[64] = "";
+		text_y += pad_y;
+		for ( c = 0; c < NUMSTATS; ++c )
+		{
+			text_y += pad_y;
+			snprintf(statText, 64, language[1200 + c], baseStats[c]);
+			ttfPrintTextFormatted(fontStat, text_x, text_y, statText);
+			printStatBonus(fontStat, baseStats[c], modifiedStats[c], text_x + longestline(statText) * fontWidth, text_y);
+		}
+
+		// armor, gold, and weight
+		text_y += pad_y * 2;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[2542], attackPower);
+
+		text_y += pad_y;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[371], armorClass);
+
+		text_y += pad_y;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[370], stats[player]->GOLD);
+		text_y += pad_y;
+		ttfPrintTextFormatted(fontStat, text_x, text_y, language[372], weight);
+
+		HudCache.end(characterSheetStatsWidget[player]);
+	}
+	// leave text_y on the weight line like drawing does, the gold hover text below is placed from it.
+	// floor is 3 lines below the name, then a gap to the attributes, a gap to attack, and 3 lines to weight
+	text_y = statsTextTop + pad_y * (3 + 2 + (NUMSTATS - 1) + 2 + 3);
 
 	statsHoverText(player, stats[player]);
 	attackHoverText(player, attackInfo);
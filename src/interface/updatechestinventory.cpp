@@ -23,46 +23,26 @@ Entity* openedChest[MAXPLAYERS] = { nullptr };
 
 void repopulateInvItems(const int player, list_t* chestInventory)
 {
-	int c = 0;
-
 	//Step 1: Clear.
-	for ( c = 0; c < kNumChestItemsToDisplay; ++c )
+	for ( int c = 0; c < kNumChestItemsToDisplay; ++c )
 	{
 		invitemschest[player][c] = nullptr;
 	}
 
-	node_t* node = nullptr;
-	Item* item = nullptr;
-
-	c = 0;
-
-	//Step 2: Loop through inventory till reach part visible in chest GUI and add those items.
-	for ( node = chestInventory->first; node != nullptr; node = node->next )
+	//Step 2: Add the items in the part of the chest visible in the chest GUI.
+	for ( int c = 0; c < kNumChestItemsToDisplay; ++c )
 	{
-		if ( node->element )
+		node_t* node = list_NodeIndexed(chestInventory, chestitemscroll[player] + c);
+		if ( !node )
 		{
-			item = (Item*) node->element;
-			if ( item )
-			{
-				++c;
-				if ( c <= chestitemscroll[player] )
-				{
-					continue;
-				}
-				invitemschest[player][c - chestitemscroll[player] - 1] = item;
-				if ( c > (kNumChestItemsToDisplay - 1) + chestitemscroll[player] )
-				{
-					break;
-				}
-			}
+			break;
 		}
+		invitemschest[player][c] = (Item*) node->element;
 	}
 }
 
 int numItemsInChest(const int player)
 {
-	node_t* node = nullptr;
-
 	list_t* chestInventory = nullptr;
 	if ( multiplayer == CLIENT )
 	{
@@ -73,17 +53,7 @@ int numItemsInChest(const int player)
 		chestInventory = (list_t*)openedChest[player]->children.first->element;
 	}
 
-	int i = 0;
-
-	if ( chestInventory )
-	{
-		for (node = chestInventory->first; node != nullptr; node = node->next)
-		{
-			++i;
-		}
-	}
-
-	return i;
+	return chestInventory ? list_Size(chestInventory) : 0;
 }
 
 const int getChestGUIStartX(const int player)
@@ -446,40 +416,27 @@ void updateChestInventory(const int player)
 
 			repopulateInvItems(player, chest_inventory);
 
-			c = 0;
-
 			//Actually render the items.
-			for (node = chest_inventory->first; node != NULL; node = node->next)
+			for ( c = 0; c < kNumChestItemsToDisplay; ++c )
 			{
-				if (node->element)
+				item = invitemschest[player][c];
+				if ( !item )
 				{
-					item = (Item*) node->element;
-					if (item)
-					{
-						c++;
-						if ( c <= chestitemscroll[player] )
-						{
-							continue;
-						}
-						char tempstr[64] = { 0 };
-						strncpy(tempstr, item->description(), 46);
-						if ( strlen(tempstr) == 46 )
-						{
-							strcat(tempstr, " ...");
-						}
-						ttfPrintText(ttf8, getChestGUIStartX(player) + 36, y, tempstr);
-						pos.x = getChestGUIStartX(player) + 16;
-						pos.y = getChestGUIStartY(player) + 17 + 18 * (c - chestitemscroll[player] - 1);
-						pos.w = 16;
-						pos.h = 16;
-						drawImageScaled(itemSprite(item), NULL, &pos);
-						y += 18;
-						if (c > (kNumChestItemsToDisplay - 1) + chestitemscroll[player])
-						{
-							break;
-						}
-					}
+					break;
+				}
+				char tempstr[64] = { 0 };
+				strncpy(tempstr, item->description(), 46);
+				if ( strlen(tempstr) == 46 )
+				{
+					strcat(tempstr, " ...");
 				}
+				ttfPrintText(ttf8, getChestGUIStartX(player) + 36, y, tempstr);
+				pos.x = getChestGUIStartX(player) + 16;
+				pos.y = getChestGUIStartY(player) + 17 + 18 * c;
+				pos.w = 16;
+				pos.h = 16;
+				drawImageScaled(itemSprite(item), NULL, &pos);
+				y += 18;
 			}
 		}
 	}
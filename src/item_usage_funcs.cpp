@@ -326,6 +326,7 @@ bool item_PotionWater(Item*& item, Entity* entity, Entity* usedBy)
 					steamAchievement("BARONY_ACH_THE_WAY_YOU_LIKE_IT");
 				}
 			}
+			stats->invalidateDerivedStats();
 			messagePlayer(player, language[858], toCurse->getName());
 			if ( multiplayer == CLIENT )
 			{
@@ -2554,6 +2555,7 @@ void item_ScrollEnchantWeapon(Item* item, int player)
 			}
 			(*toEnchant)->beatitude += 1 + item->beatitude;
 		}
+		stats[player]->invalidateDerivedStats();
 
 		if ( multiplayer == CLIENT )
 		{
@@ -2718,6 +2720,7 @@ void item_ScrollEnchantArmor(Item* item, int player)
 			}
 			armor->beatitude += 1 + item->beatitude;
 		}
+		stats[player]->invalidateDerivedStats();
 
 		if ( multiplayer == CLIENT )
 		{
@@ -2879,6 +2882,7 @@ void item_ScrollRemoveCurse(Item* item, int player)
 					steamAchievement("BARONY_ACH_THE_WAY_YOU_LIKE_IT");
 				}
 			}
+			stats[player]->invalidateDerivedStats();
 			messagePlayer(player, language[858], toCurse->getName());
 			if ( multiplayer == CLIENT )
 			{
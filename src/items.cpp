@@ -329,18 +329,196 @@ Item* uidToItem(const Uint32 uid)
 		{
 			continue;
 		}
-		for ( node_t* node = stats[i]->inventory.first; node != nullptr; node = node->next )
+		if ( node_t* node = stats[i]->inventoryIndex.findUid(stats[i]->inventory, uid) )
 		{
-			Item* item = static_cast<Item*>(node->element);
-			if ( item->uid == uid )
+			return static_cast<Item*>(node->element);
+		}
+	}
+	return nullptr;
+}
+
+/*-------------------------------------------------------------------------------
+
+	InventoryIndex
+
+	uid, type and category lookups over an inventory list. the tables
+	are rebuilt from the list on the first lookup after it changes.
+
+-------------------------------------------------------------------------------*/
+
+void InventoryIndex::update(list_t& inventory)
+{
+	if ( !dirty && builtFirst == inventory.first && builtLast == inventory.last )
+	{
+		return;
+	}
+
+	nodes.clear();
+	byUid.clear();
+	byType.clear();
+	byCategory.clear();
+	for ( node_t* node = inventory.first; node != nullptr; node = node->next )
+	{
+		Item* item = static_cast<Item*>(node->element);
+		if ( !item )
+		{
+			continue;
+		}
+		int index = static_cast<int>(nodes.size());
+		nodes.push_back(node);
+		byUid.emplace(item->uid, node); // keeps the first node, same as walking the list
+		byType[item->type].push_back(index);
+		byCategory[itemCategory(item)].push_back(index);
+	}
+	builtFirst = inventory.first;
+	builtLast = inventory.last;
+	dirty = false;
+}
+
+node_t* InventoryIndex::findUid(list_t& inventory, Uint32 uid)
+{
+	update(inventory);
+	auto find = byUid.find(uid);
+	if ( find == byUid.end() )
+	{
+		return nullptr;
+	}
+	return find->second;
+}
+
+node_t* InventoryIndex::findFirst(list_t& inventory, int itemType, int cat)
+{
+	update(inventory);
+	int first = -1;
+	if ( cat >= 0 )
+	{
+		auto find = byCategory.find(cat);
+		if ( find != byCategory.end() && !find->second.empty() )
+		{
+			first = find->second.front();
+		}
+	}
+	if ( itemType >= 0 )
+	{
+		auto find = byType.find(itemType);
+		if ( find != byType.end() && !find->second.empty() )
+		{
+			if ( first < 0 || find->second.front() < first )
+			{
+				first = find->second.front();
+			}
+		}
+	}
+	return first >= 0 ? nodes[first] : nullptr;
+}
+
+node_t* InventoryIndex::findFirstInCategory(list_t& inventory, int cat, const std::function<bool(const Item&)>& check, int* position)
+{
+	update(inventory);
+	auto find = byCategory.find(cat);
+	if ( find != byCategory.end() )
+	{
+		for ( int index : find->second )
+		{
+			if ( check(*static_cast<Item*>(nodes[index]->element)) )
 			{
-				return item;
+				if ( position )
+				{
+					*position = index;
+				}
+				return nodes[index];
 			}
 		}
 	}
 	return nullptr;
 }
 
+const std::vector<int>& InventoryIndex::positionsOfType(list_t& inventory, int itemType)
+{
+	static const std::vector<int> none;
+	update(inventory);
+	auto find = byType.find(itemType);
+	return find != byType.end() ? find->second : none;
+}
+
+const std::vector<int>& InventoryIndex::positionsInCategory(list_t& inventory, int cat)
+{
+	static const std::vector<int> none;
+	update(inventory);
+	auto find = byCategory.find(cat);
+	return find != byCategory.end() ? find->second : none;
+}
+
+/*-------------------------------------------------------------------------------
+
+	attachInventoryIndex
+
+	ties an InventoryIndex to a list. the list is flagged so list.cpp only
+	looks an index up for lists that have one, and the table here confirms
+	the flag, since lists set up by hand can have any bits set. attached
+	lists must be detached before they're freed. the table is per thread,
+	so the level prefetch worker's lists never look up the main thread's.
+
+-------------------------------------------------------------------------------*/
+
+static thread_local std::unordered_map<const list_t*, InventoryIndex*> inventoryIndexes;
+
+void attachInventoryIndex(list_t* list, InventoryIndex* index)
+{
+	if ( !list || !index )
+	{
+		return;
+	}
+	list->flags |= LIST_FLAG_INVENTORYINDEX;
+	inventoryIndexes[list] = index;
+	index->markDirty();
+}
+
+void detachInventoryIndex(list_t* list)
+{
+	if ( !list || !(list->flags & LIST_FLAG_INVENTORYINDEX) )
+	{
+		return;
+	}
+	list->flags &= ~LIST_FLAG_INVENTORYINDEX;
+	inventoryIndexes.erase(list);
+}
+
+InventoryIndex* getInventoryIndex(const list_t* list)
+{
+	if ( !list || !(list->flags & LIST_FLAG_INVENTORYINDEX) )
+	{
+		return nullptr;
+	}
+	auto find = inventoryIndexes.find(list);
+	return find != inventoryIndexes.end() ? find->second : nullptr;
+}
+
+void markInventoryIndexDirty(const list_t* list)
+{
+	if ( InventoryIndex* index = getInventoryIndex(list) )
+	{
+		index->markDirty();
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	getIndexedInventoryStats
+
+	returns myStats if its inventory has an up to date InventoryIndex.
+
+-------------------------------------------------------------------------------*/
+
+static Stat* getIndexedInventoryStats(const Stat* const myStats)
+{
+	if ( myStats && getInventoryIndex(&myStats->inventory) == &myStats->inventoryIndex )
+	{
+		return const_cast<Stat*>(myStats);
+	}
+	return nullptr;
+}
+
 /*-------------------------------------------------------------------------------
 
 	itemCurve
@@ -1029,7 +1207,7 @@ SDL_Surface* itemSprite(Item* const item)
 		}
 		if (spell)
 		{
-			node_t* node = list_Node(&items[item->type].surfaces, spell->ID);
+			node_t* node = list_NodeIndexed(&items[item->type].surfaces, spell->ID);
 			if ( !node )
 			{
 				return nullptr;
@@ -1040,7 +1218,7 @@ SDL_Surface* itemSprite(Item* const item)
 	}
 	else
 	{
-		node_t* node = list_Node(&items[item->type].surfaces, item->appearance % items[item->type].variations);
+		node_t* node = list_NodeIndexed(&items[item->type].surfaces, item->appearance % items[item->type].variations);
 		if ( !node )
 		{
 			return nullptr;
@@ -1649,6 +1827,8 @@ EquipItemResult equipItem(Item* const item, Item** const slot, const int player)
 		return EQUIP_ITEM_FAIL_CANT_UNEQUIP;
 	}
 
+	stats[player]->invalidateDerivedStats();
+
 	if ( players[player]->isLocalPlayer() && multiplayer != SINGLE
 		&& item->unableToEquipDueToSwapWeaponTimer(player) )
 	{
@@ -4015,6 +4195,11 @@ node_t* itemNodeInInventory(const Stat* const myStats, const ItemType itemToFind
 		return nullptr;
 	}
 
+	if ( Stat* playerStats = getIndexedInventoryStats(myStats) )
+	{
+		return playerStats->inventoryIndex.findFirst(playerStats->inventory, itemToFind, cat >= WEAPON ? cat : -1);
+	}
+
 	node_t* node = nullptr;
 	node_t* nextnode = nullptr;
 
@@ -4051,6 +4236,12 @@ node_t* spellbookNodeInInventory(const Stat* const myStats, const int spellIDToF
 	}
 	//messagePlayer(clientnum, "Got into spellbookNodeInInventory().");
 
+	if ( Stat* playerStats = getIndexedInventoryStats(myStats) )
+	{
+		return playerStats->inventoryIndex.findFirstInCategory(playerStats->inventory, SPELLBOOK,
+			[spellIDToFind](const Item& item) { return getSpellIDFromSpellbook(item.type) == spellIDToFind; });
+	}
+
 	for ( node_t* node = myStats->inventory.first; node != nullptr; node = node->next )
 	{
 		Item* item = static_cast<Item*>(node->element);
@@ -4079,6 +4270,25 @@ node_t* getRangedWeaponItemNodeInInventory(const Stat* const myStats, const bool
 		return nullptr;
 	}
 
+	if ( Stat* playerStats = getIndexedInventoryStats(myStats) )
+	{
+		// ranged weapons are all in the WEAPON category, so only look there and at staves.
+		int rangedPosition = -1;
+		int staffPosition = -1;
+		node_t* ranged = playerStats->inventoryIndex.findFirstInCategory(playerStats->inventory, WEAPON,
+			[](const Item& item) { return isRangedWeapon(item); }, &rangedPosition);
+		if ( includeMagicstaff )
+		{
+			node_t* staff = playerStats->inventoryIndex.findFirstInCategory(playerStats->inventory, MAGICSTAFF,
+				[](const Item& item) { return true; }, &staffPosition);
+			if ( staff && (!ranged || staffPosition < rangedPosition) )
+			{
+				ranged = staff;
+			}
+		}
+		return ranged;
+	}
+
 	for ( node_t* node = myStats->inventory.first; node != nullptr; node = node->next )
 	{
 		Item* item = static_cast<Item*>(node->element);
@@ -4314,6 +4524,10 @@ void copyItem(Item* const itemToSet, const Item* const itemToCopy) //This should
 	itemToSet->uid = itemToCopy->uid;
 	itemToSet->ownerUid = itemToCopy->ownerUid;
 	itemToSet->isDroppable = itemToCopy->isDroppable;
+	if ( itemToSet->node )
+	{
+		markInventoryIndexDirty(itemToSet->node->list);
+	}
 }
 
 ItemType itemTypeWithinGoldValue(const int cat, const int minValue, const int maxValue)
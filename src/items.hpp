@@ -530,6 +530,11 @@ void item_Spellbook(Item*& item, int player);
 //General functions.
 Item* newItem(ItemType type, Status status, Sint16 beatitude, Sint16 count, Uint32 appearance, bool identified, list_t* inventory);
 Item* uidToItem(Uint32 uid);
+// InventoryIndex tables are kept for the lists they're attached to, see list_t::flags
+void attachInventoryIndex(list_t* list, InventoryIndex* index);
+void detachInventoryIndex(list_t* list); // must be called before an attached list or its index is freed
+InventoryIndex* getInventoryIndex(const list_t* list); // nullptr if none is attached
+void markInventoryIndexDirty(const list_t* list); // call when an attached list or the uid/type of an item in it changes
 ItemType itemCurve(Category cat);
 ItemType itemLevelCurve(Category cat, int minLevel, int maxLevel);
 Item* newItemFromEntity(const Entity* entity); //Make sure to call free(item).
@@ -1,14 +1,43 @@
 #include "main.hpp"
 #include "files.hpp"
 #include "json.hpp"
+#include <chrono>
 
 #include "rapidjson/document.h"
+#include "rapidjson/reader.h"
 #include "rapidjson/writer.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/error/en.h"
 
 const Uint32 BinaryFormatTag = *"spff";
 
+bool FileHelper::streamingJsonReader = true;
+
+// read an entire file into memory, appending a null terminator
+static bool readAllFileData(File * fp, std::vector<char> & data, const char * readerName) {
+	if (fp->seek(0, FileBase::SeekMode::SETEND)) {
+		printlog("%s: failed to seek end (%d)", readerName, errno);
+		return false;
+	}
+
+	long size = fp->tell();
+	if (fp->seek(0, FileBase::SeekMode::SET)) {
+		printlog("%s: failed to seek beg (%d)", readerName, errno);
+		return false;
+	}
+
+	// reserve an extra byte for the null terminator
+	data.assign(size + 1, 0);
+
+	size_t bytesRead = fp->read(data.data(), sizeof(char), size);
+	if (bytesRead != size) {
+		printlog("%s: failed to read data (%d)", readerName, errno);
+		return false;
+	}
+
+	return true;
+}
+
 class JsonFileWriter : public FileInterface {
 public:
 
@@ -182,51 +211,585 @@ protected:
 	}
 
 	bool readAllFileData(File * fp) {
-		if (fp->seek(0, FileBase::SeekMode::SETEND)) {
-			printlog("JsonFileReader: failed to seek end (%d)", errno);
+		std::vector<char> data;
+		if (!::readAllFileData(fp, data, "JsonFileReader")) {
 			return false;
 		}
 
-		long size = fp->tell();
-		if (fp->seek(0, FileBase::SeekMode::SET)) {
-			printlog("JsonFileReader: failed to seek beg (%d)", errno);
+		rapidjson::ParseResult result = doc.Parse(data.data());
+		if (!result) {
+			printlog("JsonFileReader: parse error: %s (%d)", rapidjson::GetParseError_En(result.Code()), result.Offset());
 			return false;
 		}
 
-		// reserve an extra byte for the null terminator
-		char * data = (char *)calloc(sizeof(char), size + 1);
-		assert(data);
+		return true;
+	}
+
+	struct DocIterator {
+		rapidjson::Value::ConstValueIterator it;
+		Uint32 index;
+	};
+
+	rapidjson::Document doc;
+	const char * propName = nullptr;
+	std::vector<DocIterator> stack;
+};
+
+// Reads json without building a DOM. Values are scanned straight out of the file buffer as the
+// serialize() function asks for them, and the scan checks the syntax of everything it walks over,
+// including the members nothing asks for, so the file is only read once.
+// A syntax error stops the scan and fails the read, but values read before it are kept.
+// Properties that appear earlier in the file than they are requested are remembered by offset,
+// so objects whose keys are out of order still read correctly.
+class JsonStreamReader : public FileInterface {
+public:
+
+	static bool readObject(File * fp, const FileHelper::SerializationFunc & serialize) {
+		JsonStreamReader jsr;
+
+		if (!jsr.readAllFileData(fp)) {
+			return false;
+		}
 
-		size_t bytesRead = fp->read(data, sizeof(char), size);
-		if (bytesRead != size) {
-			printlog("JsonFileReader: failed to read data (%d)", errno);
-			free(data);
+		size_t root = jsr.skipWhitespace(0);
+		if (jsr.data[root] != '{') {
+			jsr.fail(root, "root is not an object");
 			return false;
 		}
 
-		// null terminate
-		data[size] = 0;
+		jsr.beginObject();
+		serialize(&jsr);
+		jsr.endObject();
 
-		rapidjson::ParseResult result = doc.Parse(data);
+		if (!jsr.failed()) {
+			size_t pos = jsr.skipWhitespace(jsr.rootEnd);
+			if (pos != jsr.end()) {
+				jsr.fail(pos, "content after the root object");
+			}
+		}
 
-		free(data);
+		return !jsr.failed();
+	}
 
-		if (!result) {
-			printlog("JsonFileReader: parse error: %s (%d)", rapidjson::GetParseError_En(result.Code()), result.Offset());
+	virtual bool isReading() const override { return true; }
+
+	virtual void beginObject() override {
+		size_t pos = GetCurrentValue();
+		Frame frame;
+		frame.start = pos;
+		frame.isArray = false;
+		if (pos == npos || data[pos] != '{') {
+			if (pos != npos) {
+				printlog("JsonStreamReader: expected object for '%s'", lastName());
+			}
+			frame.cursor = npos;
+		}
+		else {
+			frame.cursor = pos + 1;
+		}
+		stack.push_back(frame);
+	}
+
+	virtual void endObject() override {
+		endFrame('}');
+	}
+
+	virtual void beginArray(Uint32 & size) override {
+		size_t pos = GetCurrentValue();
+		Frame frame;
+		frame.start = pos;
+		frame.isArray = true;
+		if (pos == npos || data[pos] != '[') {
+			if (pos != npos) {
+				printlog("JsonStreamReader: expected array for '%s'", lastName());
+			}
+			frame.cursor = npos;
+			size = 0;
+		}
+		else {
+			frame.cursor = pos + 1;
+			size = countArrayElements(pos);
+		}
+		stack.push_back(frame);
+	}
+
+	virtual void endArray() override {
+		endFrame(']');
+	}
+
+	virtual void propertyName(const char * fieldName) override {
+		propName = fieldName;
+	}
+
+	virtual void value(Uint32& value) override {
+		size_t pos = GetCurrentValue();
+		if (!isNumber(pos)) {
+			return;
+		}
+		value = (Uint32)strtoul(&data[pos], nullptr, 10);
+		consumed(pos, skipValue(pos));
+	}
+	virtual void value(Sint32& value) override {
+		size_t pos = GetCurrentValue();
+		if (!isNumber(pos)) {
+			return;
+		}
+		value = (Sint32)strtol(&data[pos], nullptr, 10);
+		consumed(pos, skipValue(pos));
+	}
+	virtual void value(float& value) override {
+		size_t pos = GetCurrentValue();
+		if (!isNumber(pos)) {
+			return;
+		}
+		value = strtof(&data[pos], nullptr);
+		consumed(pos, skipValue(pos));
+	}
+	virtual void value(double& value) override {
+		size_t pos = GetCurrentValue();
+		if (!isNumber(pos)) {
+			return;
+		}
+		value = strtod(&data[pos], nullptr);
+		consumed(pos, skipValue(pos));
+	}
+	virtual void value(bool& value) override {
+		size_t pos = GetCurrentValue();
+		if (pos == npos) {
+			return;
+		}
+		if (!strncmp(&data[pos], "true", 4)) {
+			value = true;
+			consumed(pos, pos + 4);
+		}
+		else if (!strncmp(&data[pos], "false", 5)) {
+			value = false;
+			consumed(pos, pos + 5);
+		}
+		else {
+			printlog("JsonStreamReader: expected bool for '%s'", lastName());
+		}
+	}
+	virtual void value(std::string& value, Uint32 maxLength) override {
+		size_t pos = GetCurrentValue();
+		if (pos == npos) {
+			return;
+		}
+		if (data[pos] != '"') {
+			printlog("JsonStreamReader: expected string for '%s'", lastName());
+			return;
+		}
+		size_t end = skipString(pos);
+		if (failed()) {
+			return;
+		}
+		readString(pos, value);
+		assert(maxLength == 0 || value.size() <= maxLength);
+		consumed(pos, end);
+	}
+
+protected:
+
+	static const size_t npos = std::string::npos;
+
+	struct Member {
+		size_t key;			// offset of the first character of the key, after the opening quote
+		size_t keyLength;	// raw length of the key, escapes included
+		size_t value;		// offset of the member's value
+	};
+
+	struct Frame {
+		size_t start;		// offset of the opening bracket
+		size_t cursor;		// offset of the next unread member or element
+		size_t pending = npos;	// offset of a handed out value that has not been consumed yet
+		bool isArray;
+		std::vector<Member> skipped; // members passed over while searching for a later key
+	};
+
+	bool readAllFileData(File * fp) {
+		return ::readAllFileData(fp, data, "JsonStreamReader");
+	}
+
+	// offset of the null terminator after the file data
+	size_t end() const {
+		return data.size() - 1;
+	}
+
+	bool failed() const {
+		return error != npos;
+	}
+
+	// records the first syntax error. every scan stops at the null terminator,
+	// so returning end() unwinds whatever was in progress
+	// @return end()
+	size_t fail(size_t pos, const char * what) {
+		if (error == npos) {
+			error = pos;
+			printlog("JsonStreamReader: parse error: %s (%d)", what, (int)pos);
+		}
+		return end();
+	}
+
+	const char * lastName() const {
+		return propName ? propName : "";
+	}
+
+	bool isNumber(size_t pos) const {
+		if (pos == npos) {
 			return false;
 		}
+		if (!(data[pos] == '-' || (data[pos] >= '0' && data[pos] <= '9'))) {
+			printlog("JsonStreamReader: expected number for '%s'", lastName());
+			return false;
+		}
+		return true;
+	}
+
+	size_t skipWhitespace(size_t pos) const {
+		while (data[pos] == ' ' || data[pos] == '\t' || data[pos] == '\n' || data[pos] == '\r') {
+			++pos;
+		}
+		return pos;
+	}
+
+	// @return offset just past the closing quote of the string starting at pos
+	size_t skipString(size_t pos) {
+		for (++pos; data[pos] != '"'; ++pos) {
+			if ((unsigned char)data[pos] < 0x20) {
+				return fail(pos, data[pos] ? "invalid character in string" : "missing closing quote");
+			}
+			if (data[pos] != '\\') {
+				continue;
+			}
+			++pos;
+			if (data[pos] == 'u') {
+				for (int c = 1; c <= 4; ++c) {
+					if (!isxdigit((unsigned char)data[pos + c])) {
+						return fail(pos + c, "invalid unicode escape");
+					}
+				}
+				pos += 4;
+			}
+			else if (!data[pos] || !strchr("\"\\/bfnrt", data[pos])) {
+				return fail(pos, "invalid escape");
+			}
+		}
+		return pos + 1;
+	}
 
+	size_t skipDigits(size_t pos) const {
+		while (data[pos] >= '0' && data[pos] <= '9') {
+			++pos;
+		}
+		return pos;
+	}
+
+	// @return offset just past the number starting at pos
+	size_t skipNumber(size_t pos) {
+		if (data[pos] == '-') {
+			++pos;
+		}
+		if (data[pos] == '0') {
+			++pos;
+		}
+		else if (data[pos] >= '1' && data[pos] <= '9') {
+			pos = skipDigits(pos);
+		}
+		else {
+			return fail(pos, "invalid value");
+		}
+		if (data[pos] == '.') {
+			size_t digits = pos + 1;
+			pos = skipDigits(digits);
+			if (pos == digits) {
+				return fail(pos, "missing fraction digits");
+			}
+		}
+		if (data[pos] == 'e' || data[pos] == 'E') {
+			++pos;
+			if (data[pos] == '+' || data[pos] == '-') {
+				++pos;
+			}
+			size_t digits = pos;
+			pos = skipDigits(digits);
+			if (pos == digits) {
+				return fail(pos, "missing exponent digits");
+			}
+		}
+		return pos;
+	}
+
+	// reads the key of the member starting at pos
+	// @return false on a syntax error
+	bool readMember(size_t pos, Member & member) {
+		if (data[pos] != '"') {
+			fail(pos, "expected a property name");
+			return false;
+		}
+		member.key = pos + 1;
+		pos = skipString(pos);
+		if (failed()) {
+			return false;
+		}
+		member.keyLength = pos - 1 - member.key;
+		pos = skipWhitespace(pos);
+		if (data[pos] != ':') {
+			fail(pos, "expected ':' after a property name");
+			return false;
+		}
+		member.value = skipWhitespace(pos + 1);
 		return true;
 	}
 
-	struct DocIterator {
-		rapidjson::Value::ConstValueIterator it;
-		Uint32 index;
-	};
+	// steps from the end of the previous member or element (or from the opening bracket at start) to the next one
+	// @return offset of the next member or element, npos at the closing bracket or after a syntax error
+	size_t nextEntry(size_t start, size_t cursor, char close) {
+		if (failed()) {
+			return npos;
+		}
+		size_t pos = skipWhitespace(cursor);
+		if (data[pos] == close) {
+			return npos;
+		}
+		if (cursor != start + 1) {
+			if (data[pos] != ',') {
+				fail(pos, "missing a comma or closing bracket");
+				return npos;
+			}
+			pos = skipWhitespace(pos + 1);
+			if (data[pos] == close) {
+				fail(pos, "trailing comma");
+				return npos;
+			}
+		}
+		return pos;
+	}
 
-	rapidjson::Document doc;
+	// @return offset just past the end of the value starting at pos
+	size_t skipValue(size_t pos) {
+		if (data[pos] == '"') {
+			return skipString(pos);
+		}
+		if (data[pos] == '{' || data[pos] == '[') {
+			const char close = data[pos] == '{' ? '}' : ']';
+			const size_t start = pos;
+			size_t cursor = start + 1;
+			while ((pos = nextEntry(start, cursor, close)) != npos) {
+				if (close == '}') {
+					Member member;
+					if (!readMember(pos, member)) {
+						break;
+					}
+					pos = member.value;
+				}
+				cursor = skipValue(pos);
+			}
+			return failed() ? end() : skipWhitespace(cursor) + 1;
+		}
+		if (!strncmp(&data[pos], "true", 4) || !strncmp(&data[pos], "null", 4)) {
+			return pos + 4;
+		}
+		if (!strncmp(&data[pos], "false", 5)) {
+			return pos + 5;
+		}
+		return skipNumber(pos);
+	}
+
+	// @return number of elements in the array whose opening bracket is at start
+	Uint32 countArrayElements(size_t start) {
+		Uint32 count = 0;
+		size_t cursor = start + 1;
+		size_t pos;
+		while ((pos = nextEntry(start, cursor, ']')) != npos) {
+			cursor = skipValue(pos);
+			++count;
+		}
+		return count;
+	}
+
+	static void appendUtf8(std::string & out, Uint32 codepoint) {
+		if (codepoint < 0x80) {
+			out += (char)codepoint;
+		}
+		else if (codepoint < 0x800) {
+			out += (char)(0xC0 | (codepoint >> 6));
+			out += (char)(0x80 | (codepoint & 0x3F));
+		}
+		else if (codepoint < 0x10000) {
+			out += (char)(0xE0 | (codepoint >> 12));
+			out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+			out += (char)(0x80 | (codepoint & 0x3F));
+		}
+		else {
+			out += (char)(0xF0 | (codepoint >> 18));
+			out += (char)(0x80 | ((codepoint >> 12) & 0x3F));
+			out += (char)(0x80 | ((codepoint >> 6) & 0x3F));
+			out += (char)(0x80 | (codepoint & 0x3F));
+		}
+	}
+
+	Uint32 readHex4(size_t pos) const {
+		char hex[5] = { data[pos], data[pos + 1], data[pos + 2], data[pos + 3], 0 };
+		return (Uint32)strtoul(hex, nullptr, 16);
+	}
+
+	// decodes the string starting at pos (on the opening quote) into out
+	// @return offset just past the closing quote
+	size_t readString(size_t pos, std::string & out) const {
+		out.clear();
+		size_t run = ++pos;
+		for (; data[pos] != '"'; ++pos) {
+			if (data[pos] != '\\') {
+				continue;
+			}
+			out.append(&data[run], pos - run);
+			++pos;
+			switch (data[pos]) {
+				case 'b': out += '\b'; break;
+				case 'f': out += '\f'; break;
+				case 'n': out += '\n'; break;
+				case 'r': out += '\r'; break;
+				case 't': out += '\t'; break;
+				case 'u': {
+					Uint32 codepoint = readHex4(pos + 1);
+					pos += 4;
+					if (codepoint >= 0xD800 && codepoint <= 0xDBFF && data[pos + 1] == '\\' && data[pos + 2] == 'u') {
+						Uint32 low = readHex4(pos + 3);
+						codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+						pos += 6;
+					}
+					appendUtf8(out, codepoint);
+					break;
+				}
+				default: out += data[pos]; break;
+			}
+			run = pos + 1;
+		}
+		out.append(&data[run], pos - run);
+		return pos + 1;
+	}
+
+	bool keyEquals(const Member & member, const char * name) const {
+		const char * key = &data[member.key];
+		if (!memchr(key, '\\', member.keyLength)) {
+			return strlen(name) == member.keyLength && !strncmp(key, name, member.keyLength);
+		}
+		std::string decoded;
+		readString(member.key - 1, decoded);
+		return decoded == name;
+	}
+
+	// marks a handed out value as read, so its parent can continue scanning after it
+	void consumed(size_t start, size_t end) {
+		if (stack.empty()) {
+			return;
+		}
+		Frame & frame = stack.back();
+		if (frame.pending == start) {
+			frame.cursor = end;
+			frame.pending = npos;
+		}
+	}
+
+	// skips past a value that was handed out but never read
+	void skipPending(Frame & frame) {
+		if (frame.pending != npos) {
+			frame.cursor = skipValue(frame.pending);
+			frame.pending = npos;
+		}
+	}
+
+	void endFrame(char close) {
+		Frame & frame = stack.back();
+		size_t start = frame.start;
+		size_t end = npos;
+		if (frame.cursor != npos) {
+			skipPending(frame);
+			// skip any members or elements the serializer didn't ask for
+			size_t pos;
+			while ((pos = nextEntry(frame.start, frame.cursor, close)) != npos) {
+				if (close == '}') {
+					Member member;
+					if (!readMember(pos, member)) {
+						break;
+					}
+					pos = member.value;
+				}
+				frame.cursor = skipValue(pos);
+			}
+			if (!failed()) {
+				end = skipWhitespace(frame.cursor) + 1;
+			}
+		}
+		stack.pop_back();
+		if (stack.empty()) {
+			rootEnd = end;
+		}
+		else if (end != npos) {
+			consumed(start, end);
+		}
+	}
+
+	size_t GetCurrentValue() {
+		if (stack.empty()) {
+			assert(propName == nullptr);
+			return skipWhitespace(0);
+		}
+
+		Frame & frame = stack.back();
+		if (frame.cursor == npos) {
+			return npos;
+		}
+
+		if (frame.isArray) {
+			skipPending(frame);
+			size_t pos = nextEntry(frame.start, frame.cursor, ']');
+			if (pos == npos) {
+				return npos;
+			}
+			frame.cursor = pos;
+			frame.pending = pos;
+			return pos;
+		}
+
+		assert(propName != nullptr);
+		const char * name = propName;
+
+		// members we already walked past
+		for (auto it = frame.skipped.begin(); it != frame.skipped.end(); ++it) {
+			if (keyEquals(*it, name)) {
+				size_t result = it->value;
+				frame.skipped.erase(it);
+				return result;
+			}
+		}
+
+		// walk forward to the requested member, remembering the ones in between
+		skipPending(frame);
+		for (;;) {
+			size_t pos = nextEntry(frame.start, frame.cursor, '}');
+			Member member;
+			if (pos == npos || !readMember(pos, member)) {
+				if (!failed()) {
+					printlog("JsonStreamReader: property '%s' not found", name);
+				}
+				return npos;
+			}
+			if (keyEquals(member, name)) {
+				frame.cursor = member.value;
+				frame.pending = member.value;
+				return member.value;
+			}
+			frame.skipped.push_back(member);
+			frame.cursor = skipValue(member.value);
+		}
+	}
+
+	std::vector<char> data;
 	const char * propName = nullptr;
-	std::vector<DocIterator> stack;
+	std::vector<Frame> stack;
+	size_t error = npos;	// offset of the first syntax error
+	size_t rootEnd = npos;	// offset just past the root object's closing bracket
 };
 
 class BinaryFileWriter : public FileInterface {
@@ -307,6 +870,8 @@ private:
 	File* fp = nullptr;
 };
 
+// Reads the whole file up front, so each value is a bounds checked copy out of memory
+// rather than a call into the file layer per field.
 class BinaryFileReader : public FileInterface {
 public:
 
@@ -318,6 +883,11 @@ public:
 	static bool readObject(File * fp, const FileHelper::SerializationFunc & serialize) {
 		BinaryFileReader bfr(fp);
 
+		if (!::readAllFileData(fp, bfr.data, "BinaryFileReader")) {
+			return false;
+		}
+		bfr.data.pop_back(); // null terminator is not part of the binary stream
+
 		if (!bfr.readHeader()) {
 			return false;
 		}
@@ -326,7 +896,7 @@ public:
 		serialize(&bfr);
 		bfr.endObject();
 
-		return true;
+		return !bfr.overrun;
 	}
 
 	virtual bool isReading() const override { return true; }
@@ -338,8 +908,9 @@ public:
 	}
 
 	virtual void beginArray(Uint32 & size) override {
-		size_t read = fp->read(&size, sizeof(size), 1);
-		assert(read == 1);
+		if (!readRaw(&size, sizeof(size))) {
+			size = 0;
+		}
 	}
 
 	virtual void endArray() override {
@@ -349,24 +920,19 @@ public:
 	}
 
 	virtual void value(Uint32& v) override {
-		size_t read = fp->read(&v, sizeof(v), 1);
-		assert(read == 1);
+		readRaw(&v, sizeof(v));
 	}
 	virtual void value(Sint32& v) override {
-		size_t read = fp->read(&v, sizeof(v), 1);
-		assert(read == 1);
+		readRaw(&v, sizeof(v));
 	}
 	virtual void value(float& v) override {
-		size_t read = fp->read(&v, sizeof(v), 1);
-		assert(read == 1);
+		readRaw(&v, sizeof(v));
 	}
 	virtual void value(double& v) override {
-		size_t read = fp->read(&v, sizeof(v), 1);
-		assert(read == 1);
+		readRaw(&v, sizeof(v));
 	}
 	virtual void value(bool& v) override {
-		size_t read = fp->read(&v, sizeof(v), 1);
-		assert(read == 1);
+		readRaw(&v, sizeof(v));
 	}
 	virtual void value(std::string& v, Uint32 maxLength) override {
 		readStringInternal(v);
@@ -375,10 +941,22 @@ public:
 
 private:
 
+	bool readRaw(void * dest, size_t size) {
+		if (cursor + size > data.size()) {
+			if (!overrun) {
+				printlog("BinaryFileReader: unexpected end of file at offset %u", (Uint32)cursor);
+			}
+			overrun = true;
+			return false;
+		}
+		memcpy(dest, &data[cursor], size);
+		cursor += size;
+		return true;
+	}
+
 	bool readHeader() {
 		Uint32 fileFormatTag;
-		size_t read = fp->read(&fileFormatTag, sizeof(fileFormatTag), 1);
-		if (read != 1) {
+		if (!readRaw(&fileFormatTag, sizeof(fileFormatTag))) {
 			printlog("BinaryFileReader: failed to read format tag (%d)", errno);
 			return false;
 		}
@@ -392,18 +970,23 @@ private:
 	}
 
 	void readStringInternal(std::string & v) {
-		Uint32 len;
-		size_t read = fp->read(&len, sizeof(len), 1);
-		assert(read == 1);
+		Uint32 len = 0;
+		if (!readRaw(&len, sizeof(len))) {
+			return;
+		}
 
-		if (len) {
-			v.reserve(len);
-			read = fp->read(&v[0u], sizeof(char), len);
-			assert(read == len);
+		if (cursor + len > data.size()) {
+			readRaw(nullptr, len); // flag the overrun
+			return;
 		}
+		v.assign(&data[cursor], len);
+		cursor += len;
 	}
 
 	File* fp;
+	std::vector<char> data;
+	size_t cursor = 0;
+	bool overrun = false;
 };
 
 static EFileFormat GetFileFormat(File * file) {
@@ -463,7 +1046,12 @@ bool FileHelper::readObjectInternal(const char * filename, const SerializationFu
 		success = BinaryFileReader::readObject(file, serialize);
 	}
 	else if(format == EFileFormat::Json) {
-		success = JsonFileReader::readObject(file, serialize);
+		if (streamingJsonReader) {
+			success = JsonStreamReader::readObject(file, serialize);
+		}
+		else {
+			success = JsonFileReader::readObject(file, serialize);
+		}
 	}
 	else {
 		assert(false);
@@ -473,3 +1061,205 @@ bool FileHelper::readObjectInternal(const char * filename, const SerializationFu
 
 	return success;
 }
+
+// Synthetic document shaped like the larger config files (gameplay modifiers, account data),
+// used to compare the readers against each other.
+struct FileHelperBenchmarkData {
+	struct Entry {
+		std::string name;
+		Sint32 value = 0;
+		Uint32 flags = 0;
+		float scale = 0.f;
+		double weight = 0.0;
+		bool enabled = false;
+		std::vector<Uint32> tags;
+
+		void serialize(FileInterface * file) {
+			file->property("name", name);
+			file->property("value", value);
+			file->property("flags", flags);
+			file->property("scale", scale);
+			file->property("weight", weight);
+			file->property("enabled", enabled);
+			file->property("tags", tags);
+		}
+	};
+
+	Sint32 version = 0;
+	std::vector<Entry> entries;
+
+	void serialize(FileInterface * file) {
+		file->property("version", version);
+		file->property("entries", entries);
+	}
+
+	Uint32 checksum() const {
+		Uint32 sum = (Uint32)version;
+		for (auto& entry : entries) {
+			sum = sum * 31 + (Uint32)entry.name.size() + (Uint32)entry.value + entry.flags + (Uint32)entry.tags.size();
+		}
+		return sum;
+	}
+};
+
+static Uint32 benchmarkHash(Uint32 sum, const std::string & str) {
+	for (char c : str) {
+		sum = sum * 31 + (Uint8)c;
+	}
+	return sum;
+}
+
+// Mirrors the layout of data/eos.json, as read by EOSFuncs::serialize()
+struct FileHelperBenchmarkAccount {
+	Sint32 version = 0;
+	std::string credentialHost;
+	std::string credentialName;
+
+	void serialize(FileInterface * file) {
+		file->property("version", version);
+		file->property("credentialhost", credentialHost);
+		file->property("credentialname", credentialName);
+	}
+
+	Uint32 checksum() const {
+		return benchmarkHash(benchmarkHash((Uint32)version, credentialHost), credentialName);
+	}
+};
+
+// Mirrors the settings in data/gameplaymodifiers.json that GameplayCustomManager::readFromFile() reads.
+// map_generation is keyed by level name, which FileInterface has no way to enumerate, so it is left
+// for the readers to skip over.
+struct FileHelperBenchmarkModifiers {
+	struct Floors {
+		std::vector<Sint32> normalFloors;
+		std::vector<Sint32> secretFloors;
+
+		void serialize(FileInterface * file) {
+			file->property("normal_floors", normalFloors);
+			file->property("secret_floors", secretFloors);
+		}
+	};
+
+	Sint32 version = 0;
+	Sint32 xpShareRange = 0;
+	Sint32 globalXPPercent = 0;
+	Sint32 globalGoldPercent = 0;
+	bool minimapShareProgress = false;
+	Sint32 playerWeightPercent = 0;
+	double playerSpeedMax = 0.0;
+	Floors minotaurForceDisableFloors;
+	Floors minotaurForceEnableFloors;
+	Floors hungerDisableFloors;
+	Floors herxChatterDisableFloors;
+	Floors minimapDisableFloors;
+
+	void serialize(FileInterface * file) {
+		file->property("version", version);
+		file->property("xp_share_range", xpShareRange);
+		file->property("global_xp_award_percent", globalXPPercent);
+		file->property("global_gold_drop_scale_percent", globalGoldPercent);
+		file->property("player_share_minimap_progress", minimapShareProgress);
+		file->property("player_speed_weight_impact_percent", playerWeightPercent);
+		file->property("player_speed_max", playerSpeedMax);
+		file->property("minotaur_force_disable_on_floors", minotaurForceDisableFloors);
+		file->property("minotaur_force_enable_on_floors", minotaurForceEnableFloors);
+		file->property("disable_hunger_on_floors", hungerDisableFloors);
+		file->property("disable_herx_messages_on_floors", herxChatterDisableFloors);
+		file->property("disable_minimap_on_floors", minimapDisableFloors);
+	}
+
+	Uint32 checksum() const {
+		Uint32 sum = (Uint32)version;
+		sum = sum * 31 + (Uint32)xpShareRange;
+		sum = sum * 31 + (Uint32)globalXPPercent;
+		sum = sum * 31 + (Uint32)globalGoldPercent;
+		sum = sum * 31 + (minimapShareProgress ? 1 : 0);
+		sum = sum * 31 + (Uint32)playerWeightPercent;
+		sum = sum * 31 + (Uint32)(playerSpeedMax * 1000.0);
+		const Floors * floors[] = { &minotaurForceDisableFloors, &minotaurForceEnableFloors,
+			&hungerDisableFloors, &herxChatterDisableFloors, &minimapDisableFloors };
+		for (auto list : floors) {
+			for (auto floor : list->normalFloors) {
+				sum = sum * 31 + (Uint32)floor;
+			}
+			for (auto floor : list->secretFloors) {
+				sum = sum * 37 + (Uint32)floor;
+			}
+		}
+		return sum;
+	}
+};
+
+template<typename T>
+static double benchmarkRead(const char * filename, int iterations, bool streaming, Uint32 & checksum) {
+	bool oldStreaming = FileHelper::streamingJsonReader;
+	FileHelper::streamingJsonReader = streaming;
+	checksum = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		T data;
+		if (!FileHelper::readObject(filename, data)) {
+			checksum = 0;
+			break;
+		}
+		checksum = data.checksum();
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+	FileHelper::streamingJsonReader = oldStreaming;
+	return std::chrono::duration<double, std::milli>(end - start).count() / std::max(iterations, 1);
+}
+
+// times the dom and streaming readers on one of the game's own json files, if it exists
+template<typename T>
+static void benchmarkDataFile(const char * file, int iterations) {
+	if (!PHYSFS_getRealDir(file)) {
+		printlog("[JSON]: %s not found, skipped", file);
+		return;
+	}
+	std::string path = PHYSFS_getRealDir(file);
+	path.append(file);
+	Uint32 domSum = 0, streamSum = 0;
+	double domTime = benchmarkRead<T>(path.c_str(), iterations, false, domSum);
+	double streamTime = benchmarkRead<T>(path.c_str(), iterations, true, streamSum);
+	printlog("[JSON]: %s dom: %.3f ms/read, stream: %.3f ms/read%s", file, domTime, streamTime,
+		streamSum == domSum ? "" : " (MISMATCH)");
+}
+
+void FileHelper::benchmark(int iterations) {
+	const int numEntries = 2000;
+	FileHelperBenchmarkData source;
+	source.version = 1;
+	source.entries.resize(numEntries);
+	for (int i = 0; i < numEntries; ++i) {
+		auto& entry = source.entries[i];
+		entry.name = "entry_" + std::to_string(i);
+		entry.value = i * 7 - 500;
+		entry.flags = (Uint32)i * 2654435761u;
+		entry.scale = i * 0.25f;
+		entry.weight = i / 3.0;
+		entry.enabled = (i % 3) == 0;
+		entry.tags.resize(i % 8, (Uint32)i);
+	}
+
+	std::string jsonPath = outputdir;
+	jsonPath.append("/data/filehelper_benchmark.json");
+	std::string binaryPath = outputdir;
+	binaryPath.append("/data/filehelper_benchmark.bin");
+	if (!writeObject(jsonPath.c_str(), EFileFormat::Json, source)
+		|| !writeObject(binaryPath.c_str(), EFileFormat::Binary, source)) {
+		printlog("[JSON]: benchmark failed to write sample files");
+		return;
+	}
+
+	Uint32 domSum = 0, streamSum = 0, binarySum = 0;
+	double domTime = benchmarkRead<FileHelperBenchmarkData>(jsonPath.c_str(), iterations, false, domSum);
+	double streamTime = benchmarkRead<FileHelperBenchmarkData>(jsonPath.c_str(), iterations, true, streamSum);
+	double binaryTime = benchmarkRead<FileHelperBenchmarkData>(binaryPath.c_str(), iterations, true, binarySum);
+	printlog("[JSON]: benchmark %d entries x %d reads", numEntries, iterations);
+	printlog("[JSON]: dom json: %.3f ms/read", domTime);
+	printlog("[JSON]: stream json: %.3f ms/read%s", streamTime, streamSum == domSum ? "" : " (MISMATCH)");
+	printlog("[JSON]: binary: %.3f ms/read%s", binaryTime, binarySum == source.checksum() ? "" : " (MISMATCH)");
+
+	benchmarkDataFile<FileHelperBenchmarkAccount>("/data/eos.json", iterations);
+	benchmarkDataFile<FileHelperBenchmarkModifiers>("/data/gameplaymodifiers.json", iterations);
+}
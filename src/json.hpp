@@ -156,6 +156,13 @@ public:
 
 	typedef std::function<void(FileInterface*)> SerializationFunc;
 
+	// Writes a generated document in json and binary form, then times repeated reads through each reader
+	// @param iterations number of reads per reader
+	static void benchmark(int iterations);
+
+	// true to read json by scanning the file directly, false to parse it into a rapidjson DOM first
+	static bool streamingJsonReader;
+
 private:
 
 	static bool writeObjectInternal(const char * filename, EFileFormat format, const SerializationFunc& serialize);
@@ -0,0 +1,365 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: language_table.cpp
+Desc: compiles language files into binary string tables and maps them
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "files.hpp"
+#include "language_table.hpp"
+
+#if !defined(WINDOWS) && !defined(NINTENDO)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+LanguageTable languageTable;
+const Uint32 LanguageTable::kVersion;
+
+/*-------------------------------------------------------------------------------
+
+	LanguageTable::parse
+
+	reads a language file in the lang/<code>.txt format: one "<number> <text>"
+	entry per line, with blank lines and lines starting with # skipped
+
+-------------------------------------------------------------------------------*/
+
+bool LanguageTable::parse(const char* txtPath, std::vector<std::string>& entries, int maxEntries)
+{
+	File* fp = openDataFile(txtPath, "r");
+	if ( !fp )
+	{
+		return false;
+	}
+	entries.clear();
+	entries.resize(maxEntries);
+
+	Uint32 line;
+	for ( line = 1; !fp->eof(); )
+	{
+		char data[1024];
+		int entry = maxEntries;
+
+		// read line from file
+		int i;
+		bool fileEnd = false;
+		for ( i = 0; ; i++ )
+		{
+			data[i] = fp->getc();
+			if ( fp->eof() )
+			{
+				fileEnd = true;
+				break;
+			}
+
+			// blank or comment lines stop reading at a newline
+			if ( data[i] == '\n' )
+			{
+				line++;
+				if (data[0] == '\r' || data[0] == '\n' || data[0] == '#')
+				{
+					break;
+				}
+			}
+			if (data[i] == '#')
+			{
+				if (data[0] != '\n' && data[0] != '\r' && data[0] != '#')
+				{
+					break;
+				}
+			}
+		}
+		if ( fileEnd )
+		{
+			break;
+		}
+
+		// skip blank and comment lines
+		if ( data[0] == '\r' || data[0] == '\n' || data[0] == '#' )
+		{
+			continue;
+		}
+
+		data[i] = 0;
+
+		// process line
+		if ( (entry = atoi(data)) == 0 )
+		{
+			printlog( "warning: syntax error in '%s':%d\n bad syntax!\n", txtPath, line);
+			continue;
+		}
+		else if ( entry >= maxEntries || entry < 0 )
+		{
+			printlog( "warning: syntax error in '%s':%d\n invalid language entry!\n", txtPath, line);
+			continue;
+		}
+		char entryText[16] = { 0 };
+		snprintf(entryText, 15, "%d", entry);
+		if ( !entries[entry].empty() )
+		{
+			printlog( "warning: duplicate entry %d in '%s':%d\n", entry, txtPath, line);
+		}
+		entries[entry] = (char*)(data + strlen(entryText) + 1);
+	}
+
+	FileIO::close(fp);
+	return true;
+}
+
+/*-------------------------------------------------------------------------------
+
+	LanguageTable::build / compile
+
+	lays out the header, offsets and blob. empty entries share offset 0
+
+-------------------------------------------------------------------------------*/
+
+std::vector<char> LanguageTable::build(const std::vector<std::string>& entries, Uint64 sourceSize, Sint64 sourceTime)
+{
+	std::vector<Uint32> offsets(entries.size(), 0);
+	std::string blob(1, '\0');
+	for ( size_t c = 0; c < entries.size(); ++c )
+	{
+		if ( entries[c].empty() )
+		{
+			continue;
+		}
+		offsets[c] = static_cast<Uint32>(blob.size());
+		blob.append(entries[c].c_str(), entries[c].size() + 1);
+	}
+
+	Header_t header;
+	memcpy(header.magic, "BLNG", 4);
+	header.version = kVersion;
+	header.numEntries = static_cast<Uint32>(entries.size());
+	header.blobSize = static_cast<Uint32>(blob.size());
+	header.sourceSize = sourceSize;
+	header.sourceTime = sourceTime;
+
+	std::vector<char> table(sizeof(Header_t) + offsets.size() * sizeof(Uint32) + blob.size());
+	char* out = table.data();
+	memcpy(out, &header, sizeof(Header_t));
+	out += sizeof(Header_t);
+	memcpy(out, offsets.data(), offsets.size() * sizeof(Uint32));
+	out += offsets.size() * sizeof(Uint32);
+	memcpy(out, blob.data(), blob.size());
+	return table;
+}
+
+bool LanguageTable::compile(const std::vector<std::string>& entries, const char* binPath, Uint64 sourceSize, Sint64 sourceTime)
+{
+	std::vector<char> table = build(entries, sourceSize, sourceTime);
+	FILE* fp = fopen(binPath, "wb");
+	if ( !fp )
+	{
+		return false;
+	}
+	bool written = fwrite(table.data(), 1, table.size(), fp) == table.size();
+	fclose(fp);
+	if ( !written )
+	{
+		remove(binPath);
+	}
+	return written;
+}
+
+/*-------------------------------------------------------------------------------
+
+	LanguageTable::load
+
+	maps a compiled table. the only work done on the contents is checking
+	the header and that every offset lands inside the blob
+
+-------------------------------------------------------------------------------*/
+
+bool LanguageTable::load(const char* binPath, Uint64 sourceSize, Sint64 sourceTime)
+{
+	unload();
+#ifdef WINDOWS
+	HANDLE file = CreateFileA(binPath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if ( file == INVALID_HANDLE_VALUE )
+	{
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if ( !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(Header_t) )
+	{
+		CloseHandle(file);
+		return false;
+	}
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if ( !mapping )
+	{
+		return false;
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+	CloseHandle(mapping); // the view keeps the mapping alive
+	if ( !view )
+	{
+		return false;
+	}
+	data = static_cast<char*>(view);
+	size = static_cast<size_t>(fileSize.QuadPart);
+	mapped = true;
+#elif !defined(NINTENDO)
+	int fd = open(binPath, O_RDONLY);
+	if ( fd < 0 )
+	{
+		return false;
+	}
+	struct stat info;
+	if ( fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(Header_t) )
+	{
+		close(fd);
+		return false;
+	}
+	void* view = mmap(nullptr, info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if ( view == MAP_FAILED )
+	{
+		return false;
+	}
+	data = static_cast<char*>(view);
+	size = static_cast<size_t>(info.st_size);
+	mapped = true;
+#else
+	FILE* fp = fopen(binPath, "rb");
+	if ( !fp )
+	{
+		return false;
+	}
+	fseek(fp, 0, SEEK_END);
+	long fileSize = ftell(fp);
+	fseek(fp, 0, SEEK_SET);
+	if ( fileSize < (long)sizeof(Header_t) )
+	{
+		fclose(fp);
+		return false;
+	}
+	owned.resize(fileSize);
+	bool read = fread(owned.data(), 1, owned.size(), fp) == owned.size();
+	fclose(fp);
+	if ( !read )
+	{
+		owned.clear();
+		return false;
+	}
+	data = owned.data();
+	size = owned.size();
+#endif
+
+	if ( !validate(sourceSize, sourceTime, true) )
+	{
+		unload();
+		return false;
+	}
+	return true;
+}
+
+bool LanguageTable::load(std::vector<char>&& table)
+{
+	unload();
+	owned = std::move(table);
+	data = owned.data();
+	size = owned.size();
+	if ( size < sizeof(Header_t) || !validate(0, 0, false) )
+	{
+		unload();
+		return false;
+	}
+	return true;
+}
+
+bool LanguageTable::validate(Uint64 sourceSize, Sint64 sourceTime, bool checkSource) const
+{
+	const Header_t* header = reinterpret_cast<const Header_t*>(data);
+	if ( memcmp(header->magic, "BLNG", 4) || header->version != kVersion )
+	{
+		return false;
+	}
+	if ( checkSource && (header->sourceSize != sourceSize || header->sourceTime != sourceTime) )
+	{
+		return false;
+	}
+	const size_t expected = sizeof(Header_t) + static_cast<size_t>(header->numEntries) * sizeof(Uint32) + header->blobSize;
+	if ( expected != size || header->blobSize == 0 )
+	{
+		return false;
+	}
+	const Uint32* offsets = reinterpret_cast<const Uint32*>(data + sizeof(Header_t));
+	const char* blob = data + sizeof(Header_t) + header->numEntries * sizeof(Uint32);
+	if ( blob[header->blobSize - 1] != '\0' )
+	{
+		return false;
+	}
+	for ( Uint32 c = 0; c < header->numEntries; ++c )
+	{
+		if ( offsets[c] >= header->blobSize )
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void LanguageTable::unload()
+{
+	if ( data && mapped )
+	{
+#ifdef WINDOWS
+		UnmapViewOfFile(data);
+#elif !defined(NINTENDO)
+		munmap(data, size);
+#endif
+	}
+	data = nullptr;
+	size = 0;
+	mapped = false;
+	owned.clear();
+	owned.shrink_to_fit();
+}
+
+void LanguageTable::swap(LanguageTable& other)
+{
+	std::swap(data, other.data);
+	std::swap(size, other.size);
+	std::swap(mapped, other.mapped);
+	owned.swap(other.owned); // vector storage doesn't move, so data stays valid
+}
+
+Uint32 LanguageTable::entries() const
+{
+	return data ? reinterpret_cast<const Header_t*>(data)->numEntries : 0;
+}
+
+/*-------------------------------------------------------------------------------
+
+	LanguageTable::fill
+
+	points each string at its entry. entries past the end of the table get
+	the empty string at the start of the blob
+
+-------------------------------------------------------------------------------*/
+
+void LanguageTable::fill(char** strings, int numStrings) const
+{
+	if ( !data )
+	{
+		return;
+	}
+	const Uint32 numEntries = entries();
+	const Uint32* offsets = reinterpret_cast<const Uint32*>(data + sizeof(Header_t));
+	char* blob = data + sizeof(Header_t) + numEntries * sizeof(Uint32);
+	for ( int c = 0; c < numStrings; ++c )
+	{
+		strings[c] = blob + (static_cast<Uint32>(c) < numEntries ? offsets[c] : 0);
+	}
+}
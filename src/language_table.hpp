@@ -0,0 +1,81 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: language_table.hpp
+Desc: header for language_table.cpp (compiled language files)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*-------------------------------------------------------------------------------
+
+	LanguageTable
+
+	a lang/<code>.txt compiled into one binary file:
+
+		Header_t
+		Uint32 offsets[numEntries], into the blob
+		the blob: each entry's utf8 text, nul terminated. offset 0 is ""
+
+	load() maps the file and fill() points language[] straight into the
+	blob, so loading a language reads no text and allocates no strings. the
+	mapping is private (copy on write) in case anything writes through
+	language[]. loadLanguage() compiles the table into outputdir whenever
+	it's missing or the .txt it came from has changed size or timestamp.
+
+-------------------------------------------------------------------------------*/
+
+class LanguageTable
+{
+public:
+	LanguageTable() = default;
+	LanguageTable(const LanguageTable&) = delete;
+	LanguageTable& operator=(const LanguageTable&) = delete;
+	~LanguageTable() { unload(); }
+
+	// reads a language .txt into entries (indexed by entry number)
+	static bool parse(const char* txtPath, std::vector<std::string>& entries, int maxEntries);
+
+	// builds the binary table for entries. compile() also writes it to binPath
+	static std::vector<char> build(const std::vector<std::string>& entries, Uint64 sourceSize, Sint64 sourceTime);
+	static bool compile(const std::vector<std::string>& entries, const char* binPath, Uint64 sourceSize, Sint64 sourceTime);
+
+	// fails if the file is missing, malformed or wasn't built from this source
+	bool load(const char* binPath, Uint64 sourceSize, Sint64 sourceTime);
+	// takes a table from build(), for when the compiled file can't be written
+	bool load(std::vector<char>&& table);
+	void unload();
+	void swap(LanguageTable& other);
+
+	void fill(char** strings, int numStrings) const;
+	bool loaded() const { return data != nullptr; }
+	bool isMapped() const { return mapped; }
+	Uint32 entries() const;
+	size_t bytes() const { return size; }
+private:
+	struct Header_t
+	{
+		char magic[4];
+		Uint32 version;
+		Uint32 numEntries;
+		Uint32 blobSize;
+		Uint64 sourceSize;
+		Sint64 sourceTime;
+	};
+	static const Uint32 kVersion = 1;
+
+	char* data = nullptr;
+	size_t size = 0;
+	bool mapped = false; // otherwise data is in owned
+	std::vector<char> owned;
+
+	bool validate(Uint64 sourceSize, Sint64 sourceTime, bool checkSource) const;
+};
+extern LanguageTable languageTable;
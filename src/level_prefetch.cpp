@@ -0,0 +1,544 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: level_prefetch.cpp
+Desc: builds the next floor in the background
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "game.hpp"
+#include "files.hpp"
+#include "level_prefetch.hpp"
+#ifndef EDITOR
+#include "entity.hpp"
+#include "items.hpp"
+#include "monster.hpp"
+#include "net.hpp"
+#include "scores.hpp"
+#include "mod_tools.hpp"
+#endif
+
+LevelPrefetchHandler LevelPrefetch;
+const size_t LevelPrefetchHandler::kChunkSize;
+
+#ifndef EDITOR
+StagedLevel_t::StagedLevel_t()
+{
+	memset(&entities, 0, sizeof(list_t));
+	memset(&creatures, 0, sizeof(list_t));
+	memset(map.name, 0, sizeof(map.name));
+	memset(map.author, 0, sizeof(map.author));
+	memset(map.flags, 0, sizeof(map.flags));
+	map.width = 0;
+	map.height = 0;
+	map.skybox = 0;
+	map.tiles = nullptr;
+	map.entities = &entities;
+	map.creatures = &creatures;
+	map.worldUI = nullptr;
+}
+
+StagedLevel_t::~StagedLevel_t()
+{
+	// entities take themselves off the creature list as they go
+	list_FreeAll(&entities);
+	list_FreeAll(&creatures);
+	if ( map.tiles )
+	{
+		free(map.tiles);
+	}
+	if ( shoparea )
+	{
+		free(shoparea);
+	}
+}
+
+// moves every node of one list onto the end of another, elements and all
+static void moveNodes(list_t* from, list_t* to)
+{
+	if ( !from->first )
+	{
+		return;
+	}
+	for ( node_t* node = from->first; node != nullptr; node = node->next )
+	{
+		node->list = to;
+	}
+	if ( to->last )
+	{
+		to->last->next = from->first;
+		from->first->prev = to->last;
+	}
+	else
+	{
+		to->first = from->first;
+		to->count = 0;
+	}
+	to->last = from->last;
+	to->count += from->count;
+	++to->version;
+
+	from->first = nullptr;
+	from->last = nullptr;
+	from->count = 0;
+	++from->version;
+}
+
+void seedStatRolls(PrngStream_t& stream, Uint32 seed)
+{
+	const Uint32 key[2] = { seed, 0x53544154 }; // "STAT"
+	stream.seedBytes(key, sizeof(key));
+}
+
+StatRolls_t statRollsFrom(PrngStream_t& stream, const char* obituary)
+{
+	StatRolls_t rolls;
+	rolls.rng = [&stream]() { return static_cast<int>(stream.getUint() & RAND_MAX); };
+	rolls.obituary = obituary;
+	return rolls;
+}
+#endif
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::start
+
+	begins building the given floor on a worker thread, or just reading its
+	files where it can't be built ahead of time
+
+-------------------------------------------------------------------------------*/
+
+void LevelPrefetchHandler::start(int level, bool secret)
+{
+	cancel();
+
+	this->level = level;
+	this->secret = secret;
+	customMap = loadCustomNextMap;
+	filesRead = 0;
+	bytesRead = 0;
+	buildTicks = 0;
+	ticks = 0;
+	finished = false;
+	stopRequested = false;
+
+#ifndef EDITOR
+	if ( multiplayer != CLIENT )
+	{
+		seed = rand();
+		hasSeed = true;
+		if ( !gameplayCustomManager.inUse() )
+		{
+			staged = new StagedLevel_t();
+			staged->seed = seed;
+			staged->level = level;
+			staged->secret = secret;
+			staged->svFlags = svFlags;
+			staged->obituary = language[1500];
+			for ( int c = 0; c < MAXPLAYERS; ++c )
+			{
+				if ( !client_disconnected[c] )
+				{
+					++staged->players;
+				}
+			}
+		}
+	}
+#endif
+
+	thread = SDL_CreateThread(threadFunction, "levelPrefetch", static_cast<void*>(this));
+	if ( !thread )
+	{
+		printlog("[PREFETCH]: Warning - failed to create prefetch thread: %s", SDL_GetError());
+		discardStagedLevel();
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::cancel
+
+	stops the worker between files and waits for it, dropping any floor it
+	built. a floor being generated can't be stopped partway, so that waits
+	for generation to finish
+
+-------------------------------------------------------------------------------*/
+
+void LevelPrefetchHandler::cancel()
+{
+	wait();
+	discardStagedLevel();
+}
+
+void LevelPrefetchHandler::wait()
+{
+	if ( !thread )
+	{
+		return;
+	}
+	stopRequested = true;
+	SDL_WaitThread(thread, nullptr);
+	thread = nullptr;
+
+#ifndef EDITOR
+	if ( staged && staged->ready )
+	{
+		printlog("[PREFETCH]: built floor %d%s in %d ms", level, secret ? " (secret)" : "", static_cast<int>(buildTicks));
+	}
+#endif
+	printlog("[PREFETCH]: %s floor %d%s: %d files, %d KB in %d ms",
+		finished ? "prefetched" : "cancelled prefetch of",
+		level, secret ? " (secret)" : "",
+		filesRead, static_cast<int>(bytesRead / 1024), static_cast<int>(ticks));
+}
+
+void LevelPrefetchHandler::discardStagedLevel()
+{
+#ifndef EDITOR
+	if ( staged )
+	{
+		delete staged;
+		staged = nullptr;
+	}
+#endif
+}
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::applyStagedLevel
+
+	does what loadMap() and generateDungeon() would have done to the global
+	map and level state, from the floor the worker built. every floor must
+	have been built from the same line and seed, and a "gen:" floor for the
+	same floor, player count and server flags, or it's dropped
+
+-------------------------------------------------------------------------------*/
+
+bool LevelPrefetchHandler::applyStagedLevel(const std::string& line, Uint32 seed, int level, bool secret, int* checkMapHash, int& result)
+{
+#ifdef EDITOR
+	cancel();
+	return false;
+#else
+	wait();
+	if ( !staged )
+	{
+		return false;
+	}
+
+	int players = 0;
+	for ( int c = 0; c < MAXPLAYERS; ++c )
+	{
+		if ( !client_disconnected[c] )
+		{
+			++players;
+		}
+	}
+	// generation also reads darkmap, which the worker starts off cleared
+	// the way the level change clears it
+	const bool generated = line.compare(0, 4, "gen:") == 0;
+	if ( !staged->ready || staged->result < 0 || staged->line != line
+		|| staged->seed != seed
+		|| (generated && (staged->level != level || staged->secret != secret || staged->players != players
+			|| staged->svFlags != svFlags || darkmap || gameplayCustomManager.inUse())) )
+	{
+		discardStagedLevel();
+		return false;
+	}
+
+	Uint32 startTicks = SDL_GetTicks();
+	char oldmapname[64];
+	strcpy(oldmapname, map.name);
+
+	list_FreeAll(map.entities);
+	list_FreeAll(&light_l);
+	if ( map.worldUI )
+	{
+		list_FreeAll(map.worldUI);
+	}
+	if ( map.tiles )
+	{
+		free(map.tiles);
+	}
+	memcpy(map.name, staged->map.name, sizeof(map.name));
+	memcpy(map.author, staged->map.author, sizeof(map.author));
+	memcpy(map.flags, staged->map.flags, sizeof(map.flags));
+	map.width = staged->map.width;
+	map.height = staged->map.height;
+	map.skybox = staged->map.skybox;
+	map.tiles = staged->map.tiles;
+	staged->map.tiles = nullptr;
+
+	// uids were numbered from 0, carry on from where the last floor left off
+	for ( node_t* node = staged->entities.first; node != nullptr; node = node->next )
+	{
+		Entity* entity = (Entity*)node->element;
+		entity->setUID(entity_uids + entity->getUID());
+		map.entities_map.insert({ entity->getUID(), node });
+	}
+	entity_uids += staged->uids;
+	moveNodes(&staged->entities, map.entities);
+	moveNodes(&staged->creatures, map.creatures);
+	CreatureIndex.markRaceCountsDirty();
+
+	resetMapState(oldmapname);
+	nummonsters = staged->nummonsters;
+	minotaurlevel = staged->minotaurlevel;
+	if ( checkMapHash && !generated )
+	{
+		*checkMapHash = staged->checkMapHash;
+	}
+	if ( generated )
+	{
+		memcpy(shoparea, staged->shoparea, sizeof(bool) * map.width * map.height);
+		darkmap = staged->darkmap;
+		if ( staged->modded )
+		{
+			conductGameChallenges[CONDUCT_MODDED] = 1;
+		}
+		mapseed = seed;
+		prng_main = staged->prng;
+		monsterCurveCustomManager.readFromFile();
+		if ( staged->announceDarkmap )
+		{
+			messageLocalPlayers(language[1108]);
+		}
+	}
+	result = staged->result;
+
+	printlog("[PREFETCH]: applied floor %d%s in %d ms", level, secret ? " (secret)" : "", static_cast<int>(SDL_GetTicks() - startTicks));
+	discardStagedLevel();
+	return true;
+#endif
+}
+
+Uint32 LevelPrefetchHandler::nextMapSeed()
+{
+	if ( hasSeed )
+	{
+		hasSeed = false;
+		return seed;
+	}
+	return rand();
+}
+
+bool LevelPrefetchHandler::onWorkerThread() const
+{
+	SDL_threadID id = workerThreadId;
+	return id != 0 && id == SDL_ThreadID();
+}
+
+bool LevelPrefetchHandler::stagedEntityUid(const list_t* entlist, Uint32& uid)
+{
+	if ( !staged || entlist != staged->map.entities || !onWorkerThread() )
+	{
+		return false;
+	}
+	uid = staged->uids;
+	++staged->uids;
+	return true;
+}
+
+int LevelPrefetchHandler::threadFunction(void* data)
+{
+	static_cast<LevelPrefetchHandler*>(data)->run();
+	return 0;
+}
+
+void LevelPrefetchHandler::run()
+{
+	Uint32 startTicks = SDL_GetTicks();
+	workerThreadId = SDL_ThreadID();
+
+	// resolve the same levels.txt line physfsLoadMapFile() will
+	std::vector<std::string> paths;
+	std::string line = physfsLevelLine(level, secret, customMap);
+	std::string mapType;
+	std::string mapName;
+	std::tuple<int, int, int, int> mapParameters;
+	if ( staged && physfsParseLevelLine(line, mapType, mapName, mapParameters) )
+	{
+		staged->line = line;
+		buildLevel(mapType, mapName, mapParameters);
+		buildTicks = SDL_GetTicks() - startTicks;
+	}
+	else
+	{
+		collectLevelFiles(line, paths);
+	}
+
+	// the secret entrance leads down the other list: one floor on from a
+	// regular floor, or back to the regular floor below from a secret one
+	if ( customMap.empty() )
+	{
+		collectLevelFiles(physfsLevelLine(secret ? level - 1 : level, !secret, customMap), paths);
+	}
+
+	for ( auto& path : paths )
+	{
+		if ( stopRequested )
+		{
+			break;
+		}
+		if ( !path.empty() && warmFile(path) )
+		{
+			++filesRead;
+		}
+	}
+
+	workerThreadId = 0;
+	finished = !stopRequested;
+	ticks = SDL_GetTicks() - startTicks;
+}
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::buildLevel
+
+	builds the staged floor the way physfsLoadMapFile() would build it
+	into the global map
+
+-------------------------------------------------------------------------------*/
+
+void LevelPrefetchHandler::buildLevel(const std::string& mapType, const std::string& mapName, const std::tuple<int, int, int, int>& mapParameters)
+{
+#ifndef EDITOR
+	char tempstr[1024];
+	strncpy(tempstr, mapName.c_str(), mapName.length());
+	tempstr[mapName.length()] = '\0';
+	if ( mapType.compare("map:") == 0 )
+	{
+		std::string path = physfsFormatMapName(tempstr);
+		PrngStream_t statRng;
+		seedStatRolls(statRng, staged->seed);
+		const StatRolls_t statRolls = statRollsFrom(statRng, staged->obituary.c_str());
+		staged->result = loadMap(path.c_str(), &staged->map, staged->map.entities, staged->map.creatures, &staged->checkMapHash, &statRolls);
+	}
+	else if ( mapType.compare("gen:") == 0 )
+	{
+		staged->result = generateDungeon(tempstr, staged->seed, mapParameters, staged);
+	}
+	else
+	{
+		return;
+	}
+	staged->ready = true;
+#endif
+}
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::collectLevelFiles
+
+	lists the map files loading the given levels.txt line may open
+
+-------------------------------------------------------------------------------*/
+
+void LevelPrefetchHandler::collectLevelFiles(const std::string& line, std::vector<std::string>& paths) const
+{
+	std::string mapType;
+	std::string mapName;
+	std::tuple<int, int, int, int> mapParameters;
+	if ( !physfsParseLevelLine(line, mapType, mapName, mapParameters) )
+	{
+		return;
+	}
+	if ( mapType.compare("map:") == 0 )
+	{
+		paths.push_back(physfsFormatMapName(mapName.c_str()));
+	}
+	else if ( mapType.compare("gen:") == 0 )
+	{
+		collectLevelSet(mapName, paths);
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::collectLevelSet
+
+	lists the map files generateDungeon() may open for the given level set,
+	following its naming: the base map, numbered rooms, lettered subrooms
+	and shops
+
+-------------------------------------------------------------------------------*/
+
+void LevelPrefetchHandler::collectLevelSet(const std::string& levelset, std::vector<std::string>& paths) const
+{
+	char name[128];
+	paths.push_back(physfsFormatMapName(levelset.c_str()));
+
+	int numlevels = 0;
+	for ( ; numlevels < 100 && !stopRequested; ++numlevels )
+	{
+		snprintf(name, sizeof(name), "%s%02d", levelset.c_str(), numlevels);
+		std::string path = physfsFormatMapName(name);
+		if ( path.empty() )
+		{
+			break;
+		}
+		paths.push_back(path);
+	}
+
+	for ( int c = 0; c <= numlevels && !stopRequested; ++c )
+	{
+		for ( char letter = 'a'; letter <= 'z'; ++letter )
+		{
+			snprintf(name, sizeof(name), "%s%02d%c", levelset.c_str(), c, letter);
+			std::string path = physfsFormatMapName(name);
+			if ( path.empty() )
+			{
+				break;
+			}
+			paths.push_back(path);
+		}
+	}
+
+	// whether this floor gets a shop is rolled during generation, so take them all
+	for ( int c = 0; c < 100 && !stopRequested; ++c )
+	{
+		snprintf(name, sizeof(name), "shop%02d", c);
+		std::string path = physfsFormatMapName(name);
+		if ( path.empty() )
+		{
+			break;
+		}
+		paths.push_back(path);
+	}
+	paths.push_back(physfsFormatMapName("shopcitadel"));
+}
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler::warmFile
+
+	reads the whole file and throws the data away, leaving it in the OS
+	file cache for loadMap()
+
+-------------------------------------------------------------------------------*/
+
+bool LevelPrefetchHandler::warmFile(const std::string& filename)
+{
+	char path[PATH_MAX];
+	if ( !completePath(path, filename.c_str()) )
+	{
+		return false;
+	}
+	FILE* fp = fopen(path, "rb");
+	if ( !fp )
+	{
+		return false;
+	}
+	std::vector<char> buffer(kChunkSize);
+	size_t read = 0;
+	while ( !stopRequested && (read = fread(buffer.data(), 1, buffer.size(), fp)) > 0 )
+	{
+		bytesRead += read;
+	}
+	fclose(fp);
+	return true;
+}
@@ -0,0 +1,144 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: level_prefetch.hpp
+Desc: header for level_prefetch.cpp (builds the next floor in the
+	background)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "prng.hpp"
+
+struct StatRolls_t;
+
+/*-------------------------------------------------------------------------------
+
+	StagedLevel_t
+
+	a floor built off the main thread: the map and its entities, the prng
+	it was generated with, and the level state loading it would otherwise
+	have set globally. entity uids count up from 0 in the order entities
+	were created and are offset by entity_uids when the floor is applied,
+	so they come out the same as they would from a load on the main thread
+
+-------------------------------------------------------------------------------*/
+
+struct StagedLevel_t
+{
+	StagedLevel_t();
+	~StagedLevel_t(); // frees whatever wasn't moved into the global map
+
+	// what the floor is built from, checked against the level change
+	std::string line;
+	Uint32 seed = 0;
+	int level = 0;
+	bool secret = false;
+	int players = 0;
+	Uint32 svFlags = 0;
+	std::string obituary; // language[1500], for the worker's new Stats
+
+	list_t entities;
+	list_t creatures;
+	map_t map;
+	bool* shoparea = nullptr;
+	PrngStream_t prng;
+	Uint32 uids = 0; // entities created in map.entities so far
+
+	// set by the worker, only read after it's joined
+	bool ready = false;
+	int result = -1;
+	int checkMapHash = -1;
+	Uint32 nummonsters = 0;
+	int minotaurlevel = 0;
+	bool darkmap = false;
+	bool announceDarkmap = false;
+	Sint32 modded = 0;
+};
+
+/*-------------------------------------------------------------------------------
+
+	LevelPrefetchHandler
+
+	once a floor has been loaded, start() builds the next one on a worker
+	thread: a "gen:" floor is generated into a StagedLevel_t with its own
+	prng seeded from the map seed the level change will use, and a "map:"
+	floor is loaded into one. physfsLoadMapFile() then moves it into the
+	global map with applyStagedLevel() instead of building it itself.
+
+	the worker doesn't touch rand() or mutable globals: what generation
+	reads from the game state is copied into the StagedLevel_t by start(),
+	and creatures' stats are rolled from a stream seeded from the map seed.
+
+	the worker also reads the files of the floor the secret entrance would
+	lead to, so that load comes from the OS cache. clients only read files,
+	since their floors are built from the seed the server sends when the
+	level changes, and so does a server running a custom gameplay config,
+	which reads global state during generation.
+
+-------------------------------------------------------------------------------*/
+
+class LevelPrefetchHandler
+{
+public:
+	void start(int level, bool secret); // cancels any prefetch in flight
+	void wait(); // blocks until the worker has stopped, keeping the staged floor
+	void cancel(); // blocks until the worker has stopped and drops the staged floor
+
+	// moves the staged floor into the global map if it's the floor
+	// physfsLoadMapFile() is loading from the given line and seed.
+	// returns false, dropping it, if that has to load the floor itself
+	bool applyStagedLevel(const std::string& line, Uint32 seed, int level, bool secret, int* checkMapHash, int& result);
+
+	// the seed for the next level change. drawn by start() so the worker
+	// can generate with the seed the floor will actually use
+	Uint32 nextMapSeed();
+
+	// for entities created and destroyed by the worker
+	bool onWorkerThread() const;
+	bool stagedEntityUid(const list_t* entlist, Uint32& uid);
+private:
+	SDL_Thread* thread = nullptr;
+	std::atomic<bool> stopRequested{ false };
+	std::atomic<SDL_threadID> workerThreadId{ 0 };
+	int level = -1;
+	bool secret = false;
+	std::string customMap;
+	bool hasSeed = false;
+	Uint32 seed = 0;
+	StagedLevel_t* staged = nullptr; // set up by start(), built by the worker
+
+	// written by the worker, only read after it's joined
+	int filesRead = 0;
+	size_t bytesRead = 0;
+	Uint32 buildTicks = 0;
+	Uint32 ticks = 0;
+	bool finished = false;
+
+	static const size_t kChunkSize = 64 * 1024;
+
+	static int threadFunction(void* data);
+	void run();
+	void discardStagedLevel();
+	void buildLevel(const std::string& mapType, const std::string& mapName, const std::tuple<int, int, int, int>& mapParameters);
+	void collectLevelFiles(const std::string& line, std::vector<std::string>& paths) const;
+	void collectLevelSet(const std::string& levelset, std::vector<std::string>& paths) const;
+	bool warmFile(const std::string& path);
+};
+extern LevelPrefetchHandler LevelPrefetch;
+
+// a floor's creatures roll their sexes, appearances and default stats from
+// a stream seeded from the map seed, so the floor comes out the same
+// whether the worker or the level change builds it. the stream is kept
+// apart from the one generation draws from, which clients replay from the
+// same seed without rolling any stats
+void seedStatRolls(PrngStream_t& stream, Uint32 seed);
+StatRolls_t statRollsFrom(PrngStream_t& stream, const char* obituary = nullptr);
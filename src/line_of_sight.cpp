@@ -0,0 +1,204 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: line_of_sight.cpp
+Desc: per tick tile visibility from each player, to skip hopeless line traces
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "game.hpp"
+#include "entity.hpp"
+#include "player.hpp"
+#include "line_of_sight.hpp"
+
+LineOfSightHandler LineOfSight;
+
+/*-------------------------------------------------------------------------------
+
+	LineOfSightHandler::maySee
+
+	looks the tile up in the target player's field, computing the field
+	first if it's from an earlier tick or the player has moved since
+
+-------------------------------------------------------------------------------*/
+
+bool LineOfSightHandler::maySee(real_t x, real_t y, Entity& target)
+{
+	if ( target.behavior != &actPlayer || target.skill[2] < 0 || target.skill[2] >= MAXPLAYERS )
+	{
+		return true;
+	}
+	const int tileX = static_cast<int>(floor(x / 16));
+	const int tileY = static_cast<int>(floor(y / 16));
+	if ( tileX < 0 || tileY < 0 || tileX >= static_cast<int>(map.width) || tileY >= static_cast<int>(map.height) )
+	{
+		return true;
+	}
+
+	Field_t& field = fields[target.skill[2]];
+	if ( !field.valid || field.tick != ticks || field.x != target.x || field.y != target.y
+		|| field.stamps.size() != static_cast<size_t>(map.width) * map.height )
+	{
+		compute(field, target.x, target.y);
+	}
+	if ( abs(tileX - field.originX) > kRadius || abs(tileY - field.originY) > kRadius )
+	{
+		return true;
+	}
+
+	++queries;
+	if ( field.stamps[tileX * map.height + tileY] != field.stamp )
+	{
+		++rejected;
+		return false;
+	}
+	return true;
+}
+
+void LineOfSightHandler::compute(Field_t& field, real_t x, real_t y)
+{
+	const size_t numTiles = static_cast<size_t>(map.width) * map.height;
+	if ( field.stamps.size() != numTiles )
+	{
+		field.stamps.assign(numTiles, 0);
+		field.stamp = 0;
+	}
+	if ( ++field.stamp == 0 )
+	{
+		std::fill(field.stamps.begin(), field.stamps.end(), 0);
+		field.stamp = 1;
+	}
+	field.valid = true;
+	field.tick = ticks;
+	field.x = x;
+	field.y = y;
+	field.originX = static_cast<int>(floor(x / 16));
+	field.originY = static_cast<int>(floor(y / 16));
+	++fieldsComputed;
+
+	if ( field.originX < 0 || field.originY < 0
+		|| field.originX >= static_cast<int>(map.width) || field.originY >= static_cast<int>(map.height) )
+	{
+		return;
+	}
+	field.stamps[field.originX * map.height + field.originY] = field.stamp;
+
+	// where the player stands within the tile, from the tile's center, in tiles
+	const real_t fx = x / 16 - (field.originX + 0.5);
+	const real_t fy = y / 16 - (field.originY + 0.5);
+	static const int octants[8][4] =
+	{
+		{ 1, 0, 0, 1 },
+		{ 0, 1, 1, 0 },
+		{ 0, -1, 1, 0 },
+		{ -1, 0, 0, 1 },
+		{ -1, 0, 0, -1 },
+		{ 0, -1, -1, 0 },
+		{ 0, 1, -1, 0 },
+		{ 1, 0, 0, -1 }
+	};
+	for ( int c = 0; c < 8; ++c )
+	{
+		castOctant(field, fx, fy, octants[c][0], octants[c][1], octants[c][2], octants[c][3]);
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	LineOfSightHandler::castOctant
+
+	row by row shadowcasting over one octant. within the octant, column i of
+	row j is the tile at (i, j) from the player's tile, mapped to the world by
+	(xx * i + xy * j, yx * i + yy * j). lit holds the ranges of slopes (column
+	over row, measured from the player's exact position) that no wall has cut
+	yet. a tile is marked if its slopes touch a lit range, and a wall removes
+	its slopes from the rows after it. the slopes that only graze a wall's
+	corner stay lit, so the field errs towards visible.
+
+-------------------------------------------------------------------------------*/
+
+void LineOfSightHandler::castOctant(Field_t& field, real_t fx, real_t fy, int xx, int xy, int yx, int yy)
+{
+	// the player's offset in octant coordinates
+	const real_t ox = xx * fx + yx * fy;
+	const real_t oy = xy * fx + yy * fy;
+
+	lit.clear();
+	lit.push_back(Slopes_t(0.0, 1.0));
+	for ( int j = 1; j <= kRadius && !lit.empty(); ++j )
+	{
+		const real_t nearY = j - 0.5 - oy; // always > 0, the player is within half a tile of row 0
+		const real_t farY = j + 0.5 - oy;
+		blockers.clear();
+		for ( const Slopes_t& range : lit )
+		{
+			const int first = static_cast<int>(floor(ox + range.first * nearY + 0.5));
+			const int last = static_cast<int>(floor(ox + range.second * farY + 0.5));
+			for ( int i = first; i <= last; ++i )
+			{
+				const real_t left = i - 0.5 - ox;
+				const real_t right = i + 0.5 - ox;
+				const real_t low = std::min(left / nearY, left / farY);
+				const real_t high = std::max(right / nearY, right / farY);
+				if ( high < range.first || low > range.second )
+				{
+					continue;
+				}
+
+				const int x = field.originX + xx * i + xy * j;
+				const int y = field.originY + yx * i + yy * j;
+				if ( x < 0 || y < 0 || x >= static_cast<int>(map.width) || y >= static_cast<int>(map.height) )
+				{
+					// lineTrace() gives up at the edge of the map
+					blockers.push_back(Slopes_t(low, high));
+					continue;
+				}
+				field.stamps[x * map.height + y] = field.stamp;
+				if ( map.tiles[OBSTACLELAYER + y * MAPLAYERS + x * MAPLAYERS * map.height] )
+				{
+					blockers.push_back(Slopes_t(low, high));
+				}
+			}
+		}
+
+		// cut this row's walls out of the lit ranges
+		for ( const Slopes_t& blocker : blockers )
+		{
+			unblocked.clear();
+			for ( const Slopes_t& range : lit )
+			{
+				if ( blocker.second <= range.first || blocker.first >= range.second )
+				{
+					unblocked.push_back(range);
+					continue;
+				}
+				if ( range.first < blocker.first )
+				{
+					unblocked.push_back(Slopes_t(range.first, blocker.first));
+				}
+				if ( blocker.second < range.second )
+				{
+					unblocked.push_back(Slopes_t(blocker.second, range.second));
+				}
+			}
+			lit.swap(unblocked);
+		}
+	}
+}
+
+void LineOfSightHandler::logStatus() const
+{
+	printlog("[LOS]: %d player fields computed, %d line traces checked, %d skipped as blocked by walls",
+		static_cast<int>(fieldsComputed), static_cast<int>(queries), static_cast<int>(rejected));
+}
+
+void LineOfSightHandler::resetStats()
+{
+	fieldsComputed = 0;
+	queries = 0;
+	rejected = 0;
+}
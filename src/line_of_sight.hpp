@@ -0,0 +1,72 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: line_of_sight.hpp
+Desc: header for line_of_sight.cpp (per tick tile visibility from each player)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+/*-------------------------------------------------------------------------------
+
+	LineOfSightHandler
+
+	monsters looking for targets fire a lineTrace() at each candidate, and
+	each of those walks the map a world unit at a time. most candidates are
+	players, and most of those traces run into a wall.
+
+	the first time in a tick a monster asks about a player, the handler
+	shadowcasts from that player's exact position over the obstacle layer
+	and marks every tile that any wall-free line from the player touches.
+	the test is conservative: a tile is only left unmarked if no point in it
+	can see the player past the walls. so when maySee() says no, lineTrace()
+	would have stopped at a wall too. when it says yes the caller still runs
+	its lineTrace() for the exact answer, entities and pits included.
+
+-------------------------------------------------------------------------------*/
+
+class LineOfSightHandler
+{
+public:
+	static const int kRadius = 32; // tiles, further than this maySee() answers yes
+
+	// false if no wall-free line joins any point of the tile holding world x, y to target.
+	// always true for anything other than a player
+	bool maySee(real_t x, real_t y, Entity& target);
+
+	void logStatus() const;
+	void resetStats();
+private:
+	struct Field_t
+	{
+		std::vector<Uint32> stamps; // a tile is visible when its stamp matches stamp
+		Uint32 stamp = 0;
+		Uint32 tick = 0;
+		bool valid = false;
+		real_t x = 0.0;
+		real_t y = 0.0;
+		int originX = 0;
+		int originY = 0;
+	};
+	typedef std::pair<real_t, real_t> Slopes_t;
+
+	Field_t fields[MAXPLAYERS];
+	std::vector<Slopes_t> lit;
+	std::vector<Slopes_t> unblocked;
+	std::vector<Slopes_t> blockers;
+
+	Uint32 fieldsComputed = 0;
+	Uint32 queries = 0;
+	Uint32 rejected = 0;
+
+	void compute(Field_t& field, real_t x, real_t y);
+	void castOctant(Field_t& field, real_t fx, real_t fy, int xx, int xy, int yx, int yy);
+};
+extern LineOfSightHandler LineOfSight;
@@ -9,11 +9,38 @@
 
 -------------------------------------------------------------------------------*/
 
+#include <chrono>
+
 #include "main.hpp"
 #include "entity.hpp"
 #include "items.hpp"
 #include "interface/interface.hpp"
 #include "player.hpp"
+
+// random access tables for list_NodeIndexed(), rebuilt when the list's version or ends change.
+// nodes are only ever freed by list_RemoveNode(), so an entry is dropped whenever its list is emptied
+// (and by list_FreeAll()). a table therefore never points at freed nodes, and a list that later
+// reuses the address of a dead one can't match its stale first/last and inherit its table.
+// each thread keeps its own tables, as the level prefetch worker builds lists of its own.
+struct list_index_t
+{
+	Uint32 version;
+	node_t* first;
+	node_t* last;
+	std::vector<node_t*> nodes;
+};
+static thread_local std::unordered_map<const list_t*, list_index_t> listIndexes;
+
+#ifndef EDITOR
+// only lists with an InventoryIndex attached pay for the lookup
+static inline void list_MarkInventoryIndexDirty(const list_t* list)
+{
+	if ( list && (list->flags & LIST_FLAG_INVENTORYINDEX) )
+	{
+		markInventoryIndexDirty(list);
+	}
+}
+#endif // !EDITOR
 /*-------------------------------------------------------------------------------
 
 	list_FreeAll
@@ -34,6 +61,12 @@ void list_FreeAll(list_t* list)
 	}
 	list->first = NULL;
 	list->last = NULL;
+	list->count = 0;
+	++list->version;
+	if ( !listIndexes.empty() )
+	{
+		listIndexes.erase(list);
+	}
 }
 
 /*-------------------------------------------------------------------------------
@@ -56,6 +89,7 @@ void list_RemoveNode(node_t* node)
 	}
 
 #ifndef EDITOR
+	list_MarkInventoryIndexDirty(node->list);
 	for ( int i = 0; i < MAXPLAYERS; ++i )
 	{
 		if ( !players[i] || !players[i]->isLocalPlayer() )
@@ -91,6 +125,9 @@ void list_RemoveNode(node_t* node)
 #endif // !EDITOR
 	if ( node->list && node->list->first )
 	{
+		--node->list->count;
+		++node->list->version;
+
 		// if this is the first node...
 		if ( node == node->list->first )
 		{
@@ -99,6 +136,11 @@ void list_RemoveNode(node_t* node)
 			{
 				node->list->first = NULL;
 				node->list->last = NULL;
+				node->list->count = 0;
+				if ( !listIndexes.empty() )
+				{
+					listIndexes.erase(node->list);
+				}
 			}
 
 			// otherwise, the "first" pointer needs to point to the next node
@@ -167,6 +209,15 @@ node_t* list_AddNodeFirst(list_t* list)
 
 	// integrate it into the list
 	node->list = list;
+#ifndef EDITOR
+	list_MarkInventoryIndexDirty(list);
+#endif // !EDITOR
+	if ( list->first == NULL )
+	{
+		list->count = 0; // list may have been set up by hand
+	}
+	++list->count;
+	++list->version;
 	if ( list->first != NULL )
 	{
 		// there are prior nodes in the list
@@ -213,6 +264,15 @@ node_t* list_AddNodeLast(list_t* list)
 
 	// integrate it into the list
 	node->list = list;
+#ifndef EDITOR
+	list_MarkInventoryIndexDirty(list);
+#endif // !EDITOR
+	if ( list->first == NULL )
+	{
+		list->count = 0; // list may have been set up by hand
+	}
+	++list->count;
+	++list->version;
 	if ( list->last != NULL )
 	{
 		// there are prior nodes in the list
@@ -244,7 +304,8 @@ node_t* list_AddNodeLast(list_t* list)
 node_t* list_AddNode(list_t* list, int index)
 {
 	node_t* node;
-	if ( index < 0 || index > list_Size(list))
+	Uint32 size = list_Size(list);
+	if ( index < 0 || index > size )
 	{
 		return NULL;
 	}
@@ -265,6 +326,9 @@ node_t* list_AddNode(list_t* list, int index)
 
 	// integrate it into the list
 	node->list = list;
+#ifndef EDITOR
+	list_MarkInventoryIndexDirty(list);
+#endif // !EDITOR
 	node_t* oldnode = list_Node(list, index);
 	if ( oldnode )
 	{
@@ -285,7 +349,7 @@ node_t* list_AddNode(list_t* list, int index)
 	}
 	else
 	{
-		if ( list_Size(list) )
+		if ( size )
 		{
 			// inserting at the end of a list
 			node->prev = list->last;
@@ -303,6 +367,9 @@ node_t* list_AddNode(list_t* list, int index)
 		}
 	}
 
+	list->count = size + 1;
+	++list->version;
+
 	return node;
 }
 
@@ -310,22 +377,23 @@ node_t* list_AddNode(list_t* list, int index)
 
 	list_Size
 
-	returns the number of nodes in the given list
+	returns the number of nodes in the given list. the count is maintained
+	by the add/remove functions, so this no longer walks the list
 
 -------------------------------------------------------------------------------*/
 
 Uint32 list_Size(list_t* list)
 {
-	node_t* node;
-	int c;
-
 	if ( !list )
 	{
 		return 0;
 	}
 
-	for ( c = 0, node = list->first; node != NULL; node = node->next, c++ );
-	return c;
+	if ( list->first == NULL )
+	{
+		list->count = 0; // list may have been cleared by hand
+	}
+	return list->count;
 }
 
 /*-------------------------------------------------------------------------------
@@ -433,14 +501,162 @@ Uint32 list_Index(node_t* node)
 
 node_t* list_Node(list_t* list, int index)
 {
-	if ( index < 0 || index >= list_Size(list) )
+	Uint32 size = list_Size(list);
+	if ( index < 0 || static_cast<Uint32>(index) >= size )
 	{
 		return NULL;
 	}
 
 	int i;
-	node_t* node = list->first;
+	node_t* node;
+
+	// walk in from whichever end is closer
+	if ( static_cast<Uint32>(index) < size / 2 )
+	{
+		for ( i = 0, node = list->first; i != index; node = node->next, i++ );
+	}
+	else
+	{
+		for ( i = size - 1, node = list->last; i != index; node = node->prev, i-- );
+	}
+	return node;
+}
+
+/*-------------------------------------------------------------------------------
+
+	list_NodeIndexed
+
+	same as list_Node, but keeps a table of the list's nodes for constant
+	time lookups. the table is rebuilt after any change to the list, so
+	use this for lists that are read by index far more than they change
+	(e.g. item sprite lists)
+
+-------------------------------------------------------------------------------*/
+
+node_t* list_NodeIndexed(list_t* list, int index)
+{
+	Uint32 size = list_Size(list);
+	if ( index < 0 || static_cast<Uint32>(index) >= size )
+	{
+		return NULL;
+	}
+
+	list_index_t& table = listIndexes[list];
+	if ( table.version != list->version || table.first != list->first
+		|| table.last != list->last || table.nodes.size() != size )
+	{
+		table.nodes.clear();
+		table.nodes.reserve(size);
+		for ( node_t* node = list->first; node != NULL; node = node->next )
+		{
+			table.nodes.push_back(node);
+		}
+		table.version = list->version;
+		table.first = list->first;
+		table.last = list->last;
+		if ( table.nodes.size() != size )
+		{
+			printlog("warning: list_NodeIndexed() found %d nodes in a list counted as %d, was it modified by hand?", (int)table.nodes.size(), (int)size);
+			list->count = table.nodes.size();
+			if ( static_cast<Uint32>(index) >= list->count )
+			{
+				return NULL;
+			}
+		}
+	}
+	return table.nodes[index];
+}
+
+/*-------------------------------------------------------------------------------
 
-	for ( i = 0; i != index; node = node->next, i++ );
+	list_Benchmark
+
+	times list_Size, list_Node and list_NodeIndexed against plain walks of
+	a list with the given number of nodes, results are written to the log
+
+-------------------------------------------------------------------------------*/
+
+static Uint32 list_SizeWalk(list_t* list)
+{
+	Uint32 c = 0;
+	for ( node_t* node = list->first; node != NULL; node = node->next, c++ );
+	return c;
+}
+
+static node_t* list_NodeWalk(list_t* list, int index)
+{
+	if ( index < 0 || static_cast<Uint32>(index) >= list_SizeWalk(list) )
+	{
+		return NULL;
+	}
+	node_t* node = list->first;
+	for ( int i = 0; i != index; node = node->next, i++ );
 	return node;
 }
+
+void list_Benchmark(int numNodes, int iterations)
+{
+	list_t list;
+	list.first = NULL;
+	list.last = NULL;
+	for ( int c = 0; c < numNodes; ++c )
+	{
+		node_t* node = list_AddNodeLast(&list);
+		node->element = malloc(sizeof(int));
+		*static_cast<int*>(node->element) = c;
+		node->size = sizeof(int);
+	}
+
+	// simple lcg so the benchmark doesn't advance the game's rand()
+	std::vector<int> indices(iterations);
+	Uint32 seed = 12345;
+	for ( int c = 0; c < iterations; ++c )
+	{
+		seed = seed * 1103515245 + 12345;
+		indices[c] = (seed >> 8) % std::max(numNodes, 1);
+	}
+
+	auto timeMs = [](std::chrono::high_resolution_clock::time_point t1, std::chrono::high_resolution_clock::time_point t2)
+	{
+		return 1000.0 * std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1).count();
+	};
+	Uint64 checksum[5] = { 0, 0, 0, 0, 0 };
+
+	auto t1 = std::chrono::high_resolution_clock::now();
+	for ( int c = 0; c < iterations; ++c )
+	{
+		checksum[0] += list_SizeWalk(&list);
+	}
+	auto t2 = std::chrono::high_resolution_clock::now();
+	for ( int c = 0; c < iterations; ++c )
+	{
+		checksum[1] += list_Size(&list);
+	}
+	auto t3 = std::chrono::high_resolution_clock::now();
+	for ( int c = 0; c < iterations; ++c )
+	{
+		checksum[2] += *static_cast<int*>(list_NodeWalk(&list, indices[c])->element);
+	}
+	auto t4 = std::chrono::high_resolution_clock::now();
+	for ( int c = 0; c < iterations; ++c )
+	{
+		checksum[3] += *static_cast<int*>(list_Node(&list, indices[c])->element);
+	}
+	auto t5 = std::chrono::high_resolution_clock::now();
+	for ( int c = 0; c < iterations; ++c )
+	{
+		checksum[4] += *static_cast<int*>(list_NodeIndexed(&list, indices[c])->element);
+	}
+	auto t6 = std::chrono::high_resolution_clock::now();
+
+	printlog("[LIST BENCHMARK]: %d nodes, %d iterations", numNodes, iterations);
+	printlog("[LIST BENCHMARK]: size walk: %.3fms, list_Size: %.3fms", timeMs(t1, t2), timeMs(t2, t3));
+	printlog("[LIST BENCHMARK]: node walk: %.3fms, list_Node: %.3fms, list_NodeIndexed: %.3fms",
+		timeMs(t3, t4), timeMs(t4, t5), timeMs(t5, t6));
+	if ( checksum[0] != checksum[1] || checksum[2] != checksum[3] || checksum[2] != checksum[4] )
+	{
+		printlog("[LIST BENCHMARK]: error: results did not match!");
+	}
+
+	list_FreeAll(&list);
+}
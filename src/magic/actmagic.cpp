@@ -1075,15 +1075,20 @@ void actMagicMissile(Entity* my)   //TODO: Verify this function.
 
 							// alert other monsters too
 							Entity* ohitentity = hit.entity;
-							for ( node = map.creatures->first; node != nullptr && alertAllies; node = node->next )
+							std::vector<Entity*> nearbyCreatures;
+							if ( alertAllies )
 							{
-								entity = (Entity*)node->element;
+								nearbyCreatures = CreatureIndex.getCreaturesWithinRange(ohitentity->x, ohitentity->y, 1024);
+							}
+							for ( Entity* nearbyCreature : nearbyCreatures )
+							{
+								entity = nearbyCreature;
 								if ( entity->behavior == &actMonster && entity != ohitentity )
 								{
 									Stat* buddystats = entity->getStats();
 									if ( buddystats != nullptr )
 									{
-										if ( hit.entity && hit.entity->checkFriend(entity) ) //TODO: hit.entity->checkFriend() without first checking if it's NULL crashes because hit.entity turns to NULL somewhere along the line. It looks like ohitentity preserves that value though, so....uh...ya, I don't know.
+										if ( ohitentity->checkFriend(entity) ) // hit.entity is overwritten by the line traces below, so check the monster that was hit
 										{
 											if ( entity->monsterState == MONSTER_STATE_WAIT )
 											{
@@ -5542,7 +5547,7 @@ void magicDig(Entity* parent, Entity* projectile, int numRocks, int randRocks)
 					sendPacketSafe(net_sock, -1, net_packet, c - 1);
 				}
 
-				generatePathMaps();
+				updatePathMaps(hit.mapx, hit.mapy);
 			}
 		}
 	}
@@ -797,9 +797,9 @@ Entity* castSpell(Uint32 caster_uid, spell_t* spell, bool using_magicstaff, bool
 				{
 					messagePlayer(caster->skill[2], language[3437]);
 				}
-				for ( node_t* node3 = map.creatures->first; node3 != nullptr; node3 = node3->next )
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(caster->x, caster->y, TOUCHRANGE * 2);
+				for ( Entity* creature : nearbyCreatures )
 				{
-					Entity* creature = (Entity*)node3->element;
 					if ( creature && creature != caster && creature->behavior == &actMonster 
 						&& !caster->checkFriend(creature) && entityDist(caster, creature) < TOUCHRANGE * 2 )
 					{
@@ -835,9 +835,9 @@ Entity* castSpell(Uint32 caster_uid, spell_t* spell, bool using_magicstaff, bool
 				caster->setEffect(EFF_STUNNED, true, 35, true);
 				caster->attack(MONSTER_POSE_SPECIAL_WINDUP2, 0, nullptr);
 				int foundTarget = 0;
-				for ( node_t* node3 = map.creatures->first; node3 != nullptr; node3 = node3->next )
+				std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(caster->x, caster->y, TOUCHRANGE * 2);
+				for ( Entity* creature : nearbyCreatures )
 				{
-					Entity* creature = (Entity*)node3->element;
 					if ( creature && creature != caster
 						&& !caster->checkFriend(creature) && entityDist(caster, creature) < TOUCHRANGE * 2 )
 					{
@@ -1063,9 +1063,10 @@ Entity* castSpell(Uint32 caster_uid, spell_t* spell, bool using_magicstaff, bool
 					caster->setEffect(EFF_TROLLS_BLOOD, true, amount, true);
 					Uint32 color = SDL_MapRGB(mainsurface->format, 0, 255, 0);
 					messagePlayerColor(i, color, language[3490]);
-					for ( node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(caster->x, caster->y, HEAL_RADIUS);
+					for ( Entity* nearbyCreature : nearbyCreatures )
 					{
-						entity = (Entity*)(node->element);
+						entity = nearbyCreature;
 						if ( !entity || entity == caster )
 						{
 							continue;
@@ -1189,9 +1190,10 @@ Entity* castSpell(Uint32 caster_uid, spell_t* spell, bool using_magicstaff, bool
 					}
 					caster->setEffect(EFF_FAST, true, duration, true);
 					messagePlayerColor(i, uint32ColorGreen(*mainsurface), language[768]);
-					for ( node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(caster->x, caster->y, HEAL_RADIUS);
+					for ( Entity* nearbyCreature : nearbyCreatures )
 					{
-						entity = (Entity*)(node->element);
+						entity = nearbyCreature;
 						if ( !entity || entity == caster )
 						{
 							continue;
@@ -1264,9 +1266,10 @@ Entity* castSpell(Uint32 caster_uid, spell_t* spell, bool using_magicstaff, bool
 
 					playSoundEntity(caster, 168, 128);
 
-					for ( node = map.creatures->first; node; node = node->next )
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(caster->x, caster->y, HEAL_RADIUS);
+					for ( Entity* nearbyCreature : nearbyCreatures )
 					{
-						entity = (Entity*)(node->element);
+						entity = nearbyCreature;
 						if ( !entity ||  entity == caster )
 						{
 							continue;
@@ -1445,9 +1448,10 @@ Entity* castSpell(Uint32 caster_uid, spell_t* spell, bool using_magicstaff, bool
 						caster->setEffect(EFF_HP_REGEN, true, bonus * TICKS_PER_SECOND, true);
 					}
 
-					for ( node = map.creatures->first; node->next; node = node->next )
+					std::vector<Entity*> nearbyCreatures = CreatureIndex.getCreaturesWithinRange(caster->x, caster->y, HEAL_RADIUS);
+					for ( Entity* nearbyCreature : nearbyCreatures )
 					{
-						entity = (Entity*)(node->element);
+						entity = nearbyCreature;
 						if ( !entity || entity == caster )
 						{
 							continue;
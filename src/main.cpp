@@ -190,8 +190,6 @@ TCPsocket net_tcpsock = nullptr;
 UDPpacket* net_packet = nullptr;
 TCPsocket* net_tcpclients = nullptr;
 SDLNet_SocketSet tcpset = nullptr;
-list_t safePacketsSent;
-std::unordered_map<int, Uint32> safePacketsReceivedMap[MAXPLAYERS];
 bool receivedclientnum = false;
 char const * window_title = nullptr;
 bool softwaremode = false;
@@ -359,7 +357,7 @@ real_t vidgamma = 1.0f;
 real_t* zbuffer = nullptr;
 Sint32* lightmap = nullptr;
 Sint32* lightmapSmoothed = nullptr;
-bool* vismap = nullptr;
+VisibilityMap vismap;
 bool mode3d = false;
 bool verticalSync = false;
 bool showStatusEffectIcons = true;
@@ -403,6 +401,7 @@ bool deleteallbuttons = false;
 Uint32 cursorflash = 0;
 
 bool no_sound = false;
+bool headless = false;
 
 //Entity *players[4];
 
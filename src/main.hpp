@@ -357,7 +357,18 @@ typedef struct list_t
 {
 	node_t* first;
 	node_t* last;
+
+	// kept up to date by the list_ functions. plenty of lists are set up by hand with only first/last
+	// cleared, so count is resynced whenever a list is seen empty (see list_Size) and version is only
+	// ever compared against itself.
+	Uint32 count;
+	Uint32 version;
+
+	// LIST_FLAG_* bits. lists set up by hand may hold garbage here too, so a set bit is only ever
+	// taken as a hint and confirmed before it's acted on.
+	Uint32 flags;
 } list_t;
+const Uint32 LIST_FLAG_INVENTORYINDEX = 1; // has an InventoryIndex attached, see attachInventoryIndex()
 extern list_t button_l;
 extern list_t light_l;
 
@@ -602,7 +613,6 @@ extern bool softwaremode;
 extern real_t* zbuffer;
 extern Sint32* lightmap;
 extern Sint32* lightmapSmoothed;
-extern bool* vismap;
 extern Entity** clickmap;
 extern list_t entitiesdeleted;
 extern Sint32 multiplayer;
@@ -648,6 +658,7 @@ extern SDLNet_SocketSet tcpset;
 #define MAXBUFFERS 256
 
 #include "hash.hpp"
+#include "vismap.hpp"
 
 // various definitions
 extern map_t map;
@@ -742,6 +753,8 @@ list_t* list_Copy(list_t* destlist, list_t* srclist);
 list_t* list_CopyNew(list_t* srclist);
 Uint32 list_Index(node_t* node);
 node_t* list_Node(list_t* list, int index);
+node_t* list_NodeIndexed(list_t* list, int index);
+void list_Benchmark(int numNodes, int iterations);
 
 // function prototypes for objects.c:
 void defaultDeconstructor(void* data);
@@ -772,7 +785,8 @@ void glDrawWorld(view_t* camera, int mode);
 SDL_Cursor* newCursor(char const * const image[]);
 
 // function prototypes for maps.c:
-int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int> mapParameters = std::make_tuple(-1, -1, -1, 0)); // secretLevelChance of -1 is default Barony generation.
+struct StagedLevel_t;
+int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int> mapParameters = std::make_tuple(-1, -1, -1, 0), StagedLevel_t* staged = nullptr); // secretLevelChance of -1 is default Barony generation.
 void assignActions(map_t* map);
 
 // Cursor bitmap definitions
@@ -784,6 +798,7 @@ extern char const *cursor_fill[];
 GLuint create_shader(const char* filename, GLenum type);
 
 extern bool no_sound; //False means sound initialized properly. True means sound failed to initialize.
+extern bool headless; //Dedicated server, no window, GL context or audio. Draw calls become no-ops.
 extern bool initialized; //So that messagePlayer doesn't explode before the game is initialized. //TODO: Does the editor need this set too and stuff?
 
 #ifdef PANDORA
@@ -27,6 +27,7 @@
 #include "scores.hpp"
 #include "mod_tools.hpp"
 #include "menu.hpp"
+#include "level_prefetch.hpp"
 
 int startfloor = 0;
 
@@ -320,16 +321,32 @@ int monsterCurve(int level)
 	return SKELETON; // basic monster
 }
 
+// checkObstacle() for a tile while a level is generated: nothing is in
+// TileEntityList yet, so only walls and missing floor get in the way
+static bool terrainObstacle(const map_t& onMap, long x, long y)
+{
+	if ( x >= 0 && x < onMap.width << 4 )
+	{
+		if ( y >= 0 && y < onMap.height << 4 )
+		{
+			int index = (y >> 4) * MAPLAYERS + (x >> 4) * MAPLAYERS * onMap.height;
+			return onMap.tiles[OBSTACLELAYER + index] || !onMap.tiles[index];
+		}
+	}
+	return false;
+}
+
 /*-------------------------------------------------------------------------------
 
 	generateDungeon
 
 	generates a level by drawing data from numerous files and connecting
-	their rooms together with tunnels.
+	their rooms together with tunnels. given staged, the level is built
+	there instead, off the main thread (see LevelPrefetchHandler)
 
 -------------------------------------------------------------------------------*/
 
-int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int> mapParameters)
+int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int> mapParameters, StagedLevel_t* staged)
 {
 	char* sublevelname, *subRoomName;
 	char sublevelnum[3];
@@ -356,6 +373,35 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	bool *monsterexcludelocations;
 	bool *lootexcludelocations;
 
+	// builds into the global map and level state, or into staged when the
+	// level prefetch worker is building the next floor ahead of time
+	map_t& map = staged ? staged->map : ::map;
+	PrngStream_t& prng = staged ? staged->prng : prng_main;
+	const int currentlevel = staged ? staged->level : ::currentlevel;
+	const bool secretlevel = staged ? staged->secret : ::secretlevel;
+	bool& darkmap = staged ? staged->darkmap : ::darkmap;
+	int& minotaurlevel = staged ? staged->minotaurlevel : ::minotaurlevel;
+	Uint32& nummonsters = staged ? staged->nummonsters : ::nummonsters;
+	bool*& shoparea = staged ? staged->shoparea : ::shoparea;
+	Sint32& moddedConduct = staged ? staged->modded : conductGameChallenges[CONDUCT_MODDED];
+	const Uint32 svFlags = staged ? staged->svFlags : ::svFlags;
+
+	// creatures' stats come from a stream of their own, see seedStatRolls()
+	PrngStream_t statRng;
+	seedStatRolls(statRng, seed);
+	const StatRolls_t statRolls = statRollsFrom(statRng, staged ? staged->obituary.c_str() : nullptr);
+	auto announceDarkmap = [staged]()
+	{
+		if ( staged )
+		{
+			staged->announceDarkmap = true; // the worker can't message players
+		}
+		else
+		{
+			messageLocalPlayers(language[1108]);
+		}
+	};
+
 	if ( std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) == -1
 		&& std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) == -1
 		&& std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) == -1
@@ -390,36 +436,48 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 		strcat(generationLog, ", (seed %d)...\n");
 		printlog(generationLog, levelset, seed);
 
-		conductGameChallenges[CONDUCT_MODDED] = 1;
+		moddedConduct = 1;
 	}
 
 	std::string fullMapPath;
 	fullMapPath = physfsFormatMapName(levelset);
 
 	int checkMapHash = -1;
-	if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), &map, map.entities, map.creatures, &checkMapHash) == -1 )
+	if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), &map, map.entities, map.creatures, &checkMapHash, &statRolls) == -1 )
 	{
 		printlog("error: no level of set '%s' could be found.\n", levelset);
 		return -1;
 	}
 	if ( checkMapHash == 0 )
 	{
-		conductGameChallenges[CONDUCT_MODDED] = 1;
+		moddedConduct = 1;
+	}
+	if ( staged )
+	{
+		// loadMap() only sets up shop tiles for the global map
+		shoparea = (bool*) calloc(map.width * map.height, sizeof(bool));
 	}
 
 	// store this map's seed
-	mapseed = seed;
-	prng_seed_bytes(&mapseed, sizeof(mapseed));
+	if ( !staged )
+	{
+		mapseed = seed;
+	}
+	prng.seedBytes(&seed, sizeof(seed));
 
-	// generate a custom monster curve if file exists
-	monsterCurveCustomManager.readFromFile();
+	// generate a custom monster curve if file exists. a staged floor
+	// reads it when it's applied
+	if ( !staged )
+	{
+		monsterCurveCustomManager.readFromFile();
+	}
 
 	// determine whether shop level or not
 	if ( gameplayCustomManager.processedShopFloor(currentlevel, secretlevel, map.name, shoplevel) )
 	{
 		// function sets shop level for us.
 	}
-	else if ( prng_get_uint() % 2 && currentlevel > 1 && strncmp(map.name, "Underworld", 10) && strncmp(map.name, "Hell", 4) )
+	else if ( prng.getUint() % 2 && currentlevel > 1 && strncmp(map.name, "Underworld", 10) && strncmp(map.name, "Hell", 4) )
 	{
 		shoplevel = true;
 	}
@@ -431,7 +489,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	}
 	else if ( std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) != -1 )
 	{
-		if ( prng_get_uint() % 100 < std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) && (svFlags & SV_FLAG_MINOTAURS) )
+		if ( prng.getUint() % 100 < std::get<LEVELPARAM_CHANCE_MINOTAUR>(mapParameters) && (svFlags & SV_FLAG_MINOTAURS) )
 		{
 			minotaurlevel = 1;
 		}
@@ -439,7 +497,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	else if ( (currentlevel < 25 && (currentlevel % LENGTH_OF_LEVEL_REGION == 2 || currentlevel % LENGTH_OF_LEVEL_REGION == 3))
 		|| (currentlevel > 25 && (currentlevel % LENGTH_OF_LEVEL_REGION == 2 || currentlevel % LENGTH_OF_LEVEL_REGION == 4)) )
 	{
-		if ( prng_get_uint() % 2 && (svFlags & SV_FLAG_MINOTAURS) )
+		if ( prng.getUint() % 2 && (svFlags & SV_FLAG_MINOTAURS) )
 		{
 			minotaurlevel = 1;
 		}
@@ -458,10 +516,10 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	{
 		if ( std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) != -1 )
 		{
-			if ( prng_get_uint() % 100 < std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) )
+			if ( prng.getUint() % 100 < std::get<LEVELPARAM_CHANCE_DARKNESS>(mapParameters) )
 			{
 				darkmap = true;
-				messageLocalPlayers(language[1108]);
+				announceDarkmap();
 			}
 			else
 			{
@@ -470,10 +528,10 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 		}
 		else if ( currentlevel % LENGTH_OF_LEVEL_REGION >= 2 )
 		{
-			if ( prng_get_uint() % 4 == 0 )
+			if ( prng.getUint() % 4 == 0 )
 			{
 				darkmap = true;
-				messageLocalPlayers(language[1108]);
+				announceDarkmap();
 			}
 		}
 	}
@@ -483,7 +541,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	{
 		if ( std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) != -1 )
 		{
-			if ( prng_get_uint() % 100 < std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) )
+			if ( prng.getUint() % 100 < std::get<LEVELPARAM_CHANCE_SECRET>(mapParameters) )
 			{
 				secretlevelexit = 7;
 			}
@@ -492,7 +550,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 				secretlevelexit = 0;
 			}
 		}
-		else if ( (currentlevel == 3 && prng_get_uint() % 2) || currentlevel == 2 )
+		else if ( (currentlevel == 3 && prng.getUint() % 2) || currentlevel == 2 )
 		{
 			secretlevelexit = 1;
 		}
@@ -542,7 +600,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 		}
 		if ( numlevels )
 		{
-			int shopleveltouse = prng_get_uint() % numlevels;
+			int shopleveltouse = prng.getUint() % numlevels;
 			if ( !strncmp(map.name, "Citadel", 7) )
 			{
 				strcpy(sublevelname, "shopcitadel");
@@ -564,7 +622,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			shopmap.creatures->first = nullptr;
 			shopmap.creatures->last = nullptr;
 			shopmap.worldUI = nullptr;
-			if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), &shopmap, shopmap.entities, shopmap.creatures, &checkMapHash) == -1 )
+			if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), &shopmap, shopmap.entities, shopmap.creatures, &checkMapHash, &statRolls) == -1 )
 			{
 				list_FreeAll(shopmap.entities);
 				free(shopmap.entities);
@@ -577,7 +635,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			}
 			if ( checkMapHash == 0 )
 			{
-				conductGameChallenges[CONDUCT_MODDED] = 1;
+				moddedConduct = 1;
 			}
 		}
 		else
@@ -612,14 +670,14 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 		tempMap->creatures->first = nullptr;
 		tempMap->creatures->last = nullptr;
 		tempMap->worldUI = nullptr;
-		if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), tempMap, tempMap->entities, tempMap->creatures, &checkMapHash) == -1 )
+		if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), tempMap, tempMap->entities, tempMap->creatures, &checkMapHash, &statRolls) == -1 )
 		{
 			mapDeconstructor((void*)tempMap);
 			continue; // failed to load level
 		}
 		if ( checkMapHash == 0 )
 		{
-			conductGameChallenges[CONDUCT_MODDED] = 1;
+			moddedConduct = 1;
 		}
 
 		// level is successfully loaded, add it to the pool
@@ -716,14 +774,14 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			subRoomMap->creatures->first = nullptr;
 			subRoomMap->creatures->last = nullptr;
 			subRoomMap->worldUI = nullptr;
-			if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), subRoomMap, subRoomMap->entities, subRoomMap->creatures, &checkMapHash) == -1 )
+			if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), subRoomMap, subRoomMap->entities, subRoomMap->creatures, &checkMapHash, &statRolls) == -1 )
 			{
 				mapDeconstructor((void*)subRoomMap);
 				continue; // failed to load level
 			}
 			if ( checkMapHash == 0 )
 			{
-				conductGameChallenges[CONDUCT_MODDED] = 1;
+				moddedConduct = 1;
 			}
 
 			// level is successfully loaded, add it to the pool
@@ -885,7 +943,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 						break;
 				}
 				fullMapPath = physfsFormatMapName(secretmapname);
-				if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), &secretlevelmap, secretlevelmap.entities, secretlevelmap.creatures, &checkMapHash) == -1 )
+				if ( fullMapPath.empty() || loadMap(fullMapPath.c_str(), &secretlevelmap, secretlevelmap.entities, secretlevelmap.creatures, &checkMapHash, &statRolls) == -1 )
 				{
 					list_FreeAll(secretlevelmap.entities);
 					free(secretlevelmap.entities);
@@ -898,7 +956,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 				}
 				if ( checkMapHash == 0 )
 				{
-					conductGameChallenges[CONDUCT_MODDED] = 1;
+					moddedConduct = 1;
 				}
 
 				levelnum = 0;
@@ -918,7 +976,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 				{
 					break;
 				}
-				levelnum = prng_get_uint() % (numlevels); // draw randomly from the pool
+				levelnum = prng.getUint() % (numlevels); // draw randomly from the pool
 
 				// traverse the map list to the picked level
 				node = mapList.first;
@@ -1036,20 +1094,20 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 					if ( c == 0 )
 					{
 						// 7x7, pick random location across all map.
-						x = 2 + (prng_get_uint() % 7) * 7;
-						y = 2 + (prng_get_uint() % 7) * 7;
+						x = 2 + (prng.getUint() % 7) * 7;
+						y = 2 + (prng.getUint() % 7) * 7;
 					}
 					else if ( secretlevelexit && c == 1 )
 					{
 						// 14x14, pick random location minus 1 from both edges.
-						x = 2 + (prng_get_uint() % 6) * 7;
-						y = 2 + (prng_get_uint() % 6) * 7;
+						x = 2 + (prng.getUint() % 6) * 7;
+						y = 2 + (prng.getUint() % 6) * 7;
 					}
 					else if ( c == 2 && shoplevel )
 					{
 						// 7x7, pick random location across all map.
-						x = 2 + (prng_get_uint() % 7) * 7;
-						y = 2 + (prng_get_uint() % 7) * 7;
+						x = 2 + (prng.getUint() % 7) * 7;
+						y = 2 + (prng.getUint() % 7) * 7;
 					}
 				}
 				else
@@ -1057,27 +1115,27 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 					if ( c == 0 )
 					{
 						// pick random location across all map.
-						x = 2 + (prng_get_uint() % tempMap->width) * tempMap->width;
-						y = 2 + (prng_get_uint() % tempMap->height) * tempMap->height;
+						x = 2 + (prng.getUint() % tempMap->width) * tempMap->width;
+						y = 2 + (prng.getUint() % tempMap->height) * tempMap->height;
 					}
 					else if ( secretlevelexit && c == 1 )
 					{
-						x = 2 + (prng_get_uint() % tempMap->width) * tempMap->width;
-						y = 2 + (prng_get_uint() % tempMap->height) * tempMap->height;
+						x = 2 + (prng.getUint() % tempMap->width) * tempMap->width;
+						y = 2 + (prng.getUint() % tempMap->height) * tempMap->height;
 						while ( x + tempMap->width >= map.width )
 						{
-							x = 2 + (prng_get_uint() % tempMap->width) * tempMap->width;
+							x = 2 + (prng.getUint() % tempMap->width) * tempMap->width;
 						}
 						while ( y + tempMap->height >= map.height )
 						{
-							y = 2 + (prng_get_uint() % tempMap->height) * tempMap->height;
+							y = 2 + (prng.getUint() % tempMap->height) * tempMap->height;
 						}
 					}
 					else if ( c == 2 && shoplevel )
 					{
 						// pick random location across all map.
-						x = 2 + (prng_get_uint() % tempMap->width) * tempMap->width;
-						y = 2 + (prng_get_uint() % tempMap->height) * tempMap->height;
+						x = 2 + (prng.getUint() % tempMap->width) * tempMap->width;
+						y = 2 + (prng.getUint() % tempMap->height) * tempMap->height;
 					}
 				}
 
@@ -1106,7 +1164,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			}
 			else
 			{
-				pickedlocation = prng_get_uint() % numpossiblelocations;
+				pickedlocation = prng.getUint() % numpossiblelocations;
 				i = -1;
 				x = 0;
 				y = 0;
@@ -1166,7 +1224,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			if ( subroomCount[levelnum + 1] > 0 )
 			{
 				int jumps = 0;
-				pickSubRoom = prng_get_uint() % subroomCount[levelnum + 1];
+				pickSubRoom = prng.getUint() % subroomCount[levelnum + 1];
 				// traverse the map list to the picked level
 				subRoomNode = subRoomMapList.first;
 				for ( int cycleRooms = 0; (cycleRooms < levelnum + 1) && (subRoomNode != nullptr); ++cycleRooms )
@@ -1287,7 +1345,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 					entity->behavior = &actMonster;
 				}
 
-				setSpriteAttributes(childEntity, entity, entity);
+				setSpriteAttributes(childEntity, entity, entity, &statRolls);
 				childEntity->x = entity->x + x * 16;
 				childEntity->y = entity->y + y * 16;
 				//printlog("1 Generated entity. Sprite: %d Uid: %d X: %.2f Y: %.2f\n",childEntity->sprite,childEntity->getUID(),childEntity->x,childEntity->y);
@@ -1313,7 +1371,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 						entity->behavior = &actMonster;
 					}
 
-					setSpriteAttributes(childEntity, entity, entity);
+					setSpriteAttributes(childEntity, entity, entity, &statRolls);
 					childEntity->x = entity->x + subRoom_tileStartx * 16;
 					childEntity->y = entity->y + subRoom_tileStarty * 16;
 
@@ -1719,7 +1777,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			}
 		}
 
-		int whatever = prng_get_uint() % 5;
+		int whatever = prng.getUint() % 5;
 		if ( strncmp(map.name, "Hell", 4) )
 			j = std::min(
 			        std::min(
@@ -1738,7 +1796,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 		for ( c = 0; c < j; ++c )
 		{
 			// choose a random location from those available
-			pickedlocation = prng_get_uint() % numpossiblelocations;
+			pickedlocation = prng.getUint() % numpossiblelocations;
 			i = -1;
 			//printlog("pickedlocation: %d\n",pickedlocation);
 			//printlog("numpossiblelocations: %d\n",numpossiblelocations);
@@ -1810,7 +1868,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			}
 			else
 			{
-				if ( prng_get_uint() % 2 && (currentlevel > 5 && currentlevel <= 25) )
+				if ( prng.getUint() % 2 && (currentlevel > 5 && currentlevel <= 25) )
 				{
 					arrowtrapspawn = true;
 				}
@@ -1819,7 +1877,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			if ( customTrapsForMapInUse )
 			{
 				arrowtrapspawn = customTraps.arrows;
-				if ( customTraps.boulders && prng_get_uint() % 2 )
+				if ( customTraps.boulders && prng.getUint() % 2 )
 				{
 					arrowtrapspawn = false;
 				}
@@ -1946,7 +2004,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	{
 		for ( x = 0; x < map.width; x++ )
 		{
-			if ( checkObstacle( x * 16 + 8, y * 16 + 8, NULL, NULL ) || firstroomtile[y + x * map.height] )
+			if ( terrainObstacle(map, x * 16 + 8, y * 16 + 8) || firstroomtile[y + x * map.height] )
 			{
 				possiblelocations[y + x * map.height] = false;
 				numpossiblelocations--;
@@ -2015,13 +2073,13 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 		genEntityMin = std::max(genEntityMin, 2); // make sure there's room for a ladder.
 		entitiesToGenerate = genEntityMin;
 		randomEntities = std::max(genEntityMax - genEntityMin, 1); // difference between min and max is the extra chances.
-		//Needs to be 1 for prng_get_uint() % to not divide by 0.
-		j = std::min<Uint32>(entitiesToGenerate + prng_get_uint() % randomEntities, numpossiblelocations); //TODO: Why are Uint32 and Sin32 being compared?
+		//Needs to be 1 for prng.getUint() % to not divide by 0.
+		j = std::min<Uint32>(entitiesToGenerate + prng.getUint() % randomEntities, numpossiblelocations); //TODO: Why are Uint32 and Sin32 being compared?
 	}
 	else
 	{
 		// revert to old mechanics.
-		j = std::min<Uint32>(30 + prng_get_uint() % 10, numpossiblelocations); //TODO: Why are Uint32 and Sin32 being compared?
+		j = std::min<Uint32>(30 + prng.getUint() % 10, numpossiblelocations); //TODO: Why are Uint32 and Sin32 being compared?
 	}
 	int forcedMonsterSpawns = 0;
 	int forcedLootSpawns = 0;
@@ -2029,15 +2087,15 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 
 	if ( genMonsterMin > 0 || genMonsterMax > 0 )
 	{
-		forcedMonsterSpawns = genMonsterMin + prng_get_uint() % std::max(genMonsterMax - genMonsterMin, 1);
+		forcedMonsterSpawns = genMonsterMin + prng.getUint() % std::max(genMonsterMax - genMonsterMin, 1);
 	}
 	if ( genLootMin > 0 || genLootMax > 0 )
 	{
-		forcedLootSpawns = genLootMin + prng_get_uint() % std::max(genLootMax - genLootMin, 1);
+		forcedLootSpawns = genLootMin + prng.getUint() % std::max(genLootMax - genLootMin, 1);
 	}
 	if ( genDecorationMin > 0 || genDecorationMax > 0 )
 	{
-		forcedDecorationSpawns = genDecorationMin + prng_get_uint() % std::max(genDecorationMax - genDecorationMin, 1);
+		forcedDecorationSpawns = genDecorationMin + prng.getUint() % std::max(genDecorationMax - genDecorationMin, 1);
 	}
 
 	//messagePlayer(0, "Num locations: %d of %d possible, force monsters: %d, force loot: %d, force decorations: %d", j, numpossiblelocations, forcedMonsterSpawns, forcedLootSpawns, forcedDecorationSpawns);
@@ -2051,7 +2109,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 	for ( c = 0; c < std::min(j, numpossiblelocations); ++c )
 	{
 		// choose a random location from those available
-		pickedlocation = prng_get_uint() % numpossiblelocations;
+		pickedlocation = prng.getUint() % numpossiblelocations;
 		i = -1;
 		//printlog("pickedlocation: %d\n",pickedlocation);
 		//printlog("numpossiblelocations: %d\n",numpossiblelocations);
@@ -2100,17 +2158,12 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			if ( strncmp(map.name, "Underworld", 10) )
 			{
 				bool nopath = false;
-				bool hellLadderFix = !strncmp(map.name, "Hell", 4);
-				/*if ( !hellLadderFix )
-				{
-					hellLadderFix = !strncmp(map.name, "Caves", 4);
-				}*/
 				for ( node = map.entities->first; node != NULL; node = node->next )
 				{
 					entity2 = (Entity*)node->element;
 					if ( entity2->sprite == 1 )
 					{
-						list_t* path = generatePath(x, y, entity2->x / 16, entity2->y / 16, entity, entity2, hellLadderFix);
+						list_t* path = generateTerrainPath(map, x, y, entity2->x / 16, entity2->y / 16);
 						if ( path == NULL )
 						{
 							nopath = true;
@@ -2149,7 +2202,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			{
 				for ( y2 = -1; y2 <= 1; y2++ )
 				{
-					if ( checkObstacle((x + x2) * 16, (y + y2) * 16, NULL, NULL) )
+					if ( terrainObstacle(map, (x + x2) * 16, (y + y2) * 16) )
 					{
 						obstacles++;
 						if ( obstacles > 1 )
@@ -2180,14 +2233,14 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 						{
 							// doNPC processed by function
 						}
-						else if ( prng_get_uint() % 10 == 0 && currentlevel > 1 )
+						else if ( prng.getUint() % 10 == 0 && currentlevel > 1 )
 						{
 							doNPC = true;
 						}
 
 						if ( doNPC )
 						{
-							if ( currentlevel > 15 && prng_get_uint() % 4 > 0 )
+							if ( currentlevel > 15 && prng.getUint() % 4 > 0 )
 							{
 								entity = newEntity(93, 1, map.entities, map.creatures);  // automaton
 								if ( currentlevel < 25 )
@@ -2200,7 +2253,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 								entity = newEntity(27, 1, map.entities, map.creatures);  // human
 								if ( multiplayer != CLIENT && currentlevel > 5 )
 								{
-									entity->monsterStoreType = (currentlevel / 5) * 3 + (rand() % 4); // scale humans with depth.  3 LVL each 5 floors, + 0-3.
+									entity->monsterStoreType = (currentlevel / 5) * 3 + (statRng.getUint() % 4); // scale humans with depth.  3 LVL each 5 floors, + 0-3.
 								}
 							}
 						}
@@ -2217,7 +2270,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 					--forcedLootSpawns;
 					if ( lootexcludelocations[x + y * map.width] == false )
 					{
-						if ( prng_get_uint() % 10 == 0 )   // 10% chance
+						if ( prng.getUint() % 10 == 0 )   // 10% chance
 						{
 							entity = newEntity(9, 1, map.entities, nullptr);  // gold
 							numGenGold++;
@@ -2234,9 +2287,9 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 				{
 					--forcedDecorationSpawns;
 					// decorations
-					if ( (prng_get_uint() % 4 == 0 || currentlevel <= 10 && !customTrapsForMapInUse) && strcmp(map.name, "Hell") )
+					if ( (prng.getUint() % 4 == 0 || currentlevel <= 10 && !customTrapsForMapInUse) && strcmp(map.name, "Hell") )
 					{
-						switch ( prng_get_uint() % 7 )
+						switch ( prng.getUint() % 7 )
 						{
 							case 0:
 								entity = newEntity(12, 1, map.entities, nullptr); //Firecamp.
@@ -2273,7 +2326,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 							{
 								continue;
 							}
-							else if ( customTraps.verticalSpelltraps && prng_get_uint() % 2 == 0 )
+							else if ( customTraps.verticalSpelltraps && prng.getUint() % 2 == 0 )
 							{
 								entity = newEntity(120, 1, map.entities, nullptr); // vertical spell trap.
 								setSpriteAttributes(entity, nullptr, nullptr);
@@ -2291,7 +2344,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 							}
 							else
 							{
-								if ( prng_get_uint() % 2 == 0 )
+								if ( prng.getUint() % 2 == 0 )
 								{
 									entity = newEntity(120, 1, map.entities, nullptr); // vertical spell trap.
 									setSpriteAttributes(entity, nullptr, nullptr);
@@ -2313,15 +2366,22 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 			else
 			{
 				// return to normal generation
-				if ( prng_get_uint() % 2 || nodecoration )
+				if ( prng.getUint() % 2 || nodecoration )
 				{
 					// balance for total number of players
 					int balance = 0;
-					for ( i = 0; i < MAXPLAYERS; i++ )
+					if ( staged )
+					{
+						balance = staged->players;
+					}
+					else
 					{
-						if ( !client_disconnected[i] )
+						for ( i = 0; i < MAXPLAYERS; i++ )
 						{
-							balance++;
+							if ( !client_disconnected[i] )
+							{
+								balance++;
+							}
 						}
 					}
 					switch ( balance )
@@ -2346,11 +2406,11 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 					// monsters/items
 					if ( balance )
 					{
-						if ( prng_get_uint() % balance )
+						if ( prng.getUint() % balance )
 						{
 							if ( lootexcludelocations[x + y * map.width] == false )
 							{
-								if ( prng_get_uint() % 10 == 0 )   // 10% chance
+								if ( prng.getUint() % 10 == 0 )   // 10% chance
 								{
 									entity = newEntity(9, 1, map.entities, nullptr);  // gold
 									numGenGold++;
@@ -2372,14 +2432,14 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 								{
 									// doNPC processed by function
 								}
-								else if ( prng_get_uint() % 10 == 0 && currentlevel > 1 )
+								else if ( prng.getUint() % 10 == 0 && currentlevel > 1 )
 								{
 									doNPC = true;
 								}
 
 								if ( doNPC )
 								{
-									if ( currentlevel > 15 && prng_get_uint() % 4 > 0 )
+									if ( currentlevel > 15 && prng.getUint() % 4 > 0 )
 									{
 										entity = newEntity(93, 1, map.entities, map.creatures);  // automaton
 										if ( currentlevel < 25 )
@@ -2392,7 +2452,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 										entity = newEntity(27, 1, map.entities, map.creatures);  // human
 										if ( multiplayer != CLIENT && currentlevel > 5 )
 										{
-											entity->monsterStoreType = (currentlevel / 5) * 3 + (rand() % 4); // scale humans with depth. 3 LVL each 5 floors, + 0-3.
+											entity->monsterStoreType = (currentlevel / 5) * 3 + (statRng.getUint() % 4); // scale humans with depth. 3 LVL each 5 floors, + 0-3.
 										}
 									}
 								}
@@ -2409,9 +2469,9 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 				else
 				{
 					// decorations
-					if ( (prng_get_uint() % 4 == 0 || (currentlevel <= 10 && !customTrapsForMapInUse)) && strcmp(map.name, "Hell") )
+					if ( (prng.getUint() % 4 == 0 || (currentlevel <= 10 && !customTrapsForMapInUse)) && strcmp(map.name, "Hell") )
 					{
-						switch ( prng_get_uint() % 7 )
+						switch ( prng.getUint() % 7 )
 						{
 							case 0:
 								entity = newEntity(12, 1, map.entities, nullptr); //Firecamp entity.
@@ -2448,7 +2508,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 							{
 								continue;
 							}
-							else if ( customTraps.verticalSpelltraps && prng_get_uint() % 2 == 0 )
+							else if ( customTraps.verticalSpelltraps && prng.getUint() % 2 == 0 )
 							{
 								entity = newEntity(120, 1, map.entities, nullptr); // vertical spell trap.
 								setSpriteAttributes(entity, nullptr, nullptr);
@@ -2466,7 +2526,7 @@ int generateDungeon(char* levelset, Uint32 seed, std::tuple<int, int, int, int>
 							}
 							else
 							{
-								if ( prng_get_uint() % 2 == 0 )
+								if ( prng.getUint() % 2 == 0 )
 								{
 									entity = newEntity(120, 1, map.entities, nullptr); // vertical spell trap.
 									setSpriteAttributes(entity, nullptr, nullptr);
@@ -2619,6 +2679,25 @@ void assignActions(map_t* map)
 						entity = nullptr;
 						break;
 					}
+					if ( headless && numplayers == 0 )
+					{
+						// a dedicated server keeps slot 0 but doesn't play, so it gets no avatar.
+						// the clients still spawn one for it, so roll the same numbers they do
+						if ( entity->playerStartDir == -1 )
+						{
+							prng_get_uint();
+						}
+						if ( minotaurlevel )
+						{
+							entity->x += 8;
+							entity->y += 8;
+							createMinotaurTimer(entity, map);
+						}
+						++numplayers;
+						list_RemoveNode(entity->mynode);
+						entity = nullptr;
+						break;
+					}
 					if ( multiplayer != CLIENT )
 					{
 						if ( stats[numplayers]->HP <= 0 )
@@ -5747,6 +5826,8 @@ void assignActions(map_t* map)
 			}
 		}
 	}
+
+	CircuitGraph.reset(); // wires and mechanisms are indexed the first time power moves
 }
 
 void mapLevel(int player)
@@ -18,6 +18,8 @@
 #include "player.hpp"
 #include "scores.hpp"
 
+#include <algorithm>
+
 //Circuits do not overlap. They connect to all their neighbors, allowing for circuits to interfere with eachother.
 
 void actCircuit(Entity* my)
@@ -50,71 +52,13 @@ void Entity::circuitPowerOff()
 void Entity::updateCircuitNeighbors()
 {
 	//Send the power on or off signal to all neighboring circuits & mechanisms.
-	list_t* neighbors = getPowerableNeighbors(); //Grab a list of all neighboring circuits and mechanisms.
-
-	if (neighbors)
+	if ( behavior == actCircuit )
 	{
-		node_t* node = NULL;
-		for (node = neighbors->first; node != NULL; node = node->next)
-		{
-			if (node->element)
-			{
-				Entity* powerable = (Entity*)(node->element);
-
-				if (powerable)
-				{
-					if (powerable->behavior == actCircuit)
-					{
-						(circuit_status > 1) ? powerable->circuitPowerOn() : powerable->circuitPowerOff();
-					}
-					else if ( powerable->behavior == &::actSignalTimer )
-					{
-						int x1 = static_cast<int>(this->x / 16);
-						int x2 = static_cast<int>(powerable->x / 16);
-						int y1 = static_cast<int>(this->y / 16);
-						int y2 = static_cast<int>(powerable->y / 16);
-						//messagePlayer(0, "%d, %d, %d, %d", x1, x2, y1, y2);
-						switch ( powerable->signalInputDirection )
-						{
-							case 0: // west
-								if ( (x1 + 1) == x2 )
-								{
-									(circuit_status > 1) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							case 1: // south
-								if ( (y1 - 1) == y2 )
-								{
-									(circuit_status > 1) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							case 2: // east
-								if ( (x1 - 1) == x2 )
-								{
-									(circuit_status > 1) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							case 3: // north
-								if ( (y1 + 1) == y2 )
-								{
-									(circuit_status > 1) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							default:
-								break;
-						}
-					}
-					else
-					{
-						(circuit_status > 1) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-					}
-				}
-			}
-		}
-
-		//Free the list.
-		list_FreeAll(neighbors);
-		free(neighbors);
+		CircuitGraph.powerWire(*this, circuit_status > 1); //Powers the whole connected network at once.
+	}
+	else
+	{
+		CircuitGraph.powerNeighbors(*this, circuit_status > 1, false);
 	}
 }
 
@@ -437,10 +381,10 @@ void actTrapPermanent(Entity* my)
 
 	if ( !strcmp(map.name, "Boss") )
 	{
-		for ( node = map.creatures->first; node != nullptr; node = node->next ) //Only looking at players? Don't search full map.entities.
+		for ( int c = 0; c < MAXPLAYERS; ++c ) //Only looking at players.
 		{
-			entity = (Entity*)node->element;
-			if ( entity->behavior == &actPlayer )
+			entity = players[c] ? players[c]->entity : nullptr;
+			if ( entity )
 			{
 				if ( entity->x < 26 * 16 || entity->y < 6 * 16 || entity->y >= 26 * 16 )   // hardcoded, I know...
 				{
@@ -454,15 +398,8 @@ void actTrapPermanent(Entity* my)
 		if ( my->x > 50 * 16 )
 		{
 			// exit gate, act abnormal!
-			bool monsterAlive = false;
-			for ( node = map.creatures->first; node != nullptr; node = node->next )
-			{
-				entity = (Entity*)node->element;
-				if ( entity->behavior == &actMonster && (entity->getRace() == LICH_FIRE || entity->getRace() == LICH_ICE) )
-				{
-					monsterAlive = true;
-				}
-			}
+			Entity* lastMonster = nullptr;
+			bool monsterAlive = numMonsterTypeAliveOnMap(LICH_FIRE, lastMonster) > 0 || numMonsterTypeAliveOnMap(LICH_ICE, lastMonster) > 0;
 			if ( !monsterAlive )
 			{
 				// turn on when safe.
@@ -476,10 +413,10 @@ void actTrapPermanent(Entity* my)
 		else
 		{
 			// fight trigger plates, wait for players to assemble.
-			for ( node = map.creatures->first; node != nullptr; node = node->next ) //Only looking at players? Don't search full map.entities.
+			for ( int c = 0; c < MAXPLAYERS; ++c ) //Only looking at players.
 			{
-				entity = (Entity*)node->element;
-				if ( entity->behavior == &actPlayer )
+				entity = players[c] ? players[c]->entity : nullptr;
+				if ( entity )
 				{
 					if ( entity->x < 29 * 16 )   // hardcoded, I know...
 					{
@@ -533,216 +470,13 @@ void Entity::toggleSwitch()
 
 	//(my->skill[0]) ? my->sprite = 171 : my->sprite = 168;
 
-	list_t* neighbors = getPowerableNeighbors(); //Grab a list of all neighboring circuits and mechanisms.
-
-	if (neighbors)
-	{
-		node_t* node = NULL;
-		for (node = neighbors->first; node != NULL; node = node->next)
-		{
-			if (node->element)
-			{
-				Entity* powerable = (Entity*)(node->element);
-
-				if (powerable)
-				{
-					if (powerable->behavior == actCircuit)
-					{
-						(switch_power) ? powerable->circuitPowerOn() : powerable->circuitPowerOff();
-					}
-					else if ( powerable->behavior == &::actSignalTimer )
-					{
-						int x1 = static_cast<int>(this->x / 16);
-						int x2 = static_cast<int>(powerable->x / 16);
-						int y1 = static_cast<int>(this->y / 16);
-						int y2 = static_cast<int>(powerable->y / 16);
-						//messagePlayer(0, "%d, %d, %d, %d", x1, x2, y1, y2);
-						switch ( powerable->signalInputDirection )
-						{
-							case 0: // west
-								if ( (x1 + 1) == x2 )
-								{
-									(switch_power) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							case 1: // south
-								if ( (y1 - 1) == y2 )
-								{
-									(switch_power) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							case 2: // east
-								if ( (x1 - 1) == x2 )
-								{
-									(switch_power) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							case 3: // north
-								if ( (y1 + 1) == y2 )
-								{
-									(switch_power) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-								}
-								break;
-							default:
-								break;
-						}
-					}
-					else
-					{
-						(switch_power) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-					}
-				}
-			}
-		}
-
-		list_FreeAll(neighbors); //Free the list.
-		free(neighbors);
-	}
+	CircuitGraph.powerNeighbors(*this, switch_power, false);
 }
 
 void Entity::switchUpdateNeighbors()
 {
-	list_t* neighbors = getPowerableNeighbors(); //Grab a list of all neighboring circuits and mechanisms.
-
-	if (neighbors)
-	{
-		node_t* node = NULL;
-		for (node = neighbors->first; node != NULL; node = node->next)
-		{
-			if (node->element)
-			{
-				Entity* powerable = (Entity*)(node->element);
-
-				if (powerable)
-				{
-					if (powerable->circuit_status != CIRCUIT_ON)
-					{
-						if (powerable->behavior == actCircuit)
-						{
-							powerable->circuitPowerOn();
-						}
-						else if ( powerable->behavior == &::actSignalTimer )
-						{
-							int x1 = static_cast<int>(this->x / 16);
-							int x2 = static_cast<int>(powerable->x / 16);
-							int y1 = static_cast<int>(this->y / 16);
-							int y2 = static_cast<int>(powerable->y / 16);
-							//messagePlayer(0, "%d, %d, %d, %d", x1, x2, y1, y2);
-							switch ( powerable->signalInputDirection )
-							{
-								case 0: // west
-									if ( (x1 + 1) == x2 )
-									{
-										powerable->mechanismPowerOn();
-									}
-									break;
-								case 1: // south
-									if ( (y1 - 1) == y2 )
-									{
-										powerable->mechanismPowerOn();
-									}
-									break;
-								case 2: // east
-									if ( (x1 - 1) == x2 )
-									{
-										powerable->mechanismPowerOn();
-									}
-									break;
-								case 3: // north
-									if ( (y1 + 1) == y2 )
-									{
-										powerable->mechanismPowerOn();
-									}
-									break;
-								default:
-									break;
-							}
-						}
-						else
-						{
-							powerable->mechanismPowerOn();
-						}
-					}
-				}
-			}
-		}
-
-		list_FreeAll(neighbors); //Free the list.
-		free(neighbors);
-	}
-}
-
-void getPowerablesOnTile(int x, int y, list_t** list)
-{
-
-	//Take the return value of checkTileForEntity() and sort that list for powerables.
-	//if (entity->powerable == true)
-	//And then free the list returned by checkTileForEntity.
-
-	//Right. First, grab all the entities on the tile.
-	list_t* entities = NULL;
-	entities = checkTileForEntity(x, y);
-
-	if (!entities)
-	{
-		return;    //No use continuing, got no entities.
-	}
-
-	node_t* node = NULL;
-	node_t* node2 = NULL;
-	//Loop through the list of entities.
-	for (node = entities->first; node != NULL; node = node->next)
-	{
-		if (node->element)
-		{
-			Entity* entity = (Entity*) node->element;
-			//Check if the entity is powerable.
-			if (entity && entity->skill[28])   //If skill 28 = 0, the entity is not a powerable.
-			{
-				//If this is the first powerable found, the list needs to be created.
-				if (!(*list))
-				{
-					*list = (list_t*) malloc(sizeof(list_t));
-					(*list)->first = NULL;
-					(*list)->last = NULL;
-				}
-
-				//Add the current entity to it.
-				node2 = list_AddNodeLast(*list);
-				node2->element = entity;
-				node2->deconstructor = &emptyDeconstructor;
-			}
-		}
-	}
-
-	/*if (entities)
-	{
-		list_FreeAll(entities);
-		free(entities);
-	}*/
-
-	//return return_val;
-}
-
-list_t* Entity::getPowerableNeighbors()
-{
-	list_t* return_val = NULL;
-
-
-	int tx = x / 16;
-	int ty = y / 16;
-
-	getPowerablesOnTile(tx, ty, &return_val); //Check current tile
-	getPowerablesOnTile(tx - 1, ty, &return_val); //Check tile to the left.
-	getPowerablesOnTile(tx + 1, ty, &return_val); //Check tile to the right.
-	getPowerablesOnTile(tx, ty - 1, &return_val); //Check tile up.
-	getPowerablesOnTile(tx, ty + 1, &return_val); //Check tile down.
-	//getPowerablesOnTile(tx - 1, ty - 1, &return_val); //Check tile diagonal up left.
-	//getPowerablesOnTile(tx + 1, ty - 1, &return_val); //Check tile diagonal up right.
-	//getPowerablesOnTile(tx - 1, ty + 1, &return_val); //Check tile diagonal down left.
-	//getPowerablesOnTile(tx + 1, ty + 1, &return_val); //Check tile diagonal down right.
-
-	return return_val;
+	//Power on any neighboring circuits and mechanisms that aren't already on.
+	CircuitGraph.powerNeighbors(*this, true, true);
 }
 
 void actSoundSource(Entity* my)
@@ -835,7 +569,6 @@ void Entity::actSignalTimer()
 
 	int tx = x / 16;
 	int ty = y / 16;
-	list_t *neighbors = nullptr;
 	bool updateNeighbors = false;
 
 	if ( circuit_status == CIRCUIT_ON || signalTimerLatchInput == 2 )
@@ -925,77 +658,477 @@ void Entity::actSignalTimer()
 		switch ( signalInputDirection )
 		{
 			case 0: // west
-				getPowerablesOnTile(tx + 1, ty, &neighbors); //Check tile to the left.
+				CircuitGraph.powerTile(*this, tx + 1, ty, switch_power == SWITCH_POWERED, false); //Output to the east.
 				break;
 			case 1: // south
-				getPowerablesOnTile(tx, ty - 1, &neighbors); //Check tile to the north.
+				CircuitGraph.powerTile(*this, tx, ty - 1, switch_power == SWITCH_POWERED, false); //Output to the north.
 				break;
 			case 2: // east
-				getPowerablesOnTile(tx - 1, ty, &neighbors); //Check tile to the right.
+				CircuitGraph.powerTile(*this, tx - 1, ty, switch_power == SWITCH_POWERED, false); //Output to the west.
 				break;
 			case 3: // north
-				getPowerablesOnTile(tx, ty + 1, &neighbors); //Check tile to the south
+				CircuitGraph.powerTile(*this, tx, ty + 1, switch_power == SWITCH_POWERED, false); //Output to the south.
+				break;
+			default:
 				break;
 		}
-		if ( neighbors != nullptr )
+	}
+}
+/*-------------------------------------------------------------------------------
+
+	CircuitGraphHandler
+
+	see entity.hpp. tiles hold every powerable (skill[28] != 0) by map tile,
+	wires carry the id of their component. a wire touches the wires and
+	powerables on its own tile and the four next to it, as before.
+
+-------------------------------------------------------------------------------*/
+
+CircuitGraphHandler CircuitGraph;
+
+// signal timers only take input from the tile on their input side.
+static bool signalTimerFedFrom(int sx, int sy, Entity& timer)
+{
+	int tx = static_cast<int>(timer.x / 16);
+	int ty = static_cast<int>(timer.y / 16);
+	switch ( timer.signalInputDirection )
+	{
+		case 0: // west
+			return (sx + 1) == tx;
+		case 1: // south
+			return (sy - 1) == ty;
+		case 2: // east
+			return (sx - 1) == tx;
+		case 3: // north
+			return (sy + 1) == ty;
+		default:
+			return false;
+	}
+}
+
+static const int kNeighborTiles[5][2] = { { 0, 0 }, { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+
+std::vector<CircuitGraphHandler::TileNode_t>* CircuitGraphHandler::getTile(int x, int y)
+{
+	if ( x < 0 || y < 0 || x >= width || y >= height )
+	{
+		return nullptr;
+	}
+	return &tiles[x + y * width];
+}
+
+CircuitGraphHandler::TileNode_t* CircuitGraphHandler::findNode(Entity& entity)
+{
+	std::vector<TileNode_t>* tile = getTile(static_cast<int>(entity.x / 16), static_cast<int>(entity.y / 16));
+	if ( tile )
+	{
+		for ( auto& node : *tile )
+		{
+			if ( node.entity == &entity )
+			{
+				return &node;
+			}
+		}
+	}
+	return nullptr;
+}
+
+int CircuitGraphHandler::newComponent()
+{
+	if ( !freeComponents.empty() )
+	{
+		int id = freeComponents.back();
+		freeComponents.pop_back();
+		return id;
+	}
+	components.push_back(Component_t());
+	return static_cast<int>(components.size()) - 1;
+}
+
+void CircuitGraphHandler::floodComponent(int id, Entity& start)
+{
+	floodStack.clear();
+	floodStack.push_back(&start);
+	findNode(start)->component = id;
+	while ( !floodStack.empty() )
+	{
+		Entity* wire = floodStack.back();
+		floodStack.pop_back();
+		components[id].wires.push_back(wire);
+
+		int wx = static_cast<int>(wire->x / 16);
+		int wy = static_cast<int>(wire->y / 16);
+		for ( int i = 0; i < 5; ++i )
+		{
+			std::vector<TileNode_t>* tile = getTile(wx + kNeighborTiles[i][0], wy + kNeighborTiles[i][1]);
+			if ( !tile )
+			{
+				continue;
+			}
+			for ( auto& node : *tile )
+			{
+				if ( node.entity->behavior == actCircuit && node.component < 0 )
+				{
+					node.component = id;
+					floodStack.push_back(node.entity);
+				}
+			}
+		}
+	}
+}
+
+void CircuitGraphHandler::attachMechanismToWire(Entity& mechanism, const TileNode_t& wire)
+{
+	if ( mechanism.behavior == &::actSignalTimer
+		&& !signalTimerFedFrom(static_cast<int>(wire.entity->x / 16), static_cast<int>(wire.entity->y / 16), mechanism) )
+	{
+		return;
+	}
+	std::vector<Entity*>& mechanisms = components[wire.component].mechanisms;
+	if ( std::find(mechanisms.begin(), mechanisms.end(), &mechanism) == mechanisms.end() )
+	{
+		mechanisms.push_back(&mechanism);
+	}
+}
+
+void CircuitGraphHandler::attachMechanism(Entity& mechanism)
+{
+	int mx = static_cast<int>(mechanism.x / 16);
+	int my = static_cast<int>(mechanism.y / 16);
+	for ( int i = 0; i < 5; ++i )
+	{
+		std::vector<TileNode_t>* tile = getTile(mx + kNeighborTiles[i][0], my + kNeighborTiles[i][1]);
+		if ( !tile )
+		{
+			continue;
+		}
+		for ( auto& node : *tile )
 		{
-			node_t* node = nullptr;
-			for ( node = neighbors->first; node != nullptr; node = node->next )
+			if ( node.component >= 0 )
 			{
-				if ( node->element )
+				attachMechanismToWire(mechanism, node);
+			}
+		}
+	}
+}
+
+void CircuitGraphHandler::build()
+{
+	dirty = false;
+	width = map.width;
+	height = map.height;
+	tiles.clear();
+	tiles.resize(width * height);
+	components.clear();
+	freeComponents.clear();
+
+	for ( node_t* node = map.entities->first; node != nullptr; node = node->next )
+	{
+		Entity* entity = (Entity*)node->element;
+		if ( entity && entity->circuit_status )
+		{
+			std::vector<TileNode_t>* tile = getTile(static_cast<int>(entity->x / 16), static_cast<int>(entity->y / 16));
+			if ( tile )
+			{
+				tile->push_back(TileNode_t{ entity, -1 });
+			}
+		}
+	}
+	for ( auto& tile : tiles )
+	{
+		for ( size_t i = 0; i < tile.size(); ++i )
+		{
+			if ( tile[i].entity->behavior == actCircuit && tile[i].component < 0 )
+			{
+				floodComponent(newComponent(), *tile[i].entity);
+			}
+		}
+	}
+	for ( auto& tile : tiles )
+	{
+		for ( auto& node : tile )
+		{
+			if ( node.component < 0 )
+			{
+				attachMechanism(*node.entity);
+			}
+		}
+	}
+}
+
+void CircuitGraphHandler::addPowerable(Entity& entity)
+{
+	if ( dirty || !entity.circuit_status )
+	{
+		return;
+	}
+	if ( !staleComponents.empty() )
+	{
+		refloodStaleComponents();
+	}
+	if ( findNode(entity) )
+	{
+		return;
+	}
+	int ex = static_cast<int>(entity.x / 16);
+	int ey = static_cast<int>(entity.y / 16);
+	std::vector<TileNode_t>* tile = getTile(ex, ey);
+	if ( !tile )
+	{
+		return;
+	}
+	tile->push_back(TileNode_t{ &entity, -1 });
+
+	if ( entity.behavior != actCircuit )
+	{
+		attachMechanism(entity);
+		return;
+	}
+
+	// join every component this wire touches into one
+	int id = -1;
+	for ( int i = 0; i < 5; ++i )
+	{
+		std::vector<TileNode_t>* neighbor = getTile(ex + kNeighborTiles[i][0], ey + kNeighborTiles[i][1]);
+		if ( !neighbor )
+		{
+			continue;
+		}
+		for ( auto& node : *neighbor )
+		{
+			if ( node.component < 0 || node.component == id )
+			{
+				continue;
+			}
+			if ( id < 0 )
+			{
+				id = node.component;
+				continue;
+			}
+			int merged = node.component;
+			Component_t& from = components[merged];
+			for ( Entity* wire : from.wires )
+			{
+				findNode(*wire)->component = id;
+				components[id].wires.push_back(wire);
+			}
+			for ( Entity* mechanism : from.mechanisms )
+			{
+				std::vector<Entity*>& mechanisms = components[id].mechanisms;
+				if ( std::find(mechanisms.begin(), mechanisms.end(), mechanism) == mechanisms.end() )
 				{
-					Entity* powerable = (Entity*)(node->element);
+					mechanisms.push_back(mechanism);
+				}
+			}
+			from.wires.clear();
+			from.mechanisms.clear();
+			freeComponents.push_back(merged);
+		}
+	}
+
+	TileNode_t* node = findNode(entity);
+	if ( id < 0 )
+	{
+		id = newComponent();
+	}
+	node->component = id;
+	components[id].wires.push_back(&entity);
+
+	for ( int i = 0; i < 5; ++i )
+	{
+		std::vector<TileNode_t>* neighbor = getTile(ex + kNeighborTiles[i][0], ey + kNeighborTiles[i][1]);
+		if ( !neighbor )
+		{
+			continue;
+		}
+		for ( auto& other : *neighbor )
+		{
+			if ( other.component < 0 )
+			{
+				attachMechanismToWire(*other.entity, *node);
+			}
+		}
+	}
+}
+
+void CircuitGraphHandler::removePowerable(Entity& entity)
+{
+	if ( dirty )
+	{
+		return;
+	}
+	TileNode_t* node = findNode(entity);
+	if ( !node )
+	{
+		return;
+	}
+	const int id = node->component;
+	int ex = static_cast<int>(entity.x / 16);
+	int ey = static_cast<int>(entity.y / 16);
+	std::vector<TileNode_t>* tile = getTile(ex, ey);
+	tile->erase(tile->begin() + (node - tile->data()));
+
+	if ( id >= 0 )
+	{
+		// the component may have split. it's flooded again before power next moves,
+		// so clearing a whole level doesn't reflood once per wire.
+		if ( std::find(staleComponents.begin(), staleComponents.end(), id) == staleComponents.end() )
+		{
+			staleComponents.push_back(id);
+		}
+		return;
+	}
+
+	for ( int i = 0; i < 5; ++i )
+	{
+		std::vector<TileNode_t>* neighbor = getTile(ex + kNeighborTiles[i][0], ey + kNeighborTiles[i][1]);
+		if ( !neighbor )
+		{
+			continue;
+		}
+		for ( auto& wire : *neighbor )
+		{
+			if ( wire.component < 0 )
+			{
+				continue;
+			}
+			std::vector<Entity*>& mechanisms = components[wire.component].mechanisms;
+			auto it = std::find(mechanisms.begin(), mechanisms.end(), &entity);
+			if ( it != mechanisms.end() )
+			{
+				mechanisms.erase(it);
+			}
+		}
+	}
+}
 
-					if ( powerable )
+void CircuitGraphHandler::refloodStaleComponents()
+{
+	for ( int id : staleComponents )
+	{
+		components[id].wires.clear();
+		components[id].mechanisms.clear();
+		freeComponents.push_back(id);
+	}
+	for ( auto& tile : tiles )
+	{
+		for ( auto& node : tile )
+		{
+			if ( node.component >= 0
+				&& std::find(staleComponents.begin(), staleComponents.end(), node.component) != staleComponents.end() )
+			{
+				node.component = -1;
+			}
+		}
+	}
+	staleComponents.clear();
+
+	for ( auto& tile : tiles )
+	{
+		for ( size_t i = 0; i < tile.size(); ++i )
+		{
+			if ( tile[i].entity->behavior != actCircuit || tile[i].component >= 0 )
+			{
+				continue;
+			}
+			const int id = newComponent();
+			floodComponent(id, *tile[i].entity);
+			for ( Entity* wire : components[id].wires )
+			{
+				const TileNode_t& wireNode = *findNode(*wire);
+				int wx = static_cast<int>(wire->x / 16);
+				int wy = static_cast<int>(wire->y / 16);
+				for ( int j = 0; j < 5; ++j )
+				{
+					std::vector<TileNode_t>* neighbor = getTile(wx + kNeighborTiles[j][0], wy + kNeighborTiles[j][1]);
+					if ( !neighbor )
 					{
-						if ( powerable->behavior == actCircuit )
-						{
-							(switch_power == SWITCH_POWERED) ? powerable->circuitPowerOn() : powerable->circuitPowerOff();
-						}
-						else
+						continue;
+					}
+					for ( auto& other : *neighbor )
+					{
+						if ( other.component < 0 && other.entity->behavior != actCircuit )
 						{
-							if ( powerable->behavior == &::actSignalTimer )
-							{
-								switch ( powerable->signalInputDirection )
-								{
-									case 0: // west
-										if ( static_cast<int>(this->x / 16) == static_cast<int>((powerable->x / 16) - 1) )
-										{
-											(switch_power == SWITCH_POWERED) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-										}
-										break;
-									case 1: // south
-										if ( static_cast<int>(this->y / 16) == static_cast<int>((powerable->y / 16) - 1) )
-										{
-											(switch_power == SWITCH_POWERED) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-										}
-										break;
-									case 2: // east
-										if ( static_cast<int>(this->x / 16) == static_cast<int>((powerable->x / 16) + 1) )
-										{
-											(switch_power == SWITCH_POWERED) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-										}
-										break;
-									case 3: // north
-										if ( static_cast<int>(this->y / 16) == static_cast<int>((powerable->y / 16) + 1) )
-										{
-											(switch_power == SWITCH_POWERED) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-										}
-										break;
-									default:
-										break;
-								}
-							}
-							else
-							{
-								(switch_power == SWITCH_POWERED) ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
-							}
+							attachMechanismToWire(*other.entity, wireNode);
 						}
 					}
 				}
 			}
-			list_FreeAll(neighbors); //Free the list.
-			free(neighbors);
 		}
 	}
-}
\ No newline at end of file
+}
+
+void CircuitGraphHandler::prepare()
+{
+	if ( dirty )
+	{
+		build();
+	}
+	else if ( !staleComponents.empty() )
+	{
+		refloodStaleComponents();
+	}
+}
+
+void CircuitGraphHandler::powerWire(Entity& wire, bool powerOn)
+{
+	prepare();
+	Sint32 status = Entity::CIRCUIT_OFF;
+	if ( powerOn )
+	{
+		status = Entity::CIRCUIT_ON;
+	}
+	TileNode_t* node = findNode(wire);
+	if ( !node || node->component < 0 )
+	{
+		wire.circuit_status = status;
+		return;
+	}
+	Component_t& component = components[node->component];
+	for ( Entity* member : component.wires )
+	{
+		member->circuit_status = status;
+	}
+	for ( Entity* mechanism : component.mechanisms )
+	{
+		powerOn ? mechanism->mechanismPowerOn() : mechanism->mechanismPowerOff();
+	}
+}
+
+void CircuitGraphHandler::powerTile(Entity& source, int x, int y, bool powerOn, bool onlyUnpowered)
+{
+	prepare();
+	std::vector<TileNode_t>* tile = getTile(x, y);
+	if ( !tile )
+	{
+		return;
+	}
+	const int sx = static_cast<int>(source.x / 16);
+	const int sy = static_cast<int>(source.y / 16);
+	for ( auto& node : *tile )
+	{
+		Entity* powerable = node.entity;
+		if ( onlyUnpowered && powerable->circuit_status == Entity::CIRCUIT_ON )
+		{
+			continue;
+		}
+		if ( powerable->behavior == actCircuit )
+		{
+			powerOn ? powerable->circuitPowerOn() : powerable->circuitPowerOff();
+		}
+		else if ( powerable->behavior != &::actSignalTimer || signalTimerFedFrom(sx, sy, *powerable) )
+		{
+			powerOn ? powerable->mechanismPowerOn() : powerable->mechanismPowerOff();
+		}
+	}
+}
+
+void CircuitGraphHandler::powerNeighbors(Entity& source, bool powerOn, bool onlyUnpowered)
+{
+	const int sx = static_cast<int>(source.x / 16);
+	const int sy = static_cast<int>(source.y / 16);
+	for ( int i = 0; i < 5; ++i )
+	{
+		powerTile(source, sx + kNeighborTiles[i][0], sy + kNeighborTiles[i][1], powerOn, onlyUnpowered);
+	}
+}
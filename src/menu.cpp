@@ -1563,719 +1563,988 @@ void handleTutorialPauseMenu()
 
 /*-------------------------------------------------------------------------------
 
-	handleMainMenu
+	doNewGame
 
-	draws & processes the game menu; if passed true, does the whole menu,
-	otherwise just handles the reduced ingame menu
+	sets up and loads the first level of a new game (or a loaded save).
+	mode is the same as handleMainMenu's: true if starting from the main menu,
+	false when restarting midgame.
 
 -------------------------------------------------------------------------------*/
 
-void handleMainMenu(bool mode)
+void doNewGame(bool mode)
 {
-	int x, c;
-	//int y;
-	bool b;
-	//int tilesreceived=0;
-	//Mix_Music **music, *intromusic, *splashmusic, *creditsmusic;
+	int c;
 	node_t* node, *nextnode;
 	Entity* entity;
-	//SDL_Surface *sky_bmp;
-	button_t* button;
-	Sint32 mousex = inputs.getMouse(clientnum, Inputs::MouseInputs::X);
-	Sint32 mousey = inputs.getMouse(clientnum, Inputs::MouseInputs::Y);
-	Sint32 omousex = inputs.getMouse(clientnum, Inputs::MouseInputs::OX);
-	Sint32 omousey = inputs.getMouse(clientnum, Inputs::MouseInputs::OY);
 
-#ifdef STEAMWORKS
-	if ( SteamApps()->BIsDlcInstalled(1010820) )
+	bool bWasOnMainMenu = intro;
+	introstage = 1;
+	fadefinished = false;
+	fadeout = false;
+	gamePaused = false;
+	multiplayerselect = SINGLE;
+	intro = true; //Fix items auto-adding to the hotbar on game restart.
+
+	if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT )
 	{
-		enabledDLCPack1 = true;
+		if ( !mode )
+		{
+			// restarting game, make a highscore
+			saveScore();
+			deleteSaveGame(multiplayer);
+			loadingsavegame = 0;
+		}
 	}
-	if ( SteamApps()->BIsDlcInstalled(1010821) )
+	camera_charsheet_offsetyaw = (330) * PI / 180; // reset player camera view.
+
+	// undo shopkeeper grudge
+	swornenemies[SHOPKEEPER][HUMAN] = false;
+	monsterally[SHOPKEEPER][HUMAN] = true;
+	swornenemies[SHOPKEEPER][AUTOMATON] = false;
+	monsterally[SHOPKEEPER][AUTOMATON] = true;
+
+	// setup game
+	entity_uids = 1;
+	loading = true;
+	darkmap = false;
+
+	for ( int i = 0; i < MAXPLAYERS; ++i )
 	{
-		enabledDLCPack2 = true;
+		players[i]->init();
+		players[i]->hud.reset();
+		deinitShapeshiftHotbar(i);
+		for ( c = 0; c < NUM_HOTBAR_ALTERNATES; ++c )
+		{
+			players[i]->hotbar.hotbarShapeshiftInit[c] = false;
+		}
+		players[i]->shootmode = true;
+		players[i]->magic.clearSelectedSpells();
+		enemyHPDamageBarHandler[i].HPBars.clear();
 	}
-#else
-#endif // STEAMWORKS
-	if ( menuOptions.empty() )
+	currentlevel = startfloor;
+	secretlevel = false;
+	victory = 0;
+	completionTime = 0;
+
+	setDefaultPlayerConducts(); // penniless, foodless etc.
+	if ( startfloor != 0 )
 	{
-		initMenuOptions();
+		conductGameChallenges[CONDUCT_CHEATS_ENABLED] = 1;
 	}
 
-	if ( !movie )
+	for ( int i = 0; i < MAXPLAYERS; ++i )
 	{
-		// title pic
-		SDL_Rect src;
-		src.x = 20;
-		src.y = 20;
-		src.w = title_bmp->w * (230.0 / 240.0); // new banner scaled to old size.
-		src.h = title_bmp->h * (230.0 / 240.0);
-		if ( mode || introstage != 5 )
+		minimapPings[i].clear(); // clear minimap pings
+	}
+	globalLightModifierActive = GLOBAL_LIGHT_MODIFIER_STOPPED;
+	gameplayCustomManager.readFromFile();
+	textSourceScript.scriptVariables.clear();
+
+	if ( multiplayer == CLIENT )
+	{
+		gameModeManager.currentSession.saveServerFlags();
+		svFlags = lobbyWindowSvFlags;
+	}
+	else if ( !loadingsavegame && bWasOnMainMenu )
+	{
+		gameModeManager.currentSession.saveServerFlags();
+	}
+
+	if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_TUTORIAL )
+	{
+		svFlags &= ~(SV_FLAG_HARDCORE);
+		svFlags &= ~(SV_FLAG_CHEATS);
+		svFlags &= ~(SV_FLAG_LIFESAVING);
+		svFlags &= ~(SV_FLAG_CLASSIC);
+		svFlags &= ~(SV_FLAG_KEEPINVENTORY);
+		svFlags |= SV_FLAG_HUNGER;
+		svFlags |= SV_FLAG_FRIENDLYFIRE;
+		svFlags |= SV_FLAG_MINOTAURS;
+		svFlags |= SV_FLAG_TRAPS;
+
+		if ( gameModeManager.Tutorial.dungeonLevel >= 0 )
 		{
-			drawImageScaled(title_bmp, nullptr, &src);
+			currentlevel = gameModeManager.Tutorial.dungeonLevel;
+			gameModeManager.Tutorial.dungeonLevel = -1;
 		}
-		if ( mode && subtitleVisible )
+	}
+
+	for ( int i = 0; i < MAXPLAYERS; ++i )
+	{
+		// clear follower menu entities.
+		FollowerMenu[i].closeFollowerMenuGUI(true);
+		list_FreeAll(&damageIndicators[i]);
+	}
+	for ( c = 0; c < NUMMONSTERS; c++ )
+	{
+		kills[c] = 0;
+	}
+
+	// close chests
+	for ( c = 0; c < MAXPLAYERS; ++c )
+	{
+		if ( players[c]->isLocalPlayer() )
 		{
-			Uint32 colorYellow = SDL_MapRGBA(mainsurface->format, 255, 255, 0, 255);
-			Uint32 len = strlen(language[1910 + subtitleCurrent]);
-			ttfPrintTextColor(ttf16, src.x + src.w / 2 - (len * TTF16_WIDTH) / 2, src.y + src.h - 32, colorYellow, true, language[1910 + subtitleCurrent]);
+			if ( openedChest[c] )
+			{
+				openedChest[c]->closeChest();
+			}
 		}
-#ifdef STEAMWORKS
-		if ( mode )
+		else if ( c > 0 && !client_disconnected[c] )
 		{
-			// print community links
-			if ( SteamUser()->BLoggedOn() )
+			if ( openedChest[c] )
 			{
-				if ( ticks % 50 == 0 )
-				{
-					UIToastNotificationManager.createCommunityNotification();
-				}
-
-				// upgrade steam achievement for existing hunters
-				if ( ticks % 250 == 0 )
-				{
-					bool unlocked = false;
-					if ( SteamUserStats()->GetAchievement("BARONY_ACH_GUDIPARIAN_BAZI", &unlocked) )
-					{
-						if ( unlocked )
-						{
-							steamAchievement("BARONY_ACH_RANGER_DANGER");
-						}
-					}
-				}
+				openedChest[c]->closeChestServer();
 			}
 		}
+	}
+
+	// disable cheats
+	noclip = false;
+	godmode = false;
+	buddhamode = false;
+	everybodyfriendly = false;
+	gameloopFreezeEntities = false;
+
+#ifdef STEAMWORKS
+	if ( !directConnect )
+	{
+		if ( currentLobby )
+		{
+			// once the game is started, the lobby is no longer needed.
+			// when all steam users have left the lobby,
+			// the lobby is destroyed automatically on the backend.
+
+			SteamMatchmaking()->LeaveLobby(*static_cast<CSteamID*>(currentLobby));
+			cpp_Free_CSteamID(currentLobby); //TODO: Bugger this.
+			currentLobby = NULL;
+		}
+	}
 #elif defined USE_EOS
-		if ( mode )
+	if ( !directConnect )
+	{
+		/*if ( EOS.CurrentLobbyData.currentLobbyIsValid() )
 		{
-			if ( ticks % 50 == 0 )
-			{
-				UIToastNotificationManager.createCommunityNotification();
-			}
+			EOS.leaveLobby();
+		}*/
+	}
+#endif
+
+	// load dungeon
+	if ( multiplayer != CLIENT )
+	{
+		// stop all sounds
+#ifdef USE_FMOD
+		if ( sound_group )
+		{
+			FMOD_ChannelGroup_Stop(sound_group);
+		}
+		if ( soundAmbient_group )
+		{
+			FMOD_ChannelGroup_Stop(soundAmbient_group);
+		}
+		if ( soundEnvironment_group )
+		{
+			FMOD_ChannelGroup_Stop(soundEnvironment_group);
+		}
+#elif defined USE_OPENAL
+		if ( sound_group )
+		{
+			OPENAL_ChannelGroup_Stop(sound_group);
+		}
+		if ( soundAmbient_group )
+		{
+			OPENAL_ChannelGroup_Stop(soundAmbient_group);
+		}
+		if ( soundEnvironment_group )
+		{
+			OPENAL_ChannelGroup_Stop(soundEnvironment_group);
 		}
 #endif
 
-#ifdef USE_EOS
-		if ( mode && EOS.StatGlobalManager.bPromoEnabled )
+		// generate a unique game key (used to identify compatible save games)
+		prng_seed_time();
+		if ( multiplayer == SINGLE )
 		{
-			if ( ticks % 100 == 0 )
+			uniqueGameKey = prng_get_uint();
+			if ( !uniqueGameKey )
 			{
-				UIToastNotificationManager.createPromoNotification();
+				uniqueGameKey++;
 			}
 		}
-#endif
 
-		// gray text color
-		Uint32 colorGray = SDL_MapRGBA(mainsurface->format, 128, 128, 128, 255);
+		// reset class loadout
+		if ( !loadingsavegame )
+		{
+			stats[0]->clearStats();
+			initClass(0);
+			mapseed = 0;
+		}
+		else
+		{
+			loadGame(0);
+		}
 
-		// print game version
-		if ( mode || introstage != 5 )
+		// hack to fix these things from breaking everything...
+		for ( int i = 0; i < MAXPLAYERS; ++i )
 		{
-			char version[64];
-			strcpy(version, __DATE__ + 7);
-			strcat(version, ".");
-			if ( !strncmp(__DATE__, "Jan", 3) )
-			{
-				strcat(version, "01");
-			}
-			else if ( !strncmp(__DATE__, "Feb", 3) )
-			{
-				strcat(version, "02");
-			}
-			else if ( !strncmp(__DATE__, "Mar", 3) )
-			{
-				strcat(version, "03");
-			}
-			else if ( !strncmp(__DATE__, "Apr", 3) )
-			{
-				strcat(version, "04");
-			}
-			else if ( !strncmp(__DATE__, "May", 3) )
-			{
-				strcat(version, "05");
-			}
-			else if ( !strncmp(__DATE__, "Jun", 3) )
-			{
-				strcat(version, "06");
-			}
-			else if ( !strncmp(__DATE__, "Jul", 3) )
-			{
-				strcat(version, "07");
-			}
-			else if ( !strncmp(__DATE__, "Aug", 3) )
-			{
-				strcat(version, "08");
-			}
-			else if ( !strncmp(__DATE__, "Sep", 3) )
-			{
-				strcat(version, "09");
-			}
-			else if ( !strncmp(__DATE__, "Oct", 3) )
-			{
-				strcat(version, "10");
-			}
-			else if ( !strncmp(__DATE__, "Nov", 3) )
-			{
-				strcat(version, "11");
-			}
-			else if ( !strncmp(__DATE__, "Dec", 3) )
+			players[i]->hud.arm = nullptr;
+			players[i]->hud.weapon = nullptr;
+			players[i]->hud.magicLeftHand = nullptr;
+			players[i]->hud.magicRightHand = nullptr;
+		}
+
+		for ( node = map.entities->first; node != nullptr; node = node->next )
+		{
+			entity = (Entity*)node->element;
+			entity->flags[NOUPDATE] = true;
+		}
+		lastEntityUIDs = entity_uids;
+		numplayers = 0;
+		int checkMapHash = -1;
+		if ( loadingmap == false )
+		{
+			physfsLoadMapFile(currentlevel, mapseed, false, &checkMapHash);
+			if ( checkMapHash == 0 )
 			{
-				strcat(version, "12");
+				conductGameChallenges[CONDUCT_MODDED] = 1;
 			}
-			strcat(version, ".");
-			int day = atoi(__DATE__ + 4);
-			if (day >= 10)
+		}
+		else
+		{
+			if ( genmap == false )
 			{
-				strncat(version, __DATE__ + 4, 2);
+				std::string fullMapName = physfsFormatMapName(maptoload);
+				loadMap(fullMapName.c_str(), &map, map.entities, map.creatures, &checkMapHash);
+				if ( checkMapHash == 0 )
+				{
+					conductGameChallenges[CONDUCT_MODDED] = 1;
+				}
 			}
 			else
 			{
-				strcat(version, "0");
-				strncat(version, __DATE__ + 5, 1);
+				generateDungeon(maptoload, mapseed);
 			}
-			int w, h;
-			getSizeOfText(ttf8, version, &w, &h);
-			ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 4 - h, "%s", version);
-			int h2 = h;
-			getSizeOfText(ttf8, VERSION, &w, &h);
-			ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 8 - h - h2, VERSION);
-			if ( gamemods_numCurrentModsLoaded >= 0 || conductGameChallenges[CONDUCT_MODDED] )
+		}
+		assignActions(&map);
+		generatePathMaps();
+
+		achievementObserver.updateData();
+
+		if ( loadingsavegame )
+		{
+			for ( c = 0; c < MAXPLAYERS; c++ )
 			{
-				if ( gamemods_numCurrentModsLoaded >= 0 )
-				{
-					ttfPrintTextFormatted(ttf8, xres - 8 - TTF8_WIDTH * 16, yres - 12 - h - h2 * 2, "%2d mod(s) loaded", gamemods_numCurrentModsLoaded);
-				}
-				else if ( !mode )
+				if ( players[c] && players[c]->entity && !client_disconnected[c] )
 				{
-					ttfPrintTextFormatted(ttf8, xres - 8 - TTF8_WIDTH * 24, yres - 12 - h - h2 * 2, "Using modified map files");
+					if ( stats[c] && stats[c]->EFFECTS[EFF_POLYMORPH] && stats[c]->playerPolymorphStorage != NOTHING )
+					{
+						players[c]->entity->effectPolymorph = stats[c]->playerPolymorphStorage;
+						serverUpdateEntitySkill(players[c]->entity, 50); // update visual polymorph effect for clients.
+						serverUpdateEffects(c);
+					}
+					if ( stats[c] && stats[c]->EFFECTS[EFF_SHAPESHIFT] && stats[c]->playerShapeshiftStorage != NOTHING )
+					{
+						players[c]->entity->effectShapeshift = stats[c]->playerShapeshiftStorage;
+						serverUpdateEntitySkill(players[c]->entity, 53); // update visual shapeshift effect for clients.
+						serverUpdateEffects(c);
+					}
+					if ( stats[c] && stats[c]->EFFECTS[EFF_VAMPIRICAURA] && stats[c]->EFFECTS_TIMERS[EFF_VAMPIRICAURA] == -2 )
+					{
+						players[c]->entity->playerVampireCurse = 1;
+						serverUpdateEntitySkill(players[c]->entity, 51); // update curse progression
+					}
 				}
 			}
-#if (defined STEAMWORKS || defined USE_EOS)
-			if ( gamemods_disableSteamAchievements
-				|| (intro == false && 
-					(conductGameChallenges[CONDUCT_CHEATS_ENABLED]
-					|| conductGameChallenges[CONDUCT_LIFESAVING])) )
+
+			list_t* followers = loadGameFollowers();
+			if ( followers )
 			{
-				getSizeOfText(ttf8, language[3003], &w, &h);
-				if ( gamemods_numCurrentModsLoaded < 0 && !conductGameChallenges[CONDUCT_MODDED] )
-				{
-					h = -4;
-				}
-				if ( gameModeManager.getMode() != GameModeManager_t::GAME_MODE_DEFAULT )
-				{
-					// achievements are disabled
-					ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 16 - h - h2 * 3, language[3003]);
-				}
-				else
+				int c;
+				for ( c = 0; c < MAXPLAYERS; c++ )
 				{
-					// achievements are disabled
-					ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 16 - h - h2 * 3, language[3003]);
-				}
-			}
-#endif
+					node_t* tempNode = list_Node(followers, c);
+					if ( tempNode )
+					{
+						list_t* tempFollowers = (list_t*)tempNode->element;
+						if (players[c] && players[c]->entity && !client_disconnected[c])
+						{
+							node_t* node;
+							node_t* gyrobotNode = nullptr;
+							Entity* gyrobotEntity = nullptr;
+							std::vector<node_t*> allyRobotNodes;
+							for ( node = tempFollowers->first; node != NULL; node = node->next )
+							{
+								Stat* tempStats = (Stat*)node->element;
+								if ( tempStats && tempStats->type == GYROBOT )
+								{
+									gyrobotNode = node;
+									break;
+								}
+							}
+							for ( node = tempFollowers->first; node != NULL; node = node->next )
+							{
+								Stat* tempStats = (Stat*)node->element;
+								if ( tempStats && (tempStats->type == DUMMYBOT
+									|| tempStats->type == SENTRYBOT
+									|| tempStats->type == SPELLBOT) )
+								{
+									// gyrobot will pick up these guys into it's inventory, otherwise leave them behind.
+									if ( gyrobotNode )
+									{
+										allyRobotNodes.push_back(node);
+									}
+									continue;
+								}
+								Entity* monster = summonMonster(tempStats->type, players[c]->entity->x, players[c]->entity->y);
+								if ( monster )
+								{
+									if ( node == gyrobotNode )
+									{
+										gyrobotEntity = monster;
+									}
+									monster->skill[3] = 1; // to mark this monster partially initialized
+									list_RemoveNode(monster->children.last);
+
+									node_t* newNode = list_AddNodeLast(&monster->children);
+									newNode->element = tempStats->copyStats();
+									newNode->deconstructor = &statDeconstructor;
+									newNode->size = sizeof(tempStats);
+
+									Stat* monsterStats = (Stat*)newNode->element;
+									monsterStats->leader_uid = players[c]->entity->getUID();
+									monster->flags[USERFLAG2] = true;
+									/*if ( !monsterally[HUMAN][monsterStats->type] )
+									{
+									}*/
+									monster->monsterAllyIndex = c;
+									if ( multiplayer == SERVER )
+									{
+										serverUpdateEntitySkill(monster, 42); // update monsterAllyIndex for clients.
+									}
 
-#ifdef STEAMWORKS
-			getSizeOfText(ttf8, language[2549], &w, &h);
-			if ( (omousex >= xres - 8 - w && omousex < xres && omousey >= 8 && omousey < 8 + h)
-				&& subwindow == 0
-				&& introstage == 1
-				&& SteamUser()->BLoggedOn() )
-			{
-				if ( inputs.bMouseLeft(clientnum) )
-				{
-					inputs.mouseClearLeft(clientnum);
-					playSound(139, 64);
-					SteamAPICall_NumPlayersOnline = SteamUserStats()->GetNumberOfCurrentPlayers();
+									if ( multiplayer != CLIENT )
+									{
+										monster->monsterAllyClass = monsterStats->allyClass;
+										monster->monsterAllyPickupItems = monsterStats->allyItemPickup;
+										if ( stats[c]->playerSummonPERCHR != 0 && !strcmp(monsterStats->name, "skeleton knight") )
+										{
+											monster->monsterAllySummonRank = (stats[c]->playerSummonPERCHR & 0x0000FF00) >> 8;
+										}
+										else if ( stats[c]->playerSummon2PERCHR != 0 && !strcmp(monsterStats->name, "skeleton sentinel") )
+										{
+											monster->monsterAllySummonRank = (stats[c]->playerSummon2PERCHR & 0x0000FF00) >> 8;
+										}
+										serverUpdateEntitySkill(monster, 46); // update monsterAllyClass
+										serverUpdateEntitySkill(monster, 44); // update monsterAllyPickupItems
+										serverUpdateEntitySkill(monster, 50); // update monsterAllySummonRank
+									}
+
+									newNode = list_AddNodeLast(&stats[c]->FOLLOWERS);
+									newNode->deconstructor = &defaultDeconstructor;
+									Uint32* myuid = (Uint32*) malloc(sizeof(Uint32));
+									newNode->element = myuid;
+									*myuid = monster->getUID();
+
+									if ( c > 0 && multiplayer == SERVER )
+									{
+										strcpy((char*)net_packet->data, "LEAD");
+										SDLNet_Write32((Uint32)monster->getUID(), &net_packet->data[4]);
+										strcpy((char*)(&net_packet->data[8]), monsterStats->name);
+										net_packet->data[8 + strlen(monsterStats->name)] = 0;
+										net_packet->address.host = net_clients[c - 1].host;
+										net_packet->address.port = net_clients[c - 1].port;
+										net_packet->len = 8 + strlen(monsterStats->name) + 1;
+										sendPacketSafe(net_sock, -1, net_packet, c - 1);
+
+										serverUpdateAllyStat(c, monster->getUID(), monsterStats->LVL, monsterStats->HP, monsterStats->MAXHP, monsterStats->type);
+									}
+
+									if ( !FollowerMenu[c].recentEntity && players[c]->isLocalPlayer() )
+									{
+										FollowerMenu[c].recentEntity = monster;
+									}
+								}
+							}
+							if ( gyrobotEntity && !allyRobotNodes.empty() )
+							{
+								Stat* gyroStats = gyrobotEntity->getStats();
+								for ( auto it = allyRobotNodes.begin(); gyroStats && it != allyRobotNodes.end(); ++it )
+								{
+									node_t* botNode = *it;
+									if ( botNode )
+									{
+										Stat* tempStats = (Stat*)botNode->element;
+										if ( tempStats )
+										{
+											ItemType type = WOODEN_SHIELD;
+											if ( tempStats->type == SENTRYBOT )
+											{
+												type = TOOL_SENTRYBOT;
+											}
+											else if ( tempStats->type == SPELLBOT )
+											{
+												type = TOOL_SPELLBOT;
+											}
+											else if ( tempStats->type == DUMMYBOT )
+											{
+												type = TOOL_DUMMYBOT;
+											}
+											int appearance = monsterTinkeringConvertHPToAppearance(tempStats);
+											if ( type != WOODEN_SHIELD )
+											{
+												Item* item = newItem(type, static_cast<Status>(tempStats->monsterTinkeringStatus), 
+													0, 1, appearance, true, &gyroStats->inventory);
+											}
+										}
+									}
+								}
+							}
+						}
+					}
 				}
-				ttfPrintTextFormattedColor(ttf8, xres - 8 - w, 8, colorGray, language[2549], steamOnlinePlayers);
+				list_FreeAll(followers);
+				free(followers);
 			}
-			else if ( SteamUser()->BLoggedOn() )
+		}
+
+		if ( multiplayer == SINGLE )
+		{
+			saveGame();
+		}
+	}
+	else
+	{
+		// hack to fix these things from breaking everything...
+		for ( int i = 0; i < MAXPLAYERS; ++i )
+		{
+			players[i]->hud.arm = nullptr;
+			players[i]->hud.weapon = nullptr;
+			players[i]->hud.magicLeftHand = nullptr;
+			players[i]->hud.magicRightHand = nullptr;
+		}
+
+		client_disconnected[0] = false;
+
+		// initialize class
+		if ( !loadingsavegame )
+		{
+			stats[clientnum]->clearStats();
+			initClass(clientnum);
+			mapseed = 0;
+		}
+		else
+		{
+			loadGame(clientnum);
+		}
+
+		// stop all sounds
+#ifdef USE_FMOD
+		if ( sound_group )
+		{
+			FMOD_ChannelGroup_Stop(sound_group);
+		}
+		if ( soundAmbient_group )
+		{
+			FMOD_ChannelGroup_Stop(soundAmbient_group);
+		}
+		if ( soundEnvironment_group )
+		{
+			FMOD_ChannelGroup_Stop(soundEnvironment_group);
+		}
+#elif defined USE_OPENAL
+		if ( sound_group )
+		{
+			OPENAL_ChannelGroup_Stop(sound_group);
+		}
+		if ( soundAmbient_group )
+		{
+			OPENAL_ChannelGroup_Stop(soundAmbient_group);
+		}
+		if ( soundEnvironment_group )
+		{
+			OPENAL_ChannelGroup_Stop(soundEnvironment_group);
+		}
+#endif
+		// load next level
+		entity_uids = 1;
+		lastEntityUIDs = entity_uids;
+		numplayers = 0;
+
+		int checkMapHash = -1;
+		if ( loadingmap == false )
+		{
+			physfsLoadMapFile(currentlevel, mapseed, false, &checkMapHash);
+			if ( checkMapHash == 0 )
 			{
-				ttfPrintTextFormatted(ttf8, xres - 8 - w, 8, language[2549], steamOnlinePlayers);
+				conductGameChallenges[CONDUCT_MODDED] = 1;
 			}
-			if ( intro == false )
+		}
+		else
+		{
+			if ( genmap == false )
 			{
-				if ( conductGameChallenges[CONDUCT_CHEATS_ENABLED] )
+				std::string fullMapName = physfsFormatMapName(maptoload);
+				loadMap(fullMapName.c_str(), &map, map.entities, map.creatures, &checkMapHash);
+				if ( checkMapHash == 0 )
 				{
-					getSizeOfText(ttf8, language[2986], &w, &h);
-					ttfPrintTextFormatted(ttf8, xres - 8 - w, 8 + h, language[2986]);
+					conductGameChallenges[CONDUCT_MODDED] = 1;
 				}
 			}
-			if ( SteamUser()->BLoggedOn() && SteamAPICall_NumPlayersOnline == 0 )
-			{
-				SteamAPICall_NumPlayersOnline = SteamUserStats()->GetNumberOfCurrentPlayers();
-			}
-			bool bFailed = false;
-			if ( SteamUser()->BLoggedOn() )
+			else
 			{
-				SteamUtils()->GetAPICallResult(SteamAPICall_NumPlayersOnline, &NumberOfCurrentPlayers, sizeof(NumberOfCurrentPlayers_t), 1107, &bFailed);
-				if ( NumberOfCurrentPlayers.m_bSuccess )
-				{
-					steamOnlinePlayers = NumberOfCurrentPlayers.m_cPlayers;
-				}
-				uint64 id = SteamUser()->GetSteamID().ConvertToUint64();
+				generateDungeon(maptoload, rand());
 			}
-#elif defined USE_EOS
-#else
-			if ( intro && introstage == 1 )
+		}
+		assignActions(&map);
+		generatePathMaps();
+		for ( node = map.entities->first; node != nullptr; node = nextnode )
+		{
+			nextnode = node->next;
+			Entity* entity = (Entity*)node->element;
+			if ( entity->flags[NOUPDATE] )
 			{
-				getSizeOfText(ttf8, language[3402], &w, &h);
-				if ( (omousex >= xres - 8 - w && omousex < xres && omousey >= 8 && omousey < 8 + h)
-					&& subwindow == 0 )
-				{
-					if ( inputs.bMouseLeft(clientnum) )
-					{
-						inputs.mouseClearLeft(clientnum);
-						playSound(139, 64);
-						windowEnterSerialPrompt();
-						
-					}
-					ttfPrintTextFormattedColor(ttf8, xres - 8 - w, 8, colorGray, language[3402]);
-				}
-				else
-				{
-					ttfPrintTextFormatted(ttf8, xres - 8 - w, 8, language[3402]);
-				}
+				list_RemoveNode(entity->mynode);    // we're anticipating this entity data from server
 			}
-#endif // STEAMWORKS
 		}
-		// navigate with arrow keys
-		if (!subwindow)
+
+		printlog("Done.\n");
+	}
+
+	// spice of life achievement
+	usedClass[client_classes[clientnum]] = true;
+	bool usedAllClasses = true;
+	for ( c = 0; c <= CLASS_MONK; c++ )
+	{
+		if ( !usedClass[c] )
 		{
-			navigateMainMenuItems(mode);
+			usedAllClasses = false;
 		}
+	}
+	if ( usedAllClasses )
+	{
+		steamAchievement("BARONY_ACH_SPICE_OF_LIFE");
+	}
 
-		// draw menu
-		if ( mode )
+	if ( stats[clientnum]->playerRace >= 0 && stats[clientnum]->playerRace <= RACE_INSECTOID )
+	{
+		usedRace[stats[clientnum]->playerRace] = true;
+	}
+	// new achievement
+	usedAllClasses = true;
+	for ( c = 0; c <= CLASS_HUNTER; ++c )
+	{
+		if ( !usedClass[c] )
 		{
-			/*
-			 * Mouse menu item select/highlight implicitly handled here.
-			 */
-			if ( keystatus[SDL_SCANCODE_L] && (keystatus[SDL_SCANCODE_LCTRL] || keystatus[SDL_SCANCODE_RCTRL]) )
-			{
-				buttonOpenCharacterCreationWindow(nullptr);
-				client_classes[clientnum] = CLASS_BARBARIAN;
-				stats[0]->appearance = 0;
-				stats[0]->playerRace = RACE_HUMAN;
-				initClass(0);
-				strcpy(stats[0]->name, "The Server");
-				keystatus[SDL_SCANCODE_L] = 0;
-				keystatus[SDL_SCANCODE_LCTRL] = 0;
-				keystatus[SDL_SCANCODE_RCTRL] = 0;
-				multiplayerselect = SERVER;
-				charcreation_step = 6;
-				camera_charsheet_offsetyaw = (330) * PI / 180;
-				directConnect = true;
-				strcpy(portnumber_char, "12345");
-				buttonHostLobby(nullptr);
-			}
+			usedAllClasses = false;
+		}
+	}
+	bool usedAllRaces = true;
+	for ( c = RACE_HUMAN; c <= RACE_INSECTOID; ++c )
+	{
+		if ( !usedRace[c] )
+		{
+			usedAllRaces = false;
+		}
+	}
+	if ( usedAllClasses && usedAllRaces )
+	{
+		steamAchievement("BARONY_ACH_I_WANT_IT_ALL");
+	}
 
-			if ( keystatus[SDL_SCANCODE_M] && (keystatus[SDL_SCANCODE_LCTRL] || keystatus[SDL_SCANCODE_RCTRL]) )
-			{
-				buttonOpenCharacterCreationWindow(nullptr);
-				client_classes[clientnum] = CLASS_BARBARIAN;
-				stats[0]->appearance = 0;
-				stats[0]->playerRace = RACE_HUMAN;
-				initClass(0);
-				strcpy(stats[0]->name, "The Client");
-				keystatus[SDL_SCANCODE_M] = 0;
-				keystatus[SDL_SCANCODE_LCTRL] = 0;
-				keystatus[SDL_SCANCODE_RCTRL] = 0;
-				multiplayerselect = CLIENT;
-				charcreation_step = 6;
-				camera_charsheet_offsetyaw = (330) * PI / 180;
-				directConnect = true;
-				strcpy(connectaddress, "localhost:12345");
-				buttonJoinLobby(nullptr);
-			}
+	if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT && !loadingsavegame )
+	{
+		steamStatisticUpdate(STEAM_STAT_GAMES_STARTED, STEAM_STAT_INT, 1);
+		achievementObserver.updateGlobalStat(STEAM_GSTAT_GAMES_STARTED);
+	}
 
-			bool mainMenuSelectInputIsPressed = (inputs.bMouseLeft(clientnum) || keystatus[SDL_SCANCODE_RETURN] || (inputs.bControllerInputPressed(clientnum, INJOY_MENU_NEXT) && rebindaction == -1));
+	// delete game data clutter
+	list_FreeAll(&messages);
+	list_FreeAll(&command_history);
+	SafePacketHandler.reset();
+	for ( c = 0; c < MAXPLAYERS; c++ )
+	{
+		players[c]->messageZone.deleteAllNotificationMessages();
+	}
+	if ( !loadingsavegame ) // don't delete the followers we just created!
+	{
+		for (c = 0; c < MAXPLAYERS; c++)
+		{
+			list_FreeAll(&stats[c]->FOLLOWERS);
+		}
+	}
 
-			//"Start Game" button.
-			SDL_Rect text;
-			text.x = 50;
-			text.h = 18;
-			text.w = 18;
+	if ( loadingsavegame && multiplayer != CLIENT )
+	{
+		loadingsavegame = 0;
+	}
 
-			const Uint32 numMenuOptions = menuOptions.size();
-			Uint32 menuIndex = 0;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			Uint32 menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+	enchantedFeatherScrollSeed.seed(uniqueGameKey);
+	enchantedFeatherScrollsShuffled.clear();
+	enchantedFeatherScrollsShuffled = enchantedFeatherScrollsFixedList;
+	std::shuffle(enchantedFeatherScrollsShuffled.begin(), enchantedFeatherScrollsShuffled.end(), enchantedFeatherScrollSeed);
+	for ( auto it = enchantedFeatherScrollsShuffled.begin(); it != enchantedFeatherScrollsShuffled.end(); ++it )
+	{
+		//printlog("Sequence: %d", *it);
+	}
 
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
-			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
-				{
-					pauseMenuOnInputPressed();
+	list_FreeAll(&removedEntities);
 
-					// look for a save game
-					bool reloadModels = false;
-					int modelsIndexUpdateStart = 1;
-					int modelsIndexUpdateEnd = nummodels;
+	for ( c = 0; c < MAXPLAYERS; c++ )
+	{
+		list_FreeAll(&chestInv[c]);
+	}
 
-					bool reloadSounds = false;
-					if ( gamemods_customContentLoadedFirstTime )
-					{
-						if ( physfsSearchModelsToUpdate() || !gamemods_modelsListModifiedIndexes.empty() )
-						{
-							reloadModels = true; // we had some models already loaded which should be reset
-						}
-						if ( physfsSearchSoundsToUpdate() )
-						{
-							reloadSounds = true; // we had some sounds already loaded which should be reset
-						}
-					}
+	// make some messages
+	startMessages();
 
-					gamemodsClearAllMountedPaths();
-
-					if ( reloadModels )
-					{
-						// print a loading message
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[2990], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2990]);
-						GO_SwapBuffers(screen);
-
-						physfsModelIndexUpdate(modelsIndexUpdateStart, modelsIndexUpdateEnd, true);
-						generatePolyModels(modelsIndexUpdateStart, modelsIndexUpdateEnd, false);
-						gamemods_modelsListLastStartedUnmodded = true;
-					}
-					if ( reloadSounds )
-					{
-						// print a loading message
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[2988], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2988]);
-						GO_SwapBuffers(screen);
-						physfsReloadSounds(true);
-						gamemods_soundsListLastStartedUnmodded = true;
-					}
-
-					if ( gamemods_tileListRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3018], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3018]);
-						GO_SwapBuffers(screen);
-						physfsReloadTiles(true);
-						gamemods_tileListRequireReloadUnmodded = false;
-					}
-
-					if ( gamemods_booksRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[2992], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2992]);
-						GO_SwapBuffers(screen);
-						physfsReloadBooks();
-						gamemods_booksRequireReloadUnmodded = false;
-					}
-
-					if ( gamemods_musicRequireReloadUnmodded )
-					{
-						gamemodsUnloadCustomThemeMusic();
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[2994], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2994]);
-						GO_SwapBuffers(screen);
-						bool reloadIntroMusic = false;
-						physfsReloadMusic(reloadIntroMusic, true);
-						if ( reloadIntroMusic )
-						{
-#ifdef SOUND
-							playmusic(intromusic[rand() % (NUMINTROMUSIC - 1)], false, true, true);
-#endif			
-						}
-						gamemods_musicRequireReloadUnmodded = false;
-					}
-
-					if ( gamemods_langRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3005], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3005]);
-						GO_SwapBuffers(screen);
-						reloadLanguage();
-						gamemods_langRequireReloadUnmodded = false;
-					}
-
-					if ( gamemods_itemsTxtRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3009], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3009]);
-						GO_SwapBuffers(screen);
-						physfsReloadItemsTxt();
-						gamemods_itemsTxtRequireReloadUnmodded = false;
-					}
+	// kick off the main loop!
+	pauseGame(1, 0);
+	loading = false;
+	intro = false;
+}
 
-					if ( gamemods_itemSpritesRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3007], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3007]);
-						GO_SwapBuffers(screen);
-						physfsReloadItemSprites(true);
-						gamemods_itemSpritesRequireReloadUnmodded = false;
-					}
+/*-------------------------------------------------------------------------------
 
-					if ( gamemods_spriteImagesRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3016], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3016]);
-						GO_SwapBuffers(screen);
-						physfsReloadSprites(true);
-						gamemods_spriteImagesRequireReloadUnmodded = false;
-					}
+	handleMainMenu
 
-					if ( gamemods_itemsGlobalTxtRequireReloadUnmodded )
-					{
-						gamemods_itemsGlobalTxtRequireReloadUnmodded = false;
-						printlog("[PhysFS]: Unloaded modified items/items_global.txt file, reloading item spawn levels...");
-						loadItemLists();
-					}
+	draws & processes the game menu; if passed true, does the whole menu,
+	otherwise just handles the reduced ingame menu
 
-					if ( gamemods_monsterLimbsRequireReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3014], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3014]);
-						GO_SwapBuffers(screen);
-						physfsReloadMonsterLimbFiles();
-						gamemods_monsterLimbsRequireReloadUnmodded = false;
-					}
+-------------------------------------------------------------------------------*/
 
-					if ( gamemods_systemImagesReloadUnmodded )
-					{
-						drawClearBuffers();
-						int w, h;
-						getSizeOfText(ttf16, language[3016], &w, &h);
-						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3016]);
-						GO_SwapBuffers(screen);
-						physfsReloadSystemImages();
-						gamemods_systemImagesReloadUnmodded = false;
-						systemResourceImagesToReload.clear();
+void handleMainMenu(bool mode)
+{
+	int x, c;
+	//int y;
+	bool b;
+	//int tilesreceived=0;
+	//Mix_Music **music, *intromusic, *splashmusic, *creditsmusic;
+	node_t* node, *nextnode;
+	Entity* entity;
+	//SDL_Surface *sky_bmp;
+	button_t* button;
+	Sint32 mousex = inputs.getMouse(clientnum, Inputs::MouseInputs::X);
+	Sint32 mousey = inputs.getMouse(clientnum, Inputs::MouseInputs::Y);
+	Sint32 omousex = inputs.getMouse(clientnum, Inputs::MouseInputs::OX);
+	Sint32 omousey = inputs.getMouse(clientnum, Inputs::MouseInputs::OY);
 
-						// tidy up some other resource files.
-						rightsidebar_titlebar_img = spell_list_titlebar_bmp;
-						rightsidebar_slot_img = spell_list_gui_slot_bmp;
-						rightsidebar_slot_highlighted_img = spell_list_gui_slot_highlighted_bmp;
-					}
+#ifdef STEAMWORKS
+	if ( SteamApps()->BIsDlcInstalled(1010820) )
+	{
+		enabledDLCPack1 = true;
+	}
+	if ( SteamApps()->BIsDlcInstalled(1010821) )
+	{
+		enabledDLCPack2 = true;
+	}
+#else
+#endif // STEAMWORKS
+	if ( menuOptions.empty() )
+	{
+		initMenuOptions();
+	}
 
-					gamemods_disableSteamAchievements = false;
+	if ( !movie )
+	{
+		// title pic
+		SDL_Rect src;
+		src.x = 20;
+		src.y = 20;
+		src.w = title_bmp->w * (230.0 / 240.0); // new banner scaled to old size.
+		src.h = title_bmp->h * (230.0 / 240.0);
+		if ( mode || introstage != 5 )
+		{
+			drawImageScaled(title_bmp, nullptr, &src);
+		}
+		if ( mode && subtitleVisible )
+		{
+			Uint32 colorYellow = SDL_MapRGBA(mainsurface->format, 255, 255, 0, 255);
+			Uint32 len = strlen(language[1910 + subtitleCurrent]);
+			ttfPrintTextColor(ttf16, src.x + src.w / 2 - (len * TTF16_WIDTH) / 2, src.y + src.h - 32, colorYellow, true, language[1910 + subtitleCurrent]);
+		}
+#ifdef STEAMWORKS
+		if ( mode )
+		{
+			// print community links
+			if ( SteamUser()->BLoggedOn() )
+			{
+				if ( ticks % 50 == 0 )
+				{
+					UIToastNotificationManager.createCommunityNotification();
+				}
 
-					if ( gameModeManager.Tutorial.FirstTimePrompt.showFirstTimePrompt )
-					{
-						gameModeManager.Tutorial.FirstTimePrompt.createPrompt();
-					}
-					else
+				// upgrade steam achievement for existing hunters
+				if ( ticks % 250 == 0 )
+				{
+					bool unlocked = false;
+					if ( SteamUserStats()->GetAchievement("BARONY_ACH_GUDIPARIAN_BAZI", &unlocked) )
 					{
-						if ( anySaveFileExists() )
-						{
-							//openLoadGameWindow(NULL);
-							openNewLoadGameWindow(nullptr);
-						}
-						else
+						if ( unlocked )
 						{
-							buttonOpenCharacterCreationWindow(NULL);
+							steamAchievement("BARONY_ACH_RANGER_DANGER");
 						}
 					}
 				}
 			}
-			else
+		}
+#elif defined USE_EOS
+		if ( mode )
+		{
+			if ( ticks % 50 == 0 )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				UIToastNotificationManager.createCommunityNotification();
 			}
+		}
+#endif
 
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			//"Introduction" button.
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+#ifdef USE_EOS
+		if ( mode && EOS.StatGlobalManager.bPromoEnabled )
+		{
+			if ( ticks % 100 == 0 )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
-				{
-					pauseMenuOnInputPressed();
+				UIToastNotificationManager.createPromoNotification();
+			}
+		}
+#endif
 
-					introstage = 6; // goes to intro movie
-					fadeout = true;
-#ifdef MUSIC
-					playmusic(introductionmusic, true, true, false);
-#endif
-				}
+		// gray text color
+		Uint32 colorGray = SDL_MapRGBA(mainsurface->format, 128, 128, 128, 255);
+
+		// print game version
+		if ( mode || introstage != 5 )
+		{
+			char version[64];
+			strcpy(version, __DATE__ + 7);
+			strcat(version, ".");
+			if ( !strncmp(__DATE__, "Jan", 3) )
+			{
+				strcat(version, "01");
 			}
-			else
+			else if ( !strncmp(__DATE__, "Feb", 3) )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				strcat(version, "02");
 			}
-
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			//"Hall of Trials" Button.
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			else if ( !strncmp(__DATE__, "Mar", 3) )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
-				{
-					pauseMenuOnInputPressed();
-
-					gameModeManager.Tutorial.readFromFile();
-					gameModeManager.Tutorial.Menu.open();
-				}
+				strcat(version, "03");
 			}
-			else
+			else if ( !strncmp(__DATE__, "Apr", 3) )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				strcat(version, "04");
 			}
-
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			//"Statistics" Button.
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			else if ( !strncmp(__DATE__, "May", 3) )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
-				{
-					pauseMenuOnInputPressed();
-
-					buttonOpenScoresWindow(nullptr);
-				}
+				strcat(version, "05");
 			}
-			else
+			else if ( !strncmp(__DATE__, "Jun", 3) )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				strcat(version, "06");
 			}
-
-#if (defined USE_EOS && !defined STEAMWORKS)
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			//"Achievements" Button.
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			else if ( !strncmp(__DATE__, "Jul", 3) )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
-				{
-					pauseMenuOnInputPressed();
-
-					openAchievementsWindow();
-				}
+				strcat(version, "07");
+			}
+			else if ( !strncmp(__DATE__, "Aug", 3) )
+			{
+				strcat(version, "08");
+			}
+			else if ( !strncmp(__DATE__, "Sep", 3) )
+			{
+				strcat(version, "09");
+			}
+			else if ( !strncmp(__DATE__, "Oct", 3) )
+			{
+				strcat(version, "10");
+			}
+			else if ( !strncmp(__DATE__, "Nov", 3) )
+			{
+				strcat(version, "11");
+			}
+			else if ( !strncmp(__DATE__, "Dec", 3) )
+			{
+				strcat(version, "12");
+			}
+			strcat(version, ".");
+			int day = atoi(__DATE__ + 4);
+			if (day >= 10)
+			{
+				strncat(version, __DATE__ + 4, 2);
 			}
 			else
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				strcat(version, "0");
+				strncat(version, __DATE__ + 5, 1);
 			}
-#endif 
-
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			//"Settings" button.
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			int w, h;
+			getSizeOfText(ttf8, version, &w, &h);
+			ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 4 - h, "%s", version);
+			int h2 = h;
+			getSizeOfText(ttf8, VERSION, &w, &h);
+			ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 8 - h - h2, VERSION);
+			if ( gamemods_numCurrentModsLoaded >= 0 || conductGameChallenges[CONDUCT_MODDED] )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
+				if ( gamemods_numCurrentModsLoaded >= 0 )
 				{
-					pauseMenuOnInputPressed();
-					openSettingsWindow();
+					ttfPrintTextFormatted(ttf8, xres - 8 - TTF8_WIDTH * 16, yres - 12 - h - h2 * 2, "%2d mod(s) loaded", gamemods_numCurrentModsLoaded);
+				}
+				else if ( !mode )
+				{
+					ttfPrintTextFormatted(ttf8, xres - 8 - TTF8_WIDTH * 24, yres - 12 - h - h2 * 2, "Using modified map files");
 				}
 			}
-			else
+#if (defined STEAMWORKS || defined USE_EOS)
+			if ( gamemods_disableSteamAchievements
+				|| (intro == false && 
+					(conductGameChallenges[CONDUCT_CHEATS_ENABLED]
+					|| conductGameChallenges[CONDUCT_LIFESAVING])) )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				getSizeOfText(ttf8, language[3003], &w, &h);
+				if ( gamemods_numCurrentModsLoaded < 0 && !conductGameChallenges[CONDUCT_MODDED] )
+				{
+					h = -4;
+				}
+				if ( gameModeManager.getMode() != GameModeManager_t::GAME_MODE_DEFAULT )
+				{
+					// achievements are disabled
+					ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 16 - h - h2 * 3, language[3003]);
+				}
+				else
+				{
+					// achievements are disabled
+					ttfPrintTextFormatted(ttf8, xres - 8 - w, yres - 16 - h - h2 * 3, language[3003]);
+				}
 			}
+#endif
 
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			//"Credits" button
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+#ifdef STEAMWORKS
+			getSizeOfText(ttf8, language[2549], &w, &h);
+			if ( (omousex >= xres - 8 - w && omousex < xres && omousey >= 8 && omousey < 8 + h)
+				&& subwindow == 0
+				&& introstage == 1
+				&& SteamUser()->BLoggedOn() )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
+				if ( inputs.bMouseLeft(clientnum) )
 				{
-					pauseMenuOnInputPressed();
-					introstage = 4; // goes to credits
-					fadeout = true;
+					inputs.mouseClearLeft(clientnum);
+					playSound(139, 64);
+					SteamAPICall_NumPlayersOnline = SteamUserStats()->GetNumberOfCurrentPlayers();
 				}
+				ttfPrintTextFormattedColor(ttf8, xres - 8 - w, 8, colorGray, language[2549], steamOnlinePlayers);
 			}
-			else
+			else if ( SteamUser()->BLoggedOn() )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				ttfPrintTextFormatted(ttf8, xres - 8 - w, 8, language[2549], steamOnlinePlayers);
 			}
-
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-			
-			//"Custom content" button.
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			if ( intro == false )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
+				if ( conductGameChallenges[CONDUCT_CHEATS_ENABLED] )
 				{
-					pauseMenuOnInputPressed();
-					gamemodsCustomContentInit();
+					getSizeOfText(ttf8, language[2986], &w, &h);
+					ttfPrintTextFormatted(ttf8, xres - 8 - w, 8 + h, language[2986]);
 				}
 			}
-			else
+			if ( SteamUser()->BLoggedOn() && SteamAPICall_NumPlayersOnline == 0 )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				SteamAPICall_NumPlayersOnline = SteamUserStats()->GetNumberOfCurrentPlayers();
 			}
-#ifdef STEAMWORKS
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
-
-			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			bool bFailed = false;
+			if ( SteamUser()->BLoggedOn() )
 			{
-				menuselect = menuOptions.at(menuIndex).second;
-				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
-				if ( mainMenuSelectInputIsPressed )
+				SteamUtils()->GetAPICallResult(SteamAPICall_NumPlayersOnline, &NumberOfCurrentPlayers, sizeof(NumberOfCurrentPlayers_t), 1107, &bFailed);
+				if ( NumberOfCurrentPlayers.m_bSuccess )
 				{
-					pauseMenuOnInputPressed();
-					gamemodsSubscribedItemsInit();
+					steamOnlinePlayers = NumberOfCurrentPlayers.m_cPlayers;
 				}
+				uint64 id = SteamUser()->GetSteamID().ConvertToUint64();
 			}
-			else
+#elif defined USE_EOS
+#else
+			if ( intro && introstage == 1 )
 			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+				getSizeOfText(ttf8, language[3402], &w, &h);
+				if ( (omousex >= xres - 8 - w && omousex < xres && omousey >= 8 && omousey < 8 + h)
+					&& subwindow == 0 )
+				{
+					if ( inputs.bMouseLeft(clientnum) )
+					{
+						inputs.mouseClearLeft(clientnum);
+						playSound(139, 64);
+						windowEnterSerialPrompt();
+						
+					}
+					ttfPrintTextFormattedColor(ttf8, xres - 8 - w, 8, colorGray, language[3402]);
+				}
+				else
+				{
+					ttfPrintTextFormatted(ttf8, xres - 8 - w, 8, language[3402]);
+				}
 			}
-#endif
-			++menuIndex;
-			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
-			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+#endif // STEAMWORKS
+		}
+		// navigate with arrow keys
+		if (!subwindow)
+		{
+			navigateMainMenuItems(mode);
+		}
+
+		// draw menu
+		if ( mode )
+		{
+			/*
+			 * Mouse menu item select/highlight implicitly handled here.
+			 */
+			if ( keystatus[SDL_SCANCODE_L] && (keystatus[SDL_SCANCODE_LCTRL] || keystatus[SDL_SCANCODE_RCTRL]) )
+			{
+				buttonOpenCharacterCreationWindow(nullptr);
+				client_classes[clientnum] = CLASS_BARBARIAN;
+				stats[0]->appearance = 0;
+				stats[0]->playerRace = RACE_HUMAN;
+				initClass(0);
+				strcpy(stats[0]->name, "The Server");
+				keystatus[SDL_SCANCODE_L] = 0;
+				keystatus[SDL_SCANCODE_LCTRL] = 0;
+				keystatus[SDL_SCANCODE_RCTRL] = 0;
+				multiplayerselect = SERVER;
+				charcreation_step = 6;
+				camera_charsheet_offsetyaw = (330) * PI / 180;
+				directConnect = true;
+				strcpy(portnumber_char, "12345");
+				buttonHostLobby(nullptr);
+			}
+
+			if ( keystatus[SDL_SCANCODE_M] && (keystatus[SDL_SCANCODE_LCTRL] || keystatus[SDL_SCANCODE_RCTRL]) )
+			{
+				buttonOpenCharacterCreationWindow(nullptr);
+				client_classes[clientnum] = CLASS_BARBARIAN;
+				stats[0]->appearance = 0;
+				stats[0]->playerRace = RACE_HUMAN;
+				initClass(0);
+				strcpy(stats[0]->name, "The Client");
+				keystatus[SDL_SCANCODE_M] = 0;
+				keystatus[SDL_SCANCODE_LCTRL] = 0;
+				keystatus[SDL_SCANCODE_RCTRL] = 0;
+				multiplayerselect = CLIENT;
+				charcreation_step = 6;
+				camera_charsheet_offsetyaw = (330) * PI / 180;
+				directConnect = true;
+				strcpy(connectaddress, "localhost:12345");
+				buttonJoinLobby(nullptr);
+			}
+
+			bool mainMenuSelectInputIsPressed = (inputs.bMouseLeft(clientnum) || keystatus[SDL_SCANCODE_RETURN] || (inputs.bControllerInputPressed(clientnum, INJOY_MENU_NEXT) && rebindaction == -1));
+
+			//"Start Game" button.
+			SDL_Rect text;
+			text.x = 50;
+			text.h = 18;
+			text.w = 18;
+
+			const Uint32 numMenuOptions = menuOptions.size();
+			Uint32 menuIndex = 0;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			Uint32 menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
 
-			//"Quit" button.
 			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
 				menuselect = menuOptions.at(menuIndex).second;
@@ -2284,1531 +2553,1201 @@ void handleMainMenu(bool mode)
 				{
 					pauseMenuOnInputPressed();
 
-					// create confirmation window
-					subwindow = 1;
-					subx1 = xres / 2 - 128;
-					subx2 = xres / 2 + 128;
-					suby1 = yres / 2 - 40;
-					suby2 = yres / 2 + 40;
-					strcpy(subtext, language[1128]);
+					// look for a save game
+					bool reloadModels = false;
+					int modelsIndexUpdateStart = 1;
+					int modelsIndexUpdateEnd = nummodels;
 
-					// close button
-					button = newButton();
-					strcpy(button->label, "x");
-					button->x = subx2 - 20;
-					button->y = suby1;
-					button->sizex = 20;
-					button->sizey = 20;
-					button->action = &buttonCloseSubwindow;
-					button->visible = 1;
-					button->focused = 1;
-					button->key = SDL_SCANCODE_ESCAPE;
-					button->joykey = joyimpulses[INJOY_MENU_CANCEL];
+					bool reloadSounds = false;
+					if ( gamemods_customContentLoadedFirstTime )
+					{
+						if ( physfsSearchModelsToUpdate() || !gamemods_modelsListModifiedIndexes.empty() )
+						{
+							reloadModels = true; // we had some models already loaded which should be reset
+						}
+						if ( physfsSearchSoundsToUpdate() )
+						{
+							reloadSounds = true; // we had some sounds already loaded which should be reset
+						}
+					}
 
-					// yes button
-					button = newButton();
-					strcpy(button->label, language[1314]);
-					button->x = subx1 + 8;
-					button->y = suby2 - 28;
-					button->sizex = strlen(language[1314]) * 12 + 8;
-					button->sizey = 20;
-					button->action = &buttonQuitConfirm;
-					button->visible = 1;
-					button->focused = 1;
-					button->key = SDL_SCANCODE_RETURN;
-					button->joykey = joyimpulses[INJOY_MENU_NEXT];
+					gamemodsClearAllMountedPaths();
 
-					// no button
-					button = newButton();
-					strcpy(button->label, language[1315]);
-					button->x = subx2 - strlen(language[1315]) * 12 - 16;
-					button->y = suby2 - 28;
-					button->sizex = strlen(language[1315]) * 12 + 8;
-					button->sizey = 20;
-					button->action = &buttonCloseSubwindow;
-					button->visible = 1;
-					button->focused = 1;
-				}
-			}
-			else
-			{
-				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
-			}
-		}
-		else
-		{
-			if ( introstage != 5 )
-			{
-				if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT )
-				{
-					handleInGamePauseMenu();
-				}
-				else if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_TUTORIAL )
-				{
-					handleTutorialPauseMenu();
-				}
-			}
-		}
+					if ( reloadModels )
+					{
+						// print a loading message
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[2990], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2990]);
+						GO_SwapBuffers(screen);
 
-		LobbyHandler.handleLobbyListRequests();
+						physfsModelIndexUpdate(modelsIndexUpdateStart, modelsIndexUpdateEnd, true);
+						generatePolyModels(modelsIndexUpdateStart, modelsIndexUpdateEnd, false);
+						gamemods_modelsListLastStartedUnmodded = true;
+					}
+					if ( reloadSounds )
+					{
+						// print a loading message
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[2988], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2988]);
+						GO_SwapBuffers(screen);
+						physfsReloadSounds(true);
+						gamemods_soundsListLastStartedUnmodded = true;
+					}
 
-		//Confirm Resolution Change Window
-		if ( confirmResolutionWindow )
-		{
-			subx1 = xres / 2 - 128;
-			subx2 = xres / 2 + 128;
-			suby1 = yres / 2 - 40;
-			suby2 = yres / 2 + 40;
-			drawWindowFancy(subx1, suby1, subx2, suby2);
+					if ( gamemods_tileListRequireReloadUnmodded )
+					{
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3018], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3018]);
+						GO_SwapBuffers(screen);
+						physfsReloadTiles(true);
+						gamemods_tileListRequireReloadUnmodded = false;
+					}
 
-			if ( SDL_GetTicks() >= resolutionConfirmationTimer + RESOLUTION_CONFIRMATION_TIME )
-			{
-				//Automatically revert.
-				buttonRevertResolution(revertResolutionButton);
-			}
-		}
+					if ( gamemods_booksRequireReloadUnmodded )
+					{
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[2992], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2992]);
+						GO_SwapBuffers(screen);
+						physfsReloadBooks();
+						gamemods_booksRequireReloadUnmodded = false;
+					}
 
-		// draw subwindow
-		if ( subwindow )
-		{
-			drawWindowFancy(subx1, suby1, subx2, suby2);
-			if ( loadGameSaveShowRectangle > 0 )
-			{
-				SDL_Rect saveBox;
-				saveBox.x = subx1 + 4;
-				saveBox.y = suby1 + TTF12_HEIGHT * 2;
-				saveBox.w = subx2 - subx1 - 8;
-				saveBox.h = TTF12_HEIGHT * 3;
-				drawWindowFancy(saveBox.x, saveBox.y, saveBox.x + saveBox.w, saveBox.y + saveBox.h);
-				if ( gamemods_numCurrentModsLoaded >= 0 )
-				{
-					drawRect(&saveBox, uint32ColorGreen(*mainsurface), 32);
-				}
-				else
-				{
-					drawRect(&saveBox, uint32ColorBaronyBlue(*mainsurface), 32);
-				}
-				if ( loadGameSaveShowRectangle == 2 )
-				{
-					saveBox.y = suby1 + TTF12_HEIGHT * 5 + 2;
-					//drawTooltip(&saveBox);
-					drawWindowFancy(saveBox.x, saveBox.y, saveBox.x + saveBox.w, saveBox.y + saveBox.h);
-					if ( gamemods_numCurrentModsLoaded >= 0 )
+					if ( gamemods_musicRequireReloadUnmodded )
 					{
-						drawRect(&saveBox, uint32ColorGreen(*mainsurface), 32);
+						gamemodsUnloadCustomThemeMusic();
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[2994], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[2994]);
+						GO_SwapBuffers(screen);
+						bool reloadIntroMusic = false;
+						physfsReloadMusic(reloadIntroMusic, true);
+						if ( reloadIntroMusic )
+						{
+#ifdef SOUND
+							playmusic(intromusic[rand() % (NUMINTROMUSIC - 1)], false, true, true);
+#endif			
+						}
+						gamemods_musicRequireReloadUnmodded = false;
 					}
-					else
+
+					if ( gamemods_langRequireReloadUnmodded )
 					{
-						drawRect(&saveBox, uint32ColorBaronyBlue(*mainsurface), 32);
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3005], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3005]);
+						GO_SwapBuffers(screen);
+						reloadLanguage();
+						gamemods_langRequireReloadUnmodded = false;
 					}
-				}
-			}
-			if ( gamemods_window == 1 || gamemods_window == 2 || gamemods_window == 5 )
-			{
-				drawWindowFancy(subx1 + 4, suby1 + 44 + 10 * TTF12_HEIGHT,
-					subx2 - 4, suby2 - 4);
-			}
-			if ( subtext != NULL )
-			{
-				if ( strncmp(subtext, language[740], 12) )
-				{
-					ttfPrintTextFormatted(ttf12, subx1 + 8, suby1 + 8, subtext);
-				}
-				else
-				{
-					ttfPrintTextFormatted(ttf16, subx1 + 8, suby1 + 8, subtext);
-				}
-			}
-			if ( loadGameSaveShowRectangle > 0 && gamemods_numCurrentModsLoaded >= 0 )
-			{
-				ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - TTF12_HEIGHT * 5, uint32ColorBaronyBlue(*mainsurface), "%s", language[2982]);
-			}
-		}
-		else
-		{
-			loadGameSaveShowRectangle = 0;
-		}
-
-		LobbyHandler.drawLobbyFilters();
 
-		// process button actions
-		handleButtons();
+					if ( gamemods_itemsTxtRequireReloadUnmodded )
+					{
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3009], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3009]);
+						GO_SwapBuffers(screen);
+						physfsReloadItemsTxt();
+						gamemods_itemsTxtRequireReloadUnmodded = false;
+					}
 
-		LobbyHandler.handleLobbyBrowser();
-	}
+					if ( gamemods_itemSpritesRequireReloadUnmodded )
+					{
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3007], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3007]);
+						GO_SwapBuffers(screen);
+						physfsReloadItemSprites(true);
+						gamemods_itemSpritesRequireReloadUnmodded = false;
+					}
 
-	// character creation screen
-	if ( charcreation_step >= 1 && charcreation_step < 6 )
-	{
-		if ( gamemods_numCurrentModsLoaded >= 0 )
-		{
-			ttfPrintText(ttf16, subx1 + 8, suby1 + 8, language[2980]);
-		}
-		else
-		{
-			ttfPrintText(ttf16, subx1 + 8, suby1 + 8, language[1318]);
-		}
+					if ( gamemods_spriteImagesRequireReloadUnmodded )
+					{
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3016], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3016]);
+						GO_SwapBuffers(screen);
+						physfsReloadSprites(true);
+						gamemods_spriteImagesRequireReloadUnmodded = false;
+					}
 
-		// draw character window
-		if (players[clientnum] != nullptr && players[clientnum]->entity != nullptr)
-		{
-			camera_charsheet.x = players[clientnum]->entity->x / 16.0 + 1.118 * cos(camera_charsheet_offsetyaw); // + 1
-			camera_charsheet.y = players[clientnum]->entity->y / 16.0 + 1.118 * sin(camera_charsheet_offsetyaw); // -.5
-			if ( !stats[clientnum]->EFFECTS[EFF_ASLEEP] )
-			{
-				camera_charsheet.z = players[clientnum]->entity->z * 2;
-			}
-			else
-			{
-				camera_charsheet.z = 1.5;
-			}
-			camera_charsheet.ang = atan2(players[clientnum]->entity->y / 16.0 - camera_charsheet.y, players[clientnum]->entity->x / 16.0 - camera_charsheet.x);
-			camera_charsheet.vang = PI / 24;
-			camera_charsheet.winw = 360;
-			camera_charsheet.winy = suby1 + 32;
-			camera_charsheet.winh = suby2 - 96 - camera_charsheet.winy;
-			camera_charsheet.winx = subx2 - camera_charsheet.winw - 32;
-			SDL_Rect pos;
-			pos.x = camera_charsheet.winx;
-			pos.y = camera_charsheet.winy;
-			pos.w = camera_charsheet.winw;
-			pos.h = camera_charsheet.winh;
-			drawRect(&pos, 0, 255);
-			b = players[clientnum]->entity->flags[BRIGHT];
-			players[clientnum]->entity->flags[BRIGHT] = true;
-			if (!playing_random_char)
-			{
-				if ( !players[clientnum]->entity->flags[INVISIBLE] )
-				{
-					real_t ofov = fov;
-					fov = 50;
-					glDrawVoxel(&camera_charsheet, players[clientnum]->entity, REALCOLORS);
-					fov = ofov;
-				}
-				players[clientnum]->entity->flags[BRIGHT] = b;
-				c = 0;
-				for ( node = players[clientnum]->entity->children.first; node != NULL; node = node->next )
-				{
-					if ( c == 0 )
+					if ( gamemods_itemsGlobalTxtRequireReloadUnmodded )
 					{
-						c++;
+						gamemods_itemsGlobalTxtRequireReloadUnmodded = false;
+						printlog("[PhysFS]: Unloaded modified items/items_global.txt file, reloading item spawn levels...");
+						loadItemLists();
 					}
-					entity = (Entity*) node->element;
-					if ( !entity->flags[INVISIBLE] )
+
+					if ( gamemods_monsterLimbsRequireReloadUnmodded )
 					{
-						b = entity->flags[BRIGHT];
-						entity->flags[BRIGHT] = true;
-						real_t ofov = fov;
-						fov = 50;
-						glDrawVoxel(&camera_charsheet, entity, REALCOLORS);
-						fov = ofov;
-						entity->flags[BRIGHT] = b;
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3014], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3014]);
+						GO_SwapBuffers(screen);
+						physfsReloadMonsterLimbFiles();
+						gamemods_monsterLimbsRequireReloadUnmodded = false;
 					}
-					c++;
-				}
-			}
-			SDL_Rect rotateBtn;
-			rotateBtn.w = 24;
-			rotateBtn.h = 24;
-			rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w;
-			rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
-			drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-			if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
-			{
-				if ( inputs.bMouseLeft(clientnum) )
-				{
-					camera_charsheet_offsetyaw += 0.05;
-					if ( camera_charsheet_offsetyaw > 2 * PI )
+
+					if ( gamemods_systemImagesReloadUnmodded )
 					{
-						camera_charsheet_offsetyaw -= 2 * PI;
+						drawClearBuffers();
+						int w, h;
+						getSizeOfText(ttf16, language[3016], &w, &h);
+						ttfPrintText(ttf16, (xres - w) / 2, (yres - h) / 2, language[3016]);
+						GO_SwapBuffers(screen);
+						physfsReloadSystemImages();
+						gamemods_systemImagesReloadUnmodded = false;
+						systemResourceImagesToReload.clear();
+
+						// tidy up some other resource files.
+						rightsidebar_titlebar_img = spell_list_titlebar_bmp;
+						rightsidebar_slot_img = spell_list_gui_slot_bmp;
+						rightsidebar_slot_highlighted_img = spell_list_gui_slot_highlighted_bmp;
 					}
-					drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-				}
-			}
-			ttfPrintText(ttf12, rotateBtn.x + 4, rotateBtn.y + 6, ">");
 
-			rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w * 2 - 4;
-			rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
-			drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-			if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
-			{
-				if ( inputs.bMouseLeft(clientnum) )
-				{
-					camera_charsheet_offsetyaw -= 0.05;
-					if ( camera_charsheet_offsetyaw < 0.f )
+					gamemods_disableSteamAchievements = false;
+
+					if ( gameModeManager.Tutorial.FirstTimePrompt.showFirstTimePrompt )
 					{
-						camera_charsheet_offsetyaw += 2 * PI;
+						gameModeManager.Tutorial.FirstTimePrompt.createPrompt();
+					}
+					else
+					{
+						if ( anySaveFileExists() )
+						{
+							//openLoadGameWindow(NULL);
+							openNewLoadGameWindow(nullptr);
+						}
+						else
+						{
+							buttonOpenCharacterCreationWindow(NULL);
+						}
 					}
-					drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
 				}
 			}
-			ttfPrintText(ttf12, rotateBtn.x + 4, rotateBtn.y + 6, "<");
-
-			SDL_Rect raceInfoBtn;
-			raceInfoBtn.y = rotateBtn.y;
-			raceInfoBtn.w = longestline(language[3373]) * TTF12_WIDTH + 8 + 4;
-			raceInfoBtn.x = rotateBtn.x - raceInfoBtn.w - 4;
-			raceInfoBtn.h = rotateBtn.h;
-			drawWindow(raceInfoBtn.x, raceInfoBtn.y, raceInfoBtn.x + raceInfoBtn.w, raceInfoBtn.y + raceInfoBtn.h);
-			if ( mouseInBounds(clientnum, raceInfoBtn.x, raceInfoBtn.x + raceInfoBtn.w, raceInfoBtn.y, raceInfoBtn.y + raceInfoBtn.h) )
+			else
 			{
-				if ( inputs.bControllerInputPressed(clientnum, INJOY_MENU_LEFT_CLICK) || inputs.bMouseLeft(clientnum) )
-				{
-					//drawDepressed(raceInfoBtn.x, raceInfoBtn.y, raceInfoBtn.x + raceInfoBtn.w, raceInfoBtn.y + raceInfoBtn.h);
-					inputs.mouseClearLeft(clientnum);
-					inputs.controllerClearInput(clientnum, INJOY_MENU_LEFT_CLICK);
-					showRaceInfo = !showRaceInfo;
-					playSound(139, 64);
-				}
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-			if ( showRaceInfo )
+
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Introduction" button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				pos.y += 2;
-				pos.h -= raceInfoBtn.h + 6;
-				pos.x += 2;
-				pos.w -= 6;
-				drawRect(&pos, 0, 168);
-				drawLine(pos.x, pos.y, pos.x + pos.w, pos.y, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
-				drawLine(pos.x, pos.y + pos.h, pos.x + pos.w, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
-				drawLine(pos.x, pos.y, pos.x, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
-				drawLine(pos.x + pos.w, pos.y, pos.x + pos.w, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
-				if ( stats[0]->playerRace >= RACE_HUMAN )
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
 				{
-					ttfPrintText(ttf12, pos.x + 12, pos.y + 6, language[3375 + stats[0]->playerRace]);
+					pauseMenuOnInputPressed();
+
+					introstage = 6; // goes to intro movie
+					fadeout = true;
+#ifdef MUSIC
+					playmusic(introductionmusic, true, true, false);
+#endif
 				}
-				ttfPrintText(ttf12, raceInfoBtn.x + 4, raceInfoBtn.y + 6, language[3374]);
 			}
 			else
 			{
-				ttfPrintText(ttf12, raceInfoBtn.x + 4, raceInfoBtn.y + 6, language[3373]);
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-		}
 
-		// skin DLC check flags.
-		bool skipFirstDLC = false;
-		bool skipSecondDLC = false;
-		if ( enabledDLCPack2 && !enabledDLCPack1 )
-		{
-			skipFirstDLC = true;
-			if ( stats[0]->playerRace > 0 && stats[0]->playerRace <= RACE_GOATMAN )
-			{
-				stats[0]->playerRace = RACE_HUMAN;
-			}
-		}
-		else if ( enabledDLCPack1 && !enabledDLCPack2 )
-		{
-			skipSecondDLC = true;
-			if ( stats[0]->playerRace > RACE_GOATMAN )
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Hall of Trials" Button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				stats[0]->playerRace = RACE_HUMAN;
-			}
-		}
-		else if ( !enabledDLCPack1 && !enabledDLCPack2 )
-		{
-			stats[0]->playerRace = RACE_HUMAN;
-		}
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
+				{
+					pauseMenuOnInputPressed();
 
-		// sexes/race
-		if ( charcreation_step == 1 )
-		{
-			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1319]);
-			Uint32 colorStep1 = uint32ColorWhite(*mainsurface);
-			if ( raceSelect != 0 )
+					gameModeManager.Tutorial.readFromFile();
+					gameModeManager.Tutorial.Menu.open();
+				}
+			}
+			else
 			{
-				colorStep1 = uint32ColorGray(*mainsurface);
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-			if ( stats[0]->sex == 0 )
+
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Statistics" Button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 56, colorStep1, "[o] %s", language[1321]);
-				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 73, colorStep1, "[ ] %s", language[1322]);
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
+				{
+					pauseMenuOnInputPressed();
 
-				ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - 80, uint32ColorWhite(*mainsurface), language[1320], language[1321]);
+					buttonOpenScoresWindow(nullptr);
+				}
 			}
 			else
 			{
-				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 56, colorStep1, "[ ] %s", language[1321]);
-				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 73, colorStep1, "[o] %s", language[1322]);
-
-				ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - 80, uint32ColorWhite(*mainsurface), language[1320], language[1322]);
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-			ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - 56, uint32ColorWhite(*mainsurface), language[3175]);
 
-			// race
-			if ( raceSelect != 1 )
+#if (defined USE_EOS && !defined STEAMWORKS)
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Achievements" Button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				colorStep1 = uint32ColorGray(*mainsurface);
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
+				{
+					pauseMenuOnInputPressed();
+
+					openAchievementsWindow();
+				}
 			}
-			else if ( raceSelect == 1 )
+			else
 			{
-				colorStep1 = uint32ColorWhite(*mainsurface);
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-			ttfPrintText(ttf16, subx1 + 24, suby1 + 108, language[3160]);
-			int pady = suby1 + 108 + 24;
-			bool isLocked = false;
-			for ( int c = 0; c < NUMPLAYABLERACES; )
+#endif 
+
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Settings" button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				if ( raceSelect == 1 )
-				{
-					if ( skipSecondDLC )
-					{
-						if ( c > RACE_GOATMAN )
-						{
-							colorStep1 = uint32ColorGray(*mainsurface);
-						}
-						else
-						{
-							colorStep1 = uint32ColorWhite(*mainsurface);
-						}
-					}
-					else if ( skipFirstDLC )
-					{
-						if ( c > RACE_HUMAN && c <= RACE_GOATMAN )
-						{
-							colorStep1 = uint32ColorGray(*mainsurface);
-						}
-						else
-						{
-							colorStep1 = uint32ColorWhite(*mainsurface);
-						}
-					}
-					else if ( !(enabledDLCPack2 && enabledDLCPack1) )
-					{
-						if ( c > RACE_HUMAN )
-						{
-							colorStep1 = uint32ColorGray(*mainsurface);
-						}
-						else
-						{
-							colorStep1 = uint32ColorWhite(*mainsurface);
-						}
-					}
-					else if ( enabledDLCPack2 && enabledDLCPack1 )
-					{
-						colorStep1 = uint32ColorWhite(*mainsurface);
-					}
-				}
-				if ( stats[0]->playerRace == c )
-				{
-					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[o] %s", language[3161 + c]);
-				}
-				else
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
 				{
-					if ( skipSecondDLC )
-					{
-						if ( c > RACE_GOATMAN )
-						{
-							isLocked = true;
-						}
-					}
-					else if ( skipFirstDLC )
-					{
-						if ( c >= RACE_SKELETON && c < RACE_AUTOMATON )
-						{
-							isLocked = true;
-						}
-					}
-					else if ( !enabledDLCPack1 && !enabledDLCPack2 )
-					{
-						isLocked = true;
-					}
-					if ( isLocked )
-					{
-						SDL_Rect img;
-						img.x = subx1 + 32 + 10;
-						img.y = pady - 2;
-						img.w = 22;
-						img.h = 20;
-						drawImageScaled(sidebar_unlock_bmp, nullptr, &img);
-						ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[ ] %s", language[3161 + c]);
-					}
-					else
-					{
-						ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[ ] %s", language[3161 + c]);
-					}
+					pauseMenuOnInputPressed();
+					openSettingsWindow();
 				}
+			}
+			else
+			{
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+			}
 
-				if ( skipFirstDLC )
-				{
-					if ( c == RACE_HUMAN )
-					{
-						c = RACE_AUTOMATON;
-					}
-					else if ( c == RACE_INSECTOID )
-					{
-						c = RACE_SKELETON;
-						pady += 8;
-					}
-					else if ( c == RACE_GOATMAN )
-					{
-						c = NUMPLAYABLERACES;
-					}
-					else
-					{
-						++c;
-					}
-				}
-				else
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Credits" button
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			{
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
 				{
-					if ( skipSecondDLC && c == RACE_GOATMAN )
-					{
-						pady += 8;
-					}
-					else if ( !enabledDLCPack1 && !enabledDLCPack2 && c == RACE_HUMAN )
-					{
-						pady += 8;
-					}
-					++c;
+					pauseMenuOnInputPressed();
+					introstage = 4; // goes to credits
+					fadeout = true;
 				}
-				pady += 17;
 			}
-
-			pady += 24;
-			if ( isLocked )
+			else
 			{
-				pady -= 8;
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-			bool displayRaceOptions = false;
-			if ( raceSelect != 2 )
+
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+			
+			//"Custom content" button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				colorStep1 = uint32ColorGray(*mainsurface);
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
+				{
+					pauseMenuOnInputPressed();
+					gamemodsCustomContentInit();
+				}
 			}
 			else
 			{
-				colorStep1 = uint32ColorWhite(*mainsurface);
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
 			}
-			if ( stats[0]->playerRace > 0 )
+#ifdef STEAMWORKS
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
 			{
-				displayRaceOptions = true;
-				ttfPrintText(ttf16, subx1 + 24, pady, language[3176]);
-				pady += 24;
-				char raceOptionBuffer[128];
-				snprintf(raceOptionBuffer, 63, language[3177], language[3161 + stats[0]->playerRace]);
-				if ( stats[0]->appearance > 1 )
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
 				{
-					stats[0]->appearance = lastAppearance;
+					pauseMenuOnInputPressed();
+					gamemodsSubscribedItemsInit();
 				}
-				if ( stats[0]->appearance == 0 )
+			}
+			else
+			{
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+			}
+#endif
+			++menuIndex;
+			text.y = yres / 4 + 80 + (menuOptions.at(menuIndex).second - 1) * 24;
+			menuOptionSize = std::max(static_cast<Uint32>(menuOptions.at(menuIndex).first.size()), static_cast<Uint32>(4));
+
+			//"Quit" button.
+			if ( ((omousex >= text.x && omousex < text.x + menuOptionSize * text.w && omousey >= text.y && omousey < text.y + text.h) || (menuselect == menuOptions.at(menuIndex).second)) && subwindow == 0 && introstage == 1 )
+			{
+				menuselect = menuOptions.at(menuIndex).second;
+				ttfPrintTextFormattedColor(ttf16, text.x, text.y, colorGray, "%s", menuOptions.at(menuIndex).first.c_str());
+				if ( mainMenuSelectInputIsPressed )
 				{
-					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[o] %s", raceOptionBuffer);
-					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady + 17, colorStep1, "[ ] %s", language[3178]);
+					pauseMenuOnInputPressed();
+
+					// create confirmation window
+					subwindow = 1;
+					subx1 = xres / 2 - 128;
+					subx2 = xres / 2 + 128;
+					suby1 = yres / 2 - 40;
+					suby2 = yres / 2 + 40;
+					strcpy(subtext, language[1128]);
+
+					// close button
+					button = newButton();
+					strcpy(button->label, "x");
+					button->x = subx2 - 20;
+					button->y = suby1;
+					button->sizex = 20;
+					button->sizey = 20;
+					button->action = &buttonCloseSubwindow;
+					button->visible = 1;
+					button->focused = 1;
+					button->key = SDL_SCANCODE_ESCAPE;
+					button->joykey = joyimpulses[INJOY_MENU_CANCEL];
+
+					// yes button
+					button = newButton();
+					strcpy(button->label, language[1314]);
+					button->x = subx1 + 8;
+					button->y = suby2 - 28;
+					button->sizex = strlen(language[1314]) * 12 + 8;
+					button->sizey = 20;
+					button->action = &buttonQuitConfirm;
+					button->visible = 1;
+					button->focused = 1;
+					button->key = SDL_SCANCODE_RETURN;
+					button->joykey = joyimpulses[INJOY_MENU_NEXT];
+
+					// no button
+					button = newButton();
+					strcpy(button->label, language[1315]);
+					button->x = subx2 - strlen(language[1315]) * 12 - 16;
+					button->y = suby2 - 28;
+					button->sizex = strlen(language[1315]) * 12 + 8;
+					button->sizey = 20;
+					button->action = &buttonCloseSubwindow;
+					button->visible = 1;
+					button->focused = 1;
 				}
-				else if ( stats[0]->appearance == 1 )
+			}
+			else
+			{
+				ttfPrintText(ttf16, text.x, text.y, menuOptions.at(menuIndex).first.c_str());
+			}
+		}
+		else
+		{
+			if ( introstage != 5 )
+			{
+				if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT )
 				{
-					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[ ] %s", raceOptionBuffer);
-					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady + 17, colorStep1, "[o] %s", language[3178]);
+					handleInGamePauseMenu();
+				}
+				else if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_TUTORIAL )
+				{
+					handleTutorialPauseMenu();
 				}
+			}
+		}
+
+		LobbyHandler.handleLobbyListRequests();
+
+		//Confirm Resolution Change Window
+		if ( confirmResolutionWindow )
+		{
+			subx1 = xres / 2 - 128;
+			subx2 = xres / 2 + 128;
+			suby1 = yres / 2 - 40;
+			suby2 = yres / 2 + 40;
+			drawWindowFancy(subx1, suby1, subx2, suby2);
 
+			if ( SDL_GetTicks() >= resolutionConfirmationTimer + RESOLUTION_CONFIRMATION_TIME )
+			{
+				//Automatically revert.
+				buttonRevertResolution(revertResolutionButton);
 			}
+		}
 
-			pady = suby1 + 108 + 24;
-			lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
-			if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
+		// draw subwindow
+		if ( subwindow )
+		{
+			drawWindowFancy(subx1, suby1, subx2, suby2);
+			if ( loadGameSaveShowRectangle > 0 )
 			{
-				if ( omousey >= suby1 + 56 && omousey < suby1 + 72 )
+				SDL_Rect saveBox;
+				saveBox.x = subx1 + 4;
+				saveBox.y = suby1 + TTF12_HEIGHT * 2;
+				saveBox.w = subx2 - subx1 - 8;
+				saveBox.h = TTF12_HEIGHT * 3;
+				drawWindowFancy(saveBox.x, saveBox.y, saveBox.x + saveBox.w, saveBox.y + saveBox.h);
+				if ( gamemods_numCurrentModsLoaded >= 0 )
 				{
-					if ( inputs.bMouseLeft(clientnum) )
-					{
-						raceSelect = 0;
-						inputs.mouseClearLeft(clientnum);
-						stats[0]->sex = MALE;
-						lastSex = MALE;
-						if ( stats[0]->playerRace == RACE_SUCCUBUS )
-						{
-							if ( enabledDLCPack2 )
-							{
-								stats[0]->playerRace = RACE_INCUBUS;
-								if ( client_classes[0] == CLASS_MESMER && stats[0]->appearance == 0 )
-								{
-									if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-									{
-										client_classes[0] = CLASS_PUNISHER;
-									}
-									stats[0]->clearStats();
-									initClass(0);
-								}
-							}
-							else
-							{
-								stats[0]->playerRace = RACE_HUMAN;
-							}
-						}
-					}
+					drawRect(&saveBox, uint32ColorGreen(*mainsurface), 32);
 				}
-				else if ( omousey >= suby1 + 72 && omousey < suby1 + 90 )
+				else
 				{
-					if ( inputs.bMouseLeft(clientnum) )
+					drawRect(&saveBox, uint32ColorBaronyBlue(*mainsurface), 32);
+				}
+				if ( loadGameSaveShowRectangle == 2 )
+				{
+					saveBox.y = suby1 + TTF12_HEIGHT * 5 + 2;
+					//drawTooltip(&saveBox);
+					drawWindowFancy(saveBox.x, saveBox.y, saveBox.x + saveBox.w, saveBox.y + saveBox.h);
+					if ( gamemods_numCurrentModsLoaded >= 0 )
 					{
-						raceSelect = 0;
-						inputs.mouseClearLeft(clientnum);
-						stats[0]->sex = FEMALE;
-						lastSex = FEMALE;
-						if ( stats[0]->playerRace == RACE_INCUBUS )
-						{
-							if ( enabledDLCPack1 )
-							{
-								stats[0]->playerRace = RACE_SUCCUBUS;
-								if ( client_classes[0] == CLASS_PUNISHER && stats[0]->appearance == 0 )
-								{
-									if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-									{
-										client_classes[0] = CLASS_MESMER;
-									}
-									stats[0]->clearStats();
-									initClass(0);
-								}
-							}
-							else
-							{
-								stats[0]->playerRace = RACE_HUMAN;
-							}
-						}
+						drawRect(&saveBox, uint32ColorGreen(*mainsurface), 32);
+					}
+					else
+					{
+						drawRect(&saveBox, uint32ColorBaronyBlue(*mainsurface), 32);
 					}
 				}
-				else if ( omousey >= pady && omousey < pady + NUMPLAYABLERACES * 17 + (isLocked ? 8 : 0) )
+			}
+			if ( gamemods_window == 1 || gamemods_window == 2 || gamemods_window == 5 )
+			{
+				drawWindowFancy(subx1 + 4, suby1 + 44 + 10 * TTF12_HEIGHT,
+					subx2 - 4, suby2 - 4);
+			}
+			if ( subtext != NULL )
+			{
+				if ( strncmp(subtext, language[740], 12) )
 				{
-					for ( c = 0; c < NUMPLAYABLERACES; ++c )
-					{
-						if ( omousey >= pady && omousey < pady + 17 )
-						{
-							bool disableSelect = false;
-							if ( skipSecondDLC )
-							{
-								if ( c > RACE_GOATMAN )
-								{
-									disableSelect = true;
-								}
-							}
-							else if ( skipFirstDLC )
-							{
-								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID ) // this is weird cause we're reordering the menu above...
-								{
-									disableSelect = true;
-								}
-							}
-							else if ( !enabledDLCPack1 && !enabledDLCPack2 )
-							{
-								if ( c != RACE_HUMAN )
-								{
-									disableSelect = true;
-								}
-							}
-							if ( !disableSelect && inputs.bMouseLeft(clientnum) )
-							{
-								raceSelect = 1;
-								inputs.mouseClearLeft(clientnum);
-								if ( !disableSelect )
-								{
-									PlayerRaces lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
-									if ( skipFirstDLC )
-									{
-										// this is weird cause we're reordering the menu above...
-										if ( c > RACE_GOATMAN )
-										{
-											stats[0]->playerRace = c - 4;
-										}
-										else if ( c > RACE_HUMAN )
-										{
-											stats[0]->playerRace = c + 4;
-										}
-										else
-										{
-											stats[0]->playerRace = c;
-										}
-									}
-									else
-									{
-										stats[0]->playerRace = c;
-									}
-									inputs.mouseClearLeft(clientnum);
-									if ( stats[0]->playerRace == RACE_INCUBUS )
-									{
-										stats[0]->sex = MALE;
-									}
-									else if ( stats[0]->playerRace == RACE_SUCCUBUS )
-									{
-										stats[0]->sex = FEMALE;
-									}
-									else if ( lastRace == RACE_SUCCUBUS || lastRace == RACE_INCUBUS )
-									{
-										stats[0]->sex = lastSex;
-									}
-									// convert human class to monster special classes on reselect.
-									if ( stats[0]->playerRace != RACE_HUMAN && lastRace != RACE_HUMAN && client_classes[0] > CLASS_MONK
-										&& stats[0]->appearance == 0 )
-									{
-										if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-										{
-											client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-										}
-										stats[0]->clearStats();
-										initClass(0);
-									}
-									else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN && client_classes[0] > CLASS_MONK
-										&& lastAppearance == 0 )
-									{
-										if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-										{
-											client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-										}
-										stats[0]->clearStats();
-										initClass(0);
-									}
-									else if ( stats[0]->playerRace != RACE_GOATMAN && lastRace == RACE_GOATMAN )
-									{
-										stats[0]->clearStats();
-										initClass(0);
-									}
-									// appearance reset.
-									if ( stats[0]->playerRace == RACE_HUMAN && lastRace != RACE_HUMAN )
-									{
-										stats[0]->appearance = rand() % NUMAPPEARANCES;
-									}
-									else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN )
-									{
-										stats[0]->appearance = lastAppearance;
-									}
-								}
-								break;
-							}
-							else if ( disableSelect )
-							{
-								SDL_Rect tooltip;
-								tooltip.x = omousex + 16;
-								tooltip.y = omousey + 16;
-								tooltip.h = TTF12_HEIGHT + 8;
-#if (defined STEAMWORKS || defined USE_EOS)
-								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID && !skipFirstDLC )
-								{
-									tooltip.h = TTF12_HEIGHT * 2 + 8;
-									tooltip.w = longestline(language[3917]) * TTF12_WIDTH + 8;
-									drawTooltip(&tooltip);
-									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3917]);
-								}
-								else
-								{
-									tooltip.h = TTF12_HEIGHT * 2 + 8;
-									tooltip.w = longestline(language[3200]) * TTF12_WIDTH + 8;
-									drawTooltip(&tooltip);
-									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3200]);
-								}
-#ifdef STEAMWORKS
-								if ( SteamUser()->BLoggedOn() )
-								{
-									if ( inputs.bMouseLeft(clientnum) )
-									{
-										if ( SteamUtils()->IsOverlayEnabled() )
-										{
-											SteamFriends()->ActivateGameOverlayToStore(STEAM_APPID, k_EOverlayToStoreFlag_None);
-										}
-										else
-										{
-											if ( c > RACE_GOATMAN && c <= RACE_INSECTOID && !skipFirstDLC )
-											{
-												openURLTryWithOverlay(language[3993]);
-											}
-											else
-											{
-												openURLTryWithOverlay(language[3992]);
-											}
-										}
-										inputs.mouseClearLeft(clientnum);
-									}
-								}
-#elif defined USE_EOS
-								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID && !skipFirstDLC )
-								{
-									if ( inputs.bMouseLeft(clientnum) )
-									{
-										openURLTryWithOverlay(language[3985]);
-										inputs.mouseClearLeft(clientnum);
-									}
-								}
-								else
-								{
-									if ( inputs.bMouseLeft(clientnum) )
-									{
-										openURLTryWithOverlay(language[3984]);
-										inputs.mouseClearLeft(clientnum);
-									}
-								}
-#endif
-#else
-								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID )
-								{
-									tooltip.w = longestline(language[3372]) * TTF12_WIDTH + 8;
-									drawTooltip(&tooltip);
-									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3372]);
-								}
-								else
-								{
-									tooltip.w = longestline(language[3199]) * TTF12_WIDTH + 8;
-									drawTooltip(&tooltip);
-									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3199]);
-								}
-#endif // STEAMWORKS
-							}
-						}
-						pady += 17;
-						if ( isLocked )
-						{
-							if ( skipFirstDLC && c == RACE_INSECTOID )
-							{
-								pady += 8;
-							}
-							else
-							{
-								if ( skipSecondDLC && c == RACE_GOATMAN )
-								{
-									pady += 8;
-								}
-								else if ( !enabledDLCPack1 && !enabledDLCPack2 && c == RACE_HUMAN )
-								{
-									pady += 8;
-								}
-							}
-						}
-					}
+					ttfPrintTextFormatted(ttf12, subx1 + 8, suby1 + 8, subtext);
 				}
-				else if ( omousey >= pady + (NUMPLAYABLERACES * 17) + 48 && omousey < pady + (NUMPLAYABLERACES * 17) + 82 )
+				else
 				{
-					if ( inputs.bMouseLeft(clientnum) )
-					{
-						inputs.mouseClearLeft(clientnum);
-						if ( stats[0]->playerRace > 0 )
-						{
-							if ( omousey < pady + (NUMPLAYABLERACES * 17) + 64 ) // first option
-							{
-								if ( stats[0]->appearance != 0 )
-								{
-									stats[0]->appearance = 0; // use racial passives
-									// convert human class to monster special classes on reselect.
-									if ( client_classes[0] > CLASS_MONK )
-									{
-										if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-										{
-											client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-										}
-									}
-								}
-							}
-							else
-							{
-								stats[0]->appearance = 1; // act as human
-							}
-							lastAppearance = stats[0]->appearance;
-							stats[0]->clearStats();
-							initClass(0);
-							raceSelect = 2;
-							inputs.mouseClearLeft(clientnum);
-						}
-					}
+					ttfPrintTextFormatted(ttf16, subx1 + 8, suby1 + 8, subtext);
 				}
 			}
-			if ( keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
+			if ( loadGameSaveShowRectangle > 0 && gamemods_numCurrentModsLoaded >= 0 )
 			{
-				keystatus[SDL_SCANCODE_UP] = 0;
-				if ( rebindaction == -1 )
-				{
-					inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
-				}
-				inputs.hideMouseCursors();
-				if ( raceSelect == 1 )
-				{
-					PlayerRaces lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
-					if ( !enabledDLCPack1 && !enabledDLCPack2 )
-					{
-						// do nothing.
-						stats[0]->playerRace = RACE_HUMAN;
-					}
-					else if ( stats[0]->playerRace <= 0 )
-					{
-						if ( skipSecondDLC )
-						{
-							stats[0]->playerRace = NUMPLAYABLERACES - 5;
-						}
-						else if ( enabledDLCPack2 )
-						{
-							stats[0]->playerRace = NUMPLAYABLERACES - 1;
-						}
-					}
-					else
-					{
-						if ( skipFirstDLC && stats[0]->playerRace == RACE_AUTOMATON )
-						{
-							stats[0]->playerRace = RACE_HUMAN;
-						}
-						else
-						{
-							--stats[0]->playerRace;
-						}
-					}
-					if ( stats[0]->playerRace == RACE_INCUBUS )
-					{
-						stats[0]->sex = MALE;
-					}
-					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
-					{
-						stats[0]->sex = FEMALE;
-					}
-					else if ( lastRace == RACE_SUCCUBUS || lastRace == RACE_INCUBUS )
-					{
-						stats[0]->sex = lastSex;
-					}
-					// convert human class to monster special classes on reselect.
-					if ( stats[0]->playerRace != RACE_HUMAN && lastRace != RACE_HUMAN && client_classes[0] > CLASS_MONK
-						&& stats[0]->appearance == 0 )
-					{
-						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-						{
-							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-						}
-						stats[0]->clearStats();
-						initClass(0);
-					}
-					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN && client_classes[0] > CLASS_MONK
-						&& lastAppearance == 0 )
-					{
-						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-						{
-							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-						}
-						stats[0]->clearStats();
-						initClass(0);
-					}
-					else if ( stats[0]->playerRace != RACE_GOATMAN && lastRace == RACE_GOATMAN )
-					{
-						stats[0]->clearStats();
-						initClass(0);
-					}
-					// appearance reset.
-					if ( stats[0]->playerRace == RACE_HUMAN && lastRace != RACE_HUMAN )
-					{
-						stats[0]->appearance = rand() % NUMAPPEARANCES;
-					}
-					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN )
-					{
-						stats[0]->appearance = lastAppearance;
-					}
-				}
-				else if ( raceSelect == 0 )
-				{
-					stats[0]->sex = static_cast<sex_t>((stats[0]->sex == MALE));
-					lastSex = stats[0]->sex;
-					if ( stats[0]->playerRace == RACE_INCUBUS )
-					{
-						stats[0]->sex = MALE;
-					}
-					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
-					{
-						stats[0]->sex = FEMALE;
-					}
-				}
-				else if ( raceSelect == 2 )
-				{
-					if ( stats[0]->appearance != 0 )
-					{
-						stats[0]->appearance = 0;
-						// convert human class to monster special classes on reselect.
-						if ( stats[0]->playerRace != RACE_HUMAN && client_classes[0] > CLASS_MONK )
-						{
-							if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-							{
-								client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-							}
-							stats[0]->clearStats();
-							initClass(0);
-						}
-					}
-					else
-					{
-						stats[0]->appearance = 1;
-					}
-					lastAppearance = stats[0]->appearance;
-					stats[0]->clearStats();
-					initClass(0);
-				}
+				ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - TTF12_HEIGHT * 5, uint32ColorBaronyBlue(*mainsurface), "%s", language[2982]);
 			}
-			if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
+		}
+		else
+		{
+			loadGameSaveShowRectangle = 0;
+		}
+
+		LobbyHandler.drawLobbyFilters();
+
+		// process button actions
+		handleButtons();
+
+		LobbyHandler.handleLobbyBrowser();
+	}
+
+	// character creation screen
+	if ( charcreation_step >= 1 && charcreation_step < 6 )
+	{
+		if ( gamemods_numCurrentModsLoaded >= 0 )
+		{
+			ttfPrintText(ttf16, subx1 + 8, suby1 + 8, language[2980]);
+		}
+		else
+		{
+			ttfPrintText(ttf16, subx1 + 8, suby1 + 8, language[1318]);
+		}
+
+		// draw character window
+		if (players[clientnum] != nullptr && players[clientnum]->entity != nullptr)
+		{
+			camera_charsheet.x = players[clientnum]->entity->x / 16.0 + 1.118 * cos(camera_charsheet_offsetyaw); // + 1
+			camera_charsheet.y = players[clientnum]->entity->y / 16.0 + 1.118 * sin(camera_charsheet_offsetyaw); // -.5
+			if ( !stats[clientnum]->EFFECTS[EFF_ASLEEP] )
 			{
-				keystatus[SDL_SCANCODE_DOWN] = 0;
-				if ( rebindaction == -1 )
-				{
-					inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
-				}
-				inputs.hideMouseCursors();
-				if ( raceSelect == 1 )
-				{
-					PlayerRaces lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
-					if ( !enabledDLCPack1 && !enabledDLCPack2 )
-					{
-						// do nothing.
-						stats[0]->playerRace = RACE_HUMAN;
-					}
-					else if ( skipSecondDLC )
-					{
-						if ( stats[0]->playerRace >= NUMPLAYABLERACES - 5 )
-						{
-							stats[0]->playerRace = RACE_HUMAN;
-						}
-						else
-						{
-							++stats[0]->playerRace;
-						}
-					}
-					else if ( skipFirstDLC )
-					{
-						if ( stats[0]->playerRace >= RACE_GOATMAN && stats[0]->playerRace < NUMPLAYABLERACES - 1 )
-						{
-							++stats[0]->playerRace;
-						}
-						else if ( stats[0]->playerRace == RACE_HUMAN )
-						{
-							stats[0]->playerRace = RACE_AUTOMATON;
-						}
-						else if ( stats[0]->playerRace == NUMPLAYABLERACES - 1 )
-						{
-							stats[0]->playerRace = RACE_HUMAN;
-						}
-					}
-					else
-					{
-						if ( stats[0]->playerRace >= NUMPLAYABLERACES - 1 )
-						{
-							stats[0]->playerRace = RACE_HUMAN;
-						}
-						else
-						{
-							++stats[0]->playerRace;
-						}
-					}
-					if ( stats[0]->playerRace == RACE_INCUBUS )
-					{
-						stats[0]->sex = MALE;
-					}
-					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
-					{
-						stats[0]->sex = FEMALE;
-					}
-					else if ( lastRace == RACE_SUCCUBUS || lastRace == RACE_INCUBUS )
-					{
-						stats[0]->sex = lastSex;
-					}
-					// convert human class to monster special classes on reselect.
-					if ( stats[0]->playerRace != RACE_HUMAN && lastRace != RACE_HUMAN && client_classes[0] > CLASS_MONK
-						&& stats[0]->appearance == 0 )
-					{
-						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-						{
-							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-						}
-						stats[0]->clearStats();
-						initClass(0);
-					}
-					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN && client_classes[0] > CLASS_MONK 
-						&& lastAppearance == 0 )
-					{
-						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-						{
-							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-						}
-						stats[0]->clearStats();
-						initClass(0);
-					}
-					else if ( stats[0]->playerRace != RACE_GOATMAN && lastRace == RACE_GOATMAN )
-					{
-						stats[0]->clearStats();
-						initClass(0);
-					}
-					// appearance reset.
-					if ( stats[0]->playerRace == RACE_HUMAN && lastRace != RACE_HUMAN )
-					{
-						stats[0]->appearance = rand() % NUMAPPEARANCES;
-					}
-					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN )
-					{
-						stats[0]->appearance = lastAppearance;
-					}
-				}
-				else if ( raceSelect == 0 )
+				camera_charsheet.z = players[clientnum]->entity->z * 2;
+			}
+			else
+			{
+				camera_charsheet.z = 1.5;
+			}
+			camera_charsheet.ang = atan2(players[clientnum]->entity->y / 16.0 - camera_charsheet.y, players[clientnum]->entity->x / 16.0 - camera_charsheet.x);
+			camera_charsheet.vang = PI / 24;
+			camera_charsheet.winw = 360;
+			camera_charsheet.winy = suby1 + 32;
+			camera_charsheet.winh = suby2 - 96 - camera_charsheet.winy;
+			camera_charsheet.winx = subx2 - camera_charsheet.winw - 32;
+			SDL_Rect pos;
+			pos.x = camera_charsheet.winx;
+			pos.y = camera_charsheet.winy;
+			pos.w = camera_charsheet.winw;
+			pos.h = camera_charsheet.winh;
+			drawRect(&pos, 0, 255);
+			b = players[clientnum]->entity->flags[BRIGHT];
+			players[clientnum]->entity->flags[BRIGHT] = true;
+			if (!playing_random_char)
+			{
+				if ( !players[clientnum]->entity->flags[INVISIBLE] )
 				{
-					stats[0]->sex = static_cast<sex_t>((stats[0]->sex == MALE));
-					lastSex = stats[0]->sex;
-					if ( stats[0]->playerRace == RACE_INCUBUS )
-					{
-						stats[0]->sex = MALE;
-					}
-					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
-					{
-						stats[0]->sex = FEMALE;
-					}
+					real_t ofov = fov;
+					fov = 50;
+					glDrawVoxel(&camera_charsheet, players[clientnum]->entity, REALCOLORS);
+					fov = ofov;
 				}
-				else if ( raceSelect == 2 )
+				players[clientnum]->entity->flags[BRIGHT] = b;
+				c = 0;
+				for ( node = players[clientnum]->entity->children.first; node != NULL; node = node->next )
 				{
-					if ( stats[0]->appearance != 0 )
+					if ( c == 0 )
 					{
-						stats[0]->appearance = 0;
-						// convert human class to monster special classes on reselect.
-						if ( stats[0]->playerRace != RACE_HUMAN && client_classes[0] > CLASS_MONK )
-						{
-							if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
-							{
-								client_classes[0] = CLASS_MONK + stats[0]->playerRace;
-							}
-							stats[0]->clearStats();
-							initClass(0);
-						}
+						c++;
 					}
-					else
+					entity = (Entity*) node->element;
+					if ( !entity->flags[INVISIBLE] )
 					{
-						stats[0]->appearance = 1;
+						b = entity->flags[BRIGHT];
+						entity->flags[BRIGHT] = true;
+						real_t ofov = fov;
+						fov = 50;
+						glDrawVoxel(&camera_charsheet, entity, REALCOLORS);
+						fov = ofov;
+						entity->flags[BRIGHT] = b;
 					}
-					lastAppearance = stats[0]->appearance;
-					stats[0]->clearStats();
-					initClass(0);
+					c++;
 				}
 			}
-			if ( keystatus[SDL_SCANCODE_RIGHT] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_RIGHT) && rebindaction == -1) )
+			SDL_Rect rotateBtn;
+			rotateBtn.w = 24;
+			rotateBtn.h = 24;
+			rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w;
+			rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
+			drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
+			if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
 			{
-				keystatus[SDL_SCANCODE_RIGHT] = 0;
-				if ( rebindaction == -1 )
-				{
-					inputs.controllerClearInput(clientnum, INJOY_DPAD_RIGHT);
-				}
-				inputs.hideMouseCursors();
-				++raceSelect;
-				if ( stats[0]->playerRace == RACE_HUMAN )
+				if ( inputs.bMouseLeft(clientnum) )
 				{
-					if ( raceSelect > 1 )
+					camera_charsheet_offsetyaw += 0.05;
+					if ( camera_charsheet_offsetyaw > 2 * PI )
 					{
-						raceSelect = 0;
+						camera_charsheet_offsetyaw -= 2 * PI;
 					}
-				}
-				else if ( raceSelect > 2 )
-				{
-					raceSelect = 0;
+					drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
 				}
 			}
-			if ( keystatus[SDL_SCANCODE_LEFT] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_LEFT) && rebindaction == -1) )
+			ttfPrintText(ttf12, rotateBtn.x + 4, rotateBtn.y + 6, ">");
+
+			rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w * 2 - 4;
+			rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
+			drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
+			if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
 			{
-				keystatus[SDL_SCANCODE_LEFT] = 0;
-				if ( rebindaction == -1 )
-				{
-					inputs.controllerClearInput(clientnum, INJOY_DPAD_LEFT);
-				}
-				inputs.hideMouseCursors();
-				--raceSelect;
-				if ( stats[0]->playerRace == RACE_HUMAN )
+				if ( inputs.bMouseLeft(clientnum) )
 				{
-					if ( raceSelect < 0 )
+					camera_charsheet_offsetyaw -= 0.05;
+					if ( camera_charsheet_offsetyaw < 0.f )
 					{
-						raceSelect = 1;
+						camera_charsheet_offsetyaw += 2 * PI;
 					}
+					drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
 				}
-				else if ( raceSelect < 0 )
+			}
+			ttfPrintText(ttf12, rotateBtn.x + 4, rotateBtn.y + 6, "<");
+
+			SDL_Rect raceInfoBtn;
+			raceInfoBtn.y = rotateBtn.y;
+			raceInfoBtn.w = longestline(language[3373]) * TTF12_WIDTH + 8 + 4;
+			raceInfoBtn.x = rotateBtn.x - raceInfoBtn.w - 4;
+			raceInfoBtn.h = rotateBtn.h;
+			drawWindow(raceInfoBtn.x, raceInfoBtn.y, raceInfoBtn.x + raceInfoBtn.w, raceInfoBtn.y + raceInfoBtn.h);
+			if ( mouseInBounds(clientnum, raceInfoBtn.x, raceInfoBtn.x + raceInfoBtn.w, raceInfoBtn.y, raceInfoBtn.y + raceInfoBtn.h) )
+			{
+				if ( inputs.bControllerInputPressed(clientnum, INJOY_MENU_LEFT_CLICK) || inputs.bMouseLeft(clientnum) )
 				{
-					raceSelect = 2;
+					//drawDepressed(raceInfoBtn.x, raceInfoBtn.y, raceInfoBtn.x + raceInfoBtn.w, raceInfoBtn.y + raceInfoBtn.h);
+					inputs.mouseClearLeft(clientnum);
+					inputs.controllerClearInput(clientnum, INJOY_MENU_LEFT_CLICK);
+					showRaceInfo = !showRaceInfo;
+					playSound(139, 64);
 				}
 			}
-			if ( lastRace != RACE_GOATMAN && stats[0]->playerRace == RACE_GOATMAN && stats[0]->appearance == 0 )
+			if ( showRaceInfo )
 			{
-				stats[0]->clearStats();
-				initClass(0);
+				pos.y += 2;
+				pos.h -= raceInfoBtn.h + 6;
+				pos.x += 2;
+				pos.w -= 6;
+				drawRect(&pos, 0, 168);
+				drawLine(pos.x, pos.y, pos.x + pos.w, pos.y, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
+				drawLine(pos.x, pos.y + pos.h, pos.x + pos.w, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
+				drawLine(pos.x, pos.y, pos.x, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
+				drawLine(pos.x + pos.w, pos.y, pos.x + pos.w, pos.y + pos.h, SDL_MapRGB(mainsurface->format, 0, 192, 255), 255);
+				if ( stats[0]->playerRace >= RACE_HUMAN )
+				{
+					ttfPrintText(ttf12, pos.x + 12, pos.y + 6, language[3375 + stats[0]->playerRace]);
+				}
+				ttfPrintText(ttf12, raceInfoBtn.x + 4, raceInfoBtn.y + 6, language[3374]);
+			}
+			else
+			{
+				ttfPrintText(ttf12, raceInfoBtn.x + 4, raceInfoBtn.y + 6, language[3373]);
 			}
 		}
 
-		// classes
-		else if ( charcreation_step == 2 )
+		// skin DLC check flags.
+		bool skipFirstDLC = false;
+		bool skipSecondDLC = false;
+		if ( enabledDLCPack2 && !enabledDLCPack1 )
 		{
-			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1323]);
-			int entriesToDisplay = NUMCLASSES;
-			if ( enabledDLCPack1 && enabledDLCPack2 )
+			skipFirstDLC = true;
+			if ( stats[0]->playerRace > 0 && stats[0]->playerRace <= RACE_GOATMAN )
 			{
-				entriesToDisplay = NUMCLASSES;
+				stats[0]->playerRace = RACE_HUMAN;
 			}
-			else if ( enabledDLCPack1 || enabledDLCPack2 )
+		}
+		else if ( enabledDLCPack1 && !enabledDLCPack2 )
+		{
+			skipSecondDLC = true;
+			if ( stats[0]->playerRace > RACE_GOATMAN )
 			{
-				entriesToDisplay = NUMCLASSES - 4;
+				stats[0]->playerRace = RACE_HUMAN;
 			}
-			else
+		}
+		else if ( !enabledDLCPack1 && !enabledDLCPack2 )
+		{
+			stats[0]->playerRace = RACE_HUMAN;
+		}
+
+		// sexes/race
+		if ( charcreation_step == 1 )
+		{
+			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1319]);
+			Uint32 colorStep1 = uint32ColorWhite(*mainsurface);
+			if ( raceSelect != 0 )
 			{
-				entriesToDisplay = CLASS_MONK + 1;
+				colorStep1 = uint32ColorGray(*mainsurface);
 			}
+			if ( stats[0]->sex == 0 )
+			{
+				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 56, colorStep1, "[o] %s", language[1321]);
+				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 73, colorStep1, "[ ] %s", language[1322]);
 
-			std::set<int> availableClasses;
-			std::set<int> lockedClasses;
-			std::vector<int> displayedClasses;
-			for ( c = 0; c < NUMCLASSES; ++c )
+				ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - 80, uint32ColorWhite(*mainsurface), language[1320], language[1321]);
+			}
+			else
 			{
-				int result = isCharacterValidFromDLC(*stats[0], c);
-				if ( result == VALID_OK_CHARACTER )
-				{
-					availableClasses.insert(c);
-					displayedClasses.push_back(c);
-				}
-				else if ( result == INVALID_REQUIRE_ACHIEVEMENT )
-				{
-					lockedClasses.insert(c);
-				}
+				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 56, colorStep1, "[ ] %s", language[1321]);
+				ttfPrintTextFormattedColor(ttf16, subx1 + 32, suby1 + 73, colorStep1, "[o] %s", language[1322]);
+
+				ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - 80, uint32ColorWhite(*mainsurface), language[1320], language[1322]);
 			}
+			ttfPrintTextFormattedColor(ttf12, subx1 + 8, suby2 - 56, uint32ColorWhite(*mainsurface), language[3175]);
 
-			for ( auto it = lockedClasses.begin(); it != lockedClasses.end(); ++it )
+			// race
+			if ( raceSelect != 1 )
 			{
-				displayedClasses.push_back(*it);
+				colorStep1 = uint32ColorGray(*mainsurface);
 			}
-
-			int drawLockedTooltip = 0;
-			SDL_Rect tooltip;
-			for ( c = 0; c < entriesToDisplay; c++ )
+			else if ( raceSelect == 1 )
 			{
-				int classToPick = displayedClasses.at(c);
-				int pady = suby1 + 56 + 16 * c;
-				if ( lockedClasses.find(classToPick) != lockedClasses.end() )
-				{
-					pady += 8;
-				}
-
-				if ( inputs.bMouseLeft(clientnum) )
-				{
-					if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
-					{
-						if ( omousey >= pady && omousey < pady + 16 )
-						{
-							inputs.mouseClearLeft(clientnum);
-							if ( isCharacterValidFromDLC(*stats[0], classToPick) == VALID_OK_CHARACTER )
-							{
-								int previousClassPicked = client_classes[0];
-								client_classes[0] = classToPick;
-								if ( previousClassPicked != client_classes[0] )
-								{
-									// reset class loadout
-									stats[0]->clearStats();
-									initClass(0);
-								}
-							}
-						}
-					}
-				}
-
-				bool classLocked = false;
-
-				if ( classToPick == client_classes[0] )
-				{
-					ttfPrintTextFormatted(ttf16, subx1 + 32, pady, "[o] %s", playerClassLangEntry(classToPick, 0));
-				}
-				else
-				{
-					if ( lockedClasses.find(classToPick) != lockedClasses.end() )
-					{
-						classLocked = true;
-						SDL_Rect img;
-						img.x = subx1 + 32 + 10;
-						img.y = pady - 2;
-						img.w = 22;
-						img.h = 20;
-						drawImageScaled(sidebar_unlock_bmp, nullptr, &img);
-						ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, uint32ColorGray(*mainsurface), "[ ] %s", playerClassLangEntry(classToPick, 0));
-
-						if ( mouseInBounds(clientnum, subx1 + 40, subx1 + 72, pady, pady + 16) )
-						{
-#if (defined STEAMWORKS || defined USE_EOS)
-							tooltip.x = omousex + 16;
-							tooltip.y = omousey + 16;
-							tooltip.h = TTF12_HEIGHT + 8;
-							if ( classToPick > CLASS_MONK )
-							{
-								int langline = 3927 + classToPick - CLASS_CONJURER;
-								tooltip.w = longestline(language[langline]) * TTF12_WIDTH + 8;
-								drawLockedTooltip = langline;
-							}
-#endif
-						}
-					}
-					else
-					{
-						ttfPrintTextFormatted(ttf16, subx1 + 32, pady, "[ ] %s", playerClassLangEntry(classToPick, 0));
-					}
-				}
-
-				if ( keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
+				colorStep1 = uint32ColorWhite(*mainsurface);
+			}
+			ttfPrintText(ttf16, subx1 + 24, suby1 + 108, language[3160]);
+			int pady = suby1 + 108 + 24;
+			bool isLocked = false;
+			for ( int c = 0; c < NUMPLAYABLERACES; )
+			{
+				if ( raceSelect == 1 )
 				{
-					keystatus[SDL_SCANCODE_UP] = 0;
-					if ( rebindaction == -1 )
-					{
-						inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
-					}
-					inputs.hideMouseCursors();
-
-					int previousClassPicked = client_classes[0];
-					if ( client_classes[0] == 0 )
-					{
-						client_classes[0] = *(availableClasses.rbegin());;
-					}
-					else
+					if ( skipSecondDLC )
 					{
-						auto it = availableClasses.find(client_classes[0]);
-						if ( it != availableClasses.end() )
+						if ( c > RACE_GOATMAN )
 						{
-							client_classes[0] = *(--it); // get previous element
+							colorStep1 = uint32ColorGray(*mainsurface);
 						}
 						else
 						{
-							client_classes[0] = 0;
+							colorStep1 = uint32ColorWhite(*mainsurface);
 						}
 					}
-
-					if ( previousClassPicked != client_classes[0] )
-					{
-						// reset class loadout
-						stats[0]->clearStats();
-						initClass(0);
-					}
-				}
-				if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
-				{
-					keystatus[SDL_SCANCODE_DOWN] = 0;
-					if ( rebindaction == -1 )
-					{
-						inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
-					}
-					inputs.hideMouseCursors();
-
-					auto it = availableClasses.find(client_classes[0]);
-					int previousClassPicked = client_classes[0];
-					if ( it != availableClasses.end() )
+					else if ( skipFirstDLC )
 					{
-						auto nextIt = std::next(it, 1);
-						if ( nextIt == availableClasses.end() )
+						if ( c > RACE_HUMAN && c <= RACE_GOATMAN )
 						{
-							client_classes[0] = 0;
+							colorStep1 = uint32ColorGray(*mainsurface);
 						}
 						else
 						{
-							client_classes[0] = *(++it); // get next element
+							colorStep1 = uint32ColorWhite(*mainsurface);
 						}
 					}
-					else
+					else if ( !(enabledDLCPack2 && enabledDLCPack1) )
 					{
-						client_classes[0] = 0;
+						if ( c > RACE_HUMAN )
+						{
+							colorStep1 = uint32ColorGray(*mainsurface);
+						}
+						else
+						{
+							colorStep1 = uint32ColorWhite(*mainsurface);
+						}
 					}
-
-					if ( previousClassPicked != client_classes[0] )
+					else if ( enabledDLCPack2 && enabledDLCPack1 )
 					{
-						// reset class loadout
-						stats[0]->clearStats();
-						initClass(0);
+						colorStep1 = uint32ColorWhite(*mainsurface);
 					}
 				}
-			}
-
-			// class description
-			ttfPrintText(ttf12, subx1 + 8, suby2 - 80, playerClassDescription(client_classes[0], 0));
-
-			if ( drawLockedTooltip > 0 )
-			{
-				drawTooltip(&tooltip);
-				ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6,
-					uint32ColorOrange(*mainsurface), language[drawLockedTooltip]);
-			}
-		}
-
-		// faces
-		else if ( charcreation_step == 3 )
-		{
-			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1324]);
-			for ( c = 0; c < NUMAPPEARANCES; c++ )
-			{
-				if ( stats[0]->appearance == c )
+				if ( stats[0]->playerRace == c )
 				{
-					ttfPrintTextFormatted(ttf16, subx1 + 32, suby1 + 56 + c * 16, "[o] %s", language[20 + c]);
-					ttfPrintText(ttf12, subx1 + 8, suby2 - 80, language[38 + c]);
+					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[o] %s", language[3161 + c]);
 				}
 				else
 				{
-					ttfPrintTextFormatted(ttf16, subx1 + 32, suby1 + 56 + c * 16, "[ ] %s", language[20 + c]);
-				}
-				if ( inputs.bMouseLeft(clientnum) )
-				{
-					if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
+					if ( skipSecondDLC )
 					{
-						if ( omousey >= suby1 + 56 + 16 * c && omousey < suby1 + 72 + 16 * c )
+						if ( c > RACE_GOATMAN )
 						{
-							inputs.mouseClearLeft(clientnum);
-							stats[0]->appearance = c;
+							isLocked = true;
 						}
 					}
-				}
-				if ( keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
-				{
-					keystatus[SDL_SCANCODE_UP] = 0;
-					if ( rebindaction == -1 )
+					else if ( skipFirstDLC )
 					{
-						inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
+						if ( c >= RACE_SKELETON && c < RACE_AUTOMATON )
+						{
+							isLocked = true;
+						}
 					}
-					inputs.hideMouseCursors();
-					stats[0]->appearance--;
-					if (stats[0]->appearance >= NUMAPPEARANCES)
+					else if ( !enabledDLCPack1 && !enabledDLCPack2 )
 					{
-						stats[0]->appearance = NUMAPPEARANCES - 1;
+						isLocked = true;
+					}
+					if ( isLocked )
+					{
+						SDL_Rect img;
+						img.x = subx1 + 32 + 10;
+						img.y = pady - 2;
+						img.w = 22;
+						img.h = 20;
+						drawImageScaled(sidebar_unlock_bmp, nullptr, &img);
+						ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[ ] %s", language[3161 + c]);
+					}
+					else
+					{
+						ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[ ] %s", language[3161 + c]);
 					}
 				}
-				if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
+
+				if ( skipFirstDLC )
 				{
-					keystatus[SDL_SCANCODE_DOWN] = 0;
-					if ( rebindaction == -1 )
+					if ( c == RACE_HUMAN )
 					{
-						inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
+						c = RACE_AUTOMATON;
 					}
-					inputs.hideMouseCursors();
-					stats[0]->appearance++;
-					if (stats[0]->appearance >= NUMAPPEARANCES)
+					else if ( c == RACE_INSECTOID )
 					{
-						stats[0]->appearance = 0;
+						c = RACE_SKELETON;
+						pady += 8;
+					}
+					else if ( c == RACE_GOATMAN )
+					{
+						c = NUMPLAYABLERACES;
+					}
+					else
+					{
+						++c;
 					}
 				}
-			}
-		}
-
-		// name
-		else if ( charcreation_step == 4 )
-		{
-			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1325]);
-			drawDepressed(subx1 + 40, suby1 + 56, subx1 + 364, suby1 + 88);
-			ttfPrintText(ttf16, subx1 + 48, suby1 + 64, stats[0]->name);
-			ttfPrintText(ttf12, subx1 + 8, suby2 - 80, language[1326]);
-
-			// enter character name
-			if ( !SDL_IsTextInputActive() )
-			{
-				if (inputstr != stats[0]->name) //TODO: NX PORT: Not sure if this portion is correct...the PC version of this chunk has changed significantly in the interleaving time.
+				else
 				{
-					inputstr = stats[0]->name;
-#ifdef NINTENDO
-					auto result = nxKeyboard("Enter your character's name");
-					if (result.success)
+					if ( skipSecondDLC && c == RACE_GOATMAN )
 					{
-						strncpy(inputstr, result.str.c_str(), 21);
-						inputstr[21] = '\0';
+						pady += 8;
 					}
-#endif
+					else if ( !enabledDLCPack1 && !enabledDLCPack2 && c == RACE_HUMAN )
+					{
+						pady += 8;
+					}
+					++c;
 				}
-				SDL_StartTextInput();
-			}
-			//strncpy(stats[0]->name,inputstr,16);
-			inputlen = 22;
-			if (lastname != "" && strlen(inputstr) == 0)
-			{
-				strncat(inputstr, lastname.c_str(), std::max<size_t>(0, inputlen - strlen(inputstr)));
-				lastname = ""; // Set this to nothing while we're currently editing so it doesn't keep filling it.  We'll save it again if we leave this tab.
+				pady += 17;
 			}
 
-			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+			pady += 24;
+			if ( isLocked )
 			{
-				int x;
-				getSizeOfText(ttf16, stats[0]->name, &x, NULL);
-				ttfPrintText(ttf16, subx1 + 48 + x, suby1 + 64, "_");
+				pady -= 8;
 			}
-		}
-
-		// gamemode
-		else if ( charcreation_step == 5 )
-		{
-			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1327]);
-
-			std::vector<Sint32> optionY;
-			std::vector<char*> optionTexts;
-			std::vector<char*> optionSubtexts;
-			std::vector<char*> optionDescriptions;
-			std::vector<Uint32> displayedOptionToGamemode;
-			Uint32 optionHeight = TTF12_HEIGHT + 2;
-			int nummodes = 3;
-#if (defined USE_EOS && defined STEAMWORKS)
-			nummodes += 2;
-			if ( LobbyHandler.crossplayEnabled )
+			bool displayRaceOptions = false;
+			if ( raceSelect != 2 )
 			{
-				nummodes += 1;
-				optionY.insert(optionY.end(), { suby1 + 56, suby1 + 86, suby1 + 128, suby1 + 178, suby1 + 216, suby1 + 256 });
-				optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1330], language[1332], language[1330], language[1332] });
-				optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[3946], language[3947], language[3945], language[1538], language[1539] });
-				optionSubtexts.insert(optionSubtexts.end(), { nullptr, language[3943], language[3944], nullptr, language[1537], language[1537] });
-				displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, SERVERCROSSPLAY, CLIENT, DIRECTSERVER, DIRECTCLIENT});
+				colorStep1 = uint32ColorGray(*mainsurface);
 			}
 			else
 			{
-				optionY.insert(optionY.end(), { suby1 + 56, suby1 + 76, suby1 + 96, suby1 + 136, suby1 + 176, 0 });
-				optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1332], language[1330], language[1332], nullptr });
-				optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[1331], language[1333], language[1538], language[1539], nullptr });
-				optionSubtexts.insert(optionSubtexts.end(), { nullptr, nullptr, nullptr, language[1537], language[1537], nullptr });
-				displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, CLIENT, DIRECTSERVER, DIRECTCLIENT, 0 });
+				colorStep1 = uint32ColorWhite(*mainsurface);
 			}
-#elif (defined(USE_EOS) || defined(STEAMWORKS))
-			nummodes += 2;
-			optionY.insert(optionY.end(), { suby1 + 56, suby1 + 76, suby1 + 96, suby1 + 136, suby1 + 176, 0 });
-			optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1332], language[1330], language[1332], nullptr });
-			optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[1331], language[1333], language[1538], language[1539], nullptr });
-			optionSubtexts.insert(optionSubtexts.end(), { nullptr, nullptr, nullptr, language[1537], language[1537] });
-			displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, CLIENT, DIRECTSERVER, DIRECTCLIENT, 0 });
-#else
-			optionY.insert(optionY.end(), { suby1 + 56, suby1 + 76, suby1 + 96, suby1 + 136, suby1 + 176, 0 });
-			optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1332], language[1330], language[1332], nullptr });
-			optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[1331], language[1333], language[1538], language[1539], nullptr });
-			optionSubtexts.insert(optionSubtexts.end(), { nullptr, nullptr, nullptr, language[1537], language[1537] });
-			displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, CLIENT, DIRECTSERVER, DIRECTCLIENT, 0 });
-#endif
-			for ( int mode = 0; mode < nummodes; mode++ )
-			{
-				char selected = ' ';
-				if ( multiplayerselect == displayedOptionToGamemode.at(mode) )
-				{
-					selected = 'o';
-				}
-				if ( optionSubtexts.at(mode) == nullptr )
+			if ( stats[0]->playerRace > 0 )
+			{
+				displayRaceOptions = true;
+				ttfPrintText(ttf16, subx1 + 24, pady, language[3176]);
+				pady += 24;
+				char raceOptionBuffer[128];
+				snprintf(raceOptionBuffer, 63, language[3177], language[3161 + stats[0]->playerRace]);
+				if ( stats[0]->appearance > 1 )
 				{
-					ttfPrintTextFormatted(ttf16, subx1 + 32, optionY.at(mode), "[%c] %s", selected, optionTexts.at(mode));
+					stats[0]->appearance = lastAppearance;
 				}
-				else
+				if ( stats[0]->appearance == 0 )
 				{
-					ttfPrintTextFormatted(ttf16, subx1 + 32, optionY.at(mode), "[%c] %s\n     %s", selected, optionTexts.at(mode), optionSubtexts.at(mode));
+					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[o] %s", raceOptionBuffer);
+					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady + 17, colorStep1, "[ ] %s", language[3178]);
 				}
-				if ( selected == 'o' ) // draw description
+				else if ( stats[0]->appearance == 1 )
 				{
-					ttfPrintText(ttf12, subx1 + 8, suby2 - 80, optionDescriptions.at(mode));
+					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, colorStep1, "[ ] %s", raceOptionBuffer);
+					ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady + 17, colorStep1, "[o] %s", language[3178]);
 				}
 
-				if ( multiplayerselect == SINGLE )
+			}
+
+			pady = suby1 + 108 + 24;
+			lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
+			if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
+			{
+				if ( omousey >= suby1 + 56 && omousey < suby1 + 72 )
 				{
-					if ( singleplayerSavegameFreeSlot == -1 )
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60, uint32ColorOrange(*mainsurface), true, language[2965]);
+						raceSelect = 0;
+						inputs.mouseClearLeft(clientnum);
+						stats[0]->sex = MALE;
+						lastSex = MALE;
+						if ( stats[0]->playerRace == RACE_SUCCUBUS )
+						{
+							if ( enabledDLCPack2 )
+							{
+								stats[0]->playerRace = RACE_INCUBUS;
+								if ( client_classes[0] == CLASS_MESMER && stats[0]->appearance == 0 )
+								{
+									if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+									{
+										client_classes[0] = CLASS_PUNISHER;
+									}
+									stats[0]->clearStats();
+									initClass(0);
+								}
+							}
+							else
+							{
+								stats[0]->playerRace = RACE_HUMAN;
+							}
+						}
 					}
 				}
-				else if ( multiplayerselect > SINGLE )
+				else if ( omousey >= suby1 + 72 && omousey < suby1 + 90 )
 				{
-					if ( multiplayerSavegameFreeSlot == -1 )
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60, uint32ColorOrange(*mainsurface), true, language[2966]);
+						raceSelect = 0;
+						inputs.mouseClearLeft(clientnum);
+						stats[0]->sex = FEMALE;
+						lastSex = FEMALE;
+						if ( stats[0]->playerRace == RACE_INCUBUS )
+						{
+							if ( enabledDLCPack1 )
+							{
+								stats[0]->playerRace = RACE_SUCCUBUS;
+								if ( client_classes[0] == CLASS_PUNISHER && stats[0]->appearance == 0 )
+								{
+									if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+									{
+										client_classes[0] = CLASS_MESMER;
+									}
+									stats[0]->clearStats();
+									initClass(0);
+								}
+							}
+							else
+							{
+								stats[0]->playerRace = RACE_HUMAN;
+							}
+						}
 					}
-					if ( gamemods_numCurrentModsLoaded >= 0 )
+				}
+				else if ( omousey >= pady && omousey < pady + NUMPLAYABLERACES * 17 + (isLocked ? 8 : 0) )
+				{
+					for ( c = 0; c < NUMPLAYABLERACES; ++c )
 					{
-						ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60 - TTF12_HEIGHT * 6, uint32ColorOrange(*mainsurface), true, language[2981]);
+						if ( omousey >= pady && omousey < pady + 17 )
+						{
+							bool disableSelect = false;
+							if ( skipSecondDLC )
+							{
+								if ( c > RACE_GOATMAN )
+								{
+									disableSelect = true;
+								}
+							}
+							else if ( skipFirstDLC )
+							{
+								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID ) // this is weird cause we're reordering the menu above...
+								{
+									disableSelect = true;
+								}
+							}
+							else if ( !enabledDLCPack1 && !enabledDLCPack2 )
+							{
+								if ( c != RACE_HUMAN )
+								{
+									disableSelect = true;
+								}
+							}
+							if ( !disableSelect && inputs.bMouseLeft(clientnum) )
+							{
+								raceSelect = 1;
+								inputs.mouseClearLeft(clientnum);
+								if ( !disableSelect )
+								{
+									PlayerRaces lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
+									if ( skipFirstDLC )
+									{
+										// this is weird cause we're reordering the menu above...
+										if ( c > RACE_GOATMAN )
+										{
+											stats[0]->playerRace = c - 4;
+										}
+										else if ( c > RACE_HUMAN )
+										{
+											stats[0]->playerRace = c + 4;
+										}
+										else
+										{
+											stats[0]->playerRace = c;
+										}
+									}
+									else
+									{
+										stats[0]->playerRace = c;
+									}
+									inputs.mouseClearLeft(clientnum);
+									if ( stats[0]->playerRace == RACE_INCUBUS )
+									{
+										stats[0]->sex = MALE;
+									}
+									else if ( stats[0]->playerRace == RACE_SUCCUBUS )
+									{
+										stats[0]->sex = FEMALE;
+									}
+									else if ( lastRace == RACE_SUCCUBUS || lastRace == RACE_INCUBUS )
+									{
+										stats[0]->sex = lastSex;
+									}
+									// convert human class to monster special classes on reselect.
+									if ( stats[0]->playerRace != RACE_HUMAN && lastRace != RACE_HUMAN && client_classes[0] > CLASS_MONK
+										&& stats[0]->appearance == 0 )
+									{
+										if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+										{
+											client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+										}
+										stats[0]->clearStats();
+										initClass(0);
+									}
+									else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN && client_classes[0] > CLASS_MONK
+										&& lastAppearance == 0 )
+									{
+										if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+										{
+											client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+										}
+										stats[0]->clearStats();
+										initClass(0);
+									}
+									else if ( stats[0]->playerRace != RACE_GOATMAN && lastRace == RACE_GOATMAN )
+									{
+										stats[0]->clearStats();
+										initClass(0);
+									}
+									// appearance reset.
+									if ( stats[0]->playerRace == RACE_HUMAN && lastRace != RACE_HUMAN )
+									{
+										stats[0]->appearance = rand() % NUMAPPEARANCES;
+									}
+									else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN )
+									{
+										stats[0]->appearance = lastAppearance;
+									}
+								}
+								break;
+							}
+							else if ( disableSelect )
+							{
+								SDL_Rect tooltip;
+								tooltip.x = omousex + 16;
+								tooltip.y = omousey + 16;
+								tooltip.h = TTF12_HEIGHT + 8;
+#if (defined STEAMWORKS || defined USE_EOS)
+								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID && !skipFirstDLC )
+								{
+									tooltip.h = TTF12_HEIGHT * 2 + 8;
+									tooltip.w = longestline(language[3917]) * TTF12_WIDTH + 8;
+									drawTooltip(&tooltip);
+									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3917]);
+								}
+								else
+								{
+									tooltip.h = TTF12_HEIGHT * 2 + 8;
+									tooltip.w = longestline(language[3200]) * TTF12_WIDTH + 8;
+									drawTooltip(&tooltip);
+									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3200]);
+								}
+#ifdef STEAMWORKS
+								if ( SteamUser()->BLoggedOn() )
+								{
+									if ( inputs.bMouseLeft(clientnum) )
+									{
+										if ( SteamUtils()->IsOverlayEnabled() )
+										{
+											SteamFriends()->ActivateGameOverlayToStore(STEAM_APPID, k_EOverlayToStoreFlag_None);
+										}
+										else
+										{
+											if ( c > RACE_GOATMAN && c <= RACE_INSECTOID && !skipFirstDLC )
+											{
+												openURLTryWithOverlay(language[3993]);
+											}
+											else
+											{
+												openURLTryWithOverlay(language[3992]);
+											}
+										}
+										inputs.mouseClearLeft(clientnum);
+									}
+								}
+#elif defined USE_EOS
+								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID && !skipFirstDLC )
+								{
+									if ( inputs.bMouseLeft(clientnum) )
+									{
+										openURLTryWithOverlay(language[3985]);
+										inputs.mouseClearLeft(clientnum);
+									}
+								}
+								else
+								{
+									if ( inputs.bMouseLeft(clientnum) )
+									{
+										openURLTryWithOverlay(language[3984]);
+										inputs.mouseClearLeft(clientnum);
+									}
+								}
+#endif
+#else
+								if ( c > RACE_GOATMAN && c <= RACE_INSECTOID )
+								{
+									tooltip.w = longestline(language[3372]) * TTF12_WIDTH + 8;
+									drawTooltip(&tooltip);
+									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3372]);
+								}
+								else
+								{
+									tooltip.w = longestline(language[3199]) * TTF12_WIDTH + 8;
+									drawTooltip(&tooltip);
+									ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6, uint32ColorOrange(*mainsurface), language[3199]);
+								}
+#endif // STEAMWORKS
+							}
+						}
+						pady += 17;
+						if ( isLocked )
+						{
+							if ( skipFirstDLC && c == RACE_INSECTOID )
+							{
+								pady += 8;
+							}
+							else
+							{
+								if ( skipSecondDLC && c == RACE_GOATMAN )
+								{
+									pady += 8;
+								}
+								else if ( !enabledDLCPack1 && !enabledDLCPack2 && c == RACE_HUMAN )
+								{
+									pady += 8;
+								}
+							}
+						}
 					}
 				}
-				if ( gamemods_numCurrentModsLoaded >= 0 )
-				{
-					ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60 + TTF12_HEIGHT, uint32ColorBaronyBlue(*mainsurface), true, language[2982]);
-				}
-				if ( inputs.bMouseLeft(clientnum) )
+				else if ( omousey >= pady + (NUMPLAYABLERACES * 17) + 48 && omousey < pady + (NUMPLAYABLERACES * 17) + 82 )
 				{
-					if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						if ( omousey >= optionY.at(mode) && omousey < (optionY.at(mode) + optionHeight) )
+						inputs.mouseClearLeft(clientnum);
+						if ( stats[0]->playerRace > 0 )
 						{
+							if ( omousey < pady + (NUMPLAYABLERACES * 17) + 64 ) // first option
+							{
+								if ( stats[0]->appearance != 0 )
+								{
+									stats[0]->appearance = 0; // use racial passives
+									// convert human class to monster special classes on reselect.
+									if ( client_classes[0] > CLASS_MONK )
+									{
+										if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+										{
+											client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+										}
+									}
+								}
+							}
+							else
+							{
+								stats[0]->appearance = 1; // act as human
+							}
+							lastAppearance = stats[0]->appearance;
+							stats[0]->clearStats();
+							initClass(0);
+							raceSelect = 2;
 							inputs.mouseClearLeft(clientnum);
-							multiplayerselect = displayedOptionToGamemode.at(mode);
 						}
 					}
 				}
 			}
-			if (keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
+			if ( keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
 			{
 				keystatus[SDL_SCANCODE_UP] = 0;
 				if ( rebindaction == -1 )
@@ -3816,6191 +3755,6271 @@ void handleMainMenu(bool mode)
 					inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
 				}
 				inputs.hideMouseCursors();
-
-				Uint32 vIndex = 0;
-				for ( auto& option : displayedOptionToGamemode )
+				if ( raceSelect == 1 )
 				{
-					if ( option == multiplayerselect )
+					PlayerRaces lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
+					if ( !enabledDLCPack1 && !enabledDLCPack2 )
 					{
-						break;
+						// do nothing.
+						stats[0]->playerRace = RACE_HUMAN;
 					}
-					++vIndex;
-				}
-				if ( vIndex > 0 )
-				{
-					multiplayerselect = displayedOptionToGamemode.at(vIndex - 1);
-				}
-				else
-				{
-					multiplayerselect = displayedOptionToGamemode.at(nummodes - 1);
-				}
-			}
-			if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
-			{
-				keystatus[SDL_SCANCODE_DOWN] = 0;
-				if ( rebindaction == -1 )
-				{
-					inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
-				}
-				inputs.hideMouseCursors();
-
-				Uint32 vIndex = 0;
-				for ( auto& option : displayedOptionToGamemode )
-				{
-					if ( option == multiplayerselect )
+					else if ( stats[0]->playerRace <= 0 )
 					{
-						break;
+						if ( skipSecondDLC )
+						{
+							stats[0]->playerRace = NUMPLAYABLERACES - 5;
+						}
+						else if ( enabledDLCPack2 )
+						{
+							stats[0]->playerRace = NUMPLAYABLERACES - 1;
+						}
 					}
-					++vIndex;
-				}
-				if ( vIndex >= nummodes - 1 )
-				{
-					multiplayerselect = displayedOptionToGamemode.at(0);
-				}
-				else
-				{
-					multiplayerselect = displayedOptionToGamemode.at(vIndex + 1);
-				}
-			}
-		}
-	}
-
-	// serial window.
-#if (!defined STEAMWORKS && !defined USE_EOS)
-	if ( intro && introstage == 1 && subwindow && !strcmp(subtext, language[3403]) && serialEnterWindow )
-	{
-		drawDepressed(subx1 + 8, suby1 + 32, subx2 - 8, suby1 + 56);
-		ttfPrintText(ttf12, subx1 + 16, suby1 + 40, serialInputText);
-
-		// enter character name
-		if ( serialVerifyWindow == 0 && !SDL_IsTextInputActive() )
-		{
-			if (inputstr != serialInputText)
-			{
-				inputstr = serialInputText;
-#ifdef NINTENDO
-				auto result = nxKeyboard("Enter your character's name");
-				if (result.success)
-				{
-					strncpy(inputstr, result.str.c_str(), 21);
-					inputstr[21] = '\0'; //TODO: NX Port: The inputlen below names 63...? Should this be modified to match? Everywhere else, we operate on inputstr[21] when inputlen = 22.
-				}
-#endif
-			}
-			SDL_StartTextInput();
-		}
-		//strncpy(stats[0]->name,inputstr,16);
-		inputlen = 63;
-
-		if ( serialVerifyWindow > 0 )
-		{
-			if ( serialVerifyWindow % 10 < 3 )
-			{
-				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying");
-			}
-			else if ( serialVerifyWindow % 10 < 5 )
-			{
-				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying.");
-			}
-			else if ( serialVerifyWindow % 10 < 7 )
-			{
-				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying..");
-			}
-			else if ( serialVerifyWindow % 10 < 10 )
-			{
-				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying...");
-			}
-			if ( ticks % (TICKS_PER_SECOND / 2) == 0 )
-			{
-				++serialVerifyWindow;
-				if ( serialVerifyWindow >= 25 )
-				{
-					std::string serial = serialInputText;
-
-					// compute hash
-					if ( !serial.empty() )
+					else
 					{
-						std::size_t DLCHash = serialHash(serial);
-						if ( DLCHash == 144425 )
+						if ( skipFirstDLC && stats[0]->playerRace == RACE_AUTOMATON )
 						{
-							printlog("[LICENSE]: Myths and Outcasts DLC license key found.");
-							enabledDLCPack1 = true;
-							windowSerialResult(1);
+							stats[0]->playerRace = RACE_HUMAN;
 						}
-						else if ( DLCHash == 135398 )
+						else
 						{
-							printlog("[LICENSE]: Legends and Pariahs DLC license key found.");
-							enabledDLCPack2 = true;
-							windowSerialResult(2);
+							--stats[0]->playerRace;
 						}
-						else
+					}
+					if ( stats[0]->playerRace == RACE_INCUBUS )
+					{
+						stats[0]->sex = MALE;
+					}
+					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
+					{
+						stats[0]->sex = FEMALE;
+					}
+					else if ( lastRace == RACE_SUCCUBUS || lastRace == RACE_INCUBUS )
+					{
+						stats[0]->sex = lastSex;
+					}
+					// convert human class to monster special classes on reselect.
+					if ( stats[0]->playerRace != RACE_HUMAN && lastRace != RACE_HUMAN && client_classes[0] > CLASS_MONK
+						&& stats[0]->appearance == 0 )
+					{
+						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+						{
+							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+						}
+						stats[0]->clearStats();
+						initClass(0);
+					}
+					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN && client_classes[0] > CLASS_MONK
+						&& lastAppearance == 0 )
+					{
+						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+						{
+							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+						}
+						stats[0]->clearStats();
+						initClass(0);
+					}
+					else if ( stats[0]->playerRace != RACE_GOATMAN && lastRace == RACE_GOATMAN )
+					{
+						stats[0]->clearStats();
+						initClass(0);
+					}
+					// appearance reset.
+					if ( stats[0]->playerRace == RACE_HUMAN && lastRace != RACE_HUMAN )
+					{
+						stats[0]->appearance = rand() % NUMAPPEARANCES;
+					}
+					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN )
+					{
+						stats[0]->appearance = lastAppearance;
+					}
+				}
+				else if ( raceSelect == 0 )
+				{
+					stats[0]->sex = static_cast<sex_t>((stats[0]->sex == MALE));
+					lastSex = stats[0]->sex;
+					if ( stats[0]->playerRace == RACE_INCUBUS )
+					{
+						stats[0]->sex = MALE;
+					}
+					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
+					{
+						stats[0]->sex = FEMALE;
+					}
+				}
+				else if ( raceSelect == 2 )
+				{
+					if ( stats[0]->appearance != 0 )
+					{
+						stats[0]->appearance = 0;
+						// convert human class to monster special classes on reselect.
+						if ( stats[0]->playerRace != RACE_HUMAN && client_classes[0] > CLASS_MONK )
 						{
-							printlog("[LICENSE]: DLC license key invalid.");
-							windowSerialResult(0);
+							if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+							{
+								client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+							}
+							stats[0]->clearStats();
+							initClass(0);
 						}
 					}
 					else
 					{
-						windowSerialResult(0);
+						stats[0]->appearance = 1;
 					}
+					lastAppearance = stats[0]->appearance;
+					stats[0]->clearStats();
+					initClass(0);
 				}
 			}
-		}
-		else if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
-		{
-			int x;
-			getSizeOfText(ttf12, serialInputText, &x, NULL);
-			ttfPrintText(ttf12, subx1 + 16 + x, suby1 + 40, "_");
-		}
-	}
-#endif
-
-	// settings window
-	if ( settings_window == true )
-	{
-		drawWindowFancy(subx1 + 16, suby1 + 44, subx2 - 16, suby2 - 32);
-
-		int hovering_selection = -1; //0 to NUM_SERVER_FLAGS used for the game flags settings, e.g. are traps enabled, are cheats enabled, is minotaur enabled, etc.
-		SDL_Rect tooltip_box;
-
-		if ( inputs.bControllerInputPressed(clientnum, INJOY_MENU_SETTINGS_NEXT) && rebindaction == -1 )
-		{
-			inputs.controllerClearInput(clientnum, INJOY_MENU_SETTINGS_NEXT);
-			changeSettingsTab(settings_tab + 1);
-		}
-		if ( inputs.bControllerInputPressed(clientnum, INJOY_MENU_SETTINGS_PREV) && rebindaction == -1 )
-		{
-			inputs.controllerClearInput(clientnum, INJOY_MENU_SETTINGS_PREV);
-			changeSettingsTab(settings_tab - 1);
-		}
-
-		// video tab
-		if ( settings_tab == SETTINGS_VIDEO_TAB )
-		{
-			// resolution
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1338]);
-			c=0;
-			for ( auto cur : resolutions )
+			if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
 			{
-				int width, height;
-				std::tie (width, height) = cur;
-				if ( settings_xres == width && settings_yres == height )
-				{
-					ttfPrintTextFormatted(ttf12, subx1 + 32, suby1 + 84 + c * 16, "[o] %dx%d", width, height);
-				}
-				else
+				keystatus[SDL_SCANCODE_DOWN] = 0;
+				if ( rebindaction == -1 )
 				{
-					ttfPrintTextFormatted(ttf12, subx1 + 32, suby1 + 84 + c * 16, "[ ] %dx%d", width, height);
+					inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
 				}
-				if ( inputs.bMouseLeft(clientnum) )
+				inputs.hideMouseCursors();
+				if ( raceSelect == 1 )
 				{
-					if ( omousex >= subx1 + 38 && omousex < subx1 + 62 )
+					PlayerRaces lastRace = static_cast<PlayerRaces>(stats[0]->playerRace);
+					if ( !enabledDLCPack1 && !enabledDLCPack2 )
 					{
-						if ( omousey >= suby1 + 84 + c * 16 && omousey < suby1 + 96 + c * 16 )
+						// do nothing.
+						stats[0]->playerRace = RACE_HUMAN;
+					}
+					else if ( skipSecondDLC )
+					{
+						if ( stats[0]->playerRace >= NUMPLAYABLERACES - 5 )
 						{
-							inputs.mouseClearLeft(clientnum);
-							settings_xres = width;
-							settings_yres = height;
-							resolutionChanged = true;
+							stats[0]->playerRace = RACE_HUMAN;
+						}
+						else
+						{
+							++stats[0]->playerRace;
 						}
 					}
-				}
-				c++;
-			}
-
-			// extra options
-			ttfPrintText(ttf12, subx1 + 224, suby1 + 60, language[1339]);
-			if ( settings_smoothlighting )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 84, "[x] %s", language[1340]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 84, "[ ] %s", language[1340]);
-			}
-			if ( settings_fullscreen )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 108, "[x] %s", language[1341]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 108, "[ ] %s", language[1341]);
-			}
-			if ( settings_shaking )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 132, "[x] %s", language[1342]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 132, "[ ] %s", language[1342]);
-			}
-			if ( settings_bobbing )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 156, "[x] %s", language[1343]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 156, "[ ] %s", language[1343]);
-			}
-			if ( settings_spawn_blood )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 180, "[x] %s", language[1344]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 180, "[ ] %s", language[1344]);
-			}
-			if ( settings_colorblind )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 204, "[x] %s", language[1345]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 204, "[ ] %s", language[1345]);
-			}
-			if ( settings_light_flicker )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 228, "[x] %s", language[2967]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 228, "[ ] %s", language[2967]);
-			}
-			if ( settings_vsync )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 252, "[x] %s", language[3011]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 252, "[ ] %s", language[3011]);
-			}
-			if ( settings_status_effect_icons )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 276, "[x] %s", language[3357]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 276, "[ ] %s", language[3357]);
-			}
-			if ( settings_borderless )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 300, "[x] %s", language[3935]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 300, "[ ] %s", language[3935]);
-			}
-
-			if ( inputs.bMouseLeft(clientnum) )
-			{
-				if ( omousex >= subx1 + 242 && omousex < subx1 + 266 )
-				{
-					if ( omousey >= suby1 + 84 && omousey < suby1 + 84 + 12 )
+					else if ( skipFirstDLC )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_smoothlighting = (settings_smoothlighting == 0);
+						if ( stats[0]->playerRace >= RACE_GOATMAN && stats[0]->playerRace < NUMPLAYABLERACES - 1 )
+						{
+							++stats[0]->playerRace;
+						}
+						else if ( stats[0]->playerRace == RACE_HUMAN )
+						{
+							stats[0]->playerRace = RACE_AUTOMATON;
+						}
+						else if ( stats[0]->playerRace == NUMPLAYABLERACES - 1 )
+						{
+							stats[0]->playerRace = RACE_HUMAN;
+						}
 					}
-					else if ( omousey >= suby1 + 108 && omousey < suby1 + 108 + 12 )
+					else
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_fullscreen = (settings_fullscreen == 0);
+						if ( stats[0]->playerRace >= NUMPLAYABLERACES - 1 )
+						{
+							stats[0]->playerRace = RACE_HUMAN;
+						}
+						else
+						{
+							++stats[0]->playerRace;
+						}
 					}
-					else if ( omousey >= suby1 + 132 && omousey < suby1 + 132 + 12 )
+					if ( stats[0]->playerRace == RACE_INCUBUS )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_shaking = (settings_shaking == 0);
+						stats[0]->sex = MALE;
 					}
-					else if ( omousey >= suby1 + 156 && omousey < suby1 + 156 + 12 )
+					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_bobbing = (settings_bobbing == 0);
+						stats[0]->sex = FEMALE;
 					}
-					else if ( omousey >= suby1 + 180 && omousey < suby1 + 180 + 12 )
+					else if ( lastRace == RACE_SUCCUBUS || lastRace == RACE_INCUBUS )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_spawn_blood = (settings_spawn_blood == 0);
+						stats[0]->sex = lastSex;
+					}
+					// convert human class to monster special classes on reselect.
+					if ( stats[0]->playerRace != RACE_HUMAN && lastRace != RACE_HUMAN && client_classes[0] > CLASS_MONK
+						&& stats[0]->appearance == 0 )
+					{
+						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+						{
+							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+						}
+						stats[0]->clearStats();
+						initClass(0);
+					}
+					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN && client_classes[0] > CLASS_MONK 
+						&& lastAppearance == 0 )
+					{
+						if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+						{
+							client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+						}
+						stats[0]->clearStats();
+						initClass(0);
+					}
+					else if ( stats[0]->playerRace != RACE_GOATMAN && lastRace == RACE_GOATMAN )
+					{
+						stats[0]->clearStats();
+						initClass(0);
+					}
+					// appearance reset.
+					if ( stats[0]->playerRace == RACE_HUMAN && lastRace != RACE_HUMAN )
+					{
+						stats[0]->appearance = rand() % NUMAPPEARANCES;
 					}
-					else if ( omousey >= suby1 + 204 && omousey < suby1 + 204 + 12 )
+					else if ( stats[0]->playerRace != RACE_HUMAN && lastRace == RACE_HUMAN )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_colorblind = (settings_colorblind == false);
+						stats[0]->appearance = lastAppearance;
 					}
-					else if ( omousey >= suby1 + 228 && omousey < suby1 + 228 + 12 )
+				}
+				else if ( raceSelect == 0 )
+				{
+					stats[0]->sex = static_cast<sex_t>((stats[0]->sex == MALE));
+					lastSex = stats[0]->sex;
+					if ( stats[0]->playerRace == RACE_INCUBUS )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_light_flicker = (settings_light_flicker == false);
+						stats[0]->sex = MALE;
 					}
-					else if ( omousey >= suby1 + 252 && omousey < suby1 + 252 + 12 )
+					else if ( stats[0]->playerRace == RACE_SUCCUBUS )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_vsync = (settings_vsync == false);
+						stats[0]->sex = FEMALE;
 					}
-					else if ( omousey >= suby1 + 276 && omousey < suby1 + 276 + 12 )
+				}
+				else if ( raceSelect == 2 )
+				{
+					if ( stats[0]->appearance != 0 )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_status_effect_icons = (settings_status_effect_icons == false);
+						stats[0]->appearance = 0;
+						// convert human class to monster special classes on reselect.
+						if ( stats[0]->playerRace != RACE_HUMAN && client_classes[0] > CLASS_MONK )
+						{
+							if ( isCharacterValidFromDLC(*stats[0], client_classes[0]) != VALID_OK_CHARACTER )
+							{
+								client_classes[0] = CLASS_MONK + stats[0]->playerRace;
+							}
+							stats[0]->clearStats();
+							initClass(0);
+						}
 					}
-					else if ( omousey >= suby1 + 300 && omousey < suby1 + 300 + 12 )
+					else
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_borderless = (settings_borderless == false);
+						stats[0]->appearance = 1;
 					}
+					lastAppearance = stats[0]->appearance;
+					stats[0]->clearStats();
+					initClass(0);
 				}
 			}
-
-			// minimap options
-			ttfPrintText(ttf12, subx1 + 498, suby1 + 60, language[3022]);
-
-			// total scale
-			ttfPrintText(ttf12, subx1 + 498, suby1 + 84, language[3025]);
-			doSlider(subx1 + 498, suby1 + 84 + 24, 10, 2, 16, 1, (int*)(&settings_minimap_scale));
-
-			// objects (players/allies/minotaur) scale
-			ttfPrintText(ttf12, subx1 + 498, suby1 + 130, language[3026]);
-			doSlider(subx1 + 498, suby1 + 130 + 24, 10, 0, 4, 1, (int*)(&settings_minimap_object_zoom));
-
-			// foreground transparency
-			ttfPrintText(ttf12, subx1 + 498, suby1 + 176, language[3023]);
-			doSlider(subx1 + 498, suby1 + 176 + 24, 10, 0, 100, 1, (int*)(&settings_minimap_transparency_foreground));
-
-			// background transparency
-			ttfPrintText(ttf12, subx1 + 498, suby1 + 222, language[3024]);
-			doSlider(subx1 + 498, suby1 + 222 + 24, 10, 0, 100, 1, (int*)(&settings_minimap_transparency_background));
-
-			// UI options
-			ttfPrintText(ttf12, subx1 + 498, suby1 + 276, language[3034]);
-
-			if ( settings_uiscale_charactersheet )
+			if ( keystatus[SDL_SCANCODE_RIGHT] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_RIGHT) && rebindaction == -1) )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 300, "[x] %s", language[3027]);
+				keystatus[SDL_SCANCODE_RIGHT] = 0;
+				if ( rebindaction == -1 )
+				{
+					inputs.controllerClearInput(clientnum, INJOY_DPAD_RIGHT);
+				}
+				inputs.hideMouseCursors();
+				++raceSelect;
+				if ( stats[0]->playerRace == RACE_HUMAN )
+				{
+					if ( raceSelect > 1 )
+					{
+						raceSelect = 0;
+					}
+				}
+				else if ( raceSelect > 2 )
+				{
+					raceSelect = 0;
+				}
 			}
-			else
+			if ( keystatus[SDL_SCANCODE_LEFT] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_LEFT) && rebindaction == -1) )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 300, "[ ] %s", language[3027]);
+				keystatus[SDL_SCANCODE_LEFT] = 0;
+				if ( rebindaction == -1 )
+				{
+					inputs.controllerClearInput(clientnum, INJOY_DPAD_LEFT);
+				}
+				inputs.hideMouseCursors();
+				--raceSelect;
+				if ( stats[0]->playerRace == RACE_HUMAN )
+				{
+					if ( raceSelect < 0 )
+					{
+						raceSelect = 1;
+					}
+				}
+				else if ( raceSelect < 0 )
+				{
+					raceSelect = 2;
+				}
 			}
-			if ( settings_uiscale_skillspage )
+			if ( lastRace != RACE_GOATMAN && stats[0]->playerRace == RACE_GOATMAN && stats[0]->appearance == 0 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 324, "[x] %s", language[3028]);
+				stats[0]->clearStats();
+				initClass(0);
 			}
-			else
+		}
+
+		// classes
+		else if ( charcreation_step == 2 )
+		{
+			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1323]);
+			int entriesToDisplay = NUMCLASSES;
+			if ( enabledDLCPack1 && enabledDLCPack2 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 324, "[ ] %s", language[3028]);
+				entriesToDisplay = NUMCLASSES;
 			}
-			if ( settings_hide_statusbar )
+			else if ( enabledDLCPack1 || enabledDLCPack2 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 348, "[x] %s", language[3033]);
+				entriesToDisplay = NUMCLASSES - 4;
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 348, "[ ] %s", language[3033]);
-			}
-			if ( settings_hide_playertags )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 372, "[x] %s", language[3136]);
+				entriesToDisplay = CLASS_MONK + 1;
 			}
-			else
+
+			std::set<int> availableClasses;
+			std::set<int> lockedClasses;
+			std::vector<int> displayedClasses;
+			for ( c = 0; c < NUMCLASSES; ++c )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 372, "[ ] %s", language[3136]);
+				int result = isCharacterValidFromDLC(*stats[0], c);
+				if ( result == VALID_OK_CHARACTER )
+				{
+					availableClasses.insert(c);
+					displayedClasses.push_back(c);
+				}
+				else if ( result == INVALID_REQUIRE_ACHIEVEMENT )
+				{
+					lockedClasses.insert(c);
+				}
 			}
-			if ( settings_show_skill_values )
+
+			for ( auto it = lockedClasses.begin(); it != lockedClasses.end(); ++it )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 396, "[x] %s", language[3159]);
+				displayedClasses.push_back(*it);
 			}
-			else
+
+			int drawLockedTooltip = 0;
+			SDL_Rect tooltip;
+			for ( c = 0; c < entriesToDisplay; c++ )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 396, "[ ] %s", language[3159]);
-			}
+				int classToPick = displayedClasses.at(c);
+				int pady = suby1 + 56 + 16 * c;
+				if ( lockedClasses.find(classToPick) != lockedClasses.end() )
+				{
+					pady += 8;
+				}
+
+				if ( inputs.bMouseLeft(clientnum) )
+				{
+					if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
+					{
+						if ( omousey >= pady && omousey < pady + 16 )
+						{
+							inputs.mouseClearLeft(clientnum);
+							if ( isCharacterValidFromDLC(*stats[0], classToPick) == VALID_OK_CHARACTER )
+							{
+								int previousClassPicked = client_classes[0];
+								client_classes[0] = classToPick;
+								if ( previousClassPicked != client_classes[0] )
+								{
+									// reset class loadout
+									stats[0]->clearStats();
+									initClass(0);
+								}
+							}
+						}
+					}
+				}
+
+				bool classLocked = false;
+
+				if ( classToPick == client_classes[0] )
+				{
+					ttfPrintTextFormatted(ttf16, subx1 + 32, pady, "[o] %s", playerClassLangEntry(classToPick, 0));
+				}
+				else
+				{
+					if ( lockedClasses.find(classToPick) != lockedClasses.end() )
+					{
+						classLocked = true;
+						SDL_Rect img;
+						img.x = subx1 + 32 + 10;
+						img.y = pady - 2;
+						img.w = 22;
+						img.h = 20;
+						drawImageScaled(sidebar_unlock_bmp, nullptr, &img);
+						ttfPrintTextFormattedColor(ttf16, subx1 + 32, pady, uint32ColorGray(*mainsurface), "[ ] %s", playerClassLangEntry(classToPick, 0));
+
+						if ( mouseInBounds(clientnum, subx1 + 40, subx1 + 72, pady, pady + 16) )
+						{
+#if (defined STEAMWORKS || defined USE_EOS)
+							tooltip.x = omousex + 16;
+							tooltip.y = omousey + 16;
+							tooltip.h = TTF12_HEIGHT + 8;
+							if ( classToPick > CLASS_MONK )
+							{
+								int langline = 3927 + classToPick - CLASS_CONJURER;
+								tooltip.w = longestline(language[langline]) * TTF12_WIDTH + 8;
+								drawLockedTooltip = langline;
+							}
+#endif
+						}
+					}
+					else
+					{
+						ttfPrintTextFormatted(ttf16, subx1 + 32, pady, "[ ] %s", playerClassLangEntry(classToPick, 0));
+					}
+				}
+
+				if ( keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
+				{
+					keystatus[SDL_SCANCODE_UP] = 0;
+					if ( rebindaction == -1 )
+					{
+						inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
+					}
+					inputs.hideMouseCursors();
+
+					int previousClassPicked = client_classes[0];
+					if ( client_classes[0] == 0 )
+					{
+						client_classes[0] = *(availableClasses.rbegin());;
+					}
+					else
+					{
+						auto it = availableClasses.find(client_classes[0]);
+						if ( it != availableClasses.end() )
+						{
+							client_classes[0] = *(--it); // get previous element
+						}
+						else
+						{
+							client_classes[0] = 0;
+						}
+					}
 
-			if ( inputs.bMouseLeft(clientnum) )
-			{
-				if ( omousex >= subx1 + 498 && omousex < subx1 + 522 )
-				{
-					if ( omousey >= suby1 + 300 && omousey < suby1 + 300 + 12 )
+					if ( previousClassPicked != client_classes[0] )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_uiscale_charactersheet = (settings_uiscale_charactersheet == 0);
+						// reset class loadout
+						stats[0]->clearStats();
+						initClass(0);
 					}
-					else if ( omousey >= suby1 + 324 && omousey < suby1 + 324 + 12 )
+				}
+				if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
+				{
+					keystatus[SDL_SCANCODE_DOWN] = 0;
+					if ( rebindaction == -1 )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_uiscale_skillspage = (settings_uiscale_skillspage == 0);
+						inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
 					}
-					else if ( omousey >= suby1 + 348 && omousey < suby1 + 348 + 12 )
+					inputs.hideMouseCursors();
+
+					auto it = availableClasses.find(client_classes[0]);
+					int previousClassPicked = client_classes[0];
+					if ( it != availableClasses.end() )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_hide_statusbar = (settings_hide_statusbar == 0);
+						auto nextIt = std::next(it, 1);
+						if ( nextIt == availableClasses.end() )
+						{
+							client_classes[0] = 0;
+						}
+						else
+						{
+							client_classes[0] = *(++it); // get next element
+						}
 					}
-					else if ( omousey >= suby1 + 372 && omousey < suby1 + 372 + 12 )
+					else
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_hide_playertags = (settings_hide_playertags == 0);
+						client_classes[0] = 0;
 					}
-					else if ( omousey >= suby1 + 396 && omousey < suby1 + 396 + 12 )
+
+					if ( previousClassPicked != client_classes[0] )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_show_skill_values = (settings_show_skill_values == 0);
+						// reset class loadout
+						stats[0]->clearStats();
+						initClass(0);
 					}
 				}
 			}
-			// UI scale sliders
-			ttfPrintText(ttf12, subx1 + 498, suby2 - 220, language[3029]);
-			doSliderF(subx1 + 498, suby2 - 220 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_hotbar);
-			ttfPrintText(ttf12, subx1 + 498, suby2 - 174, language[3030]);
-			doSliderF(subx1 + 498, suby2 - 174 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_chatlog);
-			ttfPrintText(ttf12, subx1 + 498, suby2 - 128, language[3031]);
-			doSliderF(subx1 + 498, suby2 - 128 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_playerbars);
-			ttfPrintText(ttf12, subx1 + 498, suby2 - 80, language[3032]);
-			doSliderF(subx1 + 498, suby2 - 80 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_inventory);
-
-			// fov slider
-			ttfPrintText(ttf12, subx1 + 24, suby2 - 174, language[1346]);
-			doSlider(subx1 + 24, suby2 - 148, 14, 40, 100, 1, (int*)(&settings_fov));
 
-			// gamma slider
-			ttfPrintText(ttf12, subx1 + 24, suby2 - 128, language[1347]);
-			doSliderF(subx1 + 24, suby2 - 104, 14, 0.25, 2.f, 0.25, &settings_gamma);
+			// class description
+			ttfPrintText(ttf12, subx1 + 8, suby2 - 80, playerClassDescription(client_classes[0], 0));
 
-			// fps slider
-			ttfPrintText(ttf12, subx1 + 24, suby2 - 80, language[2411]);
-			doSlider(subx1 + 24, suby2 - 56, 14, 60, 144, 1, (int*)(&settings_fps));
+			if ( drawLockedTooltip > 0 )
+			{
+				drawTooltip(&tooltip);
+				ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 6,
+					uint32ColorOrange(*mainsurface), language[drawLockedTooltip]);
+			}
 		}
 
-		// audio tab
-		if ( settings_tab == SETTINGS_AUDIO_TAB )
+		// faces
+		else if ( charcreation_step == 3 )
 		{
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1348]);
-			doSlider(subx1 + 24, suby1 + 84, 15, 0, 128, 0, &settings_sfxvolume);
-
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 108, language[3972]);
-			doSlider(subx1 + 24, suby1 + 132, 15, 0, 128, 0, &settings_sfxAmbientVolume);
-
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 156, language[3973]);
-			doSlider(subx1 + 24, suby1 + 180, 15, 0, 128, 0, &settings_sfxEnvironmentVolume);
-
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 204, language[1349]);
-			doSlider(subx1 + 24, suby1 + 228, 15, 0, 128, 0, &settings_musvolume);
-
-			if ( settings_minimap_ping_mute )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 264, "[x] %s", language[3012]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 264, "[ ] %s", language[3012]);
-			}
-			if ( settings_mute_audio_on_focus_lost )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 288, "[x] %s", language[3158]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 288, "[ ] %s", language[3158]);
-			}
-			if ( settings_mute_player_monster_sounds )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 312, "[x] %s", language[3371]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 312, "[ ] %s", language[3371]);
-			}
-			if ( inputs.bMouseLeft(clientnum) )
+			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1324]);
+			for ( c = 0; c < NUMAPPEARANCES; c++ )
 			{
-				if ( omousex >= subx1 + 30 && omousex < subx1 + 54 )
+				if ( stats[0]->appearance == c )
 				{
-					if ( omousey >= suby1 + 168 && omousey < suby1 + 264 + 12 )
+					ttfPrintTextFormatted(ttf16, subx1 + 32, suby1 + 56 + c * 16, "[o] %s", language[20 + c]);
+					ttfPrintText(ttf12, subx1 + 8, suby2 - 80, language[38 + c]);
+				}
+				else
+				{
+					ttfPrintTextFormatted(ttf16, subx1 + 32, suby1 + 56 + c * 16, "[ ] %s", language[20 + c]);
+				}
+				if ( inputs.bMouseLeft(clientnum) )
+				{
+					if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_minimap_ping_mute = (settings_minimap_ping_mute == false);
+						if ( omousey >= suby1 + 56 + 16 * c && omousey < suby1 + 72 + 16 * c )
+						{
+							inputs.mouseClearLeft(clientnum);
+							stats[0]->appearance = c;
+						}
 					}
-					else if ( omousey >= suby1 + 192 && omousey < suby1 + 288 + 12 )
+				}
+				if ( keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
+				{
+					keystatus[SDL_SCANCODE_UP] = 0;
+					if ( rebindaction == -1 )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_mute_audio_on_focus_lost = (settings_mute_audio_on_focus_lost == false);
+						inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
 					}
-					else if ( omousey >= suby1 + 216 && omousey < suby1 + 312 + 12 )
+					inputs.hideMouseCursors();
+					stats[0]->appearance--;
+					if (stats[0]->appearance >= NUMAPPEARANCES)
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_mute_player_monster_sounds = (settings_mute_player_monster_sounds == false);
+						stats[0]->appearance = NUMAPPEARANCES - 1;
+					}
+				}
+				if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
+				{
+					keystatus[SDL_SCANCODE_DOWN] = 0;
+					if ( rebindaction == -1 )
+					{
+						inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
+					}
+					inputs.hideMouseCursors();
+					stats[0]->appearance++;
+					if (stats[0]->appearance >= NUMAPPEARANCES)
+					{
+						stats[0]->appearance = 0;
 					}
 				}
 			}
 		}
 
-		// keyboard tab
-		if ( settings_tab == SETTINGS_KEYBOARD_TAB )
+		// name
+		else if ( charcreation_step == 4 )
 		{
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1350]);
+			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1325]);
+			drawDepressed(subx1 + 40, suby1 + 56, subx1 + 364, suby1 + 88);
+			ttfPrintText(ttf16, subx1 + 48, suby1 + 64, stats[0]->name);
+			ttfPrintText(ttf12, subx1 + 8, suby2 - 80, language[1326]);
 
-			bool rebindingkey = false;
-			if ( rebindkey != -1 )
+			// enter character name
+			if ( !SDL_IsTextInputActive() )
 			{
-				rebindingkey = true;
+				if (inputstr != stats[0]->name) //TODO: NX PORT: Not sure if this portion is correct...the PC version of this chunk has changed significantly in the interleaving time.
+				{
+					inputstr = stats[0]->name;
+#ifdef NINTENDO
+					auto result = nxKeyboard("Enter your character's name");
+					if (result.success)
+					{
+						strncpy(inputstr, result.str.c_str(), 21);
+						inputstr[21] = '\0';
+					}
+#endif
+				}
+				SDL_StartTextInput();
+			}
+			//strncpy(stats[0]->name,inputstr,16);
+			inputlen = 22;
+			if (lastname != "" && strlen(inputstr) == 0)
+			{
+				strncat(inputstr, lastname.c_str(), std::max<size_t>(0, inputlen - strlen(inputstr)));
+				lastname = ""; // Set this to nothing while we're currently editing so it doesn't keep filling it.  We'll save it again if we leave this tab.
 			}
 
-			for ( int c = 0; c < NUMIMPULSES; c++ )
+			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+			{
+				int x;
+				getSizeOfText(ttf16, stats[0]->name, &x, NULL);
+				ttfPrintText(ttf16, subx1 + 48 + x, suby1 + 64, "_");
+			}
+		}
+
+		// gamemode
+		else if ( charcreation_step == 5 )
+		{
+			ttfPrintText(ttf16, subx1 + 24, suby1 + 32, language[1327]);
+
+			std::vector<Sint32> optionY;
+			std::vector<char*> optionTexts;
+			std::vector<char*> optionSubtexts;
+			std::vector<char*> optionDescriptions;
+			std::vector<Uint32> displayedOptionToGamemode;
+			Uint32 optionHeight = TTF12_HEIGHT + 2;
+			int nummodes = 3;
+#if (defined USE_EOS && defined STEAMWORKS)
+			nummodes += 2;
+			if ( LobbyHandler.crossplayEnabled )
+			{
+				nummodes += 1;
+				optionY.insert(optionY.end(), { suby1 + 56, suby1 + 86, suby1 + 128, suby1 + 178, suby1 + 216, suby1 + 256 });
+				optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1330], language[1332], language[1330], language[1332] });
+				optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[3946], language[3947], language[3945], language[1538], language[1539] });
+				optionSubtexts.insert(optionSubtexts.end(), { nullptr, language[3943], language[3944], nullptr, language[1537], language[1537] });
+				displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, SERVERCROSSPLAY, CLIENT, DIRECTSERVER, DIRECTCLIENT});
+			}
+			else
+			{
+				optionY.insert(optionY.end(), { suby1 + 56, suby1 + 76, suby1 + 96, suby1 + 136, suby1 + 176, 0 });
+				optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1332], language[1330], language[1332], nullptr });
+				optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[1331], language[1333], language[1538], language[1539], nullptr });
+				optionSubtexts.insert(optionSubtexts.end(), { nullptr, nullptr, nullptr, language[1537], language[1537], nullptr });
+				displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, CLIENT, DIRECTSERVER, DIRECTCLIENT, 0 });
+			}
+#elif (defined(USE_EOS) || defined(STEAMWORKS))
+			nummodes += 2;
+			optionY.insert(optionY.end(), { suby1 + 56, suby1 + 76, suby1 + 96, suby1 + 136, suby1 + 176, 0 });
+			optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1332], language[1330], language[1332], nullptr });
+			optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[1331], language[1333], language[1538], language[1539], nullptr });
+			optionSubtexts.insert(optionSubtexts.end(), { nullptr, nullptr, nullptr, language[1537], language[1537] });
+			displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, CLIENT, DIRECTSERVER, DIRECTCLIENT, 0 });
+#else
+			optionY.insert(optionY.end(), { suby1 + 56, suby1 + 76, suby1 + 96, suby1 + 136, suby1 + 176, 0 });
+			optionTexts.insert(optionTexts.end(), { language[1328], language[1330], language[1332], language[1330], language[1332], nullptr });
+			optionDescriptions.insert(optionDescriptions.end(), { language[1329], language[1331], language[1333], language[1538], language[1539], nullptr });
+			optionSubtexts.insert(optionSubtexts.end(), { nullptr, nullptr, nullptr, language[1537], language[1537] });
+			displayedOptionToGamemode.insert(displayedOptionToGamemode.end(), { SINGLE, SERVER, CLIENT, DIRECTSERVER, DIRECTCLIENT, 0 });
+#endif
+			for ( int mode = 0; mode < nummodes; mode++ )
 			{
-				if ( c < 14 )
+				char selected = ' ';
+				if ( multiplayerselect == displayedOptionToGamemode.at(mode) )
 				{
-					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[1351 + c]);
+					selected = 'o';
 				}
-				else if ( c < 16 )
+				if ( optionSubtexts.at(mode) == nullptr )
 				{
-					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[1940 + (c - 14)]);
+					ttfPrintTextFormatted(ttf16, subx1 + 32, optionY.at(mode), "[%c] %s", selected, optionTexts.at(mode));
 				}
-				else if ( c < 22 )
+				else
 				{
-					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[1986 + (c - 16)]);
+					ttfPrintTextFormatted(ttf16, subx1 + 32, optionY.at(mode), "[%c] %s\n     %s", selected, optionTexts.at(mode), optionSubtexts.at(mode));
 				}
-				else if ( c < 25 )
+				if ( selected == 'o' ) // draw description
 				{
-					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[3901 + (c - 22)]);
+					ttfPrintText(ttf12, subx1 + 8, suby2 - 80, optionDescriptions.at(mode));
 				}
-				if ( inputs.bMouseLeft(clientnum) && !rebindingkey )
+
+				if ( multiplayerselect == SINGLE )
 				{
-					if ( omousex >= subx1 + 24 && omousex < subx2 - 24 )
+					if ( singleplayerSavegameFreeSlot == -1 )
 					{
-						if ( omousey >= suby1 + 84 + c * 16 && omousey < suby1 + 96 + c * 16 )
-						{
-							inputs.mouseClearLeft(clientnum);
-							lastkeypressed = 0;
-							rebindingkey = true;
-							rebindkey = c;
-						}
+						ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60, uint32ColorOrange(*mainsurface), true, language[2965]);
 					}
 				}
-				if ( c != rebindkey )
+				else if ( multiplayerselect > SINGLE )
 				{
-					if ( !strcmp(getInputName(settings_impulses[c]), "Unassigned key" ))
+					if ( multiplayerSavegameFreeSlot == -1 )
 					{
-						ttfPrintTextColor(ttf12, subx1 + 256, suby1 + 84 + c * 16, uint32ColorBaronyBlue(*mainsurface), true, getInputName(settings_impulses[c]));
+						ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60, uint32ColorOrange(*mainsurface), true, language[2966]);
 					}
-					else if ( !strcmp(getInputName(settings_impulses[c]), "Unknown key") || !strcmp(getInputName(settings_impulses[c]), "Unknown trigger") )
+					if ( gamemods_numCurrentModsLoaded >= 0 )
 					{
-						ttfPrintTextColor(ttf12, subx1 + 256, suby1 + 84 + c * 16, uint32ColorRed(*mainsurface), true, getInputName(settings_impulses[c]));
+						ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60 - TTF12_HEIGHT * 6, uint32ColorOrange(*mainsurface), true, language[2981]);
 					}
-					else
+				}
+				if ( gamemods_numCurrentModsLoaded >= 0 )
+				{
+					ttfPrintTextColor(ttf12, subx1 + 8, suby2 - 60 + TTF12_HEIGHT, uint32ColorBaronyBlue(*mainsurface), true, language[2982]);
+				}
+				if ( inputs.bMouseLeft(clientnum) )
+				{
+					if ( omousex >= subx1 + 40 && omousex < subx1 + 72 )
 					{
-						ttfPrintText(ttf12, subx1 + 256, suby1 + 84 + c * 16, getInputName(settings_impulses[c]));
+						if ( omousey >= optionY.at(mode) && omousey < (optionY.at(mode) + optionHeight) )
+						{
+							inputs.mouseClearLeft(clientnum);
+							multiplayerselect = displayedOptionToGamemode.at(mode);
+						}
+					}
+				}
+			}
+			if (keystatus[SDL_SCANCODE_UP] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_UP) && rebindaction == -1) )
+			{
+				keystatus[SDL_SCANCODE_UP] = 0;
+				if ( rebindaction == -1 )
+				{
+					inputs.controllerClearInput(clientnum, INJOY_DPAD_UP);
+				}
+				inputs.hideMouseCursors();
+
+				Uint32 vIndex = 0;
+				for ( auto& option : displayedOptionToGamemode )
+				{
+					if ( option == multiplayerselect )
+					{
+						break;
 					}
+					++vIndex;
+				}
+				if ( vIndex > 0 )
+				{
+					multiplayerselect = displayedOptionToGamemode.at(vIndex - 1);
 				}
 				else
 				{
-					ttfPrintTextColor(ttf12, subx1 + 256, suby1 + 84 + c * 16, uint32ColorGreen(*mainsurface), true, "...");
+					multiplayerselect = displayedOptionToGamemode.at(nummodes - 1);
 				}
 			}
-
-			if ( rebindkey != -1 && lastkeypressed )
+			if ( keystatus[SDL_SCANCODE_DOWN] || (inputs.bControllerInputPressed(clientnum, INJOY_DPAD_DOWN) && rebindaction == -1) )
 			{
-				if ( lastkeypressed == SDL_SCANCODE_ESCAPE )
+				keystatus[SDL_SCANCODE_DOWN] = 0;
+				if ( rebindaction == -1 )
 				{
-					keystatus[SDL_SCANCODE_ESCAPE] = 0;
-					lastkeypressed = 0;
-					rebindkey = -1;
+					inputs.controllerClearInput(clientnum, INJOY_DPAD_DOWN);
 				}
-				else
+				inputs.hideMouseCursors();
+
+				Uint32 vIndex = 0;
+				for ( auto& option : displayedOptionToGamemode )
 				{
-					settings_impulses[rebindkey] = lastkeypressed;
-					if ( lastkeypressed == 283 )
+					if ( option == multiplayerselect )
 					{
-						inputs.mouseClearLeft(clientnum);  // fixes mouse-left not registering bug
+						break;
 					}
-					rebindkey = -1;
+					++vIndex;
+				}
+				if ( vIndex >= nummodes - 1 )
+				{
+					multiplayerselect = displayedOptionToGamemode.at(0);
+				}
+				else
+				{
+					multiplayerselect = displayedOptionToGamemode.at(vIndex + 1);
 				}
 			}
 		}
+	}
 
-		// mouse tab
-		if ( settings_tab == SETTINGS_MOUSE_TAB )
-		{
-			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1365]);
-			doSliderF(subx1 + 24, suby1 + 84, 11, 0, 128, 1, &settings_mousespeed);
+	// serial window.
+#if (!defined STEAMWORKS && !defined USE_EOS)
+	if ( intro && introstage == 1 && subwindow && !strcmp(subtext, language[3403]) && serialEnterWindow )
+	{
+		drawDepressed(subx1 + 8, suby1 + 32, subx2 - 8, suby1 + 56);
+		ttfPrintText(ttf12, subx1 + 16, suby1 + 40, serialInputText);
 
-			// checkboxes
-			if ( settings_reversemouse )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 108, "[x] %s", language[1366]);
-			}
-			else
+		// enter character name
+		if ( serialVerifyWindow == 0 && !SDL_IsTextInputActive() )
+		{
+			if (inputstr != serialInputText)
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 108, "[ ] %s", language[1366]);
+				inputstr = serialInputText;
+#ifdef NINTENDO
+				auto result = nxKeyboard("Enter your character's name");
+				if (result.success)
+				{
+					strncpy(inputstr, result.str.c_str(), 21);
+					inputstr[21] = '\0'; //TODO: NX Port: The inputlen below names 63...? Should this be modified to match? Everywhere else, we operate on inputstr[21] when inputlen = 22.
+				}
+#endif
 			}
-			if ( settings_smoothmouse )
+			SDL_StartTextInput();
+		}
+		//strncpy(stats[0]->name,inputstr,16);
+		inputlen = 63;
+
+		if ( serialVerifyWindow > 0 )
+		{
+			if ( serialVerifyWindow % 10 < 3 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 132, "[x] %s", language[1367]);
+				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying");
 			}
-			else
+			else if ( serialVerifyWindow % 10 < 5 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 132, "[ ] %s", language[1367]);
+				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying.");
 			}
-			if ( settings_disablemouserotationlimit )
+			else if ( serialVerifyWindow % 10 < 7 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 156, "[x] %s", language[3918]);
+				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying..");
 			}
-			else
+			else if ( serialVerifyWindow % 10 < 10 )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 156, "[ ] %s", language[3918]);
+				ttfPrintTextFormattedColor(ttf12, subx1 + 16, suby2 - 20, uint32ColorOrange(*mainsurface), "Verifying...");
 			}
-			if ( inputs.bMouseLeft(clientnum) )
+			if ( ticks % (TICKS_PER_SECOND / 2) == 0 )
 			{
-				if ( omousex >= subx1 + 30 && omousex < subx1 + 54 )
+				++serialVerifyWindow;
+				if ( serialVerifyWindow >= 25 )
 				{
-					if ( omousey >= suby1 + 108 && omousey < suby1 + 120 )
-					{
-						inputs.mouseClearLeft(clientnum);
-						settings_reversemouse = (settings_reversemouse == 0);
-					}
-					if ( omousey >= suby1 + 132 && omousey < suby1 + 144 )
+					std::string serial = serialInputText;
+
+					// compute hash
+					if ( !serial.empty() )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_smoothmouse = (settings_smoothmouse == 0);
+						std::size_t DLCHash = serialHash(serial);
+						if ( DLCHash == 144425 )
+						{
+							printlog("[LICENSE]: Myths and Outcasts DLC license key found.");
+							enabledDLCPack1 = true;
+							windowSerialResult(1);
+						}
+						else if ( DLCHash == 135398 )
+						{
+							printlog("[LICENSE]: Legends and Pariahs DLC license key found.");
+							enabledDLCPack2 = true;
+							windowSerialResult(2);
+						}
+						else
+						{
+							printlog("[LICENSE]: DLC license key invalid.");
+							windowSerialResult(0);
+						}
 					}
-					if ( omousey >= suby1 + 156 && omousey < suby1 + 168 )
+					else
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_disablemouserotationlimit = (settings_disablemouserotationlimit == 0);
+						windowSerialResult(0);
 					}
 				}
 			}
 		}
-
-		//Gamepad tab
-		if (settings_tab == SETTINGS_GAMEPAD_BINDINGS_TAB)
+		else if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
 		{
-			SDL_Rect startPos;
-			startPos.x = subx1 + 24;
-			startPos.y = suby1 + 60;
-			SDL_Rect currentPos = startPos;
-			ttfPrintText(ttf8, currentPos.x, currentPos.y, language[1996]);
-			currentPos.y += 24;
-
-			bool rebindingaction = false;
-			if (rebindaction != -1)
-			{
-				rebindingaction = true;
-			}
-
-			//Print out the bi-functional bindings.
-			for ( int c = 0; c < INDEX_JOYBINDINGS_START_MENU; ++c, currentPos.y += 12 )
-			{
-				printJoybindingNames(currentPos, c, rebindingaction);
-			}
+			int x;
+			getSizeOfText(ttf12, serialInputText, &x, NULL);
+			ttfPrintText(ttf12, subx1 + 16 + x, suby1 + 40, "_");
+		}
+	}
+#endif
 
-			//Print out the menu-exclusive bindings.
-			currentPos.y += 12;
-			drawLine(subx1 + 24, currentPos.y - 6, subx2 - 24, currentPos.y - 6, uint32ColorGray(*mainsurface), 255);
-			ttfPrintText(ttf8, currentPos.x, currentPos.y, language[1994]);
-			currentPos.y += 18;
-			for ( c = INDEX_JOYBINDINGS_START_MENU; c < INDEX_JOYBINDINGS_START_GAME; ++c, currentPos.y += 12 )
-			{
-				printJoybindingNames(currentPos, c, rebindingaction);
-			}
+	// settings window
+	if ( settings_window == true )
+	{
+		drawWindowFancy(subx1 + 16, suby1 + 44, subx2 - 16, suby2 - 32);
 
-			//Print out the game-exclusive bindings.
-			currentPos.y += 12;
-			drawLine(subx1 + 24, currentPos.y - 6, subx2 - 24, currentPos.y - 6, uint32ColorGray(*mainsurface), 255);
-			ttfPrintText(ttf8, currentPos.x, currentPos.y, language[1995]);
-			currentPos.y += 18;
-			for ( c = INDEX_JOYBINDINGS_START_GAME; c < NUM_JOY_IMPULSES; ++c, currentPos.y += 12 )
-			{
-				printJoybindingNames(currentPos, c, rebindingaction);
-			}
+		int hovering_selection = -1; //0 to NUM_SERVER_FLAGS used for the game flags settings, e.g. are traps enabled, are cheats enabled, is minotaur enabled, etc.
+		SDL_Rect tooltip_box;
 
-			if (rebindaction != -1 && lastkeypressed)
-			{
+		if ( inputs.bControllerInputPressed(clientnum, INJOY_MENU_SETTINGS_NEXT) && rebindaction == -1 )
+		{
+			inputs.controllerClearInput(clientnum, INJOY_MENU_SETTINGS_NEXT);
+			changeSettingsTab(settings_tab + 1);
+		}
+		if ( inputs.bControllerInputPressed(clientnum, INJOY_MENU_SETTINGS_PREV) && rebindaction == -1 )
+		{
+			inputs.controllerClearInput(clientnum, INJOY_MENU_SETTINGS_PREV);
+			changeSettingsTab(settings_tab - 1);
+		}
 
-				if (lastkeypressed >= 299)   /* Is a joybutton. */
+		// video tab
+		if ( settings_tab == SETTINGS_VIDEO_TAB )
+		{
+			// resolution
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1338]);
+			c=0;
+			for ( auto cur : resolutions )
+			{
+				int width, height;
+				std::tie (width, height) = cur;
+				if ( settings_xres == width && settings_yres == height )
 				{
-					settings_joyimpulses[rebindaction] = lastkeypressed;
-					*inputPressed(lastkeypressed) = 0; //To prevent bugs where the button will still be treated as pressed after assigning it, potentially doing wonky things.
-					rebindaction = -1;
+					ttfPrintTextFormatted(ttf12, subx1 + 32, suby1 + 84 + c * 16, "[o] %dx%d", width, height);
 				}
 				else
 				{
-					if (lastkeypressed == SDL_SCANCODE_ESCAPE)
+					ttfPrintTextFormatted(ttf12, subx1 + 32, suby1 + 84 + c * 16, "[ ] %dx%d", width, height);
+				}
+				if ( inputs.bMouseLeft(clientnum) )
+				{
+					if ( omousex >= subx1 + 38 && omousex < subx1 + 62 )
 					{
-						keystatus[SDL_SCANCODE_ESCAPE] = 0;
+						if ( omousey >= suby1 + 84 + c * 16 && omousey < suby1 + 96 + c * 16 )
+						{
+							inputs.mouseClearLeft(clientnum);
+							settings_xres = width;
+							settings_yres = height;
+							resolutionChanged = true;
+						}
 					}
-					lastkeypressed = 0;
-					rebindaction = -1;
 				}
+				c++;
 			}
-		}
-
-		//General gamepad settings
-		if (settings_tab == SETTINGS_GAMEPAD_SETTINGS_TAB)
-		{
-			int current_option_x = subx1 + 24;
-			int current_option_y = suby1 + 60;
 
-			//Checkboxes.
-			if (settings_gamepad_leftx_invert)
+			// extra options
+			ttfPrintText(ttf12, subx1 + 224, suby1 + 60, language[1339]);
+			if ( settings_smoothlighting )
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2401]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 84, "[x] %s", language[1340]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2401]);
-			}
-
-			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
-			{
-				inputs.mouseClearLeft(clientnum);
-				settings_gamepad_leftx_invert = !settings_gamepad_leftx_invert;
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 84, "[ ] %s", language[1340]);
 			}
-
-			current_option_y += 24;
-
-			if (settings_gamepad_lefty_invert)
+			if ( settings_fullscreen )
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2402]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 108, "[x] %s", language[1341]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2402]);
-			}
-
-			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
-			{
-				inputs.mouseClearLeft(clientnum);
-				settings_gamepad_lefty_invert = !settings_gamepad_lefty_invert;
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 108, "[ ] %s", language[1341]);
 			}
-
-			current_option_y += 24;
-
-			if (settings_gamepad_rightx_invert)
+			if ( settings_shaking )
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2403]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 132, "[x] %s", language[1342]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2403]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 132, "[ ] %s", language[1342]);
 			}
-
-			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			if ( settings_bobbing )
 			{
-				inputs.mouseClearLeft(clientnum);
-				settings_gamepad_rightx_invert = !settings_gamepad_rightx_invert;
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 156, "[x] %s", language[1343]);
 			}
-
-			current_option_y += 24;
-
-			if (settings_gamepad_righty_invert)
+			else
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2404]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 156, "[ ] %s", language[1343]);
 			}
-			else
+			if ( settings_spawn_blood )
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2404]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 180, "[x] %s", language[1344]);
 			}
-
-			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			else
 			{
-				inputs.mouseClearLeft(clientnum);
-				settings_gamepad_righty_invert = !settings_gamepad_righty_invert;
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 180, "[ ] %s", language[1344]);
 			}
-
-			current_option_y += 24;
-
-			if (settings_gamepad_menux_invert)
+			if ( settings_colorblind )
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2405]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 204, "[x] %s", language[1345]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2405]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 204, "[ ] %s", language[1345]);
 			}
-
-			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			if ( settings_light_flicker )
 			{
-				inputs.mouseClearLeft(clientnum);
-				settings_gamepad_menux_invert = !settings_gamepad_menux_invert;
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 228, "[x] %s", language[2967]);
 			}
-
-			current_option_y += 24;
-
-			if (settings_gamepad_menuy_invert)
+			else
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2406]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 228, "[ ] %s", language[2967]);
 			}
-			else
+			if ( settings_vsync )
 			{
-				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2406]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 252, "[x] %s", language[3011]);
 			}
-
-			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			else
 			{
-				inputs.mouseClearLeft(clientnum);
-				settings_gamepad_menuy_invert = !settings_gamepad_menuy_invert;
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 252, "[ ] %s", language[3011]);
 			}
-
-			current_option_y += 24;
-
-			ttfPrintText(ttf12, current_option_x, current_option_y, language[2407]);
-			current_option_y += 24;
-			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_rightx_sensitivity, font8x8_bmp, 12); //Doesn't like any fonts besides the default.
-			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_rightx_sensitivity);
-
-			current_option_y += 24;
-
-			ttfPrintText(ttf12, current_option_x, current_option_y, language[2408]);
-			current_option_y += 24;
-			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_righty_sensitivity, font8x8_bmp, 12);
-			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_righty_sensitivity);
-
-			current_option_y += 24;
-
-			ttfPrintText(ttf12, current_option_x, current_option_y, language[2409]);
-			current_option_y += 24;
-			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_menux_sensitivity, font8x8_bmp, 12);
-			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_menux_sensitivity);
-
-			current_option_y += 24;
-
-			ttfPrintText(ttf12, current_option_x, current_option_y, language[2410]);
-			current_option_y += 24;
-			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_menuy_sensitivity, font8x8_bmp, 12);
-			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_menuy_sensitivity);
-		}
-
-		// miscellaneous options
-		if (settings_tab == SETTINGS_MISC_TAB)
-		{
-			int current_x = subx1;
-			int current_y = suby1 + 60;
-
-			ttfPrintText(ttf12, subx1 + 24, current_y, language[1371]);
-			current_y += 24;
-
-			int options_start_y = current_y;
-			if ( settings_broadcast )
+			if ( settings_status_effect_icons )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1372]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 276, "[x] %s", language[3357]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1372]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 276, "[ ] %s", language[3357]);
 			}
-			current_y += 16;
-			if ( settings_nohud )
+			if ( settings_borderless )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1373]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 300, "[x] %s", language[3935]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1373]);
+				ttfPrintTextFormatted(ttf12, subx1 + 236, suby1 + 300, "[ ] %s", language[3935]);
 			}
-			current_y += 16;
-			int hotbar_options_x = subx1 + 72 + 256;
-			int hotbar_options_y = current_y;
-			if ( settings_auto_hotbar_new_items )
+
+			if ( inputs.bMouseLeft(clientnum) )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1374]);
-				int pad_x = hotbar_options_x;
-				int pad_y = hotbar_options_y;
-				drawWindowFancy(pad_x - 16, pad_y - 32, pad_x + 4 * 128 + 16, pad_y + 48 + 16);
-				ttfPrintTextFormatted(ttf12, pad_x, current_y - 16, "%s", language[2583]);
-				for ( int i = 0; i < (NUM_HOTBAR_CATEGORIES); ++i )
+				if ( omousex >= subx1 + 242 && omousex < subx1 + 266 )
 				{
-					if ( settings_auto_hotbar_categories[i] == true )
+					if ( omousey >= suby1 + 84 && omousey < suby1 + 84 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_smoothlighting = (settings_smoothlighting == 0);
+					}
+					else if ( omousey >= suby1 + 108 && omousey < suby1 + 108 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_fullscreen = (settings_fullscreen == 0);
+					}
+					else if ( omousey >= suby1 + 132 && omousey < suby1 + 132 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_shaking = (settings_shaking == 0);
+					}
+					else if ( omousey >= suby1 + 156 && omousey < suby1 + 156 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_bobbing = (settings_bobbing == 0);
+					}
+					else if ( omousey >= suby1 + 180 && omousey < suby1 + 180 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_spawn_blood = (settings_spawn_blood == 0);
+					}
+					else if ( omousey >= suby1 + 204 && omousey < suby1 + 204 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_colorblind = (settings_colorblind == false);
+					}
+					else if ( omousey >= suby1 + 228 && omousey < suby1 + 228 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_light_flicker = (settings_light_flicker == false);
+					}
+					else if ( omousey >= suby1 + 252 && omousey < suby1 + 252 + 12 )
 					{
-						ttfPrintTextFormatted(ttf12, pad_x, pad_y, "[x] %s", language[2571 + i]);
+						inputs.mouseClearLeft(clientnum);
+						settings_vsync = (settings_vsync == false);
 					}
-					else
+					else if ( omousey >= suby1 + 276 && omousey < suby1 + 276 + 12 )
 					{
-						ttfPrintTextFormatted(ttf12, pad_x, pad_y, "[ ] %s", language[2571 + i]);
+						inputs.mouseClearLeft(clientnum);
+						settings_status_effect_icons = (settings_status_effect_icons == false);
 					}
-					pad_x += 128;
-					if ( i == 3 || i == 7 )
+					else if ( omousey >= suby1 + 300 && omousey < suby1 + 300 + 12 )
 					{
-						pad_x = hotbar_options_x;
-						pad_y += 16;
+						inputs.mouseClearLeft(clientnum);
+						settings_borderless = (settings_borderless == false);
 					}
 				}
 			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1374]);
-			}
 
-			// autosort inventory categories
-			int autosort_options_x = subx1 + 72 + 256;
-			int autosort_options_y = current_y + 112;
-			int pad_x = autosort_options_x;
-			int pad_y = autosort_options_y;
-			drawWindowFancy(pad_x - 16, pad_y - 32, pad_x + 4 * 128 + 16, pad_y + 48 + 16);
-			ttfPrintTextFormatted(ttf12, pad_x, current_y - 16 + 112, "%s", language[2912]);
+			// minimap options
+			ttfPrintText(ttf12, subx1 + 498, suby1 + 60, language[3022]);
 
-			// draw the values for autosort
-			for ( int i = 0; i < (NUM_AUTOSORT_CATEGORIES); ++i )
-			{
-				ttfPrintTextFormatted(ttf12, pad_x, pad_y, "<");
-				Uint32 autosortColor = uint32ColorGreen(*mainsurface);
-				int padValue_x = pad_x;
-				if ( settings_autosort_inventory_categories[i] < 0 )
-				{
-					autosortColor = uint32ColorRed(*mainsurface);
-					padValue_x += 4; // centre the negative numbers.
-				}
-				else if ( settings_autosort_inventory_categories[i] == 0 )
-				{
-					autosortColor = uint32ColorWhite(*mainsurface);
-				}
-				ttfPrintTextFormattedColor(ttf12, padValue_x, pad_y, autosortColor, " %2d", settings_autosort_inventory_categories[i]);
-				if ( i == NUM_AUTOSORT_CATEGORIES - 1 )
-				{
-					ttfPrintTextFormatted(ttf12, pad_x, pad_y, "    > %s", language[2916]);
-				}
-				else
-				{
-					ttfPrintTextFormatted(ttf12, pad_x, pad_y, "    > %s", language[2571 + i]);
-				}
-				pad_x += 128;
-				if ( i == 3 || i == 7 )
-				{
-					pad_x = autosort_options_x;
-					pad_y += 16;
-				}
-			}
+			// total scale
+			ttfPrintText(ttf12, subx1 + 498, suby1 + 84, language[3025]);
+			doSlider(subx1 + 498, suby1 + 84 + 24, 10, 2, 16, 1, (int*)(&settings_minimap_scale));
 
-			pad_x = autosort_options_x + (strlen(language[2912]) - 3) * (TTF12_WIDTH) + 8; // 3 chars from the end of string.
-			pad_y = autosort_options_y;
-			// hover text for autosort title text
-			if ( mouseInBounds(clientnum, pad_x - 4, pad_x + 3 * TTF12_WIDTH + 8, current_y - 16 + 112, current_y - 16 + 124) )
-			{
-				tooltip_box.x = omousex - TTF12_WIDTH * 32;
-				tooltip_box.y = omousey - (TTF12_HEIGHT * 3 + 16);
-				tooltip_box.w = strlen(language[2914]) * TTF12_WIDTH + 8;
-				tooltip_box.h = TTF12_HEIGHT * 3 + 8;
-				drawTooltip(&tooltip_box);
-				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[2913]);
-				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4 + TTF12_HEIGHT, language[2914]);
-				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4 + TTF12_HEIGHT * 2, language[2915]);
-			}
+			// objects (players/allies/minotaur) scale
+			ttfPrintText(ttf12, subx1 + 498, suby1 + 130, language[3026]);
+			doSlider(subx1 + 498, suby1 + 130 + 24, 10, 0, 4, 1, (int*)(&settings_minimap_object_zoom));
 
-			current_y += 16;
-			if ( settings_auto_appraise_new_items )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1997]);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1997]);
-			}
-			current_y += 16;
-			if ( settings_disable_messages )
+			// foreground transparency
+			ttfPrintText(ttf12, subx1 + 498, suby1 + 176, language[3023]);
+			doSlider(subx1 + 498, suby1 + 176 + 24, 10, 0, 100, 1, (int*)(&settings_minimap_transparency_foreground));
+
+			// background transparency
+			ttfPrintText(ttf12, subx1 + 498, suby1 + 222, language[3024]);
+			doSlider(subx1 + 498, suby1 + 222 + 24, 10, 0, 100, 1, (int*)(&settings_minimap_transparency_background));
+
+			// UI options
+			ttfPrintText(ttf12, subx1 + 498, suby1 + 276, language[3034]);
+
+			if ( settings_uiscale_charactersheet )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1536]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 300, "[x] %s", language[3027]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1536]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 300, "[ ] %s", language[3027]);
 			}
-			current_y += 16;
-			if ( settings_right_click_protect )
+			if ( settings_uiscale_skillspage )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1998]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 324, "[x] %s", language[3028]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1998]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 324, "[ ] %s", language[3028]);
 			}
-			current_y += 16;
-			if ( settings_hotbar_numkey_quick_add )
+			if ( settings_hide_statusbar )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[2590]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 348, "[x] %s", language[3033]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[2590]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 348, "[ ] %s", language[3033]);
 			}
-			current_y += 16;
-			if ( settings_lock_right_sidebar )
+			if ( settings_hide_playertags )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[2598]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 372, "[x] %s", language[3136]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[2598]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 372, "[ ] %s", language[3136]);
 			}
-			current_y += 16;
-			if ( settings_show_game_timer_always )
+			if ( settings_show_skill_values )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[2983]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 396, "[x] %s", language[3159]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[2983]);
+				ttfPrintTextFormatted(ttf12, subx1 + 498, suby1 + 396, "[ ] %s", language[3159]);
 			}
-			current_y += 32;
-
-			// server flag elements
-			ttfPrintText(ttf12, subx1 + 24, current_y, language[1375]);
-			current_y += 24;
-
 
-			int server_flags_start_y = current_y;
-			for ( int i = 0; i < NUM_SERVER_FLAGS; i++, current_y += 16 )
+			if ( inputs.bMouseLeft(clientnum) )
 			{
-				char flagStringBuffer[512] = "";
-				if ( i < 5 )
-				{
-					strncpy(flagStringBuffer, language[153 + i], 255);
-				}
-				else
-				{
-					strncpy(flagStringBuffer, language[2917 - 5 + i], 255);
-				}
-
-				bool flagEnabled = settings_svFlags & power(2, i);
-				if ( multiplayer == CLIENT )
-				{
-					flagEnabled = svFlags & power(2, i); // clients get the data from the server and don't cache it
-				}
-
-				if ( flagEnabled )
-				{
-					ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", flagStringBuffer);
-				}
-				else
-				{
-					ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", flagStringBuffer);
-				}
-				if (mouseInBounds(clientnum, subx1 + 36 + 6, subx1 + 36 + 24 + 6, current_y, current_y + 12))   //So many gosh dang magic numbers ._.
+				if ( omousex >= subx1 + 498 && omousex < subx1 + 522 )
 				{
-					if ( i < 5 )
+					if ( omousey >= suby1 + 300 && omousey < suby1 + 300 + 12 )
 					{
-						strncpy(flagStringBuffer, language[1942 + i], 255);
+						inputs.mouseClearLeft(clientnum);
+						settings_uiscale_charactersheet = (settings_uiscale_charactersheet == 0);
 					}
-					else
+					else if ( omousey >= suby1 + 324 && omousey < suby1 + 324 + 12 )
 					{
-						strncpy(flagStringBuffer, language[2921 - 5 + i], 255);
+						inputs.mouseClearLeft(clientnum);
+						settings_uiscale_skillspage = (settings_uiscale_skillspage == 0);
 					}
-					if (strlen(flagStringBuffer) > 0)   //Don't bother drawing a tooltip if the file doesn't say anything.
+					else if ( omousey >= suby1 + 348 && omousey < suby1 + 348 + 12 )
 					{
-						hovering_selection = i;
-#if (!defined STEAMWORKS && !defined USE_EOS)
-						if ( hovering_selection == 0 )
-						{
-							hovering_selection = -1; // don't show cheats tooltip about disabling achievements.
-						}
-#endif // STEAMWORKS
-						tooltip_box.x = omousex + 16;
-						tooltip_box.y = omousey + 8; //I hate magic numbers :|. These should probably be replaced with omousex + mousecursorsprite->width, omousey + mousecursorsprite->height, respectively.
-						if ( i == 2 || i == 3 || i == 5 || i == 6 || i == 7 )
-						{
-							tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-						}
-						else if ( i == 4 || i == 8 )
-						{
-							tooltip_box.h = TTF12_HEIGHT * 3 + 8;
-						}
-						else
-						{
-							tooltip_box.h = TTF12_HEIGHT + 8;
-						}
-						if ( gameModeManager.isServerflagDisabledForCurrentMode(i) )
-						{
-							strcat(flagStringBuffer, language[3962]); // changing flags disabled.
-							tooltip_box.h += TTF12_HEIGHT;
-						}
-						tooltip_box.w = longestline(flagStringBuffer) * TTF12_WIDTH + 8; //MORE MAGIC NUMBERS. HNNGH. I can guess what they all do, but dang.
+						inputs.mouseClearLeft(clientnum);
+						settings_hide_statusbar = (settings_hide_statusbar == 0);
+					}
+					else if ( omousey >= suby1 + 372 && omousey < suby1 + 372 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_hide_playertags = (settings_hide_playertags == 0);
+					}
+					else if ( omousey >= suby1 + 396 && omousey < suby1 + 396 + 12 )
+					{
+						inputs.mouseClearLeft(clientnum);
+						settings_show_skill_values = (settings_show_skill_values == 0);
 					}
 				}
 			}
+			// UI scale sliders
+			ttfPrintText(ttf12, subx1 + 498, suby2 - 220, language[3029]);
+			doSliderF(subx1 + 498, suby2 - 220 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_hotbar);
+			ttfPrintText(ttf12, subx1 + 498, suby2 - 174, language[3030]);
+			doSliderF(subx1 + 498, suby2 - 174 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_chatlog);
+			ttfPrintText(ttf12, subx1 + 498, suby2 - 128, language[3031]);
+			doSliderF(subx1 + 498, suby2 - 128 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_playerbars);
+			ttfPrintText(ttf12, subx1 + 498, suby2 - 80, language[3032]);
+			doSliderF(subx1 + 498, suby2 - 80 + 24, 10, 1.f, 2.f, 0.25, &settings_uiscale_inventory);
+
+			// fov slider
+			ttfPrintText(ttf12, subx1 + 24, suby2 - 174, language[1346]);
+			doSlider(subx1 + 24, suby2 - 148, 14, 40, 100, 1, (int*)(&settings_fov));
+
+			// gamma slider
+			ttfPrintText(ttf12, subx1 + 24, suby2 - 128, language[1347]);
+			doSliderF(subx1 + 24, suby2 - 104, 14, 0.25, 2.f, 0.25, &settings_gamma);
+
+			// fps slider
+			ttfPrintText(ttf12, subx1 + 24, suby2 - 80, language[2411]);
+			doSlider(subx1 + 24, suby2 - 56, 14, 60, 144, 1, (int*)(&settings_fps));
+		}
+
+		// audio tab
+		if ( settings_tab == SETTINGS_AUDIO_TAB )
+		{
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1348]);
+			doSlider(subx1 + 24, suby1 + 84, 15, 0, 128, 0, &settings_sfxvolume);
+
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 108, language[3972]);
+			doSlider(subx1 + 24, suby1 + 132, 15, 0, 128, 0, &settings_sfxAmbientVolume);
+
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 156, language[3973]);
+			doSlider(subx1 + 24, suby1 + 180, 15, 0, 128, 0, &settings_sfxEnvironmentVolume);
 
-			// network options
-			current_y += 32;
-			ttfPrintText(ttf12, subx1 + 24, current_y, language[3146]);
-			current_y += 24;
-			int networking_options_start_y = current_y;
-			if ( settings_disableFPSLimitOnNetworkMessages )
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 204, language[1349]);
+			doSlider(subx1 + 24, suby1 + 228, 15, 0, 128, 0, &settings_musvolume);
+
+			if ( settings_minimap_ping_mute )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", "disable netcode FPS optimization");
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 264, "[x] %s", language[3012]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", "disable netcode FPS optimization");
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 264, "[ ] %s", language[3012]);
 			}
-			current_y += 16;
-#ifdef STEAMWORKS
-			if ( settings_disableMultithreadedSteamNetworking )
+			if ( settings_mute_audio_on_focus_lost )
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[3147]);
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 288, "[x] %s", language[3158]);
 			}
 			else
 			{
-				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[3147]);
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 288, "[ ] %s", language[3158]);
 			}
-#ifdef USE_EOS
-			current_y += 16;
-			ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[%c] %s", LobbyHandler.settings_crossplayEnabled ? 'x' : ' ', language[3948]);
-#endif
-#endif // STEAMWORKS
-
-			if (hovering_selection > -1)
+			if ( settings_mute_player_monster_sounds )
 			{
-				drawTooltip(&tooltip_box);
-				if (hovering_selection < NUM_SERVER_FLAGS)
-				{
-					char flagStringBuffer[512] = "";
-					if ( hovering_selection < 5 )
-					{
-						strncpy(flagStringBuffer, language[1942 + hovering_selection], 255);
-					}
-					else
-					{
-						strncpy(flagStringBuffer, language[2921 - 5 + hovering_selection], 255);
-					}
-					if ( gameModeManager.isServerflagDisabledForCurrentMode(hovering_selection) )
-					{
-						strcat(flagStringBuffer, language[3962]); // changing flags disabled.
-					}
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, flagStringBuffer);
-				}
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 312, "[x] %s", language[3371]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 312, "[ ] %s", language[3371]);
 			}
-
-			current_y = options_start_y;
-
 			if ( inputs.bMouseLeft(clientnum) )
 			{
-				if ( omousex >= subx1 + 42 && omousex < subx1 + 66 )
+				if ( omousex >= subx1 + 30 && omousex < subx1 + 54 )
 				{
-					if ( omousey >= current_y && omousey < current_y + 12 )
-					{
-						inputs.mouseClearLeft(clientnum);
-						settings_broadcast = (settings_broadcast == false);
-					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
-					{
-						inputs.mouseClearLeft(clientnum);
-						settings_nohud = (settings_nohud == false);
-					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+					if ( omousey >= suby1 + 168 && omousey < suby1 + 264 + 12 )
 					{
 						inputs.mouseClearLeft(clientnum);
-						settings_auto_hotbar_new_items = (settings_auto_hotbar_new_items == false);
+						settings_minimap_ping_mute = (settings_minimap_ping_mute == false);
 					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+					else if ( omousey >= suby1 + 192 && omousey < suby1 + 288 + 12 )
 					{
 						inputs.mouseClearLeft(clientnum);
-						settings_auto_appraise_new_items = (settings_auto_appraise_new_items == false);
+						settings_mute_audio_on_focus_lost = (settings_mute_audio_on_focus_lost == false);
 					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+					else if ( omousey >= suby1 + 216 && omousey < suby1 + 312 + 12 )
 					{
 						inputs.mouseClearLeft(clientnum);
-						settings_disable_messages = (settings_disable_messages == false);
+						settings_mute_player_monster_sounds = (settings_mute_player_monster_sounds == false);
 					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+				}
+			}
+		}
+
+		// keyboard tab
+		if ( settings_tab == SETTINGS_KEYBOARD_TAB )
+		{
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1350]);
+
+			bool rebindingkey = false;
+			if ( rebindkey != -1 )
+			{
+				rebindingkey = true;
+			}
+
+			for ( int c = 0; c < NUMIMPULSES; c++ )
+			{
+				if ( c < 14 )
+				{
+					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[1351 + c]);
+				}
+				else if ( c < 16 )
+				{
+					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[1940 + (c - 14)]);
+				}
+				else if ( c < 22 )
+				{
+					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[1986 + (c - 16)]);
+				}
+				else if ( c < 25 )
+				{
+					ttfPrintText(ttf12, subx1 + 24, suby1 + 84 + 16 * c, language[3901 + (c - 22)]);
+				}
+				if ( inputs.bMouseLeft(clientnum) && !rebindingkey )
+				{
+					if ( omousex >= subx1 + 24 && omousex < subx2 - 24 )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_right_click_protect = (settings_right_click_protect == false);
+						if ( omousey >= suby1 + 84 + c * 16 && omousey < suby1 + 96 + c * 16 )
+						{
+							inputs.mouseClearLeft(clientnum);
+							lastkeypressed = 0;
+							rebindingkey = true;
+							rebindkey = c;
+						}
 					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+				}
+				if ( c != rebindkey )
+				{
+					if ( !strcmp(getInputName(settings_impulses[c]), "Unassigned key" ))
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_hotbar_numkey_quick_add = (settings_hotbar_numkey_quick_add == false);
+						ttfPrintTextColor(ttf12, subx1 + 256, suby1 + 84 + c * 16, uint32ColorBaronyBlue(*mainsurface), true, getInputName(settings_impulses[c]));
 					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+					else if ( !strcmp(getInputName(settings_impulses[c]), "Unknown key") || !strcmp(getInputName(settings_impulses[c]), "Unknown trigger") )
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_lock_right_sidebar = (settings_lock_right_sidebar == false);
+						ttfPrintTextColor(ttf12, subx1 + 256, suby1 + 84 + c * 16, uint32ColorRed(*mainsurface), true, getInputName(settings_impulses[c]));
 					}
-					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
+					else
 					{
-						inputs.mouseClearLeft(clientnum);
-						settings_show_game_timer_always = (settings_show_game_timer_always == false);
+						ttfPrintText(ttf12, subx1 + 256, suby1 + 84 + c * 16, getInputName(settings_impulses[c]));
 					}
 				}
 				else
 				{
-					if ( settings_auto_hotbar_new_items )
-					{
-						if ( inputs.bMouseLeft(clientnum) )
-						{
-							for ( int i = 0; i < NUM_HOTBAR_CATEGORIES; ++i )
-							{
-								if ( mouseInBounds(clientnum, hotbar_options_x, hotbar_options_x + 24, hotbar_options_y, hotbar_options_y + 12) )
-								{
-									settings_auto_hotbar_categories[i] = !settings_auto_hotbar_categories[i];
-									inputs.mouseClearLeft(clientnum);
-								}
-								hotbar_options_x += 128;
-								if ( i == 3 || i == 7 )
-								{
-									hotbar_options_x -= (128 * 4);
-									hotbar_options_y += 16;
-								}
-							}
-						}
-					}
-
-					// autosort category toggles
-					if ( inputs.bMouseLeft(clientnum) )
-					{
-						for ( int i = 0; i < NUM_AUTOSORT_CATEGORIES; ++i )
-						{
-							if ( mouseInBounds(clientnum, autosort_options_x, autosort_options_x + 16, autosort_options_y, autosort_options_y + 12) )
-							{
-								--settings_autosort_inventory_categories[i];
-								if ( settings_autosort_inventory_categories[i] < -9 )
-								{
-									settings_autosort_inventory_categories[i] = 9;
-								}
-								inputs.mouseClearLeft(clientnum);
-							}
-							else if ( mouseInBounds(clientnum, autosort_options_x + 36, autosort_options_x + 52, autosort_options_y, autosort_options_y + 12) )
-							{
-								++settings_autosort_inventory_categories[i];
-								if ( settings_autosort_inventory_categories[i] > 9 )
-								{
-									settings_autosort_inventory_categories[i] = -9;
-								}
-								inputs.mouseClearLeft(clientnum);
-							}
-							autosort_options_x += 128;
-							if ( i == 3 || i == 7 )
-							{
-								autosort_options_x -= (128 * 4);
-								autosort_options_y += 16;
-							}
-						}
-					}
+					ttfPrintTextColor(ttf12, subx1 + 256, suby1 + 84 + c * 16, uint32ColorGreen(*mainsurface), true, "...");
 				}
+			}
 
-				if ( multiplayer != CLIENT )
+			if ( rebindkey != -1 && lastkeypressed )
+			{
+				if ( lastkeypressed == SDL_SCANCODE_ESCAPE )
 				{
-					current_y = server_flags_start_y;
-					for ( int i = 0; i < NUM_SERVER_FLAGS; i++, current_y += 16 )
+					keystatus[SDL_SCANCODE_ESCAPE] = 0;
+					lastkeypressed = 0;
+					rebindkey = -1;
+				}
+				else
+				{
+					settings_impulses[rebindkey] = lastkeypressed;
+					if ( lastkeypressed == 283 )
 					{
-						if ( !gameModeManager.isServerflagDisabledForCurrentMode(i)
-							&& mouseInBounds(clientnum, subx1 + 36 + 6, subx1 + 36 + 24 + 6, current_y, current_y + 12) )
-						{
-							inputs.mouseClearLeft(clientnum);
-
-							// toggle flag
-							settings_svFlags ^= power(2, i);
-						}
+						inputs.mouseClearLeft(clientnum);  // fixes mouse-left not registering bug
 					}
+					rebindkey = -1;
 				}
 			}
+		}
 
+		// mouse tab
+		if ( settings_tab == SETTINGS_MOUSE_TAB )
+		{
+			ttfPrintText(ttf12, subx1 + 24, suby1 + 60, language[1365]);
+			doSliderF(subx1 + 24, suby1 + 84, 11, 0, 128, 1, &settings_mousespeed);
 
-			if ( omousex >= subx1 + 42 && omousex < subx1 + 66 )
+			// checkboxes
+			if ( settings_reversemouse )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 108, "[x] %s", language[1366]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 108, "[ ] %s", language[1366]);
+			}
+			if ( settings_smoothmouse )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 132, "[x] %s", language[1367]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 132, "[ ] %s", language[1367]);
+			}
+			if ( settings_disablemouserotationlimit )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 156, "[x] %s", language[3918]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 24, suby1 + 156, "[ ] %s", language[3918]);
+			}
+			if ( inputs.bMouseLeft(clientnum) )
 			{
-				tooltip_box.x = omousex + 16;
-				tooltip_box.y = omousey + 8;
-				tooltip_box.h = TTF12_HEIGHT + 8;
-
-				// networking hover text and mouse selection
-				current_y = networking_options_start_y;
-				if ( omousey >= current_y && omousey < current_y + 12 )
+				if ( omousex >= subx1 + 30 && omousex < subx1 + 54 )
 				{
-					//tooltip_box.w = longestline(language[3148]) * TTF12_WIDTH + 8;
-					//tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					//drawTooltip(&tooltip_box);
-					//ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3148]);
-					if ( inputs.bMouseLeft(clientnum) )
+					if ( omousey >= suby1 + 108 && omousey < suby1 + 120 )
 					{
 						inputs.mouseClearLeft(clientnum);
-						settings_disableFPSLimitOnNetworkMessages = (settings_disableFPSLimitOnNetworkMessages == false);
+						settings_reversemouse = (settings_reversemouse == 0);
 					}
-				}
-				current_y += 16;
-#ifdef STEAMWORKS
-				if ( omousey >= current_y && omousey < current_y + 12 )
-				{
-					tooltip_box.w = longestline(language[3148]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3148]);
-					if ( inputs.bMouseLeft(clientnum) )
+					if ( omousey >= suby1 + 132 && omousey < suby1 + 144 )
 					{
 						inputs.mouseClearLeft(clientnum);
-						settings_disableMultithreadedSteamNetworking = true;// (settings_disableMultithreadedSteamNetworking == false);
+						settings_smoothmouse = (settings_smoothmouse == 0);
 					}
-				}
-#ifdef USE_EOS
-				current_y += 16;
-				if ( omousey >= current_y && omousey < current_y + 12 )
-				{
-					/*tooltip_box.w = longestline(language[3148]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3148]);*/
-					if ( inputs.bMouseLeft(clientnum) )
+					if ( omousey >= suby1 + 156 && omousey < suby1 + 168 )
 					{
 						inputs.mouseClearLeft(clientnum);
-						LobbyHandler.settings_crossplayEnabled = !LobbyHandler.settings_crossplayEnabled;
+						settings_disablemouserotationlimit = (settings_disablemouserotationlimit == 0);
 					}
 				}
-#endif
-#endif // STEAMWORKS
+			}
+		}
 
+		//Gamepad tab
+		if (settings_tab == SETTINGS_GAMEPAD_BINDINGS_TAB)
+		{
+			SDL_Rect startPos;
+			startPos.x = subx1 + 24;
+			startPos.y = suby1 + 60;
+			SDL_Rect currentPos = startPos;
+			ttfPrintText(ttf8, currentPos.x, currentPos.y, language[1996]);
+			currentPos.y += 24;
 
-				current_y = options_start_y;
+			bool rebindingaction = false;
+			if (rebindaction != -1)
+			{
+				rebindingaction = true;
+			}
 
-				if ( omousey >= current_y && omousey < current_y + 12 ) // ip broadcast
-				{
-					tooltip_box.w = longestline(language[3149]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3149]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // no hud
-				{
-					tooltip_box.w = longestline(language[3150]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3150]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // auto add to hotbar
-				{
-					tooltip_box.w = longestline(language[3151]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3151]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // auto appraisal
-				{
-					tooltip_box.w = longestline(language[3152]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3152]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // no messages
-				{
-					tooltip_box.w = longestline(language[3153]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3153]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // right click protect
-				{
-					tooltip_box.w = longestline(language[3154]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3154]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // numkey hotbar
-				{
-					tooltip_box.w = longestline(language[3155]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 3 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3155]);
-				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // lock ride sidebar
+			//Print out the bi-functional bindings.
+			for ( int c = 0; c < INDEX_JOYBINDINGS_START_MENU; ++c, currentPos.y += 12 )
+			{
+				printJoybindingNames(currentPos, c, rebindingaction);
+			}
+
+			//Print out the menu-exclusive bindings.
+			currentPos.y += 12;
+			drawLine(subx1 + 24, currentPos.y - 6, subx2 - 24, currentPos.y - 6, uint32ColorGray(*mainsurface), 255);
+			ttfPrintText(ttf8, currentPos.x, currentPos.y, language[1994]);
+			currentPos.y += 18;
+			for ( c = INDEX_JOYBINDINGS_START_MENU; c < INDEX_JOYBINDINGS_START_GAME; ++c, currentPos.y += 12 )
+			{
+				printJoybindingNames(currentPos, c, rebindingaction);
+			}
+
+			//Print out the game-exclusive bindings.
+			currentPos.y += 12;
+			drawLine(subx1 + 24, currentPos.y - 6, subx2 - 24, currentPos.y - 6, uint32ColorGray(*mainsurface), 255);
+			ttfPrintText(ttf8, currentPos.x, currentPos.y, language[1995]);
+			currentPos.y += 18;
+			for ( c = INDEX_JOYBINDINGS_START_GAME; c < NUM_JOY_IMPULSES; ++c, currentPos.y += 12 )
+			{
+				printJoybindingNames(currentPos, c, rebindingaction);
+			}
+
+			if (rebindaction != -1 && lastkeypressed)
+			{
+
+				if (lastkeypressed >= 299)   /* Is a joybutton. */
 				{
-					tooltip_box.w = longestline(language[3156]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 3 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3156]);
+					settings_joyimpulses[rebindaction] = lastkeypressed;
+					*inputPressed(lastkeypressed) = 0; //To prevent bugs where the button will still be treated as pressed after assigning it, potentially doing wonky things.
+					rebindaction = -1;
 				}
-				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // show timer always
+				else
 				{
-					tooltip_box.w = longestline(language[3157]) * TTF12_WIDTH + 8;
-					tooltip_box.h = TTF12_HEIGHT * 3 + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3157]);
+					if (lastkeypressed == SDL_SCANCODE_ESCAPE)
+					{
+						keystatus[SDL_SCANCODE_ESCAPE] = 0;
+					}
+					lastkeypressed = 0;
+					rebindaction = -1;
 				}
 			}
 		}
-	}
 
-	// achievements window
-	if ( subwindow && achievements_window )
-	{
-		if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
-		{
-			mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
-			buttonAchievementsDown(nullptr);
-		}
-		if ( mousestatus[SDL_BUTTON_WHEELUP] )
+		//General gamepad settings
+		if (settings_tab == SETTINGS_GAMEPAD_SETTINGS_TAB)
 		{
-			mousestatus[SDL_BUTTON_WHEELUP] = 0;
-			buttonAchievementsUp(nullptr);
-		}
+			int current_option_x = subx1 + 24;
+			int current_option_y = suby1 + 60;
 
-		char page_str[128];
-		int num_achievements = achievementNames.size();
-		if ( num_achievements > 0 )
-		{
-			int num_unlocked = 0;
-			int num_locked_and_hidden = 0;
-			int num_displayed = num_achievements;
-			for (auto& item : achievementNames)
+			//Checkboxes.
+			if (settings_gamepad_leftx_invert)
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2401]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2401]);
+			}
+
+			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			{
+				inputs.mouseClearLeft(clientnum);
+				settings_gamepad_leftx_invert = !settings_gamepad_leftx_invert;
+			}
+
+			current_option_y += 24;
+
+			if (settings_gamepad_lefty_invert)
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2402]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2402]);
+			}
+
+			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			{
+				inputs.mouseClearLeft(clientnum);
+				settings_gamepad_lefty_invert = !settings_gamepad_lefty_invert;
+			}
+
+			current_option_y += 24;
+
+			if (settings_gamepad_rightx_invert)
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2403]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2403]);
+			}
+
+			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			{
+				inputs.mouseClearLeft(clientnum);
+				settings_gamepad_rightx_invert = !settings_gamepad_rightx_invert;
+			}
+
+			current_option_y += 24;
+
+			if (settings_gamepad_righty_invert)
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2404]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2404]);
+			}
+
+			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
+			{
+				inputs.mouseClearLeft(clientnum);
+				settings_gamepad_righty_invert = !settings_gamepad_righty_invert;
+			}
+
+			current_option_y += 24;
+
+			if (settings_gamepad_menux_invert)
 			{
-				if (achievementUnlocked(item.first.c_str()))
-				{
-					++num_unlocked;
-				}
-				else if ( achievementHidden.find(item.first.c_str()) != achievementHidden.end() )
-				{
-					++num_locked_and_hidden;
-					--num_displayed;
-				}
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2405]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2405]);
 			}
 
-			if ( num_locked_and_hidden > 0 )
+			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
 			{
-				++num_displayed; // add 1 hidden entry.
+				inputs.mouseClearLeft(clientnum);
+				settings_gamepad_menux_invert = !settings_gamepad_menux_invert;
 			}
 
-			int max_pages = num_displayed / 6 + ((num_displayed % 6) ? 1 : 0);
-			achievements_window_page = std::min(achievements_window_page, max_pages);
+			current_option_y += 24;
 
-			snprintf(page_str, sizeof(page_str), "Page %d / %d\n\nUnlocked %d / %d achievements (%d%%)",
-				achievements_window_page, max_pages, num_unlocked, num_achievements, (num_unlocked * 100) / num_achievements);
-			ttfPrintText(ttf12, subx1 + 8, suby1 + 30, page_str);
+			if (settings_gamepad_menuy_invert)
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[x] %s", language[2406]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, current_option_x, current_option_y, "[ ] %s", language[2406]);
+			}
 
-			int first_ach = (achievements_window_page - 1) * 6;
-			// list achievement images
-			int index = 0;
-			bool bFirstHiddenAchievement = true;
-			for (auto& item : achievementNamesSorted)
+			if (inputs.bMouseLeft(clientnum) && mouseInBounds(clientnum, current_option_x, current_option_x + strlen("[x]")*TTF12_WIDTH, current_option_y, current_option_y + TTF12_HEIGHT))
 			{
-				bool hiddenAchievement = (achievementHidden.find(item.first) != achievementHidden.end());
-				bool unlocked = achievementUnlocked(item.first.c_str());
-				if ( index < first_ach )
-				{
-					++index; continue;
-				}
-				if ( hiddenAchievement )
-				{
-					if ( !bFirstHiddenAchievement )
-					{
-						continue;
-					}
-					bFirstHiddenAchievement = false;
-				}
+				inputs.mouseClearLeft(clientnum);
+				settings_gamepad_menuy_invert = !settings_gamepad_menuy_invert;
+			}
 
-				const int iconAreaWidth = 12 + 64 + 12;
+			current_option_y += 24;
 
-				SDL_Rect bodyBox;
-				bodyBox.x = subx1 + 4 + iconAreaWidth;
-				bodyBox.y = suby1 + 80 + 4 + (index - first_ach) * 80;
-				bodyBox.w = subx2 - subx1 - 30 - 8 - iconAreaWidth;
-				bodyBox.h = 80 - 8;
-				drawWindowFancy(bodyBox.x, bodyBox.y, bodyBox.x + bodyBox.w, bodyBox.y + bodyBox.h);
+			ttfPrintText(ttf12, current_option_x, current_option_y, language[2407]);
+			current_option_y += 24;
+			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_rightx_sensitivity, font8x8_bmp, 12); //Doesn't like any fonts besides the default.
+			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_rightx_sensitivity);
 
-				SDL_Rect iconBox;
-				iconBox.x = subx1 + 4;
-				iconBox.y = bodyBox.y;
-				iconBox.w = iconAreaWidth;
-				iconBox.h = bodyBox.h;
-				drawWindowFancy(iconBox.x, iconBox.y, iconBox.x + iconBox.w, iconBox.y + iconBox.h);
+			current_option_y += 24;
 
-				SDL_Rect bodyHighlight;
-				bodyHighlight.x = bodyBox.x + 2;
-				bodyHighlight.y = bodyBox.y + 2;
-				bodyHighlight.w = bodyBox.w - 4;
-				bodyHighlight.h = bodyBox.h - 4;
+			ttfPrintText(ttf12, current_option_x, current_option_y, language[2408]);
+			current_option_y += 24;
+			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_righty_sensitivity, font8x8_bmp, 12);
+			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_righty_sensitivity);
 
-				SDL_Rect iconHighlight;
-				iconHighlight.x = iconBox.x + 2;
-				iconHighlight.y = iconBox.y + 2;
-				iconHighlight.w = iconBox.w - 4;
-				iconHighlight.h = iconBox.h - 4;
+			current_option_y += 24;
 
-				if ( achievementUnlocked(item.first.c_str()) )
-				{
-					drawRect(&bodyHighlight, uint32ColorBaronyBlue(*mainsurface), 64);
-					drawRect(&iconHighlight, SDL_MapRGB(mainsurface->format, 1, 0, 16), 255);
-				}
-				else
-				{
-					drawRect(&bodyHighlight, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
-					drawRect(&iconHighlight, SDL_MapRGB(mainsurface->format, 36, 36, 36), 255);
-				}
+			ttfPrintText(ttf12, current_option_x, current_option_y, language[2409]);
+			current_option_y += 24;
+			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_menux_sensitivity, font8x8_bmp, 12);
+			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_menux_sensitivity);
 
-				// draw name
-				Uint32 nameColor = unlocked ? SDL_MapRGB(mainsurface->format, 0, 255, 255) : SDL_MapRGB(mainsurface->format, 128, 128, 128);
-				if ( hiddenAchievement && !unlocked )
-				{
-					ttfPrintTextColor(ttf12, subx1 + 100, suby1 + 92 + (index - first_ach) * 80, nameColor, true, "Hidden Achievements");
-				}
-				else
-				{
-					ttfPrintTextColor(ttf12, subx1 + 100, suby1 + 92 + (index - first_ach) * 80, nameColor, true, item.second.c_str());
-				}
+			current_option_y += 24;
 
-				// draw description
-				if ( !(hiddenAchievement && !unlocked) )
+			ttfPrintText(ttf12, current_option_x, current_option_y, language[2410]);
+			current_option_y += 24;
+			//doSlider(current_option_x, current_option_y, 11, 1, 2000, 200, &settings_gamepad_menuy_sensitivity, font8x8_bmp, 12);
+			doSlider(current_option_x, current_option_y, 11, 1, 4096, 100, &settings_gamepad_menuy_sensitivity);
+		}
+
+		// miscellaneous options
+		if (settings_tab == SETTINGS_MISC_TAB)
+		{
+			int current_x = subx1;
+			int current_y = suby1 + 60;
+
+			ttfPrintText(ttf12, subx1 + 24, current_y, language[1371]);
+			current_y += 24;
+
+			int options_start_y = current_y;
+			if ( settings_broadcast )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1372]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1372]);
+			}
+			current_y += 16;
+			if ( settings_nohud )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1373]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1373]);
+			}
+			current_y += 16;
+			int hotbar_options_x = subx1 + 72 + 256;
+			int hotbar_options_y = current_y;
+			if ( settings_auto_hotbar_new_items )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1374]);
+				int pad_x = hotbar_options_x;
+				int pad_y = hotbar_options_y;
+				drawWindowFancy(pad_x - 16, pad_y - 32, pad_x + 4 * 128 + 16, pad_y + 48 + 16);
+				ttfPrintTextFormatted(ttf12, pad_x, current_y - 16, "%s", language[2583]);
+				for ( int i = 0; i < (NUM_HOTBAR_CATEGORIES); ++i )
 				{
-					auto it = achievementDesc.find(item.first);
-					if ( it != achievementDesc.end() )
+					if ( settings_auto_hotbar_categories[i] == true )
 					{
-						auto item = *it;
-						std::string sub = item.second.length() > 140 ? item.second.substr(0, 140) + "..." : item.second;
-						for ( size_t c, offset = 0;;)
-						{
-							size_t lastoffset = offset;
-							for ( c = lastoffset + 1; c < sub.size(); ++c )
-							{
-								if ( sub[c] == ' ' )
-								{
-									break;
-								}
-							}
-							offset = c;
-							if ( offset > 70 && lastoffset )
-							{
-								sub[lastoffset] = '\n';
-								break;
-							}
-							if ( offset >= sub.size() )
-							{
-								break;
-							}
-						}
-						ttfPrintText(ttf12, subx1 + 100, suby1 + 120 + (index - first_ach) * 80, sub.c_str());
+						ttfPrintTextFormatted(ttf12, pad_x, pad_y, "[x] %s", language[2571 + i]);
 					}
-				}
-				else if ( hiddenAchievement && !unlocked )
-				{
-					ttfPrintTextFormatted(ttf12, subx1 + 100, suby1 + 120 + (index - first_ach) * 80, 
-						"+%d hidden achievements remain...", num_locked_and_hidden);
-				}
-
-				// draw progress
-				if ( !unlocked )
-				{
-					auto it = achievementProgress.find(item.first);
-					if ( it != achievementProgress.end() )
+					else
 					{
-						int maxValue = steamStatAchStringsAndMaxVals[it->second].second;
-						int currentValue = g_SteamStats[it->second].m_iValue;
-						int percent = (int)floor(currentValue * 100 / static_cast<double>(maxValue));
-						//char percent_str[32] = { 0 };
-						// snprintf(percent_str, sizeof(percent_str), "%3d%% complete", percent);
-						// ttfPrintTextColor(ttf12, subx2 - 330, suby1 + 92 + (index - first_ach) * 80, uint32ColorWhite(*mainsurface), true, percent_str);
-
-						SDL_Rect progressbar;
-						progressbar.x = subx2 - 330 + (4 * TTF12_WIDTH) + TTF12_WIDTH;
-						progressbar.y = suby1 + 92 + (index - first_ach) * 80 - 4;
-						progressbar.h = TTF12_HEIGHT + 2;
-						progressbar.w = (bodyBox.x + bodyBox.w) - progressbar.x - 4;
-						drawWindowFancy(progressbar.x - 2, progressbar.y - 2, progressbar.x + progressbar.w + 2, progressbar.y + progressbar.h + 2);
-
-						drawRect(&progressbar, SDL_MapRGB(mainsurface->format, 36, 36, 36), 255);
-						progressbar.w = std::min((bodyBox.x + bodyBox.w) - progressbar.x - 4, static_cast<int>(progressbar.w * percent / 100.0));
-						drawRect(&progressbar, uint32ColorBaronyBlue(*mainsurface), 92);
-						progressbar.w = (bodyBox.x + bodyBox.w) - progressbar.x - TTF12_WIDTH;
-
-						char progress_str[32] = { 0 };
-						snprintf(progress_str, sizeof(progress_str), "%d / %d", currentValue, maxValue);
-						ttfPrintTextColor(ttf12, progressbar.x + progressbar.w / 2 - (strlen(progress_str) * TTF12_WIDTH) / 2,
-							suby1 + 92 + (index - first_ach) * 80, uint32ColorWhite(*mainsurface), true, progress_str);
+						ttfPrintTextFormatted(ttf12, pad_x, pad_y, "[ ] %s", language[2571 + i]);
+					}
+					pad_x += 128;
+					if ( i == 3 || i == 7 )
+					{
+						pad_x = hotbar_options_x;
+						pad_y += 16;
 					}
 				}
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1374]);
+			}
 
-				// draw unlock time
-				if ( unlocked )
+			// autosort inventory categories
+			int autosort_options_x = subx1 + 72 + 256;
+			int autosort_options_y = current_y + 112;
+			int pad_x = autosort_options_x;
+			int pad_y = autosort_options_y;
+			drawWindowFancy(pad_x - 16, pad_y - 32, pad_x + 4 * 128 + 16, pad_y + 48 + 16);
+			ttfPrintTextFormatted(ttf12, pad_x, current_y - 16 + 112, "%s", language[2912]);
+
+			// draw the values for autosort
+			for ( int i = 0; i < (NUM_AUTOSORT_CATEGORIES); ++i )
+			{
+				ttfPrintTextFormatted(ttf12, pad_x, pad_y, "<");
+				Uint32 autosortColor = uint32ColorGreen(*mainsurface);
+				int padValue_x = pad_x;
+				if ( settings_autosort_inventory_categories[i] < 0 )
+				{
+					autosortColor = uint32ColorRed(*mainsurface);
+					padValue_x += 4; // centre the negative numbers.
+				}
+				else if ( settings_autosort_inventory_categories[i] == 0 )
 				{
-					auto it = achievementUnlockTime.find(item.first);
-					if ( it != achievementUnlockTime.end() )
-					{
-						char buffer[64];
-						time_t t = (time_t)it->second;
-						struct tm* tm_info = localtime(&t);
-						strftime(buffer, sizeof(buffer), "Unlocked %Y/%m/%d at %H:%M:%S", tm_info);
-
-						char text[64];
-						snprintf(text, sizeof(text), "%32s", buffer);
-						ttfPrintTextColor(ttf12, subx2 - 330, suby1 + 92 + (index - first_ach) * 80, uint32ColorYellow(*mainsurface), true, text);
-					}
+					autosortColor = uint32ColorWhite(*mainsurface);
 				}
-
-				// draw image
-				std::string img = unlocked ? item.first + ".png" : item.first + "_l.png";
-				if ( !unlocked && hiddenAchievement )
+				ttfPrintTextFormattedColor(ttf12, padValue_x, pad_y, autosortColor, " %2d", settings_autosort_inventory_categories[i]);
+				if ( i == NUM_AUTOSORT_CATEGORIES - 1 )
 				{
-					img = "LOCKED_ACHIEVEMENT.png";
+					ttfPrintTextFormatted(ttf12, pad_x, pad_y, "    > %s", language[2916]);
 				}
-				auto it = achievementImages.find(img);
-				if ( it != achievementImages.end() )
+				else
 				{
-					SDL_Rect rect;
-					rect.x = subx1 + 16;
-					rect.y = suby1 + 88 + (index - first_ach) * 80;
-					rect.w = 64;
-					rect.h = 64;
-					drawImage((*it).second, NULL, &rect);
+					ttfPrintTextFormatted(ttf12, pad_x, pad_y, "    > %s", language[2571 + i]);
 				}
-
-				++index;
-				if (index >= first_ach + 6)
+				pad_x += 128;
+				if ( i == 3 || i == 7 )
 				{
-					break;
+					pad_x = autosort_options_x;
+					pad_y += 16;
 				}
 			}
-		}
-		else
-		{
-			ttfPrintText(ttf12, subx1 + 8, suby1 + 100, language[709]);
-		}
-	}
 
-	// connect window
-	if ( connect_window )
-	{
-		if ( connect_window == SERVER )
-		{
-			drawDepressed(subx1 + 8, suby1 + 40, subx2 - 8, suby1 + 64);
-			ttfPrintText(ttf12, subx1 + 12, suby1 + 46, portnumber_char);
+			pad_x = autosort_options_x + (strlen(language[2912]) - 3) * (TTF12_WIDTH) + 8; // 3 chars from the end of string.
+			pad_y = autosort_options_y;
+			// hover text for autosort title text
+			if ( mouseInBounds(clientnum, pad_x - 4, pad_x + 3 * TTF12_WIDTH + 8, current_y - 16 + 112, current_y - 16 + 124) )
+			{
+				tooltip_box.x = omousex - TTF12_WIDTH * 32;
+				tooltip_box.y = omousey - (TTF12_HEIGHT * 3 + 16);
+				tooltip_box.w = strlen(language[2914]) * TTF12_WIDTH + 8;
+				tooltip_box.h = TTF12_HEIGHT * 3 + 8;
+				drawTooltip(&tooltip_box);
+				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[2913]);
+				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4 + TTF12_HEIGHT, language[2914]);
+				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4 + TTF12_HEIGHT * 2, language[2915]);
+			}
 
-			// enter port number
-			if ( !SDL_IsTextInputActive() )
+			current_y += 16;
+			if ( settings_auto_appraise_new_items )
 			{
-				SDL_StartTextInput(); //TODO: NX PORT: Why is the order different in some of these chunks? For example, some of them start text input first, others start it after the below chunk of code.
-				if (inputstr != portnumber_char)
-				{
-					inputstr = portnumber_char;
-#ifdef NINTENDO
-					auto result = nxKeyboard("Enter port number");
-					if (result.success)
-					{
-						strncpy(inputstr, result.str.c_str(), 21);
-						inputstr[21] = '\0'; //TODO: NX PORT: Why 21? inputlen = 5 down there, shouldn't this be inputstr[4]?
-					}
-#endif
-				}
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1997]);
 			}
-			//strncpy(portnumber_char,inputstr,5);
-			inputlen = 5;
-			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+			else
 			{
-				int x;
-				getSizeOfText(ttf12, portnumber_char, &x, NULL);
-				ttfPrintText(ttf12, subx1 + 12 + x, suby1 + 46, "_");
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1997]);
 			}
-		}
-		else if ( connect_window == CLIENT )
-		{
-			drawDepressed(subx1 + 8, suby1 + 40, subx2 - 8, suby1 + 64);
-			if ( !broadcast )
+			current_y += 16;
+			if ( settings_disable_messages )
 			{
-				ttfPrintText(ttf12, subx1 + 12, suby1 + 46, connectaddress);
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1536]);
 			}
 			else
 			{
-				int i;
-				for ( i = 0; i < strlen(connectaddress); i++ )
-				{
-					ttfPrintText(ttf12, subx1 + 12 + 12 * i, suby1 + 46, "*");
-				}
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1536]);
+			}
+			current_y += 16;
+			if ( settings_right_click_protect )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[1998]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[1998]);
+			}
+			current_y += 16;
+			if ( settings_hotbar_numkey_quick_add )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[2590]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[2590]);
 			}
+			current_y += 16;
+			if ( settings_lock_right_sidebar )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[2598]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[2598]);
+			}
+			current_y += 16;
+			if ( settings_show_game_timer_always )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[2983]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[2983]);
+			}
+			current_y += 32;
 
-			// enter address
-			if ( !SDL_IsTextInputActive() )
+			// server flag elements
+			ttfPrintText(ttf12, subx1 + 24, current_y, language[1375]);
+			current_y += 24;
+
+
+			int server_flags_start_y = current_y;
+			for ( int i = 0; i < NUM_SERVER_FLAGS; i++, current_y += 16 )
 			{
-				SDL_StartTextInput();
+				char flagStringBuffer[512] = "";
+				if ( i < 5 )
+				{
+					strncpy(flagStringBuffer, language[153 + i], 255);
+				}
+				else
+				{
+					strncpy(flagStringBuffer, language[2917 - 5 + i], 255);
+				}
 
-				if (inputstr != connectaddress)
+				bool flagEnabled = settings_svFlags & power(2, i);
+				if ( multiplayer == CLIENT )
 				{
-					inputstr = connectaddress;
-#ifdef NINTENDO
-					auto result = nxKeyboard("Enter address");
-					if (result.success)
+					flagEnabled = svFlags & power(2, i); // clients get the data from the server and don't cache it
+				}
+
+				if ( flagEnabled )
+				{
+					ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", flagStringBuffer);
+				}
+				else
+				{
+					ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", flagStringBuffer);
+				}
+				if (mouseInBounds(clientnum, subx1 + 36 + 6, subx1 + 36 + 24 + 6, current_y, current_y + 12))   //So many gosh dang magic numbers ._.
+				{
+					if ( i < 5 )
 					{
-						strncpy(inputstr, result.str.c_str(), 21);
-						inputstr[21] = '\0'; //TODO: NX PORT: Why not inputstr[30], since inputlen = 31?
+						strncpy(flagStringBuffer, language[1942 + i], 255);
+					}
+					else
+					{
+						strncpy(flagStringBuffer, language[2921 - 5 + i], 255);
+					}
+					if (strlen(flagStringBuffer) > 0)   //Don't bother drawing a tooltip if the file doesn't say anything.
+					{
+						hovering_selection = i;
+#if (!defined STEAMWORKS && !defined USE_EOS)
+						if ( hovering_selection == 0 )
+						{
+							hovering_selection = -1; // don't show cheats tooltip about disabling achievements.
+						}
+#endif // STEAMWORKS
+						tooltip_box.x = omousex + 16;
+						tooltip_box.y = omousey + 8; //I hate magic numbers :|. These should probably be replaced with omousex + mousecursorsprite->width, omousey + mousecursorsprite->height, respectively.
+						if ( i == 2 || i == 3 || i == 5 || i == 6 || i == 7 )
+						{
+							tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+						}
+						else if ( i == 4 || i == 8 )
+						{
+							tooltip_box.h = TTF12_HEIGHT * 3 + 8;
+						}
+						else
+						{
+							tooltip_box.h = TTF12_HEIGHT + 8;
+						}
+						if ( gameModeManager.isServerflagDisabledForCurrentMode(i) )
+						{
+							strcat(flagStringBuffer, language[3962]); // changing flags disabled.
+							tooltip_box.h += TTF12_HEIGHT;
+						}
+						tooltip_box.w = longestline(flagStringBuffer) * TTF12_WIDTH + 8; //MORE MAGIC NUMBERS. HNNGH. I can guess what they all do, but dang.
 					}
-#endif
 				}
 			}
-			//strncpy(connectaddress,inputstr,31);
-			inputlen = 31;
-			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+
+			// network options
+			current_y += 32;
+			ttfPrintText(ttf12, subx1 + 24, current_y, language[3146]);
+			current_y += 24;
+			int networking_options_start_y = current_y;
+			if ( settings_disableFPSLimitOnNetworkMessages )
 			{
-				int x;
-				getSizeOfText(ttf12, connectaddress, &x, NULL);
-				ttfPrintText(ttf12, subx1 + 12 + x, suby1 + 46, "_");
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", "disable netcode FPS optimization");
 			}
-		}
-	}
-
-	// communicating with clients
-	if ( multiplayer == SERVER && mode )
-	{
-		//void *newSteamID = NULL; //TODO: Bugger void pointers!
-#ifdef STEAMWORKS
-		CSteamID newSteamID;
-#endif
-#if defined USE_EOS
-		EOS_ProductUserId newRemoteProductId = nullptr;
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", "disable netcode FPS optimization");
+			}
+			current_y += 16;
+#ifdef STEAMWORKS
+			if ( settings_disableMultithreadedSteamNetworking )
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[x] %s", language[3147]);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[ ] %s", language[3147]);
+			}
+#ifdef USE_EOS
+			current_y += 16;
+			ttfPrintTextFormatted(ttf12, subx1 + 36, current_y, "[%c] %s", LobbyHandler.settings_crossplayEnabled ? 'x' : ' ', language[3948]);
 #endif
+#endif // STEAMWORKS
 
-		// hosting the lobby
-		int numpacket;
-		for ( numpacket = 0; numpacket < PACKET_LIMIT; numpacket++ )
-		{
-			if ( directConnect )
+			if (hovering_selection > -1)
 			{
-				if ( !SDLNet_UDP_Recv(net_sock, net_packet) )
+				drawTooltip(&tooltip_box);
+				if (hovering_selection < NUM_SERVER_FLAGS)
 				{
-					break;
+					char flagStringBuffer[512] = "";
+					if ( hovering_selection < 5 )
+					{
+						strncpy(flagStringBuffer, language[1942 + hovering_selection], 255);
+					}
+					else
+					{
+						strncpy(flagStringBuffer, language[2921 - 5 + hovering_selection], 255);
+					}
+					if ( gameModeManager.isServerflagDisabledForCurrentMode(hovering_selection) )
+					{
+						strcat(flagStringBuffer, language[3962]); // changing flags disabled.
+					}
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, flagStringBuffer);
 				}
 			}
-			else
+
+			current_y = options_start_y;
+
+			if ( inputs.bMouseLeft(clientnum) )
 			{
-				if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+				if ( omousex >= subx1 + 42 && omousex < subx1 + 66 )
 				{
-#ifdef STEAMWORKS
-					uint32_t packetlen = 0;
-					if ( !SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
+					if ( omousey >= current_y && omousey < current_y + 12 )
 					{
-						break;
+						inputs.mouseClearLeft(clientnum);
+						settings_broadcast = (settings_broadcast == false);
 					}
-					packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
-					/*if ( newSteamID ) {
-						cpp_Free_CSteamID( newSteamID );
-						newSteamID = NULL;
-					}*/
-					//newSteamID = c_AllocateNew_CSteamID();
-					Uint32 bytesRead = 0;
-					if ( !SteamNetworking()->ReadP2PPacket(net_packet->data, packetlen, &bytesRead, &newSteamID, 0) )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-						continue;
+						inputs.mouseClearLeft(clientnum);
+						settings_nohud = (settings_nohud == false);
 					}
-					net_packet->len = packetlen;
-					if ( packetlen < sizeof(DWORD) )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-						continue;    // junk packet, skip //TODO: Investigate the cause of this. During earlier testing, we were getting bombarded with untold numbers of these malformed packets, as if the entire steam network were being routed through this game.
+						inputs.mouseClearLeft(clientnum);
+						settings_auto_hotbar_new_items = (settings_auto_hotbar_new_items == false);
 					}
-
-					CSteamID mySteamID = SteamUser()->GetSteamID();
-					if ( mySteamID.ConvertToUint64() == newSteamID.ConvertToUint64() )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-						continue;
+						inputs.mouseClearLeft(clientnum);
+						settings_auto_appraise_new_items = (settings_auto_appraise_new_items == false);
 					}
-#endif
-				}
-				else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-				{
-#if defined USE_EOS
-					if ( !EOS.HandleReceivedMessages(&newRemoteProductId) )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-						continue;
+						inputs.mouseClearLeft(clientnum);
+						settings_disable_messages = (settings_disable_messages == false);
 					}
-					EOS.P2PConnectionInfo.insertProductIdIntoPeers(newRemoteProductId);
-#endif // USE_EOS
-				}
-			}
-
-			if ( handleSafePacket() )
-			{
-				continue;
-			}
-			if (!strncmp((char*)net_packet->data, "BARONY_JOIN_REQUEST", 19))
-			{
-				int playerNum = MAXPLAYERS;
-				if ( !directConnect )
-				{
-					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-#ifdef STEAMWORKS
-						bool skipJoin = false;
-						for ( int c = 0; c < MAXPLAYERS; c++ )
-						{
-							if ( client_disconnected[c] || !steamIDRemote[c] )
-							{
-								continue;
-							}
-							if ( newSteamID.ConvertToUint64() == (static_cast<CSteamID*>(steamIDRemote[c]))->ConvertToUint64() )
-							{
-								// we've already accepted this player. NEXT!
-								skipJoin = true;
-								break;
-							}
-						}
-						if ( skipJoin )
-						{
-							continue;
-						}
-#endif
+						inputs.mouseClearLeft(clientnum);
+						settings_right_click_protect = (settings_right_click_protect == false);
 					}
-					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-#if defined USE_EOS
-						bool skipJoin = false;
-						/*for ( c = 0; c < MAXPLAYERS; c++ )
-						{
-							if ( client_disconnected[c] )
-							{
-								continue;
-							}
-						}*/
-						EOSFuncs::logInfo("newRemoteProductId: %s", EOSFuncs::Helpers_t::productIdToString(newRemoteProductId));
-						if ( newRemoteProductId && EOS.P2PConnectionInfo.isPeerIndexed(newRemoteProductId) )
-						{
-							if ( EOS.P2PConnectionInfo.getIndexFromPeerId(newRemoteProductId) >= 0 )
-							{
-								// we've already accepted this player. NEXT!
-								skipJoin = true;
-							}
-						}
-						if ( skipJoin )
-						{
-							continue;
-						}
-#endif // USE_EOS
+						inputs.mouseClearLeft(clientnum);
+						settings_hotbar_numkey_quick_add = (settings_hotbar_numkey_quick_add == false);
 					}
-				}
-				NetworkingLobbyJoinRequestResult result = lobbyPlayerJoinRequest(playerNum);
-				if ( result == NetworkingLobbyJoinRequestResult::NET_LOBBY_JOIN_P2P_FAILURE )
-				{
-					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-#ifdef STEAMWORKS
-						for ( int responses = 0; responses < 5; ++responses )
-						{
-							SteamNetworking()->SendP2PPacket(newSteamID, net_packet->data, net_packet->len, k_EP2PSendReliable, 0);
-							SDL_Delay(5);
-						}
-#endif
+						inputs.mouseClearLeft(clientnum);
+						settings_lock_right_sidebar = (settings_lock_right_sidebar == false);
 					}
-					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					else if ( omousey >= (current_y += 16) && omousey < current_y + 12 )
 					{
-#if defined USE_EOS
-						for ( int responses = 0; responses < 5; ++responses )
-						{
-							EOS.SendMessageP2P(newRemoteProductId, net_packet->data, net_packet->len);
-							SDL_Delay(5);
-						}
-#endif
+						inputs.mouseClearLeft(clientnum);
+						settings_show_game_timer_always = (settings_show_game_timer_always == false);
 					}
 				}
-				else if ( result == NetworkingLobbyJoinRequestResult::NET_LOBBY_JOIN_P2P_SUCCESS )
+				else
 				{
-					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					if ( settings_auto_hotbar_new_items )
 					{
-#ifdef STEAMWORKS
-						if ( steamIDRemote[playerNum - 1] )
-						{
-							cpp_Free_CSteamID(steamIDRemote[playerNum - 1]);
-						}
-						steamIDRemote[playerNum - 1] = new CSteamID();
-						*static_cast<CSteamID*>(steamIDRemote[playerNum - 1]) = newSteamID;
-						for ( int responses = 0; responses < 5; ++responses )
+						if ( inputs.bMouseLeft(clientnum) )
 						{
-							SteamNetworking()->SendP2PPacket(*static_cast<CSteamID* >(steamIDRemote[playerNum - 1]), net_packet->data, net_packet->len, k_EP2PSendReliable, 0);
-							SDL_Delay(5);
+							for ( int i = 0; i < NUM_HOTBAR_CATEGORIES; ++i )
+							{
+								if ( mouseInBounds(clientnum, hotbar_options_x, hotbar_options_x + 24, hotbar_options_y, hotbar_options_y + 12) )
+								{
+									settings_auto_hotbar_categories[i] = !settings_auto_hotbar_categories[i];
+									inputs.mouseClearLeft(clientnum);
+								}
+								hotbar_options_x += 128;
+								if ( i == 3 || i == 7 )
+								{
+									hotbar_options_x -= (128 * 4);
+									hotbar_options_y += 16;
+								}
+							}
 						}
-#endif
 					}
-					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+
+					// autosort category toggles
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-#if defined USE_EOS
-						EOS.P2PConnectionInfo.assignPeerIndex(newRemoteProductId, playerNum - 1);
-						for ( int responses = 0; responses < 5; ++responses )
+						for ( int i = 0; i < NUM_AUTOSORT_CATEGORIES; ++i )
 						{
-							EOS.SendMessageP2P(EOS.P2PConnectionInfo.getPeerIdFromIndex(playerNum - 1), net_packet->data, net_packet->len);
-							SDL_Delay(5);
+							if ( mouseInBounds(clientnum, autosort_options_x, autosort_options_x + 16, autosort_options_y, autosort_options_y + 12) )
+							{
+								--settings_autosort_inventory_categories[i];
+								if ( settings_autosort_inventory_categories[i] < -9 )
+								{
+									settings_autosort_inventory_categories[i] = 9;
+								}
+								inputs.mouseClearLeft(clientnum);
+							}
+							else if ( mouseInBounds(clientnum, autosort_options_x + 36, autosort_options_x + 52, autosort_options_y, autosort_options_y + 12) )
+							{
+								++settings_autosort_inventory_categories[i];
+								if ( settings_autosort_inventory_categories[i] > 9 )
+								{
+									settings_autosort_inventory_categories[i] = -9;
+								}
+								inputs.mouseClearLeft(clientnum);
+							}
+							autosort_options_x += 128;
+							if ( i == 3 || i == 7 )
+							{
+								autosort_options_x -= (128 * 4);
+								autosort_options_y += 16;
+							}
 						}
-#endif
-					}
-				}
-				continue;
-			}
-
-			// got a chat message
-			else if (!strncmp((char*)net_packet->data, "CMSG", 4))
-			{
-				int i;
-				for ( i = 1; i < MAXPLAYERS; i++ )
-				{
-					if ( client_disconnected[i] )
-					{
-						continue;
 					}
-					net_packet->address.host = net_clients[i - 1].host;
-					net_packet->address.port = net_clients[i - 1].port;
-					sendPacketSafe(net_sock, -1, net_packet, i - 1);
 				}
-				newString(&lobbyChatboxMessages, 0xFFFFFFFF, (char*)(&net_packet->data[4]));
-				playSound(238, 64);
-				continue;
-			}
 
-			// player disconnected
-			else if (!strncmp((char*)net_packet->data, "PLAYERDISCONNECT", 16))
-			{
-				client_disconnected[net_packet->data[16]] = true;
-				for ( int c = 1; c < MAXPLAYERS; c++ )
+				if ( multiplayer != CLIENT )
 				{
-					if ( client_disconnected[c] )
+					current_y = server_flags_start_y;
+					for ( int i = 0; i < NUM_SERVER_FLAGS; i++, current_y += 16 )
 					{
-						continue;
+						if ( !gameModeManager.isServerflagDisabledForCurrentMode(i)
+							&& mouseInBounds(clientnum, subx1 + 36 + 6, subx1 + 36 + 24 + 6, current_y, current_y + 12) )
+						{
+							inputs.mouseClearLeft(clientnum);
+
+							// toggle flag
+							settings_svFlags ^= power(2, i);
+						}
 					}
-					net_packet->address.host = net_clients[c - 1].host;
-					net_packet->address.port = net_clients[c - 1].port;
-					net_packet->len = 17;
-					sendPacketSafe(net_sock, -1, net_packet, c - 1);
 				}
-				char shortname[32] = { 0 };
-				strncpy(shortname, stats[net_packet->data[16]]->name, 22);
-				newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
-				continue;
 			}
 
-			// client requesting new svFlags
-			else if (!strncmp((char*)net_packet->data, "SVFL", 4))
+
+			if ( omousex >= subx1 + 42 && omousex < subx1 + 66 )
 			{
-				// update svFlags for everyone
-				SDLNet_Write32(svFlags, &net_packet->data[4]);
-				net_packet->len = 8;
+				tooltip_box.x = omousex + 16;
+				tooltip_box.y = omousey + 8;
+				tooltip_box.h = TTF12_HEIGHT + 8;
 
-				for ( int c = 1; c < MAXPLAYERS; c++ )
+				// networking hover text and mouse selection
+				current_y = networking_options_start_y;
+				if ( omousey >= current_y && omousey < current_y + 12 )
 				{
-					if ( client_disconnected[c] )
+					//tooltip_box.w = longestline(language[3148]) * TTF12_WIDTH + 8;
+					//tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					//drawTooltip(&tooltip_box);
+					//ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3148]);
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						continue;
+						inputs.mouseClearLeft(clientnum);
+						settings_disableFPSLimitOnNetworkMessages = (settings_disableFPSLimitOnNetworkMessages == false);
 					}
-					net_packet->address.host = net_clients[c - 1].host;
-					net_packet->address.port = net_clients[c - 1].port;
-					sendPacketSafe(net_sock, -1, net_packet, c - 1);
 				}
-				continue;
-			}
-
-			// keepalive
-			else if (!strncmp((char*)net_packet->data, "KEEPALIVE", 9))
-			{
-				client_keepalive[net_packet->data[9]] = ticks;
-				continue; // just a keep alive
-			}
-		}
-	}
-
-	// communicating with server
-	if ( multiplayer == CLIENT && mode )
-	{
-		if ( receivedclientnum == false )
-		{
+				current_y += 16;
 #ifdef STEAMWORKS
-			CSteamID newSteamID;
-			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-			{
-				// waiting on host response.
-				if ( joinLobbyWaitingForHostResponse )
+				if ( omousey >= current_y && omousey < current_y + 12 )
 				{
-					// waiting on host response.
-					if ( ticks - client_keepalive[0] >= 15 * TICKS_PER_SECOND ) // 15 second timeout
+					tooltip_box.w = longestline(language[3148]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3148]);
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						buttonDisconnect(nullptr);
-						openFailedConnectionWindow(CLIENT);
-						strcpy(subtext, LobbyHandler_t::getLobbyJoinFailedConnectString(static_cast<int>(LobbyHandler_t::LOBBY_JOIN_TIMEOUT)).c_str());
-						connectingToLobbyStatus = EResult::k_EResultOK;
+						inputs.mouseClearLeft(clientnum);
+						settings_disableMultithreadedSteamNetworking = true;// (settings_disableMultithreadedSteamNetworking == false);
 					}
 				}
-			}
-#endif
-#if defined USE_EOS
-			EOS_ProductUserId newRemoteProductId = nullptr;
-			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-			{
-				if ( EOS.bJoinLobbyWaitingForHostResponse )
+#ifdef USE_EOS
+				current_y += 16;
+				if ( omousey >= current_y && omousey < current_y + 12 )
 				{
-					// waiting on host response.
-					if ( ticks - client_keepalive[0] >= 15 * TICKS_PER_SECOND ) // 15 second timeout
+					/*tooltip_box.w = longestline(language[3148]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3148]);*/
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						buttonDisconnect(nullptr);
-						openFailedConnectionWindow(CLIENT);
-						strcpy(subtext, LobbyHandler_t::getLobbyJoinFailedConnectString(static_cast<int>(LobbyHandler_t::LOBBY_JOIN_TIMEOUT)).c_str());
-						EOS.ConnectingToLobbyStatus = static_cast<int>(EOS_EResult::EOS_Success);
+						inputs.mouseClearLeft(clientnum);
+						LobbyHandler.settings_crossplayEnabled = !LobbyHandler.settings_crossplayEnabled;
 					}
 				}
-			}
 #endif
+#endif // STEAMWORKS
 
-			// trying to connect to the server and get a player number
-			// receive the packet:
-			bool gotPacket = false;
-			if ( directConnect )
-			{
-				if ( SDLNet_TCP_Recv(net_tcpsock, net_packet->data, 4 + MAXPLAYERS * (5 + 23)) )
+
+				current_y = options_start_y;
+
+				if ( omousey >= current_y && omousey < current_y + 12 ) // ip broadcast
 				{
-					gotPacket = true;
+					tooltip_box.w = longestline(language[3149]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3149]);
 				}
-			}
-			else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-			{
-#ifdef STEAMWORKS
-				for ( Uint32 numpacket = 0; numpacket < PACKET_LIMIT && net_packet; numpacket++ )
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // no hud
 				{
-					Uint32 packetlen = 0;
-					if ( !SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
-					{
-						break;
-					}
-					packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
-					Uint32 bytesRead = 0;
-					if ( !SteamNetworking()->ReadP2PPacket(net_packet->data, packetlen, &bytesRead, &newSteamID, 0) || bytesRead != 4 + MAXPLAYERS * (5 + 23) )
-					{
-						continue;
-					}
-					net_packet->len = packetlen;
-					if ( packetlen < sizeof(DWORD) )
-					{
-						continue;
-					}
-
-					CSteamID mySteamID = SteamUser()->GetSteamID();
-					if ( mySteamID.ConvertToUint64() == newSteamID.ConvertToUint64() )
-					{
-						continue;
-					}
-					if ( (int)net_packet->data[3] < '0'
-						&& (int)net_packet->data[0] == 0
-						&& (int)net_packet->data[1] == 0
-						&& (int)net_packet->data[2] == 0 )
-					{
-						// data encoded with [0 0 0 clientnum] - directly sends an INT, if the character is < '0', then it is non-alphanumeric character.
-						// likely not some other form of data - like an old "GOTP" from a recently closed session.
-						gotPacket = true;
-					}
-					else
-					{
-						continue;
-					}
-					break;
+					tooltip_box.w = longestline(language[3150]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3150]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // auto add to hotbar
+				{
+					tooltip_box.w = longestline(language[3151]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3151]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // auto appraisal
+				{
+					tooltip_box.w = longestline(language[3152]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3152]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // no messages
+				{
+					tooltip_box.w = longestline(language[3153]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3153]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // right click protect
+				{
+					tooltip_box.w = longestline(language[3154]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3154]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // numkey hotbar
+				{
+					tooltip_box.w = longestline(language[3155]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 3 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3155]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // lock ride sidebar
+				{
+					tooltip_box.w = longestline(language[3156]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 3 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3156]);
+				}
+				else if ( omousey >= (current_y += 16) && omousey < current_y + 12 ) // show timer always
+				{
+					tooltip_box.w = longestline(language[3157]) * TTF12_WIDTH + 8;
+					tooltip_box.h = TTF12_HEIGHT * 3 + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, language[3157]);
 				}
-#endif
 			}
-			else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+		}
+	}
+
+	// achievements window
+	if ( subwindow && achievements_window )
+	{
+		if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+		{
+			mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+			buttonAchievementsDown(nullptr);
+		}
+		if ( mousestatus[SDL_BUTTON_WHEELUP] )
+		{
+			mousestatus[SDL_BUTTON_WHEELUP] = 0;
+			buttonAchievementsUp(nullptr);
+		}
+
+		char page_str[128];
+		int num_achievements = achievementNames.size();
+		if ( num_achievements > 0 )
+		{
+			int num_unlocked = 0;
+			int num_locked_and_hidden = 0;
+			int num_displayed = num_achievements;
+			for (auto& item : achievementNames)
 			{
-#ifdef USE_EOS
-				for ( Uint32 numpacket = 0; numpacket < PACKET_LIMIT; numpacket++ )
+				if (achievementUnlocked(item.first.c_str()))
 				{
-					if ( !EOS.HandleReceivedMessages(&newRemoteProductId) )
-					{
-						continue;
-					}
-					if ( (int)net_packet->data[3] < '0' 
-						&& (int)net_packet->data[0] == 0 
-						&& (int)net_packet->data[1] == 0
-						&& (int)net_packet->data[2] == 0 )
-					{
-						// data encoded with [0 0 0 clientnum] - directly sends an INT, if the character is < '0', then it is non-alphanumeric character.
-						// likely not some other form of data - like an old "GOTP" from a recently closed session.
-						gotPacket = true;
-					}
-					else
-					{
-						continue;
-					}
-					break;
+					++num_unlocked;
+				}
+				else if ( achievementHidden.find(item.first.c_str()) != achievementHidden.end() )
+				{
+					++num_locked_and_hidden;
+					--num_displayed;
 				}
-#endif // USE_EOS
 			}
 
-
-			// parse the packet:
-			if ( gotPacket )
+			if ( num_locked_and_hidden > 0 )
 			{
-				list_FreeAll(&button_l);
-				deleteallbuttons = true;
+				++num_displayed; // add 1 hidden entry.
+			}
 
-				//clientnum = (int)SDLNet_Read32(&net_packet->data[0]);
-				clientnum = (int)net_packet->data[3];
-				//printlog("%d %d %d %d", (int)net_packet->data[0], (int)net_packet->data[1], (int)net_packet->data[2], (int)net_packet->data[3]);
+			int max_pages = num_displayed / 6 + ((num_displayed % 6) ? 1 : 0);
+			achievements_window_page = std::min(achievements_window_page, max_pages);
 
-				if ( clientnum >= MAXPLAYERS || clientnum <= 0 )
+			snprintf(page_str, sizeof(page_str), "Page %d / %d\n\nUnlocked %d / %d achievements (%d%%)",
+				achievements_window_page, max_pages, num_unlocked, num_achievements, (num_unlocked * 100) / num_achievements);
+			ttfPrintText(ttf12, subx1 + 8, suby1 + 30, page_str);
+
+			int first_ach = (achievements_window_page - 1) * 6;
+			// list achievement images
+			int index = 0;
+			bool bFirstHiddenAchievement = true;
+			for (auto& item : achievementNamesSorted)
+			{
+				bool hiddenAchievement = (achievementHidden.find(item.first) != achievementHidden.end());
+				bool unlocked = achievementUnlocked(item.first.c_str());
+				if ( index < first_ach )
 				{
-					printlog("connection attempt denied by server, error code: %d.\n", clientnum);
-					multiplayer = SINGLE;
-					if ( !directConnect )
+					++index; continue;
+				}
+				if ( hiddenAchievement )
+				{
+					if ( !bFirstHiddenAchievement )
 					{
-						if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-						{
-#ifdef STEAMWORKS
-							// if we got a packet, flush any remaining packets from the queue.
-							Uint32 startTicks = SDL_GetTicks();
-							Uint32 checkTicks = startTicks;
-							while ( (checkTicks - startTicks) < 2000 )
-							{
-								SteamAPI_RunCallbacks();
-								Uint32 packetlen = 0;
-								if ( SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
-								{
-									packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
-									Uint32 bytesRead = 0;
-									char buffer[NET_PACKET_SIZE];
-									if ( SteamNetworking()->ReadP2PPacket(buffer, packetlen, &bytesRead, &newSteamID, 0) )
-									{
-										checkTicks = SDL_GetTicks(); // found a packet, extend the wait time.
-									}
-									buffer[4] = '\0';
-									if ( (int)buffer[3] < '0'
-										&& (int)buffer[0] == 0
-										&& (int)buffer[1] == 0
-										&& (int)buffer[2] == 0 )
-									{
-										printlog("[Steam Lobby]: Clearing P2P packet queue: received: %d", (int)buffer[3]);
-									}
-									else
-									{
-										printlog("[Steam Lobby]: Clearing P2P packet queue: received: %s", buffer);
-									}
-								}
-								SDL_Delay(10);
-								if ( (SDL_GetTicks() - startTicks) > 5000 )
-								{
-									// hard break at 3 seconds.
-									break;
-								}
-							}
-#endif
-						}
-						else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-						{
-#if defined USE_EOS
-							// if we got a packet, flush any remaining packets from the queue.
-							Uint32 startTicks = SDL_GetTicks();
-							Uint32 checkTicks = startTicks;
-							while ( (checkTicks - startTicks) < 2000 )
-							{
-								EOS_Platform_Tick(EOS.PlatformHandle);
-								if ( EOS.HandleReceivedMessagesAndIgnore(&newRemoteProductId) )
-								{
-									checkTicks = SDL_GetTicks(); // found a packet, extend the wait time.
-								}
-								SDL_Delay(10);
-								if ( (SDL_GetTicks() - startTicks) > 5000 )
-								{
-									// hard break at 3 seconds.
-									break;
-								}
-							}
-#endif // USE_EOS
-						}
+						continue;
 					}
+					bFirstHiddenAchievement = false;
+				}
 
-					// close current window
-					buttonCloseSubwindow(NULL);
-					for ( node = button_l.first; node != NULL; node = nextnode )
-					{
-						nextnode = node->next;
-						button = (button_t*)node->element;
-						if ( button->focused )
-						{
-							list_RemoveNode(button->node);
-						}
-					}
+				const int iconAreaWidth = 12 + 64 + 12;
 
-#ifdef STEAMWORKS
-					if ( !directConnect )
-					{
-						if ( currentLobby )
-						{
-							SteamMatchmaking()->LeaveLobby(*static_cast<CSteamID*>(currentLobby));
-							cpp_Free_CSteamID( currentLobby ); //TODO: Bugger this.
-							currentLobby = NULL;
-						}
-					}
-#endif
-#if defined USE_EOS
-					if ( !directConnect )
-					{
-						if ( EOS.CurrentLobbyData.currentLobbyIsValid() )
-						{
-							EOS.leaveLobby();
-						}
-					}
-#endif
+				SDL_Rect bodyBox;
+				bodyBox.x = subx1 + 4 + iconAreaWidth;
+				bodyBox.y = suby1 + 80 + 4 + (index - first_ach) * 80;
+				bodyBox.w = subx2 - subx1 - 30 - 8 - iconAreaWidth;
+				bodyBox.h = 80 - 8;
+				drawWindowFancy(bodyBox.x, bodyBox.y, bodyBox.x + bodyBox.w, bodyBox.y + bodyBox.h);
 
-					// create new window
-					subwindow = 1;
-					subx1 = xres / 2 - 256;
-					subx2 = xres / 2 + 256;
-					suby1 = yres / 2 - 48;
-					suby2 = yres / 2 + 48;
-					strcpy(subtext, language[1377]);
-					if ( clientnum == MAXPLAYERS )
-					{
-						strcat(subtext, language[1378]);
-					}
-					else if ( clientnum == MAXPLAYERS + 1 )
-					{
-						strcat(subtext, language[1379]);
-					}
-					else if ( clientnum == MAXPLAYERS + 2 )
-					{
-						strcat(subtext, language[1380]);
-					}
-					else if ( clientnum == MAXPLAYERS + 3 )
-					{
-						strcat(subtext, language[1381]);
-					}
-					else if ( clientnum == MAXPLAYERS + 4 )
-					{
-						strcat(subtext, language[1382]);
-					}
-					else if ( clientnum == MAXPLAYERS + 5 )
-					{
-						strcat(subtext, language[1383]);
-					}
-					else
-					{
-						strcat(subtext, language[1384]);
-					}
-					clientnum = 0;
+				SDL_Rect iconBox;
+				iconBox.x = subx1 + 4;
+				iconBox.y = bodyBox.y;
+				iconBox.w = iconAreaWidth;
+				iconBox.h = bodyBox.h;
+				drawWindowFancy(iconBox.x, iconBox.y, iconBox.x + iconBox.w, iconBox.y + iconBox.h);
 
-					// close button
-					button = newButton();
-					strcpy(button->label, "x");
-					button->x = subx2 - 20;
-					button->y = suby1;
-					button->sizex = 20;
-					button->sizey = 20;
-					button->action = &buttonCloseSubwindow;
-					button->visible = 1;
-					button->focused = 1;
-					button->key = SDL_SCANCODE_ESCAPE;
-					button->joykey = joyimpulses[INJOY_MENU_CANCEL];
+				SDL_Rect bodyHighlight;
+				bodyHighlight.x = bodyBox.x + 2;
+				bodyHighlight.y = bodyBox.y + 2;
+				bodyHighlight.w = bodyBox.w - 4;
+				bodyHighlight.h = bodyBox.h - 4;
 
-					// okay button
-					button = newButton();
-					strcpy(button->label, language[732]);
-					button->x = subx2 - (subx2 - subx1) / 2 - 28;
-					button->y = suby2 - 28;
-					button->sizex = 56;
-					button->sizey = 20;
-					button->action = &buttonCloseSubwindow;
-					button->visible = 1;
-					button->focused = 1;
-					button->key = SDL_SCANCODE_RETURN;
-					button->joykey = joyimpulses[INJOY_MENU_NEXT];
+				SDL_Rect iconHighlight;
+				iconHighlight.x = iconBox.x + 2;
+				iconHighlight.y = iconBox.y + 2;
+				iconHighlight.w = iconBox.w - 4;
+				iconHighlight.h = iconBox.h - 4;
+
+				if ( achievementUnlocked(item.first.c_str()) )
+				{
+					drawRect(&bodyHighlight, uint32ColorBaronyBlue(*mainsurface), 64);
+					drawRect(&iconHighlight, SDL_MapRGB(mainsurface->format, 1, 0, 16), 255);
+				}
+				else
+				{
+					drawRect(&bodyHighlight, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
+					drawRect(&iconHighlight, SDL_MapRGB(mainsurface->format, 36, 36, 36), 255);
+				}
+
+				// draw name
+				Uint32 nameColor = unlocked ? SDL_MapRGB(mainsurface->format, 0, 255, 255) : SDL_MapRGB(mainsurface->format, 128, 128, 128);
+				if ( hiddenAchievement && !unlocked )
+				{
+					ttfPrintTextColor(ttf12, subx1 + 100, suby1 + 92 + (index - first_ach) * 80, nameColor, true, "Hidden Achievements");
 				}
 				else
 				{
-					// join game succeeded, advance to lobby
-					client_keepalive[0] = ticks;
-					receivedclientnum = true;
-					printlog("connected to server.\n");
-					client_disconnected[clientnum] = false;
-					if ( !loadingsavegame )
+					ttfPrintTextColor(ttf12, subx1 + 100, suby1 + 92 + (index - first_ach) * 80, nameColor, true, item.second.c_str());
+				}
+
+				// draw description
+				if ( !(hiddenAchievement && !unlocked) )
+				{
+					auto it = achievementDesc.find(item.first);
+					if ( it != achievementDesc.end() )
 					{
-						stats[clientnum]->appearance = stats[0]->appearance;
+						auto item = *it;
+						std::string sub = item.second.length() > 140 ? item.second.substr(0, 140) + "..." : item.second;
+						for ( size_t c, offset = 0;;)
+						{
+							size_t lastoffset = offset;
+							for ( c = lastoffset + 1; c < sub.size(); ++c )
+							{
+								if ( sub[c] == ' ' )
+								{
+									break;
+								}
+							}
+							offset = c;
+							if ( offset > 70 && lastoffset )
+							{
+								sub[lastoffset] = '\n';
+								break;
+							}
+							if ( offset >= sub.size() )
+							{
+								break;
+							}
+						}
+						ttfPrintText(ttf12, subx1 + 100, suby1 + 120 + (index - first_ach) * 80, sub.c_str());
 					}
+				}
+				else if ( hiddenAchievement && !unlocked )
+				{
+					ttfPrintTextFormatted(ttf12, subx1 + 100, suby1 + 120 + (index - first_ach) * 80, 
+						"+%d hidden achievements remain...", num_locked_and_hidden);
+				}
 
-					// now set up everybody else
-					for ( int c = 0; c < MAXPLAYERS; c++ )
+				// draw progress
+				if ( !unlocked )
+				{
+					auto it = achievementProgress.find(item.first);
+					if ( it != achievementProgress.end() )
 					{
-						client_disconnected[c] = false;
-						client_classes[c] = net_packet->data[4 + c * (5 + 23)]; // class
-						stats[c]->sex = static_cast<sex_t>(net_packet->data[5 + c * (5 + 23)]); // sex
-						client_disconnected[c] = net_packet->data[6 + c * (5 + 23)]; // connectedness :p
-						stats[c]->appearance = net_packet->data[7 + c * (5 + 23)]; // appearance
-						stats[c]->playerRace = net_packet->data[8 + c * (5 + 23)]; // player race
-						strcpy(stats[c]->name, (char*)(&net_packet->data[9 + c * (5 + 23)]));  // name
-					}
+						int maxValue = steamStatAchStringsAndMaxVals[it->second].second;
+						int currentValue = g_SteamStats[it->second].m_iValue;
+						int percent = (int)floor(currentValue * 100 / static_cast<double>(maxValue));
+						//char percent_str[32] = { 0 };
+						// snprintf(percent_str, sizeof(percent_str), "%3d%% complete", percent);
+						// ttfPrintTextColor(ttf12, subx2 - 330, suby1 + 92 + (index - first_ach) * 80, uint32ColorWhite(*mainsurface), true, percent_str);
 
-					// request svFlags
-					strcpy((char*)net_packet->data, "SVFL");
-					net_packet->len = 4;
-					net_packet->address.host = net_server.host;
-					net_packet->address.port = net_server.port;
-					sendPacketSafe(net_sock, -1, net_packet, 0);
+						SDL_Rect progressbar;
+						progressbar.x = subx2 - 330 + (4 * TTF12_WIDTH) + TTF12_WIDTH;
+						progressbar.y = suby1 + 92 + (index - first_ach) * 80 - 4;
+						progressbar.h = TTF12_HEIGHT + 2;
+						progressbar.w = (bodyBox.x + bodyBox.w) - progressbar.x - 4;
+						drawWindowFancy(progressbar.x - 2, progressbar.y - 2, progressbar.x + progressbar.w + 2, progressbar.y + progressbar.h + 2);
 
-					// open lobby window
-					lobby_window = true;
-					subwindow = 1;
-					subx1 = xres / 2 - 400;
-					subx2 = xres / 2 + 400;
-#ifdef PANDORA
-					suby1 = yres / 2 - ((yres==480)?230:290);
-					suby2 = yres / 2 + ((yres==480)?230:290);
-#else
-					suby1 = yres / 2 - 300;
-					suby2 = yres / 2 + 300;
-#endif
+						drawRect(&progressbar, SDL_MapRGB(mainsurface->format, 36, 36, 36), 255);
+						progressbar.w = std::min((bodyBox.x + bodyBox.w) - progressbar.x - 4, static_cast<int>(progressbar.w * percent / 100.0));
+						drawRect(&progressbar, uint32ColorBaronyBlue(*mainsurface), 92);
+						progressbar.w = (bodyBox.x + bodyBox.w) - progressbar.x - TTF12_WIDTH;
 
-					if ( directConnect )
-					{
-						strcpy(subtext, language[1385]);
-						if ( !broadcast )
-						{
-							strcat(subtext, last_ip);
-						}
-						else
-						{
-							strcat(subtext, "HIDDEN FOR BROADCAST");
-						}
+						char progress_str[32] = { 0 };
+						snprintf(progress_str, sizeof(progress_str), "%d / %d", currentValue, maxValue);
+						ttfPrintTextColor(ttf12, progressbar.x + progressbar.w / 2 - (strlen(progress_str) * TTF12_WIDTH) / 2,
+							suby1 + 92 + (index - first_ach) * 80, uint32ColorWhite(*mainsurface), true, progress_str);
 					}
-					else
+				}
+
+				// draw unlock time
+				if ( unlocked )
+				{
+					auto it = achievementUnlockTime.find(item.first);
+					if ( it != achievementUnlockTime.end() )
 					{
-						strcpy(subtext, language[1386]);
+						char buffer[64];
+						time_t t = (time_t)it->second;
+						struct tm* tm_info = localtime(&t);
+						strftime(buffer, sizeof(buffer), "Unlocked %Y/%m/%d at %H:%M:%S", tm_info);
+
+						char text[64];
+						snprintf(text, sizeof(text), "%32s", buffer);
+						ttfPrintTextColor(ttf12, subx2 - 330, suby1 + 92 + (index - first_ach) * 80, uint32ColorYellow(*mainsurface), true, text);
 					}
-					strcat(subtext, language[1387]);
+				}
 
-					// disconnect button
-					button = newButton();
-					strcpy(button->label, language[1311]);
-					button->sizex = strlen(language[1311]) * 12 + 8;
-					button->sizey = 20;
-					button->x = subx1 + 4;
-					button->y = suby2 - 24;
-					button->action = &buttonDisconnect;
-					button->visible = 1;
-					button->focused = 1;
-					button->joykey = joyimpulses[INJOY_MENU_CANCEL];
-#ifdef STEAMWORKS
-					if ( !directConnect && LobbyHandler.getJoiningType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-					{
-						const char* serverNumModsChar = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), "svNumMods");
-						int serverNumModsLoaded = atoi(serverNumModsChar);
-						if ( serverNumModsLoaded > 0 )
-						{
-							// subscribe to server loaded mods button
-							button = newButton();
-							strcpy(button->label, language[2984]);
-							button->sizex = strlen(language[2984]) * 12 + 8;
-							button->sizey = 20;
-							button->x = subx2 - 4 - button->sizex;
-							button->y = suby2 - 24;
-							button->action = &buttonGamemodsSubscribeToHostsModFiles;
-							button->visible = 1;
-							button->focused = 1;
+				// draw image
+				std::string img = unlocked ? item.first + ".png" : item.first + "_l.png";
+				if ( !unlocked && hiddenAchievement )
+				{
+					img = "LOCKED_ACHIEVEMENT.png";
+				}
+				auto it = achievementImages.find(img);
+				if ( it != achievementImages.end() )
+				{
+					SDL_Rect rect;
+					rect.x = subx1 + 16;
+					rect.y = suby1 + 88 + (index - first_ach) * 80;
+					rect.w = 64;
+					rect.h = 64;
+					drawImage((*it).second, NULL, &rect);
+				}
 
-							// mount server mods button
-							button = newButton();
-							strcpy(button->label, language[2985]);
-							button->sizex = strlen(language[2985]) * 12 + 8;
-							button->sizey = 20;
-							button->x = subx2 - 4 - button->sizex;
-							button->y = suby2 - 24;
-							button->action = &buttonGamemodsMountHostsModFiles;
-							button->visible = 0;
-							button->focused = 1;
+				++index;
+				if (index >= first_ach + 6)
+				{
+					break;
+				}
+			}
+		}
+		else
+		{
+			ttfPrintText(ttf12, subx1 + 8, suby1 + 100, language[709]);
+		}
+	}
 
-							g_SteamWorkshop->CreateQuerySubscribedItems(k_EUserUGCList_Subscribed, k_EUGCMatchingUGCType_All, k_EUserUGCListSortOrder_LastUpdatedDesc);
-							g_SteamWorkshop->subscribedCallStatus = 0;
-						}
+	// connect window
+	if ( connect_window )
+	{
+		if ( connect_window == SERVER )
+		{
+			drawDepressed(subx1 + 8, suby1 + 40, subx2 - 8, suby1 + 64);
+			ttfPrintText(ttf12, subx1 + 12, suby1 + 46, portnumber_char);
+
+			// enter port number
+			if ( !SDL_IsTextInputActive() )
+			{
+				SDL_StartTextInput(); //TODO: NX PORT: Why is the order different in some of these chunks? For example, some of them start text input first, others start it after the below chunk of code.
+				if (inputstr != portnumber_char)
+				{
+					inputstr = portnumber_char;
+#ifdef NINTENDO
+					auto result = nxKeyboard("Enter port number");
+					if (result.success)
+					{
+						strncpy(inputstr, result.str.c_str(), 21);
+						inputstr[21] = '\0'; //TODO: NX PORT: Why 21? inputlen = 5 down there, shouldn't this be inputstr[4]?
+					}
+#endif
+				}
+			}
+			//strncpy(portnumber_char,inputstr,5);
+			inputlen = 5;
+			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+			{
+				int x;
+				getSizeOfText(ttf12, portnumber_char, &x, NULL);
+				ttfPrintText(ttf12, subx1 + 12 + x, suby1 + 46, "_");
+			}
+		}
+		else if ( connect_window == CLIENT )
+		{
+			drawDepressed(subx1 + 8, suby1 + 40, subx2 - 8, suby1 + 64);
+			if ( !broadcast )
+			{
+				ttfPrintText(ttf12, subx1 + 12, suby1 + 46, connectaddress);
+			}
+			else
+			{
+				int i;
+				for ( i = 0; i < strlen(connectaddress); i++ )
+				{
+					ttfPrintText(ttf12, subx1 + 12 + 12 * i, suby1 + 46, "*");
+				}
+			}
+
+			// enter address
+			if ( !SDL_IsTextInputActive() )
+			{
+				SDL_StartTextInput();
+
+				if (inputstr != connectaddress)
+				{
+					inputstr = connectaddress;
+#ifdef NINTENDO
+					auto result = nxKeyboard("Enter address");
+					if (result.success)
+					{
+						strncpy(inputstr, result.str.c_str(), 21);
+						inputstr[21] = '\0'; //TODO: NX PORT: Why not inputstr[30], since inputlen = 31?
 					}
-#endif // STEAMWORKS
+#endif
 				}
 			}
+			//strncpy(connectaddress,inputstr,31);
+			inputlen = 31;
+			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+			{
+				int x;
+				getSizeOfText(ttf12, connectaddress, &x, NULL);
+				ttfPrintText(ttf12, subx1 + 12 + x, suby1 + 46, "_");
+			}
 		}
-		else if ( multiplayer == CLIENT )
-		{
+	}
+
+	// communicating with clients
+	if ( multiplayer == SERVER && mode )
+	{
+		//void *newSteamID = NULL; //TODO: Bugger void pointers!
 #ifdef STEAMWORKS
-			CSteamID newSteamID;
-			joinLobbyWaitingForHostResponse = false;
+		CSteamID newSteamID;
 #endif
-#ifdef USE_EOS
-			EOS.bJoinLobbyWaitingForHostResponse = false;
+#if defined USE_EOS
+		EOS_ProductUserId newRemoteProductId = nullptr;
 #endif
-			int numpacket;
-			for ( numpacket = 0; numpacket < PACKET_LIMIT && net_packet; numpacket++ )
+
+		// hosting the lobby
+		int numpacket;
+		for ( numpacket = 0; numpacket < PACKET_LIMIT; numpacket++ )
+		{
+			if ( directConnect )
 			{
-				if ( directConnect )
+				if ( !SDLNet_UDP_Recv(net_sock, net_packet) )
 				{
-					if ( !SDLNet_UDP_Recv(net_sock, net_packet) )
+					break;
+				}
+			}
+			else
+			{
+				if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+				{
+#ifdef STEAMWORKS
+					uint32_t packetlen = 0;
+					if ( !SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
 					{
 						break;
 					}
-				}
-				else
-				{
-					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
+					/*if ( newSteamID ) {
+						cpp_Free_CSteamID( newSteamID );
+						newSteamID = NULL;
+					}*/
+					//newSteamID = c_AllocateNew_CSteamID();
+					Uint32 bytesRead = 0;
+					if ( !SteamNetworking()->ReadP2PPacket(net_packet->data, packetlen, &bytesRead, &newSteamID, 0) )
 					{
-#ifdef STEAMWORKS
-						uint32_t packetlen = 0;
-						if ( !SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
-						{
-							break;
-						}
-						packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
-						Uint32 bytesRead = 0;
-						if ( !SteamNetworking()->ReadP2PPacket(net_packet->data, packetlen, &bytesRead, &newSteamID, 0) ) //TODO: Sometimes if a host closes a lobby, it can crash here for a client.
-						{
-							continue;
-						}
-						net_packet->len = packetlen;
-						if ( packetlen < sizeof(DWORD) )
-						{
-							continue;    //TODO: Again, figure out why this is happening.
-						}
-
-						CSteamID mySteamID = SteamUser()->GetSteamID();
-						if (mySteamID.ConvertToUint64() == newSteamID.ConvertToUint64())
-						{
-							continue;
-						}
-#endif
+						continue;
 					}
-					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					net_packet->len = packetlen;
+					if ( packetlen < sizeof(DWORD) )
 					{
-#if defined USE_EOS
-						EOS_ProductUserId remoteId = nullptr;
-						if ( !EOS.HandleReceivedMessages(&remoteId) )
-						{
-							continue;
-						}
-#endif // USE_EOS
+						continue;    // junk packet, skip //TODO: Investigate the cause of this. During earlier testing, we were getting bombarded with untold numbers of these malformed packets, as if the entire steam network were being routed through this game.
 					}
-				}
-
-				if ( handleSafePacket() )
-				{
-					continue;
-				}
 
-				// game start
-				if (!strncmp((char*)net_packet->data, "BARONY_GAME_START", 17))
-				{
-					lobbyWindowSvFlags = SDLNet_Read32(&net_packet->data[17]);
-					uniqueGameKey = SDLNet_Read32(&net_packet->data[21]);
-					buttonCloseSubwindow(NULL);
-					numplayers = MAXPLAYERS;
-					introstage = 3;
-					fadeout = true;
-					if ( net_packet->data[25] == 0 )
+					CSteamID mySteamID = SteamUser()->GetSteamID();
+					if ( mySteamID.ConvertToUint64() == newSteamID.ConvertToUint64() )
 					{
-						loadingsavegame = 0;
+						continue;
 					}
-					continue;
+#endif
 				}
-
-				// new player
-				else if (!strncmp((char*)net_packet->data, "NEWPLAYER", 9))
+				else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 				{
-					client_disconnected[net_packet->data[9]] = false;
-					client_classes[net_packet->data[9]] = net_packet->data[10];
-					stats[net_packet->data[9]]->sex = static_cast<sex_t>(net_packet->data[11]);
-					stats[net_packet->data[9]]->appearance = net_packet->data[12];
-					stats[net_packet->data[9]]->playerRace = net_packet->data[13];
-					strcpy(stats[net_packet->data[9]]->name, (char*)(&net_packet->data[14]));
-
-					char shortname[32] = { 0 };
-					strncpy(shortname, stats[net_packet->data[9]]->name, 22);
-					newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1388], shortname);
-					continue;
+#if defined USE_EOS
+					if ( !EOS.HandleReceivedMessages(&newRemoteProductId) )
+					{
+						continue;
+					}
+					EOS.P2PConnectionInfo.insertProductIdIntoPeers(newRemoteProductId);
+#endif // USE_EOS
 				}
+			}
 
-				// player disconnect
-				else if (!strncmp((char*)net_packet->data, "PLAYERDISCONNECT", 16) || !strncmp((char*)net_packet->data, "KICK", 4) )
+			if ( handleSafePacket() )
+			{
+				continue;
+			}
+			if (!strncmp((char*)net_packet->data, "BARONY_JOIN_REQUEST", 19))
+			{
+				int playerNum = MAXPLAYERS;
+				if ( !directConnect )
 				{
-					int playerDisconnected = 0;
-					if ( !strncmp((char*)net_packet->data, "KICK", 4) )
-					{
-						playerDisconnected = clientnum;
-					}
-					else
-					{
-						playerDisconnected = net_packet->data[16];
-						client_disconnected[playerDisconnected] = true;
-					}
-					if ( playerDisconnected == clientnum || net_packet->data[16] == 0 )
+					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 					{
-						// close lobby window
-						buttonCloseSubwindow(NULL);
-						for ( node = button_l.first; node != NULL; node = nextnode )
+#ifdef STEAMWORKS
+						bool skipJoin = false;
+						for ( int c = 0; c < MAXPLAYERS; c++ )
 						{
-							nextnode = node->next;
-							button = (button_t*)node->element;
-							if ( button->focused )
+							if ( client_disconnected[c] || !steamIDRemote[c] )
 							{
-								list_RemoveNode(button->node);
+								continue;
+							}
+							if ( newSteamID.ConvertToUint64() == (static_cast<CSteamID*>(steamIDRemote[c]))->ConvertToUint64() )
+							{
+								// we've already accepted this player. NEXT!
+								skipJoin = true;
+								break;
 							}
 						}
-
-						// create new window
-						subwindow = 1;
-						subx1 = xres / 2 - 256;
-						subx2 = xres / 2 + 256;
-						suby1 = yres / 2 - 40;
-						suby2 = yres / 2 + 40;
-
-						if ( playerDisconnected == clientnum )
+						if ( skipJoin )
 						{
-							strcpy(subtext, language[1127]);
+							continue;
 						}
-						else
+#endif
+					}
+					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					{
+#if defined USE_EOS
+						bool skipJoin = false;
+						/*for ( c = 0; c < MAXPLAYERS; c++ )
 						{
-							strcpy(subtext, language[1126]);
-						}
-
-						// close button
-						button = newButton();
-						strcpy(button->label, "x");
-						button->x = subx2 - 20;
-						button->y = suby1;
-						button->sizex = 20;
-						button->sizey = 20;
-						button->action = &buttonCloseSubwindow;
-						button->visible = 1;
-						button->focused = 1;
-						button->joykey = joyimpulses[INJOY_MENU_CANCEL];
-
-						// okay button
-						button = newButton();
-						strcpy(button->label, language[732]);
-						button->x = subx2 - (subx2 - subx1) / 2 - 20;
-						button->y = suby2 - 24;
-						button->sizex = 56;
-						button->sizey = 20;
-						button->action = &buttonCloseSubwindow;
-						button->visible = 1;
-						button->focused = 1;
-						button->joykey = joyimpulses[INJOY_MENU_NEXT];
-
-						// reset multiplayer status
-						multiplayer = SINGLE;
-						stats[0]->sex = stats[clientnum]->sex;
-						client_classes[0] = client_classes[clientnum];
-						strcpy(stats[0]->name, stats[clientnum]->name);
-						clientnum = 0;
-						client_disconnected[0] = false;
-						for ( int c = 1; c < MAXPLAYERS; c++ )
+							if ( client_disconnected[c] )
+							{
+								continue;
+							}
+						}*/
+						EOSFuncs::logInfo("newRemoteProductId: %s", EOSFuncs::Helpers_t::productIdToString(newRemoteProductId));
+						if ( newRemoteProductId && EOS.P2PConnectionInfo.isPeerIndexed(newRemoteProductId) )
+						{
+							if ( EOS.P2PConnectionInfo.getIndexFromPeerId(newRemoteProductId) >= 0 )
+							{
+								// we've already accepted this player. NEXT!
+								skipJoin = true;
+							}
+						}
+						if ( skipJoin )
 						{
-							client_disconnected[c] = true;
+							continue;
 						}
-
-						// close any existing net interfaces
-						closeNetworkInterfaces();
-
+#endif // USE_EOS
+					}
+				}
+				NetworkingLobbyJoinRequestResult result = lobbyPlayerJoinRequest(playerNum);
+				if ( result == NetworkingLobbyJoinRequestResult::NET_LOBBY_JOIN_P2P_FAILURE )
+				{
+					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					{
 #ifdef STEAMWORKS
-						if ( !directConnect )
+						for ( int responses = 0; responses < 5; ++responses )
 						{
-							if ( currentLobby )
-							{
-								SteamMatchmaking()->LeaveLobby(*static_cast<CSteamID*>(currentLobby));
-								cpp_Free_CSteamID(currentLobby); //TODO: Bugger this.
-								currentLobby = NULL;
-							}
+							SteamNetworking()->SendP2PPacket(newSteamID, net_packet->data, net_packet->len, k_EP2PSendReliable, 0);
+							SDL_Delay(5);
 						}
 #endif
+					}
+					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					{
 #if defined USE_EOS
-						if ( !directConnect )
+						for ( int responses = 0; responses < 5; ++responses )
 						{
-							if ( EOS.CurrentLobbyData.currentLobbyIsValid() )
-							{
-								EOS.leaveLobby();
-							}
+							EOS.SendMessageP2P(newRemoteProductId, net_packet->data, net_packet->len);
+							SDL_Delay(5);
 						}
 #endif
 					}
-					else
+				}
+				else if ( result == NetworkingLobbyJoinRequestResult::NET_LOBBY_JOIN_P2P_SUCCESS )
+				{
+					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 					{
-						char shortname[32] = { 0 };
-						strncpy(shortname, stats[net_packet->data[16]]->name, 22);
-						newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
+#ifdef STEAMWORKS
+						if ( steamIDRemote[playerNum - 1] )
+						{
+							cpp_Free_CSteamID(steamIDRemote[playerNum - 1]);
+						}
+						steamIDRemote[playerNum - 1] = new CSteamID();
+						*static_cast<CSteamID*>(steamIDRemote[playerNum - 1]) = newSteamID;
+						for ( int responses = 0; responses < 5; ++responses )
+						{
+							SteamNetworking()->SendP2PPacket(*static_cast<CSteamID* >(steamIDRemote[playerNum - 1]), net_packet->data, net_packet->len, k_EP2PSendReliable, 0);
+							SDL_Delay(5);
+						}
+#endif
+					}
+					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					{
+#if defined USE_EOS
+						EOS.P2PConnectionInfo.assignPeerIndex(newRemoteProductId, playerNum - 1);
+						for ( int responses = 0; responses < 5; ++responses )
+						{
+							EOS.SendMessageP2P(EOS.P2PConnectionInfo.getPeerIdFromIndex(playerNum - 1), net_packet->data, net_packet->len);
+							SDL_Delay(5);
+						}
+#endif
 					}
-					continue;
 				}
+				continue;
+			}
 
-				// got a chat message
-				else if (!strncmp((char*)net_packet->data, "CMSG", 4))
+			// got a chat message
+			else if (!strncmp((char*)net_packet->data, "CMSG", 4))
+			{
+				int i;
+				for ( i = 1; i < MAXPLAYERS; i++ )
 				{
-					newString(&lobbyChatboxMessages, 0xFFFFFFFF, (char*)(&net_packet->data[4]));
-					playSound(238, 64);
-					continue;
+					if ( client_disconnected[i] )
+					{
+						continue;
+					}
+					net_packet->address.host = net_clients[i - 1].host;
+					net_packet->address.port = net_clients[i - 1].port;
+					sendPacketSafe(net_sock, -1, net_packet, i - 1);
 				}
+				newString(&lobbyChatboxMessages, 0xFFFFFFFF, (char*)(&net_packet->data[4]));
+				playSound(238, 64);
+				continue;
+			}
 
-				// update svFlags
-				else if (!strncmp((char*)net_packet->data, "SVFL", 4))
+			// player disconnected
+			else if (!strncmp((char*)net_packet->data, "PLAYERDISCONNECT", 16))
+			{
+				client_disconnected[net_packet->data[16]] = true;
+				for ( int c = 1; c < MAXPLAYERS; c++ )
 				{
-					lobbyWindowSvFlags = SDLNet_Read32(&net_packet->data[4]);
-					continue;
+					if ( client_disconnected[c] )
+					{
+						continue;
+					}
+					net_packet->address.host = net_clients[c - 1].host;
+					net_packet->address.port = net_clients[c - 1].port;
+					net_packet->len = 17;
+					sendPacketSafe(net_sock, -1, net_packet, c - 1);
 				}
+				char shortname[32] = { 0 };
+				strncpy(shortname, stats[net_packet->data[16]]->name, 22);
+				newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
+				continue;
+			}
 
-				// keepalive
-				else if (!strncmp((char*)net_packet->data, "KEEPALIVE", 9))
+			// client requesting new svFlags
+			else if (!strncmp((char*)net_packet->data, "SVFL", 4))
+			{
+				// update svFlags for everyone
+				SDLNet_Write32(svFlags, &net_packet->data[4]);
+				net_packet->len = 8;
+
+				for ( int c = 1; c < MAXPLAYERS; c++ )
 				{
-					client_keepalive[0] = ticks;
-					continue; // just a keep alive
+					if ( client_disconnected[c] )
+					{
+						continue;
+					}
+					net_packet->address.host = net_clients[c - 1].host;
+					net_packet->address.port = net_clients[c - 1].port;
+					sendPacketSafe(net_sock, -1, net_packet, c - 1);
 				}
+				continue;
+			}
+
+			// keepalive
+			else if (!strncmp((char*)net_packet->data, "KEEPALIVE", 9))
+			{
+				client_keepalive[net_packet->data[9]] = ticks;
+				continue; // just a keep alive
 			}
 		}
 	}
-	if ( multiplayer == SINGLE )
-	{
-		receivedclientnum = false;
-	}
 
-	// lobby window
-	if ( lobby_window )
+	// communicating with server
+	if ( multiplayer == CLIENT && mode )
 	{
-
-		int hovering_selection = -1; //0 to NUM_SERVER_FLAGS used for the server flags settings, e.g. are traps, cheats, minotaur, etc enabled.
-		SDL_Rect tooltip_box;
-
-		// player info text
-		for ( int c = 0; c < MAXPLAYERS; ++c )
+		if ( receivedclientnum == false )
 		{
-			if ( client_disconnected[c] )
+#ifdef STEAMWORKS
+			CSteamID newSteamID;
+			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 			{
-				continue;
+				// waiting on host response.
+				if ( joinLobbyWaitingForHostResponse )
+				{
+					// waiting on host response.
+					if ( ticks - client_keepalive[0] >= 15 * TICKS_PER_SECOND ) // 15 second timeout
+					{
+						buttonDisconnect(nullptr);
+						openFailedConnectionWindow(CLIENT);
+						strcpy(subtext, LobbyHandler_t::getLobbyJoinFailedConnectString(static_cast<int>(LobbyHandler_t::LOBBY_JOIN_TIMEOUT)).c_str());
+						connectingToLobbyStatus = EResult::k_EResultOK;
+					}
+				}
 			}
-			string charDisplayName = "";
-			charDisplayName = stats[c]->name;
+#endif
+#if defined USE_EOS
+			EOS_ProductUserId newRemoteProductId = nullptr;
+			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+			{
+				if ( EOS.bJoinLobbyWaitingForHostResponse )
+				{
+					// waiting on host response.
+					if ( ticks - client_keepalive[0] >= 15 * TICKS_PER_SECOND ) // 15 second timeout
+					{
+						buttonDisconnect(nullptr);
+						openFailedConnectionWindow(CLIENT);
+						strcpy(subtext, LobbyHandler_t::getLobbyJoinFailedConnectString(static_cast<int>(LobbyHandler_t::LOBBY_JOIN_TIMEOUT)).c_str());
+						EOS.ConnectingToLobbyStatus = static_cast<int>(EOS_EResult::EOS_Success);
+					}
+				}
+			}
+#endif
 
-			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+			// trying to connect to the server and get a player number
+			// receive the packet:
+			bool gotPacket = false;
+			if ( directConnect )
+			{
+				if ( SDLNet_TCP_Recv(net_tcpsock, net_packet->data, 4 + MAXPLAYERS * (5 + 23)) )
+				{
+					gotPacket = true;
+				}
+			}
+			else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 			{
 #ifdef STEAMWORKS
-				if ( c != clientnum )
+				for ( Uint32 numpacket = 0; numpacket < PACKET_LIMIT && net_packet; numpacket++ )
 				{
-					for ( int remoteIDIndex = 0; remoteIDIndex < MAXPLAYERS; ++remoteIDIndex )
+					Uint32 packetlen = 0;
+					if ( !SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
 					{
-						if ( steamIDRemote[remoteIDIndex] )
-						{
-							const char* memberNumChar = SteamMatchmaking()->GetLobbyMemberData(*static_cast<CSteamID*>(currentLobby), *static_cast<CSteamID*>(steamIDRemote[remoteIDIndex]), "clientnum");
-							if ( memberNumChar )
-							{
-								std::string str = memberNumChar;
-								if ( str.compare("") != 0 )
-								{
-									int memberNum = std::stoi(str);
-									if ( memberNum >= 0 && memberNum < MAXPLAYERS && memberNum == c )
-									{
-										charDisplayName += " (";
-										charDisplayName += SteamFriends()->GetFriendPersonaName(*static_cast<CSteamID*>(steamIDRemote[remoteIDIndex]));
-										charDisplayName += ")";
-									}
-								}
-							}
-						}
+						break;
+					}
+					packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
+					Uint32 bytesRead = 0;
+					if ( !SteamNetworking()->ReadP2PPacket(net_packet->data, packetlen, &bytesRead, &newSteamID, 0) || bytesRead != 4 + MAXPLAYERS * (5 + 23) )
+					{
+						continue;
+					}
+					net_packet->len = packetlen;
+					if ( packetlen < sizeof(DWORD) )
+					{
+						continue;
+					}
+
+					CSteamID mySteamID = SteamUser()->GetSteamID();
+					if ( mySteamID.ConvertToUint64() == newSteamID.ConvertToUint64() )
+					{
+						continue;
+					}
+					if ( (int)net_packet->data[3] < '0'
+						&& (int)net_packet->data[0] == 0
+						&& (int)net_packet->data[1] == 0
+						&& (int)net_packet->data[2] == 0 )
+					{
+						// data encoded with [0 0 0 clientnum] - directly sends an INT, if the character is < '0', then it is non-alphanumeric character.
+						// likely not some other form of data - like an old "GOTP" from a recently closed session.
+						gotPacket = true;
 					}
-				}
-				else
-				{
-					charDisplayName += " (";
-					charDisplayName += SteamFriends()->GetPersonaName();
-					charDisplayName += ")";
-
-					if ( currentLobby )
+					else
 					{
-						if ( ticks % 10 == 0 )
-						{
-							const char* memberNumChar = SteamMatchmaking()->GetLobbyMemberData(*static_cast<CSteamID*>(currentLobby), SteamUser()->GetSteamID(), "clientnum");
-							if ( memberNumChar )
-							{
-								std::string str = memberNumChar;
-								if ( str.compare("") == 0 || str.compare(std::to_string(clientnum)) != 0 )
-								{
-									SteamMatchmaking()->SetLobbyMemberData(*static_cast<CSteamID*>(currentLobby), "clientnum", std::to_string(clientnum).c_str());
-									printlog("[STEAM Lobbies]: Updating clientnum %d to lobby member data", clientnum);
-								}
-							}
-						}
+						continue;
 					}
+					break;
 				}
 #endif
 			}
-			else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+			else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 			{
-#if defined USE_EOS
-				if ( c == clientnum )
+#ifdef USE_EOS
+				for ( Uint32 numpacket = 0; numpacket < PACKET_LIMIT; numpacket++ )
 				{
-					charDisplayName += " (";
-					charDisplayName += EOS.CurrentUserInfo.Name;
-					charDisplayName += ")";
-
-					if ( EOS.CurrentLobbyData.currentLobbyIsValid()
-						&& EOS.CurrentLobbyData.getClientnumMemberAttribute(EOS.CurrentUserInfo.getProductUserIdHandle()) < 0 )
+					if ( !EOS.HandleReceivedMessages(&newRemoteProductId) )
 					{
-						if ( EOS.CurrentLobbyData.assignClientnumMemberAttribute(EOS.CurrentUserInfo.getProductUserIdHandle(), clientnum) )
-						{
-							EOS.CurrentLobbyData.modifyLobbyMemberAttributeForCurrentUser();
-						}
+						continue;
 					}
-				}
-				else
-				{
-					for ( auto& player : EOS.CurrentLobbyData.playersInLobby )
+					if ( (int)net_packet->data[3] < '0' 
+						&& (int)net_packet->data[0] == 0 
+						&& (int)net_packet->data[1] == 0
+						&& (int)net_packet->data[2] == 0 )
 					{
-						if ( player.clientNumber == c )
-						{
-							charDisplayName += " (";
-							charDisplayName += player.name;
-							charDisplayName += ")";
-						}
+						// data encoded with [0 0 0 clientnum] - directly sends an INT, if the character is < '0', then it is non-alphanumeric character.
+						// likely not some other form of data - like an old "GOTP" from a recently closed session.
+						gotPacket = true;
+					}
+					else
+					{
+						continue;
 					}
+					break;
 				}
-#endif
-			}
-
-			std::string raceAndClass = language[3161 + stats[c]->playerRace];
-			raceAndClass += " ";
-			if ( stats[c]->playerRace > RACE_HUMAN && stats[c]->appearance != 0 )
-			{
-				raceAndClass += "(aesthetic) ";
-			}
-			raceAndClass += playerClassLangEntry(client_classes[c], c);
-
-			if ( charDisplayName.size() > 39 )
-			{
-				charDisplayName = charDisplayName.substr(0, 37);
-				charDisplayName += "..";
+#endif // USE_EOS
 			}
 
-			if ( stats[c]->sex )
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 8, suby1 + 80 + 60 * c, "%d:  %s\n    %s\n    %s", c + 1, charDisplayName.c_str(), language[1322], raceAndClass.c_str());
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, subx1 + 8, suby1 + 80 + 60 * c, "%d:  %s\n    %s\n    %s", c + 1, charDisplayName.c_str(), language[1321], raceAndClass.c_str());
-			}
-		}
 
-		// select gui element w/ mouse
-		if ( inputs.bMouseLeft(clientnum) )
-		{
-			if ( mouseInBounds(clientnum, subx1 + 16, subx2 - 16, suby2 - 48, suby2 - 32) )
+			// parse the packet:
+			if ( gotPacket )
 			{
-				inputs.mouseClearLeft(clientnum);
+				list_FreeAll(&button_l);
+				deleteallbuttons = true;
 
-				// chatbox
-				inputstr = lobbyChatbox;
-				inputlen = LOBBY_CHATBOX_LENGTH - 1;
-				cursorflash = ticks;
-			}
-			else if ( mouseInBounds(clientnum, xres / 2, subx2 - 32, suby1 + 56, suby1 + 68) && !directConnect )
-			{
-				inputs.mouseClearLeft(clientnum);
+				//clientnum = (int)SDLNet_Read32(&net_packet->data[0]);
+				clientnum = (int)net_packet->data[3];
+				//printlog("%d %d %d %d", (int)net_packet->data[0], (int)net_packet->data[1], (int)net_packet->data[2], (int)net_packet->data[3]);
 
-				// lobby name
-				if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+				if ( clientnum >= MAXPLAYERS || clientnum <= 0 )
 				{
+					printlog("connection attempt denied by server, error code: %d.\n", clientnum);
+					multiplayer = SINGLE;
+					if ( !directConnect )
+					{
+						if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+						{
 #ifdef STEAMWORKS
-					inputstr = currentLobbyName;
-					inputlen = 31;
-#endif
-				}
-				else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-				{
-#if defined USE_EOS
-					inputstr = EOS.currentLobbyName;
-					inputlen = 31;
+							// if we got a packet, flush any remaining packets from the queue.
+							Uint32 startTicks = SDL_GetTicks();
+							Uint32 checkTicks = startTicks;
+							while ( (checkTicks - startTicks) < 2000 )
+							{
+								SteamAPI_RunCallbacks();
+								Uint32 packetlen = 0;
+								if ( SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
+								{
+									packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
+									Uint32 bytesRead = 0;
+									char buffer[NET_PACKET_SIZE];
+									if ( SteamNetworking()->ReadP2PPacket(buffer, packetlen, &bytesRead, &newSteamID, 0) )
+									{
+										checkTicks = SDL_GetTicks(); // found a packet, extend the wait time.
+									}
+									buffer[4] = '\0';
+									if ( (int)buffer[3] < '0'
+										&& (int)buffer[0] == 0
+										&& (int)buffer[1] == 0
+										&& (int)buffer[2] == 0 )
+									{
+										printlog("[Steam Lobby]: Clearing P2P packet queue: received: %d", (int)buffer[3]);
+									}
+									else
+									{
+										printlog("[Steam Lobby]: Clearing P2P packet queue: received: %s", buffer);
+									}
+								}
+								SDL_Delay(10);
+								if ( (SDL_GetTicks() - startTicks) > 5000 )
+								{
+									// hard break at 3 seconds.
+									break;
+								}
+							}
 #endif
-				}
-				cursorflash = ticks;
-			}
-
-			// server flags
-			int i;
-			if ( multiplayer == SERVER )
-			{
-				for ( i = 0; i < NUM_SERVER_FLAGS; i++ )
-				{
-					if ( mouseInBounds(clientnum, xres / 2 + 8 + 6, xres / 2 + 8 + 30, suby1 + 80 + i * 16, suby1 + 92 + i * 16) )
-					{
-						inputs.mouseClearLeft(clientnum);
-
-						// toggle flag
-						svFlags ^= power(2, i);
-
-						// update client flags
-						strcpy((char*)net_packet->data, "SVFL");
-						SDLNet_Write32(svFlags, &net_packet->data[4]);
-						net_packet->len = 8;
-
-						int c;
-						for ( c = 1; c < MAXPLAYERS; c++ )
+						}
+						else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 						{
-							if ( client_disconnected[c] )
+#if defined USE_EOS
+							// if we got a packet, flush any remaining packets from the queue.
+							Uint32 startTicks = SDL_GetTicks();
+							Uint32 checkTicks = startTicks;
+							while ( (checkTicks - startTicks) < 2000 )
 							{
-								continue;
+								EOS_Platform_Tick(EOS.PlatformHandle);
+								if ( EOS.HandleReceivedMessagesAndIgnore(&newRemoteProductId) )
+								{
+									checkTicks = SDL_GetTicks(); // found a packet, extend the wait time.
+								}
+								SDL_Delay(10);
+								if ( (SDL_GetTicks() - startTicks) > 5000 )
+								{
+									// hard break at 3 seconds.
+									break;
+								}
 							}
-							net_packet->address.host = net_clients[c - 1].host;
-							net_packet->address.port = net_clients[c - 1].port;
-							sendPacketSafe(net_sock, -1, net_packet, c - 1);
+#endif // USE_EOS
 						}
+					}
 
-						// update lobby data
-						if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					// close current window
+					buttonCloseSubwindow(NULL);
+					for ( node = button_l.first; node != NULL; node = nextnode )
+					{
+						nextnode = node->next;
+						button = (button_t*)node->element;
+						if ( button->focused )
 						{
-#ifdef STEAMWORKS
-							char svFlagsChar[16];
-							snprintf(svFlagsChar, 15, "%d", svFlags);
-							SteamMatchmaking()->SetLobbyData(*static_cast<CSteamID*>(currentLobby), "svFlags", svFlagsChar);
-#endif
+							list_RemoveNode(button->node);
 						}
 					}
-				}
-			}
 
-			// switch lobby type
-			if ( multiplayer == SERVER && !directConnect )
-			{
-				if ( LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-				{
 #ifdef STEAMWORKS
-					for ( Uint32 i = 0; i < 2; i++ )
-					{
-						if ( mouseInBounds(clientnum, xres / 2 + 8 + 6, xres / 2 + 8 + 30, suby1 + 256 + i * 16, suby1 + 268 + i * 16) )
-						{
-							inputs.mouseClearLeft(clientnum);
-							switch ( i )
-							{
-								default:
-									currentLobbyType = k_ELobbyTypePrivate;
-									break;
-								case 1:
-									currentLobbyType = k_ELobbyTypePublic;
-									break;
-								/*case 2:
-									currentLobbyType = k_ELobbyTypeFriendsOnly;
-									// deprecated by steam, doesn't return in getLobbyList.
-									break;*/
-							}
-							SteamMatchmaking()->SetLobbyType(*static_cast<CSteamID*>(currentLobby), currentLobbyType);
+					if ( !directConnect )
+					{
+						if ( currentLobby )
+						{
+							SteamMatchmaking()->LeaveLobby(*static_cast<CSteamID*>(currentLobby));
+							cpp_Free_CSteamID( currentLobby ); //TODO: Bugger this.
+							currentLobby = NULL;
 						}
 					}
 #endif
-				}
-				else if ( LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-				{
-#ifdef USE_EOS
-					for ( Uint32 i = 0; i < 2; i++ )
+#if defined USE_EOS
+					if ( !directConnect )
 					{
-						if ( mouseInBounds(clientnum, xres / 2 + 8 + 6, xres / 2 + 8 + 30, suby1 + 256 + i * 16, suby1 + 268 + i * 16) )
+						if ( EOS.CurrentLobbyData.currentLobbyIsValid() )
 						{
-							inputs.mouseClearLeft(clientnum);
-							switch ( i )
-							{
-								default:
-									EOS.currentPermissionLevel = EOS_ELobbyPermissionLevel::EOS_LPL_JOINVIAPRESENCE;
-									break;
-								case 1:
-									EOS.currentPermissionLevel = EOS_ELobbyPermissionLevel::EOS_LPL_PUBLICADVERTISED;
-									break;
-							}
+							EOS.leaveLobby();
 						}
 					}
 #endif
-				}
-			}
-		}
 
-		// switch textboxes with TAB
-		if ( multiplayer == SERVER )
-		{
-			if ( keystatus[SDL_SCANCODE_TAB] )
-			{
-				keystatus[SDL_SCANCODE_TAB] = 0;
-				if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-				{
-#ifdef STEAMWORKS
-					if ( inputstr == currentLobbyName )
+					// create new window
+					subwindow = 1;
+					subx1 = xres / 2 - 256;
+					subx2 = xres / 2 + 256;
+					suby1 = yres / 2 - 48;
+					suby2 = yres / 2 + 48;
+					strcpy(subtext, language[1377]);
+					if ( clientnum == MAXPLAYERS )
 					{
-						inputstr = lobbyChatbox;
-						inputlen = LOBBY_CHATBOX_LENGTH - 1;
+						strcat(subtext, language[1378]);
 					}
-					else
+					else if ( clientnum == MAXPLAYERS + 1 )
 					{
-						inputstr = currentLobbyName;
-						inputlen = 31;
+						strcat(subtext, language[1379]);
 					}
-#endif
-				}
-				else if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-				{
-#if defined USE_EOS
-					if ( inputstr == EOS.currentLobbyName )
+					else if ( clientnum == MAXPLAYERS + 2 )
 					{
-						inputstr = lobbyChatbox;
-						inputlen = LOBBY_CHATBOX_LENGTH - 1;
+						strcat(subtext, language[1380]);
+					}
+					else if ( clientnum == MAXPLAYERS + 3 )
+					{
+						strcat(subtext, language[1381]);
+					}
+					else if ( clientnum == MAXPLAYERS + 4 )
+					{
+						strcat(subtext, language[1382]);
+					}
+					else if ( clientnum == MAXPLAYERS + 5 )
+					{
+						strcat(subtext, language[1383]);
 					}
 					else
 					{
-						inputstr = EOS.currentLobbyName;
-						inputlen = 31;
+						strcat(subtext, language[1384]);
 					}
-#endif
-				}
-			}
-		}
-
-		// server flag elements
-		int i;
-		for ( i = 0; i < NUM_SERVER_FLAGS; i++ )
-		{
-			char flagStringBuffer[256] = "";
-			if ( i < 5 )
-			{
-				strncpy(flagStringBuffer, language[153 + i], 255);
-			}
-			else
-			{
-				strncpy(flagStringBuffer, language[2917 - 5 + i], 255);
-			}
+					clientnum = 0;
 
-			Uint32 displayedSvFlags = svFlags;
-			if ( multiplayer == CLIENT )
-			{
-				displayedSvFlags = lobbyWindowSvFlags;
-			}
+					// close button
+					button = newButton();
+					strcpy(button->label, "x");
+					button->x = subx2 - 20;
+					button->y = suby1;
+					button->sizex = 20;
+					button->sizey = 20;
+					button->action = &buttonCloseSubwindow;
+					button->visible = 1;
+					button->focused = 1;
+					button->key = SDL_SCANCODE_ESCAPE;
+					button->joykey = joyimpulses[INJOY_MENU_CANCEL];
 
-			if ( displayedSvFlags & power(2, i) )
-			{
-				ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 80 + 16 * i, "[x] %s", flagStringBuffer);
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 80 + 16 * i, "[ ] %s", flagStringBuffer);
-			}
-			if (mouseInBounds(clientnum, (xres / 2) + 8 + 6, (xres / 2) + 8 + 30, suby1 + 80 + (i * 16), suby1 + 92 + (i * 16)))   //So many gosh dang magic numbers ._.
-			{
-				if ( i < 5 )
-				{
-					strncpy(flagStringBuffer, language[1942 + i], 255);
+					// okay button
+					button = newButton();
+					strcpy(button->label, language[732]);
+					button->x = subx2 - (subx2 - subx1) / 2 - 28;
+					button->y = suby2 - 28;
+					button->sizex = 56;
+					button->sizey = 20;
+					button->action = &buttonCloseSubwindow;
+					button->visible = 1;
+					button->focused = 1;
+					button->key = SDL_SCANCODE_RETURN;
+					button->joykey = joyimpulses[INJOY_MENU_NEXT];
 				}
 				else
 				{
-					strncpy(flagStringBuffer, language[2921 - 5 + i], 255);
-				}
-				if (strlen(flagStringBuffer) > 0)   //Don't bother drawing a tooltip if the file doesn't say anything.
-				{
-					hovering_selection = i;
-#if !defined STEAMWORKS && !defined USE_EOS
-					if ( hovering_selection == 0 )
+					// join game succeeded, advance to lobby
+					client_keepalive[0] = ticks;
+					receivedclientnum = true;
+					SafePacketHandler.reset(); // nothing sent before we had a clientnum can be acked
+					printlog("connected to server.\n");
+					client_disconnected[clientnum] = false;
+					if ( !loadingsavegame )
 					{
-						hovering_selection = -1; // don't show cheats tooltip about disabling achievements.
+						stats[clientnum]->appearance = stats[0]->appearance;
 					}
-#endif // STEAMWORKS
-					tooltip_box.x = mousex - 256;
-					tooltip_box.y = mousey + 8;
-					tooltip_box.w = longestline(flagStringBuffer) * TTF12_WIDTH + 8; //MORE MAGIC NUMBERS. HNNGH. I can guess what they all do, but dang.
-					tooltip_box.h = TTF12_HEIGHT + 8;
-					if ( i == 2 || i == 3 || i == 5 || i == 6 || i == 7 )
+
+					// now set up everybody else
+					for ( int c = 0; c < MAXPLAYERS; c++ )
 					{
-						tooltip_box.h = TTF12_HEIGHT * 2 + 8;
+						client_disconnected[c] = false;
+						client_classes[c] = net_packet->data[4 + c * (5 + 23)]; // class
+						stats[c]->sex = static_cast<sex_t>(net_packet->data[5 + c * (5 + 23)]); // sex
+						client_disconnected[c] = net_packet->data[6 + c * (5 + 23)]; // connectedness :p
+						stats[c]->appearance = net_packet->data[7 + c * (5 + 23)]; // appearance
+						stats[c]->playerRace = net_packet->data[8 + c * (5 + 23)]; // player race
+						strcpy(stats[c]->name, (char*)(&net_packet->data[9 + c * (5 + 23)]));  // name
 					}
-					else if ( i == 4 || i == 8)
+
+					// request svFlags
+					strcpy((char*)net_packet->data, "SVFL");
+					net_packet->len = 4;
+					net_packet->address.host = net_server.host;
+					net_packet->address.port = net_server.port;
+					sendPacketSafe(net_sock, -1, net_packet, 0);
+
+					// open lobby window
+					lobby_window = true;
+					subwindow = 1;
+					subx1 = xres / 2 - 400;
+					subx2 = xres / 2 + 400;
+#ifdef PANDORA
+					suby1 = yres / 2 - ((yres==480)?230:290);
+					suby2 = yres / 2 + ((yres==480)?230:290);
+#else
+					suby1 = yres / 2 - 300;
+					suby2 = yres / 2 + 300;
+#endif
+
+					if ( directConnect )
 					{
-						tooltip_box.h = TTF12_HEIGHT * 3 + 8;
+						strcpy(subtext, language[1385]);
+						if ( !broadcast )
+						{
+							strcat(subtext, last_ip);
+						}
+						else
+						{
+							strcat(subtext, "HIDDEN FOR BROADCAST");
+						}
 					}
 					else
 					{
-						tooltip_box.h = TTF12_HEIGHT + 8;
+						strcpy(subtext, language[1386]);
 					}
-				}
-			}
-		}
+					strcat(subtext, language[1387]);
 
-		// lobby type elements
-		if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-		{
+					// disconnect button
+					button = newButton();
+					strcpy(button->label, language[1311]);
+					button->sizex = strlen(language[1311]) * 12 + 8;
+					button->sizey = 20;
+					button->x = subx1 + 4;
+					button->y = suby2 - 24;
+					button->action = &buttonDisconnect;
+					button->visible = 1;
+					button->focused = 1;
+					button->joykey = joyimpulses[INJOY_MENU_CANCEL];
 #ifdef STEAMWORKS
-			if ( multiplayer == SERVER )
-			{
-				for ( Uint32 i = 0; i < 2; i++ )
-				{
-					if ( (i == 0 && currentLobbyType == k_ELobbyTypePrivate)
-						|| (i == 1 && currentLobbyType == k_ELobbyTypePublic) )
-					{
-						ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[o] %s", language[250 + i]);
-					}
-					else
+					if ( !directConnect && LobbyHandler.getJoiningType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 					{
-						ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[ ] %s", language[250 + i]);
+						const char* serverNumModsChar = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), "svNumMods");
+						int serverNumModsLoaded = atoi(serverNumModsChar);
+						if ( serverNumModsLoaded > 0 )
+						{
+							// subscribe to server loaded mods button
+							button = newButton();
+							strcpy(button->label, language[2984]);
+							button->sizex = strlen(language[2984]) * 12 + 8;
+							button->sizey = 20;
+							button->x = subx2 - 4 - button->sizex;
+							button->y = suby2 - 24;
+							button->action = &buttonGamemodsSubscribeToHostsModFiles;
+							button->visible = 1;
+							button->focused = 1;
+
+							// mount server mods button
+							button = newButton();
+							strcpy(button->label, language[2985]);
+							button->sizex = strlen(language[2985]) * 12 + 8;
+							button->sizey = 20;
+							button->x = subx2 - 4 - button->sizex;
+							button->y = suby2 - 24;
+							button->action = &buttonGamemodsMountHostsModFiles;
+							button->visible = 0;
+							button->focused = 1;
+
+							g_SteamWorkshop->CreateQuerySubscribedItems(k_EUserUGCList_Subscribed, k_EUGCMatchingUGCType_All, k_EUserUGCListSortOrder_LastUpdatedDesc);
+							g_SteamWorkshop->subscribedCallStatus = 0;
+						}
 					}
+#endif // STEAMWORKS
 				}
 			}
-#endif
 		}
-		else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+		else if ( multiplayer == CLIENT )
 		{
+#ifdef STEAMWORKS
+			CSteamID newSteamID;
+			joinLobbyWaitingForHostResponse = false;
+#endif
 #ifdef USE_EOS
-			for ( Uint32 i = 0; i < 2; i++ )
+			EOS.bJoinLobbyWaitingForHostResponse = false;
+#endif
+			int numpacket;
+			for ( numpacket = 0; numpacket < PACKET_LIMIT && net_packet; numpacket++ )
 			{
-				if ( (i == 0 && EOS.CurrentLobbyData.LobbyAttributes.PermissionLevel == static_cast<Uint32>(EOS_ELobbyPermissionLevel::EOS_LPL_JOINVIAPRESENCE))
-					|| (i == 1 && EOS.CurrentLobbyData.LobbyAttributes.PermissionLevel == static_cast<Uint32>(EOS_ELobbyPermissionLevel::EOS_LPL_PUBLICADVERTISED)) )
+				if ( directConnect )
 				{
-					ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[o] %s", language[250 + i]);
+					if ( !SDLNet_UDP_Recv(net_sock, net_packet) )
+					{
+						break;
+					}
 				}
 				else
 				{
-					ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[ ] %s", language[250 + i]);
-				}
-			}
-
-			if ( EOS.CurrentLobbyData.LobbyAttributes.gameJoinKey.compare("") != 0 )
-			{
-				ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * 3, "Lobby invite code: %s", EOS.CurrentLobbyData.LobbyAttributes.gameJoinKey.c_str());
-			}
-#endif
-		}
-
-		if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-		{
+					if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+					{
 #ifdef STEAMWORKS
-			// server name
-			drawDepressed(xres / 2, suby1 + 56, xres / 2 + 388, suby1 + 72);
-			ttfPrintTextFormatted(ttf12, xres / 2 + 2, suby1 + 58, "%s", currentLobbyName);
-			if ( inputstr == currentLobbyName )
-			{
-				if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
-				{
-					int x;
-					getSizeOfText(ttf12, currentLobbyName, &x, NULL);
-					ttfPrintTextFormatted(ttf12, xres / 2 + 2 + x, suby1 + 58, "_");
-				}
-			}
+						uint32_t packetlen = 0;
+						if ( !SteamNetworking()->IsP2PPacketAvailable(&packetlen, 0) )
+						{
+							break;
+						}
+						packetlen = std::min<int>(packetlen, NET_PACKET_SIZE - 1);
+						Uint32 bytesRead = 0;
+						if ( !SteamNetworking()->ReadP2PPacket(net_packet->data, packetlen, &bytesRead, &newSteamID, 0) ) //TODO: Sometimes if a host closes a lobby, it can crash here for a client.
+						{
+							continue;
+						}
+						net_packet->len = packetlen;
+						if ( packetlen < sizeof(DWORD) )
+						{
+							continue;    //TODO: Again, figure out why this is happening.
+						}
 
-			// update server name
-			if ( currentLobby )
-			{
-				const char* lobbyName = SteamMatchmaking()->GetLobbyData( *static_cast<CSteamID*>(currentLobby), "name");
-				if ( lobbyName )
-				{
-					if ( strcmp(lobbyName, currentLobbyName) )
-					{
-						if ( multiplayer == CLIENT )
+						CSteamID mySteamID = SteamUser()->GetSteamID();
+						if (mySteamID.ConvertToUint64() == newSteamID.ConvertToUint64())
 						{
-							// update the lobby name on our end
-							snprintf( currentLobbyName, 31, "%s", lobbyName );
+							continue;
 						}
-						else if ( multiplayer == SERVER )
+#endif
+					}
+					else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+					{
+#if defined USE_EOS
+						EOS_ProductUserId remoteId = nullptr;
+						if ( !EOS.HandleReceivedMessages(&remoteId) )
 						{
-							// update the backend's copy of the lobby name
-							SteamMatchmaking()->SetLobbyData(*static_cast<CSteamID*>(currentLobby), "name", currentLobbyName);
+							continue;
 						}
+#endif // USE_EOS
 					}
 				}
-				if ( multiplayer == SERVER )
+
+				if ( handleSafePacket() )
 				{
-					const char* lobbyTimeStr = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), "lobbyModifiedTime");
-					if ( lobbyTimeStr )
+					continue;
+				}
+
+				// game start
+				if (!strncmp((char*)net_packet->data, "BARONY_GAME_START", 17))
+				{
+					lobbyWindowSvFlags = SDLNet_Read32(&net_packet->data[17]);
+					uniqueGameKey = SDLNet_Read32(&net_packet->data[21]);
+					buttonCloseSubwindow(NULL);
+					numplayers = MAXPLAYERS;
+					introstage = 3;
+					fadeout = true;
+					if ( net_packet->data[25] == 0 )
 					{
-						Uint32 lobbyTime = static_cast<Uint32>(atoi(lobbyTimeStr));
-						if ( SteamUtils()->GetServerRealTime() >= lobbyTime + 3 )
-						{
-							//printlog("Updated server time");
-							char modifiedTime[32];
-							snprintf(modifiedTime, 31, "%d", SteamUtils()->GetServerRealTime());
-							SteamMatchmaking()->SetLobbyData(*static_cast<CSteamID*>(currentLobby), "lobbyModifiedTime", modifiedTime);
-						}
+						loadingsavegame = 0;
 					}
+					continue;
 				}
-			}
-#endif
-		}
-		else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-		{
-#if defined USE_EOS
-			// server name
-			drawDepressed(xres / 2, suby1 + 56, xres / 2 + 388, suby1 + 72);
-			ttfPrintTextFormatted(ttf12, xres / 2 + 2, suby1 + 58, "%s", EOS.currentLobbyName);
-			if ( inputstr == EOS.currentLobbyName )
-			{
-				if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+
+				// new player
+				else if (!strncmp((char*)net_packet->data, "NEWPLAYER", 9))
 				{
-					int x;
-					getSizeOfText(ttf12, EOS.currentLobbyName, &x, NULL);
-					ttfPrintTextFormatted(ttf12, xres / 2 + 2 + x, suby1 + 58, "_");
+					client_disconnected[net_packet->data[9]] = false;
+					client_classes[net_packet->data[9]] = net_packet->data[10];
+					stats[net_packet->data[9]]->sex = static_cast<sex_t>(net_packet->data[11]);
+					stats[net_packet->data[9]]->appearance = net_packet->data[12];
+					stats[net_packet->data[9]]->playerRace = net_packet->data[13];
+					strcpy(stats[net_packet->data[9]]->name, (char*)(&net_packet->data[14]));
+
+					char shortname[32] = { 0 };
+					strncpy(shortname, stats[net_packet->data[9]]->name, 22);
+					newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1388], shortname);
+					continue;
 				}
-			}
 
-			// update server name
-			if ( multiplayer == CLIENT )
-			{
-				// update the lobby name on our end
-				snprintf(EOS.currentLobbyName, 31, "%s", EOS.CurrentLobbyData.LobbyAttributes.lobbyName.c_str());
-			}
-			else if ( multiplayer == SERVER )
-			{
-				// update the backend's copy of the lobby name and other properties
-				if ( ticks % TICKS_PER_SECOND == 0 && EOS.CurrentLobbyData.currentLobbyIsValid() )
+				// player disconnect
+				else if (!strncmp((char*)net_packet->data, "PLAYERDISCONNECT", 16) || !strncmp((char*)net_packet->data, "KICK", 4) )
 				{
-					if ( EOS.CurrentLobbyData.LobbyAttributes.lobbyName.compare(EOS.currentLobbyName) != 0
-						&& strcmp(EOS.currentLobbyName, "") != 0 )
+					int playerDisconnected = 0;
+					if ( !strncmp((char*)net_packet->data, "KICK", 4) )
 					{
-						EOS.CurrentLobbyData.updateLobbyForHost(EOSFuncs::LobbyData_t::HostUpdateLobbyTypes::LOBBY_UPDATE_MAIN_MENU);
+						playerDisconnected = clientnum;
 					}
-					else if ( EOS.CurrentLobbyData.LobbyAttributes.serverFlags != svFlags )
+					else
 					{
-						EOS.CurrentLobbyData.updateLobbyForHost(EOSFuncs::LobbyData_t::HostUpdateLobbyTypes::LOBBY_UPDATE_MAIN_MENU);
+						playerDisconnected = net_packet->data[16];
+						client_disconnected[playerDisconnected] = true;
+					}
+					if ( playerDisconnected == clientnum || net_packet->data[16] == 0 )
+					{
+						// close lobby window
+						buttonCloseSubwindow(NULL);
+						for ( node = button_l.first; node != NULL; node = nextnode )
+						{
+							nextnode = node->next;
+							button = (button_t*)node->element;
+							if ( button->focused )
+							{
+								list_RemoveNode(button->node);
+							}
+						}
+
+						// create new window
+						subwindow = 1;
+						subx1 = xres / 2 - 256;
+						subx2 = xres / 2 + 256;
+						suby1 = yres / 2 - 40;
+						suby2 = yres / 2 + 40;
+
+						if ( playerDisconnected == clientnum )
+						{
+							strcpy(subtext, language[1127]);
+						}
+						else
+						{
+							strcpy(subtext, language[1126]);
+						}
+
+						// close button
+						button = newButton();
+						strcpy(button->label, "x");
+						button->x = subx2 - 20;
+						button->y = suby1;
+						button->sizex = 20;
+						button->sizey = 20;
+						button->action = &buttonCloseSubwindow;
+						button->visible = 1;
+						button->focused = 1;
+						button->joykey = joyimpulses[INJOY_MENU_CANCEL];
+
+						// okay button
+						button = newButton();
+						strcpy(button->label, language[732]);
+						button->x = subx2 - (subx2 - subx1) / 2 - 20;
+						button->y = suby2 - 24;
+						button->sizex = 56;
+						button->sizey = 20;
+						button->action = &buttonCloseSubwindow;
+						button->visible = 1;
+						button->focused = 1;
+						button->joykey = joyimpulses[INJOY_MENU_NEXT];
+
+						// reset multiplayer status
+						multiplayer = SINGLE;
+						stats[0]->sex = stats[clientnum]->sex;
+						client_classes[0] = client_classes[clientnum];
+						strcpy(stats[0]->name, stats[clientnum]->name);
+						clientnum = 0;
+						client_disconnected[0] = false;
+						for ( int c = 1; c < MAXPLAYERS; c++ )
+						{
+							client_disconnected[c] = true;
+						}
+
+						// close any existing net interfaces
+						closeNetworkInterfaces();
+
+#ifdef STEAMWORKS
+						if ( !directConnect )
+						{
+							if ( currentLobby )
+							{
+								SteamMatchmaking()->LeaveLobby(*static_cast<CSteamID*>(currentLobby));
+								cpp_Free_CSteamID(currentLobby); //TODO: Bugger this.
+								currentLobby = NULL;
+							}
+						}
+#endif
+#if defined USE_EOS
+						if ( !directConnect )
+						{
+							if ( EOS.CurrentLobbyData.currentLobbyIsValid() )
+							{
+								EOS.leaveLobby();
+							}
+						}
+#endif
 					}
-					else if ( EOS.CurrentLobbyData.LobbyAttributes.PermissionLevel != static_cast<Uint32>(EOS.currentPermissionLevel) )
+					else
 					{
-						EOS.CurrentLobbyData.updateLobbyForHost(EOSFuncs::LobbyData_t::HostUpdateLobbyTypes::LOBBY_UPDATE_MAIN_MENU);
+						char shortname[32] = { 0 };
+						strncpy(shortname, stats[net_packet->data[16]]->name, 22);
+						newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
 					}
+					continue;
 				}
-			}
-#endif
-		}
 
-		// chatbox gui elements
-		drawDepressed(subx1 + 16, suby2 - 256, subx2 - 16, suby2 - 48);
-		drawDepressed(subx1 + 16, suby2 - 48, subx2 - 16, suby2 - 32);
+				// got a chat message
+				else if (!strncmp((char*)net_packet->data, "CMSG", 4))
+				{
+					newString(&lobbyChatboxMessages, 0xFFFFFFFF, (char*)(&net_packet->data[4]));
+					playSound(238, 64);
+					continue;
+				}
 
-		// draw chatbox main text
-		int y = suby2 - 50;
-		for ( c = 0; c < 20; c++ )
-		{
-			node_t* node = list_Node(&lobbyChatboxMessages, list_Size(&lobbyChatboxMessages) - c - 1);
-			if ( node )
-			{
-				string_t* str = (string_t*)node->element;
-				y -= str->lines * TTF12_HEIGHT;
-				if ( y < suby2 - 254 )   // there were some tall messages and we're out of space
+				// update svFlags
+				else if (!strncmp((char*)net_packet->data, "SVFL", 4))
 				{
-					break;
+					lobbyWindowSvFlags = SDLNet_Read32(&net_packet->data[4]);
+					continue;
+				}
+
+				// keepalive
+				else if (!strncmp((char*)net_packet->data, "KEEPALIVE", 9))
+				{
+					client_keepalive[0] = ticks;
+					continue; // just a keep alive
 				}
-				ttfPrintTextFormatted(ttf12, subx1 + 18, y, str->data);
-			}
-			else
-			{
-				break;
 			}
 		}
-		while ( list_Size(&lobbyChatboxMessages) > 20 )
-		{
-			// if there are too many messages to fit the chatbox, just cull them
-			list_RemoveNode(lobbyChatboxMessages.first);
-		}
+	}
+	if ( multiplayer == SINGLE )
+	{
+		receivedclientnum = false;
+	}
 
-		// handle chatbox text entry
-		if ( !SDL_IsTextInputActive() )
-		{
-			//TODO: NX PORT: Does this need to be updated for the Switch? Even if only to just disable this feature entirely?
-			// this is the default text entry box in this window.
-			inputstr = lobbyChatbox;
-			inputlen = LOBBY_CHATBOX_LENGTH - 1;
-			SDL_StartTextInput();
-		}
-		if ( keystatus[SDL_SCANCODE_RETURN] && strlen(lobbyChatbox) > 0 )
-		{
-			keystatus[SDL_SCANCODE_RETURN] = 0;
-			if ( multiplayer != CLIENT )
-			{
-				playSound(238, 64);
-			}
+	// lobby window
+	if ( lobby_window )
+	{
 
-			char shortname[32] = {0};
-			strncpy(shortname, stats[clientnum]->name, 22);
+		int hovering_selection = -1; //0 to NUM_SERVER_FLAGS used for the server flags settings, e.g. are traps, cheats, minotaur, etc enabled.
+		SDL_Rect tooltip_box;
 
-			char msg[LOBBY_CHATBOX_LENGTH + 32] = { 0 };
-			snprintf(msg, LOBBY_CHATBOX_LENGTH, "%s: %s", shortname, lobbyChatbox);
-			if ( strlen(lobbyChatbox) > LOBBY_CHATBOX_LENGTH - strlen(shortname) - 2 )
-			{
-				msg[strlen(msg)] = '\n';
-				int i;
-				for ( i = 0; i < strlen(shortname) + 2; i++ )
-				{
-					snprintf((char*)(msg + strlen(msg)), (LOBBY_CHATBOX_LENGTH + 31) - strlen(msg), " ");
-				}
-				snprintf((char*)(msg + strlen(msg)), (LOBBY_CHATBOX_LENGTH + 31) - strlen(msg), "%s", (char*)(lobbyChatbox + LOBBY_CHATBOX_LENGTH - strlen(shortname) - 2));
-			}
-			if ( multiplayer != CLIENT )
+		// player info text
+		for ( int c = 0; c < MAXPLAYERS; ++c )
+		{
+			if ( client_disconnected[c] )
 			{
-				newString(&lobbyChatboxMessages, 0xFFFFFFFF, msg);  // servers print their messages right away
+				continue;
 			}
+			string charDisplayName = "";
+			charDisplayName = stats[c]->name;
 
-			int playerToKick = -1;
-			bool skipMessageRelayToClients = false;
-			if ( multiplayer == SERVER )
+			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 			{
-				std::string chatboxStr = lobbyChatbox;
-				if ( (chatboxStr.size() > strlen("/kick ")) 
-					&& chatboxStr.find("/kick ") != std::string::npos && chatboxStr.find("/kick ") == size_t(0U) )
+#ifdef STEAMWORKS
+				if ( c != clientnum )
 				{
-					// find player num to kick
-					chatboxStr = chatboxStr.substr(chatboxStr.find("/kick ") + strlen("/kick "));
-					std::istringstream(chatboxStr) >> playerToKick;
-					playerToKick -= 1;
-					if ( playerToKick > 0 && playerToKick < MAXPLAYERS )
+					for ( int remoteIDIndex = 0; remoteIDIndex < MAXPLAYERS; ++remoteIDIndex )
 					{
-						char kickMsg[LOBBY_CHATBOX_LENGTH + 32] = { 0 };
-						if ( !client_disconnected[playerToKick] )
-						{
-							char clientShortName[32] = { 0 };
-							strncpy(clientShortName, stats[playerToKick]->name, 22);
-							snprintf(kickMsg, LOBBY_CHATBOX_LENGTH, language[279], playerToKick + 1, clientShortName);
-							newString(&lobbyChatboxMessages, 0xFFFFFFFF, kickMsg);  // servers print their messages right away
-
-							strcpy(msg, kickMsg);
-						}
-						else
+						if ( steamIDRemote[remoteIDIndex] )
 						{
-							newString(&lobbyChatboxMessages, 0xFFFFFFFF, "***   Invalid player to kick   ***");
-							skipMessageRelayToClients = true;
-							playerToKick = -1;
+							const char* memberNumChar = SteamMatchmaking()->GetLobbyMemberData(*static_cast<CSteamID*>(currentLobby), *static_cast<CSteamID*>(steamIDRemote[remoteIDIndex]), "clientnum");
+							if ( memberNumChar )
+							{
+								std::string str = memberNumChar;
+								if ( str.compare("") != 0 )
+								{
+									int memberNum = std::stoi(str);
+									if ( memberNum >= 0 && memberNum < MAXPLAYERS && memberNum == c )
+									{
+										charDisplayName += " (";
+										charDisplayName += SteamFriends()->GetFriendPersonaName(*static_cast<CSteamID*>(steamIDRemote[remoteIDIndex]));
+										charDisplayName += ")";
+									}
+								}
+							}
 						}
 					}
-					else
+				}
+				else
+				{
+					charDisplayName += " (";
+					charDisplayName += SteamFriends()->GetPersonaName();
+					charDisplayName += ")";
+
+					if ( currentLobby )
 					{
-						newString(&lobbyChatboxMessages, 0xFFFFFFFF, "***   Invalid player to kick   ***");
-						skipMessageRelayToClients = true;
-						playerToKick = -1;
+						if ( ticks % 10 == 0 )
+						{
+							const char* memberNumChar = SteamMatchmaking()->GetLobbyMemberData(*static_cast<CSteamID*>(currentLobby), SteamUser()->GetSteamID(), "clientnum");
+							if ( memberNumChar )
+							{
+								std::string str = memberNumChar;
+								if ( str.compare("") == 0 || str.compare(std::to_string(clientnum)) != 0 )
+								{
+									SteamMatchmaking()->SetLobbyMemberData(*static_cast<CSteamID*>(currentLobby), "clientnum", std::to_string(clientnum).c_str());
+									printlog("[STEAM Lobbies]: Updating clientnum %d to lobby member data", clientnum);
+								}
+							}
+						}
 					}
 				}
+#endif
 			}
-
-			strcpy(lobbyChatbox, "");
-
-			// send the message
-			strcpy((char*)net_packet->data, "CMSG");
-			strcat((char*)(net_packet->data), msg);
-			net_packet->len = 4 + strlen(msg) + 1;
-			net_packet->data[net_packet->len - 1] = 0;
-			if ( multiplayer == CLIENT )
-			{
-				net_packet->address.host = net_server.host;
-				net_packet->address.port = net_server.port;
-				sendPacketSafe(net_sock, -1, net_packet, 0);
-			}
-			else if ( multiplayer == SERVER )
+			else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 			{
-				for ( int i = 1; i < MAXPLAYERS; i++ )
+#if defined USE_EOS
+				if ( c == clientnum )
 				{
-					if ( client_disconnected[i] )
-					{
-						continue;
-					}
-					if ( playerToKick == i )
-					{
-						continue;
-					}
-					if ( skipMessageRelayToClients )
+					charDisplayName += " (";
+					charDisplayName += EOS.CurrentUserInfo.Name;
+					charDisplayName += ")";
+
+					if ( EOS.CurrentLobbyData.currentLobbyIsValid()
+						&& EOS.CurrentLobbyData.getClientnumMemberAttribute(EOS.CurrentUserInfo.getProductUserIdHandle()) < 0 )
 					{
-						continue;
+						if ( EOS.CurrentLobbyData.assignClientnumMemberAttribute(EOS.CurrentUserInfo.getProductUserIdHandle(), clientnum) )
+						{
+							EOS.CurrentLobbyData.modifyLobbyMemberAttributeForCurrentUser();
+						}
 					}
-					net_packet->address.host = net_clients[i - 1].host;
-					net_packet->address.port = net_clients[i - 1].port;
-					sendPacketSafe(net_sock, -1, net_packet, i - 1);
 				}
-
-				if ( playerToKick > 0 )
+				else
 				{
-					// send message to kicked player
-					strcpy((char*)net_packet->data, "KICK");
-					net_packet->address.host = net_clients[playerToKick - 1].host;
-					net_packet->address.port = net_clients[playerToKick - 1].port;
-					net_packet->len = 4;
-					sendPacketSafe(net_sock, -1, net_packet, playerToKick - 1);
-
-					client_disconnected[playerToKick] = true;
-					// notify everyone else.
-					for ( int i = 1; i < MAXPLAYERS; i++ )
+					for ( auto& player : EOS.CurrentLobbyData.playersInLobby )
 					{
-						if ( client_disconnected[i] )
+						if ( player.clientNumber == c )
 						{
-							continue;
+							charDisplayName += " (";
+							charDisplayName += player.name;
+							charDisplayName += ")";
 						}
-						strncpy((char*)(net_packet->data), "PLAYERDISCONNECT", 16);
-						net_packet->data[16] = playerToKick;
-						net_packet->address.host = net_clients[i - 1].host;
-						net_packet->address.port = net_clients[i - 1].port;
-						net_packet->len = 17;
-						sendPacketSafe(net_sock, -1, net_packet, i - 1);
 					}
-					char shortname[32] = { 0 };
-					strncpy(shortname, stats[playerToKick]->name, 22);
-					newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
 				}
+#endif
 			}
-		}
 
-		// draw chatbox entry text and cursor
-		ttfPrintTextFormatted(ttf12, subx1 + 18, suby2 - 46, ">%s", lobbyChatbox);
-		if ( inputstr == lobbyChatbox )
-		{
-			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+			std::string raceAndClass = language[3161 + stats[c]->playerRace];
+			raceAndClass += " ";
+			if ( stats[c]->playerRace > RACE_HUMAN && stats[c]->appearance != 0 )
 			{
-				int x;
-				getSizeOfText(ttf12, lobbyChatbox, &x, NULL);
-				ttfPrintTextFormatted(ttf12, subx1 + 18 + x + TTF12_WIDTH, suby2 - 46, "_");
+				raceAndClass += "(aesthetic) ";
 			}
-		}
+			raceAndClass += playerClassLangEntry(client_classes[c], c);
 
-		if (hovering_selection > -1)
-		{
-			drawTooltip(&tooltip_box);
-			char flagStringBuffer[256] = "";
-			if ( hovering_selection < 5 )
+			if ( charDisplayName.size() > 39 )
 			{
-				strncpy(flagStringBuffer, language[1942 + hovering_selection], 255);
+				charDisplayName = charDisplayName.substr(0, 37);
+				charDisplayName += "..";
 			}
-			else
+
+			if ( stats[c]->sex )
 			{
-				strncpy(flagStringBuffer, language[2921 - 5 + hovering_selection], 255);
+				ttfPrintTextFormatted(ttf12, subx1 + 8, suby1 + 80 + 60 * c, "%d:  %s\n    %s\n    %s", c + 1, charDisplayName.c_str(), language[1322], raceAndClass.c_str());
 			}
-			if (hovering_selection < NUM_SERVER_FLAGS)
+			else
 			{
-				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, flagStringBuffer);
+				ttfPrintTextFormatted(ttf12, subx1 + 8, suby1 + 80 + 60 * c, "%d:  %s\n    %s\n    %s", c + 1, charDisplayName.c_str(), language[1321], raceAndClass.c_str());
 			}
 		}
-#ifdef STEAMWORKS
-		// draw server workshop mod list
-		if ( !directConnect && currentLobby )
+
+		// select gui element w/ mouse
+		if ( inputs.bMouseLeft(clientnum) )
 		{
-			const char* serverNumModsChar = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), "svNumMods");
-			int serverNumModsLoaded = atoi(serverNumModsChar);
-			if ( serverNumModsLoaded > 0 )
+			if ( mouseInBounds(clientnum, subx1 + 16, subx2 - 16, suby2 - 48, suby2 - 32) )
 			{
-				char tagName[32];
-				std::vector<std::string> serverFileIdsLoaded;
-				std::string modList = "Clients can click '";
-				modList.append(language[2984]).append("' and \n'").append(language[2985]);
-				modList.append("' to automatically subscribe and \n");
-				modList.append("mount workshop items loaded in the host's lobby.\n\n");
-				modList.append("All clients should be running the same mod load order\n");
-				modList.append("to prevent any crashes or undefined behavior.\n\n");
-				modList.append("Game client may need to be closed to install and detect\nnew subscriptions due to Workshop limitations.\n");
-				int numToolboxLines = 9;
-				bool itemNeedsSubscribing = false;
-				bool itemNeedsMounting = false;
-				Uint32 modsStatusColor = uint32ColorBaronyBlue(*mainsurface);
-				bool modListOutOfOrder = false;
-				for ( int lines = 0; lines < serverNumModsLoaded; ++lines )
+				inputs.mouseClearLeft(clientnum);
+
+				// chatbox
+				inputstr = lobbyChatbox;
+				inputlen = LOBBY_CHATBOX_LENGTH - 1;
+				cursorflash = ticks;
+			}
+			else if ( mouseInBounds(clientnum, xres / 2, subx2 - 32, suby1 + 56, suby1 + 68) && !directConnect )
+			{
+				inputs.mouseClearLeft(clientnum);
+
+				// lobby name
+				if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 				{
-					snprintf(tagName, 32, "svMod%d", lines);
-					const char* serverModFileID = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), tagName);
-					if ( strcmp(serverModFileID, "") )
-					{
-						if ( gamemodsCheckIfSubscribedAndDownloadedFileID(atoi(serverModFileID)) == false )
-						{
-							modList.append("Workshop item not subscribed or installed: ");
-							modList.append(serverModFileID);
-							modList.append("\n");
-							itemNeedsSubscribing = true;
-							++numToolboxLines;
-						}
-						else if ( gamemodsCheckFileIDInLoadedPaths(atoi(serverModFileID)) == false )
-						{
-							modList.append("Workshop item downloaded but not loaded: ");
-							modList.append(serverModFileID);
-							modList.append("\n");
-							itemNeedsMounting = true;
-							++numToolboxLines;
-						}
-						serverFileIdsLoaded.push_back(serverModFileID);
-					}
+#ifdef STEAMWORKS
+					inputstr = currentLobbyName;
+					inputlen = 31;
+#endif
 				}
-				if ( itemNeedsSubscribing )
+				else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 				{
-					for ( node = button_l.first; node != NULL; node = nextnode )
-					{
-						nextnode = node->next;
-						button = (button_t*)node->element;
-						if ( button->action == &buttonGamemodsMountHostsModFiles )
-						{
-							button->visible = 0;
-						}
-						if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
-						{
-							button->visible = 1;
-						}
-					}
+#if defined USE_EOS
+					inputstr = EOS.currentLobbyName;
+					inputlen = 31;
+#endif
 				}
-				else
+				cursorflash = ticks;
+			}
+
+			// server flags
+			int i;
+			if ( multiplayer == SERVER )
+			{
+				for ( i = 0; i < NUM_SERVER_FLAGS; i++ )
 				{
-					if ( itemNeedsMounting )
+					if ( mouseInBounds(clientnum, xres / 2 + 8 + 6, xres / 2 + 8 + 30, suby1 + 80 + i * 16, suby1 + 92 + i * 16) )
 					{
-						modsStatusColor = uint32ColorOrange(*mainsurface);
-						for ( node = button_l.first; node != NULL; node = nextnode )
+						inputs.mouseClearLeft(clientnum);
+
+						// toggle flag
+						svFlags ^= power(2, i);
+
+						// update client flags
+						strcpy((char*)net_packet->data, "SVFL");
+						SDLNet_Write32(svFlags, &net_packet->data[4]);
+						net_packet->len = 8;
+
+						int c;
+						for ( c = 1; c < MAXPLAYERS; c++ )
 						{
-							nextnode = node->next;
-							button = (button_t*)node->element;
-							if ( button->action == &buttonGamemodsMountHostsModFiles )
-							{
-								button->visible = 1;
-							}
-							if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+							if ( client_disconnected[c] )
 							{
-								button->visible = 0;
+								continue;
 							}
+							net_packet->address.host = net_clients[c - 1].host;
+							net_packet->address.port = net_clients[c - 1].port;
+							sendPacketSafe(net_sock, -1, net_packet, c - 1);
+						}
+
+						// update lobby data
+						if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+						{
+#ifdef STEAMWORKS
+							char svFlagsChar[16];
+							snprintf(svFlagsChar, 15, "%d", svFlags);
+							SteamMatchmaking()->SetLobbyData(*static_cast<CSteamID*>(currentLobby), "svFlags", svFlagsChar);
+#endif
 						}
 					}
-					else if ( gamemodsIsClientLoadOrderMatchingHost(serverFileIdsLoaded)
-						&& serverFileIdsLoaded.size() == gamemods_workshopLoadedFileIDMap.size() )
+				}
+			}
+
+			// switch lobby type
+			if ( multiplayer == SERVER && !directConnect )
+			{
+				if ( LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+				{
+#ifdef STEAMWORKS
+					for ( Uint32 i = 0; i < 2; i++ )
 					{
-						modsStatusColor = uint32ColorGreen(*mainsurface);
-						for ( node = button_l.first; node != NULL; node = nextnode )
+						if ( mouseInBounds(clientnum, xres / 2 + 8 + 6, xres / 2 + 8 + 30, suby1 + 256 + i * 16, suby1 + 268 + i * 16) )
 						{
-							nextnode = node->next;
-							button = (button_t*)node->element;
-							if ( button->action == &buttonGamemodsMountHostsModFiles )
-							{
-								button->visible = 0;
-							}
-							if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+							inputs.mouseClearLeft(clientnum);
+							switch ( i )
 							{
-								button->visible = 0;
+								default:
+									currentLobbyType = k_ELobbyTypePrivate;
+									break;
+								case 1:
+									currentLobbyType = k_ELobbyTypePublic;
+									break;
+								/*case 2:
+									currentLobbyType = k_ELobbyTypeFriendsOnly;
+									// deprecated by steam, doesn't return in getLobbyList.
+									break;*/
 							}
+							SteamMatchmaking()->SetLobbyType(*static_cast<CSteamID*>(currentLobby), currentLobbyType);
 						}
 					}
-					else
+#endif
+				}
+				else if ( LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+				{
+#ifdef USE_EOS
+					for ( Uint32 i = 0; i < 2; i++ )
 					{
-						modsStatusColor = uint32ColorOrange(*mainsurface);
-						modListOutOfOrder = true;
-						for ( node = button_l.first; node != NULL; node = nextnode )
+						if ( mouseInBounds(clientnum, xres / 2 + 8 + 6, xres / 2 + 8 + 30, suby1 + 256 + i * 16, suby1 + 268 + i * 16) )
 						{
-							nextnode = node->next;
-							button = (button_t*)node->element;
-							if ( button->action == &buttonGamemodsMountHostsModFiles )
-							{
-								button->visible = 1;
-							}
-							if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+							inputs.mouseClearLeft(clientnum);
+							switch ( i )
 							{
-								button->visible = 0;
+								default:
+									EOS.currentPermissionLevel = EOS_ELobbyPermissionLevel::EOS_LPL_JOINVIAPRESENCE;
+									break;
+								case 1:
+									EOS.currentPermissionLevel = EOS_ELobbyPermissionLevel::EOS_LPL_PUBLICADVERTISED;
+									break;
 							}
 						}
 					}
+#endif
 				}
-				ttfPrintTextFormattedColor(ttf12, xres / 2 + 8, suby1 + 304, modsStatusColor, "%2d mod(s) loaded by host (?)", serverNumModsLoaded);
-				std::string modStatusString;
-				if ( itemNeedsSubscribing )
-				{
-					modStatusString = "Your client is missing mods in subscriptions";
-				}
-				else if ( itemNeedsMounting )
-				{
-					modStatusString = "Your client is missing mods in load order";
-				}
-				else if ( modListOutOfOrder )
+			}
+		}
+
+		// switch textboxes with TAB
+		if ( multiplayer == SERVER )
+		{
+			if ( keystatus[SDL_SCANCODE_TAB] )
+			{
+				keystatus[SDL_SCANCODE_TAB] = 0;
+				if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 				{
-					modStatusString = "Your client mod list is out of order";
+#ifdef STEAMWORKS
+					if ( inputstr == currentLobbyName )
+					{
+						inputstr = lobbyChatbox;
+						inputlen = LOBBY_CHATBOX_LENGTH - 1;
+					}
+					else
+					{
+						inputstr = currentLobbyName;
+						inputlen = 31;
+					}
+#endif
 				}
-				else
+				else if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 				{
-					modStatusString = "Your client has complete mod list";
+#if defined USE_EOS
+					if ( inputstr == EOS.currentLobbyName )
+					{
+						inputstr = lobbyChatbox;
+						inputlen = LOBBY_CHATBOX_LENGTH - 1;
+					}
+					else
+					{
+						inputstr = EOS.currentLobbyName;
+						inputlen = 31;
+					}
+#endif
 				}
+			}
+		}
 
-				int lineStartListLoadedMods = numToolboxLines;
-				numToolboxLines += serverNumModsLoaded + 3;
-				std::string clientModString = "Your client mod list:\n";
-				for ( std::vector<std::pair<std::string, uint64>>::iterator it = gamemods_workshopLoadedFileIDMap.begin(); 
-					it != gamemods_workshopLoadedFileIDMap.end(); ++it )
+		// server flag elements
+		int i;
+		for ( i = 0; i < NUM_SERVER_FLAGS; i++ )
+		{
+			char flagStringBuffer[256] = "";
+			if ( i < 5 )
+			{
+				strncpy(flagStringBuffer, language[153 + i], 255);
+			}
+			else
+			{
+				strncpy(flagStringBuffer, language[2917 - 5 + i], 255);
+			}
+
+			Uint32 displayedSvFlags = svFlags;
+			if ( multiplayer == CLIENT )
+			{
+				displayedSvFlags = lobbyWindowSvFlags;
+			}
+
+			if ( displayedSvFlags & power(2, i) )
+			{
+				ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 80 + 16 * i, "[x] %s", flagStringBuffer);
+			}
+			else
+			{
+				ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 80 + 16 * i, "[ ] %s", flagStringBuffer);
+			}
+			if (mouseInBounds(clientnum, (xres / 2) + 8 + 6, (xres / 2) + 8 + 30, suby1 + 80 + (i * 16), suby1 + 92 + (i * 16)))   //So many gosh dang magic numbers ._.
+			{
+				if ( i < 5 )
 				{
-					clientModString.append(std::to_string(it->second));
-					clientModString.append("\n");
+					strncpy(flagStringBuffer, language[1942 + i], 255);
 				}
-				std::string serverModString = "Server mod list:\n";
-				for ( std::vector<std::string>::iterator it = serverFileIdsLoaded.begin(); it != serverFileIdsLoaded.end(); ++it )
+				else
 				{
-					serverModString.append(*it);
-					serverModString.append("\n");
+					strncpy(flagStringBuffer, language[2921 - 5 + i], 255);
 				}
-
-				ttfPrintTextFormattedColor(ttf12, xres / 2 + 8, suby1 + 320, modsStatusColor, "%s", modStatusString.c_str());
-				if ( mouseInBounds(clientnum, xres / 2 + 8, xres / 2 + 8 + 31 * TTF12_WIDTH, suby1 + 304, suby1 + 320 + TTF12_HEIGHT) )
+				if (strlen(flagStringBuffer) > 0)   //Don't bother drawing a tooltip if the file doesn't say anything.
 				{
-					tooltip_box.w = 60 * TTF12_WIDTH + 8;
-					tooltip_box.x = mousex - 16 - tooltip_box.w;
+					hovering_selection = i;
+#if !defined STEAMWORKS && !defined USE_EOS
+					if ( hovering_selection == 0 )
+					{
+						hovering_selection = -1; // don't show cheats tooltip about disabling achievements.
+					}
+#endif // STEAMWORKS
+					tooltip_box.x = mousex - 256;
 					tooltip_box.y = mousey + 8;
-					tooltip_box.h = numToolboxLines * TTF12_HEIGHT + 8;
-					drawTooltip(&tooltip_box);
-					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 8, "%s", modList.c_str());
-					ttfPrintTextFormattedColor(ttf12, tooltip_box.x + 4, tooltip_box.y + lineStartListLoadedMods * TTF12_HEIGHT + 16,
-						modsStatusColor, "%s", clientModString.c_str());
-					ttfPrintTextFormattedColor(ttf12, tooltip_box.x + 4 + 24 * TTF12_WIDTH, tooltip_box.y + lineStartListLoadedMods * TTF12_HEIGHT + 16, 
-						modsStatusColor, "%s", serverModString.c_str());
-				}
-				if ( multiplayer == CLIENT && itemNeedsMounting )
-				{
-					if ( g_SteamWorkshop->subscribedCallStatus == 1 )
+					tooltip_box.w = longestline(flagStringBuffer) * TTF12_WIDTH + 8; //MORE MAGIC NUMBERS. HNNGH. I can guess what they all do, but dang.
+					tooltip_box.h = TTF12_HEIGHT + 8;
+					if ( i == 2 || i == 3 || i == 5 || i == 6 || i == 7 )
 					{
-						ttfPrintTextFormattedColor(ttf12, subx2 - 64 * TTF12_WIDTH, suby2 - 4 - TTF12_HEIGHT, uint32ColorOrange(*mainsurface), 
-							"retrieving data...");
+						tooltip_box.h = TTF12_HEIGHT * 2 + 8;
 					}
-					else if ( g_SteamWorkshop->subscribedCallStatus == 2 )
+					else if ( i == 4 || i == 8)
 					{
-						ttfPrintTextFormattedColor(ttf12, subx2 - 64 * TTF12_WIDTH, suby2 - 4 - TTF12_HEIGHT, uint32ColorOrange(*mainsurface),
-							"please retry mount operation.");
+						tooltip_box.h = TTF12_HEIGHT * 3 + 8;
 					}
 					else
 					{
-						ttfPrintTextFormattedColor(ttf12, subx2 - 64 * TTF12_WIDTH, suby2 - 4 - TTF12_HEIGHT, uint32ColorOrange(*mainsurface),
-							"press mount button.");
+						tooltip_box.h = TTF12_HEIGHT + 8;
 					}
 				}
 			}
 		}
-#endif // STEAMWORKS
 
-		// handle keepalive timeouts (lobby)
-		if ( multiplayer == SERVER )
+		// lobby type elements
+		if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 		{
-			for ( int i = 1; i < MAXPLAYERS; i++ )
+#ifdef STEAMWORKS
+			if ( multiplayer == SERVER )
 			{
-				if ( client_disconnected[i] )
-				{
-					continue;
-				}
-				bool clientHasLostP2P = false;
-				if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+				for ( Uint32 i = 0; i < 2; i++ )
 				{
-#ifdef STEAMWORKS
-					if ( !steamIDRemote[i - 1] )
+					if ( (i == 0 && currentLobbyType == k_ELobbyTypePrivate)
+						|| (i == 1 && currentLobbyType == k_ELobbyTypePublic) )
 					{
-						clientHasLostP2P = true;
+						ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[o] %s", language[250 + i]);
 					}
-#endif
-				}
-				else if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
-				{
-#ifdef USE_EOS
-					if ( !EOS.P2PConnectionInfo.isPeerStillValid(i - 1) )
+					else
 					{
-						clientHasLostP2P = true;
+						ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[ ] %s", language[250 + i]);
 					}
+				}
+			}
 #endif
+		}
+		else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+		{
+#ifdef USE_EOS
+			for ( Uint32 i = 0; i < 2; i++ )
+			{
+				if ( (i == 0 && EOS.CurrentLobbyData.LobbyAttributes.PermissionLevel == static_cast<Uint32>(EOS_ELobbyPermissionLevel::EOS_LPL_JOINVIAPRESENCE))
+					|| (i == 1 && EOS.CurrentLobbyData.LobbyAttributes.PermissionLevel == static_cast<Uint32>(EOS_ELobbyPermissionLevel::EOS_LPL_PUBLICADVERTISED)) )
+				{
+					ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[o] %s", language[250 + i]);
 				}
-				if ( clientHasLostP2P || (ticks - client_keepalive[i] > TICKS_PER_SECOND * 30) )
+				else
 				{
-					client_disconnected[i] = true;
-					strncpy((char*)(net_packet->data), "PLAYERDISCONNECT", 16);
-					net_packet->data[16] = i;
-					net_packet->len = 17;
-					for ( int c = 1; c < MAXPLAYERS; c++ )
-					{
-						if ( client_disconnected[c] )
-						{
-							continue;
-						}
-						net_packet->address.host = net_clients[c - 1].host;
-						net_packet->address.port = net_clients[c - 1].port;
-						sendPacketSafe(net_sock, -1, net_packet, c - 1);
-					}
-					char shortname[32] = { 0 };
-					strncpy(shortname, stats[i]->name, 22);
-					newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
-					continue;
+					ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * i, "[ ] %s", language[250 + i]);
 				}
 			}
+
+			if ( EOS.CurrentLobbyData.LobbyAttributes.gameJoinKey.compare("") != 0 )
+			{
+				ttfPrintTextFormatted(ttf12, xres / 2 + 8, suby1 + 256 + 16 * 3, "Lobby invite code: %s", EOS.CurrentLobbyData.LobbyAttributes.gameJoinKey.c_str());
+			}
+#endif
 		}
-		else if ( multiplayer == CLIENT )
+
+		if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 		{
-			bool hostHasLostP2P = false;
-			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
-			{
 #ifdef STEAMWORKS
-				if ( !steamIDRemote[0] )
+			// server name
+			drawDepressed(xres / 2, suby1 + 56, xres / 2 + 388, suby1 + 72);
+			ttfPrintTextFormatted(ttf12, xres / 2 + 2, suby1 + 58, "%s", currentLobbyName);
+			if ( inputstr == currentLobbyName )
+			{
+				if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
 				{
-					hostHasLostP2P = true;
+					int x;
+					getSizeOfText(ttf12, currentLobbyName, &x, NULL);
+					ttfPrintTextFormatted(ttf12, xres / 2 + 2 + x, suby1 + 58, "_");
 				}
-#endif
 			}
-			else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+
+			// update server name
+			if ( currentLobby )
 			{
-#ifdef USE_EOS
-				if ( !EOS.P2PConnectionInfo.isPeerStillValid(0) )
+				const char* lobbyName = SteamMatchmaking()->GetLobbyData( *static_cast<CSteamID*>(currentLobby), "name");
+				if ( lobbyName )
 				{
-					hostHasLostP2P = true;
+					if ( strcmp(lobbyName, currentLobbyName) )
+					{
+						if ( multiplayer == CLIENT )
+						{
+							// update the lobby name on our end
+							snprintf( currentLobbyName, 31, "%s", lobbyName );
+						}
+						else if ( multiplayer == SERVER )
+						{
+							// update the backend's copy of the lobby name
+							SteamMatchmaking()->SetLobbyData(*static_cast<CSteamID*>(currentLobby), "name", currentLobbyName);
+						}
+					}
+				}
+				if ( multiplayer == SERVER )
+				{
+					const char* lobbyTimeStr = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), "lobbyModifiedTime");
+					if ( lobbyTimeStr )
+					{
+						Uint32 lobbyTime = static_cast<Uint32>(atoi(lobbyTimeStr));
+						if ( SteamUtils()->GetServerRealTime() >= lobbyTime + 3 )
+						{
+							//printlog("Updated server time");
+							char modifiedTime[32];
+							snprintf(modifiedTime, 31, "%d", SteamUtils()->GetServerRealTime());
+							SteamMatchmaking()->SetLobbyData(*static_cast<CSteamID*>(currentLobby), "lobbyModifiedTime", modifiedTime);
+						}
+					}
 				}
-#endif
 			}
-
-			if ( hostHasLostP2P || (ticks - client_keepalive[0] > TICKS_PER_SECOND * 30) )
+#endif
+		}
+		else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+		{
+#if defined USE_EOS
+			// server name
+			drawDepressed(xres / 2, suby1 + 56, xres / 2 + 388, suby1 + 72);
+			ttfPrintTextFormatted(ttf12, xres / 2 + 2, suby1 + 58, "%s", EOS.currentLobbyName);
+			if ( inputstr == EOS.currentLobbyName )
 			{
-				buttonDisconnect(NULL);
-				openFailedConnectionWindow(3); // lost connection to server box
+				if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+				{
+					int x;
+					getSizeOfText(ttf12, EOS.currentLobbyName, &x, NULL);
+					ttfPrintTextFormatted(ttf12, xres / 2 + 2 + x, suby1 + 58, "_");
+				}
 			}
-		}
 
-		// send keepalive messages every second
-		if ( ticks % (TICKS_PER_SECOND * 1) == 0 && multiplayer != SINGLE )
-		{
-			strcpy((char*)net_packet->data, "KEEPALIVE");
-			net_packet->data[9] = clientnum;
-			net_packet->len = 10;
+			// update server name
 			if ( multiplayer == CLIENT )
 			{
-				net_packet->address.host = net_server.host;
-				net_packet->address.port = net_server.port;
-				sendPacketSafe(net_sock, -1, net_packet, 0);
+				// update the lobby name on our end
+				snprintf(EOS.currentLobbyName, 31, "%s", EOS.CurrentLobbyData.LobbyAttributes.lobbyName.c_str());
 			}
 			else if ( multiplayer == SERVER )
 			{
-				int i;
-				for ( i = 1; i < MAXPLAYERS; i++ )
+				// update the backend's copy of the lobby name and other properties
+				if ( ticks % TICKS_PER_SECOND == 0 && EOS.CurrentLobbyData.currentLobbyIsValid() )
 				{
-					if ( client_disconnected[i] )
+					if ( EOS.CurrentLobbyData.LobbyAttributes.lobbyName.compare(EOS.currentLobbyName) != 0
+						&& strcmp(EOS.currentLobbyName, "") != 0 )
 					{
-						continue;
+						EOS.CurrentLobbyData.updateLobbyForHost(EOSFuncs::LobbyData_t::HostUpdateLobbyTypes::LOBBY_UPDATE_MAIN_MENU);
+					}
+					else if ( EOS.CurrentLobbyData.LobbyAttributes.serverFlags != svFlags )
+					{
+						EOS.CurrentLobbyData.updateLobbyForHost(EOSFuncs::LobbyData_t::HostUpdateLobbyTypes::LOBBY_UPDATE_MAIN_MENU);
+					}
+					else if ( EOS.CurrentLobbyData.LobbyAttributes.PermissionLevel != static_cast<Uint32>(EOS.currentPermissionLevel) )
+					{
+						EOS.CurrentLobbyData.updateLobbyForHost(EOSFuncs::LobbyData_t::HostUpdateLobbyTypes::LOBBY_UPDATE_MAIN_MENU);
 					}
-					net_packet->address.host = net_clients[i - 1].host;
-					net_packet->address.port = net_clients[i - 1].port;
-					sendPacketSafe(net_sock, -1, net_packet, i - 1);
 				}
 			}
+#endif
 		}
-	}
 
-	// leaderboards window
-#ifdef STEAMWORKS
-	if ( score_leaderboard_window != 0 && g_SteamLeaderboards )
-	{
-		int numEntriesToShow = 15;
-		int filenameMaxLength = 48;
-		int filename_padx = subx1 + 16;
-		int filename_pady = suby1 + 32;
-		int filename_padx2 = subx2 - 16 - 40;
-		int filename_pady2 = filename_pady + numEntriesToShow * TTF12_HEIGHT + 8;
-		int filename_rowHeight = TTF12_HEIGHT + 4;
-		int numEntriesTotal = 0;
+		// chatbox gui elements
+		drawDepressed(subx1 + 16, suby2 - 256, subx2 - 16, suby2 - 48);
+		drawDepressed(subx1 + 16, suby2 - 48, subx2 - 16, suby2 - 32);
 
-		ttfPrintTextFormattedColor(ttf16, filename_padx, filename_pady, uint32ColorWhite(*mainsurface), "%s", 
-			g_SteamLeaderboards->leaderboardNames[g_SteamLeaderboards->LeaderboardView.boardToDownload].c_str());
+		// draw chatbox main text
+		int y = suby2 - 50;
+		for ( c = 0; c < 20; c++ )
+		{
+			node_t* node = list_Node(&lobbyChatboxMessages, list_Size(&lobbyChatboxMessages) - c - 1);
+			if ( node )
+			{
+				string_t* str = (string_t*)node->element;
+				y -= str->lines * TTF12_HEIGHT;
+				if ( y < suby2 - 254 )   // there were some tall messages and we're out of space
+				{
+					break;
+				}
+				ttfPrintTextFormatted(ttf12, subx1 + 18, y, str->data);
+			}
+			else
+			{
+				break;
+			}
+		}
+		while ( list_Size(&lobbyChatboxMessages) > 20 )
+		{
+			// if there are too many messages to fit the chatbox, just cull them
+			list_RemoveNode(lobbyChatboxMessages.first);
+		}
 
-		filename_pady += 3 * TTF12_HEIGHT;
-		if ( !g_SteamLeaderboards->b_LeaderboardInit )
+		// handle chatbox text entry
+		if ( !SDL_IsTextInputActive() )
 		{
-			// waiting for leaderboard to be found...
+			//TODO: NX PORT: Does this need to be updated for the Switch? Even if only to just disable this feature entirely?
+			// this is the default text entry box in this window.
+			inputstr = lobbyChatbox;
+			inputlen = LOBBY_CHATBOX_LENGTH - 1;
+			SDL_StartTextInput();
 		}
-		else if ( g_SteamLeaderboards->b_LeaderboardInit && !g_SteamLeaderboards->b_ScoresDownloaded )
+		if ( keystatus[SDL_SCANCODE_RETURN] && strlen(lobbyChatbox) > 0 )
 		{
-			// wait for leaderboard to be downloaded...
-			if ( score_leaderboard_window == 1 )
+			keystatus[SDL_SCANCODE_RETURN] = 0;
+			if ( multiplayer != CLIENT )
 			{
-				g_SteamLeaderboards->DownloadScores(g_SteamLeaderboards->LeaderboardView.requestType, g_SteamLeaderboards->LeaderboardView.rangeStart,
-					g_SteamLeaderboards->LeaderboardView.rangeEnd);
-				score_leaderboard_window = 2;
+				playSound(238, 64);
 			}
-			ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady + 2 * TTF12_HEIGHT, uint32ColorOrange(*mainsurface), "Downloading entries...");
-		}
-		else 
-		{
 
-			if ( g_SteamLeaderboards->b_ScoresDownloaded )
+			char shortname[32] = {0};
+			strncpy(shortname, stats[clientnum]->name, 22);
+
+			char msg[LOBBY_CHATBOX_LENGTH + 32] = { 0 };
+			snprintf(msg, LOBBY_CHATBOX_LENGTH, "%s: %s", shortname, lobbyChatbox);
+			if ( strlen(lobbyChatbox) > LOBBY_CHATBOX_LENGTH - strlen(shortname) - 2 )
 			{
-				numEntriesTotal = g_SteamLeaderboards->m_nLeaderboardEntries;
-				if ( numEntriesTotal <= 0 )
+				msg[strlen(msg)] = '\n';
+				int i;
+				for ( i = 0; i < strlen(shortname) + 2; i++ )
 				{
-					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady + 2 * TTF12_HEIGHT, uint32ColorGreen(*mainsurface), "No Leaderboard entries for this category");
+					snprintf((char*)(msg + strlen(msg)), (LOBBY_CHATBOX_LENGTH + 31) - strlen(msg), " ");
 				}
+				snprintf((char*)(msg + strlen(msg)), (LOBBY_CHATBOX_LENGTH + 31) - strlen(msg), "%s", (char*)(lobbyChatbox + LOBBY_CHATBOX_LENGTH - strlen(shortname) - 2));
+			}
+			if ( multiplayer != CLIENT )
+			{
+				newString(&lobbyChatboxMessages, 0xFFFFFFFF, msg);  // servers print their messages right away
 			}
 
-			SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
-
-			tooltip.x = omousex + 8;
-			tooltip.y = omousey + 8;
-			tooltip.w = 32 + TTF12_WIDTH * 14;
-			tooltip.h = TTF12_HEIGHT + 8;
-
-			filename_pady += 2 * TTF12_HEIGHT;
-
-			// do slider
-			SDL_Rect slider;
-			slider.x = filename_padx2 + 8;
-			slider.y = filename_pady - 8;
-			slider.h = suby2 - (filename_pady + 20);
-			slider.w = 32;
-
-			int entriesToScroll = std::max(static_cast<int>((numEntriesTotal / numEntriesToShow) - 1), 0);
-			entriesToScroll = entriesToScroll * numEntriesToShow + (numEntriesTotal % numEntriesToShow);
-
-			bool drawScrollTooltip = false;
-
-			// handle slider movement.
-			if ( numEntriesTotal > numEntriesToShow )
+			int playerToKick = -1;
+			bool skipMessageRelayToClients = false;
+			if ( multiplayer == SERVER )
 			{
-				drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-				if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
-					slider.y, slider.y + slider.h) )
+				std::string chatboxStr = lobbyChatbox;
+				if ( (chatboxStr.size() > strlen("/kick ")) 
+					&& chatboxStr.find("/kick ") != std::string::npos && chatboxStr.find("/kick ") == size_t(0U) )
 				{
-					if ( mouseInBounds(clientnum, slider.x, slider.x + slider.w,
-						slider.y, slider.y + slider.h) )
-					{
-						drawScrollTooltip = true;
-					}
-					if ( mousestatus[SDL_BUTTON_WHEELUP] )
+					// find player num to kick
+					chatboxStr = chatboxStr.substr(chatboxStr.find("/kick ") + strlen("/kick "));
+					std::istringstream(chatboxStr) >> playerToKick;
+					playerToKick -= 1;
+					if ( playerToKick > 0 && playerToKick < MAXPLAYERS )
 					{
-						g_SteamLeaderboards->LeaderboardView.scrollIndex = std::max(g_SteamLeaderboards->LeaderboardView.scrollIndex - 1, 0);
-						mousestatus[SDL_BUTTON_WHEELUP] = 0;
+						char kickMsg[LOBBY_CHATBOX_LENGTH + 32] = { 0 };
+						if ( !client_disconnected[playerToKick] )
+						{
+							char clientShortName[32] = { 0 };
+							strncpy(clientShortName, stats[playerToKick]->name, 22);
+							snprintf(kickMsg, LOBBY_CHATBOX_LENGTH, language[279], playerToKick + 1, clientShortName);
+							newString(&lobbyChatboxMessages, 0xFFFFFFFF, kickMsg);  // servers print their messages right away
+
+							strcpy(msg, kickMsg);
+						}
+						else
+						{
+							newString(&lobbyChatboxMessages, 0xFFFFFFFF, "***   Invalid player to kick   ***");
+							skipMessageRelayToClients = true;
+							playerToKick = -1;
+						}
 					}
-					if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+					else
 					{
-						g_SteamLeaderboards->LeaderboardView.scrollIndex = std::min(g_SteamLeaderboards->LeaderboardView.scrollIndex + 1, entriesToScroll);
-						mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+						newString(&lobbyChatboxMessages, 0xFFFFFFFF, "***   Invalid player to kick   ***");
+						skipMessageRelayToClients = true;
+						playerToKick = -1;
 					}
 				}
-
-				if ( keystatus[SDL_SCANCODE_UP] )
-				{
-					g_SteamLeaderboards->LeaderboardView.scrollIndex = std::max(g_SteamLeaderboards->LeaderboardView.scrollIndex - 1, 0);
-					keystatus[SDL_SCANCODE_UP] = 0;
-				}
-				if ( keystatus[SDL_SCANCODE_DOWN] )
-				{
-					g_SteamLeaderboards->LeaderboardView.scrollIndex = std::min(g_SteamLeaderboards->LeaderboardView.scrollIndex + 1, entriesToScroll);
-					keystatus[SDL_SCANCODE_DOWN] = 0;
-				}
-				slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
-				slider.y += slider.h * savegames_window_scroll;
-				if ( g_SteamLeaderboards->LeaderboardView.scrollIndex == entriesToScroll ) // reached end.
-				{
-					slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
-				}
-				drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
 			}
-			else
+
+			strcpy(lobbyChatbox, "");
+
+			// send the message
+			strcpy((char*)net_packet->data, "CMSG");
+			strcat((char*)(net_packet->data), msg);
+			net_packet->len = 4 + strlen(msg) + 1;
+			net_packet->data[net_packet->len - 1] = 0;
+			if ( multiplayer == CLIENT )
 			{
-				//drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-				drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h);
+				net_packet->address.host = net_server.host;
+				net_packet->address.port = net_server.port;
+				sendPacketSafe(net_sock, -1, net_packet, 0);
 			}
-
-			// draw the content
-			for ( int i = 0; i < numEntriesTotal; ++i )
+			else if ( multiplayer == SERVER )
 			{
-				filename_padx = subx1 + 16;
-				if ( i >= g_SteamLeaderboards->LeaderboardView.scrollIndex && i < numEntriesToShow + g_SteamLeaderboards->LeaderboardView.scrollIndex )
+				for ( int i = 1; i < MAXPLAYERS; i++ )
 				{
-					drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
-					SDL_Rect highlightEntry;
-					highlightEntry.x = filename_padx;
-					highlightEntry.y = filename_pady - 8;
-					highlightEntry.w = filename_padx2 - filename_padx;
-					highlightEntry.h = filename_rowHeight + 8;
-					drawRect(&highlightEntry, uint32ColorBaronyBlue(*mainsurface), 64);
-
-					char steamID[32] = "";
-					if ( strlen(SteamFriends()->GetFriendPersonaName(g_SteamLeaderboards->m_leaderboardEntries[i].m_steamIDUser)) > 18 )
-					{
-						strncpy(steamID, SteamFriends()->GetFriendPersonaName(g_SteamLeaderboards->m_leaderboardEntries[i].m_steamIDUser), 16);
-						strcat(steamID, "..");
-					}
-					else
+					if ( client_disconnected[i] )
 					{
-						strncpy(steamID, SteamFriends()->GetFriendPersonaName(g_SteamLeaderboards->m_leaderboardEntries[i].m_steamIDUser), 18);
+						continue;
 					}
-					if ( g_SteamLeaderboards->LeaderboardView.boardToDownload != LEADERBOARD_NONE
-						&& g_SteamLeaderboards->LeaderboardView.boardToDownload % 2 == 1 )
+					if ( playerToKick == i )
 					{
-						Uint32 sec = (g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore) % 60;
-						Uint32 min = ((g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore) / 60) % 60;
-						Uint32 hour = ((g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore) / 60) / 60;
-
-						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "#%2d [%18s]:   Time: %02d:%02d:%02d  Score: %6d",
-							g_SteamLeaderboards->m_leaderboardEntries[i].m_nGlobalRank,
-							steamID, hour, min, sec, g_SteamLeaderboards->downloadedTags[i][TAG_TOTAL_SCORE]);
+						continue;
 					}
-					else
+					if ( skipMessageRelayToClients )
 					{
-						Uint32 sec = (g_SteamLeaderboards->downloadedTags[i][TAG_COMPLETION_TIME]) % 60;
-						Uint32 min = ((g_SteamLeaderboards->downloadedTags[i][TAG_COMPLETION_TIME]) / 60) % 60;
-						Uint32 hour = ((g_SteamLeaderboards->downloadedTags[i][TAG_COMPLETION_TIME]) / 60) / 60;
-						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "#%2d [%18s]:   Score: %6d  Time: %02d:%02d:%02d",
-							g_SteamLeaderboards->m_leaderboardEntries[i].m_nGlobalRank,
-							steamID, g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore, hour, min, sec);
+						continue;
 					}
+					net_packet->address.host = net_clients[i - 1].host;
+					net_packet->address.port = net_clients[i - 1].port;
+					sendPacketSafe(net_sock, -1, net_packet, i - 1);
+				}
 
-					filename_padx = filename_padx2 - (15 * TTF12_WIDTH + 16);
-					int text_x = filename_padx;
-					int text_y = filename_pady;
-					if ( drawClickableButton(filename_padx, filename_pady, 15 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0) && score_leaderboard_window != 3 )
+				if ( playerToKick > 0 )
+				{
+					// send message to kicked player
+					strcpy((char*)net_packet->data, "KICK");
+					net_packet->address.host = net_clients[playerToKick - 1].host;
+					net_packet->address.port = net_clients[playerToKick - 1].port;
+					net_packet->len = 4;
+					sendPacketSafe(net_sock, -1, net_packet, playerToKick - 1);
+
+					client_disconnected[playerToKick] = true;
+					// notify everyone else.
+					for ( int i = 1; i < MAXPLAYERS; i++ )
 					{
-						score_leaderboard_window = 3;
-						g_SteamLeaderboards->currentLeaderBoardIndex = i;
-						steamLeaderboardReadScore(g_SteamLeaderboards->downloadedTags[g_SteamLeaderboards->currentLeaderBoardIndex]);
-						for ( node = button_l.first; node != NULL; node = node->next )
+						if ( client_disconnected[i] )
 						{
-							button = (button_t*)node->element;
-							button->visible = 0;
+							continue;
 						}
+						strncpy((char*)(net_packet->data), "PLAYERDISCONNECT", 16);
+						net_packet->data[16] = playerToKick;
+						net_packet->address.host = net_clients[i - 1].host;
+						net_packet->address.port = net_clients[i - 1].port;
+						net_packet->len = 17;
+						sendPacketSafe(net_sock, -1, net_packet, i - 1);
 					}
-					ttfPrintTextFormatted(ttf12, text_x + 8, text_y, "%s", "View character");
-
-					filename_padx = filename_padx2 - (2 * TTF12_WIDTH + 14);
-					text_x = filename_padx;
-
-					filename_pady += 3 * filename_rowHeight / 2;
+					char shortname[32] = { 0 };
+					strncpy(shortname, stats[playerToKick]->name, 22);
+					newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
 				}
 			}
 		}
-	}
-#endif
-	// statistics window
-	if ( score_window || score_leaderboard_window == 3 )
-	{
-		if ( score_leaderboard_window == 3 )
+
+		// draw chatbox entry text and cursor
+		ttfPrintTextFormatted(ttf12, subx1 + 18, suby2 - 46, ">%s", lobbyChatbox);
+		if ( inputstr == lobbyChatbox )
 		{
-			drawWindowFancy(subx1 + 10, suby1 + 20, subx2 - 10, suby2 - 10);
-			if ( drawClickableButton(subx2 - 10 * TTF12_WIDTH - 3, suby1 + 20 + 8, 8 * TTF12_WIDTH, TTF12_HEIGHT, 0) )
+			if ( (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
 			{
-				score_leaderboard_window = 2;
-				for ( node = button_l.first; node != NULL; node = node->next )
-				{
-					button = (button_t*)node->element;
-					button->visible = 1;
-				}
+				int x;
+				getSizeOfText(ttf12, lobbyChatbox, &x, NULL);
+				ttfPrintTextFormatted(ttf12, subx1 + 18 + x + TTF12_WIDTH, suby2 - 46, "_");
 			}
-			ttfPrintTextFormatted(ttf12, subx2 - 10 * TTF12_WIDTH + 9, suby1 + 20 + 8, "close");
 		}
-		// draw button label... shamelessly hacked together from "multiplayer scores toggle button" initialisation...
-		int toggleText_x = subx2 - 44 - strlen("show multiplayer") * 12;
-		int toggleText_y = suby1 + 4 ;
-		int w = 0;
-		int h = 0;
-		list_t* scoresPtr = &topscores;
 
-		if ( !score_leaderboard_window )
+		if (hovering_selection > -1)
 		{
-			if ( !scoreDisplayMultiplayer )
+			drawTooltip(&tooltip_box);
+			char flagStringBuffer[256] = "";
+			if ( hovering_selection < 5 )
 			{
-				getSizeOfText(ttf12, "show multiplayer", &w, &h);
-				ttfPrintText(ttf12, toggleText_x + (strlen("show multiplayer") * 12 + 8 - w) / 2, toggleText_y + (20 - h) / 2 + 3, "show multiplayer");
+				strncpy(flagStringBuffer, language[1942 + hovering_selection], 255);
 			}
 			else
 			{
-				scoresPtr = &topscoresMultiplayer;
-				getSizeOfText(ttf12, "show solo", &w, &h);
-				ttfPrintText(ttf12, toggleText_x + (strlen("show multiplayer") * 12 + 8 - w) / 2, toggleText_y + (20 - h) / 2 + 3, "show solo");
+				strncpy(flagStringBuffer, language[2921 - 5 + hovering_selection], 255);
 			}
-		}
-		else
-		{
-			scoresPtr = nullptr;
-		}
-
-		if ( !list_Size(scoresPtr) && !score_leaderboard_window )
-		{
-#define NOSCORESSTR language[1389]
-			ttfPrintTextFormatted(ttf16, xres / 2 - strlen(NOSCORESSTR) * 9, yres / 2 - 9, NOSCORESSTR);
-		}
-		else
-		{
-			if ( !score_leaderboard_window )
+			if (hovering_selection < NUM_SERVER_FLAGS)
 			{
-				if ( scoreDisplayMultiplayer )
-				{
-					ttfPrintTextFormatted(ttf16, subx1 + 8, suby1 + 8, "%s - %d / %d", language[2958], score_window, list_Size(&topscoresMultiplayer));
-				}
-				else
-				{
-					ttfPrintTextFormatted(ttf16, subx1 + 8, suby1 + 8, "%s - %d / %d", language[1390], score_window, list_Size(&topscores));
-				}
+				ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 4, flagStringBuffer);
 			}
-
-			// draw character window
-			if (players[clientnum] != nullptr && players[clientnum]->entity != nullptr)
+		}
+#ifdef STEAMWORKS
+		// draw server workshop mod list
+		if ( !directConnect && currentLobby )
+		{
+			const char* serverNumModsChar = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), "svNumMods");
+			int serverNumModsLoaded = atoi(serverNumModsChar);
+			if ( serverNumModsLoaded > 0 )
 			{
-				camera_charsheet.x = players[clientnum]->entity->x / 16.0 + 1.118 * cos(camera_charsheet_offsetyaw); // + 1
-				camera_charsheet.y = players[clientnum]->entity->y / 16.0 + 1.118 * sin(camera_charsheet_offsetyaw); // -.5
-				camera_charsheet.z = players[clientnum]->entity->z * 2;
-				camera_charsheet.ang = atan2(players[clientnum]->entity->y / 16.0 - camera_charsheet.y, players[clientnum]->entity->x / 16.0 - camera_charsheet.x);
-				camera_charsheet.vang = PI / 24;
-				camera_charsheet.winw = 400;
-				camera_charsheet.winy = suby1 + 32;
-				camera_charsheet.winh = suby2 - 96 - camera_charsheet.winy;
-				camera_charsheet.winx = subx1 + 32;
-				SDL_Rect pos;
-				pos.x = camera_charsheet.winx;
-				pos.y = camera_charsheet.winy;
-				pos.w = camera_charsheet.winw;
-				pos.h = camera_charsheet.winh;
-				drawRect(&pos, 0, 255);
-				b = players[clientnum]->entity->flags[BRIGHT];
-				players[clientnum]->entity->flags[BRIGHT] = true;
-				if ( !players[clientnum]->entity->flags[INVISIBLE] )
-				{
-					real_t ofov = fov;
-					fov = 50;
-					glDrawVoxel(&camera_charsheet, players[clientnum]->entity, REALCOLORS);
-					fov = ofov;
-				}
-				players[clientnum]->entity->flags[BRIGHT] = b;
-				c = 0;
-				for ( node = players[clientnum]->entity->children.first; node != NULL; node = node->next )
-				{
-					if ( c == 0 )
-					{
-						c++;
-					}
-					entity = (Entity*) node->element;
-					if ( !entity->flags[INVISIBLE] )
-					{
-						b = entity->flags[BRIGHT];
-						entity->flags[BRIGHT] = true;
-						real_t ofov = fov;
-						fov = 50;
-						glDrawVoxel(&camera_charsheet, entity, REALCOLORS);
-						fov = ofov;
-						entity->flags[BRIGHT] = b;
-					}
-					c++;
-				}
-				SDL_Rect rotateBtn;
-				rotateBtn.w = 24;
-				rotateBtn.h = 24;
-				rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w;
-				rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
-				drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-				if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
+				char tagName[32];
+				std::vector<std::string> serverFileIdsLoaded;
+				std::string modList = "Clients can click '";
+				modList.append(language[2984]).append("' and \n'").append(language[2985]);
+				modList.append("' to automatically subscribe and \n");
+				modList.append("mount workshop items loaded in the host's lobby.\n\n");
+				modList.append("All clients should be running the same mod load order\n");
+				modList.append("to prevent any crashes or undefined behavior.\n\n");
+				modList.append("Game client may need to be closed to install and detect\nnew subscriptions due to Workshop limitations.\n");
+				int numToolboxLines = 9;
+				bool itemNeedsSubscribing = false;
+				bool itemNeedsMounting = false;
+				Uint32 modsStatusColor = uint32ColorBaronyBlue(*mainsurface);
+				bool modListOutOfOrder = false;
+				for ( int lines = 0; lines < serverNumModsLoaded; ++lines )
 				{
-					if ( inputs.bMouseLeft(clientnum) )
+					snprintf(tagName, 32, "svMod%d", lines);
+					const char* serverModFileID = SteamMatchmaking()->GetLobbyData(*static_cast<CSteamID*>(currentLobby), tagName);
+					if ( strcmp(serverModFileID, "") )
 					{
-						camera_charsheet_offsetyaw += 0.05;
-						if ( camera_charsheet_offsetyaw > 2 * PI )
+						if ( gamemodsCheckIfSubscribedAndDownloadedFileID(atoi(serverModFileID)) == false )
 						{
-							camera_charsheet_offsetyaw -= 2 * PI;
+							modList.append("Workshop item not subscribed or installed: ");
+							modList.append(serverModFileID);
+							modList.append("\n");
+							itemNeedsSubscribing = true;
+							++numToolboxLines;
 						}
-						drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-					}
-				}
-				ttfPrintText(ttf12, rotateBtn.x + 6, rotateBtn.y + 6, ">");
-
-				rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w * 2 - 4;
-				rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
-				drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-				if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
-				{
-					if ( inputs.bMouseLeft(clientnum) )
-					{
-						camera_charsheet_offsetyaw -= 0.05;
-						if ( camera_charsheet_offsetyaw < 0.f )
+						else if ( gamemodsCheckFileIDInLoadedPaths(atoi(serverModFileID)) == false )
 						{
-							camera_charsheet_offsetyaw += 2 * PI;
+							modList.append("Workshop item downloaded but not loaded: ");
+							modList.append(serverModFileID);
+							modList.append("\n");
+							itemNeedsMounting = true;
+							++numToolboxLines;
 						}
-						drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
-					}
-				}
-				ttfPrintText(ttf12, rotateBtn.x + 4, rotateBtn.y + 6, "<");
-			}
-
-			// print name and class
-			if ( victory )
-			{
-				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 40, language[1391]);
-				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 56, "%s", stats[clientnum]->name);
-				int creature = HUMAN;
-				if ( players[clientnum] && players[clientnum]->entity )
-				{
-					creature = static_cast<int>(players[clientnum]->entity->getMonsterFromPlayerRace(stats[clientnum]->playerRace));
-				}
-				if ( victory == 1 )
-				{
-					if ( creature != HUMAN )
-					{
-						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3359], monstertypenamecapitalized[creature]);
-					}
-					else
-					{
-						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[1392]);
+						serverFileIdsLoaded.push_back(serverModFileID);
 					}
 				}
-				else if ( victory == 2 )
+				if ( itemNeedsSubscribing )
 				{
-					if ( creature != HUMAN )
-					{
-						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3360], monstertypenamecapitalized[creature]);
-					}
-					else
+					for ( node = button_l.first; node != NULL; node = nextnode )
 					{
-						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[1393]);
+						nextnode = node->next;
+						button = (button_t*)node->element;
+						if ( button->action == &buttonGamemodsMountHostsModFiles )
+						{
+							button->visible = 0;
+						}
+						if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+						{
+							button->visible = 1;
+						}
 					}
 				}
-				else if ( victory == 3 )
+				else
 				{
-					if ( creature != HUMAN )
+					if ( itemNeedsMounting )
 					{
-						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3361], 
-							language[3363 - 1 + stats[clientnum]->playerRace]);
+						modsStatusColor = uint32ColorOrange(*mainsurface);
+						for ( node = button_l.first; node != NULL; node = nextnode )
+						{
+							nextnode = node->next;
+							button = (button_t*)node->element;
+							if ( button->action == &buttonGamemodsMountHostsModFiles )
+							{
+								button->visible = 1;
+							}
+							if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+							{
+								button->visible = 0;
+							}
+						}
+					}
+					else if ( gamemodsIsClientLoadOrderMatchingHost(serverFileIdsLoaded)
+						&& serverFileIdsLoaded.size() == gamemods_workshopLoadedFileIDMap.size() )
+					{
+						modsStatusColor = uint32ColorGreen(*mainsurface);
+						for ( node = button_l.first; node != NULL; node = nextnode )
+						{
+							nextnode = node->next;
+							button = (button_t*)node->element;
+							if ( button->action == &buttonGamemodsMountHostsModFiles )
+							{
+								button->visible = 0;
+							}
+							if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+							{
+								button->visible = 0;
+							}
+						}
 					}
 					else
 					{
-						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[2911]);
+						modsStatusColor = uint32ColorOrange(*mainsurface);
+						modListOutOfOrder = true;
+						for ( node = button_l.first; node != NULL; node = nextnode )
+						{
+							nextnode = node->next;
+							button = (button_t*)node->element;
+							if ( button->action == &buttonGamemodsMountHostsModFiles )
+							{
+								button->visible = 1;
+							}
+							if ( button->action == &buttonGamemodsSubscribeToHostsModFiles )
+							{
+								button->visible = 0;
+							}
+						}
 					}
 				}
-			}
-			else
-			{
-				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 40, language[1394]);
-				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 56, "%s", stats[clientnum]->name);
-
-				char classname[64];
-				strcpy(classname, playerClassLangEntry(client_classes[0], clientnum));
-				classname[0] -= 32;
-				int creature = HUMAN;
-				if ( players[clientnum] && players[clientnum]->entity )
+				ttfPrintTextFormattedColor(ttf12, xres / 2 + 8, suby1 + 304, modsStatusColor, "%2d mod(s) loaded by host (?)", serverNumModsLoaded);
+				std::string modStatusString;
+				if ( itemNeedsSubscribing )
 				{
-					creature = static_cast<int>(players[clientnum]->entity->getMonsterFromPlayerRace(stats[clientnum]->playerRace));
+					modStatusString = "Your client is missing mods in subscriptions";
 				}
-				if ( creature != HUMAN )
+				else if ( itemNeedsMounting )
 				{
-					ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3362], monstertypenamecapitalized[creature], classname);
+					modStatusString = "Your client is missing mods in load order";
+				}
+				else if ( modListOutOfOrder )
+				{
+					modStatusString = "Your client mod list is out of order";
 				}
 				else
 				{
-					ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[1395], classname);
+					modStatusString = "Your client has complete mod list";
 				}
-			}
 
-			// print total score
-			if ( score_leaderboard_window != 3 )
-			{
-				node = list_Node(scoresPtr, score_window - 1);
-				if ( node )
+				int lineStartListLoadedMods = numToolboxLines;
+				numToolboxLines += serverNumModsLoaded + 3;
+				std::string clientModString = "Your client mod list:\n";
+				for ( std::vector<std::pair<std::string, uint64>>::iterator it = gamemods_workshopLoadedFileIDMap.begin(); 
+					it != gamemods_workshopLoadedFileIDMap.end(); ++it )
 				{
-					score_t* score = (score_t*)node->element;
-					ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 104, language[1404], totalScore(score));
+					clientModString.append(std::to_string(it->second));
+					clientModString.append("\n");
+				}
+				std::string serverModString = "Server mod list:\n";
+				for ( std::vector<std::string>::iterator it = serverFileIdsLoaded.begin(); it != serverFileIdsLoaded.end(); ++it )
+				{
+					serverModString.append(*it);
+					serverModString.append("\n");
 				}
-			}
-			else
-			{
-#ifdef STEAMWORKS
-				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 104, language[1404], g_SteamLeaderboards->downloadedTags[g_SteamLeaderboards->currentLeaderBoardIndex][TAG_TOTAL_SCORE]);
-#endif // STEAMWORKS
-			}
-
-			Entity* playerEntity = nullptr;
-			if ( players[clientnum] )
-			{
-				playerEntity = players[clientnum]->entity;
-			}
-
-			// print character stats
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 128, language[359], stats[clientnum]->LVL, playerClassLangEntry(client_classes[clientnum], clientnum));
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 140, language[1396], stats[clientnum]->EXP);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 152, language[1397], stats[clientnum]->GOLD);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 164, language[361], currentlevel);
-
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 188, language[1398], statGetSTR(stats[clientnum], playerEntity), stats[clientnum]->STR);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 200, language[1399], statGetDEX(stats[clientnum], playerEntity), stats[clientnum]->DEX);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 212, language[1400], statGetCON(stats[clientnum], playerEntity), stats[clientnum]->CON);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 224, language[1401], statGetINT(stats[clientnum], playerEntity), stats[clientnum]->INT);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 236, language[1402], statGetPER(stats[clientnum], playerEntity), stats[clientnum]->PER);
-			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 248, language[1403], statGetCHR(stats[clientnum], playerEntity), stats[clientnum]->CHR);
 
-			// time
-			Uint32 sec = (completionTime / TICKS_PER_SECOND) % 60;
-			Uint32 min = ((completionTime / TICKS_PER_SECOND) / 60) % 60;
-			Uint32 hour = ((completionTime / TICKS_PER_SECOND) / 60) / 60;
-			ttfPrintTextFormatted(ttf12, subx1 + 32, suby2 - 80, "%s: %02d:%02d:%02d. %s:", language[1405], hour, min, sec, language[1406]);
-			if ( !conductPenniless && !conductFoodless && !conductVegetarian && !conductIlliterate && !conductGameChallenges[CONDUCT_HARDCORE]
-				&& !conductGameChallenges[CONDUCT_CHEATS_ENABLED]
-				&& !conductGameChallenges[CONDUCT_MODDED]
-				&& !conductGameChallenges[CONDUCT_LIFESAVING]
-				&& !conductGameChallenges[CONDUCT_KEEPINVENTORY]
-				&& !conductGameChallenges[CONDUCT_BRAWLER]
-				&& !conductGameChallenges[CONDUCT_RANGED_ONLY]
-				&& !conductGameChallenges[CONDUCT_BLESSED_BOOTS_SPEED]
-				&& !conductGameChallenges[CONDUCT_BOOTS_SPEED]
-				&& !conductGameChallenges[CONDUCT_ACCURSED]
-				&& !conductGameChallenges[CONDUCT_MULTIPLAYER])
-			{
-				ttfPrintText(ttf12, subx1 + 32, suby2 - 64, language[1407]);
-			}
-			else
-			{
-				int b = 0;
-				strcpy(tempstr, " ");
-				if ( conductPenniless )
+				ttfPrintTextFormattedColor(ttf12, xres / 2 + 8, suby1 + 320, modsStatusColor, "%s", modStatusString.c_str());
+				if ( mouseInBounds(clientnum, xres / 2 + 8, xres / 2 + 8 + 31 * TTF12_WIDTH, suby1 + 304, suby1 + 320 + TTF12_HEIGHT) )
 				{
-					strcat(tempstr, language[1408]);
-					++b;
+					tooltip_box.w = 60 * TTF12_WIDTH + 8;
+					tooltip_box.x = mousex - 16 - tooltip_box.w;
+					tooltip_box.y = mousey + 8;
+					tooltip_box.h = numToolboxLines * TTF12_HEIGHT + 8;
+					drawTooltip(&tooltip_box);
+					ttfPrintTextFormatted(ttf12, tooltip_box.x + 4, tooltip_box.y + 8, "%s", modList.c_str());
+					ttfPrintTextFormattedColor(ttf12, tooltip_box.x + 4, tooltip_box.y + lineStartListLoadedMods * TTF12_HEIGHT + 16,
+						modsStatusColor, "%s", clientModString.c_str());
+					ttfPrintTextFormattedColor(ttf12, tooltip_box.x + 4 + 24 * TTF12_WIDTH, tooltip_box.y + lineStartListLoadedMods * TTF12_HEIGHT + 16, 
+						modsStatusColor, "%s", serverModString.c_str());
 				}
-				if ( conductFoodless )
+				if ( multiplayer == CLIENT && itemNeedsMounting )
 				{
-					if ( b > 0 )
+					if ( g_SteamWorkshop->subscribedCallStatus == 1 )
 					{
-						strcat(tempstr, ", ");
+						ttfPrintTextFormattedColor(ttf12, subx2 - 64 * TTF12_WIDTH, suby2 - 4 - TTF12_HEIGHT, uint32ColorOrange(*mainsurface), 
+							"retrieving data...");
+					}
+					else if ( g_SteamWorkshop->subscribedCallStatus == 2 )
+					{
+						ttfPrintTextFormattedColor(ttf12, subx2 - 64 * TTF12_WIDTH, suby2 - 4 - TTF12_HEIGHT, uint32ColorOrange(*mainsurface),
+							"please retry mount operation.");
+					}
+					else
+					{
+						ttfPrintTextFormattedColor(ttf12, subx2 - 64 * TTF12_WIDTH, suby2 - 4 - TTF12_HEIGHT, uint32ColorOrange(*mainsurface),
+							"press mount button.");
 					}
-					strcat(tempstr, language[1409]);
-					++b;
 				}
-				if ( conductVegetarian )
+			}
+		}
+#endif // STEAMWORKS
+
+		// handle keepalive timeouts (lobby)
+		if ( multiplayer == SERVER )
+		{
+			for ( int i = 1; i < MAXPLAYERS; i++ )
+			{
+				if ( client_disconnected[i] )
 				{
-					if ( b > 0 )
+					continue;
+				}
+				bool clientHasLostP2P = false;
+				if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+				{
+#ifdef STEAMWORKS
+					if ( !steamIDRemote[i - 1] )
 					{
-						strcat(tempstr, ", ");
+						clientHasLostP2P = true;
 					}
-					strcat(tempstr, language[1410]);
-					++b;
+#endif
 				}
-				if ( conductIlliterate )
+				else if ( !directConnect && LobbyHandler.getHostingType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
 				{
-					if ( b > 0 )
+#ifdef USE_EOS
+					if ( !EOS.P2PConnectionInfo.isPeerStillValid(i - 1) )
 					{
-						strcat(tempstr, ", ");
+						clientHasLostP2P = true;
 					}
-					strcat(tempstr, language[1411]);
-					++b;
+#endif
 				}
-				for ( int c = 0; c < NUM_CONDUCT_CHALLENGES; ++c )
+				if ( clientHasLostP2P || (ticks - client_keepalive[i] > TICKS_PER_SECOND * 30) )
 				{
-					if ( conductGameChallenges[c] != 0 )
+					client_disconnected[i] = true;
+					strncpy((char*)(net_packet->data), "PLAYERDISCONNECT", 16);
+					net_packet->data[16] = i;
+					net_packet->len = 17;
+					for ( int c = 1; c < MAXPLAYERS; c++ )
 					{
-						if ( b > 0 )
-						{
-							strcat(tempstr, ", ");
-						}
-						if ( b > 0 && b % 4 == 0 )
+						if ( client_disconnected[c] )
 						{
-							strcat(tempstr, "\n ");
+							continue;
 						}
-						strcat(tempstr, language[2925 + c]);
-						++b;
+						net_packet->address.host = net_clients[c - 1].host;
+						net_packet->address.port = net_clients[c - 1].port;
+						sendPacketSafe(net_sock, -1, net_packet, c - 1);
 					}
+					char shortname[32] = { 0 };
+					strncpy(shortname, stats[i]->name, 22);
+					newString(&lobbyChatboxMessages, 0xFFFFFFFF, language[1376], shortname);
+					continue;
 				}
-				/*	if ( b > 0 )
+			}
+		}
+		else if ( multiplayer == CLIENT )
+		{
+			bool hostHasLostP2P = false;
+			if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+			{
+#ifdef STEAMWORKS
+				if ( !steamIDRemote[0] )
 				{
-					tempstr[strlen(tempstr) - 2] = 0;
-				}*/
-				ttfPrintTextFormatted(ttf12, subx1 + 20, suby2 - 64, tempstr);
+					hostHasLostP2P = true;
+				}
+#endif
+			}
+			else if ( !directConnect && LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+			{
+#ifdef USE_EOS
+				if ( !EOS.P2PConnectionInfo.isPeerStillValid(0) )
+				{
+					hostHasLostP2P = true;
+				}
+#endif
 			}
 
-			// kills
-			int x = 0, y = 0;
-			ttfPrintText(ttf12, subx1 + 456, suby1 + 272, language[1412]);
-			bool nokills = true;
-			for ( x = 0; x < NUMMONSTERS; x++ )
+			if ( hostHasLostP2P || (ticks - client_keepalive[0] > TICKS_PER_SECOND * 30) )
 			{
-				if ( kills[x] )
+				buttonDisconnect(NULL);
+				openFailedConnectionWindow(3); // lost connection to server box
+			}
+		}
+
+		// send keepalive messages every second
+		if ( ticks % (TICKS_PER_SECOND * 1) == 0 && multiplayer != SINGLE )
+		{
+			strcpy((char*)net_packet->data, "KEEPALIVE");
+			net_packet->data[9] = clientnum;
+			net_packet->len = 10;
+			if ( multiplayer == CLIENT )
+			{
+				net_packet->address.host = net_server.host;
+				net_packet->address.port = net_server.port;
+				sendPacketSafe(net_sock, -1, net_packet, 0);
+			}
+			else if ( multiplayer == SERVER )
+			{
+				int i;
+				for ( i = 1; i < MAXPLAYERS; i++ )
 				{
-					nokills = false;
-					if ( kills[x] > 1 )
-					{
-						if ( x < KOBOLD )
-						{
-							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[111 + x]);
-						}
-						else
-						{
-							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[2050 + (x - KOBOLD)]);
-						}
-					}
-					else
+					if ( client_disconnected[i] )
 					{
-						if ( x < KOBOLD )
-						{
-							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[90 + x]);
-						}
-						else
-						{
-							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[2000 + (x - KOBOLD)]);
-						}
+						continue;
 					}
-					y++;
+					net_packet->address.host = net_clients[i - 1].host;
+					net_packet->address.port = net_clients[i - 1].port;
+					sendPacketSafe(net_sock, -1, net_packet, i - 1);
 				}
 			}
-			if ( nokills )
-			{
-				ttfPrintText(ttf12, subx1 + 456, suby1 + 296, language[1413]);
-			}
 		}
 	}
-	else
-	{
-		scoreDisplayMultiplayer = false;
-	}
 
-	if ( savegames_window != 0 )
+	// leaderboards window
+#ifdef STEAMWORKS
+	if ( score_leaderboard_window != 0 && g_SteamLeaderboards )
 	{
-		int numSavesToShow = 5;
+		int numEntriesToShow = 15;
 		int filenameMaxLength = 48;
 		int filename_padx = subx1 + 16;
 		int filename_pady = suby1 + 32;
 		int filename_padx2 = subx2 - 16 - 40;
-		int filename_pady2 = filename_pady + numSavesToShow * TTF12_HEIGHT + 8;
-		int filename_rowHeight = 2 * TTF12_HEIGHT + 8;
+		int filename_pady2 = filename_pady + numEntriesToShow * TTF12_HEIGHT + 8;
+		int filename_rowHeight = TTF12_HEIGHT + 4;
+		int numEntriesTotal = 0;
+
+		ttfPrintTextFormattedColor(ttf16, filename_padx, filename_pady, uint32ColorWhite(*mainsurface), "%s", 
+			g_SteamLeaderboards->leaderboardNames[g_SteamLeaderboards->LeaderboardView.boardToDownload].c_str());
+
 		filename_pady += 3 * TTF12_HEIGHT;
-		int numSaves = savegamesList.size();
-		if ( numSaves > 0 )
+		if ( !g_SteamLeaderboards->b_LeaderboardInit )
 		{
-			//ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), language[3066]);
+			// waiting for leaderboard to be found...
+		}
+		else if ( g_SteamLeaderboards->b_LeaderboardInit && !g_SteamLeaderboards->b_ScoresDownloaded )
+		{
+			// wait for leaderboard to be downloaded...
+			if ( score_leaderboard_window == 1 )
+			{
+				g_SteamLeaderboards->DownloadScores(g_SteamLeaderboards->LeaderboardView.requestType, g_SteamLeaderboards->LeaderboardView.rangeStart,
+					g_SteamLeaderboards->LeaderboardView.rangeEnd);
+				score_leaderboard_window = 2;
+			}
+			ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady + 2 * TTF12_HEIGHT, uint32ColorOrange(*mainsurface), "Downloading entries...");
 		}
+		else 
+		{
 
-		SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
+			if ( g_SteamLeaderboards->b_ScoresDownloaded )
+			{
+				numEntriesTotal = g_SteamLeaderboards->m_nLeaderboardEntries;
+				if ( numEntriesTotal <= 0 )
+				{
+					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady + 2 * TTF12_HEIGHT, uint32ColorGreen(*mainsurface), "No Leaderboard entries for this category");
+				}
+			}
 
-		tooltip.x = omousex + 8;
-		tooltip.y = omousey + 8;
-		tooltip.w = 32 + TTF12_WIDTH * 14;
-		tooltip.h = TTF12_HEIGHT + 8;
+			SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
 
-		filename_pady += 2 * TTF12_HEIGHT;
+			tooltip.x = omousex + 8;
+			tooltip.y = omousey + 8;
+			tooltip.w = 32 + TTF12_WIDTH * 14;
+			tooltip.h = TTF12_HEIGHT + 8;
 
-		// do slider
-		SDL_Rect slider;
-		slider.x = filename_padx2 + 8;
-		slider.y = filename_pady - 8;
-		slider.h = suby2 - (filename_pady + 20);
-		slider.w = 32;
+			filename_pady += 2 * TTF12_HEIGHT;
 
-		int entriesToScroll = std::max(static_cast<int>((numSaves / numSavesToShow) - 1), 0);
-		entriesToScroll = entriesToScroll * numSavesToShow + (numSaves % numSavesToShow);
+			// do slider
+			SDL_Rect slider;
+			slider.x = filename_padx2 + 8;
+			slider.y = filename_pady - 8;
+			slider.h = suby2 - (filename_pady + 20);
+			slider.w = 32;
 
-		bool drawScrollTooltip = false;
+			int entriesToScroll = std::max(static_cast<int>((numEntriesTotal / numEntriesToShow) - 1), 0);
+			entriesToScroll = entriesToScroll * numEntriesToShow + (numEntriesTotal % numEntriesToShow);
 
-		// handle slider movement.
-		if ( numSaves > numSavesToShow )
-		{
-			drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-			if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
-				slider.y, slider.y + slider.h) )
+			bool drawScrollTooltip = false;
+
+			// handle slider movement.
+			if ( numEntriesTotal > numEntriesToShow )
 			{
-				if ( mouseInBounds(clientnum, slider.x, slider.x + slider.w,
+				drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+				if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
 					slider.y, slider.y + slider.h) )
 				{
-					drawScrollTooltip = true;
+					if ( mouseInBounds(clientnum, slider.x, slider.x + slider.w,
+						slider.y, slider.y + slider.h) )
+					{
+						drawScrollTooltip = true;
+					}
+					if ( mousestatus[SDL_BUTTON_WHEELUP] )
+					{
+						g_SteamLeaderboards->LeaderboardView.scrollIndex = std::max(g_SteamLeaderboards->LeaderboardView.scrollIndex - 1, 0);
+						mousestatus[SDL_BUTTON_WHEELUP] = 0;
+					}
+					if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+					{
+						g_SteamLeaderboards->LeaderboardView.scrollIndex = std::min(g_SteamLeaderboards->LeaderboardView.scrollIndex + 1, entriesToScroll);
+						mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+					}
 				}
-				if ( mousestatus[SDL_BUTTON_WHEELUP] )
+
+				if ( keystatus[SDL_SCANCODE_UP] )
 				{
-					savegames_window_scroll = std::max(savegames_window_scroll - 1, 0);
-					mousestatus[SDL_BUTTON_WHEELUP] = 0;
+					g_SteamLeaderboards->LeaderboardView.scrollIndex = std::max(g_SteamLeaderboards->LeaderboardView.scrollIndex - 1, 0);
+					keystatus[SDL_SCANCODE_UP] = 0;
 				}
-				if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+				if ( keystatus[SDL_SCANCODE_DOWN] )
 				{
-					savegames_window_scroll = std::min(savegames_window_scroll + 1, entriesToScroll);
-					mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+					g_SteamLeaderboards->LeaderboardView.scrollIndex = std::min(g_SteamLeaderboards->LeaderboardView.scrollIndex + 1, entriesToScroll);
+					keystatus[SDL_SCANCODE_DOWN] = 0;
 				}
-			}
-
-			if ( keystatus[SDL_SCANCODE_UP] )
-			{
-				savegames_window_scroll = std::max(savegames_window_scroll - 1, 0);
-				keystatus[SDL_SCANCODE_UP] = 0;
-			}
-			if ( keystatus[SDL_SCANCODE_DOWN] )
-			{
-				savegames_window_scroll = std::min(savegames_window_scroll + 1, entriesToScroll);
-				keystatus[SDL_SCANCODE_DOWN] = 0;
-			}
-			slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
-			slider.y += slider.h * savegames_window_scroll;
-			if ( savegames_window_scroll == entriesToScroll ) // reached end.
-			{
-				slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
-			}
-			drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
-		}
-		else
-		{
-			//drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-			drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h);
-		}
-
-		bool drawDeleteTooltip = false;
-		int numSingleplayerSaves = 0;
-		int numMultiplayerSaves = 0;
-
-		// draw the content
-		for ( int i = 0; i < numSaves && !savegamesList.empty(); ++i ) //TODO: Why did this line add `&& !savegamesList.empty()` ?
-		{
-			filename_padx = subx1 + 16;
-
-			std::vector<std::tuple<int, int, int, std::string>>::iterator it = savegamesList.begin();
-			std::advance(it, i);
-			std::tuple<int, int, int, std::string> entry = *it;
-
-			if ( std::get<1>(entry) != SINGLE )
-			{
-				++numMultiplayerSaves;
+				slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
+				slider.y += slider.h * savegames_window_scroll;
+				if ( g_SteamLeaderboards->LeaderboardView.scrollIndex == entriesToScroll ) // reached end.
+				{
+					slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
+				}
+				drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
 			}
 			else
 			{
-				++numSingleplayerSaves;
+				//drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+				drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h);
 			}
 
-			if ( i >= savegames_window_scroll && i < numSavesToShow + savegames_window_scroll )
+			// draw the content
+			for ( int i = 0; i < numEntriesTotal; ++i )
 			{
-				drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
-				SDL_Rect highlightEntry;
-				highlightEntry.x = filename_padx;
-				highlightEntry.y = filename_pady - 8;
-				highlightEntry.w = filename_padx2 - filename_padx;
-				highlightEntry.h = filename_rowHeight + 8;
-				if ( gamemods_numCurrentModsLoaded >= 0 )
+				filename_padx = subx1 + 16;
+				if ( i >= g_SteamLeaderboards->LeaderboardView.scrollIndex && i < numEntriesToShow + g_SteamLeaderboards->LeaderboardView.scrollIndex )
 				{
-					if ( std::get<1>(entry) == SINGLE ) // single player.
+					drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
+					SDL_Rect highlightEntry;
+					highlightEntry.x = filename_padx;
+					highlightEntry.y = filename_pady - 8;
+					highlightEntry.w = filename_padx2 - filename_padx;
+					highlightEntry.h = filename_rowHeight + 8;
+					drawRect(&highlightEntry, uint32ColorBaronyBlue(*mainsurface), 64);
+
+					char steamID[32] = "";
+					if ( strlen(SteamFriends()->GetFriendPersonaName(g_SteamLeaderboards->m_leaderboardEntries[i].m_steamIDUser)) > 18 )
 					{
-						drawRect(&highlightEntry, uint32ColorGreen(*mainsurface), 64);
+						strncpy(steamID, SteamFriends()->GetFriendPersonaName(g_SteamLeaderboards->m_leaderboardEntries[i].m_steamIDUser), 16);
+						strcat(steamID, "..");
 					}
 					else
 					{
-						drawRect(&highlightEntry, uint32ColorGreen(*mainsurface), 32);
-					}
-				}
-				else
-				{
-					if ( std::get<1>(entry) == SINGLE ) // single player.
-					{
-						drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 48);
-						//drawRect(&highlightEntry, uint32ColorBaronyBlue(*mainsurface), 16);
+						strncpy(steamID, SteamFriends()->GetFriendPersonaName(g_SteamLeaderboards->m_leaderboardEntries[i].m_steamIDUser), 18);
 					}
-					else
+					if ( g_SteamLeaderboards->LeaderboardView.boardToDownload != LEADERBOARD_NONE
+						&& g_SteamLeaderboards->LeaderboardView.boardToDownload % 2 == 1 )
 					{
-						drawRect(&highlightEntry, uint32ColorBaronyBlue(*mainsurface), 32);
-					}
-				}
-
-				ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "[%d]: %s", i + 1, std::get<3>(entry).c_str());
+						Uint32 sec = (g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore) % 60;
+						Uint32 min = ((g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore) / 60) % 60;
+						Uint32 hour = ((g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore) / 60) / 60;
 
-				filename_padx = filename_padx2 - (13 * TTF12_WIDTH + 16);
-				int text_x = filename_padx;
-				int text_y = filename_pady + 10;
-				if ( drawClickableButton(filename_padx, filename_pady, 10 * TTF12_WIDTH + 8, TTF12_HEIGHT * 2 + 4, 0) )
-				{
-					if ( std::get<1>(entry) == SINGLE )
-					{
-						savegameCurrentFileIndex = std::get<2>(entry);
-						buttonLoadSingleplayerGame(nullptr);
+						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "#%2d [%18s]:   Time: %02d:%02d:%02d  Score: %6d",
+							g_SteamLeaderboards->m_leaderboardEntries[i].m_nGlobalRank,
+							steamID, hour, min, sec, g_SteamLeaderboards->downloadedTags[i][TAG_TOTAL_SCORE]);
 					}
 					else
 					{
-						savegameCurrentFileIndex = std::get<2>(entry);
-						buttonLoadMultiplayerGame(nullptr);
+						Uint32 sec = (g_SteamLeaderboards->downloadedTags[i][TAG_COMPLETION_TIME]) % 60;
+						Uint32 min = ((g_SteamLeaderboards->downloadedTags[i][TAG_COMPLETION_TIME]) / 60) % 60;
+						Uint32 hour = ((g_SteamLeaderboards->downloadedTags[i][TAG_COMPLETION_TIME]) / 60) / 60;
+						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "#%2d [%18s]:   Score: %6d  Time: %02d:%02d:%02d",
+							g_SteamLeaderboards->m_leaderboardEntries[i].m_nGlobalRank,
+							steamID, g_SteamLeaderboards->m_leaderboardEntries[i].m_nScore, hour, min, sec);
 					}
-				}
-				ttfPrintTextFormatted(ttf12, text_x + 8, text_y, "%s", "Load Game");
 
-				filename_padx = filename_padx2 - (2 * TTF12_WIDTH + 14);
-				text_x = filename_padx;
-				if ( drawClickableButton(filename_padx, filename_pady, 2 * TTF12_WIDTH + 8, TTF12_HEIGHT * 2 + 4, uint32ColorRed(*mainsurface)) )
-				{
-					if ( std::get<1>(entry) == SINGLE )
-					{
-						savegameCurrentFileIndex = std::get<2>(entry);
-						buttonDeleteSavedSoloGame(nullptr);
-					}
-					else
+					filename_padx = filename_padx2 - (15 * TTF12_WIDTH + 16);
+					int text_x = filename_padx;
+					int text_y = filename_pady;
+					if ( drawClickableButton(filename_padx, filename_pady, 15 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0) && score_leaderboard_window != 3 )
 					{
-						savegameCurrentFileIndex = std::get<2>(entry);
-						buttonDeleteSavedMultiplayerGame(nullptr);
+						score_leaderboard_window = 3;
+						g_SteamLeaderboards->currentLeaderBoardIndex = i;
+						steamLeaderboardReadScore(g_SteamLeaderboards->downloadedTags[g_SteamLeaderboards->currentLeaderBoardIndex]);
+						for ( node = button_l.first; node != NULL; node = node->next )
+						{
+							button = (button_t*)node->element;
+							button->visible = 0;
+						}
 					}
+					ttfPrintTextFormatted(ttf12, text_x + 8, text_y, "%s", "View character");
+
+					filename_padx = filename_padx2 - (2 * TTF12_WIDTH + 14);
+					text_x = filename_padx;
+
+					filename_pady += 3 * filename_rowHeight / 2;
 				}
-				ttfPrintTextFormatted(ttf12, text_x + 6, text_y, "%s", "X");
-				if ( mouseInBounds(clientnum, filename_padx, filename_padx + 2 * TTF12_WIDTH + 8, filename_pady, filename_pady + TTF12_HEIGHT * 2 + 4) )
+			}
+		}
+	}
+#endif
+	// statistics window
+	if ( score_window || score_leaderboard_window == 3 )
+	{
+		if ( score_leaderboard_window == 3 )
+		{
+			drawWindowFancy(subx1 + 10, suby1 + 20, subx2 - 10, suby2 - 10);
+			if ( drawClickableButton(subx2 - 10 * TTF12_WIDTH - 3, suby1 + 20 + 8, 8 * TTF12_WIDTH, TTF12_HEIGHT, 0) )
+			{
+				score_leaderboard_window = 2;
+				for ( node = button_l.first; node != NULL; node = node->next )
 				{
-					drawDeleteTooltip = true;
+					button = (button_t*)node->element;
+					button->visible = 1;
 				}
-
-				filename_pady += 3 * filename_rowHeight / 2;
 			}
+			ttfPrintTextFormatted(ttf12, subx2 - 10 * TTF12_WIDTH + 9, suby1 + 20 + 8, "close");
 		}
+		// draw button label... shamelessly hacked together from "multiplayer scores toggle button" initialisation...
+		int toggleText_x = subx2 - 44 - strlen("show multiplayer") * 12;
+		int toggleText_y = suby1 + 4 ;
+		int w = 0;
+		int h = 0;
+		list_t* scoresPtr = &topscores;
 
-		Uint32 saveNumColor = uint32ColorGreen(*mainsurface);
-		if ( numSingleplayerSaves == SAVE_GAMES_MAX )
+		if ( !score_leaderboard_window )
 		{
-			saveNumColor = uint32ColorOrange(*mainsurface);
+			if ( !scoreDisplayMultiplayer )
+			{
+				getSizeOfText(ttf12, "show multiplayer", &w, &h);
+				ttfPrintText(ttf12, toggleText_x + (strlen("show multiplayer") * 12 + 8 - w) / 2, toggleText_y + (20 - h) / 2 + 3, "show multiplayer");
+			}
+			else
+			{
+				scoresPtr = &topscoresMultiplayer;
+				getSizeOfText(ttf12, "show solo", &w, &h);
+				ttfPrintText(ttf12, toggleText_x + (strlen("show multiplayer") * 12 + 8 - w) / 2, toggleText_y + (20 - h) / 2 + 3, "show solo");
+			}
 		}
-		ttfPrintTextFormattedColor(ttf12, subx2 - (longestline(language[3067]) * TTF12_WIDTH), suby1 + 44, saveNumColor,
-			language[3067], numSingleplayerSaves, SAVE_GAMES_MAX);
-
-		saveNumColor = uint32ColorGreen(*mainsurface);
-		if ( numMultiplayerSaves == SAVE_GAMES_MAX )
+		else
 		{
-			saveNumColor = uint32ColorOrange(*mainsurface);
+			scoresPtr = nullptr;
 		}
-		ttfPrintTextFormattedColor(ttf12, subx2 - (longestline(language[3068]) * TTF12_WIDTH), suby1 + 44 + TTF12_HEIGHT + 4, saveNumColor,
-			language[3068], numMultiplayerSaves, SAVE_GAMES_MAX);
 
-		// draw the tooltip we initialised earlier.
-		if ( drawDeleteTooltip )
-		{
-			tooltip.w = longestline(language[3064]) * TTF12_WIDTH + 16;
-			drawTooltip(&tooltip);
-			ttfPrintTextFormatted(ttf12, tooltip.x + 6, tooltip.y + 6, language[3064]);
-		}
-		else if ( drawScrollTooltip )
+		if ( !list_Size(scoresPtr) && !score_leaderboard_window )
 		{
-			tooltip.w = longestline(language[3066]) * TTF12_WIDTH + 16;
-			drawTooltip(&tooltip);
-			ttfPrintTextFormatted(ttf12, tooltip.x + 6, tooltip.y + 6, language[3066]);
+#define NOSCORESSTR language[1389]
+			ttfPrintTextFormatted(ttf16, xres / 2 - strlen(NOSCORESSTR) * 9, yres / 2 - 9, NOSCORESSTR);
 		}
-	}
-	else if ( gamemods_window != 0 )
-	{
-		int filenameMaxLength = 24;
-		int filename_padx = subx1 + 16;
-		int filename_pady = suby1 + 32;
-		int numFileEntries = 10;
-
-		int filename_padx2 = filename_padx + filenameMaxLength * TTF12_WIDTH + 8;
-		int filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 8;
-#ifdef STEAMWORKS
-		if ( gamemods_window == 1 || gamemods_window == 2 || gamemods_window == 5 )
+		else
 		{
-			if ( !currentDirectoryFiles.empty() )
+			if ( !score_leaderboard_window )
 			{
-				int lineNumber = 0;
-				std::string line;
-				std::list<std::string>::const_iterator it = currentDirectoryFiles.begin();
-				std::advance(it, gamemods_window_scroll);
-
-				drawWindow(filename_padx, filename_pady - 2,
-					filename_padx2, filename_pady2);
-
-				SDL_Rect pos;
-				pos.x = filename_padx;
-				pos.y = filename_pady - 2 + std::max(gamemods_window_fileSelect - 1, 0) * TTF12_HEIGHT;
-				pos.w = filenameMaxLength * TTF12_WIDTH + 8;
-				pos.h = TTF12_HEIGHT;
-				if ( gamemods_window_fileSelect != 0 )
+				if ( scoreDisplayMultiplayer )
 				{
-					drawRect(&pos, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+					ttfPrintTextFormatted(ttf16, subx1 + 8, suby1 + 8, "%s - %d / %d", language[2958], score_window, list_Size(&topscoresMultiplayer));
 				}
-
-				for ( ; it != currentDirectoryFiles.end() && lineNumber < numFileEntries; ++it )
+				else
 				{
-					line = *it;
-					line = line.substr(0, filenameMaxLength);
-					ttfPrintTextFormatted(ttf12, filename_padx, filename_pady + lineNumber * TTF12_HEIGHT, "%s", line.c_str());
-					++lineNumber;
+					ttfPrintTextFormatted(ttf16, subx1 + 8, suby1 + 8, "%s - %d / %d", language[1390], score_window, list_Size(&topscores));
 				}
-				int entriesToScroll = std::max(static_cast<int>((currentDirectoryFiles.size() / numFileEntries) - 1), 0);
-				entriesToScroll = entriesToScroll * numFileEntries + (currentDirectoryFiles.size() % numFileEntries);
+			}
 
-				if ( mouseInBounds(clientnum, filename_padx - 4, filename_padx2,
-					filename_pady, filename_pady2) && currentDirectoryFiles.size() > numFileEntries )
+			// draw character window
+			if (players[clientnum] != nullptr && players[clientnum]->entity != nullptr)
+			{
+				camera_charsheet.x = players[clientnum]->entity->x / 16.0 + 1.118 * cos(camera_charsheet_offsetyaw); // + 1
+				camera_charsheet.y = players[clientnum]->entity->y / 16.0 + 1.118 * sin(camera_charsheet_offsetyaw); // -.5
+				camera_charsheet.z = players[clientnum]->entity->z * 2;
+				camera_charsheet.ang = atan2(players[clientnum]->entity->y / 16.0 - camera_charsheet.y, players[clientnum]->entity->x / 16.0 - camera_charsheet.x);
+				camera_charsheet.vang = PI / 24;
+				camera_charsheet.winw = 400;
+				camera_charsheet.winy = suby1 + 32;
+				camera_charsheet.winh = suby2 - 96 - camera_charsheet.winy;
+				camera_charsheet.winx = subx1 + 32;
+				SDL_Rect pos;
+				pos.x = camera_charsheet.winx;
+				pos.y = camera_charsheet.winy;
+				pos.w = camera_charsheet.winw;
+				pos.h = camera_charsheet.winh;
+				drawRect(&pos, 0, 255);
+				b = players[clientnum]->entity->flags[BRIGHT];
+				players[clientnum]->entity->flags[BRIGHT] = true;
+				if ( !players[clientnum]->entity->flags[INVISIBLE] )
 				{
-					if ( mousestatus[SDL_BUTTON_WHEELUP] )
+					real_t ofov = fov;
+					fov = 50;
+					glDrawVoxel(&camera_charsheet, players[clientnum]->entity, REALCOLORS);
+					fov = ofov;
+				}
+				players[clientnum]->entity->flags[BRIGHT] = b;
+				c = 0;
+				for ( node = players[clientnum]->entity->children.first; node != NULL; node = node->next )
+				{
+					if ( c == 0 )
 					{
-						gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
-						mousestatus[SDL_BUTTON_WHEELUP] = 0;
+						c++;
 					}
-					if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+					entity = (Entity*) node->element;
+					if ( !entity->flags[INVISIBLE] )
 					{
-						gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
-						mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+						b = entity->flags[BRIGHT];
+						entity->flags[BRIGHT] = true;
+						real_t ofov = fov;
+						fov = 50;
+						glDrawVoxel(&camera_charsheet, entity, REALCOLORS);
+						fov = ofov;
+						entity->flags[BRIGHT] = b;
 					}
+					c++;
 				}
-				for ( int i = 1; i <= numFileEntries; ++i )
+				SDL_Rect rotateBtn;
+				rotateBtn.w = 24;
+				rotateBtn.h = 24;
+				rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w;
+				rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
+				drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
+				if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
 				{
-					if ( mouseInBounds(clientnum, filename_padx - 4, filename_padx2,
-						filename_pady - 2, filename_pady - 2 + i * TTF12_HEIGHT) )
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						if ( inputs.bMouseLeft(clientnum) )
+						camera_charsheet_offsetyaw += 0.05;
+						if ( camera_charsheet_offsetyaw > 2 * PI )
 						{
-							gamemods_window_fileSelect = i;
-							inputs.mouseClearLeft(clientnum);
+							camera_charsheet_offsetyaw -= 2 * PI;
 						}
+						drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
 					}
 				}
-				if ( !directoryToUpload.empty() )
-				{
-					ttfPrintTextFormatted(ttf12, filename_padx, filename_pady2 + TTF12_HEIGHT, "folder to upload: %s", directoryToUpload.c_str());
-				}
-			}
-		}
-		if ( gamemods_window == 2 || gamemods_window == 5 )
-		{
-			numFileEntries = 20;
-			filename_padx = subx2 - (filenameMaxLength * TTF12_WIDTH + 16);
-			filename_padx2 = subx2 - 16;
-			filename_pady = filename_pady2 + 2 * TTF12_HEIGHT;
-			filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 2;
-			if ( !directoryFilesListToUpload.empty() )
-			{
-				ttfPrintTextFormatted(ttf12, filename_padx, filename_pady - TTF12_HEIGHT, "file preview in folder:");
-				drawWindow(filename_padx, filename_pady - 2,
-					filename_padx2, filename_pady2);
-				int lineNumber = 0;
-				std::string line;
-				for ( std::list<std::string>::const_iterator it = directoryFilesListToUpload.begin(); it != directoryFilesListToUpload.end() && lineNumber < 20; ++it )
+				ttfPrintText(ttf12, rotateBtn.x + 6, rotateBtn.y + 6, ">");
+
+				rotateBtn.x = camera_charsheet.winx + camera_charsheet.winw - rotateBtn.w * 2 - 4;
+				rotateBtn.y = camera_charsheet.winy + camera_charsheet.winh - rotateBtn.h;
+				drawWindow(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
+				if ( mouseInBounds(clientnum, rotateBtn.x, rotateBtn.x + rotateBtn.w, rotateBtn.y, rotateBtn.y + rotateBtn.h) )
 				{
-					line = *it;
-					if ( line.size() >= filenameMaxLength )
-					{
-						line = line.substr(0, filenameMaxLength - 3);
-						line.append("..");
-					}
-					else
+					if ( inputs.bMouseLeft(clientnum) )
 					{
-						line = line.substr(0, filenameMaxLength);
+						camera_charsheet_offsetyaw -= 0.05;
+						if ( camera_charsheet_offsetyaw < 0.f )
+						{
+							camera_charsheet_offsetyaw += 2 * PI;
+						}
+						drawDepressed(rotateBtn.x, rotateBtn.y, rotateBtn.x + rotateBtn.w, rotateBtn.y + rotateBtn.h);
 					}
-					ttfPrintTextFormatted(ttf12, filename_padx, filename_pady + lineNumber * TTF12_HEIGHT, "%s", line.c_str());
-					++lineNumber;
 				}
+				ttfPrintText(ttf12, rotateBtn.x + 4, rotateBtn.y + 6, "<");
 			}
 
-			int status_padx = subx1 + 16;
-			int status_pady = filename_pady;
-			if ( gamemods_uploadStatus != 0 && g_SteamWorkshop )
+			// print name and class
+			if ( victory )
 			{
-				status_pady += 3 * TTF12_HEIGHT;
-				if ( gamemods_window == 2 )
+				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 40, language[1391]);
+				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 56, "%s", stats[clientnum]->name);
+				int creature = HUMAN;
+				if ( players[clientnum] && players[clientnum]->entity )
 				{
-					if ( g_SteamWorkshop->SubmitItemUpdateResult.m_eResult == 0
-						&& gamemods_uploadStatus < 5 )
-					{
-						switch ( g_SteamWorkshop->createItemResult.m_eResult )
-						{
-							case 0:
-								ttfPrintTextFormatted(ttf12, status_padx, status_pady, "creating item...");
-								break;
-							case k_EResultOK:
-								if ( gamemods_uploadStatus < 2 )
-								{
-									for ( node = button_l.first; node != NULL; node = nextnode )
-									{
-										nextnode = node->next;
-										button = (button_t*)node->element;
-										if ( button->action == &buttonGamemodsPrepareWorkshopItemUpload )
-										{
-											button->visible = false;
-										}
-									}
-									gamemods_uploadStatus = 2;
-									g_SteamWorkshop->StartItemUpdate();
-								}
-								else
-								{
-									if ( g_SteamWorkshop->UGCUpdateHandle == 0 )
-									{
-										ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "item created! awaiting file handle...");
-									}
-									else
-									{
-										if ( gamemods_uploadStatus == 2 )
-										{
-											gamemods_uploadStatus = 3;
-											// set item fields button
-											button = newButton();
-											strcpy(button->label, "set item fields");
-											button->x = subx1 + 16;
-											button->y = suby1 + TTF12_HEIGHT * 34;
-											button->sizex = 16 * TTF12_WIDTH + 8;
-											button->sizey = 32;
-											button->action = &buttonGamemodsSetWorkshopItemFields;
-											button->visible = 1;
-											button->focused = 1;
-											gamemods_currentEditField = 0;
-										}
-										ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), "item and file handle create success!");
-									}
-								}
-								break;
-							default:
-								// error in createItem!
-								ttfPrintTextFormatted(ttf12, status_padx, status_pady, "error in creating item!");
-								break;
-						}
-						status_pady += 2 * TTF12_HEIGHT;
-						if ( gamemods_uploadStatus >= 3 && g_SteamWorkshop->SubmitItemUpdateResult.m_eResult == 0 )
-						{
-							for ( int fields = 0; fields < 2; ++fields )
-							{
-								status_pady += TTF12_HEIGHT;
-								drawDepressed(status_padx, status_pady - 4, status_padx + 32 * TTF12_WIDTH, status_pady + TTF12_HEIGHT);
-								switch ( fields )
-								{
-									case 0:
-										ttfPrintText(ttf12, status_padx + 8, status_pady - TTF12_HEIGHT, "Enter a title:");
-										if ( gamemods_uploadStatus == 3 && gamemods_workshopSetPropertyReturn[0] )
-										{
-											ttfPrintTextColor(ttf12, status_padx + 20 * TTF12_WIDTH, status_pady - TTF12_HEIGHT, uint32ColorGreen(*mainsurface), true, "success set");
-										}
-										ttfPrintText(ttf12, status_padx + 8, status_pady, gamemods_uploadTitle);
-										break;
-									case 1:
-										ttfPrintText(ttf12, status_padx + 8, status_pady - TTF12_HEIGHT, "Enter description:");
-										if ( gamemods_uploadStatus == 3 && gamemods_workshopSetPropertyReturn[1] )
-										{
-
-										}
-										ttfPrintText(ttf12, status_padx + 8, status_pady, gamemods_uploadDescription);
-										break;
-									default:
-										break;
-								}
-								if ( gamemods_uploadStatus == 4 )
-								{
-									if ( gamemods_workshopSetPropertyReturn[fields] )
-									{
-										ttfPrintTextColor(ttf12, status_padx + 20 * TTF12_WIDTH, status_pady - TTF12_HEIGHT, uint32ColorGreen(*mainsurface), true, "success set");
-									}
-									else
-									{
-										ttfPrintTextColor(ttf12, status_padx + 20 * TTF12_WIDTH, status_pady - TTF12_HEIGHT, uint32ColorRed(*mainsurface), true, "error!");
-									}
-								}
-
-								if ( mouseInBounds(clientnum, status_padx, status_padx + 32 * TTF12_WIDTH, status_pady - 4, status_pady + TTF12_HEIGHT) )
-								{
-									if ( inputs.bMouseLeft(clientnum) )
-									{
-										switch ( fields )
-										{
-											case 0:
-												inputstr = gamemods_uploadTitle;
-												gamemods_currentEditField = 0;
-												break;
-											case 1:
-												inputstr = gamemods_uploadDescription;
-												gamemods_currentEditField = 1;
-												break;
-											default:
-												break;
-										}
-										inputs.mouseClearLeft(clientnum);
-									}
-								}
-
-								if ( gamemods_uploadStatus == 3 && !SDL_IsTextInputActive() )
-								{
-									inputstr = gamemods_uploadTitle;
-									SDL_StartTextInput();
-								}
-								inputlen = 30;
-								if ( SDL_IsTextInputActive() && gamemods_currentEditField == fields
-									&& (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
-								{
-									int x;
-									getSizeOfText(ttf12, inputstr, &x, NULL);
-									ttfPrintText(ttf12, status_padx + x + 8, status_pady, "_");
-								}
-								status_pady += 2 * TTF12_HEIGHT;
-							}
-							if ( gamemods_uploadStatus >= 4 )
-							{
-								if ( gamemods_workshopSetPropertyReturn[2] )
-								{
-									ttfPrintTextColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), true, "folder path success set");
-								}
-								else
-								{
-									ttfPrintTextColor(ttf12, status_padx, status_pady, uint32ColorRed(*mainsurface), true, "error in folder path!");
-								}
-							}
-
-							status_pady += 2 * TTF12_HEIGHT;
-							// set some workshop item tags
-							ttfPrintText(ttf12, status_padx, status_pady, "Select workshop tags");
-							int tag_padx = status_padx;
-							int tag_pady = status_pady + TTF12_HEIGHT;
-							int tag_padx1 = tag_padx + 20 * TTF12_WIDTH;
-							gamemodsDrawWorkshopItemTagToggle("dungeons", tag_padx, tag_pady);
-							gamemodsDrawWorkshopItemTagToggle("textures", tag_padx1, tag_pady);
-							tag_pady += TTF12_HEIGHT + 4;
-							gamemodsDrawWorkshopItemTagToggle("models", tag_padx, tag_pady);
-							gamemodsDrawWorkshopItemTagToggle("gameplay", tag_padx1, tag_pady);
-							tag_pady += TTF12_HEIGHT + 4;
-							gamemodsDrawWorkshopItemTagToggle("audio", tag_padx, tag_pady);
-							gamemodsDrawWorkshopItemTagToggle("translations", tag_padx1, tag_pady);
-							tag_pady += TTF12_HEIGHT + 4;
-							gamemodsDrawWorkshopItemTagToggle("misc", tag_padx, tag_pady);
-						}
-					}
+					creature = static_cast<int>(players[clientnum]->entity->getMonsterFromPlayerRace(stats[clientnum]->playerRace));
 				}
-				else if ( gamemods_window == 5 && g_SteamWorkshop->m_myWorkshopItemToModify.m_nPublishedFileId != 0 && gamemods_uploadStatus < 5 )
+				if ( victory == 1 )
 				{
-					std::string line = g_SteamWorkshop->m_myWorkshopItemToModify.m_rgchTitle;
-					if ( line.size() > filenameMaxLength )
-					{
-						line = line.substr(0, filenameMaxLength - 2);
-						line.append("..");
-					}
-					status_pady += 2 * TTF12_HEIGHT;
-					ttfPrintTextFormattedColor(ttf12, status_padx + 8, status_pady, uint32ColorBaronyBlue(*mainsurface), "Title:");
-					status_pady += TTF12_HEIGHT;
-					ttfPrintTextFormatted(ttf12, status_padx + 8, status_pady, "%s", line.c_str());
-
-					line = g_SteamWorkshop->m_myWorkshopItemToModify.m_rgchDescription;
-					if ( line.size() > filenameMaxLength )
+					if ( creature != HUMAN )
 					{
-						line = line.substr(0, filenameMaxLength - 2);
-						line.append("..");
+						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3359], monstertypenamecapitalized[creature]);
 					}
-					status_pady += TTF12_HEIGHT;
-					ttfPrintTextFormattedColor(ttf12, status_padx + 8, status_pady, uint32ColorBaronyBlue(*mainsurface), "Description:");
-					status_pady += TTF12_HEIGHT;
-					ttfPrintTextFormatted(ttf12, status_padx + 8, status_pady, "%s", line.c_str());
-
-					status_pady += 2 * TTF12_HEIGHT;
-					// set some workshop item tags
-					ttfPrintText(ttf12, status_padx, status_pady, "Modify workshop tags");
-					int tag_padx = status_padx;
-					int tag_pady = status_pady + TTF12_HEIGHT;
-					int tag_padx1 = tag_padx + 20 * TTF12_WIDTH;
-					gamemodsDrawWorkshopItemTagToggle("dungeons", tag_padx, tag_pady);
-					gamemodsDrawWorkshopItemTagToggle("textures", tag_padx1, tag_pady);
-					tag_pady += TTF12_HEIGHT + 4;
-					gamemodsDrawWorkshopItemTagToggle("models", tag_padx, tag_pady);
-					gamemodsDrawWorkshopItemTagToggle("gameplay", tag_padx1, tag_pady);
-					tag_pady += TTF12_HEIGHT + 4;
-					gamemodsDrawWorkshopItemTagToggle("audio", tag_padx, tag_pady);
-					gamemodsDrawWorkshopItemTagToggle("translations", tag_padx1, tag_pady);
-					tag_pady += TTF12_HEIGHT + 4;
-					gamemodsDrawWorkshopItemTagToggle("misc", tag_padx, tag_pady);
-
-					status_pady += 6 * TTF12_HEIGHT;
-					if ( directoryFilesListToUpload.empty() )
+					else
 					{
-						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), "Only Workshop tags will be updated.");
+						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[1392]);
+					}
+				}
+				else if ( victory == 2 )
+				{
+					if ( creature != HUMAN )
+					{
+						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3360], monstertypenamecapitalized[creature]);
 					}
 					else
 					{
-						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "Workshop file contents will be updated.");
+						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[1393]);
 					}
 				}
-				status_pady += 5 * TTF12_HEIGHT;
-				if ( gamemods_uploadStatus >= 5 )
+				else if ( victory == 3 )
 				{
-					uint64 bytesProc;
-					uint64 bytesTotal;
-					int status = SteamUGC()->GetItemUpdateProgress(g_SteamWorkshop->UGCUpdateHandle, &bytesProc, &bytesTotal);
-					if ( g_SteamWorkshop->SubmitItemUpdateResult.m_eResult != 0 )
+					if ( creature != HUMAN )
 					{
-						for ( node = button_l.first; node != NULL; node = nextnode )
-						{
-							nextnode = node->next;
-							button = (button_t*)node->element;
-							if ( button->action == &buttonGamemodsPrepareWorkshopItemUpload
-								|| button->action == &buttonGamemodsStartUploadItem
-								|| button->action == &buttonGamemodsSetWorkshopItemFields
-								|| button->action == &buttonGamemodsSelectDirectoryForUpload
-								|| button->action == &buttonGamemodsModifyExistingWorkshopItemFields
-								|| button->action == &buttonGamemodsCancelModifyFileContents )
-							{
-								button->visible = false;
-							}
-						}
-						if ( g_SteamWorkshop->SubmitItemUpdateResult.m_eResult == k_EResultOK )
-						{
-							if ( g_SteamWorkshop->uploadSuccessTicks == 0 )
-							{
-								g_SteamWorkshop->uploadSuccessTicks = ticks;
-							}
-							else
-							{
-								if ( ticks - g_SteamWorkshop->uploadSuccessTicks > TICKS_PER_SECOND * 5 )
-								{
-									//cleanup the interface.
-									buttonCloseSubwindow(NULL);
-									list_FreeAll(&button_l);
-									deleteallbuttons = true;
-									gamemodsSubscribedItemsInit();
-								}
-							}
-							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), "successfully uploaded!");
-							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady + TTF12_HEIGHT, uint32ColorGreen(*mainsurface), "reloading window in %d...!", 5 - ((ticks - g_SteamWorkshop->uploadSuccessTicks) / TICKS_PER_SECOND));
-						}
-						else
-						{
-							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "error! %d", g_SteamWorkshop->SubmitItemUpdateResult.m_eResult);
-							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady + TTF12_HEIGHT, uint32ColorOrange(*mainsurface), "close the window and try again.");
-						}
+						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3361], 
+							language[3363 - 1 + stats[clientnum]->playerRace]);
 					}
 					else
 					{
-						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "uploading... status %d", status);
-						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady + TTF12_HEIGHT, uint32ColorOrange(*mainsurface), "bytes processed: %d", bytesProc);
+						ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[2911]);
 					}
 				}
 			}
-		}
-		if ( gamemods_window == 3 || gamemods_window == 4 )
-		{
-			numFileEntries = 8;
-			filenameMaxLength = 48;
-			filename_padx = subx1 + 16;
-			filename_pady = suby1 + 32;
-			filename_padx2 = subx2 - 16 - 40;
-			filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 8;
-			int filename_rowHeight = 2 * TTF12_HEIGHT + 8;
+			else
+			{
+				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 40, language[1394]);
+				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 56, "%s", stats[clientnum]->name);
 
+				char classname[64];
+				strcpy(classname, playerClassLangEntry(client_classes[0], clientnum));
+				classname[0] -= 32;
+				int creature = HUMAN;
+				if ( players[clientnum] && players[clientnum]->entity )
+				{
+					creature = static_cast<int>(players[clientnum]->entity->getMonsterFromPlayerRace(stats[clientnum]->playerRace));
+				}
+				if ( creature != HUMAN )
+				{
+					ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[3362], monstertypenamecapitalized[creature], classname);
+				}
+				else
+				{
+					ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 72, language[1395], classname);
+				}
+			}
 
-			if ( gamemods_subscribedItemsStatus == 0 )
+			// print total score
+			if ( score_leaderboard_window != 3 )
 			{
-				if ( g_SteamWorkshop->SteamUGCQueryCompleted.m_eResult == k_EResultOK )
+				node = list_Node(scoresPtr, score_window - 1);
+				if ( node )
 				{
-					gamemods_subscribedItemsStatus = 1;
+					score_t* score = (score_t*)node->element;
+					ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 104, language[1404], totalScore(score));
 				}
 			}
 			else
 			{
-				filename_pady += 1 * TTF12_HEIGHT;
+#ifdef STEAMWORKS
+				ttfPrintTextFormatted(ttf16, subx1 + 448, suby1 + 104, language[1404], g_SteamLeaderboards->downloadedTags[g_SteamLeaderboards->currentLeaderBoardIndex][TAG_TOTAL_SCORE]);
+#endif // STEAMWORKS
+			}
 
+			Entity* playerEntity = nullptr;
+			if ( players[clientnum] )
+			{
+				playerEntity = players[clientnum]->entity;
+			}
 
-				filename_pady += 2 * TTF12_HEIGHT;
-				if ( gamemods_window == 3 )
+			// print character stats
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 128, language[359], stats[clientnum]->LVL, playerClassLangEntry(client_classes[clientnum], clientnum));
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 140, language[1396], stats[clientnum]->EXP);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 152, language[1397], stats[clientnum]->GOLD);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 164, language[361], currentlevel);
+
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 188, language[1398], statGetSTR(stats[clientnum], playerEntity), stats[clientnum]->STR);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 200, language[1399], statGetDEX(stats[clientnum], playerEntity), stats[clientnum]->DEX);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 212, language[1400], statGetCON(stats[clientnum], playerEntity), stats[clientnum]->CON);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 224, language[1401], statGetINT(stats[clientnum], playerEntity), stats[clientnum]->INT);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 236, language[1402], statGetPER(stats[clientnum], playerEntity), stats[clientnum]->PER);
+			ttfPrintTextFormatted(ttf12, subx1 + 456, suby1 + 248, language[1403], statGetCHR(stats[clientnum], playerEntity), stats[clientnum]->CHR);
+
+			// time
+			Uint32 sec = (completionTime / TICKS_PER_SECOND) % 60;
+			Uint32 min = ((completionTime / TICKS_PER_SECOND) / 60) % 60;
+			Uint32 hour = ((completionTime / TICKS_PER_SECOND) / 60) / 60;
+			ttfPrintTextFormatted(ttf12, subx1 + 32, suby2 - 80, "%s: %02d:%02d:%02d. %s:", language[1405], hour, min, sec, language[1406]);
+			if ( !conductPenniless && !conductFoodless && !conductVegetarian && !conductIlliterate && !conductGameChallenges[CONDUCT_HARDCORE]
+				&& !conductGameChallenges[CONDUCT_CHEATS_ENABLED]
+				&& !conductGameChallenges[CONDUCT_MODDED]
+				&& !conductGameChallenges[CONDUCT_LIFESAVING]
+				&& !conductGameChallenges[CONDUCT_KEEPINVENTORY]
+				&& !conductGameChallenges[CONDUCT_BRAWLER]
+				&& !conductGameChallenges[CONDUCT_RANGED_ONLY]
+				&& !conductGameChallenges[CONDUCT_BLESSED_BOOTS_SPEED]
+				&& !conductGameChallenges[CONDUCT_BOOTS_SPEED]
+				&& !conductGameChallenges[CONDUCT_ACCURSED]
+				&& !conductGameChallenges[CONDUCT_MULTIPLAYER])
+			{
+				ttfPrintText(ttf12, subx1 + 32, suby2 - 64, language[1407]);
+			}
+			else
+			{
+				int b = 0;
+				strcpy(tempstr, " ");
+				if ( conductPenniless )
 				{
-					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "successfully retrieved subscribed items!");
+					strcat(tempstr, language[1408]);
+					++b;
 				}
-				else
+				if ( conductFoodless )
 				{
-					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "successfully retrieved my workshop items!");
+					if ( b > 0 )
+					{
+						strcat(tempstr, ", ");
+					}
+					strcat(tempstr, language[1409]);
+					++b;
 				}
-
-				std::string modInfoStr = "current loaded mods (hover for info): ";
-				SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
-				bool drawModLoadOrder = false;
-				int drawExtendedInformationForMod = -1; // value of 0 or greater will draw.
-				int maxDescriptionLines = 10;
-
-				tooltip.x = omousex - 256;
-				tooltip.y = omousey + 16;
-				tooltip.w = 32 + TTF12_WIDTH * 64;
-				tooltip.h = (gamemods_mountedFilepaths.size() + 1) * TTF12_HEIGHT + 8;
-
-				if ( gamemods_mountedFilepaths.size() > 0 && gamemods_window == 3 )
+				if ( conductVegetarian )
 				{
-					ttfPrintTextFormatted(ttf12, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_pady, "%s %2d", modInfoStr.c_str(), gamemods_mountedFilepaths.size());
-					if ( mouseInBounds(clientnum, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_padx2, filename_pady, filename_pady + TTF12_HEIGHT) )
+					if ( b > 0 )
 					{
-						drawModLoadOrder = true;
+						strcat(tempstr, ", ");
 					}
-					else
+					strcat(tempstr, language[1410]);
+					++b;
+				}
+				if ( conductIlliterate )
+				{
+					if ( b > 0 )
 					{
-						drawModLoadOrder = false;
+						strcat(tempstr, ", ");
 					}
+					strcat(tempstr, language[1411]);
+					++b;
 				}
+				for ( int c = 0; c < NUM_CONDUCT_CHALLENGES; ++c )
+				{
+					if ( conductGameChallenges[c] != 0 )
+					{
+						if ( b > 0 )
+						{
+							strcat(tempstr, ", ");
+						}
+						if ( b > 0 && b % 4 == 0 )
+						{
+							strcat(tempstr, "\n ");
+						}
+						strcat(tempstr, language[2925 + c]);
+						++b;
+					}
+				}
+				/*	if ( b > 0 )
+				{
+					tempstr[strlen(tempstr) - 2] = 0;
+				}*/
+				ttfPrintTextFormatted(ttf12, subx1 + 20, suby2 - 64, tempstr);
+			}
 
-				filename_pady += 2 * TTF12_HEIGHT;
-
-				// do slider
-				SDL_Rect slider;
-				slider.x = filename_padx2 + 8;
-				slider.y = filename_pady - 8;
-				slider.h = suby2 - (filename_pady + 20);
-				slider.w = 32;
-
-				int numSubscribedItemsReturned = g_SteamWorkshop->SteamUGCQueryCompleted.m_unNumResultsReturned;
-				int entriesToScroll = std::max(static_cast<int>((numSubscribedItemsReturned / numFileEntries) - 1), 0);
-				entriesToScroll = entriesToScroll * numFileEntries + (numSubscribedItemsReturned % numFileEntries);
-
-				// handle slider movement.
-				if ( numSubscribedItemsReturned > numFileEntries )
+			// kills
+			int x = 0, y = 0;
+			ttfPrintText(ttf12, subx1 + 456, suby1 + 272, language[1412]);
+			bool nokills = true;
+			for ( x = 0; x < NUMMONSTERS; x++ )
+			{
+				if ( kills[x] )
 				{
-					drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-					if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
-						slider.y, slider.y + slider.h) )
+					nokills = false;
+					if ( kills[x] > 1 )
 					{
-						if ( mousestatus[SDL_BUTTON_WHEELUP] )
+						if ( x < KOBOLD )
 						{
-							gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
-							mousestatus[SDL_BUTTON_WHEELUP] = 0;
+							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[111 + x]);
 						}
-						if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+						else
 						{
-							gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
-							mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[2050 + (x - KOBOLD)]);
 						}
 					}
-				
-					if ( keystatus[SDL_SCANCODE_UP] )
-					{
-						gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
-						keystatus[SDL_SCANCODE_UP] = 0;
-					}
-					if ( keystatus[SDL_SCANCODE_DOWN] )
-					{
-						gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
-						keystatus[SDL_SCANCODE_DOWN] = 0;
-					}
-					slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
-					slider.y += slider.h * gamemods_window_scroll;
-					if ( gamemods_window_scroll == entriesToScroll ) // reached end.
+					else
 					{
-						slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
+						if ( x < KOBOLD )
+						{
+							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[90 + x]);
+						}
+						else
+						{
+							ttfPrintTextFormatted(ttf12, subx1 + 456 + (y / 14) * 156, suby1 + 296 + (y % 14) * 12, "%d %s", kills[x], language[2000 + (x - KOBOLD)]);
+						}
 					}
-					drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
+					y++;
 				}
+			}
+			if ( nokills )
+			{
+				ttfPrintText(ttf12, subx1 + 456, suby1 + 296, language[1413]);
+			}
+		}
+	}
+	else
+	{
+		scoreDisplayMultiplayer = false;
+	}
 
-				// draw last message results
-				if ( ticks - g_SteamWorkshop->LastActionResult.creationTick < TICKS_PER_SECOND * 5 )
+	if ( savegames_window != 0 )
+	{
+		int numSavesToShow = 5;
+		int filenameMaxLength = 48;
+		int filename_padx = subx1 + 16;
+		int filename_pady = suby1 + 32;
+		int filename_padx2 = subx2 - 16 - 40;
+		int filename_pady2 = filename_pady + numSavesToShow * TTF12_HEIGHT + 8;
+		int filename_rowHeight = 2 * TTF12_HEIGHT + 8;
+		filename_pady += 3 * TTF12_HEIGHT;
+		int numSaves = savegamesList.size();
+		if ( numSaves > 0 )
+		{
+			//ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), language[3066]);
+		}
+
+		SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
+
+		tooltip.x = omousex + 8;
+		tooltip.y = omousey + 8;
+		tooltip.w = 32 + TTF12_WIDTH * 14;
+		tooltip.h = TTF12_HEIGHT + 8;
+
+		filename_pady += 2 * TTF12_HEIGHT;
+
+		// do slider
+		SDL_Rect slider;
+		slider.x = filename_padx2 + 8;
+		slider.y = filename_pady - 8;
+		slider.h = suby2 - (filename_pady + 20);
+		slider.w = 32;
+
+		int entriesToScroll = std::max(static_cast<int>((numSaves / numSavesToShow) - 1), 0);
+		entriesToScroll = entriesToScroll * numSavesToShow + (numSaves % numSavesToShow);
+
+		bool drawScrollTooltip = false;
+
+		// handle slider movement.
+		if ( numSaves > numSavesToShow )
+		{
+			drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+			if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
+				slider.y, slider.y + slider.h) )
+			{
+				if ( mouseInBounds(clientnum, slider.x, slider.x + slider.w,
+					slider.y, slider.y + slider.h) )
 				{
-					ttfPrintTextFormattedColor(ttf12, filename_padx + 8, suby2 - TTF12_HEIGHT - 4, uint32ColorOrange(*mainsurface), "%s returned status %d", 
-						g_SteamWorkshop->LastActionResult.actionMsg.c_str(), static_cast<int>(g_SteamWorkshop->LastActionResult.lastResult));
+					drawScrollTooltip = true;
 				}
-
-				// draw the content
-				for ( int i = gamemods_window_scroll; i < numSubscribedItemsReturned && i < numFileEntries + gamemods_window_scroll; ++i )
+				if ( mousestatus[SDL_BUTTON_WHEELUP] )
 				{
-					filename_padx = subx1 + 16;
-					SteamUGCDetails_t itemDetails = g_SteamWorkshop->m_subscribedItemListDetails[i];
-					char fullpath[PATH_MAX];
-					if ( itemDetails.m_eResult == k_EResultOK )
-					{
-						drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
-						SDL_Rect highlightEntry;
-						highlightEntry.x = filename_padx;
-						highlightEntry.y = filename_pady - 8;
-						highlightEntry.w = filename_padx2 - filename_padx;
-						highlightEntry.h = filename_rowHeight + 8;
-						drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
-
-						bool itemDownloaded = SteamUGC()->GetItemInstallInfo(itemDetails.m_nPublishedFileId, NULL, fullpath, PATH_MAX, NULL);
-						bool pathIsMounted = gamemodsIsPathInMountedFiles(fullpath);
+					savegames_window_scroll = std::max(savegames_window_scroll - 1, 0);
+					mousestatus[SDL_BUTTON_WHEELUP] = 0;
+				}
+				if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+				{
+					savegames_window_scroll = std::min(savegames_window_scroll + 1, entriesToScroll);
+					mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+				}
+			}
 
-						if ( pathIsMounted && gamemods_window == 3 )
-						{
-							SDL_Rect pos;
-							pos.x = filename_padx + 2;
-							pos.y = filename_pady - 6;
-							pos.w = filename_padx2 - filename_padx - 4;
-							pos.h = filename_rowHeight + 4;
-							drawRect(&pos, uint32ColorGreen(*mainsurface), 64);
-						}
+			if ( keystatus[SDL_SCANCODE_UP] )
+			{
+				savegames_window_scroll = std::max(savegames_window_scroll - 1, 0);
+				keystatus[SDL_SCANCODE_UP] = 0;
+			}
+			if ( keystatus[SDL_SCANCODE_DOWN] )
+			{
+				savegames_window_scroll = std::min(savegames_window_scroll + 1, entriesToScroll);
+				keystatus[SDL_SCANCODE_DOWN] = 0;
+			}
+			slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
+			slider.y += slider.h * savegames_window_scroll;
+			if ( savegames_window_scroll == entriesToScroll ) // reached end.
+			{
+				slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
+			}
+			drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
+		}
+		else
+		{
+			//drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+			drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h);
+		}
 
-						// draw preview title
-						std::string line = itemDetails.m_rgchTitle;
-						std::size_t found = line.find_first_of('\n');
-						if ( found != std::string::npos && found < filenameMaxLength - 2 )
-						{
-							line = line.substr(0, found); // don't print out newlines.
-							line.append("..");
-						}
-						else if ( line.length() >= filenameMaxLength )
-						{
-							line = line.substr(0, filenameMaxLength - 2);
-							line.append("..");
-						}
-						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "Title: %s", line.c_str());
+		bool drawDeleteTooltip = false;
+		int numSingleplayerSaves = 0;
+		int numMultiplayerSaves = 0;
 
-						// draw preview description
-						line = itemDetails.m_rgchDescription;
-						found = line.find_first_of('\n');
-						if ( found != std::string::npos && found < filenameMaxLength - 2 )
-						{
-							line = line.substr(0, found);
-							line.append("..");
-						}
-						else if ( line.length() >= filenameMaxLength )
-						{
-							line = line.substr(0, filenameMaxLength - 2);
-							line.append("..");
-						}
-						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady + TTF12_HEIGHT, "Desc: %s", line.c_str());
+		// draw the content
+		for ( int i = 0; i < numSaves && !savegamesList.empty(); ++i ) //TODO: Why did this line add `&& !savegamesList.empty()` ?
+		{
+			filename_padx = subx1 + 16;
 
-						// if hovering over title or description, provide more info...
-						if ( mouseInBounds(clientnum, filename_padx + 8, filename_padx + 8 + 52 * TTF12_WIDTH, filename_pady + TTF12_HEIGHT, filename_pady + 2 * TTF12_HEIGHT) )
-						{
-							drawExtendedInformationForMod = i;
-						}
+			std::vector<std::tuple<int, int, int, std::string>>::iterator it = savegamesList.begin();
+			std::advance(it, i);
+			std::tuple<int, int, int, std::string> entry = *it;
 
-						filename_padx = filename_padx2 - (12 * TTF12_WIDTH + 16) * 2;
-						// download button
-						if ( gamemods_window == 3 )
-						{
-							if ( !itemDownloaded )
-							{
-								if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, uint32ColorBaronyBlue(*mainsurface), " Download ", 0) )
-								{
-									SteamUGC()->DownloadItem(itemDetails.m_nPublishedFileId, true);
-								}
-							}
-							filename_padx += (12 * TTF12_WIDTH + 16);
-							// mount button
-							if ( itemDownloaded && !pathIsMounted )
-							{
-								if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, " Load Item ", 0) )
-								{
-									if ( PHYSFS_mount(fullpath, NULL, 0) )
-									{
-										gamemods_mountedFilepaths.push_back(std::make_pair(fullpath, itemDetails.m_rgchTitle));
-										gamemods_workshopLoadedFileIDMap.push_back(std::make_pair(itemDetails.m_rgchTitle, itemDetails.m_nPublishedFileId));
-										gamemods_modelsListRequiresReload = true;
-										gamemods_soundListRequiresReload = true;
-									}
-								}
-							}
-							filename_padx -= (12 * TTF12_WIDTH + 16);
-						}
-						if ( gamemods_window == 4 )
-						{
-							filename_padx += (12 * TTF12_WIDTH + 16);
-							// edit content button
-							if ( gamemodsDrawClickableButton(filename_padx, filename_pady + filename_rowHeight / 4, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, uint32ColorBaronyBlue(*mainsurface), "  Update  ", 0) )
-							{
-								buttonGamemodsOpenModifyExistingWindow(nullptr);
-								gamemods_window = 5;
-								gamemods_uploadStatus = 1;
-								g_SteamWorkshop->m_myWorkshopItemToModify = itemDetails;
+			if ( std::get<1>(entry) != SINGLE )
+			{
+				++numMultiplayerSaves;
+			}
+			else
+			{
+				++numSingleplayerSaves;
+			}
 
-								// grab the current item tags and store them for modification.
-								std::string workshopItemTagString = g_SteamWorkshop->m_myWorkshopItemToModify.m_rgchTags;
-								std::size_t found = workshopItemTagString.find(",");
-								g_SteamWorkshop->workshopItemTags.clear();
-								while ( found != std::string::npos )
-								{
-									std::string line = workshopItemTagString.substr(0, found);
-									workshopItemTagString = workshopItemTagString.substr(found + 1); // skip the "," character.
-									g_SteamWorkshop->workshopItemTags.push_back(line); // store the comma separated value.
-									found = workshopItemTagString.find(",");
-								}
-								// add the final string.
-								g_SteamWorkshop->workshopItemTags.push_back(workshopItemTagString); 
-							}
-						}
-						filename_pady += filename_rowHeight / 2;
-						if ( gamemods_window == 3 )
-						{
-							// unsubscribe button
-							if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, uint32ColorRed(*mainsurface), "Unsubscribe", 0) )
-							{
-								if ( pathIsMounted )
-								{
-									if ( PHYSFS_unmount(fullpath) )
-									{
-										if ( gamemodsRemovePathFromMountedFiles(fullpath) )
-										{
-											printlog("[%s] is removed from the search path.\n", fullpath);
-											gamemods_modelsListRequiresReload = true;
-											gamemods_soundListRequiresReload = true;
-										}
-									}
-								}
-								g_SteamWorkshop->UnsubscribeItemFileID(itemDetails.m_nPublishedFileId);
-								gamemods_window_scroll = 0;
-							}
-							filename_padx += (12 * TTF12_WIDTH + 16);
-							// unmount button
-							if ( itemDownloaded && pathIsMounted )
-							{
-								if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, "Unload Item", 0) )
-								{
-									if ( PHYSFS_unmount(fullpath) )
-									{
-										if ( gamemodsRemovePathFromMountedFiles(fullpath) )
-										{
-											printlog("[%s] is removed from the search path.\n", fullpath);
-											gamemods_modelsListRequiresReload = true;
-											gamemods_soundListRequiresReload = true;
-										}
-									}
-								}
-							}
-						}
+			if ( i >= savegames_window_scroll && i < numSavesToShow + savegames_window_scroll )
+			{
+				drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
+				SDL_Rect highlightEntry;
+				highlightEntry.x = filename_padx;
+				highlightEntry.y = filename_pady - 8;
+				highlightEntry.w = filename_padx2 - filename_padx;
+				highlightEntry.h = filename_rowHeight + 8;
+				if ( gamemods_numCurrentModsLoaded >= 0 )
+				{
+					if ( std::get<1>(entry) == SINGLE ) // single player.
+					{
+						drawRect(&highlightEntry, uint32ColorGreen(*mainsurface), 64);
+					}
+					else
+					{
+						drawRect(&highlightEntry, uint32ColorGreen(*mainsurface), 32);
 					}
-					filename_pady += filename_rowHeight;
 				}
-
-				// draw the tooltip we initialised earlier.
-				if ( drawModLoadOrder )
+				else
 				{
-					drawTooltip(&tooltip);
-					int numLoadedModLine = 1;
-					ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 4, uint32ColorBaronyBlue(*mainsurface), 
-						"Current load list: (first is lowest priority)");
-					for ( std::vector<std::pair<std::string, std::string>>::iterator it = gamemods_mountedFilepaths.begin(); it != gamemods_mountedFilepaths.end(); ++it )
+					if ( std::get<1>(entry) == SINGLE ) // single player.
 					{
-						std::pair<std::string, std::string> line = *it;
-						modInfoStr = line.second;
-						if ( modInfoStr.length() > 64 )
-						{
-							modInfoStr = modInfoStr.substr(0, 64 - 2).append("..");
-						}
-						ttfPrintTextFormatted(ttf12, tooltip.x + 4, tooltip.y + 4 + numLoadedModLine * TTF12_HEIGHT, "%2d) %s", numLoadedModLine, modInfoStr.c_str());
-						++numLoadedModLine;
+						drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 48);
+						//drawRect(&highlightEntry, uint32ColorBaronyBlue(*mainsurface), 16);
+					}
+					else
+					{
+						drawRect(&highlightEntry, uint32ColorBaronyBlue(*mainsurface), 32);
 					}
 				}
-				else if ( drawExtendedInformationForMod >= 0 )
+
+				ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "[%d]: %s", i + 1, std::get<3>(entry).c_str());
+
+				filename_padx = filename_padx2 - (13 * TTF12_WIDTH + 16);
+				int text_x = filename_padx;
+				int text_y = filename_pady + 10;
+				if ( drawClickableButton(filename_padx, filename_pady, 10 * TTF12_WIDTH + 8, TTF12_HEIGHT * 2 + 4, 0) )
 				{
-					int tooltip_pady = 8;
-					SteamUGCDetails_t itemDetails = g_SteamWorkshop->m_subscribedItemListDetails[drawExtendedInformationForMod];
-					// draw the information.
-					std::string line;
+					if ( std::get<1>(entry) == SINGLE )
+					{
+						savegameCurrentFileIndex = std::get<2>(entry);
+						buttonLoadSingleplayerGame(nullptr);
+					}
+					else
+					{
+						savegameCurrentFileIndex = std::get<2>(entry);
+						buttonLoadMultiplayerGame(nullptr);
+					}
+				}
+				ttfPrintTextFormatted(ttf12, text_x + 8, text_y, "%s", "Load Game");
 
-					line = itemDetails.m_rgchDescription;
-					line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
-					//line.erase(std::remove(line.begin(), line.end(), '\n'), line.end());
-					std::string subString;
-					std::string outputStr;
-					std::size_t found = line.find('\n');
-					int numlines = 0;
-					while ( line.length() >= 62 || (found != std::string::npos && found < 62) )
+				filename_padx = filename_padx2 - (2 * TTF12_WIDTH + 14);
+				text_x = filename_padx;
+				if ( drawClickableButton(filename_padx, filename_pady, 2 * TTF12_WIDTH + 8, TTF12_HEIGHT * 2 + 4, uint32ColorRed(*mainsurface)) )
+				{
+					if ( std::get<1>(entry) == SINGLE )
 					{
-						if ( numlines >= maxDescriptionLines )
-						{
-							break;
-						}
-						if ( found != std::string::npos && found < 62 )
-						{
-							// found newline.
-							subString = line.substr(0, found);
-							line = line.substr(found + 1);
-						}
-						else
-						{
-							subString = line.substr(0, 62);
-							if ( subString.at(subString.length() - 1) != ' ' || line.at(62) != ' ' )
-							{
-								// handle word wrapping.
-								std::size_t lastSpace = subString.find_last_of(' ');
-								if ( lastSpace != std::string::npos )
-								{
-									subString = subString.substr(0, lastSpace);
-									line = line.substr(lastSpace, line.length());
-								}
-								else
-								{
-									line = line.substr(62);
-								}
-							}
-							else
-							{
-								line = line.substr(62);
-							}
-						}
-						outputStr.append(subString);
-						outputStr += '\n';
-						outputStr.append("  ");
-						found = line.find('\n');
-						++numlines;
+						savegameCurrentFileIndex = std::get<2>(entry);
+						buttonDeleteSavedSoloGame(nullptr);
+					}
+					else
+					{
+						savegameCurrentFileIndex = std::get<2>(entry);
+						buttonDeleteSavedMultiplayerGame(nullptr);
 					}
+				}
+				ttfPrintTextFormatted(ttf12, text_x + 6, text_y, "%s", "X");
+				if ( mouseInBounds(clientnum, filename_padx, filename_padx + 2 * TTF12_WIDTH + 8, filename_pady, filename_pady + TTF12_HEIGHT * 2 + 4) )
+				{
+					drawDeleteTooltip = true;
+				}
 
-					subString = line;
-					outputStr.append(subString);
+				filename_pady += 3 * filename_rowHeight / 2;
+			}
+		}
+
+		Uint32 saveNumColor = uint32ColorGreen(*mainsurface);
+		if ( numSingleplayerSaves == SAVE_GAMES_MAX )
+		{
+			saveNumColor = uint32ColorOrange(*mainsurface);
+		}
+		ttfPrintTextFormattedColor(ttf12, subx2 - (longestline(language[3067]) * TTF12_WIDTH), suby1 + 44, saveNumColor,
+			language[3067], numSingleplayerSaves, SAVE_GAMES_MAX);
+
+		saveNumColor = uint32ColorGreen(*mainsurface);
+		if ( numMultiplayerSaves == SAVE_GAMES_MAX )
+		{
+			saveNumColor = uint32ColorOrange(*mainsurface);
+		}
+		ttfPrintTextFormattedColor(ttf12, subx2 - (longestline(language[3068]) * TTF12_WIDTH), suby1 + 44 + TTF12_HEIGHT + 4, saveNumColor,
+			language[3068], numMultiplayerSaves, SAVE_GAMES_MAX);
+
+		// draw the tooltip we initialised earlier.
+		if ( drawDeleteTooltip )
+		{
+			tooltip.w = longestline(language[3064]) * TTF12_WIDTH + 16;
+			drawTooltip(&tooltip);
+			ttfPrintTextFormatted(ttf12, tooltip.x + 6, tooltip.y + 6, language[3064]);
+		}
+		else if ( drawScrollTooltip )
+		{
+			tooltip.w = longestline(language[3066]) * TTF12_WIDTH + 16;
+			drawTooltip(&tooltip);
+			ttfPrintTextFormatted(ttf12, tooltip.x + 6, tooltip.y + 6, language[3066]);
+		}
+	}
+	else if ( gamemods_window != 0 )
+	{
+		int filenameMaxLength = 24;
+		int filename_padx = subx1 + 16;
+		int filename_pady = suby1 + 32;
+		int numFileEntries = 10;
+
+		int filename_padx2 = filename_padx + filenameMaxLength * TTF12_WIDTH + 8;
+		int filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 8;
+#ifdef STEAMWORKS
+		if ( gamemods_window == 1 || gamemods_window == 2 || gamemods_window == 5 )
+		{
+			if ( !currentDirectoryFiles.empty() )
+			{
+				int lineNumber = 0;
+				std::string line;
+				std::list<std::string>::const_iterator it = currentDirectoryFiles.begin();
+				std::advance(it, gamemods_window_scroll);
+
+				drawWindow(filename_padx, filename_pady - 2,
+					filename_padx2, filename_pady2);
+
+				SDL_Rect pos;
+				pos.x = filename_padx;
+				pos.y = filename_pady - 2 + std::max(gamemods_window_fileSelect - 1, 0) * TTF12_HEIGHT;
+				pos.w = filenameMaxLength * TTF12_WIDTH + 8;
+				pos.h = TTF12_HEIGHT;
+				if ( gamemods_window_fileSelect != 0 )
+				{
+					drawRect(&pos, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+				}
 
-					tooltip.h = (6 + std::min(maxDescriptionLines, numlines)) * TTF12_HEIGHT + 12;
-					drawTooltip(&tooltip);
+				for ( ; it != currentDirectoryFiles.end() && lineNumber < numFileEntries; ++it )
+				{
+					line = *it;
+					line = line.substr(0, filenameMaxLength);
+					ttfPrintTextFormatted(ttf12, filename_padx, filename_pady + lineNumber * TTF12_HEIGHT, "%s", line.c_str());
+					++lineNumber;
+				}
+				int entriesToScroll = std::max(static_cast<int>((currentDirectoryFiles.size() / numFileEntries) - 1), 0);
+				entriesToScroll = entriesToScroll * numFileEntries + (currentDirectoryFiles.size() % numFileEntries);
 
-					// draw description title.
-					line = itemDetails.m_rgchTitle;
-					found = line.find_first_of('\n');
-					if ( found != std::string::npos && found < 62 )
-					{
-						line = line.substr(0, found);
-						line.append("..");
-					}
-					else if ( line.length() >= 64 )
+				if ( mouseInBounds(clientnum, filename_padx - 4, filename_padx2,
+					filename_pady, filename_pady2) && currentDirectoryFiles.size() > numFileEntries )
+				{
+					if ( mousestatus[SDL_BUTTON_WHEELUP] )
 					{
-						line = line.substr(0, 62);
-						line.append("..");
+						gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
+						mousestatus[SDL_BUTTON_WHEELUP] = 0;
 					}
-					ttfPrintTextFormattedColor(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, uint32ColorBaronyBlue(*mainsurface), "%s", line.c_str());
-					tooltip_pady += TTF12_HEIGHT * 2;
-
-					// draw description body.
-					ttfPrintTextFormatted(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, "  %s", outputStr.c_str());
-
-					tooltip_pady += TTF12_HEIGHT * (numlines + 2);
-					
-					// draw tags.
-					ttfPrintTextFormattedColor(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, uint32ColorBaronyBlue(*mainsurface), "tags:");
-					tooltip_pady += TTF12_HEIGHT;
-					line = itemDetails.m_rgchTags;
-
-					int tooltip_padx = 0;
-					if ( !line.empty() )
+					if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
 					{
-						subString = line;
-						ttfPrintTextFormatted(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, "  %s", subString.c_str());
+						gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
+						mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
 					}
 				}
-			}
-		}
-#endif //STEAMWORKS
-
-		if ( gamemods_window == 6 ) //TODO: NX PORT: Does this need any changes for the switch? Even if only to entirely disable the feature?
-		{
-			// create blank file structure for a mod.
-			filename_padx = subx1 + 16;
-			filename_pady = suby1 + 32;
-			ttfPrintTextFormatted(ttf12, filename_padx, filename_pady, "Enter base folder name for template directory");
-			filename_pady += TTF12_HEIGHT + 8;
-			drawDepressed(filename_padx - 4, filename_pady - 4, filename_padx + 32 * TTF12_WIDTH + 8, filename_pady + TTF12_HEIGHT);
-			ttfPrintTextFormatted(ttf12, filename_padx, filename_pady, "%s", gamemods_newBlankDirectory);
-			if ( !SDL_IsTextInputActive() )
-			{
-				inputstr = gamemods_newBlankDirectory;
-				SDL_StartTextInput();
-			}
-			inputlen = 30;
-			if ( SDL_IsTextInputActive()
-				&& (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
-			{
-				int x;
-				getSizeOfText(ttf12, inputstr, &x, NULL);
-				ttfPrintText(ttf12, filename_padx + x, filename_pady, "_");
-			}
-			filename_pady += TTF12_HEIGHT + 8;
-			if ( strcmp(gamemods_newBlankDirectoryOldName, gamemods_newBlankDirectory) == 0 )
-			{
-				if ( gamemods_newBlankDirectoryStatus == -1 )
+				for ( int i = 1; i <= numFileEntries; ++i )
 				{
-					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorRed(*mainsurface), "Error: could not create directory %s/, already exists in mods/ folder", gamemods_newBlankDirectory);
+					if ( mouseInBounds(clientnum, filename_padx - 4, filename_padx2,
+						filename_pady - 2, filename_pady - 2 + i * TTF12_HEIGHT) )
+					{
+						if ( inputs.bMouseLeft(clientnum) )
+						{
+							gamemods_window_fileSelect = i;
+							inputs.mouseClearLeft(clientnum);
+						}
+					}
 				}
-				else if ( gamemods_newBlankDirectoryStatus == 1 )
+				if ( !directoryToUpload.empty() )
 				{
-					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "Successfully created directory %s/ in mods/ folder", gamemods_newBlankDirectory);
+					ttfPrintTextFormatted(ttf12, filename_padx, filename_pady2 + TTF12_HEIGHT, "folder to upload: %s", directoryToUpload.c_str());
 				}
 			}
 		}
-		if ( gamemods_window == 7 )
+		if ( gamemods_window == 2 || gamemods_window == 5 )
 		{
-			numFileEntries = 8;
-			filenameMaxLength = 48;
-			filename_padx = subx1 + 16;
-			filename_pady = suby1 + 32;
-			filename_padx2 = subx2 - 16 - 40;
-			filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 8;
-			int filename_rowHeight = 2 * TTF12_HEIGHT + 8;
-			filename_pady += 3 * TTF12_HEIGHT;
-			int numLocalFolders = std::max(static_cast<int>(gamemods_localModFoldernames.size() - 2), 0);
-			if ( numLocalFolders > 0 )
-			{
-				ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "successfully retrieved local items!");
-			}
-			else
+			numFileEntries = 20;
+			filename_padx = subx2 - (filenameMaxLength * TTF12_WIDTH + 16);
+			filename_padx2 = subx2 - 16;
+			filename_pady = filename_pady2 + 2 * TTF12_HEIGHT;
+			filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 2;
+			if ( !directoryFilesListToUpload.empty() )
 			{
-				ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorOrange(*mainsurface), "no folders found!");
-				ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady + TTF12_HEIGHT + 8, uint32ColorOrange(*mainsurface), "to get started create a new folder, or copy shared custom content to the mods/ folder");
+				ttfPrintTextFormatted(ttf12, filename_padx, filename_pady - TTF12_HEIGHT, "file preview in folder:");
+				drawWindow(filename_padx, filename_pady - 2,
+					filename_padx2, filename_pady2);
+				int lineNumber = 0;
+				std::string line;
+				for ( std::list<std::string>::const_iterator it = directoryFilesListToUpload.begin(); it != directoryFilesListToUpload.end() && lineNumber < 20; ++it )
+				{
+					line = *it;
+					if ( line.size() >= filenameMaxLength )
+					{
+						line = line.substr(0, filenameMaxLength - 3);
+						line.append("..");
+					}
+					else
+					{
+						line = line.substr(0, filenameMaxLength);
+					}
+					ttfPrintTextFormatted(ttf12, filename_padx, filename_pady + lineNumber * TTF12_HEIGHT, "%s", line.c_str());
+					++lineNumber;
+				}
 			}
 
-			std::string modInfoStr = "current loaded mods (hover for info): ";
-			SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
-			bool drawModLoadOrder = false;
-			int drawExtendedInformationForMod = -1; // value of 0 or greater will draw.
-			int maxDescriptionLines = 10;
-
-			tooltip.x = omousex - 256;
-			tooltip.y = omousey + 16;
-			tooltip.w = 32 + TTF12_WIDTH * 64;
-			tooltip.h = (gamemods_mountedFilepaths.size() + 1) * TTF12_HEIGHT + 8;
-
-			if ( gamemods_mountedFilepaths.size() > 0 )
+			int status_padx = subx1 + 16;
+			int status_pady = filename_pady;
+			if ( gamemods_uploadStatus != 0 && g_SteamWorkshop )
 			{
-				ttfPrintTextFormatted(ttf12, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_pady, "%s %2d", modInfoStr.c_str(), gamemods_mountedFilepaths.size());
-				if ( mouseInBounds(clientnum, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_padx2, filename_pady, filename_pady + TTF12_HEIGHT) )
-				{
-					drawModLoadOrder = true;
-				}
-				else
+				status_pady += 3 * TTF12_HEIGHT;
+				if ( gamemods_window == 2 )
 				{
-					drawModLoadOrder = false;
-				}
-			}
+					if ( g_SteamWorkshop->SubmitItemUpdateResult.m_eResult == 0
+						&& gamemods_uploadStatus < 5 )
+					{
+						switch ( g_SteamWorkshop->createItemResult.m_eResult )
+						{
+							case 0:
+								ttfPrintTextFormatted(ttf12, status_padx, status_pady, "creating item...");
+								break;
+							case k_EResultOK:
+								if ( gamemods_uploadStatus < 2 )
+								{
+									for ( node = button_l.first; node != NULL; node = nextnode )
+									{
+										nextnode = node->next;
+										button = (button_t*)node->element;
+										if ( button->action == &buttonGamemodsPrepareWorkshopItemUpload )
+										{
+											button->visible = false;
+										}
+									}
+									gamemods_uploadStatus = 2;
+									g_SteamWorkshop->StartItemUpdate();
+								}
+								else
+								{
+									if ( g_SteamWorkshop->UGCUpdateHandle == 0 )
+									{
+										ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "item created! awaiting file handle...");
+									}
+									else
+									{
+										if ( gamemods_uploadStatus == 2 )
+										{
+											gamemods_uploadStatus = 3;
+											// set item fields button
+											button = newButton();
+											strcpy(button->label, "set item fields");
+											button->x = subx1 + 16;
+											button->y = suby1 + TTF12_HEIGHT * 34;
+											button->sizex = 16 * TTF12_WIDTH + 8;
+											button->sizey = 32;
+											button->action = &buttonGamemodsSetWorkshopItemFields;
+											button->visible = 1;
+											button->focused = 1;
+											gamemods_currentEditField = 0;
+										}
+										ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), "item and file handle create success!");
+									}
+								}
+								break;
+							default:
+								// error in createItem!
+								ttfPrintTextFormatted(ttf12, status_padx, status_pady, "error in creating item!");
+								break;
+						}
+						status_pady += 2 * TTF12_HEIGHT;
+						if ( gamemods_uploadStatus >= 3 && g_SteamWorkshop->SubmitItemUpdateResult.m_eResult == 0 )
+						{
+							for ( int fields = 0; fields < 2; ++fields )
+							{
+								status_pady += TTF12_HEIGHT;
+								drawDepressed(status_padx, status_pady - 4, status_padx + 32 * TTF12_WIDTH, status_pady + TTF12_HEIGHT);
+								switch ( fields )
+								{
+									case 0:
+										ttfPrintText(ttf12, status_padx + 8, status_pady - TTF12_HEIGHT, "Enter a title:");
+										if ( gamemods_uploadStatus == 3 && gamemods_workshopSetPropertyReturn[0] )
+										{
+											ttfPrintTextColor(ttf12, status_padx + 20 * TTF12_WIDTH, status_pady - TTF12_HEIGHT, uint32ColorGreen(*mainsurface), true, "success set");
+										}
+										ttfPrintText(ttf12, status_padx + 8, status_pady, gamemods_uploadTitle);
+										break;
+									case 1:
+										ttfPrintText(ttf12, status_padx + 8, status_pady - TTF12_HEIGHT, "Enter description:");
+										if ( gamemods_uploadStatus == 3 && gamemods_workshopSetPropertyReturn[1] )
+										{
 
-			filename_pady += 2 * TTF12_HEIGHT;
+										}
+										ttfPrintText(ttf12, status_padx + 8, status_pady, gamemods_uploadDescription);
+										break;
+									default:
+										break;
+								}
+								if ( gamemods_uploadStatus == 4 )
+								{
+									if ( gamemods_workshopSetPropertyReturn[fields] )
+									{
+										ttfPrintTextColor(ttf12, status_padx + 20 * TTF12_WIDTH, status_pady - TTF12_HEIGHT, uint32ColorGreen(*mainsurface), true, "success set");
+									}
+									else
+									{
+										ttfPrintTextColor(ttf12, status_padx + 20 * TTF12_WIDTH, status_pady - TTF12_HEIGHT, uint32ColorRed(*mainsurface), true, "error!");
+									}
+								}
 
-			// do slider
-			SDL_Rect slider;
-			slider.x = filename_padx2 + 8;
-			slider.y = filename_pady - 8;
-			slider.h = suby2 - (filename_pady + 20);
-			slider.w = 32;
+								if ( mouseInBounds(clientnum, status_padx, status_padx + 32 * TTF12_WIDTH, status_pady - 4, status_pady + TTF12_HEIGHT) )
+								{
+									if ( inputs.bMouseLeft(clientnum) )
+									{
+										switch ( fields )
+										{
+											case 0:
+												inputstr = gamemods_uploadTitle;
+												gamemods_currentEditField = 0;
+												break;
+											case 1:
+												inputstr = gamemods_uploadDescription;
+												gamemods_currentEditField = 1;
+												break;
+											default:
+												break;
+										}
+										inputs.mouseClearLeft(clientnum);
+									}
+								}
 
-			int entriesToScroll = std::max(static_cast<int>((numLocalFolders / numFileEntries) - 1), 0);
-			entriesToScroll = entriesToScroll * numFileEntries + (numLocalFolders % numFileEntries);
+								if ( gamemods_uploadStatus == 3 && !SDL_IsTextInputActive() )
+								{
+									inputstr = gamemods_uploadTitle;
+									SDL_StartTextInput();
+								}
+								inputlen = 30;
+								if ( SDL_IsTextInputActive() && gamemods_currentEditField == fields
+									&& (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
+								{
+									int x;
+									getSizeOfText(ttf12, inputstr, &x, NULL);
+									ttfPrintText(ttf12, status_padx + x + 8, status_pady, "_");
+								}
+								status_pady += 2 * TTF12_HEIGHT;
+							}
+							if ( gamemods_uploadStatus >= 4 )
+							{
+								if ( gamemods_workshopSetPropertyReturn[2] )
+								{
+									ttfPrintTextColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), true, "folder path success set");
+								}
+								else
+								{
+									ttfPrintTextColor(ttf12, status_padx, status_pady, uint32ColorRed(*mainsurface), true, "error in folder path!");
+								}
+							}
 
-			// handle slider movement.
-			if ( numLocalFolders > numFileEntries )
-			{
-				drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-				if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
-					slider.y, slider.y + slider.h) )
+							status_pady += 2 * TTF12_HEIGHT;
+							// set some workshop item tags
+							ttfPrintText(ttf12, status_padx, status_pady, "Select workshop tags");
+							int tag_padx = status_padx;
+							int tag_pady = status_pady + TTF12_HEIGHT;
+							int tag_padx1 = tag_padx + 20 * TTF12_WIDTH;
+							gamemodsDrawWorkshopItemTagToggle("dungeons", tag_padx, tag_pady);
+							gamemodsDrawWorkshopItemTagToggle("textures", tag_padx1, tag_pady);
+							tag_pady += TTF12_HEIGHT + 4;
+							gamemodsDrawWorkshopItemTagToggle("models", tag_padx, tag_pady);
+							gamemodsDrawWorkshopItemTagToggle("gameplay", tag_padx1, tag_pady);
+							tag_pady += TTF12_HEIGHT + 4;
+							gamemodsDrawWorkshopItemTagToggle("audio", tag_padx, tag_pady);
+							gamemodsDrawWorkshopItemTagToggle("translations", tag_padx1, tag_pady);
+							tag_pady += TTF12_HEIGHT + 4;
+							gamemodsDrawWorkshopItemTagToggle("misc", tag_padx, tag_pady);
+						}
+					}
+				}
+				else if ( gamemods_window == 5 && g_SteamWorkshop->m_myWorkshopItemToModify.m_nPublishedFileId != 0 && gamemods_uploadStatus < 5 )
 				{
-					if ( mousestatus[SDL_BUTTON_WHEELUP] )
+					std::string line = g_SteamWorkshop->m_myWorkshopItemToModify.m_rgchTitle;
+					if ( line.size() > filenameMaxLength )
 					{
-						gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
-						mousestatus[SDL_BUTTON_WHEELUP] = 0;
+						line = line.substr(0, filenameMaxLength - 2);
+						line.append("..");
 					}
-					if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+					status_pady += 2 * TTF12_HEIGHT;
+					ttfPrintTextFormattedColor(ttf12, status_padx + 8, status_pady, uint32ColorBaronyBlue(*mainsurface), "Title:");
+					status_pady += TTF12_HEIGHT;
+					ttfPrintTextFormatted(ttf12, status_padx + 8, status_pady, "%s", line.c_str());
+
+					line = g_SteamWorkshop->m_myWorkshopItemToModify.m_rgchDescription;
+					if ( line.size() > filenameMaxLength )
 					{
-						gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
-						mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+						line = line.substr(0, filenameMaxLength - 2);
+						line.append("..");
 					}
-				}
-
-				if ( keystatus[SDL_SCANCODE_UP] )
-				{
-					gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
-					keystatus[SDL_SCANCODE_UP] = 0;
-				}
-				if ( keystatus[SDL_SCANCODE_DOWN] )
-				{
-					gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
-					keystatus[SDL_SCANCODE_DOWN] = 0;
-				}
-				slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
-				slider.y += slider.h * gamemods_window_scroll;
-				if ( gamemods_window_scroll == entriesToScroll ) // reached end.
-				{
-					slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
-				}
-				drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
-			}
-
-			// draw the content
-			for ( int i = gamemods_window_scroll; i < numLocalFolders && i < numFileEntries + gamemods_window_scroll; ++i )
-			{
-				filename_padx = subx1 + 16;
-
-				std::list<std::string>::iterator it = gamemods_localModFoldernames.begin();
-				std::advance(it, 2); // skip the "." and ".." directories.
-				std::advance(it, i);
-				std::string folderName = *it;
-
-				drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
-				SDL_Rect highlightEntry;
-				highlightEntry.x = filename_padx;
-				highlightEntry.y = filename_pady - 8;
-				highlightEntry.w = filename_padx2 - filename_padx;
-				highlightEntry.h = filename_rowHeight + 8;
-				drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
-
-				std::string path = outputdir;
-				path.append(PHYSFS_getDirSeparator()).append("mods").append(PHYSFS_getDirSeparator()).append(folderName);
-				bool pathIsMounted = gamemodsIsPathInMountedFiles(path);
-
-				if ( pathIsMounted )
-				{
-					SDL_Rect pos;
-					pos.x = filename_padx + 2;
-					pos.y = filename_pady - 6;
-					pos.w = filename_padx2 - filename_padx - 4;
-					pos.h = filename_rowHeight + 4;
-					drawRect(&pos, uint32ColorGreen(*mainsurface), 64);
-				}
+					status_pady += TTF12_HEIGHT;
+					ttfPrintTextFormattedColor(ttf12, status_padx + 8, status_pady, uint32ColorBaronyBlue(*mainsurface), "Description:");
+					status_pady += TTF12_HEIGHT;
+					ttfPrintTextFormatted(ttf12, status_padx + 8, status_pady, "%s", line.c_str());
 
-				if ( folderName.length() >= filenameMaxLength )
-				{
-					folderName = folderName.substr(0, 46);
-					folderName.append("..");
-				}
-				ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady + TTF12_HEIGHT / 2, "Folder Name: %s", folderName.c_str());
+					status_pady += 2 * TTF12_HEIGHT;
+					// set some workshop item tags
+					ttfPrintText(ttf12, status_padx, status_pady, "Modify workshop tags");
+					int tag_padx = status_padx;
+					int tag_pady = status_pady + TTF12_HEIGHT;
+					int tag_padx1 = tag_padx + 20 * TTF12_WIDTH;
+					gamemodsDrawWorkshopItemTagToggle("dungeons", tag_padx, tag_pady);
+					gamemodsDrawWorkshopItemTagToggle("textures", tag_padx1, tag_pady);
+					tag_pady += TTF12_HEIGHT + 4;
+					gamemodsDrawWorkshopItemTagToggle("models", tag_padx, tag_pady);
+					gamemodsDrawWorkshopItemTagToggle("gameplay", tag_padx1, tag_pady);
+					tag_pady += TTF12_HEIGHT + 4;
+					gamemodsDrawWorkshopItemTagToggle("audio", tag_padx, tag_pady);
+					gamemodsDrawWorkshopItemTagToggle("translations", tag_padx1, tag_pady);
+					tag_pady += TTF12_HEIGHT + 4;
+					gamemodsDrawWorkshopItemTagToggle("misc", tag_padx, tag_pady);
 
-				filename_padx = filename_padx2 - (12 * TTF12_WIDTH + 16);
-				// mount button
-				if ( !pathIsMounted )
-				{
-					if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, " Load Item ", 0) )
+					status_pady += 6 * TTF12_HEIGHT;
+					if ( directoryFilesListToUpload.empty() )
 					{
-						if ( PHYSFS_mount(path.c_str(), NULL, 0) )
-						{
-							gamemods_mountedFilepaths.push_back(std::make_pair(path, folderName));
-							printlog("[PhysFS]: [%s] is in the search path.\n", path.c_str());
-							gamemods_modelsListRequiresReload = true;
-							gamemods_soundListRequiresReload = true;
-						}
+						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), "Only Workshop tags will be updated.");
+					}
+					else
+					{
+						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "Workshop file contents will be updated.");
 					}
 				}
-				filename_pady += filename_rowHeight / 2;
-				// unmount button
-				if ( pathIsMounted )
+				status_pady += 5 * TTF12_HEIGHT;
+				if ( gamemods_uploadStatus >= 5 )
 				{
-					if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, "Unload Item", 0) )
+					uint64 bytesProc;
+					uint64 bytesTotal;
+					int status = SteamUGC()->GetItemUpdateProgress(g_SteamWorkshop->UGCUpdateHandle, &bytesProc, &bytesTotal);
+					if ( g_SteamWorkshop->SubmitItemUpdateResult.m_eResult != 0 )
 					{
-						if ( PHYSFS_unmount(path.c_str()) )
+						for ( node = button_l.first; node != NULL; node = nextnode )
 						{
-							if ( gamemodsRemovePathFromMountedFiles(path) )
+							nextnode = node->next;
+							button = (button_t*)node->element;
+							if ( button->action == &buttonGamemodsPrepareWorkshopItemUpload
+								|| button->action == &buttonGamemodsStartUploadItem
+								|| button->action == &buttonGamemodsSetWorkshopItemFields
+								|| button->action == &buttonGamemodsSelectDirectoryForUpload
+								|| button->action == &buttonGamemodsModifyExistingWorkshopItemFields
+								|| button->action == &buttonGamemodsCancelModifyFileContents )
 							{
-								printlog("[PhysFS]: [%s] is removed from the search path.\n", path.c_str());
-								gamemods_modelsListRequiresReload = true;
-								gamemods_soundListRequiresReload = true;
+								button->visible = false;
 							}
 						}
-					}
-				}
-				filename_pady += filename_rowHeight;
-			}
-
-			// draw the tooltip we initialised earlier.
-			if ( drawModLoadOrder )
-			{
-				drawTooltip(&tooltip);
-				int numLoadedModLine = 1;
-				ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 4, uint32ColorBaronyBlue(*mainsurface),
-					"Current load list: (first is lowest priority)");
-				for ( std::vector<std::pair<std::string, std::string>>::iterator it = gamemods_mountedFilepaths.begin(); it != gamemods_mountedFilepaths.end(); ++it )
-				{
-					std::pair<std::string, std::string> line = *it;
-					modInfoStr = line.second;
-					if ( modInfoStr.length() > 64 )
+						if ( g_SteamWorkshop->SubmitItemUpdateResult.m_eResult == k_EResultOK )
+						{
+							if ( g_SteamWorkshop->uploadSuccessTicks == 0 )
+							{
+								g_SteamWorkshop->uploadSuccessTicks = ticks;
+							}
+							else
+							{
+								if ( ticks - g_SteamWorkshop->uploadSuccessTicks > TICKS_PER_SECOND * 5 )
+								{
+									//cleanup the interface.
+									buttonCloseSubwindow(NULL);
+									list_FreeAll(&button_l);
+									deleteallbuttons = true;
+									gamemodsSubscribedItemsInit();
+								}
+							}
+							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorGreen(*mainsurface), "successfully uploaded!");
+							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady + TTF12_HEIGHT, uint32ColorGreen(*mainsurface), "reloading window in %d...!", 5 - ((ticks - g_SteamWorkshop->uploadSuccessTicks) / TICKS_PER_SECOND));
+						}
+						else
+						{
+							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "error! %d", g_SteamWorkshop->SubmitItemUpdateResult.m_eResult);
+							ttfPrintTextFormattedColor(ttf12, status_padx, status_pady + TTF12_HEIGHT, uint32ColorOrange(*mainsurface), "close the window and try again.");
+						}
+					}
+					else
 					{
-						modInfoStr = modInfoStr.substr(0, 64 - 2).append("..");
+						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady, uint32ColorOrange(*mainsurface), "uploading... status %d", status);
+						ttfPrintTextFormattedColor(ttf12, status_padx, status_pady + TTF12_HEIGHT, uint32ColorOrange(*mainsurface), "bytes processed: %d", bytesProc);
 					}
-					ttfPrintTextFormatted(ttf12, tooltip.x + 4, tooltip.y + 4 + numLoadedModLine * TTF12_HEIGHT, "%2d) %s", numLoadedModLine, modInfoStr.c_str());
-					++numLoadedModLine;
 				}
 			}
 		}
-	}
-	else if ( gameModeManager.Tutorial.Menu.isOpen() )
-	{
-		int numFileEntries = 11;
-
-		int filenameMaxLength = 48;
-		int filename_padx = subx1 + 16;
-		int filename_pady = suby1 + 32;
-		int filename_padx2 = subx2 - 16;
-		int filename_rowHeight = 1.25 * TTF12_HEIGHT + 8;
-
-		auto& menu = gameModeManager.Tutorial.Menu;
-		ttfPrintTextFormattedColor(ttf12, filename_padx + 8, filename_pady + 8, uint32ColorWhite(*mainsurface), "%s", menu.windowTitle.c_str());
-
-		filename_pady += 4 * TTF12_HEIGHT;
+		if ( gamemods_window == 3 || gamemods_window == 4 )
+		{
+			numFileEntries = 8;
+			filenameMaxLength = 48;
+			filename_padx = subx1 + 16;
+			filename_pady = suby1 + 32;
+			filename_padx2 = subx2 - 16 - 40;
+			filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 8;
+			int filename_rowHeight = 2 * TTF12_HEIGHT + 8;
 
-		// do slider
-		SDL_Rect slider;
-		slider.x = filename_padx2 + 8;
-		slider.y = filename_pady - 8;
-		slider.h = suby2 - (filename_pady + 20);
-		slider.w = 32;
 
-		int entriesToScroll = static_cast<Uint32>(std::max(((static_cast<int>(gameModeManager.Tutorial.levels.size()) / numFileEntries) - 1), 0));
-		entriesToScroll = entriesToScroll * numFileEntries + (gameModeManager.Tutorial.levels.size() % numFileEntries);
+			if ( gamemods_subscribedItemsStatus == 0 )
+			{
+				if ( g_SteamWorkshop->SteamUGCQueryCompleted.m_eResult == k_EResultOK )
+				{
+					gamemods_subscribedItemsStatus = 1;
+				}
+			}
+			else
+			{
+				filename_pady += 1 * TTF12_HEIGHT;
 
-		menu.selectedMenuItem = -1;
 
-		// handle slider movement.
-		if ( gameModeManager.Tutorial.levels.size() > numFileEntries )
-		{
-			drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
-			if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
-				slider.y, slider.y + slider.h) )
-			{
-				if ( mousestatus[SDL_BUTTON_WHEELUP] )
+				filename_pady += 2 * TTF12_HEIGHT;
+				if ( gamemods_window == 3 )
 				{
-					menu.windowScroll = std::max(menu.windowScroll - 1, 0);
-					mousestatus[SDL_BUTTON_WHEELUP] = 0;
+					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "successfully retrieved subscribed items!");
 				}
-				if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+				else
 				{
-					menu.windowScroll = std::min(menu.windowScroll + 1, entriesToScroll);
-					mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "successfully retrieved my workshop items!");
 				}
-			}
-
-			if ( keystatus[SDL_SCANCODE_UP] )
-			{
-				menu.windowScroll = std::max(menu.windowScroll - 1, 0);
-				keystatus[SDL_SCANCODE_UP] = 0;
-			}
-			if ( keystatus[SDL_SCANCODE_DOWN] )
-			{
-				menu.windowScroll = std::min(menu.windowScroll + 1, entriesToScroll);
-				keystatus[SDL_SCANCODE_DOWN] = 0;
-			}
-			slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
-			slider.y += slider.h * menu.windowScroll;
-			if ( menu.windowScroll == entriesToScroll ) // reached end.
-			{
-				slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
-			}
-			drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
-		}
 
-		// draw the content
-		for ( int i = menu.windowScroll; i < gameModeManager.Tutorial.levels.size() && i < numFileEntries + menu.windowScroll; ++i )
-		{
-			filename_padx = subx1 + 16;
+				std::string modInfoStr = "current loaded mods (hover for info): ";
+				SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
+				bool drawModLoadOrder = false;
+				int drawExtendedInformationForMod = -1; // value of 0 or greater will draw.
+				int maxDescriptionLines = 10;
 
-			auto it = gameModeManager.Tutorial.levels.begin();
-			std::advance(it, i);
-			std::string folderName = (*it).title;
+				tooltip.x = omousex - 256;
+				tooltip.y = omousey + 16;
+				tooltip.w = 32 + TTF12_WIDTH * 64;
+				tooltip.h = (gamemods_mountedFilepaths.size() + 1) * TTF12_HEIGHT + 8;
 
-			drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
+				if ( gamemods_mountedFilepaths.size() > 0 && gamemods_window == 3 )
+				{
+					ttfPrintTextFormatted(ttf12, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_pady, "%s %2d", modInfoStr.c_str(), gamemods_mountedFilepaths.size());
+					if ( mouseInBounds(clientnum, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_padx2, filename_pady, filename_pady + TTF12_HEIGHT) )
+					{
+						drawModLoadOrder = true;
+					}
+					else
+					{
+						drawModLoadOrder = false;
+					}
+				}
 
-			SDL_Rect highlightEntry;
-			highlightEntry.x = filename_padx;
-			highlightEntry.y = filename_pady - 8;
-			highlightEntry.w = filename_padx2 - filename_padx;
-			highlightEntry.h = filename_rowHeight + 8;
-			drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
+				filename_pady += 2 * TTF12_HEIGHT;
 
-			if ( mouseInBounds(clientnum, highlightEntry.x, highlightEntry.x + highlightEntry.w, highlightEntry.y - 2, highlightEntry.y + highlightEntry.h + 4) )
-			{
-				menu.selectedMenuItem = i;
-			}
+				// do slider
+				SDL_Rect slider;
+				slider.x = filename_padx2 + 8;
+				slider.y = filename_pady - 8;
+				slider.h = suby2 - (filename_pady + 20);
+				slider.w = 32;
 
-			if ( menu.selectedMenuItem == i )
-			{
-				SDL_Rect pos;
-				pos.x = filename_padx + 2;
-				pos.y = filename_pady - 6;
-				pos.w = filename_padx2 - filename_padx - 4;
-				pos.h = filename_rowHeight + 4;
-				drawRect(&pos, uint32ColorBaronyBlue(*mainsurface), 64);
-				ttfPrintTextFormattedColor(ttf12, filename_padx + 8, suby2 - 3 * TTF12_HEIGHT, uint32ColorYellow(*mainsurface), "%s", (*it).description.c_str());
-			}
+				int numSubscribedItemsReturned = g_SteamWorkshop->SteamUGCQueryCompleted.m_unNumResultsReturned;
+				int entriesToScroll = std::max(static_cast<int>((numSubscribedItemsReturned / numFileEntries) - 1), 0);
+				entriesToScroll = entriesToScroll * numFileEntries + (numSubscribedItemsReturned % numFileEntries);
 
-			SDL_Rect btn;
-			btn.w = 6 * TTF12_WIDTH + 8;
-			btn.h = highlightEntry.h - 12;
-			btn.x = highlightEntry.x + highlightEntry.w - btn.w - 4;
-			btn.y = highlightEntry.y + 8;
-			if ( i == 0 )
-			{
-				btn.w = 11 * TTF12_WIDTH + 8;
-				btn.x = highlightEntry.x + highlightEntry.w - btn.w - 4;
-				if ( drawClickableButton(btn.x, btn.y, btn.w, btn.h, 0) )
+				// handle slider movement.
+				if ( numSubscribedItemsReturned > numFileEntries )
 				{
-					menu.onClickEntry();
+					drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+					if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
+						slider.y, slider.y + slider.h) )
+					{
+						if ( mousestatus[SDL_BUTTON_WHEELUP] )
+						{
+							gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
+							mousestatus[SDL_BUTTON_WHEELUP] = 0;
+						}
+						if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+						{
+							gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
+							mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
+						}
+					}
+				
+					if ( keystatus[SDL_SCANCODE_UP] )
+					{
+						gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
+						keystatus[SDL_SCANCODE_UP] = 0;
+					}
+					if ( keystatus[SDL_SCANCODE_DOWN] )
+					{
+						gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
+						keystatus[SDL_SCANCODE_DOWN] = 0;
+					}
+					slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
+					slider.y += slider.h * gamemods_window_scroll;
+					if ( gamemods_window_scroll == entriesToScroll ) // reached end.
+					{
+						slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
+					}
+					drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
 				}
-				ttfPrintTextFormatted(ttf12, btn.x + 11, filename_pady + 4, "%s", "Enter Hub");
-			}
-			else
-			{
-				if ( drawClickableButton(btn.x, btn.y, btn.w, btn.h, 0) )
+
+				// draw last message results
+				if ( ticks - g_SteamWorkshop->LastActionResult.creationTick < TICKS_PER_SECOND * 5 )
 				{
-					menu.onClickEntry();
+					ttfPrintTextFormattedColor(ttf12, filename_padx + 8, suby2 - TTF12_HEIGHT - 4, uint32ColorOrange(*mainsurface), "%s returned status %d", 
+						g_SteamWorkshop->LastActionResult.actionMsg.c_str(), static_cast<int>(g_SteamWorkshop->LastActionResult.lastResult));
 				}
-				ttfPrintTextFormatted(ttf12, btn.x + 7, filename_pady + 4, "%s", "Begin");
-			}
 
-			ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady + 4, "%s", (*it).title.c_str());
+				// draw the content
+				for ( int i = gamemods_window_scroll; i < numSubscribedItemsReturned && i < numFileEntries + gamemods_window_scroll; ++i )
+				{
+					filename_padx = subx1 + 16;
+					SteamUGCDetails_t itemDetails = g_SteamWorkshop->m_subscribedItemListDetails[i];
+					char fullpath[PATH_MAX];
+					if ( itemDetails.m_eResult == k_EResultOK )
+					{
+						drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
+						SDL_Rect highlightEntry;
+						highlightEntry.x = filename_padx;
+						highlightEntry.y = filename_pady - 8;
+						highlightEntry.w = filename_padx2 - filename_padx;
+						highlightEntry.h = filename_rowHeight + 8;
+						drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
+
+						bool itemDownloaded = SteamUGC()->GetItemInstallInfo(itemDetails.m_nPublishedFileId, NULL, fullpath, PATH_MAX, NULL);
+						bool pathIsMounted = gamemodsIsPathInMountedFiles(fullpath);
+
+						if ( pathIsMounted && gamemods_window == 3 )
+						{
+							SDL_Rect pos;
+							pos.x = filename_padx + 2;
+							pos.y = filename_pady - 6;
+							pos.w = filename_padx2 - filename_padx - 4;
+							pos.h = filename_rowHeight + 4;
+							drawRect(&pos, uint32ColorGreen(*mainsurface), 64);
+						}
+
+						// draw preview title
+						std::string line = itemDetails.m_rgchTitle;
+						std::size_t found = line.find_first_of('\n');
+						if ( found != std::string::npos && found < filenameMaxLength - 2 )
+						{
+							line = line.substr(0, found); // don't print out newlines.
+							line.append("..");
+						}
+						else if ( line.length() >= filenameMaxLength )
+						{
+							line = line.substr(0, filenameMaxLength - 2);
+							line.append("..");
+						}
+						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady, "Title: %s", line.c_str());
 
-			if ( i != 0 )
-			{
-				const Uint32 sec = ((*it).completionTime / TICKS_PER_SECOND) % 60;
-				const Uint32 min = (((*it).completionTime / TICKS_PER_SECOND) / 60) % 60;
-				const Uint32 hour = (((*it).completionTime / TICKS_PER_SECOND) / 60) / 60;
-				const Uint32 timeTextWidth = 28 * TTF12_WIDTH + 8;
-				if ( (*it).completionTime > 0 )
-				{
-					ttfPrintTextFormatted(ttf12, btn.x - timeTextWidth, filename_pady + 4, "Best time: %02d:%02d:%02d", hour, min, sec);
-				}
-				else
-				{
-					ttfPrintTextFormatted(ttf12, btn.x - timeTextWidth, filename_pady + 4, "Not completed");
-				}
-			}
+						// draw preview description
+						line = itemDetails.m_rgchDescription;
+						found = line.find_first_of('\n');
+						if ( found != std::string::npos && found < filenameMaxLength - 2 )
+						{
+							line = line.substr(0, found);
+							line.append("..");
+						}
+						else if ( line.length() >= filenameMaxLength )
+						{
+							line = line.substr(0, filenameMaxLength - 2);
+							line.append("..");
+						}
+						ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady + TTF12_HEIGHT, "Desc: %s", line.c_str());
 
-			filename_padx = filename_padx2 - (12 * TTF12_WIDTH + 16);
-			filename_pady += 1.5 * filename_rowHeight;
-		}
+						// if hovering over title or description, provide more info...
+						if ( mouseInBounds(clientnum, filename_padx + 8, filename_padx + 8 + 52 * TTF12_WIDTH, filename_pady + TTF12_HEIGHT, filename_pady + 2 * TTF12_HEIGHT) )
+						{
+							drawExtendedInformationForMod = i;
+						}
 
-		if ( menu.selectedMenuItem == -1 )
-		{
-			ttfPrintTextFormattedColor(ttf12, subx1 + 16 + 8, suby2 - 3 * TTF12_HEIGHT, uint32ColorYellow(*mainsurface), "%s", menu.defaultHoverText.c_str());
-		}
-	}
-	else if ( gameModeManager.Tutorial.FirstTimePrompt.isOpen() )
-	{
-		gameModeManager.Tutorial.FirstTimePrompt.drawDialogue();
-		if ( gameModeManager.Tutorial.FirstTimePrompt.doButtonSkipPrompt )
-		{
-			gameModeManager.Tutorial.FirstTimePrompt.doButtonSkipPrompt = false;
-			if ( anySaveFileExists() )
-			{
-				openNewLoadGameWindow(nullptr);
-			}
-			else
-			{
-				buttonOpenCharacterCreationWindow(NULL);
-			}
-		}
-	}
+						filename_padx = filename_padx2 - (12 * TTF12_WIDTH + 16) * 2;
+						// download button
+						if ( gamemods_window == 3 )
+						{
+							if ( !itemDownloaded )
+							{
+								if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, uint32ColorBaronyBlue(*mainsurface), " Download ", 0) )
+								{
+									SteamUGC()->DownloadItem(itemDetails.m_nPublishedFileId, true);
+								}
+							}
+							filename_padx += (12 * TTF12_WIDTH + 16);
+							// mount button
+							if ( itemDownloaded && !pathIsMounted )
+							{
+								if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, " Load Item ", 0) )
+								{
+									if ( PHYSFS_mount(fullpath, NULL, 0) )
+									{
+										gamemods_mountedFilepaths.push_back(std::make_pair(fullpath, itemDetails.m_rgchTitle));
+										gamemods_workshopLoadedFileIDMap.push_back(std::make_pair(itemDetails.m_rgchTitle, itemDetails.m_nPublishedFileId));
+										gamemods_modelsListRequiresReload = true;
+										gamemods_soundListRequiresReload = true;
+									}
+								}
+							}
+							filename_padx -= (12 * TTF12_WIDTH + 16);
+						}
+						if ( gamemods_window == 4 )
+						{
+							filename_padx += (12 * TTF12_WIDTH + 16);
+							// edit content button
+							if ( gamemodsDrawClickableButton(filename_padx, filename_pady + filename_rowHeight / 4, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, uint32ColorBaronyBlue(*mainsurface), "  Update  ", 0) )
+							{
+								buttonGamemodsOpenModifyExistingWindow(nullptr);
+								gamemods_window = 5;
+								gamemods_uploadStatus = 1;
+								g_SteamWorkshop->m_myWorkshopItemToModify = itemDetails;
 
-	// handle fade actions
-	if ( fadefinished )
-	{
-		if ( introstage == 2 )   // quit game
-		{
-			introstage = 0;
-			mainloop = 0;
-		}
-		else if ( introstage == 3 )     // new game
-		{
-			bool bWasOnMainMenu = intro;
-			introstage = 1;
-			fadefinished = false;
-			fadeout = false;
-			gamePaused = false;
-			multiplayerselect = SINGLE;
-			intro = true; //Fix items auto-adding to the hotbar on game restart.
+								// grab the current item tags and store them for modification.
+								std::string workshopItemTagString = g_SteamWorkshop->m_myWorkshopItemToModify.m_rgchTags;
+								std::size_t found = workshopItemTagString.find(",");
+								g_SteamWorkshop->workshopItemTags.clear();
+								while ( found != std::string::npos )
+								{
+									std::string line = workshopItemTagString.substr(0, found);
+									workshopItemTagString = workshopItemTagString.substr(found + 1); // skip the "," character.
+									g_SteamWorkshop->workshopItemTags.push_back(line); // store the comma separated value.
+									found = workshopItemTagString.find(",");
+								}
+								// add the final string.
+								g_SteamWorkshop->workshopItemTags.push_back(workshopItemTagString); 
+							}
+						}
+						filename_pady += filename_rowHeight / 2;
+						if ( gamemods_window == 3 )
+						{
+							// unsubscribe button
+							if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, uint32ColorRed(*mainsurface), "Unsubscribe", 0) )
+							{
+								if ( pathIsMounted )
+								{
+									if ( PHYSFS_unmount(fullpath) )
+									{
+										if ( gamemodsRemovePathFromMountedFiles(fullpath) )
+										{
+											printlog("[%s] is removed from the search path.\n", fullpath);
+											gamemods_modelsListRequiresReload = true;
+											gamemods_soundListRequiresReload = true;
+										}
+									}
+								}
+								g_SteamWorkshop->UnsubscribeItemFileID(itemDetails.m_nPublishedFileId);
+								gamemods_window_scroll = 0;
+							}
+							filename_padx += (12 * TTF12_WIDTH + 16);
+							// unmount button
+							if ( itemDownloaded && pathIsMounted )
+							{
+								if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, "Unload Item", 0) )
+								{
+									if ( PHYSFS_unmount(fullpath) )
+									{
+										if ( gamemodsRemovePathFromMountedFiles(fullpath) )
+										{
+											printlog("[%s] is removed from the search path.\n", fullpath);
+											gamemods_modelsListRequiresReload = true;
+											gamemods_soundListRequiresReload = true;
+										}
+									}
+								}
+							}
+						}
+					}
+					filename_pady += filename_rowHeight;
+				}
 
-			if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT )
-			{
-				if ( !mode )
+				// draw the tooltip we initialised earlier.
+				if ( drawModLoadOrder )
 				{
-					// restarting game, make a highscore
-					saveScore();
-					deleteSaveGame(multiplayer);
-					loadingsavegame = 0;
+					drawTooltip(&tooltip);
+					int numLoadedModLine = 1;
+					ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 4, uint32ColorBaronyBlue(*mainsurface), 
+						"Current load list: (first is lowest priority)");
+					for ( std::vector<std::pair<std::string, std::string>>::iterator it = gamemods_mountedFilepaths.begin(); it != gamemods_mountedFilepaths.end(); ++it )
+					{
+						std::pair<std::string, std::string> line = *it;
+						modInfoStr = line.second;
+						if ( modInfoStr.length() > 64 )
+						{
+							modInfoStr = modInfoStr.substr(0, 64 - 2).append("..");
+						}
+						ttfPrintTextFormatted(ttf12, tooltip.x + 4, tooltip.y + 4 + numLoadedModLine * TTF12_HEIGHT, "%2d) %s", numLoadedModLine, modInfoStr.c_str());
+						++numLoadedModLine;
+					}
 				}
-			}
-			camera_charsheet_offsetyaw = (330) * PI / 180; // reset player camera view.
-
-			// undo shopkeeper grudge
-			swornenemies[SHOPKEEPER][HUMAN] = false;
-			monsterally[SHOPKEEPER][HUMAN] = true;
-			swornenemies[SHOPKEEPER][AUTOMATON] = false;
-			monsterally[SHOPKEEPER][AUTOMATON] = true;
+				else if ( drawExtendedInformationForMod >= 0 )
+				{
+					int tooltip_pady = 8;
+					SteamUGCDetails_t itemDetails = g_SteamWorkshop->m_subscribedItemListDetails[drawExtendedInformationForMod];
+					// draw the information.
+					std::string line;
 
-			// setup game //TODO: Move into a function startGameStuff() or something.
-			entity_uids = 1;
-			loading = true;
-			darkmap = false;
+					line = itemDetails.m_rgchDescription;
+					line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+					//line.erase(std::remove(line.begin(), line.end(), '\n'), line.end());
+					std::string subString;
+					std::string outputStr;
+					std::size_t found = line.find('\n');
+					int numlines = 0;
+					while ( line.length() >= 62 || (found != std::string::npos && found < 62) )
+					{
+						if ( numlines >= maxDescriptionLines )
+						{
+							break;
+						}
+						if ( found != std::string::npos && found < 62 )
+						{
+							// found newline.
+							subString = line.substr(0, found);
+							line = line.substr(found + 1);
+						}
+						else
+						{
+							subString = line.substr(0, 62);
+							if ( subString.at(subString.length() - 1) != ' ' || line.at(62) != ' ' )
+							{
+								// handle word wrapping.
+								std::size_t lastSpace = subString.find_last_of(' ');
+								if ( lastSpace != std::string::npos )
+								{
+									subString = subString.substr(0, lastSpace);
+									line = line.substr(lastSpace, line.length());
+								}
+								else
+								{
+									line = line.substr(62);
+								}
+							}
+							else
+							{
+								line = line.substr(62);
+							}
+						}
+						outputStr.append(subString);
+						outputStr += '\n';
+						outputStr.append("  ");
+						found = line.find('\n');
+						++numlines;
+					}
 
-			for ( int i = 0; i < MAXPLAYERS; ++i )
-			{
-				players[i]->init();
-				players[i]->hud.reset();
-				deinitShapeshiftHotbar(i);
-				for ( c = 0; c < NUM_HOTBAR_ALTERNATES; ++c )
-				{
-					players[i]->hotbar.hotbarShapeshiftInit[c] = false;
-				}
-				players[i]->shootmode = true;
-				players[i]->magic.clearSelectedSpells();
-				enemyHPDamageBarHandler[i].HPBars.clear();
-			}
-			currentlevel = startfloor;
-			secretlevel = false;
-			victory = 0;
-			completionTime = 0;
+					subString = line;
+					outputStr.append(subString);
 
-			setDefaultPlayerConducts(); // penniless, foodless etc.
-			if ( startfloor != 0 )
-			{
-				conductGameChallenges[CONDUCT_CHEATS_ENABLED] = 1;
-			}
+					tooltip.h = (6 + std::min(maxDescriptionLines, numlines)) * TTF12_HEIGHT + 12;
+					drawTooltip(&tooltip);
 
-			for ( int i = 0; i < MAXPLAYERS; ++i )
-			{
-				minimapPings[i].clear(); // clear minimap pings
-			}
-			globalLightModifierActive = GLOBAL_LIGHT_MODIFIER_STOPPED;
-			gameplayCustomManager.readFromFile();
-			textSourceScript.scriptVariables.clear();
+					// draw description title.
+					line = itemDetails.m_rgchTitle;
+					found = line.find_first_of('\n');
+					if ( found != std::string::npos && found < 62 )
+					{
+						line = line.substr(0, found);
+						line.append("..");
+					}
+					else if ( line.length() >= 64 )
+					{
+						line = line.substr(0, 62);
+						line.append("..");
+					}
+					ttfPrintTextFormattedColor(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, uint32ColorBaronyBlue(*mainsurface), "%s", line.c_str());
+					tooltip_pady += TTF12_HEIGHT * 2;
 
-			if ( multiplayer == CLIENT )
-			{
-				gameModeManager.currentSession.saveServerFlags();
-				svFlags = lobbyWindowSvFlags;
-			}
-			else if ( !loadingsavegame && bWasOnMainMenu )
-			{
-				gameModeManager.currentSession.saveServerFlags();
-			}
+					// draw description body.
+					ttfPrintTextFormatted(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, "  %s", outputStr.c_str());
 
-			if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_TUTORIAL )
-			{
-				svFlags &= ~(SV_FLAG_HARDCORE);
-				svFlags &= ~(SV_FLAG_CHEATS);
-				svFlags &= ~(SV_FLAG_LIFESAVING);
-				svFlags &= ~(SV_FLAG_CLASSIC);
-				svFlags &= ~(SV_FLAG_KEEPINVENTORY);
-				svFlags |= SV_FLAG_HUNGER;
-				svFlags |= SV_FLAG_FRIENDLYFIRE;
-				svFlags |= SV_FLAG_MINOTAURS;
-				svFlags |= SV_FLAG_TRAPS;
+					tooltip_pady += TTF12_HEIGHT * (numlines + 2);
+					
+					// draw tags.
+					ttfPrintTextFormattedColor(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, uint32ColorBaronyBlue(*mainsurface), "tags:");
+					tooltip_pady += TTF12_HEIGHT;
+					line = itemDetails.m_rgchTags;
 
-				if ( gameModeManager.Tutorial.dungeonLevel >= 0 )
-				{
-					currentlevel = gameModeManager.Tutorial.dungeonLevel;
-					gameModeManager.Tutorial.dungeonLevel = -1;
+					int tooltip_padx = 0;
+					if ( !line.empty() )
+					{
+						subString = line;
+						ttfPrintTextFormatted(ttf12, tooltip.x + 8, tooltip.y + tooltip_pady, "  %s", subString.c_str());
+					}
 				}
 			}
+		}
+#endif //STEAMWORKS
 
-			for ( int i = 0; i < MAXPLAYERS; ++i )
+		if ( gamemods_window == 6 ) //TODO: NX PORT: Does this need any changes for the switch? Even if only to entirely disable the feature?
+		{
+			// create blank file structure for a mod.
+			filename_padx = subx1 + 16;
+			filename_pady = suby1 + 32;
+			ttfPrintTextFormatted(ttf12, filename_padx, filename_pady, "Enter base folder name for template directory");
+			filename_pady += TTF12_HEIGHT + 8;
+			drawDepressed(filename_padx - 4, filename_pady - 4, filename_padx + 32 * TTF12_WIDTH + 8, filename_pady + TTF12_HEIGHT);
+			ttfPrintTextFormatted(ttf12, filename_padx, filename_pady, "%s", gamemods_newBlankDirectory);
+			if ( !SDL_IsTextInputActive() )
 			{
-				// clear follower menu entities.
-				FollowerMenu[i].closeFollowerMenuGUI(true);
-				list_FreeAll(&damageIndicators[i]);
+				inputstr = gamemods_newBlankDirectory;
+				SDL_StartTextInput();
 			}
-			for ( c = 0; c < NUMMONSTERS; c++ )
+			inputlen = 30;
+			if ( SDL_IsTextInputActive()
+				&& (ticks - cursorflash) % TICKS_PER_SECOND < TICKS_PER_SECOND / 2 )
 			{
-				kills[c] = 0;
+				int x;
+				getSizeOfText(ttf12, inputstr, &x, NULL);
+				ttfPrintText(ttf12, filename_padx + x, filename_pady, "_");
 			}
-
-			// close chests
-			for ( c = 0; c < MAXPLAYERS; ++c )
+			filename_pady += TTF12_HEIGHT + 8;
+			if ( strcmp(gamemods_newBlankDirectoryOldName, gamemods_newBlankDirectory) == 0 )
 			{
-				if ( players[c]->isLocalPlayer() )
+				if ( gamemods_newBlankDirectoryStatus == -1 )
 				{
-					if ( openedChest[c] )
-					{
-						openedChest[c]->closeChest();
-					}
+					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorRed(*mainsurface), "Error: could not create directory %s/, already exists in mods/ folder", gamemods_newBlankDirectory);
 				}
-				else if ( c > 0 && !client_disconnected[c] )
+				else if ( gamemods_newBlankDirectoryStatus == 1 )
 				{
-					if ( openedChest[c] )
-					{
-						openedChest[c]->closeChestServer();
-					}
+					ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "Successfully created directory %s/ in mods/ folder", gamemods_newBlankDirectory);
 				}
 			}
-
-			// disable cheats
-			noclip = false;
-			godmode = false;
-			buddhamode = false;
-			everybodyfriendly = false;
-			gameloopFreezeEntities = false;
-
-#ifdef STEAMWORKS
-			if ( !directConnect )
+		}
+		if ( gamemods_window == 7 )
+		{
+			numFileEntries = 8;
+			filenameMaxLength = 48;
+			filename_padx = subx1 + 16;
+			filename_pady = suby1 + 32;
+			filename_padx2 = subx2 - 16 - 40;
+			filename_pady2 = filename_pady + numFileEntries * TTF12_HEIGHT + 8;
+			int filename_rowHeight = 2 * TTF12_HEIGHT + 8;
+			filename_pady += 3 * TTF12_HEIGHT;
+			int numLocalFolders = std::max(static_cast<int>(gamemods_localModFoldernames.size() - 2), 0);
+			if ( numLocalFolders > 0 )
 			{
-				if ( currentLobby )
-				{
-					// once the game is started, the lobby is no longer needed.
-					// when all steam users have left the lobby,
-					// the lobby is destroyed automatically on the backend.
-
-					SteamMatchmaking()->LeaveLobby(*static_cast<CSteamID*>(currentLobby));
-					cpp_Free_CSteamID(currentLobby); //TODO: Bugger this.
-					currentLobby = NULL;
-				}
+				ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorGreen(*mainsurface), "successfully retrieved local items!");
 			}
-#elif defined USE_EOS
-			if ( !directConnect )
+			else
 			{
-				/*if ( EOS.CurrentLobbyData.currentLobbyIsValid() )
-				{
-					EOS.leaveLobby();
-				}*/
+				ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady, uint32ColorOrange(*mainsurface), "no folders found!");
+				ttfPrintTextFormattedColor(ttf12, filename_padx, filename_pady + TTF12_HEIGHT + 8, uint32ColorOrange(*mainsurface), "to get started create a new folder, or copy shared custom content to the mods/ folder");
 			}
-#endif
 
-			// load dungeon
-			if ( multiplayer != CLIENT )
-			{
-				// stop all sounds
-#ifdef USE_FMOD
-				if ( sound_group )
-				{
-					FMOD_ChannelGroup_Stop(sound_group);
-				}
-				if ( soundAmbient_group )
-				{
-					FMOD_ChannelGroup_Stop(soundAmbient_group);
-				}
-				if ( soundEnvironment_group )
-				{
-					FMOD_ChannelGroup_Stop(soundEnvironment_group);
-				}
-#elif defined USE_OPENAL
-				if ( sound_group )
-				{
-					OPENAL_ChannelGroup_Stop(sound_group);
-				}
-				if ( soundAmbient_group )
-				{
-					OPENAL_ChannelGroup_Stop(soundAmbient_group);
-				}
-				if ( soundEnvironment_group )
-				{
-					OPENAL_ChannelGroup_Stop(soundEnvironment_group);
-				}
-#endif
+			std::string modInfoStr = "current loaded mods (hover for info): ";
+			SDL_Rect tooltip; // we will draw the tooltip after drawing the other elements of the display window.
+			bool drawModLoadOrder = false;
+			int drawExtendedInformationForMod = -1; // value of 0 or greater will draw.
+			int maxDescriptionLines = 10;
 
-				// generate a unique game key (used to identify compatible save games)
-				prng_seed_time();
-				if ( multiplayer == SINGLE )
-				{
-					uniqueGameKey = prng_get_uint();
-					if ( !uniqueGameKey )
-					{
-						uniqueGameKey++;
-					}
-				}
+			tooltip.x = omousex - 256;
+			tooltip.y = omousey + 16;
+			tooltip.w = 32 + TTF12_WIDTH * 64;
+			tooltip.h = (gamemods_mountedFilepaths.size() + 1) * TTF12_HEIGHT + 8;
 
-				// reset class loadout
-				if ( !loadingsavegame )
+			if ( gamemods_mountedFilepaths.size() > 0 )
+			{
+				ttfPrintTextFormatted(ttf12, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_pady, "%s %2d", modInfoStr.c_str(), gamemods_mountedFilepaths.size());
+				if ( mouseInBounds(clientnum, filename_padx2 - modInfoStr.length() * TTF12_WIDTH - 16, filename_padx2, filename_pady, filename_pady + TTF12_HEIGHT) )
 				{
-					stats[0]->clearStats();
-					initClass(0);
-					mapseed = 0;
+					drawModLoadOrder = true;
 				}
 				else
 				{
-					loadGame(0);
+					drawModLoadOrder = false;
 				}
+			}
 
-				// hack to fix these things from breaking everything...
-				for ( int i = 0; i < MAXPLAYERS; ++i )
-				{
-					players[i]->hud.arm = nullptr;
-					players[i]->hud.weapon = nullptr;
-					players[i]->hud.magicLeftHand = nullptr;
-					players[i]->hud.magicRightHand = nullptr;
-				}
+			filename_pady += 2 * TTF12_HEIGHT;
 
-				for ( node = map.entities->first; node != nullptr; node = node->next )
-				{
-					entity = (Entity*)node->element;
-					entity->flags[NOUPDATE] = true;
-				}
-				lastEntityUIDs = entity_uids;
-				numplayers = 0;
-				int checkMapHash = -1;
-				if ( loadingmap == false )
-				{
-					physfsLoadMapFile(currentlevel, mapseed, false, &checkMapHash);
-					if ( checkMapHash == 0 )
-					{
-						conductGameChallenges[CONDUCT_MODDED] = 1;
-					}
-				}
-				else
-				{
-					if ( genmap == false )
-					{
-						std::string fullMapName = physfsFormatMapName(maptoload);
-						loadMap(fullMapName.c_str(), &map, map.entities, map.creatures, &checkMapHash);
-						if ( checkMapHash == 0 )
-						{
-							conductGameChallenges[CONDUCT_MODDED] = 1;
-						}
-					}
-					else
-					{
-						generateDungeon(maptoload, mapseed);
-					}
-				}
-				assignActions(&map);
-				generatePathMaps();
+			// do slider
+			SDL_Rect slider;
+			slider.x = filename_padx2 + 8;
+			slider.y = filename_pady - 8;
+			slider.h = suby2 - (filename_pady + 20);
+			slider.w = 32;
 
-				achievementObserver.updateData();
+			int entriesToScroll = std::max(static_cast<int>((numLocalFolders / numFileEntries) - 1), 0);
+			entriesToScroll = entriesToScroll * numFileEntries + (numLocalFolders % numFileEntries);
 
-				if ( loadingsavegame )
+			// handle slider movement.
+			if ( numLocalFolders > numFileEntries )
+			{
+				drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+				if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
+					slider.y, slider.y + slider.h) )
 				{
-					for ( c = 0; c < MAXPLAYERS; c++ )
+					if ( mousestatus[SDL_BUTTON_WHEELUP] )
 					{
-						if ( players[c] && players[c]->entity && !client_disconnected[c] )
-						{
-							if ( stats[c] && stats[c]->EFFECTS[EFF_POLYMORPH] && stats[c]->playerPolymorphStorage != NOTHING )
-							{
-								players[c]->entity->effectPolymorph = stats[c]->playerPolymorphStorage;
-								serverUpdateEntitySkill(players[c]->entity, 50); // update visual polymorph effect for clients.
-								serverUpdateEffects(c);
-							}
-							if ( stats[c] && stats[c]->EFFECTS[EFF_SHAPESHIFT] && stats[c]->playerShapeshiftStorage != NOTHING )
-							{
-								players[c]->entity->effectShapeshift = stats[c]->playerShapeshiftStorage;
-								serverUpdateEntitySkill(players[c]->entity, 53); // update visual shapeshift effect for clients.
-								serverUpdateEffects(c);
-							}
-							if ( stats[c] && stats[c]->EFFECTS[EFF_VAMPIRICAURA] && stats[c]->EFFECTS_TIMERS[EFF_VAMPIRICAURA] == -2 )
-							{
-								players[c]->entity->playerVampireCurse = 1;
-								serverUpdateEntitySkill(players[c]->entity, 51); // update curse progression
-							}
-						}
+						gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
+						mousestatus[SDL_BUTTON_WHEELUP] = 0;
 					}
-
-					list_t* followers = loadGameFollowers();
-					if ( followers )
+					if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
 					{
-						int c;
-						for ( c = 0; c < MAXPLAYERS; c++ )
-						{
-							node_t* tempNode = list_Node(followers, c);
-							if ( tempNode )
-							{
-								list_t* tempFollowers = (list_t*)tempNode->element;
-								if (players[c] && players[c]->entity && !client_disconnected[c])
-								{
-									node_t* node;
-									node_t* gyrobotNode = nullptr;
-									Entity* gyrobotEntity = nullptr;
-									std::vector<node_t*> allyRobotNodes;
-									for ( node = tempFollowers->first; node != NULL; node = node->next )
-									{
-										Stat* tempStats = (Stat*)node->element;
-										if ( tempStats && tempStats->type == GYROBOT )
-										{
-											gyrobotNode = node;
-											break;
-										}
-									}
-									for ( node = tempFollowers->first; node != NULL; node = node->next )
-									{
-										Stat* tempStats = (Stat*)node->element;
-										if ( tempStats && (tempStats->type == DUMMYBOT
-											|| tempStats->type == SENTRYBOT
-											|| tempStats->type == SPELLBOT) )
-										{
-											// gyrobot will pick up these guys into it's inventory, otherwise leave them behind.
-											if ( gyrobotNode )
-											{
-												allyRobotNodes.push_back(node);
-											}
-											continue;
-										}
-										Entity* monster = summonMonster(tempStats->type, players[c]->entity->x, players[c]->entity->y);
-										if ( monster )
-										{
-											if ( node == gyrobotNode )
-											{
-												gyrobotEntity = monster;
-											}
-											monster->skill[3] = 1; // to mark this monster partially initialized
-											list_RemoveNode(monster->children.last);
-
-											node_t* newNode = list_AddNodeLast(&monster->children);
-											newNode->element = tempStats->copyStats();
-											newNode->deconstructor = &statDeconstructor;
-											newNode->size = sizeof(tempStats);
-
-											Stat* monsterStats = (Stat*)newNode->element;
-											monsterStats->leader_uid = players[c]->entity->getUID();
-											monster->flags[USERFLAG2] = true;
-											/*if ( !monsterally[HUMAN][monsterStats->type] )
-											{
-											}*/
-											monster->monsterAllyIndex = c;
-											if ( multiplayer == SERVER )
-											{
-												serverUpdateEntitySkill(monster, 42); // update monsterAllyIndex for clients.
-											}
-
-											if ( multiplayer != CLIENT )
-											{
-												monster->monsterAllyClass = monsterStats->allyClass;
-												monster->monsterAllyPickupItems = monsterStats->allyItemPickup;
-												if ( stats[c]->playerSummonPERCHR != 0 && !strcmp(monsterStats->name, "skeleton knight") )
-												{
-													monster->monsterAllySummonRank = (stats[c]->playerSummonPERCHR & 0x0000FF00) >> 8;
-												}
-												else if ( stats[c]->playerSummon2PERCHR != 0 && !strcmp(monsterStats->name, "skeleton sentinel") )
-												{
-													monster->monsterAllySummonRank = (stats[c]->playerSummon2PERCHR & 0x0000FF00) >> 8;
-												}
-												serverUpdateEntitySkill(monster, 46); // update monsterAllyClass
-												serverUpdateEntitySkill(monster, 44); // update monsterAllyPickupItems
-												serverUpdateEntitySkill(monster, 50); // update monsterAllySummonRank
-											}
-
-											newNode = list_AddNodeLast(&stats[c]->FOLLOWERS);
-											newNode->deconstructor = &defaultDeconstructor;
-											Uint32* myuid = (Uint32*) malloc(sizeof(Uint32));
-											newNode->element = myuid;
-											*myuid = monster->getUID();
-
-											if ( c > 0 && multiplayer == SERVER )
-											{
-												strcpy((char*)net_packet->data, "LEAD");
-												SDLNet_Write32((Uint32)monster->getUID(), &net_packet->data[4]);
-												strcpy((char*)(&net_packet->data[8]), monsterStats->name);
-												net_packet->data[8 + strlen(monsterStats->name)] = 0;
-												net_packet->address.host = net_clients[c - 1].host;
-												net_packet->address.port = net_clients[c - 1].port;
-												net_packet->len = 8 + strlen(monsterStats->name) + 1;
-												sendPacketSafe(net_sock, -1, net_packet, c - 1);
-
-												serverUpdateAllyStat(c, monster->getUID(), monsterStats->LVL, monsterStats->HP, monsterStats->MAXHP, monsterStats->type);
-											}
-
-											if ( !FollowerMenu[c].recentEntity && players[c]->isLocalPlayer() )
-											{
-												FollowerMenu[c].recentEntity = monster;
-											}
-										}
-									}
-									if ( gyrobotEntity && !allyRobotNodes.empty() )
-									{
-										Stat* gyroStats = gyrobotEntity->getStats();
-										for ( auto it = allyRobotNodes.begin(); gyroStats && it != allyRobotNodes.end(); ++it )
-										{
-											node_t* botNode = *it;
-											if ( botNode )
-											{
-												Stat* tempStats = (Stat*)botNode->element;
-												if ( tempStats )
-												{
-													ItemType type = WOODEN_SHIELD;
-													if ( tempStats->type == SENTRYBOT )
-													{
-														type = TOOL_SENTRYBOT;
-													}
-													else if ( tempStats->type == SPELLBOT )
-													{
-														type = TOOL_SPELLBOT;
-													}
-													else if ( tempStats->type == DUMMYBOT )
-													{
-														type = TOOL_DUMMYBOT;
-													}
-													int appearance = monsterTinkeringConvertHPToAppearance(tempStats);
-													if ( type != WOODEN_SHIELD )
-													{
-														Item* item = newItem(type, static_cast<Status>(tempStats->monsterTinkeringStatus), 
-															0, 1, appearance, true, &gyroStats->inventory);
-													}
-												}
-											}
-										}
-									}
-								}
-							}
-						}
-						list_FreeAll(followers);
-						free(followers);
+						gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
+						mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
 					}
 				}
 
-				if ( multiplayer == SINGLE )
-				{
-					saveGame();
-				}
-			}
-			else
-			{
-				// hack to fix these things from breaking everything...
-				for ( int i = 0; i < MAXPLAYERS; ++i )
-				{
-					players[i]->hud.arm = nullptr;
-					players[i]->hud.weapon = nullptr;
-					players[i]->hud.magicLeftHand = nullptr;
-					players[i]->hud.magicRightHand = nullptr;
-				}
-
-				client_disconnected[0] = false;
-
-				// initialize class
-				if ( !loadingsavegame )
-				{
-					stats[clientnum]->clearStats();
-					initClass(clientnum);
-					mapseed = 0;
-				}
-				else
-				{
-					loadGame(clientnum);
-				}
-
-				// stop all sounds
-#ifdef USE_FMOD
-				if ( sound_group )
-				{
-					FMOD_ChannelGroup_Stop(sound_group);
-				}
-				if ( soundAmbient_group )
+				if ( keystatus[SDL_SCANCODE_UP] )
 				{
-					FMOD_ChannelGroup_Stop(soundAmbient_group);
+					gamemods_window_scroll = std::max(gamemods_window_scroll - 1, 0);
+					keystatus[SDL_SCANCODE_UP] = 0;
 				}
-				if ( soundEnvironment_group )
+				if ( keystatus[SDL_SCANCODE_DOWN] )
 				{
-					FMOD_ChannelGroup_Stop(soundEnvironment_group);
+					gamemods_window_scroll = std::min(gamemods_window_scroll + 1, entriesToScroll);
+					keystatus[SDL_SCANCODE_DOWN] = 0;
 				}
-#elif defined USE_OPENAL
-				if ( sound_group )
+				slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
+				slider.y += slider.h * gamemods_window_scroll;
+				if ( gamemods_window_scroll == entriesToScroll ) // reached end.
 				{
-					OPENAL_ChannelGroup_Stop(sound_group);
+					slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
 				}
-				if ( soundAmbient_group )
+				drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
+			}
+
+			// draw the content
+			for ( int i = gamemods_window_scroll; i < numLocalFolders && i < numFileEntries + gamemods_window_scroll; ++i )
+			{
+				filename_padx = subx1 + 16;
+
+				std::list<std::string>::iterator it = gamemods_localModFoldernames.begin();
+				std::advance(it, 2); // skip the "." and ".." directories.
+				std::advance(it, i);
+				std::string folderName = *it;
+
+				drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
+				SDL_Rect highlightEntry;
+				highlightEntry.x = filename_padx;
+				highlightEntry.y = filename_pady - 8;
+				highlightEntry.w = filename_padx2 - filename_padx;
+				highlightEntry.h = filename_rowHeight + 8;
+				drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
+
+				std::string path = outputdir;
+				path.append(PHYSFS_getDirSeparator()).append("mods").append(PHYSFS_getDirSeparator()).append(folderName);
+				bool pathIsMounted = gamemodsIsPathInMountedFiles(path);
+
+				if ( pathIsMounted )
 				{
-					OPENAL_ChannelGroup_Stop(soundAmbient_group);
+					SDL_Rect pos;
+					pos.x = filename_padx + 2;
+					pos.y = filename_pady - 6;
+					pos.w = filename_padx2 - filename_padx - 4;
+					pos.h = filename_rowHeight + 4;
+					drawRect(&pos, uint32ColorGreen(*mainsurface), 64);
 				}
-				if ( soundEnvironment_group )
+
+				if ( folderName.length() >= filenameMaxLength )
 				{
-					OPENAL_ChannelGroup_Stop(soundEnvironment_group);
+					folderName = folderName.substr(0, 46);
+					folderName.append("..");
 				}
-#endif
-				// load next level
-				entity_uids = 1;
-				lastEntityUIDs = entity_uids;
-				numplayers = 0;
+				ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady + TTF12_HEIGHT / 2, "Folder Name: %s", folderName.c_str());
 
-				int checkMapHash = -1;
-				if ( loadingmap == false )
+				filename_padx = filename_padx2 - (12 * TTF12_WIDTH + 16);
+				// mount button
+				if ( !pathIsMounted )
 				{
-					physfsLoadMapFile(currentlevel, mapseed, false, &checkMapHash);
-					if ( checkMapHash == 0 )
+					if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, " Load Item ", 0) )
 					{
-						conductGameChallenges[CONDUCT_MODDED] = 1;
+						if ( PHYSFS_mount(path.c_str(), NULL, 0) )
+						{
+							gamemods_mountedFilepaths.push_back(std::make_pair(path, folderName));
+							printlog("[PhysFS]: [%s] is in the search path.\n", path.c_str());
+							gamemods_modelsListRequiresReload = true;
+							gamemods_soundListRequiresReload = true;
+						}
 					}
 				}
-				else
+				filename_pady += filename_rowHeight / 2;
+				// unmount button
+				if ( pathIsMounted )
 				{
-					if ( genmap == false )
+					if ( gamemodsDrawClickableButton(filename_padx, filename_pady, 12 * TTF12_WIDTH + 8, TTF12_HEIGHT, 0, "Unload Item", 0) )
 					{
-						std::string fullMapName = physfsFormatMapName(maptoload);
-						loadMap(fullMapName.c_str(), &map, map.entities, map.creatures, &checkMapHash);
-						if ( checkMapHash == 0 )
+						if ( PHYSFS_unmount(path.c_str()) )
 						{
-							conductGameChallenges[CONDUCT_MODDED] = 1;
+							if ( gamemodsRemovePathFromMountedFiles(path) )
+							{
+								printlog("[PhysFS]: [%s] is removed from the search path.\n", path.c_str());
+								gamemods_modelsListRequiresReload = true;
+								gamemods_soundListRequiresReload = true;
+							}
 						}
 					}
-					else
-					{
-						generateDungeon(maptoload, rand());
-					}
 				}
-				assignActions(&map);
-				generatePathMaps();
-				for ( node = map.entities->first; node != nullptr; node = nextnode )
+				filename_pady += filename_rowHeight;
+			}
+
+			// draw the tooltip we initialised earlier.
+			if ( drawModLoadOrder )
+			{
+				drawTooltip(&tooltip);
+				int numLoadedModLine = 1;
+				ttfPrintTextFormattedColor(ttf12, tooltip.x + 4, tooltip.y + 4, uint32ColorBaronyBlue(*mainsurface),
+					"Current load list: (first is lowest priority)");
+				for ( std::vector<std::pair<std::string, std::string>>::iterator it = gamemods_mountedFilepaths.begin(); it != gamemods_mountedFilepaths.end(); ++it )
 				{
-					nextnode = node->next;
-					Entity* entity = (Entity*)node->element;
-					if ( entity->flags[NOUPDATE] )
+					std::pair<std::string, std::string> line = *it;
+					modInfoStr = line.second;
+					if ( modInfoStr.length() > 64 )
 					{
-						list_RemoveNode(entity->mynode);    // we're anticipating this entity data from server
+						modInfoStr = modInfoStr.substr(0, 64 - 2).append("..");
 					}
+					ttfPrintTextFormatted(ttf12, tooltip.x + 4, tooltip.y + 4 + numLoadedModLine * TTF12_HEIGHT, "%2d) %s", numLoadedModLine, modInfoStr.c_str());
+					++numLoadedModLine;
 				}
-
-				printlog("Done.\n");
 			}
+		}
+	}
+	else if ( gameModeManager.Tutorial.Menu.isOpen() )
+	{
+		int numFileEntries = 11;
+
+		int filenameMaxLength = 48;
+		int filename_padx = subx1 + 16;
+		int filename_pady = suby1 + 32;
+		int filename_padx2 = subx2 - 16;
+		int filename_rowHeight = 1.25 * TTF12_HEIGHT + 8;
+
+		auto& menu = gameModeManager.Tutorial.Menu;
+		ttfPrintTextFormattedColor(ttf12, filename_padx + 8, filename_pady + 8, uint32ColorWhite(*mainsurface), "%s", menu.windowTitle.c_str());
+
+		filename_pady += 4 * TTF12_HEIGHT;
+
+		// do slider
+		SDL_Rect slider;
+		slider.x = filename_padx2 + 8;
+		slider.y = filename_pady - 8;
+		slider.h = suby2 - (filename_pady + 20);
+		slider.w = 32;
+
+		int entriesToScroll = static_cast<Uint32>(std::max(((static_cast<int>(gameModeManager.Tutorial.levels.size()) / numFileEntries) - 1), 0));
+		entriesToScroll = entriesToScroll * numFileEntries + (gameModeManager.Tutorial.levels.size() % numFileEntries);
+
+		menu.selectedMenuItem = -1;
 
-			// spice of life achievement
-			usedClass[client_classes[clientnum]] = true;
-			bool usedAllClasses = true;
-			for ( c = 0; c <= CLASS_MONK; c++ )
+		// handle slider movement.
+		if ( gameModeManager.Tutorial.levels.size() > numFileEntries )
+		{
+			drawRect(&slider, SDL_MapRGB(mainsurface->format, 64, 64, 64), 255);
+			if ( mouseInBounds(clientnum, filename_padx, slider.x + slider.w,
+				slider.y, slider.y + slider.h) )
 			{
-				if ( !usedClass[c] )
+				if ( mousestatus[SDL_BUTTON_WHEELUP] )
 				{
-					usedAllClasses = false;
+					menu.windowScroll = std::max(menu.windowScroll - 1, 0);
+					mousestatus[SDL_BUTTON_WHEELUP] = 0;
+				}
+				if ( mousestatus[SDL_BUTTON_WHEELDOWN] )
+				{
+					menu.windowScroll = std::min(menu.windowScroll + 1, entriesToScroll);
+					mousestatus[SDL_BUTTON_WHEELDOWN] = 0;
 				}
-			}
-			if ( usedAllClasses )
-			{
-				steamAchievement("BARONY_ACH_SPICE_OF_LIFE");
 			}
 
-			if ( stats[clientnum]->playerRace >= 0 && stats[clientnum]->playerRace <= RACE_INSECTOID )
+			if ( keystatus[SDL_SCANCODE_UP] )
 			{
-				usedRace[stats[clientnum]->playerRace] = true;
+				menu.windowScroll = std::max(menu.windowScroll - 1, 0);
+				keystatus[SDL_SCANCODE_UP] = 0;
 			}
-			// new achievement
-			usedAllClasses = true;
-			for ( c = 0; c <= CLASS_HUNTER; ++c )
+			if ( keystatus[SDL_SCANCODE_DOWN] )
 			{
-				if ( !usedClass[c] )
-				{
-					usedAllClasses = false;
-				}
+				menu.windowScroll = std::min(menu.windowScroll + 1, entriesToScroll);
+				keystatus[SDL_SCANCODE_DOWN] = 0;
 			}
-			bool usedAllRaces = true;
-			for ( c = RACE_HUMAN; c <= RACE_INSECTOID; ++c )
+			slider.h *= (1 / static_cast<real_t>(entriesToScroll + 1));
+			slider.y += slider.h * menu.windowScroll;
+			if ( menu.windowScroll == entriesToScroll ) // reached end.
 			{
-				if ( !usedRace[c] )
-				{
-					usedAllRaces = false;
-				}
+				slider.y += (suby2 - 28) - (slider.y + slider.h); // bottom of slider is (suby2 - 28), so move the y level to imitate hitting the bottom in case of rounding error.
 			}
-			if ( usedAllClasses && usedAllRaces )
+			drawWindowFancy(slider.x, slider.y, slider.x + slider.w, slider.y + slider.h); // draw shortened list relative slider.
+		}
+
+		// draw the content
+		for ( int i = menu.windowScroll; i < gameModeManager.Tutorial.levels.size() && i < numFileEntries + menu.windowScroll; ++i )
+		{
+			filename_padx = subx1 + 16;
+
+			auto it = gameModeManager.Tutorial.levels.begin();
+			std::advance(it, i);
+			std::string folderName = (*it).title;
+
+			drawWindowFancy(filename_padx, filename_pady - 8, filename_padx2, filename_pady + filename_rowHeight);
+
+			SDL_Rect highlightEntry;
+			highlightEntry.x = filename_padx;
+			highlightEntry.y = filename_pady - 8;
+			highlightEntry.w = filename_padx2 - filename_padx;
+			highlightEntry.h = filename_rowHeight + 8;
+			drawRect(&highlightEntry, SDL_MapRGB(mainsurface->format, 128, 128, 128), 64);
+
+			if ( mouseInBounds(clientnum, highlightEntry.x, highlightEntry.x + highlightEntry.w, highlightEntry.y - 2, highlightEntry.y + highlightEntry.h + 4) )
 			{
-				steamAchievement("BARONY_ACH_I_WANT_IT_ALL");
+				menu.selectedMenuItem = i;
 			}
 
-			if ( gameModeManager.getMode() == GameModeManager_t::GAME_MODE_DEFAULT && !loadingsavegame )
+			if ( menu.selectedMenuItem == i )
 			{
-				steamStatisticUpdate(STEAM_STAT_GAMES_STARTED, STEAM_STAT_INT, 1);
-				achievementObserver.updateGlobalStat(STEAM_GSTAT_GAMES_STARTED);
+				SDL_Rect pos;
+				pos.x = filename_padx + 2;
+				pos.y = filename_pady - 6;
+				pos.w = filename_padx2 - filename_padx - 4;
+				pos.h = filename_rowHeight + 4;
+				drawRect(&pos, uint32ColorBaronyBlue(*mainsurface), 64);
+				ttfPrintTextFormattedColor(ttf12, filename_padx + 8, suby2 - 3 * TTF12_HEIGHT, uint32ColorYellow(*mainsurface), "%s", (*it).description.c_str());
 			}
 
-			// delete game data clutter
-			list_FreeAll(&messages);
-			list_FreeAll(&command_history);
-			list_FreeAll(&safePacketsSent);
-			for ( c = 0; c < MAXPLAYERS; c++ )
+			SDL_Rect btn;
+			btn.w = 6 * TTF12_WIDTH + 8;
+			btn.h = highlightEntry.h - 12;
+			btn.x = highlightEntry.x + highlightEntry.w - btn.w - 4;
+			btn.y = highlightEntry.y + 8;
+			if ( i == 0 )
 			{
-				safePacketsReceivedMap[c].clear();
-				players[c]->messageZone.deleteAllNotificationMessages();
+				btn.w = 11 * TTF12_WIDTH + 8;
+				btn.x = highlightEntry.x + highlightEntry.w - btn.w - 4;
+				if ( drawClickableButton(btn.x, btn.y, btn.w, btn.h, 0) )
+				{
+					menu.onClickEntry();
+				}
+				ttfPrintTextFormatted(ttf12, btn.x + 11, filename_pady + 4, "%s", "Enter Hub");
 			}
-			if ( !loadingsavegame ) // don't delete the followers we just created!
+			else
 			{
-				for (c = 0; c < MAXPLAYERS; c++)
+				if ( drawClickableButton(btn.x, btn.y, btn.w, btn.h, 0) )
 				{
-					list_FreeAll(&stats[c]->FOLLOWERS);
+					menu.onClickEntry();
 				}
+				ttfPrintTextFormatted(ttf12, btn.x + 7, filename_pady + 4, "%s", "Begin");
 			}
 
-			if ( loadingsavegame && multiplayer != CLIENT )
-			{
-				loadingsavegame = 0;
-			}
+			ttfPrintTextFormatted(ttf12, filename_padx + 8, filename_pady + 4, "%s", (*it).title.c_str());
 
-			enchantedFeatherScrollSeed.seed(uniqueGameKey);
-			enchantedFeatherScrollsShuffled.clear();
-			enchantedFeatherScrollsShuffled = enchantedFeatherScrollsFixedList;
-			std::shuffle(enchantedFeatherScrollsShuffled.begin(), enchantedFeatherScrollsShuffled.end(), enchantedFeatherScrollSeed);
-			for ( auto it = enchantedFeatherScrollsShuffled.begin(); it != enchantedFeatherScrollsShuffled.end(); ++it )
+			if ( i != 0 )
 			{
-				//printlog("Sequence: %d", *it);
+				const Uint32 sec = ((*it).completionTime / TICKS_PER_SECOND) % 60;
+				const Uint32 min = (((*it).completionTime / TICKS_PER_SECOND) / 60) % 60;
+				const Uint32 hour = (((*it).completionTime / TICKS_PER_SECOND) / 60) / 60;
+				const Uint32 timeTextWidth = 28 * TTF12_WIDTH + 8;
+				if ( (*it).completionTime > 0 )
+				{
+					ttfPrintTextFormatted(ttf12, btn.x - timeTextWidth, filename_pady + 4, "Best time: %02d:%02d:%02d", hour, min, sec);
+				}
+				else
+				{
+					ttfPrintTextFormatted(ttf12, btn.x - timeTextWidth, filename_pady + 4, "Not completed");
+				}
 			}
 
-			list_FreeAll(&removedEntities);
+			filename_padx = filename_padx2 - (12 * TTF12_WIDTH + 16);
+			filename_pady += 1.5 * filename_rowHeight;
+		}
 
-			for ( c = 0; c < MAXPLAYERS; c++ )
+		if ( menu.selectedMenuItem == -1 )
+		{
+			ttfPrintTextFormattedColor(ttf12, subx1 + 16 + 8, suby2 - 3 * TTF12_HEIGHT, uint32ColorYellow(*mainsurface), "%s", menu.defaultHoverText.c_str());
+		}
+	}
+	else if ( gameModeManager.Tutorial.FirstTimePrompt.isOpen() )
+	{
+		gameModeManager.Tutorial.FirstTimePrompt.drawDialogue();
+		if ( gameModeManager.Tutorial.FirstTimePrompt.doButtonSkipPrompt )
+		{
+			gameModeManager.Tutorial.FirstTimePrompt.doButtonSkipPrompt = false;
+			if ( anySaveFileExists() )
 			{
-				list_FreeAll(&chestInv[c]);
+				openNewLoadGameWindow(nullptr);
 			}
+			else
+			{
+				buttonOpenCharacterCreationWindow(NULL);
+			}
+		}
+	}
 
-			// make some messages
-			startMessages();
-
-			// kick off the main loop!
-			pauseGame(1, 0);
-			loading = false;
-			intro = false;
+	// handle fade actions
+	if ( fadefinished )
+	{
+		if ( introstage == 2 )   // quit game
+		{
+			introstage = 0;
+			mainloop = 0;
+		}
+		else if ( introstage == 3 )     // new game
+		{
+			doNewGame(mode);
 		}
 		else if ( introstage == 4 )     // credits
 		{
@@ -10212,6 +10231,7 @@ void handleMainMenu(bool mode)
 					if ( shopInv[x] )
 					{
 						list_FreeAll(shopInv[x]);
+						detachInventoryIndex(shopInv[x]);
 						free(shopInv[x]);
 						shopInv[x] = nullptr;
 					}
@@ -10408,10 +10428,9 @@ void handleMainMenu(bool mode)
 			// delete game data clutter
 			list_FreeAll(&messages);
 			list_FreeAll(&command_history);
-			list_FreeAll(&safePacketsSent);
+			SafePacketHandler.reset();
 			for ( c = 0; c < MAXPLAYERS; c++ )
 			{
-				safePacketsReceivedMap[c].clear();
 				players[c]->messageZone.deleteAllNotificationMessages();
 			}
 			for (c = 0; c < MAXPLAYERS; c++)
@@ -15,6 +15,7 @@ extern bool savethisgame;
 
 // main menu code
 void handleMainMenu(bool mode);
+void doNewGame(bool mode);
 
 #define NUMSUBTITLES 30
 extern int subtitleCurrent;
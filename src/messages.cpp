@@ -14,6 +14,7 @@
 #include "messages.hpp"
 #include "main.hpp"
 #include "player.hpp"
+#include "hud_cache.hpp"
 #include <regex>
 
 void messageDeconstructor(void* data)
@@ -250,8 +251,26 @@ void Player::MessageZone_t::updateMessages()
 	}
 }
 
+// the messages only move or fade now and then, so they're drawn from a cached list
+static HudCacheHandler::Widget_t messagesWidget[MAXPLAYERS];
+
 void Player::MessageZone_t::drawMessages()
 {
+	const int playernum = player.playernum;
+	HudPanelTimer panelTimer(playernum, HudCacheHandler::PANEL_MESSAGES);
+
+	HudCacheHandler::Key key;
+	key.add(xres).add(yres).add(font);
+	for ( Message *current : notification_messages )
+	{
+		key.add(current->text->data).add(current->text->color).add(current->x).add(current->y)
+			.add(std::min<Sint16>(std::max<Sint16>(0, current->alpha), 255));
+	}
+	if ( HudCache.begin(messagesWidget[playernum], key) )
+	{
+		return;
+	}
+
 	for ( Message *current : notification_messages )
 	{
 		Uint32 color = current->text->color ^ mainsurface->format->Amask;
@@ -309,6 +328,7 @@ void Player::MessageZone_t::drawMessages()
 			ttfPrintTextFormattedColor(font, current->x, current->y, color, current->text->data);
 		}
 	}
+	HudCache.end(messagesWidget[playernum]);
 }
 
 void Player::MessageZone_t::deleteAllNotificationMessages()
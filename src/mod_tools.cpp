@@ -15,6 +15,7 @@ See LICENSE for details.
 #include "draw.hpp"
 #include "player.hpp"
 
+JsonFileCache jsonFileCache;
 MonsterStatCustomManager monsterStatCustomManager;
 MonsterCurveCustomManager monsterCurveCustomManager;
 GameplayCustomManager gameplayCustomManager;
@@ -43,6 +44,70 @@ const std::vector<std::string> MonsterStatCustomManager::shopkeeperTypeStrings =
 	"general"
 };
 
+std::shared_ptr<const rapidjson::Document> JsonFileCache::getDocument(const std::string& path, std::string& inputPath)
+{
+	const char* realDir = PHYSFS_getRealDir(path.c_str());
+	if ( !realDir )
+	{
+		inputPath = path;
+		entries.erase(path);
+		return nullptr;
+	}
+	inputPath = realDir;
+	inputPath.append(path);
+
+	PHYSFS_Stat stat;
+	PHYSFS_sint64 modtime = -1;
+	if ( PHYSFS_stat(path.c_str(), &stat) )
+	{
+		modtime = stat.modtime;
+	}
+
+	auto find = entries.find(path);
+	if ( find != entries.end() && find->second.realDir.compare(realDir) == 0 && find->second.modtime == modtime )
+	{
+		++hits;
+		return find->second.document;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	File* fp = FileIO::open(inputPath.c_str(), "rb");
+	if ( !fp )
+	{
+		printlog("[JSON]: Error: Could not locate json file %s", inputPath.c_str());
+		entries.erase(path);
+		return nullptr;
+	}
+	std::vector<char> buf(fp->size() + 1, '\0');
+	size_t count = fp->read(buf.data(), sizeof(buf[0]), buf.size() - 1);
+	buf[count] = '\0';
+	FileIO::close(fp);
+
+	auto document = std::make_shared<rapidjson::Document>();
+	rapidjson::StringStream is(buf.data());
+	document->ParseStream(is);
+
+	Entry_t& entry = entries[path];
+	entry.realDir = realDir;
+	entry.modtime = modtime;
+	entry.document = document;
+	++loads;
+	loadMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	return entry.document;
+}
+
+void JsonFileCache::logStatus() const
+{
+	printlog("[JSON]: cache holds %d files, %d loads in %.2f ms, %d hits",
+		static_cast<int>(entries.size()), loads, loadMs, hits);
+}
+
+void MonsterStatCustomManager::logStatus() const
+{
+	printlog("[JSON]: %d monster definitions built, %d spawns in %.2f ms (%.3f ms each)",
+		definitionsBuilt, spawns, spawnMs, spawns > 0 ? spawnMs / spawns : 0.0);
+}
+
 void GameModeManager_t::Tutorial_t::startTutorial(std::string mapToSet)
 {
 	if ( mapToSet.compare("") == 0 )
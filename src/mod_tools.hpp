@@ -22,6 +22,9 @@ See LICENSE for details.
 #include "net.hpp"
 #include "scores.hpp"
 
+#include <chrono>
+#include <memory>
+
 class CustomHelpers
 {
 public:
@@ -62,6 +65,40 @@ public:
 	}
 };
 
+/*-------------------------------------------------------------------------------
+
+	JsonFileCache
+
+	parsed documents for the json files under /data, keyed by PhysFS path.
+	a file is only read and parsed again once it resolves to a different
+	mount (a mod was loaded or unloaded) or its modification time changes,
+	until then every caller shares the same immutable document.
+
+-------------------------------------------------------------------------------*/
+
+class JsonFileCache
+{
+public:
+	// nullptr if the file can't be found or read. inputPath is set to the
+	// real path of the file for log messages
+	std::shared_ptr<const rapidjson::Document> getDocument(const std::string& path, std::string& inputPath);
+	void clear() { entries.clear(); }
+	void logStatus() const;
+
+	int loads = 0;
+	int hits = 0;
+	double loadMs = 0.0;
+private:
+	struct Entry_t
+	{
+		std::string realDir;
+		PHYSFS_sint64 modtime = -1;
+		std::shared_ptr<const rapidjson::Document> document;
+	};
+	std::unordered_map<std::string, Entry_t> entries;
+};
+extern JsonFileCache jsonFileCache;
+
 class MonsterStatCustomManager
 {
 public:
@@ -389,6 +426,22 @@ public:
 				PROFICIENCIES[i] = 0;
 			}
 		};
+		explicit StatEntry(Uint32 seed) :
+			StatEntrySeed(seed)
+		{
+			for ( int i = 0; i < NUMPROFICIENCIES; ++i )
+			{
+				PROFICIENCIES[i] = 0;
+			}
+		};
+
+		// takes every value from a parsed definition, but keeps this entry's own seed
+		void copyDefinition(const StatEntry& definition)
+		{
+			std::mt19937 seed = StatEntrySeed;
+			*this = definition;
+			StatEntrySeed = seed;
+		}
 
 		std::string getFollowerVariant()
 		{
@@ -1090,252 +1143,289 @@ public:
 		{
 			filePath.append(".json");
 		}
-		if ( PHYSFS_getRealDir(filePath.c_str()) )
+		if ( !PHYSFS_getRealDir(filePath.c_str()) )
 		{
-			std::string inputPath = PHYSFS_getRealDir(filePath.c_str());
-			inputPath.append(filePath);
-
-			File* fp = FileIO::open(inputPath.c_str(), "rb");
-			if ( !fp )
-			{
-				printlog("[JSON]: Error: Could not locate json file %s", inputPath.c_str());
-				return nullptr;
-			}
-			char buf[65536];
-			int count = fp->read(buf, sizeof(buf[0]), sizeof(buf));
-			buf[count] = '\0';
-			rapidjson::StringStream is(buf);
-			FileIO::close(fp);
+			printlog("[JSON]: Error: Could not locate json file %s", filePath.c_str());
+			return nullptr;
+		}
 
-			rapidjson::Document d;
-			d.ParseStream(is);
+		auto definition = getDefinition(filePath);
+		if ( !definition.first )
+		{
+			return nullptr;
+		}
 
+		auto start = std::chrono::high_resolution_clock::now();
+		StatEntry* statEntry = new StatEntry();
+		statEntry->copyDefinition(*definition.second);
 
-			if ( !d.HasMember("version") )
-			{
-				printlog("[JSON]: Error: No 'version' value in json file, or JSON syntax incorrect! %s", inputPath.c_str());
-				return nullptr;
-			}
-			StatEntry* statEntry = new StatEntry();
-			int version = d["version"].GetInt();
-			const rapidjson::Value& stats = d["stats"];
-			for ( rapidjson::Value::ConstMemberIterator stat_itr = stats.MemberBegin(); stat_itr != stats.MemberEnd(); ++stat_itr )
-			{
-				readKeyToStatEntry(*statEntry, stat_itr);
-			}
-			const rapidjson::Value& miscStats = d["misc_stats"];
-			for ( rapidjson::Value::ConstMemberIterator stat_itr = miscStats.MemberBegin(); stat_itr != miscStats.MemberEnd(); ++stat_itr )
-			{
-				readKeyToStatEntry(*statEntry, stat_itr);
-			}
-			const rapidjson::Value& proficiencies = d["proficiencies"];
-			for ( rapidjson::Value::ConstMemberIterator stat_itr = proficiencies.MemberBegin(); stat_itr != proficiencies.MemberEnd(); ++stat_itr )
-			{
-				readKeyToStatEntry(*statEntry, stat_itr);
-			}
-			const rapidjson::Value& equipped_items = d["equipped_items"];
-			for ( rapidjson::Value::ConstMemberIterator itemSlot_itr = equipped_items.MemberBegin(); itemSlot_itr != equipped_items.MemberEnd(); ++itemSlot_itr )
-			{
-				std::string slotName = itemSlot_itr->name.GetString();
-				if ( itemSlot_itr->value.MemberCount() > 0 )
-				{
-					if ( itemSlot_itr->value.IsArray() )
-					{
-						std::vector<std::pair<ItemEntry, int>> itemsToChoose;
-						// a selection of items in the slot. need to choose 1.
-						for ( rapidjson::Value::ConstValueIterator itemArray_itr = itemSlot_itr->value.Begin(); itemArray_itr != itemSlot_itr->value.End(); ++itemArray_itr )
-						{
-							ItemEntry item;
-							for ( rapidjson::Value::ConstMemberIterator item_itr = itemArray_itr->MemberBegin(); item_itr != itemArray_itr->MemberEnd(); ++item_itr )
-							{
-								item.readKeyToItemEntry(item_itr);
-							}
-							itemsToChoose.push_back(std::make_pair(item, getSlotFromKeyName(slotName)));
-						}
-						if ( itemsToChoose.size() > 0 )
-						{
-							std::vector<int> itemChances(itemsToChoose.size(), 0);
-							int index = 0;
-							for ( auto& pair : itemsToChoose )
-							{
-								itemChances.at(index) = pair.first.weightedChance;
-								++index;
-							}
-
-							std::discrete_distribution<> itemWeightedDistribution(itemChances.begin(), itemChances.end());
-							int result = itemWeightedDistribution(monsterStatSeed);
-							statEntry->equipped_items.push_back(std::make_pair(itemsToChoose.at(result).first, itemsToChoose.at(result).second));
-						}
-					}
-					else
-					{
-						ItemEntry item;
-						for ( rapidjson::Value::ConstMemberIterator item_itr = itemSlot_itr->value.MemberBegin(); item_itr != itemSlot_itr->value.MemberEnd(); ++item_itr )
-						{
-							item.readKeyToItemEntry(item_itr);
-						}
-						statEntry->equipped_items.push_back(std::make_pair(item, getSlotFromKeyName(slotName)));
-					}
-				}
-			}
-			const rapidjson::Value& inventory_items = d["inventory_items"];
-			for ( rapidjson::Value::ConstValueIterator itemSlot_itr = inventory_items.Begin(); itemSlot_itr != inventory_items.End(); ++itemSlot_itr )
+		// item entries roll rand() as they're read, so they're taken from the
+		// document on every spawn, in the same order as always
+		const rapidjson::Document& d = *definition.first;
+		const rapidjson::Value& equipped_items = d["equipped_items"];
+		for ( rapidjson::Value::ConstMemberIterator itemSlot_itr = equipped_items.MemberBegin(); itemSlot_itr != equipped_items.MemberEnd(); ++itemSlot_itr )
+		{
+			std::string slotName = itemSlot_itr->name.GetString();
+			if ( itemSlot_itr->value.MemberCount() > 0 )
 			{
-				if ( itemSlot_itr->IsArray() )
+				if ( itemSlot_itr->value.IsArray() )
 				{
-					std::vector<ItemEntry> itemsToChoose;
+					std::vector<std::pair<ItemEntry, int>> itemsToChoose;
 					// a selection of items in the slot. need to choose 1.
-					for ( rapidjson::Value::ConstValueIterator itemArray_itr = itemSlot_itr->Begin(); itemArray_itr != itemSlot_itr->End(); ++itemArray_itr )
+					for ( rapidjson::Value::ConstValueIterator itemArray_itr = itemSlot_itr->value.Begin(); itemArray_itr != itemSlot_itr->value.End(); ++itemArray_itr )
 					{
 						ItemEntry item;
 						for ( rapidjson::Value::ConstMemberIterator item_itr = itemArray_itr->MemberBegin(); item_itr != itemArray_itr->MemberEnd(); ++item_itr )
 						{
 							item.readKeyToItemEntry(item_itr);
 						}
-						itemsToChoose.push_back(item);
+						itemsToChoose.push_back(std::make_pair(item, getSlotFromKeyName(slotName)));
 					}
 					if ( itemsToChoose.size() > 0 )
 					{
 						std::vector<int> itemChances(itemsToChoose.size(), 0);
 						int index = 0;
-						for ( auto& i : itemsToChoose )
+						for ( auto& pair : itemsToChoose )
 						{
-							itemChances.at(index) = i.weightedChance;
+							itemChances.at(index) = pair.first.weightedChance;
 							++index;
 						}
 
 						std::discrete_distribution<> itemWeightedDistribution(itemChances.begin(), itemChances.end());
 						int result = itemWeightedDistribution(monsterStatSeed);
-						statEntry->inventory_items.push_back(itemsToChoose.at(result));
+						statEntry->equipped_items.push_back(std::make_pair(itemsToChoose.at(result).first, itemsToChoose.at(result).second));
 					}
 				}
 				else
 				{
 					ItemEntry item;
-					for ( rapidjson::Value::ConstMemberIterator item_itr = itemSlot_itr->MemberBegin(); item_itr != itemSlot_itr->MemberEnd(); ++item_itr )
+					for ( rapidjson::Value::ConstMemberIterator item_itr = itemSlot_itr->value.MemberBegin(); item_itr != itemSlot_itr->value.MemberEnd(); ++item_itr )
 					{
 						item.readKeyToItemEntry(item_itr);
 					}
-					statEntry->inventory_items.push_back(item);
-				}
-			}
-			if ( d.HasMember("followers") )
-			{
-				const rapidjson::Value& numFollowersVal = d["followers"]["num_followers"];
-				statEntry->numFollowers = numFollowersVal.GetInt();
-				const rapidjson::Value& followers = d["followers"]["follower_variants"];
-
-				statEntry->followerVariants.clear();
-				for ( rapidjson::Value::ConstMemberIterator follower_itr = followers.MemberBegin(); follower_itr != followers.MemberEnd(); ++follower_itr )
-				{
-					statEntry->followerVariants.push_back(std::make_pair(follower_itr->name.GetString(), follower_itr->value.GetInt()));
+					statEntry->equipped_items.push_back(std::make_pair(item, getSlotFromKeyName(slotName)));
 				}
 			}
-			if ( d.HasMember("properties") )
+		}
+		const rapidjson::Value& inventory_items = d["inventory_items"];
+		for ( rapidjson::Value::ConstValueIterator itemSlot_itr = inventory_items.Begin(); itemSlot_itr != inventory_items.End(); ++itemSlot_itr )
+		{
+			if ( itemSlot_itr->IsArray() )
 			{
-				if ( d["properties"].HasMember("monster_name_always_display_as_generic_species") )
-				{
-					statEntry->isMonsterNameGeneric = d["properties"]["monster_name_always_display_as_generic_species"].GetBool();
-				}
-				if ( d["properties"].HasMember("populate_empty_equipped_items_with_default") )
-				{
-					statEntry->useDefaultEquipment = d["properties"]["populate_empty_equipped_items_with_default"].GetBool();
-				}
-				if ( d["properties"].HasMember("populate_default_inventory") )
+				std::vector<ItemEntry> itemsToChoose;
+				// a selection of items in the slot. need to choose 1.
+				for ( rapidjson::Value::ConstValueIterator itemArray_itr = itemSlot_itr->Begin(); itemArray_itr != itemSlot_itr->End(); ++itemArray_itr )
 				{
-					statEntry->useDefaultInventoryItems = d["properties"]["populate_default_inventory"].GetBool();
-				}
-				if ( d["properties"].HasMember("disable_miniboss_chance") )
-				{
-					statEntry->disableMiniboss = d["properties"]["disable_miniboss_chance"].GetBool();
+					ItemEntry item;
+					for ( rapidjson::Value::ConstMemberIterator item_itr = itemArray_itr->MemberBegin(); item_itr != itemArray_itr->MemberEnd(); ++item_itr )
+					{
+						item.readKeyToItemEntry(item_itr);
+					}
+					itemsToChoose.push_back(item);
 				}
-				if ( d["properties"].HasMember("force_player_recruitable") )
+				if ( itemsToChoose.size() > 0 )
 				{
-					statEntry->forceRecruitableToPlayer = d["properties"]["force_player_recruitable"].GetBool();
+					std::vector<int> itemChances(itemsToChoose.size(), 0);
+					int index = 0;
+					for ( auto& i : itemsToChoose )
+					{
+						itemChances.at(index) = i.weightedChance;
+						++index;
+					}
+
+					std::discrete_distribution<> itemWeightedDistribution(itemChances.begin(), itemChances.end());
+					int result = itemWeightedDistribution(monsterStatSeed);
+					statEntry->inventory_items.push_back(itemsToChoose.at(result));
 				}
-				if ( d["properties"].HasMember("force_player_friendly") )
+			}
+			else
+			{
+				ItemEntry item;
+				for ( rapidjson::Value::ConstMemberIterator item_itr = itemSlot_itr->MemberBegin(); item_itr != itemSlot_itr->MemberEnd(); ++item_itr )
 				{
-					statEntry->forceFriendlyToPlayer = d["properties"]["force_player_friendly"].GetBool();
+					item.readKeyToItemEntry(item_itr);
 				}
-				if ( d["properties"].HasMember("force_player_enemy") )
+				statEntry->inventory_items.push_back(item);
+			}
+		}
+		if ( !statEntry->shopkeeperStoreTypes.empty() )
+		{
+			std::vector<int> storeChances(statEntry->shopkeeperStoreTypes.size(), 0);
+			int index = 0;
+			for ( auto& chance : storeChances )
+			{
+				chance = statEntry->shopkeeperStoreTypes.at(index).second;
+				++index;
+			}
+
+			std::discrete_distribution<> storeTypeWeightedDistribution(storeChances.begin(), storeChances.end());
+			std::string result = statEntry->shopkeeperStoreTypes.at(storeTypeWeightedDistribution(monsterStatSeed)).first;
+			index = 0;
+			for ( auto& lookup : shopkeeperTypeStrings )
+			{
+				if ( lookup.compare(result) == 0 )
 				{
-					statEntry->forceEnemyToPlayer = d["properties"]["force_player_enemy"].GetBool();
+					statEntry->chosenShopkeeperStore = index;
+					break;
 				}
-				if ( d["properties"].HasMember("disable_item_drops") )
+				++index;
+			}
+		}
+
+		++spawns;
+		spawnMs += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+		return statEntry;
+	}
+
+	int spawns = 0;
+	double spawnMs = 0.0;
+	int definitionsBuilt = 0;
+	void logStatus() const;
+private:
+	struct Definition_t
+	{
+		std::shared_ptr<const rapidjson::Document> document;
+		std::shared_ptr<const StatEntry> base;
+	};
+	std::unordered_map<std::string, Definition_t> definitions;
+
+	// the parsed document for a monster file, along with a StatEntry holding everything
+	// in it that doesn't roll (stats, proficiencies, followers, properties, shopkeeper
+	// settings). rebuilt whenever jsonFileCache hands back a different document
+	std::pair<std::shared_ptr<const rapidjson::Document>, std::shared_ptr<const StatEntry>> getDefinition(const std::string& filePath)
+	{
+		std::string inputPath;
+		auto document = jsonFileCache.getDocument(filePath, inputPath);
+		if ( !document )
+		{
+			definitions.erase(filePath);
+			return std::make_pair(nullptr, nullptr);
+		}
+		auto find = definitions.find(filePath);
+		if ( find != definitions.end() && find->second.document == document )
+		{
+			return std::make_pair(find->second.document, find->second.base);
+		}
+
+		const rapidjson::Document& d = *document;
+		if ( !d.IsObject() || !d.HasMember("version") )
+		{
+			printlog("[JSON]: Error: No 'version' value in json file, or JSON syntax incorrect! %s", inputPath.c_str());
+			definitions.erase(filePath);
+			return std::make_pair(nullptr, nullptr);
+		}
+
+		auto entry = std::make_shared<StatEntry>(0);
+		StatEntry& definition = *entry;
+		int version = d["version"].GetInt();
+		const rapidjson::Value& stats = d["stats"];
+		for ( rapidjson::Value::ConstMemberIterator stat_itr = stats.MemberBegin(); stat_itr != stats.MemberEnd(); ++stat_itr )
+		{
+			readKeyToStatEntry(definition, stat_itr);
+		}
+		const rapidjson::Value& miscStats = d["misc_stats"];
+		for ( rapidjson::Value::ConstMemberIterator stat_itr = miscStats.MemberBegin(); stat_itr != miscStats.MemberEnd(); ++stat_itr )
+		{
+			readKeyToStatEntry(definition, stat_itr);
+		}
+		const rapidjson::Value& proficiencies = d["proficiencies"];
+		for ( rapidjson::Value::ConstMemberIterator stat_itr = proficiencies.MemberBegin(); stat_itr != proficiencies.MemberEnd(); ++stat_itr )
+		{
+			readKeyToStatEntry(definition, stat_itr);
+		}
+		if ( d.HasMember("followers") )
+		{
+			const rapidjson::Value& numFollowersVal = d["followers"]["num_followers"];
+			definition.numFollowers = numFollowersVal.GetInt();
+			const rapidjson::Value& followers = d["followers"]["follower_variants"];
+
+			definition.followerVariants.clear();
+			for ( rapidjson::Value::ConstMemberIterator follower_itr = followers.MemberBegin(); follower_itr != followers.MemberEnd(); ++follower_itr )
+			{
+				definition.followerVariants.push_back(std::make_pair(follower_itr->name.GetString(), follower_itr->value.GetInt()));
+			}
+		}
+		if ( d.HasMember("properties") )
+		{
+			if ( d["properties"].HasMember("monster_name_always_display_as_generic_species") )
+			{
+				definition.isMonsterNameGeneric = d["properties"]["monster_name_always_display_as_generic_species"].GetBool();
+			}
+			if ( d["properties"].HasMember("populate_empty_equipped_items_with_default") )
+			{
+				definition.useDefaultEquipment = d["properties"]["populate_empty_equipped_items_with_default"].GetBool();
+			}
+			if ( d["properties"].HasMember("populate_default_inventory") )
+			{
+				definition.useDefaultInventoryItems = d["properties"]["populate_default_inventory"].GetBool();
+			}
+			if ( d["properties"].HasMember("disable_miniboss_chance") )
+			{
+				definition.disableMiniboss = d["properties"]["disable_miniboss_chance"].GetBool();
+			}
+			if ( d["properties"].HasMember("force_player_recruitable") )
+			{
+				definition.forceRecruitableToPlayer = d["properties"]["force_player_recruitable"].GetBool();
+			}
+			if ( d["properties"].HasMember("force_player_friendly") )
+			{
+				definition.forceFriendlyToPlayer = d["properties"]["force_player_friendly"].GetBool();
+			}
+			if ( d["properties"].HasMember("force_player_enemy") )
+			{
+				definition.forceEnemyToPlayer = d["properties"]["force_player_enemy"].GetBool();
+			}
+			if ( d["properties"].HasMember("disable_item_drops") )
+			{
+				definition.disableItemDrops = d["properties"]["disable_item_drops"].GetBool();
+			}
+			if ( d["properties"].HasMember("xp_award_percent") )
+			{
+				definition.xpAwardPercent = d["properties"]["xp_award_percent"].GetInt();
+			}
+			if ( d["properties"].HasMember("enable_casting_inventory_spellbooks") )
+			{
+				definition.castSpellbooksFromInventory = d["properties"]["enable_casting_inventory_spellbooks"].GetBool();
+			}
+			if ( d["properties"].HasMember("spellbook_cast_cooldown") )
+			{
+				definition.spellbookCastCooldown = d["properties"]["spellbook_cast_cooldown"].GetInt();
+			}
+		}
+		if ( d.HasMember("shopkeeper_properties") )
+		{
+			if ( d["shopkeeper_properties"].HasMember("store_type_chances") )
+			{
+				for ( rapidjson::Value::ConstMemberIterator types_itr = d["shopkeeper_properties"]["store_type_chances"].MemberBegin(); 
+					types_itr != d["shopkeeper_properties"]["store_type_chances"].MemberEnd(); ++types_itr )
 				{
-					statEntry->disableItemDrops = d["properties"]["disable_item_drops"].GetBool();
+					definition.shopkeeperStoreTypes.push_back(std::make_pair(types_itr->name.GetString(), types_itr->value.GetInt()));
 				}
-				if ( d["properties"].HasMember("xp_award_percent") )
+				if ( d["shopkeeper_properties"].HasMember("generate_default_shop_items") )
 				{
-					statEntry->xpAwardPercent = d["properties"]["xp_award_percent"].GetInt();
+					definition.shopkeeperGenDefaultItems = d["shopkeeper_properties"]["generate_default_shop_items"].GetBool();
 				}
-				if ( d["properties"].HasMember("enable_casting_inventory_spellbooks") )
+				if ( d["shopkeeper_properties"].HasMember("num_generated_items_min") )
 				{
-					statEntry->castSpellbooksFromInventory = d["properties"]["enable_casting_inventory_spellbooks"].GetBool();
+					definition.shopkeeperMinItems = d["shopkeeper_properties"]["num_generated_items_min"].GetInt();
 				}
-				if ( d["properties"].HasMember("spellbook_cast_cooldown") )
+				if ( d["shopkeeper_properties"].HasMember("num_generated_items_max") )
 				{
-					statEntry->spellbookCastCooldown = d["properties"]["spellbook_cast_cooldown"].GetInt();
+					definition.shopkeeperMaxItems = d["shopkeeper_properties"]["num_generated_items_max"].GetInt();
 				}
-			}
-			if ( d.HasMember("shopkeeper_properties") )
-			{
-				if ( d["shopkeeper_properties"].HasMember("store_type_chances") )
+				if ( d["shopkeeper_properties"].HasMember("generated_item_blessing_max") )
 				{
-					for ( rapidjson::Value::ConstMemberIterator types_itr = d["shopkeeper_properties"]["store_type_chances"].MemberBegin(); 
-						types_itr != d["shopkeeper_properties"]["store_type_chances"].MemberEnd(); ++types_itr )
-					{
-						statEntry->shopkeeperStoreTypes.push_back(std::make_pair(types_itr->name.GetString(), types_itr->value.GetInt()));
-					}
-					if ( !statEntry->shopkeeperStoreTypes.empty() )
-					{
-						std::vector<int> storeChances(statEntry->shopkeeperStoreTypes.size(), 0);
-						int index = 0;
-						for ( auto& chance : storeChances )
-						{
-							chance = statEntry->shopkeeperStoreTypes.at(index).second;
-							++index;
-						}
-
-						std::discrete_distribution<> storeTypeWeightedDistribution(storeChances.begin(), storeChances.end());
-						std::string result = statEntry->shopkeeperStoreTypes.at(storeTypeWeightedDistribution(monsterStatSeed)).first;
-						index = 0;
-						for ( auto& lookup : shopkeeperTypeStrings )
-						{
-							if ( lookup.compare(result) == 0 )
-							{
-								statEntry->chosenShopkeeperStore = index;
-								break;
-							}
-							++index;
-						}
-					}
-					if ( d["shopkeeper_properties"].HasMember("generate_default_shop_items") )
-					{
-						statEntry->shopkeeperGenDefaultItems = d["shopkeeper_properties"]["generate_default_shop_items"].GetBool();
-					}
-					if ( d["shopkeeper_properties"].HasMember("num_generated_items_min") )
-					{
-						statEntry->shopkeeperMinItems = d["shopkeeper_properties"]["num_generated_items_min"].GetInt();
-					}
-					if ( d["shopkeeper_properties"].HasMember("num_generated_items_max") )
-					{
-						statEntry->shopkeeperMaxItems = d["shopkeeper_properties"]["num_generated_items_max"].GetInt();
-					}
-					if ( d["shopkeeper_properties"].HasMember("generated_item_blessing_max") )
-					{
-						statEntry->shopkeeperMaxGeneratedBlessing = d["shopkeeper_properties"]["generated_item_blessing_max"].GetInt();
-					}
+					definition.shopkeeperMaxGeneratedBlessing = d["shopkeeper_properties"]["generated_item_blessing_max"].GetInt();
 				}
 			}
-			printlog("[JSON]: Successfully read json file %s", inputPath.c_str());
-			return statEntry;
 		}
-		else
-		{
-			printlog("[JSON]: Error: Could not locate json file %s", filePath.c_str());
-		}
-		return nullptr;
+
+		Definition_t& cached = definitions[filePath];
+		cached.document = document;
+		cached.base = entry;
+		++definitionsBuilt;
+		printlog("[JSON]: Successfully read json file %s", inputPath.c_str());
+		return std::make_pair(cached.document, cached.base);
 	}
 };
 extern MonsterStatCustomManager monsterStatCustomManager;
@@ -1343,6 +1433,7 @@ extern MonsterStatCustomManager monsterStatCustomManager;
 class MonsterCurveCustomManager
 {
 	bool usingCustomManager = false;
+	std::shared_ptr<const rapidjson::Document> curveDocument; // what allLevelCurves was built from
 public:
 	std::mt19937 curveSeed;
 	MonsterCurveCustomManager() :
@@ -1385,28 +1476,20 @@ public:
 
 	void readFromFile()
 	{
+		std::string inputPath;
+		auto document = jsonFileCache.getDocument("/data/monstercurve.json", inputPath);
+		if ( document && document == curveDocument )
+		{
+			// unchanged since the last floor, keep the curves
+			return;
+		}
 		allLevelCurves.clear();
 		usingCustomManager = false;
-		if ( PHYSFS_getRealDir("/data/monstercurve.json") )
+		curveDocument = document;
+		if ( document )
 		{
-			std::string inputPath = PHYSFS_getRealDir("/data/monstercurve.json");
-			inputPath.append("/data/monstercurve.json");
-
-			File* fp = FileIO::open(inputPath.c_str(), "rb");
-			if ( !fp )
-			{
-				printlog("[JSON]: Error: Could not locate json file %s", inputPath.c_str());
-				return;
-			}
-			char buf[65536];
-			int count = fp->read(buf, sizeof(buf[0]), sizeof(buf));
-			buf[count] = '\0';
-			rapidjson::StringStream is(buf);
-			FileIO::close(fp);
-
-			rapidjson::Document d;
-			d.ParseStream(is);
-			if ( !d.HasMember("version") )
+			const rapidjson::Document& d = *document;
+			if ( !d.IsObject() || !d.HasMember("version") )
 			{
 				printlog("[JSON]: Error: No 'version' value in json file, or JSON syntax incorrect! %s", inputPath.c_str());
 				return;
@@ -1507,7 +1590,7 @@ public:
 		{
 			return false;
 		}
-		for ( LevelCurve curve : allLevelCurves )
+		for ( const LevelCurve& curve : allLevelCurves )
 		{
 			if ( curve.mapName.compare(currentMap) == 0 )
 			{
@@ -1521,7 +1604,7 @@ public:
 	{
 		std::vector<int> monsterCurveChances(NUMMONSTERS, 0);
 
-		for ( LevelCurve curve : allLevelCurves )
+		for ( LevelCurve& curve : allLevelCurves )
 		{
 			if ( curve.mapName.compare(currentMap) == 0 )
 			{
@@ -2024,26 +2107,12 @@ public:
 	void readFromFile()
 	{
 		resetValues();
-		if ( PHYSFS_getRealDir("/data/gameplaymodifiers.json") )
+		std::string inputPath;
+		auto document = jsonFileCache.getDocument("/data/gameplaymodifiers.json", inputPath);
+		if ( document )
 		{
-			std::string inputPath = PHYSFS_getRealDir("/data/gameplaymodifiers.json");
-			inputPath.append("/data/gameplaymodifiers.json");
-
-			File* fp = FileIO::open(inputPath.c_str(), "rb");
-			if ( !fp )
-			{
-				printlog("[JSON]: Error: Could not locate json file %s", inputPath.c_str());
-				return;
-			}
-			char buf[65536];
-			int count = fp->read(buf, sizeof(buf[0]), sizeof(buf));
-			buf[count] = '\0';
-			rapidjson::StringStream is(buf);
-			FileIO::close(fp);
-
-			rapidjson::Document d;
-			d.ParseStream(is);
-			if ( !d.HasMember("version") )
+			const rapidjson::Document& d = *document;
+			if ( !d.IsObject() || !d.HasMember("version") )
 			{
 				printlog("[JSON]: Error: No 'version' value in json file, or JSON syntax incorrect! %s", inputPath.c_str());
 				return;
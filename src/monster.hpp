@@ -728,6 +728,98 @@ bool handleMonsterChatter(int monsterclicked, bool ringconflict, char namesays[6
 // check qty of a certain creature race alive on a map
 int numMonsterTypeAliveOnMap(Monster creature, Entity*& lastMonster);
 
+// coarse grid over map.creatures, so AI can look at nearby creatures without walking the whole list
+class CreatureIndexHandler
+{
+private:
+	static const int kCellSize = 128; // world units per cell, 8 tiles
+	static const int kGridDimension = (256 * 16) / kCellSize;
+	static const int kCellMargin = 16; // a creature pushed by something else may be a tile out of its cell until it next moves
+	static const int kMaxCreatureSize = 20; // largest sizex/sizey of a creature, the devil's
+
+	bool raceCountDirty = true;
+	Uint32 raceCountTick = 0;
+	int raceCount[NUMMONSTERS];
+	Entity* raceLastEntity[NUMMONSTERS];
+
+	list_t* getCellList(real_t x, real_t y);
+	void rebuildRaceCounts();
+	// the grid is only kept up to date by the server's game loop. clients walk map.creatures instead
+	bool useGrid() const;
+	void addAllCreatures(std::vector<Entity*>& creatures);
+	void addCellRange(std::vector<Entity*>& creatures, int x1, int y1, int x2, int y2);
+public:
+	list_t gridCreatures[kGridDimension][kGridDimension];
+
+	node_t* addEntity(Entity& entity);
+	node_t* updateEntity(Entity& entity);
+	void removeEntity(Entity& entity);
+
+	// returns every creature that may be within range of x, y. callers still do their own exact distance check.
+	std::vector<Entity*> getCreaturesWithinRange(real_t x, real_t y, real_t range);
+	// creatures within range of x, y whose bearing is within halfAngle either side of yaw, as getTargetsAroundEntity() measures it.
+	std::vector<Entity*> getCreaturesInCone(real_t x, real_t y, real_t range, real_t yaw, real_t halfAngle);
+	// every creature that may be on the tiles x1, y1 to x2, y2 inclusive. callers still check the tile.
+	std::vector<Entity*> getCreaturesOnTiles(int x1, int y1, int x2, int y2);
+	// every creature that may overlap entity, for entityInsideEntity() checks.
+	std::vector<Entity*> getCreaturesTouching(Entity& entity);
+	// number of creatures of the given race, lastMonster is set to the last one found in map.creatures order.
+	// counts are rebuilt at most once per tick, or when a creature is added or removed.
+	int getNumMonsterType(Monster creature, Entity*& lastMonster);
+	void markRaceCountsDirty() { raceCountDirty = true; }
+
+	CreatureIndexHandler()
+	{
+		for ( int i = 0; i < kGridDimension; ++i )
+		{
+			for ( int j = 0; j < kGridDimension; ++j )
+			{
+				gridCreatures[i][j].first = nullptr;
+				gridCreatures[i][j].last = nullptr;
+			}
+		}
+	};
+};
+extern CreatureIndexHandler CreatureIndex;
+
+// level of detail for monster AI. idle monsters far from every player do their target searches, looking around
+// and wander picking every few ticks instead of every tick, staggered by uid. movement (knockback) still runs every tick.
+class MonsterAILODHandler
+{
+private:
+	static const int kMaxInterval = 8;
+	static const int kMinAwarenessRange = 256; // world units, so short sighted monsters still run full rate when a player can see them
+	static const int kAwarenessMargin = 64; // world units past a monster's sight range that still count as in range
+
+	Uint32 statsTick = 0;
+	Uint32 tickThinks = 0;
+	Uint32 tickSkips = 0;
+	Uint64 totalThinks = 0;
+	Uint64 totalSkips = 0;
+	Uint32 worstTickThinks = 0;
+	Uint32 ticksCounted = 0;
+	Uint64 intervalCounts[kMaxInterval + 1];
+
+	void countTick();
+public:
+	bool enabled = true;
+
+	// 1 is full rate. anything within its sight range (plus a margin) of a player, with a target, a leader
+	// or a status that needs reacting to, or not idle, is always full rate.
+	int getThinkInterval(Entity& my, Stat& myStats);
+	// whether the monster thinks this tick, recorded in the stats. interval is set to getThinkInterval()
+	bool think(Entity& my, Stat& myStats, int& interval);
+
+	void logStatus();
+	void resetStats();
+
+	MonsterAILODHandler()
+	{
+		resetStats();
+	};
+};
+extern MonsterAILODHandler MonsterAILOD;
+
 //-----RACE SPECIFIC CONSTANTS-----
 
 //--Goatman--
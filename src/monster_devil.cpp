@@ -450,13 +450,12 @@ void devilMoveBodyparts(Entity* my, Stat* myStats, double dist)
 			case 2:
 			{
 				entity->z -= 16;
-				node_t* tempNode;
 				Entity* playertotrack = nullptr;
-				for ( tempNode = map.creatures->first; tempNode != nullptr; tempNode = tempNode->next ) //Searching for players only? Don't search full map.entities then.
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Searching for players only.
 				{
-					Entity* tempEntity = (Entity*)tempNode->element;
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
 					double lowestdist = 5000;
-					if ( tempEntity->behavior == &actPlayer )
+					if ( tempEntity )
 					{
 						double disttoplayer = entityDist(my, tempEntity);
 						if ( disttoplayer < lowestdist )
@@ -699,10 +698,9 @@ int Entity::devilGetNumMonstersInArena(Monster creature)
 	int hellArena_y0 = 15;
 	int hellArena_y1 = 49;
 	int numMonstersActiveInArena = 0;
-	node_t* tempNode;
-	for ( tempNode = map.creatures->first; tempNode != nullptr; tempNode = tempNode->next )
+	std::vector<Entity*> arenaCreatures = CreatureIndex.getCreaturesOnTiles(hellArena_x0, hellArena_y0, hellArena_x1, hellArena_y1);
+	for ( Entity* monster : arenaCreatures )
 	{
-		Entity* monster = (Entity*)tempNode->element;
 		if ( monster && monster->getMonsterTypeFromSprite() == creature )
 		{
 			if ( static_cast<int>(monster->x / 16) >= hellArena_x0 && static_cast<int>(monster->x / 16) <= hellArena_x1 )
@@ -416,13 +416,12 @@ void lichAnimate(Entity* my, double dist)
 			case 4:
 			{
 				entity->z -= 4.25;
-				node_t* tempNode;
 				Entity* playertotrack = nullptr;
-				for ( tempNode = map.creatures->first; tempNode != nullptr; tempNode = tempNode->next ) //Only searching for players, so don't search full map.entities.
+				for ( int c = 0; c < MAXPLAYERS; ++c ) //Only searching for players.
 				{
-					Entity* tempEntity = (Entity*)tempNode->element;
+					Entity* tempEntity = players[c] ? players[c]->entity : nullptr;
 					double lowestdist = 5000;
-					if ( tempEntity->behavior == &actPlayer )
+					if ( tempEntity )
 					{
 						double disttoplayer = entityDist(my, tempEntity);
 						if ( disttoplayer < lowestdist )
@@ -382,7 +382,7 @@ void scarabAnimate(Entity* my, Stat* myStats, double dist)
 						entity->skill[11] = entity->flags[INVISIBLE];
 						serverUpdateEntityBodypart(my, bodypart);
 					}
-					if ( entity->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
+					if ( my->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
 					{
 						serverUpdateEntityBodypart(my, bodypart);
 					}
@@ -483,7 +483,7 @@ void scarabAnimate(Entity* my, Stat* myStats, double dist)
 						entity->skill[11] = entity->flags[INVISIBLE];
 						serverUpdateEntityBodypart(my, bodypart);
 					}
-					if ( entity->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
+					if ( my->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
 					{
 						serverUpdateEntityBodypart(my, bodypart);
 					}
@@ -866,7 +866,7 @@ void sentryBotAnimate(Entity* my, Stat* myStats, double dist)
 				//			entity->skill[10] = entity->sprite;
 				//			serverUpdateEntityBodypart(my, bodypart);
 				//		}
-				//		if ( entity->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
+				//		if ( my->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
 				//		{
 				//			serverUpdateEntityBodypart(my, bodypart);
 				//		}
@@ -1436,7 +1436,7 @@ void gyroBotAnimate(Entity* my, Stat* myStats, double dist)
 						entity->skill[10] = entity->sprite;
 						serverUpdateEntityBodypart(my, bodypart);
 					}
-					if ( entity->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
+					if ( my->getUID() % (TICKS_PER_SECOND * 10) == ticks % (TICKS_PER_SECOND * 10) )
 					{
 						serverUpdateEntityBodypart(my, bodypart);
 					}
@@ -330,6 +330,7 @@ void Entity::actMonsterLimb(bool processLight)
 		list_RemoveNode(mynode);
 		return;
 	}
+	attachAsLimb();
 
 	//Do something magical beyond my comprehension.
 	if ( multiplayer != CLIENT )
@@ -396,6 +397,21 @@ void Entity::actMonsterLimb(bool processLight)
 	}
 }
 
+void Entity::attachAsLimb()
+{
+	if ( attachedLimb )
+	{
+		return;
+	}
+	// nothing looks limbs up by tile, collision and line traces skip them as PASSABLE
+	attachedLimb = true;
+	if ( myTileListNode )
+	{
+		list_RemoveNode(myTileListNode);
+		myTileListNode = nullptr;
+	}
+}
+
 void Entity::removeMonsterDeathNodes()
 {
 	int i = 0;
@@ -36,26 +36,22 @@
 #include "colors.hpp"
 #include "mod_tools.hpp"
 #include "lobbies.hpp"
+#include "net_simulator.hpp"
 
 NetHandler* net_handler = nullptr;
+NetTrafficStats_t NetTrafficStats;
 
 char last_ip[64] = "";
 char last_port[64] = "";
 char lobbyChatbox[LOBBY_CHATBOX_LENGTH];
 list_t lobbyChatboxMessages;
 bool disableMultithreadedSteamNetworking = true;
+bool disableDirectConnectNetworkThread = false;
 bool disableFPSLimitOnNetworkMessages = false;
 
 // uncomment this to have the game log packet info
 //#define PACKETINFO
 
-void packetDeconstructor(void* data)
-{
-	packetsend_t* packetsend = (packetsend_t*)data;
-	SDLNet_FreePacket(packetsend->packet);
-	free(data);
-}
-
 /*-------------------------------------------------------------------------------
 
 	sendPacket
@@ -64,14 +60,30 @@ void packetDeconstructor(void* data)
 	is ignored. Otherwise, the first two arguments are ignored and the packet
 	is sent with SteamNetworking()->SendP2PPacket, using the hostnum variable
 	to get the steam ID of the same player number and the first two arguments
-	are ignored.
+	are ignored. direct-connect packets are handed to the network thread to
+	send when it's running. packets go through NetSimulator first.
 
 -------------------------------------------------------------------------------*/
 
 int sendPacket(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool tryReliable)
 {
+	if ( NetSimulator.interceptOutgoing(sock, channel, packet, hostnum, tryReliable) )
+	{
+		return 1;
+	}
+	return transportSendPacket(sock, channel, packet, hostnum, tryReliable);
+}
+
+int transportSendPacket(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool tryReliable)
+{
+	++NetTrafficStats.packetsSent;
+	NetTrafficStats.bytesSent += packet->len;
 	if ( directConnect )
 	{
+		if ( net_handler && net_handler->queueOutgoingPacket(sock, channel, packet) )
+		{
+			return 1;
+		}
 		return SDLNet_UDP_Send(sock, channel, packet);
 	}
 	else
@@ -105,19 +117,17 @@ int sendPacket(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool
 	sendPacketSafe
 
 	works like sendPacket, but adds an additional layer of insurance to
-	increase the chance of a successful transmission. When STEAMWORKS is
-	undefined, the game uses its own system to increase the transmission
-	success rate of a packet. Otherwise it just sends the packet with
-	SendP2PPacket's k_EP2PSendReliable flag
+	increase the chance of a successful transmission. the packet is kept by
+	SafePacketHandler and resent until the recipient acknowledges it. When
+	using Steam, the packet is also sent with k_EP2PSendReliable
 
 -------------------------------------------------------------------------------*/
 
-Uint32 packetnum = 0;
 int sendPacketSafe(UDPsocket sock, int channel, UDPpacket* packet, int hostnum)
 {
-	if ( hostnum < 0 )
+	if ( hostnum < 0 || hostnum >= MAXPLAYERS )
 	{
-		printlog("[NET]: Error - attempt to send to negative hostnum: %d", hostnum);
+		printlog("[NET]: Error - attempt to send to invalid hostnum: %d", hostnum);
 		return 0;
 	}
 
@@ -143,67 +153,438 @@ int sendPacketSafe(UDPsocket sock, int channel, UDPpacket* packet, int hostnum)
 		}
 	}
 
-	packetsend_t* packetsend = (packetsend_t*) malloc(sizeof(packetsend_t));
-	if (!(packetsend->packet = SDLNet_AllocPacket(NET_PACKET_SIZE)))
+	return SafePacketHandler.send(sock, channel, packet, hostnum);
+}
+
+/*-------------------------------------------------------------------------------
+
+	SafePacketHandler_t
+
+	see net.hpp
+
+-------------------------------------------------------------------------------*/
+
+SafePacketHandler_t SafePacketHandler;
+const int SafePacketHandler_t::kSendWindow;
+const int SafePacketHandler_t::kReceiveWindow;
+const int SafePacketHandler_t::kAckBits;
+const Uint32 SafePacketHandler_t::kMinRTO;
+const Uint32 SafePacketHandler_t::kMaxRTO;
+const Uint32 SafePacketHandler_t::kInitialRTO;
+const int SafePacketHandler_t::kResendBudget;
+
+SafePacketHandler_t::SafePacketHandler_t()
+{
+	reset();
+}
+
+SafePacketHandler_t::~SafePacketHandler_t()
+{
+	if ( scratchPacket )
+	{
+		SDLNet_FreePacket(scratchPacket);
+		scratchPacket = nullptr;
+	}
+}
+
+void SafePacketHandler_t::resetSendPeer(SendPeer_t& peer)
+{
+	// start each stream somewhere random, so packets still in the air from an
+	// earlier session are unlikely to land in the new stream's window.
+	static Uint32 seed = static_cast<Uint32>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+	seed = seed * 1664525 + 1013904223;
+
+	for ( int i = 0; i < kSendWindow; ++i )
+	{
+		peer.ring[i].inUse = false;
+	}
+	peer.backlog.clear();
+	peer.nextSequence = seed;
+	peer.oldestSequence = seed;
+	peer.inFlight = 0;
+	peer.hasRTTSample = false;
+	peer.srtt = 0.0;
+	peer.rttvar = 0.0;
+	peer.rto = kInitialRTO;
+	peer.stats = PeerStats_t();
+}
+
+void SafePacketHandler_t::reset()
+{
+	for ( int i = 0; i < MAXPLAYERS; ++i )
+	{
+		resetSendPeer(sendPeers[i]);
+		receivePeers[i].initialized = false;
+		receivePeers[i].duplicates = 0;
+		receivePeers[i].stale = 0;
+	}
+}
+
+void SafePacketHandler_t::resetPeer(int hostnum, int peerClientnum)
+{
+	if ( hostnum >= 0 && hostnum < MAXPLAYERS )
+	{
+		resetSendPeer(sendPeers[hostnum]);
+	}
+	if ( peerClientnum >= 0 && peerClientnum < MAXPLAYERS )
+	{
+		receivePeers[peerClientnum].initialized = false;
+		receivePeers[peerClientnum].duplicates = 0;
+		receivePeers[peerClientnum].stale = 0;
+	}
+}
+
+void SafePacketHandler_t::transmit(int hostnum, PendingPacket_t& pending)
+{
+	if ( !scratchPacket )
+	{
+		if ( !(scratchPacket = SDLNet_AllocPacket(NET_PACKET_SIZE)) )
+		{
+			printlog("warning: packet allocation failed: %s\n", SDLNet_GetError());
+			return;
+		}
+	}
+	memcpy(scratchPacket->data, pending.data, pending.len);
+	scratchPacket->len = pending.len;
+	scratchPacket->channel = pending.channel;
+	scratchPacket->address.host = pending.address.host;
+	scratchPacket->address.port = pending.address.port;
+	sendPacket(pending.sock, pending.channel, scratchPacket, hostnum, true);
+}
+
+int SafePacketHandler_t::send(UDPsocket sock, int channel, UDPpacket* packet, int hostnum)
+{
+	SendPeer_t& peer = sendPeers[hostnum];
+	const int len = packet->len + 9;
+	if ( len > NET_PACKET_SIZE )
 	{
-		printlog("warning: packet allocation failed: %s\n", SDLNet_GetError());
-		free(packetsend);
+		// a truncated packet isn't the one the caller asked us to deliver
+		printlog("[NET]: Error - safe packet of %d bytes is over the %d byte limit, not sent", len, NET_PACKET_SIZE);
+		++peer.stats.rejected;
 		return 0;
 	}
 
-	packetsend->hostnum = hostnum;
-	packetsend->sock = sock;
-	packetsend->channel = channel;
-	packetsend->packet->channel = channel;
-	memcpy(packetsend->packet->data + 9, packet->data, NET_PACKET_SIZE - 9);
-	packetsend->packet->len = packet->len + 9;
-	packetsend->packet->address.host = packet->address.host;
-	packetsend->packet->address.port = packet->address.port;
-	strcpy((char*)packetsend->packet->data, "SAFE");
+	PendingPacket_t queued;
+	PendingPacket_t* pending = &queued;
+	const bool windowFull = !peer.backlog.empty() || peer.ring[peer.nextSequence % kSendWindow].inUse;
+	if ( !windowFull )
+	{
+		pending = &peer.ring[peer.nextSequence % kSendWindow];
+	}
+
+	strcpy((char*)pending->data, "SAFE");
 	if ( receivedclientnum || multiplayer != CLIENT )
 	{
-		packetsend->packet->data[4] = clientnum;
+		pending->data[4] = clientnum;
 	}
 	else
 	{
-		packetsend->packet->data[4] = MAXPLAYERS;
+		pending->data[4] = MAXPLAYERS;
+	}
+	memcpy(pending->data + 9, packet->data, len - 9);
+	pending->len = len;
+	pending->sock = sock;
+	pending->channel = channel;
+	pending->address.host = packet->address.host;
+	pending->address.port = packet->address.port;
+	++peer.stats.sent;
+
+	if ( windowFull )
+	{
+		// the slot this would take still holds an unacked packet. wait for it rather than evict it.
+		peer.backlog.push_back(queued);
+		++peer.stats.backlogged;
+		peer.stats.peakBacklog = std::max(peer.stats.peakBacklog, static_cast<int>(peer.backlog.size()));
+		return 1;
 	}
-	SDLNet_Write32(packetnum, &packetsend->packet->data[5]);
-	packetsend->num = packetnum;
-	packetsend->tries = 0;
-	packetnum++;
+	start(hostnum, *pending);
+	return 1;
+}
 
-	node_t* node = list_AddNodeFirst(&safePacketsSent);
-	node->element = packetsend;
-	node->deconstructor = &packetDeconstructor;
+void SafePacketHandler_t::start(int hostnum, PendingPacket_t& pending)
+{
+	SendPeer_t& peer = sendPeers[hostnum];
+	pending.sequence = peer.nextSequence++;
+	SDLNet_Write32(pending.sequence, &pending.data[5]);
+	pending.tries = 0;
+	pending.firstSentTime = SDL_GetTicks();
+	pending.lastSentTime = pending.firstSentTime;
+	pending.inUse = true;
+
+	++peer.inFlight;
+	peer.stats.peakInFlight = std::max(peer.stats.peakInFlight, peer.inFlight);
+	transmit(hostnum, pending);
+}
 
-	if ( directConnect )
+void SafePacketHandler_t::flushBacklog(int hostnum)
+{
+	SendPeer_t& peer = sendPeers[hostnum];
+	while ( !peer.backlog.empty() )
+	{
+		PendingPacket_t& slot = peer.ring[peer.nextSequence % kSendWindow];
+		if ( slot.inUse )
+		{
+			return;
+		}
+		slot = peer.backlog.front();
+		peer.backlog.pop_front();
+		start(hostnum, slot);
+	}
+}
+
+void SafePacketHandler_t::sampleRTT(SendPeer_t& peer, Uint32 rtt)
+{
+	// smoothed round trip time and variance as in RFC 6298
+	if ( !peer.hasRTTSample )
 	{
-		return SDLNet_UDP_Send(sock, channel, packetsend->packet);
+		peer.srtt = rtt;
+		peer.rttvar = rtt / 2.0;
+		peer.hasRTTSample = true;
 	}
 	else
 	{
-		if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
+		peer.rttvar = 0.75 * peer.rttvar + 0.25 * fabs(peer.srtt - rtt);
+		peer.srtt = 0.875 * peer.srtt + 0.125 * rtt;
+	}
+	real_t rto = peer.srtt + std::max(4.0 * peer.rttvar, 10.0);
+	peer.rto = std::min(std::max(static_cast<Uint32>(rto), kMinRTO), kMaxRTO);
+}
+
+void SafePacketHandler_t::acknowledge(int hostnum, Uint32 sequence, Uint32 now)
+{
+	SendPeer_t& peer = sendPeers[hostnum];
+	PendingPacket_t& pending = peer.ring[sequence % kSendWindow];
+	if ( !pending.inUse || pending.sequence != sequence )
+	{
+		return; // already acked or expired
+	}
+	if ( pending.tries == 0 )
+	{
+		// only time packets that were never resent, otherwise we can't tell which copy got through
+		sampleRTT(peer, now - pending.firstSentTime);
+	}
+	pending.inUse = false;
+	--peer.inFlight;
+	++peer.stats.acked;
+}
+
+bool SafePacketHandler_t::markReceived(ReceivePeer_t& peer, Uint32 sequence)
+{
+	if ( peer.initialized )
+	{
+		Sint32 diff = static_cast<Sint32>(sequence - peer.highest);
+		if ( diff > 0 )
 		{
-#ifdef STEAMWORKS
-			if ( steamIDRemote[hostnum] && !client_disconnected[hostnum] )
+			if ( diff >= kReceiveWindow )
 			{
-				return SteamNetworking()->SendP2PPacket(*static_cast<CSteamID* >(steamIDRemote[hostnum]), packetsend->packet->data, packetsend->packet->len, k_EP2PSendReliable, 0);
+				peer.received.reset();
 			}
 			else
 			{
-				return 0;
+				for ( Uint32 skipped = peer.highest + 1; skipped != sequence; ++skipped )
+				{
+					peer.received.reset(skipped % kReceiveWindow);
+				}
 			}
-#endif
+			peer.received.set(sequence % kReceiveWindow);
+			peer.highest = sequence;
+			return true;
 		}
-		else if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_CROSSPLAY )
+		if ( -diff < kReceiveWindow )
 		{
-#if defined USE_EOS
-			EOS.SendMessageP2P(EOS.P2PConnectionInfo.getPeerIdFromIndex(hostnum), packetsend->packet->data, packetsend->packet->len);
-			return 0;
-#endif
+			if ( peer.received.test(sequence % kReceiveWindow) )
+			{
+				++peer.duplicates;
+				return false;
+			}
+			peer.received.set(sequence % kReceiveWindow);
+			return true;
+		}
+		// too far behind to tell whether we've had it, so it's a very late resend
+		// of something we can no longer check. a sender starting a new stream
+		// comes with a new connection, which resets the peer with resetPeer() or reset()
+		++peer.stale;
+		return false;
+	}
+
+	peer.initialized = true;
+	peer.received.reset();
+	peer.received.set(sequence % kReceiveWindow);
+	peer.highest = sequence;
+	return true;
+}
+
+void SafePacketHandler_t::update()
+{
+	const Uint32 now = SDL_GetTicks();
+	for ( int hostnum = 0; hostnum < MAXPLAYERS; ++hostnum )
+	{
+		SendPeer_t& peer = sendPeers[hostnum];
+		flushBacklog(hostnum);
+		if ( peer.inFlight <= 0 )
+		{
+			peer.oldestSequence = peer.nextSequence;
+			continue;
+		}
+
+		// a slot is only handed to a new sequence once its packet is acked or expired,
+		// so anything more than a window behind nextSequence is finished.
+		if ( peer.nextSequence - peer.oldestSequence > static_cast<Uint32>(kSendWindow) )
+		{
+			peer.oldestSequence = peer.nextSequence - kSendWindow;
+		}
+
+		// walk from the oldest sequence in flight, skipping the front of the window as it gets acked.
+		int budget = kResendBudget;
+		bool front = true;
+		for ( Uint32 sequence = peer.oldestSequence; sequence != peer.nextSequence; ++sequence )
+		{
+			PendingPacket_t& pending = peer.ring[sequence % kSendWindow];
+			if ( !pending.inUse || pending.sequence != sequence )
+			{
+				if ( front )
+				{
+					peer.oldestSequence = sequence + 1;
+				}
+				continue;
+			}
+			front = false;
+
+			// back off exponentially on repeated timeouts
+			Uint32 timeout = std::min(peer.rto << std::min(pending.tries, 4), kMaxRTO);
+			if ( now - pending.lastSentTime < timeout )
+			{
+				continue;
+			}
+			if ( pending.tries >= MAXTRIES )
+			{
+				pending.inUse = false;
+				--peer.inFlight;
+				++peer.stats.expired;
+				continue;
+			}
+			if ( budget <= 0 )
+			{
+				break;
+			}
+			--budget;
+			++pending.tries;
+			pending.lastSentTime = now;
+			++peer.stats.resent;
+			transmit(hostnum, pending);
+		}
+	}
+}
+
+bool SafePacketHandler_t::handlePacket(UDPpacket* packet)
+{
+	// safe packet
+	if ( !strncmp((char*)packet->data, "SAFE", 4) )
+	{
+		if ( packet->data[4] != MAXPLAYERS )
+		{
+			Uint32 receivedPacketNum = SDLNet_Read32(&packet->data[5]);
+			Uint8 fromClientnum = packet->data[4];
+			if ( fromClientnum >= MAXPLAYERS )
+			{
+				return true;
+			}
+
+			ReceivePeer_t& peer = receivePeers[fromClientnum];
+			bool isNew = markReceived(peer, receivedPacketNum);
+
+			// send an ack, even for duplicates since it means our last ack was lost
+			int j = fromClientnum;
+			int c = packet->len;
+			Uint8 bytedata[NET_PACKET_SIZE];
+			memcpy(&bytedata, packet->data + 9, std::max(c - 9, 0));
+
+			packet->data[4] = clientnum;
+			strcpy((char*)packet->data, "GOTP");
+			SDLNet_Write32(receivedPacketNum, &packet->data[5]);
+			Uint32 bits = 0;
+			for ( int i = 0; i < kAckBits; ++i )
+			{
+				if ( peer.received.test((peer.highest - 1 - i) % kReceiveWindow) )
+				{
+					bits |= (1 << i);
+				}
+			}
+			SDLNet_Write32(peer.highest, &packet->data[9]);
+			SDLNet_Write32(bits, &packet->data[13]);
+			packet->len = 17;
+			if ( multiplayer == CLIENT )
+			{
+				packet->address.host = net_server.host;
+				packet->address.port = net_server.port;
+				sendPacket(net_sock, -1, packet, 0);
+			}
+			else if ( j > 0 )
+			{
+				packet->address.host = net_clients[j - 1].host;
+				packet->address.port = net_clients[j - 1].port;
+				sendPacket(net_sock, -1, packet, j - 1);
+			}
+
+			packet->len = std::max(c - 9, 0);
+			memcpy(packet->data, &bytedata, packet->len);
+			if ( !isNew )
+			{
+				return true;
+			}
+		}
+	}
+
+	// they got the safe packet
+	else if ( !strncmp((char*)packet->data, "GOTP", 4) )
+	{
+		int hostnum = (multiplayer == CLIENT) ? 0 : packet->data[4] - 1;
+		if ( hostnum < 0 || hostnum >= MAXPLAYERS )
+		{
+			return true;
+		}
+		const Uint32 now = SDL_GetTicks();
+		acknowledge(hostnum, SDLNet_Read32(&packet->data[5]), now);
+		if ( packet->len >= 17 )
+		{
+			Uint32 highest = SDLNet_Read32(&packet->data[9]);
+			Uint32 bits = SDLNet_Read32(&packet->data[13]);
+			acknowledge(hostnum, highest, now);
+			for ( int i = 0; i < kAckBits; ++i )
+			{
+				if ( bits & (1 << i) )
+				{
+					acknowledge(hostnum, highest - 1 - i, now);
+				}
+			}
+		}
+		flushBacklog(hostnum);
+		return true;
+	}
+
+	return false;
+}
+
+void SafePacketHandler_t::logStats()
+{
+	for ( int hostnum = 0; hostnum < MAXPLAYERS; ++hostnum )
+	{
+		const SendPeer_t& peer = sendPeers[hostnum];
+		if ( peer.stats.sent == 0 )
+		{
+			continue;
+		}
+		printlog("[NET]: safe packets to %d: rtt %.1fms (var %.1f), rto %dms, in flight %d (peak %d), backlog %d (peak %d), sent %d, resent %d, acked %d, expired %d, backlogged %d, rejected %d",
+			hostnum, peer.srtt, peer.rttvar, peer.rto, peer.inFlight, peer.stats.peakInFlight,
+			static_cast<int>(peer.backlog.size()), peer.stats.peakBacklog,
+			peer.stats.sent, peer.stats.resent, peer.stats.acked, peer.stats.expired, peer.stats.backlogged, peer.stats.rejected);
+	}
+	for ( int c = 0; c < MAXPLAYERS; ++c )
+	{
+		if ( receivePeers[c].initialized )
+		{
+			printlog("[NET]: safe packets from %d: highest %u, duplicates %d, stale %d", c, receivePeers[c].highest, receivePeers[c].duplicates, receivePeers[c].stale);
 		}
-		return 0;
 	}
 }
 
@@ -648,62 +1029,99 @@ void serverUpdateBodypartIDs(Entity* entity)
 
 	serverUpdateEntityBodypart
 
-	Updates the given bodypart of the given entity for all clients
+	Queues the given bodypart of the given entity to be sent to all clients.
+	serverSendPendingBodyparts() sends every bodypart of an entity queued
+	during a tick as one packet
 
 -------------------------------------------------------------------------------*/
 
-//int numPlayerBodypartUpdates = 0;
-//int numMonsterBodypartUpdates = 0;
-//Uint32 lastbodypartTick = 0;
+static std::vector<Uint32> bodypartUpdateEntities; // uids with bodypartsPendingUpdate set
 
 void serverUpdateEntityBodypart(Entity* entity, int bodypart)
 {
-	int c;
+	if ( multiplayer != SERVER || !entity )
+	{
+		return;
+	}
+	if ( bodypart < 0 || bodypart >= 32 )
+	{
+		// no creature has anywhere near this many children
+		return;
+	}
+	if ( entity->bodypartsPendingUpdate == 0 )
+	{
+		bodypartUpdateEntities.push_back(entity->getUID());
+	}
+	entity->bodypartsPendingUpdate |= (1u << bodypart);
+}
+
+/*-------------------------------------------------------------------------------
+
+	serverSendPendingBodyparts
+
+	Sends the sprite and visibility of every bodypart queued with
+	serverUpdateEntityBodypart() this tick, one packet per entity
+
+-------------------------------------------------------------------------------*/
+
+void serverSendPendingBodyparts()
+{
+	if ( bodypartUpdateEntities.empty() )
+	{
+		return;
+	}
 	if ( multiplayer != SERVER )
 	{
+		bodypartUpdateEntities.clear();
 		return;
 	}
-	for ( c = 1; c < MAXPLAYERS; c++ )
+	for ( Uint32 uid : bodypartUpdateEntities )
 	{
-		if ( client_disconnected[c] || players[c]->isLocalPlayer() )
+		Entity* entity = uidToEntity(uid);
+		if ( !entity || entity->bodypartsPendingUpdate == 0 )
 		{
 			continue;
 		}
+		const Uint32 pending = entity->bodypartsPendingUpdate;
+		entity->bodypartsPendingUpdate = 0;
+
 		strcpy((char*)net_packet->data, "ENTB");
 		SDLNet_Write32(entity->getUID(), &net_packet->data[4]);
-		net_packet->data[8] = bodypart;
-		node_t* node = list_Node(&entity->children, bodypart);
-		if ( !node )
+		int numParts = 0;
+		int len = 9;
+		int bodypart = 0;
+		for ( node_t* node = entity->children.first; node != nullptr && bodypart < 32; node = node->next, ++bodypart )
+		{
+			if ( !(pending & (1u << bodypart)) || !node->element )
+			{
+				continue;
+			}
+			Entity* tempEntity = (Entity*)node->element;
+			net_packet->data[len] = bodypart;
+			SDLNet_Write32(tempEntity->sprite, &net_packet->data[len + 1]);
+			net_packet->data[len + 5] = tempEntity->flags[INVISIBLE];
+			len += 6;
+			++numParts;
+		}
+		if ( numParts == 0 )
 		{
 			continue;
 		}
-		Entity* tempEntity = (Entity*)node->element;
-		SDLNet_Write32(tempEntity->sprite, &net_packet->data[9]);
-		net_packet->data[13] = tempEntity->flags[INVISIBLE];
-		net_packet->address.host = net_clients[c - 1].host;
-		net_packet->address.port = net_clients[c - 1].port;
-		net_packet->len = 14;
-		sendPacketSafe(net_sock, -1, net_packet, c - 1);
+		net_packet->data[8] = numParts;
+		net_packet->len = len;
+
+		for ( int c = 1; c < MAXPLAYERS; c++ )
+		{
+			if ( client_disconnected[c] || players[c]->isLocalPlayer() )
+			{
+				continue;
+			}
+			net_packet->address.host = net_clients[c - 1].host;
+			net_packet->address.port = net_clients[c - 1].port;
+			sendPacketSafe(net_sock, -1, net_packet, c - 1);
+		}
 	}
-	//if ( entity->behavior == &actPlayer )
-	//{
-	//	++numPlayerBodypartUpdates;
-	//}
-	//else if ( entity->behavior == &actMonster )
-	//{
-	//	++numMonsterBodypartUpdates;
-	//}
-	//if ( lastbodypartTick == 0 )
-	//{
-	//	lastbodypartTick = ticks;
-	//}
-	//if ( ticks - lastbodypartTick >= 250 )
-	//{
-	//	messagePlayer(0, "Bodypart updates (%ds) players: %d, monster: %d", (ticks - lastbodypartTick) / 50, numPlayerBodypartUpdates, numMonsterBodypartUpdates);
-	//	lastbodypartTick = 0;
-	//	numMonsterBodypartUpdates = 0;
-	//	numPlayerBodypartUpdates = 0;
-	//}
+	bodypartUpdateEntities.clear();
 }
 
 /*-------------------------------------------------------------------------------
@@ -1502,6 +1920,7 @@ NetworkingLobbyJoinRequestResult lobbyPlayerJoinRequest(int& outResult)
 		stats[c]->playerRace = (raceAndAppearance & 0xFF);
 		net_clients[c - 1].host = net_packet->address.host;
 		net_clients[c - 1].port = net_packet->address.port;
+		SafePacketHandler.resetPeer(c - 1, c); // forget anything left over from whoever had this slot before
 		if ( directConnect )
 		{
 			while ( (net_tcpclients[c - 1] = SDLNet_TCP_Accept(net_tcpsock)) == NULL );
@@ -2045,13 +2464,18 @@ void clientHandlePacket()
 		Entity *entity = uidToEntity((int)SDLNet_Read32(&net_packet->data[4]));
 		if ( entity )
 		{
-			node_t* childNode = list_Node(&entity->children, net_packet->data[8]);
-			if ( childNode )
+			const int numParts = net_packet->data[8];
+			for ( int i = 0; i < numParts && 9 + i * 6 + 6 <= net_packet->len; ++i )
 			{
-				Entity* tempEntity = (Entity*)childNode->element;
-				tempEntity->sprite = SDLNet_Read32(&net_packet->data[9]);
-				tempEntity->skill[7] = tempEntity->sprite;
-				tempEntity->flags[INVISIBLE] = net_packet->data[13];
+				const Uint8* part = &net_packet->data[9 + i * 6];
+				node_t* childNode = list_Node(&entity->children, part[0]);
+				if ( childNode )
+				{
+					Entity* tempEntity = (Entity*)childNode->element;
+					tempEntity->sprite = SDLNet_Read32(&part[1]);
+					tempEntity->skill[7] = tempEntity->sprite;
+					tempEntity->flags[INVISIBLE] = part[5];
+				}
 			}
 		}
 		return;
@@ -3287,6 +3711,7 @@ void clientHandlePacket()
 				}
 			}
 		}
+		stats[clientnum]->invalidateDerivedStats();
 		return;
 	}
 
@@ -3894,6 +4319,7 @@ void clientHandlePacket()
 		{
 			stats[clientnum]->mask->beatitude++;
 		}
+		stats[clientnum]->invalidateDerivedStats();
 		return;
 	}
 
@@ -3966,6 +4392,7 @@ void clientHandlePacket()
 			default:
 				break;
 		}
+		stats[clientnum]->invalidateDerivedStats();
 		return;
 	}
 
@@ -4398,30 +4825,33 @@ void clientHandlePacket()
 
 void clientHandleMessages(Uint32 framerateBreakInterval)
 {
-#ifdef STEAMWORKS
-	if (!directConnect && !net_handler)
+	NetSimulator.update();
+
+	if ( !net_handler )
 	{
 		net_handler = new NetHandler();
-		if ( !disableMultithreadedSteamNetworking )
+		if ( directConnect ? !disableDirectConnectNetworkThread : !disableMultithreadedSteamNetworking )
 		{
 			net_handler->initializeMultithreadedPacketHandling();
 		}
 	}
-#elif defined USE_EOS
-	if ( !directConnect && !net_handler )
+
+	// when the transport isn't threaded, poll it here on the game thread.
+	if ( directConnect )
 	{
-		net_handler = new NetHandler();
+		if ( !net_handler->isThreaded() )
+		{
+			directConnectReceivePackets(*net_handler, net_sock);
+		}
 	}
-#endif
-
-	if (!directConnect)
+	else
 	{
 #if defined(STEAMWORKS) || defined(USE_EOS)
 		if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 		{
 #ifdef STEAMWORKS
 			//Steam stuff goes here.
-			if ( disableMultithreadedSteamNetworking )
+			if ( !net_handler->isThreaded() )
 			{
 				steamPacketThread(static_cast<void*>(net_handler));
 			}
@@ -4433,53 +4863,32 @@ void clientHandleMessages(Uint32 framerateBreakInterval)
 			EOSPacketThread(static_cast<void*>(net_handler));
 #endif
 		}
-		SteamPacketWrapper* packet = nullptr;
+#endif
+	}
+
+	if ( logCheckMainLoopTimers )
+	{
+		DebugStats.messagesT1 = std::chrono::high_resolution_clock::now();
+		DebugStats.handlePacketStartLoop = true;
+	}
+
+	while ( net_handler->getGamePacket(net_packet) )
+	{
+		clientHandlePacket(); //Uses net_packet.
 
 		if ( logCheckMainLoopTimers )
 		{
-			DebugStats.messagesT1 = std::chrono::high_resolution_clock::now();
-			DebugStats.handlePacketStartLoop = true;
+			DebugStats.messagesT2WhileLoop = std::chrono::high_resolution_clock::now();
+			DebugStats.handlePacketStartLoop = false;
 		}
 
-		while (packet = net_handler->getGamePacket())
+		if ( !disableFPSLimitOnNetworkMessages && !frameRateLimit(framerateBreakInterval, false) )
 		{
-			memcpy(net_packet->data, packet->data(), packet->len());
-			net_packet->len = packet->len();
-
-			clientHandlePacket(); //Uses net_packet.
-
 			if ( logCheckMainLoopTimers )
 			{
-				DebugStats.messagesT2WhileLoop = std::chrono::high_resolution_clock::now();
-				DebugStats.handlePacketStartLoop = false;
-			}
-			delete packet;
-
-			if ( !disableFPSLimitOnNetworkMessages && !frameRateLimit(framerateBreakInterval, false) )
-			{
-				if ( logCheckMainLoopTimers )
-				{
-					printlog("[NETWORK]: Incoming messages exceeded given cycle time, packets remaining: %d", net_handler->game_packets.size());
-				}
-				break;
-			}
-		}
-#endif
-	}
-	else
-	{
-		//Direct-connect goes here.
-
-		// receive packets from server
-		while (SDLNet_UDP_Recv(net_sock, net_packet))
-		{
-			// filter out broken packets
-			if ( !net_packet->data[0] )
-			{
-				continue;
+				printlog("[NETWORK]: Incoming messages exceeded given cycle time, packets remaining: %d", net_handler->incomingPackets.size());
 			}
-
-			clientHandlePacket();
+			break;
 		}
 	}
 }
@@ -5334,6 +5743,7 @@ void serverHandlePacket()
 		if ( item != nullptr )
 		{
 			item->beatitude = 0;
+			stats[player]->invalidateDerivedStats();
 		}
 		return;
 	}
@@ -5436,6 +5846,7 @@ void serverHandlePacket()
 		}
 
 		equipment->beatitude = net_packet->data[6] - 100; // we sent the data beatitude + 100
+		stats[player]->invalidateDerivedStats();
 		//messagePlayer(0, "%d", equipment->beatitude);
 		return;
 	}
@@ -5619,30 +6030,33 @@ void serverHandlePacket()
 
 void serverHandleMessages(Uint32 framerateBreakInterval)
 {
-#ifdef STEAMWORKS
-	if (!directConnect && !net_handler)
+	NetSimulator.update();
+
+	if ( !net_handler )
 	{
 		net_handler = new NetHandler();
-		if ( !disableMultithreadedSteamNetworking )
+		if ( directConnect ? !disableDirectConnectNetworkThread : !disableMultithreadedSteamNetworking )
 		{
 			net_handler->initializeMultithreadedPacketHandling();
 		}
 	}
-#elif defined USE_EOS
-	if ( !directConnect && !net_handler )
+
+	// when the transport isn't threaded, poll it here on the game thread.
+	if ( directConnect )
 	{
-		net_handler = new NetHandler();
+		if ( !net_handler->isThreaded() )
+		{
+			directConnectReceivePackets(*net_handler, net_sock);
+		}
 	}
-#endif
-
-	if (!directConnect)
+	else
 	{
 #if defined(STEAMWORKS) || defined(USE_EOS)
 		if ( LobbyHandler.getP2PType() == LobbyHandler_t::LobbyServiceType::LOBBY_STEAM )
 		{
 #ifdef STEAMWORKS
 			//Steam stuff goes here.
-			if ( disableMultithreadedSteamNetworking )
+			if ( !net_handler->isThreaded() )
 			{
 				steamPacketThread(static_cast<void*>(net_handler));
 			}
@@ -5652,54 +6066,34 @@ void serverHandleMessages(Uint32 framerateBreakInterval)
 		{
 #if defined USE_EOS
 			EOSPacketThread(static_cast<void*>(net_handler));
-#endif // USE_EOS
+#endif
 		}
-		SteamPacketWrapper* packet = nullptr;
+#endif
+	}
+
+	if ( logCheckMainLoopTimers )
+	{
+		DebugStats.messagesT1 = std::chrono::high_resolution_clock::now();
+		DebugStats.handlePacketStartLoop = true;
+	}
+
+	while ( net_handler->getGamePacket(net_packet) )
+	{
+		serverHandlePacket(); //Uses net_packet.
 
 		if ( logCheckMainLoopTimers )
 		{
-			DebugStats.messagesT1 = std::chrono::high_resolution_clock::now();
-			DebugStats.handlePacketStartLoop = true;
+			DebugStats.messagesT2WhileLoop = std::chrono::high_resolution_clock::now();
+			DebugStats.handlePacketStartLoop = false;
 		}
 
-		while (packet = net_handler->getGamePacket())
+		if ( !disableFPSLimitOnNetworkMessages && !frameRateLimit(framerateBreakInterval, false) )
 		{
-			memcpy(net_packet->data, packet->data(), packet->len());
-			net_packet->len = packet->len();
-
-			serverHandlePacket(); //Uses net_packet;
-
 			if ( logCheckMainLoopTimers )
 			{
-				DebugStats.messagesT2WhileLoop = std::chrono::high_resolution_clock::now();
-				DebugStats.handlePacketStartLoop = false;
-			}
-			delete packet;
-
-			if ( !disableFPSLimitOnNetworkMessages && !frameRateLimit(framerateBreakInterval, false) )
-			{
-				if ( logCheckMainLoopTimers )
-				{
-					printlog("[NETWORK]: Incoming messages exceeded given cycle time, packets remaining: %d", net_handler->game_packets.size());
-				}
-				break;
-			}
-		}
-#endif
-	}
-	else
-	{
-		//Direct-connect goes here.
-
-		while (SDLNet_UDP_Recv(net_sock, net_packet))
-		{
-			// filter out broken packets
-			if ( !net_packet->data[0] )
-			{
-				continue;
+				printlog("[NETWORK]: Incoming messages exceeded given cycle time, packets remaining: %d", net_handler->incomingPackets.size());
 			}
-
-			serverHandlePacket(); //Uses net_packet.
+			break;
 		}
 	}
 }
@@ -5715,128 +6109,7 @@ void serverHandleMessages(Uint32 framerateBreakInterval)
 
 bool handleSafePacket()
 {
-	node_t* node;
-	int c, j;
-
-	// safe packet
-	if (!strncmp((char*)net_packet->data, "SAFE", 4))
-	{
-		if ( net_packet->data[4] != MAXPLAYERS )
-		{
-			int receivedPacketNum = SDLNet_Read32(&net_packet->data[5]);
-			Uint8 fromClientnum = net_packet->data[4];
-
-			if ( ticks > (60 * TICKS_PER_SECOND) && (ticks % (TICKS_PER_SECOND / 2) == 0) )
-			{
-				// clear old packets > 60 secs
-				for ( auto it = safePacketsReceivedMap[fromClientnum].begin(); it != safePacketsReceivedMap[fromClientnum].end(); )
-				{
-					if ( it->second < (ticks - 60 * TICKS_PER_SECOND) )
-					{
-						it = safePacketsReceivedMap[fromClientnum].erase(it);
-					}
-					else
-					{
-						++it;
-					}
-				}
-			}
-
-			//auto tmp1 = std::chrono::high_resolution_clock::now();
-			auto find = safePacketsReceivedMap[fromClientnum].find(receivedPacketNum);
-			if ( find != safePacketsReceivedMap[fromClientnum].end() )
-			{
-				return true;
-			}
-
-			/*auto tmp2 = std::chrono::high_resolution_clock::now();
-			std::chrono::duration<double> time_span =
-				std::chrono::duration_cast<std::chrono::duration<double>>(tmp2 - tmp1);
-			double timer = time_span.count() * 1000;*/
-
-			safePacketsReceivedMap[fromClientnum].insert(std::make_pair(receivedPacketNum, ticks));
-
-			// send an ack
-			j = net_packet->data[4];
-			net_packet->data[4] = clientnum;
-			strcpy((char*)net_packet->data, "GOTP");
-			if ( multiplayer == CLIENT )
-			{
-				net_packet->address.host = net_server.host;
-				net_packet->address.port = net_server.port;
-			}
-			else
-			{
-				if ( j > 0 )
-				{
-					net_packet->address.host = net_clients[j - 1].host;
-					net_packet->address.port = net_clients[j - 1].port;
-				}
-			}
-			c = net_packet->len;
-			net_packet->len = 9;
-			if ( multiplayer == CLIENT )
-			{
-				sendPacket(net_sock, -1, net_packet, 0);
-			}
-			else
-			{
-				if ( j > 0 )
-				{
-					sendPacket(net_sock, -1, net_packet, j - 1);
-				}
-			}
-			net_packet->len = c - 9;
-			Uint8 bytedata[NET_PACKET_SIZE];
-			memcpy(&bytedata, net_packet->data + 9, net_packet->len);
-			memcpy(net_packet->data, &bytedata, net_packet->len);
-
-			/*int sprite = -9999;
-			char chr[5];
-			chr[0] = '\0';
-			strncpy(chr, (char*)net_packet->data, 4);
-			chr[4] = '\0';
-			if ( !strncmp((char*)net_packet->data, "ENTU", 4) )
-			{
-				Entity *entity = uidToEntity((int)SDLNet_Read32(&net_packet->data[4]));
-				if ( entity )
-				{
-					sprite = entity->sprite;
-				}
-			}
-
-			if ( !strncmp((char*)net_packet->data, "ENTS", 4) )
-			{
-				Entity *entity = uidToEntity((int)SDLNet_Read32(&net_packet->data[4]));
-				if ( entity )
-				{
-					messagePlayer(clientnum, "%s | %d : %d - %d | %d %.8f", chr, entity->sprite, net_packet->data[8],
-						SDLNet_Read32(&net_packet->data[9]), safePacketsReceivedMap[fromClientnum].size(), timer);
-				}
-			}
-			else
-			{
-				messagePlayer(clientnum, "%s | %d %.8f", chr, safePacketsReceivedMap[fromClientnum].size(), timer);
-			}*/
-		}
-	}
-
-	// they got the safe packet
-	else if (!strncmp((char*)net_packet->data, "GOTP", 4))
-	{
-		for ( node = safePacketsSent.first; node != NULL; node = node->next )
-		{
-			packetsend_t* packet = (packetsend_t*)node->element;
-			if ( packet->num == SDLNet_Read32(&net_packet->data[5]) )
-			{
-				list_RemoveNode(node);
-				break;
-			}
-		}
-		return true;
-	}
-
-	return false;
+	return SafePacketHandler.handlePacket(net_packet);
 }
 
 /*-------------------------------------------------------------------------------
@@ -5850,6 +6123,7 @@ bool handleSafePacket()
 void closeNetworkInterfaces()
 {
 	printlog("closing network interfaces...\n");
+	NetSimulator.clear();
 
 	if (net_handler)
 	{
@@ -5902,104 +6176,139 @@ void closeNetworkInterfaces()
 
 /* ***** MULTITHREADED STEAM PACKET HANDLING ***** */
 
-SteamPacketWrapper::SteamPacketWrapper(Uint8* data, int len)
+NetPacketRing::NetPacketRing(Uint32 capacity) :
+	head(0),
+	tail(0)
 {
-	_data = data;
-	_len = len;
+	Uint32 size = 1;
+	while ( size < capacity )
+	{
+		size <<= 1;
+	}
+	slots.resize(size);
+	mask = size - 1;
 }
 
-SteamPacketWrapper::~SteamPacketWrapper()
+NetPacketRing::Slot* NetPacketRing::beginWrite()
 {
-	free(_data);
+	const Uint32 h = head.load(std::memory_order_relaxed);
+	if ( h - tail.load(std::memory_order_acquire) > mask )
+	{
+		return nullptr;
+	}
+	return &slots[h & mask];
 }
 
-Uint8*& SteamPacketWrapper::data()
+void NetPacketRing::commitWrite()
 {
-	return _data;
+	head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
 }
 
-int& SteamPacketWrapper::len()
+NetPacketRing::Slot* NetPacketRing::beginRead(Uint32 offset)
 {
-	return _len;
+	const Uint32 t = tail.load(std::memory_order_relaxed);
+	if ( head.load(std::memory_order_acquire) - t <= offset )
+	{
+		return nullptr;
+	}
+	return &slots[(t + offset) & mask];
 }
 
-NetHandler::NetHandler()
+void NetPacketRing::commitRead(Uint32 count)
 {
-	steam_packet_thread = nullptr;
+	tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+Uint32 NetPacketRing::size() const
+{
+	return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+const Uint32 NetHandler::kIncomingPackets;
+const Uint32 NetHandler::kOutgoingPackets;
+const int NetHandler::kSendBatch;
+
+NetHandler::NetHandler() :
+	incomingPackets(kIncomingPackets),
+	outgoingPackets(kOutgoingPackets),
+	outgoingOverflows(0)
+{
+	packet_thread = nullptr;
 	continue_multithreading_steam_packets = false;
-	game_packets_lock = SDL_CreateMutex();
+	directConnectSocket = nullptr;
 	continue_multithreading_steam_packets_lock = SDL_CreateMutex();
 }
 
 NetHandler::~NetHandler()
 {
 	//First, must join with the worker thread.
-	printlog("Waiting for steam_packet_thread to finish...");
+	printlog("Waiting for packet_thread to finish...");
 	stopMultithreadedPacketHandling();
-	if ( steam_packet_thread )
+	if ( packet_thread )
 	{
-		SDL_WaitThread(steam_packet_thread, NULL); //Wait for the thread to finish.
+		SDL_WaitThread(packet_thread, NULL); //Wait for the thread to finish.
+		packet_thread = nullptr;
 	}
 	printlog("Done.\n");
 
-	SDL_DestroyMutex(game_packets_lock);
-	game_packets_lock = nullptr;
 	SDL_DestroyMutex(continue_multithreading_steam_packets_lock);
 	continue_multithreading_steam_packets_lock = nullptr;
-
-	//Free up packet memory.
-	while (!game_packets.empty())
-	{
-		SteamPacketWrapper* packet = game_packets.front();
-		delete packet;
-		game_packets.pop();
-	}
 }
 
 void NetHandler::toggleMultithreading(bool disableMultithreading)
 {
+	if ( directConnect )
+	{
+		return; // steam setting, direct-connect uses disableDirectConnectNetworkThread
+	}
 	if ( disableMultithreading )
 	{
 		// stop the old thread...
-		if ( steam_packet_thread )
+		if ( packet_thread )
 		{
-			printlog("Waiting for steam_packet_thread to finish...");
+			printlog("Waiting for packet_thread to finish...");
 			stopMultithreadedPacketHandling();
-			if ( steam_packet_thread )
-			{
-				SDL_WaitThread(steam_packet_thread, NULL); //Wait for the thread to finish.
-			}
+			SDL_WaitThread(packet_thread, NULL); //Wait for the thread to finish.
 			printlog("Done.\n");
-			SDL_DestroyMutex(game_packets_lock);
-			game_packets_lock = nullptr;
-			SDL_DestroyMutex(continue_multithreading_steam_packets_lock);
-			continue_multithreading_steam_packets_lock = nullptr;
-			steam_packet_thread = nullptr;
+			packet_thread = nullptr;
 		}
 	}
-	else
+	else if ( !packet_thread )
 	{
 		// create the new thread...
-		steam_packet_thread = nullptr;
-		continue_multithreading_steam_packets = false;
-		game_packets_lock = SDL_CreateMutex();
-		continue_multithreading_steam_packets_lock = SDL_CreateMutex();
 		initializeMultithreadedPacketHandling();
 	}
 }
 
 void NetHandler::initializeMultithreadedPacketHandling()
 {
+	if ( directConnect )
+	{
+		printlog("Initializing direct-connect network thread.");
+		startDirectConnectThread(net_sock);
+		return;
+	}
 #ifdef STEAMWORKS
 
 	printlog("Initializing multithreaded packet handling.");
 
-	steam_packet_thread = SDL_CreateThread(steamPacketThread, "steamPacketThread", static_cast<void* >(this));
 	continue_multithreading_steam_packets = true;
+	packet_thread = SDL_CreateThread(steamPacketThread, "steamPacketThread", static_cast<void* >(this));
 
 #endif
 }
 
+void NetHandler::startDirectConnectThread(UDPsocket sock)
+{
+	directConnectSocket = sock;
+	continue_multithreading_steam_packets = true;
+	packet_thread = SDL_CreateThread(directConnectPacketThread, "directConnectPacketThread", static_cast<void* >(this));
+	if ( !packet_thread )
+	{
+		printlog("[NET]: Warning - failed to create network thread: %s", SDL_GetError());
+	}
+}
+
 void NetHandler::stopMultithreadedPacketHandling()
 {
 	SDL_LockMutex(continue_multithreading_steam_packets_lock); //NOTE: Will block.
@@ -6013,42 +6322,192 @@ bool NetHandler::getContinueMultithreadingSteamPackets()
 	//SDL_UnlockMutex(continue_multithreading_steam_packets_lock);
 }
 
-void NetHandler::addGamePacket(SteamPacketWrapper* packet)
+bool NetHandler::getGamePacket(UDPpacket* packet)
 {
-	if ( !disableMultithreadedSteamNetworking )
+	if ( NetSimulator.filteringIncoming() )
 	{
-		SDL_LockMutex(game_packets_lock);
-		game_packets.push(packet);
-		SDL_UnlockMutex(game_packets_lock);
+		// everything that has arrived waits in the simulator until it's due
+		while ( readIncomingPacket(packet) )
+		{
+			NetSimulator.interceptIncoming(packet);
+		}
+		if ( !NetSimulator.getIncoming(packet) )
+		{
+			return false;
+		}
 	}
-	else
+	else if ( !readIncomingPacket(packet) )
+	{
+		return false;
+	}
+	NetSimulator.recordIncoming(packet);
+	return true;
+}
+
+bool NetHandler::readIncomingPacket(UDPpacket* packet)
+{
+	NetPacketRing::Slot* slot = incomingPackets.beginRead();
+	if ( !slot )
+	{
+		return false;
+	}
+	memcpy(packet->data, slot->data, slot->len);
+	packet->len = slot->len;
+	packet->address.host = slot->address.host;
+	packet->address.port = slot->address.port;
+	incomingPackets.commitRead();
+	++NetTrafficStats.packetsReceived;
+	NetTrafficStats.bytesReceived += packet->len;
+	return true;
+}
+
+bool NetHandler::queueOutgoingPacket(UDPsocket sock, int channel, UDPpacket* packet)
+{
+	if ( !packet_thread || sock != directConnectSocket || packet->len > NET_PACKET_SIZE )
 	{
-		game_packets.push(packet);
+		return false;
 	}
+	NetPacketRing::Slot* slot = outgoingPackets.beginWrite();
+	if ( !slot )
+	{
+		++outgoingOverflows;
+		return false;
+	}
+	memcpy(slot->data, packet->data, packet->len);
+	slot->len = packet->len;
+	slot->channel = channel;
+	slot->address.host = packet->address.host;
+	slot->address.port = packet->address.port;
+	outgoingPackets.commitWrite();
+	return true;
 }
 
-SteamPacketWrapper* NetHandler::getGamePacket()
+void NetHandler::flushOutgoingPackets()
 {
-	SteamPacketWrapper* packet = nullptr;
-	if ( !disableMultithreadedSteamNetworking )
+	UDPpacket batch[kSendBatch];
+	UDPpacket* batchPointers[kSendBatch];
+	NetPacketRing::Slot* slot;
+	int num = 0;
+	while ( (slot = outgoingPackets.beginRead(num)) )
 	{
-		SDL_LockMutex(game_packets_lock);
-		if (!game_packets.empty())
+		// point the packet at the slot rather than copying out of it,
+		// the slots are only released once the whole batch is sent.
+		batch[num].channel = slot->channel;
+		batch[num].data = slot->data;
+		batch[num].len = slot->len;
+		batch[num].maxlen = NET_PACKET_SIZE;
+		batch[num].status = 0;
+		batch[num].address = slot->address;
+		batchPointers[num] = &batch[num];
+		if ( ++num == kSendBatch )
 		{
-			packet = game_packets.front();
-			game_packets.pop();
+			SDLNet_UDP_SendV(directConnectSocket, batchPointers, num);
+			outgoingPackets.commitRead(num);
+			num = 0;
 		}
-		SDL_UnlockMutex(game_packets_lock);
 	}
-	else
+	if ( num > 0 )
+	{
+		SDLNet_UDP_SendV(directConnectSocket, batchPointers, num);
+		outgoingPackets.commitRead(num);
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	directConnectReceivePackets
+
+	reads everything available on the socket straight into the incoming ring.
+	called from directConnectPacketThread, or from the game thread when the
+	network thread is disabled.
+
+-------------------------------------------------------------------------------*/
+
+void directConnectReceivePackets(NetHandler& handler, UDPsocket sock)
+{
+	NetPacketRing::Slot* slot;
+	while ( (slot = handler.incomingPackets.beginWrite()) )
 	{
-		if ( !game_packets.empty() )
+		UDPpacket packet;
+		packet.channel = -1;
+		packet.data = slot->data;
+		packet.len = 0;
+		packet.maxlen = NET_PACKET_SIZE;
+		packet.status = 0;
+		if ( SDLNet_UDP_Recv(sock, &packet) <= 0 )
 		{
-			packet = game_packets.front();
-			game_packets.pop();
+			break;
 		}
+		// filter out broken packets
+		if ( !packet.data[0] )
+		{
+			continue;
+		}
+		slot->len = packet.len;
+		slot->channel = packet.channel;
+		slot->address = packet.address;
+		handler.incomingPackets.commitWrite();
 	}
-	return packet;
+}
+
+/*-------------------------------------------------------------------------------
+
+	directConnectPacketThread
+
+	io loop for direct-connect games. waits on the socket, receives, then
+	sends whatever the game thread queued. if the incoming ring is full,
+	packets are left in the socket's buffer until the game thread catches up.
+
+-------------------------------------------------------------------------------*/
+
+int directConnectPacketThread(void* data)
+{
+	if ( !data )
+	{
+		return -1;
+	}
+
+	NetHandler& handler = *static_cast<NetHandler*>(data);
+	UDPsocket sock = handler.directConnectSocket;
+	if ( !sock )
+	{
+		return -1;
+	}
+	SDLNet_SocketSet set = SDLNet_AllocSocketSet(1);
+	if ( set )
+	{
+		SDLNet_UDP_AddSocket(set, sock);
+	}
+
+	bool run = true;
+	while ( run )
+	{
+		if ( set )
+		{
+			SDLNet_CheckSockets(set, 1);
+		}
+		else
+		{
+			SDL_Delay(1);
+		}
+
+		directConnectReceivePackets(handler, sock);
+		handler.flushOutgoingPackets();
+		if ( !handler.incomingPackets.beginWrite() )
+		{
+			SDL_Delay(1); // game thread is behind, don't spin on a readable socket
+		}
+
+		SDL_LockMutex(handler.continue_multithreading_steam_packets_lock);
+		run = handler.getContinueMultithreadingSteamPackets();
+		SDL_UnlockMutex(handler.continue_multithreading_steam_packets_lock);
+	}
+
+	if ( set )
+	{
+		SDLNet_FreeSocketSet(set);
+	}
+	return 0;
 }
 
 int EOSPacketThread(void* data)
@@ -6068,50 +6527,25 @@ int EOSPacketThread(void* data)
 	NetHandler& handler = *static_cast<NetHandler*>(data); //Basically, our this.
 	EOS_ProductUserId remoteId = nullptr;
 	Uint32 packetlen = 0;
-	Uint32 bytes_read = 0;
-	Uint8* packet = nullptr;
 	bool run = true;
-	std::queue<SteamPacketWrapper* > packets; //TODO: Expose to game? Use lock-free packets?
 
 	while ( run )   //1. Check if thread is supposed to be running.
 	{
 		//2. Game not over. Grab/poll for packet.
-
-		//while (handler.getContinueMultithreadingSteamPackets() && SteamNetworking()->IsP2PPacketAvailable(&packetlen)) //Burst read in a bunch of packets.
-		while (EOS.HandleReceivedMessages(&remoteId) )
+		NetPacketRing::Slot* slot = nullptr;
+		while ( (slot = handler.incomingPackets.beginWrite()) && EOS.HandleReceivedMessages(&remoteId) )
 		{
 			packetlen = std::min<uint32_t>(net_packet->len, NET_PACKET_SIZE - 1);
-			//Read packets and push into queue.
-			packet = static_cast<Uint8*>(malloc(packetlen));
-			memcpy(packet, net_packet->data, packetlen);
 			if ( !EOSFuncs::Helpers_t::isMatchingProductIds(remoteId, EOS.CurrentUserInfo.getProductUserIdHandle())
 				&& net_packet->data[0] )
 			{
-				//Push packet into queue.
-				//TODO: Use lock-free queues?
-				packets.push(new SteamPacketWrapper(packet, packetlen));
-				packet = nullptr;
-			}
-			if ( packet )
-			{
-				free(packet);
+				//Push packet into the ring.
+				memcpy(slot->data, net_packet->data, packetlen);
+				slot->len = packetlen;
+				handler.incomingPackets.commitWrite();
 			}
 		}
 
-
-		//3. Now push our local packetstack onto the game's network stack.
-		//Well, that is: analyze packet.
-		//If packet is good, push into queue.
-		//If packet is bad, loop back to start of function.
-
-		while ( !packets.empty() )
-		{
-			//Copy over the packets read in so far, and expose them to the game.
-			SteamPacketWrapper* packet = packets.front();
-			packets.pop();
-			handler.addGamePacket(packet);
-		}
-
 		run = false; // only run thread once if multithreading disabled.
 	}
 #endif // USE_EOS
@@ -6133,49 +6567,25 @@ int steamPacketThread(void* data)
 	Uint32 packetlen = 0;
 	Uint32 bytes_read = 0;
 	CSteamID steam_id_remote;
-	Uint8* packet = nullptr;
 	CSteamID mySteamID = SteamUser()->GetSteamID();
 	bool run = true;
-	std::queue<SteamPacketWrapper* > packets; //TODO: Expose to game? Use lock-free packets?
 
 	while (run)   //1. Check if thread is supposed to be running.
 	{
 		//2. Game not over. Grab/poll for packet.
-
-		//while (handler.getContinueMultithreadingSteamPackets() && SteamNetworking()->IsP2PPacketAvailable(&packetlen)) //Burst read in a bunch of packets.
-		while (SteamNetworking()->IsP2PPacketAvailable(&packetlen))
+		//Read straight into the ring, if it's full the rest wait in steam's queue.
+		NetPacketRing::Slot* slot = nullptr;
+		while ((slot = handler.incomingPackets.beginWrite()) && SteamNetworking()->IsP2PPacketAvailable(&packetlen))
 		{
 			packetlen = std::min<uint32_t>(packetlen, NET_PACKET_SIZE - 1);
-			//Read packets and push into queue.
-			packet = static_cast<Uint8* >(malloc(packetlen));
-			if (SteamNetworking()->ReadP2PPacket(packet, packetlen, &bytes_read, &steam_id_remote, 0))
+			if (SteamNetworking()->ReadP2PPacket(slot->data, packetlen, &bytes_read, &steam_id_remote, 0))
 			{
-				if (packetlen > sizeof(DWORD) && mySteamID.ConvertToUint64() != steam_id_remote.ConvertToUint64() && net_packet->data[0])
+				if (packetlen > sizeof(DWORD) && mySteamID.ConvertToUint64() != steam_id_remote.ConvertToUint64() && slot->data[0])
 				{
-					//Push packet into queue.
-					//TODO: Use lock-free queues?
-					packets.push(new SteamPacketWrapper(packet, packetlen));
-					packet = nullptr;
+					slot->len = packetlen;
+					handler.incomingPackets.commitWrite();
 				}
 			}
-			if (packet)
-			{
-				free(packet);
-			}
-		}
-
-
-		//3. Now push our local packetstack onto the game's network stack.
-		//Well, that is: analyze packet.
-		//If packet is good, push into queue.
-		//If packet is bad, loop back to start of function.
-
-		while (!packets.empty())
-		{
-			//Copy over the packets read in so far, and expose them to the game.
-			SteamPacketWrapper* packet = packets.front();
-			packets.pop();
-			handler.addGamePacket(packet);
 		}
 
 		if ( !disableMultithreadedSteamNetworking )
@@ -6200,6 +6610,126 @@ int steamPacketThread(void* data)
 
 /* ***** END MULTITHREADED STEAM PACKET HANDLING ***** */
 
+/*-------------------------------------------------------------------------------
+
+	netLoopbackBenchmark
+
+	sends numPackets over localhost in bursts, once received inline the way
+	the game thread used to, and once through a pair of NetHandler io threads.
+	logs throughput and one way latency for both.
+
+-------------------------------------------------------------------------------*/
+
+static Uint64 netBenchmarkMicroseconds()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::high_resolution_clock::now().time_since_epoch()).count();
+}
+
+void netLoopbackBenchmark(int numPackets)
+{
+	const int burst = 64;
+	const int payloadLen = 128;
+	const Uint32 timeout = 2000; // ms to wait for stragglers before counting them lost
+
+	for ( int threaded = 0; threaded < 2; ++threaded )
+	{
+		UDPsocket senderSock = SDLNet_UDP_Open(0);
+		UDPsocket receiverSock = SDLNet_UDP_Open(0);
+		UDPpacket* packet = SDLNet_AllocPacket(NET_PACKET_SIZE);
+		if ( !senderSock || !receiverSock || !packet )
+		{
+			printlog("[NET]: Loopback benchmark failed to open sockets: %s", SDLNet_GetError());
+			if ( senderSock )
+			{
+				SDLNet_UDP_Close(senderSock);
+			}
+			if ( receiverSock )
+			{
+				SDLNet_UDP_Close(receiverSock);
+			}
+			if ( packet )
+			{
+				SDLNet_FreePacket(packet);
+			}
+			return;
+		}
+		IPaddress* local = SDLNet_UDP_GetPeerAddress(receiverSock, -1);
+		IPaddress destination;
+		SDLNet_ResolveHost(&destination, "127.0.0.1", SDLNet_Read16(&local->port));
+
+		NetHandler* sender = nullptr;
+		NetHandler* receiver = nullptr;
+		if ( threaded )
+		{
+			sender = new NetHandler();
+			receiver = new NetHandler();
+			sender->startDirectConnectThread(senderSock);
+			receiver->startDirectConnectThread(receiverSock);
+		}
+
+		int sent = 0;
+		int received = 0;
+		Uint64 totalLatency = 0;
+		Uint64 maxLatency = 0;
+		const Uint64 start = netBenchmarkMicroseconds();
+		Uint32 lastReceive = SDL_GetTicks();
+		while ( received < numPackets && SDL_GetTicks() - lastReceive < timeout )
+		{
+			for ( int i = 0; i < burst && sent < numPackets; ++i, ++sent )
+			{
+				const Uint64 now = netBenchmarkMicroseconds();
+				memset(packet->data, 0, payloadLen);
+				strcpy((char*)packet->data, "BNCH");
+				SDLNet_Write32(sent, &packet->data[4]);
+				SDLNet_Write32(static_cast<Uint32>(now >> 32), &packet->data[8]);
+				SDLNet_Write32(static_cast<Uint32>(now), &packet->data[12]);
+				packet->len = payloadLen;
+				packet->address = destination;
+				if ( !sender || !sender->queueOutgoingPacket(senderSock, -1, packet) )
+				{
+					SDLNet_UDP_Send(senderSock, -1, packet);
+				}
+			}
+
+			bool gotPacket = true;
+			while ( gotPacket )
+			{
+				gotPacket = receiver ? receiver->getGamePacket(packet) : (SDLNet_UDP_Recv(receiverSock, packet) > 0);
+				if ( gotPacket && !strncmp((char*)packet->data, "BNCH", 4) )
+				{
+					const Uint64 sentAt = (static_cast<Uint64>(SDLNet_Read32(&packet->data[8])) << 32) | SDLNet_Read32(&packet->data[12]);
+					const Uint64 latency = netBenchmarkMicroseconds() - sentAt;
+					totalLatency += latency;
+					maxLatency = std::max(maxLatency, latency);
+					++received;
+					lastReceive = SDL_GetTicks();
+				}
+			}
+			if ( sent >= numPackets )
+			{
+				SDL_Delay(1);
+			}
+		}
+		const double elapsed = (netBenchmarkMicroseconds() - start) / 1000.0;
+
+		if ( threaded )
+		{
+			delete sender; // joins the threads
+			delete receiver;
+		}
+		SDLNet_UDP_Close(senderSock);
+		SDLNet_UDP_Close(receiverSock);
+		SDLNet_FreePacket(packet);
+
+		printlog("[NET]: Loopback %s: %d/%d packets in %.2fms (%.0f packets/s), latency avg %.1fus max %lluus",
+			threaded ? "io thread" : "inline", received, numPackets, elapsed,
+			elapsed > 0.0 ? received / (elapsed / 1000.0) : 0.0,
+			received > 0 ? totalLatency / static_cast<double>(received) : 0.0,
+			static_cast<unsigned long long>(maxLatency));
+	}
+}
+
 void deleteMultiplayerSaveGames()
 {
 	if ( multiplayer != SERVER )
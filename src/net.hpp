@@ -12,6 +12,10 @@
 #pragma once
 
 #include <queue>
+#include <deque>
+#include <bitset>
+#include <atomic>
+#include <vector>
 
 #define DEFAULT_PORT 57165
 #define LOBBY_CHATBOX_LENGTH 62
@@ -24,6 +28,7 @@ extern list_t lobbyChatboxMessages;
 int power(int a, int b);
 int sendPacket(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool tryReliable = false);
 int sendPacketSafe(UDPsocket sock, int channel, UDPpacket* packet, int hostnum);
+int transportSendPacket(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool tryReliable = false); // sendPacket without NetSimulator
 void messagePlayer(int player, char const * const message, ...);
 void messageLocalPlayers(char const * const message, ...);
 void messagePlayerColor(int player, Uint32 color, char const * const message, ...);
@@ -41,6 +46,7 @@ void serverSpawnMiscParticlesAtLocation(Sint16 x, Sint16 y, Sint16 z, int partic
 void serverUpdateEntityFlag(Entity* entity, int flag);
 void serverUpdateBodypartIDs(Entity* entity);
 void serverUpdateEntityBodypart(Entity* entity, int bodypart);
+void serverSendPendingBodyparts(); // once per tick, after entity behaviors
 void serverUpdateEffects(int player);
 void serverUpdateHunger(int player);
 void serverUpdatePlayerStats();
@@ -66,8 +72,118 @@ Entity* receiveEntity(Entity* entity);
 void clientActions(Entity* entity);
 void clientHandleMessages(Uint32 framerateBreakInterval);
 void serverHandleMessages(Uint32 framerateBreakInterval);
+void clientHandlePacket(); // handles net_packet
+void serverHandlePacket();
 bool handleSafePacket();
 
+/*-------------------------------------------------------------------------------
+
+	SafePacketHandler_t
+
+	reliable delivery for sendPacketSafe(). every peer gets a preallocated
+	ring of unacknowledged packets indexed by sequence number. a packet sent
+	while the ring is full waits in a backlog until an ack frees a slot, so
+	nothing is dropped before it's acked or has used up MAXTRIES. receivers ack
+	with the sequence they got plus a bitfield of the 32 sequences before
+	their highest, so one lost ack doesn't cause a resend. resends are timed
+	off a smoothed round trip estimate and capped per peer per update. a
+	packet more than kReceiveWindow behind the highest one received is
+	dropped; a stream only starts over after reset() or resetPeer().
+
+	wire format (unchanged SAFE header):
+	"SAFE" | sender clientnum | sequence (4) | payload
+	"GOTP" | acker clientnum | sequence (4) | highest received (4) | bits (4)
+
+-------------------------------------------------------------------------------*/
+
+class SafePacketHandler_t
+{
+public:
+	static const int kSendWindow = 256; // unacked packets in flight per peer, more wait in a backlog
+	static const int kReceiveWindow = 4096; // sequences remembered per sender for duplicate checks
+	static const int kAckBits = 32;
+	static const Uint32 kMinRTO = 50; // ms
+	static const Uint32 kMaxRTO = 2000; // ms
+	static const Uint32 kInitialRTO = 200; // ms, used until the first round trip sample
+	static const int kResendBudget = 8; // resends per peer per update
+
+	struct PeerStats_t
+	{
+		Uint32 sent = 0;
+		Uint32 resent = 0;
+		Uint32 acked = 0;
+		Uint32 expired = 0; // gave up after MAXTRIES
+		Uint32 backlogged = 0; // waited for a free slot because the window was full
+		Uint32 rejected = 0; // too big to send
+		int peakInFlight = 0;
+		int peakBacklog = 0;
+	};
+
+	SafePacketHandler_t();
+	~SafePacketHandler_t();
+
+	int send(UDPsocket sock, int channel, UDPpacket* packet, int hostnum);
+	bool handlePacket(UDPpacket* packet);
+	void update(); // resends any packets past their timeout, call once a tick
+	void reset(); // forgets everything, for starting a new game or session
+	void resetPeer(int hostnum, int peerClientnum); // a new client took over a player slot
+
+	int getInFlight(int hostnum) const { return sendPeers[hostnum].inFlight; }
+	real_t getSmoothedRTT(int hostnum) const { return sendPeers[hostnum].srtt; }
+	Uint32 getRTO(int hostnum) const { return sendPeers[hostnum].rto; }
+	const PeerStats_t& getStats(int hostnum) const { return sendPeers[hostnum].stats; }
+	void logStats();
+
+private:
+	struct PendingPacket_t
+	{
+		bool inUse = false;
+		Uint32 sequence = 0;
+		Uint32 firstSentTime = 0;
+		Uint32 lastSentTime = 0;
+		int tries = 0;
+		UDPsocket sock = nullptr;
+		int channel = -1;
+		IPaddress address;
+		int len = 0;
+		Uint8 data[NET_PACKET_SIZE];
+	};
+	struct SendPeer_t
+	{
+		Uint32 nextSequence = 0;
+		Uint32 oldestSequence = 0; // lowest sequence that may still be in flight
+		int inFlight = 0;
+		bool hasRTTSample = false;
+		real_t srtt = 0.0;
+		real_t rttvar = 0.0;
+		Uint32 rto = kInitialRTO;
+		PendingPacket_t ring[kSendWindow];
+		std::deque<PendingPacket_t> backlog; // not yet given a sequence, in send order
+		PeerStats_t stats;
+	};
+	struct ReceivePeer_t
+	{
+		bool initialized = false;
+		Uint32 highest = 0;
+		std::bitset<kReceiveWindow> received;
+		Uint32 duplicates = 0; // packets we already had, i.e. resends whose ack got lost
+		Uint32 stale = 0; // dropped for being a whole window behind the highest
+	};
+
+	SendPeer_t sendPeers[MAXPLAYERS];
+	ReceivePeer_t receivePeers[MAXPLAYERS];
+	UDPpacket* scratchPacket = nullptr;
+
+	void resetSendPeer(SendPeer_t& peer);
+	void transmit(int hostnum, PendingPacket_t& pending);
+	void start(int hostnum, PendingPacket_t& pending); // gives a packet the next sequence and sends it
+	void flushBacklog(int hostnum);
+	void acknowledge(int hostnum, Uint32 sequence, Uint32 now);
+	void sampleRTT(SendPeer_t& peer, Uint32 rtt);
+	bool markReceived(ReceivePeer_t& peer, Uint32 sequence); // returns false on a duplicate
+};
+extern SafePacketHandler_t SafePacketHandler;
+
 void closeNetworkInterfaces();
 
 // server/game flags
@@ -84,52 +200,107 @@ const Uint32 SV_FLAG_CLASSIC = 64;
 const Uint32 SV_FLAG_KEEPINVENTORY = 128;
 const Uint32 SV_FLAG_LIFESAVING = 256;
 
-class SteamPacketWrapper
+/*
+ * Single producer, single consumer ring of fixed size packet buffers. The
+ * producer fills a slot in place and publishes it, the consumer reads it in
+ * place and releases it, so nothing is allocated per packet and no locks are
+ * taken. Exactly one thread may write and one thread may read at a time.
+ */
+class NetPacketRing
 {
-	Uint8* _data;
-	int _len;
-	//TODO: Encapsulate CSteam ID?
 public:
-	SteamPacketWrapper(Uint8* data, int len);
-	~SteamPacketWrapper(); //NOTE: DOES free _data. Don't keep it somewhere else or segfaults will ensue. If you're lucky.
+	struct Slot
+	{
+		int len = 0;
+		int channel = -1;
+		IPaddress address;
+		Uint8 data[NET_PACKET_SIZE];
+	};
+
+	NetPacketRing(Uint32 capacity); // rounded up to a power of two
 
-	Uint8*& data();
-	int& len();
+	// producer side. returns nullptr when the ring is full.
+	Slot* beginWrite();
+	void commitWrite();
+
+	// consumer side. returns the unread slot at offset, or nullptr if there
+	// aren't that many. commitRead releases the oldest count slots.
+	Slot* beginRead(Uint32 offset = 0);
+	void commitRead(Uint32 count = 1);
+
+	Uint32 size() const;
+	Uint32 capacity() const { return mask + 1; }
+private:
+	std::vector<Slot> slots;
+	Uint32 mask;
+	std::atomic<Uint32> head; // next slot to write, only advanced by the producer
+	std::atomic<Uint32> tail; // next slot to read, only advanced by the consumer
 };
 
 class NetHandler
 {
-	SDL_Thread* steam_packet_thread;
+	SDL_Thread* packet_thread;
 	bool continue_multithreading_steam_packets;
-	SDL_mutex* game_packets_lock;
 public:
 	NetHandler();
 	~NetHandler();
-	std::queue<SteamPacketWrapper* > game_packets;
+
+	static const Uint32 kIncomingPackets = 1024;
+	static const Uint32 kOutgoingPackets = 512;
+	static const int kSendBatch = 32; // packets handed to SDLNet_UDP_SendV at once
+
+	NetPacketRing incomingPackets; // transport -> game thread
+	NetPacketRing outgoingPackets; // game thread -> io thread, direct-connect only
+	UDPsocket directConnectSocket; // socket owned by the io thread while it runs
+	std::atomic<Uint32> outgoingOverflows;
 
 	void initializeMultithreadedPacketHandling();
+	void startDirectConnectThread(UDPsocket sock);
 	void stopMultithreadedPacketHandling();
 	void toggleMultithreading(bool disableMultithreading);
+	bool isThreaded() const { return packet_thread != nullptr; }
 
 	bool getContinueMultithreadingSteamPackets();
 
-	void addGamePacket(SteamPacketWrapper* packet);
+	/*
+	 * Copies the next incoming packet into the given packet and releases its slot.
+	 * Returns false if there are no packets.
+	 */
+	bool getGamePacket(UDPpacket* packet);
+	bool readIncomingPacket(UDPpacket* packet); // getGamePacket without NetSimulator
 
 	/*
-	 * This function will take the next packet in the queue, pop it off, and then return it.
-	 * Returns nullptr if no packets.
-	 * NOTE: You *MUST* free the data returned by this, or else you will leak memory! Such is the way of things.
+	 * Hands a direct-connect packet to the io thread to send. Returns false if
+	 * the io thread isn't running or is backed up, in which case the caller
+	 * sends it itself.
 	 */
-	SteamPacketWrapper* getGamePacket();
+	bool queueOutgoingPacket(UDPsocket sock, int channel, UDPpacket* packet);
+
+	// sends everything queued by queueOutgoingPacket. io thread only.
+	void flushOutgoingPackets();
 
 	SDL_mutex* continue_multithreading_steam_packets_lock;
 };
 extern NetHandler* net_handler;
 
+// running totals of game traffic, counted on the game thread
+struct NetTrafficStats_t
+{
+	Uint64 packetsSent = 0;
+	Uint64 bytesSent = 0;
+	Uint64 packetsReceived = 0;
+	Uint64 bytesReceived = 0;
+};
+extern NetTrafficStats_t NetTrafficStats;
+
 extern bool disableMultithreadedSteamNetworking;
+extern bool disableDirectConnectNetworkThread;
 extern bool disableFPSLimitOnNetworkMessages;
 
 int steamPacketThread(void* data);
 int EOSPacketThread(void* data);
+int directConnectPacketThread(void* data);
+void directConnectReceivePackets(NetHandler& handler, UDPsocket sock);
+void netLoopbackBenchmark(int numPackets);
 
 void deleteMultiplayerSaveGames(); //Server function, deletes its own save and broadcasts delete packet to clients.
@@ -0,0 +1,477 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: net_simulator.cpp
+Desc: network condition simulator, packet record and replay
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "game.hpp"
+#include "files.hpp"
+#include "net.hpp"
+#include "net_simulator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+NetSimulator_t NetSimulator;
+const Uint32 NetSimulator_t::kRecordVersion;
+const Uint32 NetSimulator_t::kReorderHoldMs;
+
+static const char kRecordMagic[4] = { 'B', 'N', 'P', 'R' };
+static const int kRecordHeaderSize = 12; // magic, version, side, clientnum, 2 spare
+static const int kRecordEntrySize = 16; // time, ticks, host, port, len
+
+NetSimulator_t::NetSimulator_t() :
+	rng(0)
+{
+}
+
+NetSimulator_t::~NetSimulator_t()
+{
+	stopRecording();
+	if ( scratchPacket )
+	{
+		SDLNet_FreePacket(scratchPacket);
+		scratchPacket = nullptr;
+	}
+}
+
+bool NetSimulator_t::active() const
+{
+	return conditions.latency || conditions.jitter || conditions.loss > 0.0
+		|| conditions.duplicate > 0.0 || conditions.reorder > 0.0;
+}
+
+void NetSimulator_t::setSeed(Uint32 seed)
+{
+	rng.seed(seed);
+}
+
+void NetSimulator_t::clear()
+{
+	outgoingQueue.clear();
+	incomingQueue.clear();
+}
+
+void NetSimulator_t::logStatus()
+{
+	printlog("[NETSIM]: latency %dms, jitter %dms, loss %.1f%%, duplicate %.1f%%, reorder %.1f%%, applied to %s%s%s",
+		conditions.latency, conditions.jitter, conditions.loss, conditions.duplicate, conditions.reorder,
+		conditions.incoming ? "incoming" : "", (conditions.incoming && conditions.outgoing) ? " and " : "",
+		conditions.outgoing ? "outgoing" : "");
+	printlog("[NETSIM]: delayed %d, dropped %d, duplicated %d, reordered %d, queued %d out / %d in, recorded %d%s",
+		stats.delayed, stats.dropped, stats.duplicated, stats.reordered,
+		(int)outgoingQueue.size(), (int)incomingQueue.size(), stats.recorded, isRecording() ? " (recording)" : "");
+}
+
+bool NetSimulator_t::ReleaseOrder::operator()(const PendingPacket_t& lhs, const PendingPacket_t& rhs) const
+{
+	// std heaps keep the largest element on top, so this sorts the earliest last
+	if ( lhs.releaseTime != rhs.releaseTime )
+	{
+		return static_cast<Sint32>(lhs.releaseTime - rhs.releaseTime) > 0;
+	}
+	return static_cast<Sint32>(lhs.sequence - rhs.sequence) > 0;
+}
+
+bool NetSimulator_t::roll(double percent)
+{
+	if ( percent <= 0.0 )
+	{
+		return false;
+	}
+	return std::uniform_real_distribution<double>(0.0, 100.0)(rng) < percent;
+}
+
+Uint32 NetSimulator_t::rollDelay()
+{
+	Sint32 delay = conditions.latency;
+	if ( conditions.jitter )
+	{
+		delay += static_cast<Sint32>(rng() % (conditions.jitter * 2 + 1)) - static_cast<Sint32>(conditions.jitter);
+	}
+	if ( roll(conditions.reorder) )
+	{
+		// hold it long enough that whatever is sent next overtakes it
+		delay += conditions.latency + conditions.jitter + kReorderHoldMs;
+		++stats.reordered;
+	}
+	return static_cast<Uint32>(std::max(0, delay));
+}
+
+void NetSimulator_t::push(std::vector<PendingPacket_t>& queue, PendingPacket_t& pending)
+{
+	pending.sequence = nextSequence++;
+	queue.push_back(std::move(pending));
+	std::push_heap(queue.begin(), queue.end(), ReleaseOrder());
+}
+
+bool NetSimulator_t::popDue(std::vector<PendingPacket_t>& queue, Uint32 now, PendingPacket_t& out)
+{
+	if ( queue.empty() || static_cast<Sint32>(queue.front().releaseTime - now) > 0 )
+	{
+		return false;
+	}
+	std::pop_heap(queue.begin(), queue.end(), ReleaseOrder());
+	out = std::move(queue.back());
+	queue.pop_back();
+	return true;
+}
+
+/*-------------------------------------------------------------------------------
+
+	NetSimulator_t::interceptOutgoing
+
+	takes the packet out of sendPacket() if any conditions are set. the copy
+	is sent by update() once it's due.
+
+-------------------------------------------------------------------------------*/
+
+bool NetSimulator_t::interceptOutgoing(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool tryReliable)
+{
+	if ( suppressOutgoing )
+	{
+		return true;
+	}
+	if ( !conditions.outgoing || !active() )
+	{
+		return false;
+	}
+	if ( roll(conditions.loss) )
+	{
+		++stats.dropped;
+		return true;
+	}
+
+	const Uint32 now = SDL_GetTicks();
+	const int copies = roll(conditions.duplicate) ? 2 : 1;
+	for ( int i = 0; i < copies; ++i )
+	{
+		PendingPacket_t pending;
+		pending.releaseTime = now + rollDelay();
+		pending.sock = sock;
+		pending.channel = channel;
+		pending.hostnum = hostnum;
+		pending.tryReliable = tryReliable;
+		pending.address = packet->address;
+		pending.data.assign(packet->data, packet->data + packet->len);
+		push(outgoingQueue, pending);
+	}
+	stats.duplicated += copies - 1;
+	++stats.delayed;
+	return true;
+}
+
+void NetSimulator_t::update()
+{
+	if ( outgoingQueue.empty() )
+	{
+		return;
+	}
+	if ( !scratchPacket && !(scratchPacket = SDLNet_AllocPacket(NET_PACKET_SIZE)) )
+	{
+		return;
+	}
+
+	const Uint32 now = SDL_GetTicks();
+	PendingPacket_t pending;
+	while ( popDue(outgoingQueue, now, pending) )
+	{
+		memcpy(scratchPacket->data, pending.data.data(), pending.data.size());
+		scratchPacket->len = pending.data.size();
+		scratchPacket->address = pending.address;
+		transportSendPacket(pending.sock, pending.channel, scratchPacket, pending.hostnum, pending.tryReliable);
+	}
+}
+
+bool NetSimulator_t::filteringIncoming() const
+{
+	return (conditions.incoming && active()) || !incomingQueue.empty();
+}
+
+void NetSimulator_t::interceptIncoming(const UDPpacket* packet)
+{
+	if ( !conditions.incoming || !active() )
+	{
+		PendingPacket_t pending;
+		pending.releaseTime = SDL_GetTicks();
+		pending.address = packet->address;
+		pending.data.assign(packet->data, packet->data + packet->len);
+		push(incomingQueue, pending);
+		return;
+	}
+	if ( roll(conditions.loss) )
+	{
+		++stats.dropped;
+		return;
+	}
+
+	const Uint32 now = SDL_GetTicks();
+	const int copies = roll(conditions.duplicate) ? 2 : 1;
+	for ( int i = 0; i < copies; ++i )
+	{
+		PendingPacket_t pending;
+		pending.releaseTime = now + rollDelay();
+		pending.address = packet->address;
+		pending.data.assign(packet->data, packet->data + packet->len);
+		push(incomingQueue, pending);
+	}
+	stats.duplicated += copies - 1;
+	++stats.delayed;
+}
+
+bool NetSimulator_t::getIncoming(UDPpacket* packet)
+{
+	PendingPacket_t pending;
+	if ( !popDue(incomingQueue, SDL_GetTicks(), pending) )
+	{
+		return false;
+	}
+	memcpy(packet->data, pending.data.data(), pending.data.size());
+	packet->len = pending.data.size();
+	packet->address = pending.address;
+	return true;
+}
+
+/*-------------------------------------------------------------------------------
+
+	NetSimulator_t::startRecording
+
+	recordings are a 12 byte header (magic, version, side, clientnum) then
+	one entry per packet: arrival time in ms, ticks, sender address, length
+	and the packet data. everything is written in network byte order.
+
+-------------------------------------------------------------------------------*/
+
+bool NetSimulator_t::startRecording(const char* filename)
+{
+	stopRecording();
+
+	char path[PATH_MAX];
+	completePath(path, filename, outputdir);
+	if ( !(recordFile = fopen(path, "wb")) )
+	{
+		printlog("[NETSIM]: failed to open %s for recording", path);
+		return false;
+	}
+
+	Uint8 header[kRecordHeaderSize] = { 0 };
+	memcpy(header, kRecordMagic, sizeof(kRecordMagic));
+	SDLNet_Write32(kRecordVersion, &header[4]);
+	header[8] = static_cast<Uint8>(multiplayer);
+	header[9] = static_cast<Uint8>(clientnum);
+	fwrite(header, 1, sizeof(header), recordFile);
+
+	recordStartTime = SDL_GetTicks();
+	stats.recorded = 0;
+	printlog("[NETSIM]: recording incoming packets to %s", path);
+	return true;
+}
+
+void NetSimulator_t::stopRecording()
+{
+	if ( recordFile )
+	{
+		fclose(recordFile);
+		recordFile = nullptr;
+		printlog("[NETSIM]: recorded %d packets", stats.recorded);
+	}
+}
+
+void NetSimulator_t::recordIncoming(const UDPpacket* packet)
+{
+	if ( !recordFile )
+	{
+		return;
+	}
+	Uint8 entry[kRecordEntrySize];
+	SDLNet_Write32(SDL_GetTicks() - recordStartTime, &entry[0]);
+	SDLNet_Write32(ticks, &entry[4]);
+	SDLNet_Write32(packet->address.host, &entry[8]);
+	SDLNet_Write16(packet->address.port, &entry[12]);
+	SDLNet_Write16(static_cast<Uint16>(packet->len), &entry[14]);
+	fwrite(entry, 1, sizeof(entry), recordFile);
+	fwrite(packet->data, 1, packet->len, recordFile);
+	++stats.recorded;
+}
+
+bool NetSimulator_t::readRecording(const char* filename, int& side, std::vector<RecordedPacket_t>& packets)
+{
+	char path[PATH_MAX];
+	completePath(path, filename, outputdir);
+	FILE* fp = fopen(path, "rb");
+	if ( !fp )
+	{
+		printlog("[NETSIM]: failed to open recording %s", path);
+		return false;
+	}
+
+	Uint8 header[kRecordHeaderSize];
+	if ( fread(header, 1, sizeof(header), fp) != sizeof(header)
+		|| memcmp(header, kRecordMagic, sizeof(kRecordMagic))
+		|| SDLNet_Read32(&header[4]) != kRecordVersion )
+	{
+		printlog("[NETSIM]: %s is not a packet recording", path);
+		fclose(fp);
+		return false;
+	}
+	side = header[8];
+
+	Uint8 entry[kRecordEntrySize];
+	while ( fread(entry, 1, sizeof(entry), fp) == sizeof(entry) )
+	{
+		RecordedPacket_t packet;
+		packet.time = SDLNet_Read32(&entry[0]);
+		packet.ticks = SDLNet_Read32(&entry[4]);
+		packet.address.host = SDLNet_Read32(&entry[8]);
+		packet.address.port = SDLNet_Read16(&entry[12]);
+		Uint16 len = SDLNet_Read16(&entry[14]);
+		if ( len > NET_PACKET_SIZE )
+		{
+			break;
+		}
+		packet.data.resize(len);
+		if ( fread(packet.data.data(), 1, len, fp) != len )
+		{
+			break;
+		}
+		packets.push_back(std::move(packet));
+	}
+	fclose(fp);
+	return true;
+}
+
+/*-------------------------------------------------------------------------------
+
+	NetSimulator_t::replay
+
+	replays run offline only. the handlers act on the world and on
+	SafePacketHandler, so replaying into a hosted or joined game would
+	corrupt the session for everyone in it. a single player game is used
+	as a scratch world instead: the recorded side stands in for the
+	duration, nothing the handlers send goes out, and the safe packet state
+	the recording leaves behind is reset afterwards. the world itself keeps
+	whatever the packets did to it, so start a fresh game after replaying.
+
+-------------------------------------------------------------------------------*/
+
+bool NetSimulator_t::replay(const char* filename)
+{
+	if ( intro || multiplayer != SINGLE )
+	{
+		printlog("[NETSIM]: replays need an offline single player game, not a hosted or joined one");
+		return false;
+	}
+
+	int side = SINGLE;
+	std::vector<RecordedPacket_t> packets;
+	if ( !readRecording(filename, side, packets) )
+	{
+		return false;
+	}
+	if ( side != CLIENT && side != SERVER )
+	{
+		printlog("[NETSIM]: recording has no client or server side (%d)", side);
+		return false;
+	}
+
+	replayImmediate(side, packets);
+	return true;
+}
+
+void NetSimulator_t::replayImmediate(int side, std::vector<RecordedPacket_t>& packets)
+{
+	typedef std::chrono::high_resolution_clock Clock;
+	struct PacketTypeStats_t
+	{
+		Uint32 count = 0;
+		double totalUs = 0.0;
+		double maxUs = 0.0;
+	};
+	std::map<std::string, PacketTypeStats_t> typeStats;
+
+	UDPpacket* replayPacket = SDLNet_AllocPacket(NET_PACKET_SIZE);
+	if ( !replayPacket )
+	{
+		return;
+	}
+	UDPpacket* oldPacket = net_packet;
+	const int oldMultiplayer = multiplayer;
+	net_packet = replayPacket;
+	multiplayer = side;
+	suppressOutgoing = true;
+
+	// server handlers look up client addresses to reply to, even though the replies are dropped
+	IPaddress* replayClients = nullptr;
+	if ( !net_clients )
+	{
+		replayClients = static_cast<IPaddress*>(calloc(MAXPLAYERS, sizeof(IPaddress)));
+		net_clients = replayClients;
+	}
+
+	double totalUs = 0.0;
+	for ( auto& recorded : packets )
+	{
+		memcpy(net_packet->data, recorded.data.data(), recorded.data.size());
+		net_packet->len = recorded.data.size();
+		net_packet->address = recorded.address;
+
+		// packet types are four letter codes, longer ones share a prefix
+		std::string type(reinterpret_cast<const char*>(recorded.data.data()), std::min<size_t>(4, recorded.data.size()));
+		for ( auto& c : type )
+		{
+			if ( c < ' ' || c > '~' )
+			{
+				c = '?';
+			}
+		}
+
+		Clock::time_point start = Clock::now();
+		if ( side == CLIENT )
+		{
+			clientHandlePacket();
+		}
+		else
+		{
+			serverHandlePacket();
+		}
+		double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+		PacketTypeStats_t& entry = typeStats[type];
+		++entry.count;
+		entry.totalUs += us;
+		entry.maxUs = std::max(entry.maxUs, us);
+		totalUs += us;
+	}
+
+	if ( replayClients )
+	{
+		net_clients = nullptr;
+		free(replayClients);
+	}
+	suppressOutgoing = false;
+	multiplayer = oldMultiplayer;
+	net_packet = oldPacket;
+	SDLNet_FreePacket(replayPacket);
+	SafePacketHandler.reset();
+
+	std::vector<std::pair<std::string, PacketTypeStats_t>> sorted(typeStats.begin(), typeStats.end());
+	std::sort(sorted.begin(), sorted.end(),
+		[](const std::pair<std::string, PacketTypeStats_t>& lhs, const std::pair<std::string, PacketTypeStats_t>& rhs)
+		{
+			return lhs.second.totalUs > rhs.second.totalUs;
+		});
+	printlog("[NETSIM]: replayed %d packets into %s handler, %.2fms total",
+		(int)packets.size(), side == CLIENT ? "client" : "server", totalUs / 1000.0);
+	for ( auto& it : sorted )
+	{
+		printlog("[NETSIM]: %-4s x%6d  total %9.1fus  avg %7.2fus  max %8.1fus",
+			it.first.c_str(), it.second.count, it.second.totalUs, it.second.totalUs / it.second.count, it.second.maxUs);
+	}
+}
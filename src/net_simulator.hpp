@@ -0,0 +1,135 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: net_simulator.hpp
+Desc: header for net_simulator.cpp (network condition simulator, packet
+	record and replay)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+
+/*-------------------------------------------------------------------------------
+
+	NetSimulator_t
+
+	sits between the game and the transport. outgoing packets are caught in
+	sendPacket(), incoming ones in NetHandler::getGamePacket(), so it works
+	the same for direct-connect, steam and EOS. set up with /netsim, which
+	like any console command can go in a config file.
+
+	packets are held in a queue ordered by release time. latency and jitter
+	pick the release time, reordered packets are held back past the packets
+	sent after them, lost packets never enter the queue and duplicated ones
+	enter it twice. all rolls come from a private generator so a given
+	/netsim seed gives the same drops every run, and the game's own prng is
+	left alone.
+
+	/netrecord writes every packet the handlers see, with its arrival time,
+	to a file. /netreplay feeds a recording back through clientHandlePacket
+	or serverHandlePacket back to back, timing each packet type. it only
+	runs in an offline single player game, never a live session.
+
+-------------------------------------------------------------------------------*/
+
+class NetSimulator_t
+{
+public:
+	struct Conditions_t
+	{
+		Uint32 latency = 0; // ms added to every packet
+		Uint32 jitter = 0; // ms, +/- on top of latency
+		double loss = 0.0; // percent of packets dropped
+		double duplicate = 0.0; // percent of packets sent twice
+		double reorder = 0.0; // percent of packets held back behind later ones
+		bool incoming = true;
+		bool outgoing = true;
+	} conditions;
+
+	struct Stats_t
+	{
+		Uint32 delayed = 0;
+		Uint32 dropped = 0;
+		Uint32 duplicated = 0;
+		Uint32 reordered = 0;
+		Uint32 recorded = 0;
+	} stats;
+
+	NetSimulator_t();
+	~NetSimulator_t();
+
+	bool active() const;
+	void setSeed(Uint32 seed);
+	void clear(); // drops everything still queued, call when sockets close
+	void logStatus();
+
+	// called by sendPacket(). returns true if the packet was taken
+	bool interceptOutgoing(UDPsocket sock, int channel, UDPpacket* packet, int hostnum, bool tryReliable);
+	// sends the outgoing packets that are due
+	void update();
+
+	// called by NetHandler::getGamePacket()
+	bool filteringIncoming() const;
+	void interceptIncoming(const UDPpacket* packet);
+	bool getIncoming(UDPpacket* packet);
+
+	bool startRecording(const char* filename);
+	void stopRecording();
+	bool isRecording() const { return recordFile != nullptr; }
+	void recordIncoming(const UDPpacket* packet);
+
+	// handles every packet in the recording immediately and logs the cost of
+	// each packet type. refuses to run while a networked game is live
+	bool replay(const char* filename);
+private:
+	struct PendingPacket_t
+	{
+		Uint32 releaseTime = 0;
+		Uint32 sequence = 0; // keeps packets due on the same ms in order
+		UDPsocket sock = nullptr;
+		int channel = -1;
+		int hostnum = 0;
+		bool tryReliable = false;
+		IPaddress address;
+		std::vector<Uint8> data;
+	};
+	struct ReleaseOrder
+	{
+		bool operator()(const PendingPacket_t& lhs, const PendingPacket_t& rhs) const;
+	};
+	struct RecordedPacket_t
+	{
+		Uint32 time = 0; // ms since recording started
+		Uint32 ticks = 0;
+		IPaddress address;
+		std::vector<Uint8> data;
+	};
+
+	static const Uint32 kRecordVersion = 1;
+	static const Uint32 kReorderHoldMs = 50;
+
+	std::vector<PendingPacket_t> outgoingQueue; // heaps ordered by ReleaseOrder
+	std::vector<PendingPacket_t> incomingQueue;
+	Uint32 nextSequence = 0;
+	std::mt19937 rng;
+	UDPpacket* scratchPacket = nullptr;
+	bool suppressOutgoing = false; // set while replaying, replies go nowhere
+
+	FILE* recordFile = nullptr;
+	Uint32 recordStartTime = 0;
+
+	bool roll(double percent);
+	Uint32 rollDelay();
+	void push(std::vector<PendingPacket_t>& queue, PendingPacket_t& pending);
+	bool popDue(std::vector<PendingPacket_t>& queue, Uint32 now, PendingPacket_t& out);
+	bool readRecording(const char* filename, int& side, std::vector<RecordedPacket_t>& packets);
+	void replayImmediate(int side, std::vector<RecordedPacket_t>& packets);
+};
+extern NetSimulator_t NetSimulator;
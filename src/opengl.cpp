@@ -14,6 +14,7 @@
 #include "entity.hpp"
 #include "files.hpp"
 #include "items.hpp"
+#include "texture_atlas.hpp"
 
 #ifdef WINDOWS
 PFNGLGENBUFFERSPROC SDL_glGenBuffers;
@@ -676,7 +677,7 @@ void glDrawWorldUISprite(view_t* camera, Entity* entity, int mode)
 			}
 			SDL_UnlockSurface(sprite);
 
-			node_t* node = list_Node(&items[item->type].surfaces, item->appearance % items[item->type].variations);
+			node_t* node = list_NodeIndexed(&items[item->type].surfaces, item->appearance % items[item->type].variations);
 			if ( !node )
 			{
 				return;
@@ -1029,14 +1030,15 @@ void glDrawSprite(view_t* camera, Entity* entity, int mode)
 	}
 
 	// draw quad
+	const TextureAtlasHandler::Region_t& uv = TextureAtlas.region(sprite);
 	glBegin(GL_QUADS);
-	glTexCoord2f(0, 0);
+	glTexCoord2f(uv.u0, uv.v0);
 	glVertex3f(0, sprite->h / 2, sprite->w / 2);
-	glTexCoord2f(0, 1);
+	glTexCoord2f(uv.u0, uv.v1);
 	glVertex3f(0, -sprite->h / 2, sprite->w / 2);
-	glTexCoord2f(1, 1);
+	glTexCoord2f(uv.u1, uv.v1);
 	glVertex3f(0, -sprite->h / 2, -sprite->w / 2);
-	glTexCoord2f(1, 0);
+	glTexCoord2f(uv.u1, uv.v0);
 	glVertex3f(0, sprite->h / 2, -sprite->w / 2);
 	glEnd();
 	glDepthRange(0, 1);
@@ -1327,7 +1329,7 @@ void glDrawWorld(view_t* camera, int mode)
 
 		// first (higher) sky layer
 		glColor4f(1.f, 1.f, 1.f, .5);
-		glBindTexture(GL_TEXTURE_2D, texid[tiles[cloudtile]->refcount]); // sky tile
+		glBindTexture(GL_TEXTURE_2D, TextureAtlas.repeatingTexture(tiles[cloudtile])); // sky tile
 		glBegin( GL_QUADS );
 		glTexCoord2f((real_t)(ticks % 60) / 60, (real_t)(ticks % 60) / 60);
 		glVertex3f(-CLIPFAR * 16, 64, -CLIPFAR * 16);
@@ -1344,7 +1346,7 @@ void glDrawWorld(view_t* camera, int mode)
 
 		// second (closer) sky layer
 		glColor4f(1.f, 1.f, 1.f, .5);
-		glBindTexture(GL_TEXTURE_2D, texid[tiles[cloudtile]->refcount]); // sky tile
+		glBindTexture(GL_TEXTURE_2D, TextureAtlas.repeatingTexture(tiles[cloudtile])); // sky tile
 		glBegin( GL_QUADS );
 		glTexCoord2f((real_t)(ticks % 240) / 240, (real_t)(ticks % 240) / 240);
 		glVertex3f(-CLIPFAR * 16, 32, -CLIPFAR * 16);
@@ -1388,17 +1390,27 @@ void glDrawWorld(view_t* camera, int mode)
 	// glBegin / glEnd are also moved outside, 
 	// but needs to track the texture used to "flush" current drawing before switching
 	GLuint cur_tex = 0, new_tex = 0;
+	// where the current tile sits in its atlas page
+	const TextureAtlasHandler::Region_t* uv = &TextureAtlas.region(nullptr);
 	glBindTexture(GL_TEXTURE_2D, 0);
 	glBegin(GL_QUADS);
+	// add what this view can see to what the views before it this frame could,
+	// and always draw the tiles right around the camera
+	vismap.merge(viewVismap(camera));
+	for ( x = std::max(0, (int)camera->x - 3); x <= std::min((int)map.width - 1, (int)camera->x + 3); x++ )
+	{
+		for ( y = std::max(0, (int)camera->y - 3); y <= std::min((int)map.height - 1, (int)camera->y + 3); y++ )
+		{
+			vismap.set(x, y);
+		}
+	}
 	for ( x = 0; x < map.width; x++ )
 	{
-		for ( y = 0; y < map.height; y++ )
+		// walk each row a run of visible tiles at a time
+		int spanBegin, spanEnd;
+		for ( int from = 0; vismap.nextSpan(x, from, spanBegin, spanEnd); from = spanEnd )
 		{
-			if ( x >= (int)camera->x - 3 && x <= (int)camera->x + 3 && y >= (int)camera->y - 3 && y <= (int)camera->y + 3 )
-			{
-				vismap[y + x * map.height] = true;
-			}
-			if ( vismap[y + x * map.height] )
+			for ( y = spanBegin; y < spanEnd; y++ )
 			{
 				for ( z = 0; z < MAPLAYERS + 1; z++ )
 				{
@@ -1418,17 +1430,20 @@ void glDrawWorld(view_t* camera, int mode)
 							if ( map.tiles[index] < 0 || map.tiles[index] >= numtiles )
 							{
 								new_tex = texid[sprites[0]->refcount];
+								uv = &TextureAtlas.region(sprites[0]);
 								//glBindTexture(GL_TEXTURE_2D, texid[sprites[0]->refcount]);
 							}
 							else
 							{
 								new_tex = texid[tiles[map.tiles[index]]->refcount];
+								uv = &TextureAtlas.region(tiles[map.tiles[index]]);
 								//glBindTexture(GL_TEXTURE_2D, texid[tiles[map.tiles[index]]->refcount]);
 							}
 						}
 						else
 						{
 							new_tex = 0;
+							uv = &TextureAtlas.region(nullptr);
 							//glBindTexture(GL_TEXTURE_2D, 0);
 						}
 						// check if the texture has changed (flushing drawing if it's the case)
@@ -1450,33 +1465,47 @@ void glDrawWorld(view_t* camera, int mode)
 								{
 									s = getLightAt(x + 1, y + 1);
 									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
 									s = getLightAt(x + 1, y);
 									glColor3f(s, s, s);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
 								}
 								else
 								{
-									s = getLightAt(x + 1, y + 1);
-									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									// two copies of the tile up the wall, fading to black. atlas pages
+									// don't repeat, so each copy is its own quad meeting at half light
+									real_t s0 = getLightAt(x + 1, y + 1);
+									real_t s1 = getLightAt(x + 1, y);
+									glColor3f(s0, s0, s0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
+									glColor3f(s1, s1, s1);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
+
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(0));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
 									glColor3f(0, 0, 0);
-									glTexCoord2f(0, 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48 - 32, y * 32 + 32);
-									s = getLightAt(x + 1, y);
-									glColor3f(0, 0, 0);
-									glTexCoord2f(1, 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48 - 32, y * 32 + 0);
-									glColor3f(s, s, s);
-									glTexCoord2f(1, 0);
-									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
 								}
 								//glEnd();
 							}
@@ -1505,13 +1534,13 @@ void glDrawWorld(view_t* camera, int mode)
 								if ( x == map.width - 1 || !map.tiles[z + y * MAPLAYERS + (x + 1)*MAPLAYERS * map.height] )
 								{
 									//glBegin( GL_QUADS );
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
 									//glEnd();
 								}
@@ -1528,33 +1557,47 @@ void glDrawWorld(view_t* camera, int mode)
 								{
 									s = getLightAt(x, y + 1);
 									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
 									s = getLightAt(x + 1, y + 1);
 									glColor3f(s, s, s);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
 								}
 								else
 								{
-									s = getLightAt(x, y + 1);
-									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									// two copies of the tile up the wall, fading to black. atlas pages
+									// don't repeat, so each copy is its own quad meeting at half light
+									real_t s0 = getLightAt(x, y + 1);
+									real_t s1 = getLightAt(x + 1, y + 1);
+									glColor3f(s0, s0, s0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
+									glColor3f(s1, s1, s1);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
+
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(0));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
 									glColor3f(0, 0, 0);
-									glTexCoord2f(0, 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48 - 32, y * 32 + 32);
-									s = getLightAt(x + 1, y + 1);
-									glColor3f(0, 0, 0);
-									glTexCoord2f(1, 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48 - 32, y * 32 + 32);
-									glColor3f(s, s, s);
-									glTexCoord2f(1, 0);
-									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
 								}
 								//glEnd();
 							}
@@ -1579,13 +1622,13 @@ void glDrawWorld(view_t* camera, int mode)
 								if ( y == map.height - 1 || !map.tiles[z + (y + 1)*MAPLAYERS + x * MAPLAYERS * map.height] )
 								{
 									//glBegin( GL_QUADS );
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 32);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 32);
 									//glEnd();
 								}
@@ -1602,33 +1645,47 @@ void glDrawWorld(view_t* camera, int mode)
 								{
 									s = getLightAt(x, y);
 									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
 									s = getLightAt(x, y + 1);
 									glColor3f(s, s, s);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
 								}
 								else
 								{
-									s = getLightAt(x, y);
-									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									// two copies of the tile up the wall, fading to black. atlas pages
+									// don't repeat, so each copy is its own quad meeting at half light
+									real_t s0 = getLightAt(x, y);
+									real_t s1 = getLightAt(x, y + 1);
+									glColor3f(s0, s0, s0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
+									glColor3f(s1, s1, s1);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
+
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(0));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
 									glColor3f(0, 0, 0);
-									glTexCoord2f(0, 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48 - 32, y * 32 + 0);
-									s = getLightAt(x, y + 1);
-									glColor3f(0, 0, 0);
-									glTexCoord2f(1, 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48 - 32, y * 32 + 32);
-									glColor3f(s, s, s);
-									glTexCoord2f(1, 0);
-									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
 								}
 								//glEnd();
 							}
@@ -1653,13 +1710,13 @@ void glDrawWorld(view_t* camera, int mode)
 								if ( x == 0 || !map.tiles[z + y * MAPLAYERS + (x - 1)*MAPLAYERS * map.height] )
 								{
 									//glBegin( GL_QUADS );
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 32);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 32);
 									//glEnd();
 								}
@@ -1676,33 +1733,47 @@ void glDrawWorld(view_t* camera, int mode)
 								{
 									s = getLightAt(x + 1, y);
 									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
 									s = getLightAt(x, y);
 									glColor3f(s, s, s);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
 								}
 								else
 								{
-									s = getLightAt(x + 1, y);
-									glColor3f(s, s, s);
-									glTexCoord2f(0, 0);
+									// two copies of the tile up the wall, fading to black. atlas pages
+									// don't repeat, so each copy is its own quad meeting at half light
+									real_t s0 = getLightAt(x + 1, y);
+									real_t s1 = getLightAt(x, y);
+									glColor3f(s0, s0, s0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
+									glColor3f(s1, s1, s1);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
+
+									glColor3f(s0 / 2, s0 / 2, s0 / 2);
+									glTexCoord2f(uv->u(0), uv->v(0));
+									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
 									glColor3f(0, 0, 0);
-									glTexCoord2f(0, 2);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48 - 32, y * 32 + 0);
-									s = getLightAt(x, y);
-									glColor3f(0, 0, 0);
-									glTexCoord2f(1, 2);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48 - 32, y * 32 + 0);
-									glColor3f(s, s, s);
-									glTexCoord2f(1, 0);
-									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
+									glColor3f(s1 / 2, s1 / 2, s1 / 2);
+									glTexCoord2f(uv->u(1), uv->v(0));
+									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
 								}
 								//glEnd();
 							}
@@ -1727,13 +1798,13 @@ void glDrawWorld(view_t* camera, int mode)
 								if ( y == 0 || !map.tiles[z + (y - 1)*MAPLAYERS + x * MAPLAYERS * map.height] )
 								{
 									//glBegin( GL_QUADS );
-									glTexCoord2f(0, 0);
+									glTexCoord2f(uv->u(0), uv->v(0));
 									glVertex3f(x * 32 + 32, z * 32 - 16, y * 32 + 0);
-									glTexCoord2f(0, 1);
+									glTexCoord2f(uv->u(0), uv->v(1));
 									glVertex3f(x * 32 + 32, z * 32 - 48, y * 32 + 0);
-									glTexCoord2f(1, 1);
+									glTexCoord2f(uv->u(1), uv->v(1));
 									glVertex3f(x * 32 + 0, z * 32 - 48, y * 32 + 0);
-									glTexCoord2f(1, 0);
+									glTexCoord2f(uv->u(1), uv->v(0));
 									glVertex3f(x * 32 + 0, z * 32 - 16, y * 32 + 0);
 									//glEnd();
 								}
@@ -1746,6 +1817,7 @@ void glDrawWorld(view_t* camera, int mode)
 						if ( mode == REALCOLORS )
 						{
 							new_tex = texid[tiles[mapceilingtile]->refcount];
+							uv = &TextureAtlas.region(tiles[mapceilingtile]);
 							//glBindTexture(GL_TEXTURE_2D, texid[tiles[50]->refcount]); // rock tile
 							if (cur_tex!=new_tex)
 							{
@@ -1771,19 +1843,19 @@ void glDrawWorld(view_t* camera, int mode)
 								//glBegin( GL_QUADS );
 								s = getLightAt(x, y);
 								glColor3f(s, s, s);
-								glTexCoord2f(0, 0);
+								glTexCoord2f(uv->u(0), uv->v(0));
 								glVertex3f(x * 32 + 0, -16 - 32 * abs(z), y * 32 + 0);
 								s = getLightAt(x, y + 1);
 								glColor3f(s, s, s);
-								glTexCoord2f(0, 1);
+								glTexCoord2f(uv->u(0), uv->v(1));
 								glVertex3f(x * 32 + 0, -16 - 32 * abs(z), y * 32 + 32);
 								s = getLightAt(x + 1, y + 1);
 								glColor3f(s, s, s);
-								glTexCoord2f(1, 1);
+								glTexCoord2f(uv->u(1), uv->v(1));
 								glVertex3f(x * 32 + 32, -16 - 32 * abs(z), y * 32 + 32);
 								s = getLightAt(x + 1, y);
 								glColor3f(s, s, s);
-								glTexCoord2f(1, 0);
+								glTexCoord2f(uv->u(1), uv->v(0));
 								glVertex3f(x * 32 + 32, -16 - 32 * abs(z), y * 32 + 0);
 								//glEnd();
 							}
@@ -1797,19 +1869,19 @@ void glDrawWorld(view_t* camera, int mode)
 								//glBegin( GL_QUADS );
 								s = getLightAt(x, y);
 								glColor3f(s, s, s);
-								glTexCoord2f(0, 0);
+								glTexCoord2f(uv->u(0), uv->v(0));
 								glVertex3f(x * 32 + 0, 16 + 32 * abs(z - 2), y * 32 + 0);
 								s = getLightAt(x + 1, y);
 								glColor3f(s, s, s);
-								glTexCoord2f(1, 0);
+								glTexCoord2f(uv->u(1), uv->v(0));
 								glVertex3f(x * 32 + 32, 16 + 32 * abs(z - 2), y * 32 + 0);
 								s = getLightAt(x + 1, y + 1);
 								glColor3f(s, s, s);
-								glTexCoord2f(1, 1);
+								glTexCoord2f(uv->u(1), uv->v(1));
 								glVertex3f(x * 32 + 32, 16 + 32 * abs(z - 2), y * 32 + 32);
 								s = getLightAt(x, y + 1);
 								glColor3f(s, s, s);
-								glTexCoord2f(0, 1);
+								glTexCoord2f(uv->u(0), uv->v(1));
 								glVertex3f(x * 32 + 0, 16 + 32 * abs(z - 2), y * 32 + 32);
 								//glEnd();
 							}
@@ -1830,13 +1902,13 @@ void glDrawWorld(view_t* camera, int mode)
 							if ( !map.tiles[index + 1] )
 							{
 								//glBegin( GL_QUADS );
-								glTexCoord2f(0, 0);
+								glTexCoord2f(uv->u(0), uv->v(0));
 								glVertex3f(x * 32 + 0, -16 - 32 * abs(z), y * 32 + 0);
-								glTexCoord2f(0, 1);
+								glTexCoord2f(uv->u(0), uv->v(1));
 								glVertex3f(x * 32 + 0, -16 - 32 * abs(z), y * 32 + 32);
-								glTexCoord2f(1, 1);
+								glTexCoord2f(uv->u(1), uv->v(1));
 								glVertex3f(x * 32 + 32, -16 - 32 * abs(z), y * 32 + 32);
-								glTexCoord2f(1, 0);
+								glTexCoord2f(uv->u(1), uv->v(0));
 								glVertex3f(x * 32 + 32, -16 - 32 * abs(z), y * 32 + 0);
 								//glEnd();
 							}
@@ -1848,13 +1920,13 @@ void glDrawWorld(view_t* camera, int mode)
 							if ( !map.tiles[index - 1] )
 							{
 								//glBegin( GL_QUADS );
-								glTexCoord2f(0, 0);
+								glTexCoord2f(uv->u(0), uv->v(0));
 								glVertex3f(x * 32 + 0, 16 + 32 * abs(z - 2), y * 32 + 0);
-								glTexCoord2f(1, 0);
+								glTexCoord2f(uv->u(1), uv->v(0));
 								glVertex3f(x * 32 + 32, 16 + 32 * abs(z - 2), y * 32 + 0);
-								glTexCoord2f(1, 1);
+								glTexCoord2f(uv->u(1), uv->v(1));
 								glVertex3f(x * 32 + 32, 16 + 32 * abs(z - 2), y * 32 + 32);
-								glTexCoord2f(0, 1);
+								glTexCoord2f(uv->u(0), uv->v(1));
 								glVertex3f(x * 32 + 0, 16 + 32 * abs(z - 2), y * 32 + 32);
 								//glEnd();
 							}
@@ -1906,6 +1978,10 @@ unsigned int GO_GetPixelU32(int x, int y, view_t& camera)
 
 void GO_SwapBuffers(SDL_Window* screen)
 {
+	if ( headless )
+	{
+		return;
+	}
 	dirty = 1;
 #ifdef PANDORA
 	bool bBlit = !(xres==800 && yres==480);
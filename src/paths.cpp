@@ -18,8 +18,12 @@
 #include "paths.hpp"
 #include "items.hpp"
 #include "net.hpp"
+#include "prng.hpp"
 #include "magic/magic.hpp"
 
+#include <chrono>
+#include <queue>
+
 int* pathMapFlying = NULL;
 int* pathMapGrounded = NULL;
 int pathMapZone = 1;
@@ -134,16 +138,25 @@ pathnode_t** heapRemove(pathnode_t** heap, long* length)
 
 -------------------------------------------------------------------------------*/
 
-int pathCheckObstacle(long x, long y, Entity* my, Entity* target)
+// walls, holes and lava, checked against the given map so the level
+// prefetch worker can path through a floor it's building
+static bool pathTerrainBlocked(const map_t& onMap, long x, long y)
 {
-	int u = std::min(std::max<unsigned int>(0, x >> 4), map.width);
-	int v = std::min(std::max<unsigned int>(0, y >> 4), map.height); //TODO: Why are int and long int being compared?
-	int index = v * MAPLAYERS + u * MAPLAYERS * map.height;
+	int u = std::min(std::max<unsigned int>(0, x >> 4), onMap.width);
+	int v = std::min(std::max<unsigned int>(0, y >> 4), onMap.height); //TODO: Why are int and long int being compared?
+	int index = v * MAPLAYERS + u * MAPLAYERS * onMap.height;
+
+	return onMap.tiles[OBSTACLELAYER + index] || !onMap.tiles[index] || lavatiles[onMap.tiles[index]];
+}
 
-	if ( map.tiles[OBSTACLELAYER + index] || !map.tiles[index] || lavatiles[map.tiles[index]] )
+int pathCheckObstacle(long x, long y, Entity* my, Entity* target)
+{
+	if ( pathTerrainBlocked(map, x, y) )
 	{
 		return 1;
 	}
+	int u = std::min(std::max<unsigned int>(0, x >> 4), map.width);
+	int v = std::min(std::max<unsigned int>(0, y >> 4), map.height);
 
 	node_t* node;
 	std::vector<list_t*> entLists = TileEntityList.getEntitiesWithinRadiusAroundEntity(my, 0);
@@ -173,186 +186,25 @@ int pathCheckObstacle(long x, long y, Entity* my, Entity* target)
 
 /*-------------------------------------------------------------------------------
 
-	generatePath
+	searchPath
 
-	generates a path through the level using the A* pathfinding algorithm.
-	Takes a starting point and destination in map coordinates, and returns
-	a list of pathnodes which lead from the starting point to the destination.
-	If no path connecting the two positions is possible, generatePath returns
-	NULL.
+	A* search from x1, y1 to x2, y2 over a prepared path map. binaryheap
+	must have room for map.width * map.height nodes. given a terrain map,
+	only its walls, holes and lava are checked and pathMap isn't used
 
 -------------------------------------------------------------------------------*/
 
-list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target, bool lavaIsPassable)
+static list_t* searchPath(int* pathMap, pathnode_t** binaryheap, int x1, int y1, int x2, int y2, Entity* my, Entity* target, const map_t* terrain = nullptr)
 {
-	if (!my)
-	{
-		return NULL;
-	}
-
 	pathnode_t* pathnode, *childnode, *parent;
 	list_t* openList, *closedList;
 	list_t* path;
 	node_t* node;
 	bool alreadyadded;
 	Sint32 x, y, z, h, g;
-	pathnode_t** binaryheap;
 	long heaplength = 0;
-	node_t* entityNode = NULL;
-
-	int* pathMap = (int*) calloc(map.width * map.height, sizeof(int));
-
-	bool levitating = false;
-
-	x1 = std::min<unsigned int>(std::max(0, x1), map.width - 1);
-	y1 = std::min<unsigned int>(std::max(0, y1), map.height - 1);
-	x2 = std::min<unsigned int>(std::max(0, x2), map.width - 1);
-	y2 = std::min<unsigned int>(std::max(0, y2), map.height - 1); //TODO: Why are int and unsigned int being compared?
-
-	// get levitation status
-	Stat* stats = my->getStats();
-	if ( stats )
-	{
-		levitating = isLevitating(stats);
-	}
-	if ( my )
-	{
-		if ( my->behavior == &actItem || my->behavior == &actArrowTrap || my->behavior == &actBoulderTrap )
-		{
-			levitating = true;
-		}
-	}
-
-	// for boulders falling and checking if a player can reach the ladder.
-	bool playerCheckPathToExit = (my && my->behavior == &actPlayer
-		&& target && (target->behavior == &actLadder || target->behavior == &actPortal));
-	bool playerCheckAchievement = (my && my->behavior == &actPlayer
-		&& target && (target->behavior == &actBomb || target->behavior == &actPlayerLimb || target->behavior == &actItem || target->behavior == &actSwitch));
-
-	if ( !loading )
-	{
-		if ( levitating || playerCheckPathToExit )
-		{
-			memcpy(pathMap, pathMapFlying, map.width * map.height * sizeof(int));
-		}
-		else
-		{
-			memcpy(pathMap, pathMapGrounded, map.width * map.height * sizeof(int));
-		}
-	}
-
-	int myPathMap = pathMap[y1 + x1 * map.height];
-	if ( !loading )
-	{
-		if ( !myPathMap || myPathMap != pathMap[y2 + x2 * map.height] || !pathMap[y2 + x2 * map.height] || (x1 == x2 && y1 == y2) )
-		{
-			free(pathMap);
-			return NULL;
-		}
-	}
-
-	// for boulders falling and checking if a player can reach the ladder.
-	// if we're not levitating, we use the flying path map (for water/lava) and here we remove the empty air tiles from the pathMap.
-	if ( playerCheckPathToExit && !levitating )
-	{
-		for ( int y = 0; y < map.height; ++y )
-		{
-			for ( int x = 0; x < map.width; ++x )
-			{
-				if ( !map.tiles[y * MAPLAYERS + x * MAPLAYERS * map.height] )
-				{
-					pathMap[y + x * map.height] = 0;
-				}
-			}
-		}
-	}
-
-	Uint32 standingOnTrap = 0; // 0 - not checked.
-
-	for ( entityNode = map.entities->first; entityNode != nullptr; entityNode = entityNode->next )
-	{
-		Entity* entity = (Entity*)entityNode->element;
-		if ( entity->flags[PASSABLE] )
-		{
-			if ( entity->behavior == &actSpearTrap 
-				&& (my->getRace() == HUMAN || my->monsterAllyGetPlayerLeader() ) )
-			{
-				// humans/followers know better than that!
 
-				// unless they're standing on a trap...
-				if ( standingOnTrap == 0 )
-				{
-					std::vector<list_t*> entLists = TileEntityList.getEntitiesWithinRadiusAroundEntity(my, 0);
-					for ( std::vector<list_t*>::iterator it = entLists.begin(); it != entLists.end() && !standingOnTrap; ++it )
-					{
-						list_t* currentList = *it;
-						node_t* node;
-						if ( currentList )
-						{
-							for ( node = currentList->first; node != nullptr && !standingOnTrap; node = node->next )
-							{
-								Entity* entity = (Entity*)node->element;
-								if ( entity && entity->behavior == &actSpearTrap )
-								{
-									standingOnTrap = 1; // 1 - standing on the trap.
-								}
-							}
-						}
-					}
-					if ( standingOnTrap == 0 )
-					{
-						standingOnTrap = 2; // 2 - have run the check but failed.
-					}
-				}
-				if ( standingOnTrap == 1 )
-				{
-					continue;
-				}
-			}
-			else
-			{
-				continue;
-			}
-		}
-		if ( entity->behavior == &actDoorFrame || entity->behavior == &actDoor || entity->behavior == &actMagicMissile )
-		{
-			continue;
-		}
-		if ( playerCheckPathToExit && entity->behavior == &actGate )
-		{
-			continue;
-		}
-		if ( entity == target || entity == my )
-		{
-			continue;
-		}
-		if ( entity->behavior == &actMonster && !my->checkEnemy(entity) )
-		{
-			continue;
-		}
-		if ( entity->behavior == &actPlayer && my->monsterAllyIndex >= 0 
-			&& (my->monsterTarget == 0 || my->monsterAllyState == ALLY_STATE_MOVETO) )
-		{
-			continue;
-		}
-		if ( lavaIsPassable &&
-			(entity->sprite == 41
-			|| lavatiles[map.tiles[static_cast<int>(entity->y / 16) * MAPLAYERS + static_cast<int>(entity->x / 16) * MAPLAYERS * map.height]]
-			|| swimmingtiles[map.tiles[static_cast<int>(entity->y / 16) * MAPLAYERS + static_cast<int>(entity->x / 16) * MAPLAYERS * map.height]])
-			)
-		{
-			//Fix to make ladders generate in hell.
-			continue;
-		}
-		if ( playerCheckAchievement &&
-			(entity->behavior == &actMonster || entity->behavior == &actPlayer) )
-		{
-			continue;
-		}
-		int x = std::min<unsigned int>(std::max<int>(0, entity->x / 16), map.width - 1); //TODO: Why are int and double being compared? And why are int and unsigned int being compared?
-		int y = std::min<unsigned int>(std::max<int>(0, entity->y / 16), map.height - 1); //TODO: Why are int and double being compared? And why are int and unsigned int being compared?
-		pathMap[y + x * map.height] = 0;
-	}
+	binaryheap[0] = NULL;
 
 	openList = (list_t*) malloc(sizeof(list_t));
 	openList->first = NULL;
@@ -360,9 +212,6 @@ list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target,
 	closedList = (list_t*) malloc(sizeof(list_t));
 	closedList->first = NULL;
 	closedList->last = NULL;
-	binaryheap = (pathnode_t**) malloc(sizeof(pathnode_t*)*map.width * map.height);
-	binaryheap[0] = NULL;
-
 	// create starting node in list
 	pathnode = newPathnode(openList, x1, y1, NULL, 1);
 	pathnode->g = 0;
@@ -409,8 +258,6 @@ list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target,
 			}
 			list_FreeAll(closedList);
 			free(closedList);
-			free(binaryheap);
-			free(pathMap);
 			return path;
 		}
 
@@ -424,7 +271,25 @@ list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target,
 					continue;
 				}
 				z = 0;
-				if ( !loading )
+				if ( terrain )
+				{
+					if ( pathTerrainBlocked(*terrain, ((pathnode->x + x) << 4) + 8, ((pathnode->y + y) << 4) + 8) )
+					{
+						z++;
+					}
+					if ( x && y )
+					{
+						if ( pathTerrainBlocked(*terrain, ((pathnode->x) << 4) + 8, ((pathnode->y + y) << 4) + 8) )
+						{
+							z++;
+						}
+						if ( pathTerrainBlocked(*terrain, ((pathnode->x + x) << 4) + 8, ((pathnode->y) << 4) + 8) )
+						{
+							z++;
+						}
+					}
+				}
+				else if ( !loading )
 				{
 					if ( !pathMap[(pathnode->y + y) + (pathnode->x + x)*map.height] )
 					{
@@ -505,8 +370,6 @@ list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target,
 							list_FreeAll(closedList);
 							free(openList);
 							free(closedList);
-							free(binaryheap);
-							free(pathMap);
 							return NULL;
 						}
 						childnode = newPathnode(openList, pathnode->x + x, pathnode->y + y, pathnode, 1);
@@ -531,333 +394,996 @@ list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target,
 	list_FreeAll(closedList);
 	free(openList);
 	free(closedList);
-	free(binaryheap);
-	free(pathMap);
 	return NULL;
 }
 
 /*-------------------------------------------------------------------------------
 
-	generatePathMaps
+	searchRoute
 
-	Maps out islands in the game map for the path generator
+	refines a route from PathGraphHandler::findRoute() into a full path by
+	searching from one waypoint to the next. returns NULL if any leg is
+	blocked, e.g. by a monster standing on an entrance
 
 -------------------------------------------------------------------------------*/
 
-void fillPathMap(int* pathMap, int x, int y, int zone);
-
-void generatePathMaps()
+static list_t* searchRoute(int* pathMap, pathnode_t** binaryheap, int x1, int y1, const std::vector<std::pair<int, int>>& waypoints, Entity* my, Entity* target)
 {
-	int x, y;
-
-	if ( pathMapGrounded )
-	{
-		free(pathMapGrounded);
-	}
-	pathMapGrounded = (int*) calloc(map.width * map.height, sizeof(int));
-	if ( pathMapFlying )
-	{
-		free(pathMapFlying);
-	}
-	pathMapFlying = (int*) calloc(map.width * map.height, sizeof(int));
-
-	pathMapZone = 1;
-	for ( y = 0; y < map.height; y++ )
+	list_t* path = (list_t*) malloc(sizeof(list_t));
+	path->first = NULL;
+	path->last = NULL;
+	pathnode_t* last = NULL;
+
+	int x = x1;
+	int y = y1;
+	for ( auto& waypoint : waypoints )
 	{
-		for ( x = 0; x < map.width; x++ )
+		if ( waypoint.first == x && waypoint.second == y )
 		{
-			if ( !pathMapGrounded[y + x * map.height] )
-			{
-				fillPathMap(pathMapGrounded, x, y, pathMapZone);
-			}
-			if ( !pathMapFlying[y + x * map.height] )
-			{
-				fillPathMap(pathMapFlying, x, y, pathMapZone);
-			}
+			continue;
+		}
+		list_t* leg = searchPath(pathMap, binaryheap, x, y, waypoint.first, waypoint.second, my, target);
+		if ( !leg )
+		{
+			list_FreeAll(path);
+			free(path);
+			return NULL;
+		}
+		for ( node_t* node = leg->first; node != NULL; node = node->next )
+		{
+			pathnode_t* pathnode = (pathnode_t*)node->element;
+			last = newPathnode(path, pathnode->x, pathnode->y, last, 1);
 		}
+		list_FreeAll(leg);
+		free(leg);
+		x = waypoint.first;
+		y = waypoint.second;
 	}
+	return path;
 }
 
-void fillPathMap(int* pathMap, int x, int y, int zone)
-{
-	bool obstacle = true;
+/*-------------------------------------------------------------------------------
 
-	int index = y * MAPLAYERS + x * MAPLAYERS * map.height;
-	if ( !map.tiles[OBSTACLELAYER + index] && map.tiles[index] 
-		&& !(swimmingtiles[map.tiles[index]] || lavatiles[map.tiles[index]]) )
+	generatePath
+
+	generates a path through the level using the A* pathfinding algorithm.
+	Takes a starting point and destination in map coordinates, and returns
+	a list of pathnodes which lead from the starting point to the destination.
+	If no path connecting the two positions is possible, generatePath returns
+	NULL.
+
+-------------------------------------------------------------------------------*/
+
+list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target, bool lavaIsPassable)
+{
+	if (!my)
 	{
-		obstacle = false;
+		return NULL;
 	}
-	else if ( pathMap == pathMapFlying && !map.tiles[OBSTACLELAYER + index] )
+
+	node_t* entityNode = NULL;
+
+	bool levitating = false;
+
+	x1 = std::min<unsigned int>(std::max(0, x1), map.width - 1);
+	y1 = std::min<unsigned int>(std::max(0, y1), map.height - 1);
+	x2 = std::min<unsigned int>(std::max(0, x2), map.width - 1);
+	y2 = std::min<unsigned int>(std::max(0, y2), map.height - 1); //TODO: Why are int and unsigned int being compared?
+
+	// get levitation status
+	Stat* stats = my->getStats();
+	if ( stats )
 	{
-		obstacle = false;
+		levitating = isLevitating(stats);
 	}
-	if ( obstacle == false )
+	if ( my )
 	{
-		node_t* node;
-		list_t* list = checkTileForEntity(x, y);
-		if ( list )
+		if ( my->behavior == &actItem || my->behavior == &actArrowTrap || my->behavior == &actBoulderTrap )
+		{
+			levitating = true;
+		}
+	}
+
+	// for boulders falling and checking if a player can reach the ladder.
+	bool playerCheckPathToExit = (my && my->behavior == &actPlayer
+		&& target && (target->behavior == &actLadder || target->behavior == &actPortal));
+	bool playerCheckAchievement = (my && my->behavior == &actPlayer
+		&& target && (target->behavior == &actBomb || target->behavior == &actPlayerLimb || target->behavior == &actItem || target->behavior == &actSwitch));
+
+	// bail out before copying the path map if the goal is on another island
+	if ( !loading )
+	{
+		if ( (x1 == x2 && y1 == y2) || !pathMapsConnected(x1, y1, x2, y2, levitating || playerCheckPathToExit) )
+		{
+			return NULL;
+		}
+	}
+
+	int* pathMap = (int*) calloc(map.width * map.height, sizeof(int));
+	if ( !loading )
+	{
+		if ( levitating || playerCheckPathToExit )
+		{
+			memcpy(pathMap, pathMapFlying, map.width * map.height * sizeof(int));
+		}
+		else
+		{
+			memcpy(pathMap, pathMapGrounded, map.width * map.height * sizeof(int));
+		}
+	}
+
+	// for boulders falling and checking if a player can reach the ladder.
+	// if we're not levitating, we use the flying path map (for water/lava) and here we remove the empty air tiles from the pathMap.
+	if ( playerCheckPathToExit && !levitating )
+	{
+		for ( int y = 0; y < map.height; ++y )
 		{
-			for ( node = list->first; node != NULL; node = node->next )
+			for ( int x = 0; x < map.width; ++x )
 			{
-				Entity* entity = (Entity*)node->element;
-				if ( entity )
+				if ( !map.tiles[y * MAPLAYERS + x * MAPLAYERS * map.height] )
 				{
-					if ( isPathObstacle(entity) )
-					{
-						obstacle = true;
-						break;
-					}
-					else if ( entity->behavior == &actWallBuilder || entity->behavior == &actWallBuster )
-					{
-						obstacle = false;
-						break;
-					}
+					pathMap[y + x * map.height] = 0;
 				}
 			}
-			//list_FreeAll(list);
-			//free(list);
 		}
 	}
 
-	if ( obstacle )
-	{
-		return;
-	}
+	Uint32 standingOnTrap = 0; // 0 - not checked.
 
-	pathMap[y + x * map.height] = zone;
-	bool repeat;
-	do
+	for ( entityNode = map.entities->first; entityNode != nullptr; entityNode = entityNode->next )
 	{
-		repeat = false;
-
-		int u, v;
-		for ( u = 0; u < map.width; u++ )
+		Entity* entity = (Entity*)entityNode->element;
+		if ( entity->flags[PASSABLE] )
 		{
-			for ( v = 0; v < map.height; v++ )
+			if ( entity->behavior == &actSpearTrap 
+				&& (my->getRace() == HUMAN || my->monsterAllyGetPlayerLeader() ) )
 			{
-				if ( pathMap[v + u * map.height] == zone )
+				// humans/followers know better than that!
+
+				// unless they're standing on a trap...
+				if ( standingOnTrap == 0 )
 				{
-					if ( u < map.width - 1 )
-					{
-						if ( !pathMap[v + (u + 1)*map.height] )
-						{
-							bool foundObstacle = false;
-							bool foundWallModifier = false;
-							list_t* list = checkTileForEntity(u + 1, v);
-							if ( list )
-							{
-								node_t* node;
-								for ( node = list->first; node != NULL; node = node->next )
-								{
-									Entity* entity = (Entity*)node->element;
-									if ( entity )
-									{
-										if ( isPathObstacle(entity) )
-										{
-											foundObstacle = true;
-											break;
-										}
-										else if ( entity->behavior == &actWallBuilder || entity->behavior == &actWallBuster )
-										{
-											foundWallModifier = true;
-											break;
-										}
-									}
-								}
-								if ( foundWallModifier )
-								{
-									pathMap[v + (u + 1)*map.height] = zone;
-									repeat = true;
-								}
-								//list_FreeAll(list);
-								//free(list);
-							}
-							if ( !foundWallModifier && !foundObstacle )
-							{
-								int index = v * MAPLAYERS + (u + 1) * MAPLAYERS * map.height;
-								if ( !map.tiles[OBSTACLELAYER + index] && (pathMap == pathMapFlying 
-									|| (map.tiles[index] && !(swimmingtiles[map.tiles[index]] || lavatiles[map.tiles[index]]) )) )
-								{
-									pathMap[v + (u + 1)*map.height] = zone;
-									repeat = true;
-								}
-							}
-						}
-					}
-					if ( u > 0 )
-					{
-						if ( !pathMap[v + (u - 1)*map.height] )
-						{
-							bool foundObstacle = false;
-							bool foundWallModifier = false;
-							list_t* list = checkTileForEntity(u - 1, v);
-							if ( list )
-							{
-								node_t* node;
-								for ( node = list->first; node != NULL; node = node->next )
-								{
-									Entity* entity = (Entity*)node->element;
-									if ( entity )
-									{
-										if ( isPathObstacle(entity) )
-										{
-											foundObstacle = true;
-											break;
-										}
-										else if ( entity->behavior == &actWallBuilder || entity->behavior == &actWallBuster )
-										{
-											foundWallModifier = true;
-											break;
-										}
-									}
-								}
-								if ( foundWallModifier )
-								{
-									pathMap[v + (u - 1)*map.height] = zone;
-									repeat = true;
-								}
-								//list_FreeAll(list);
-								//free(list);
-							}
-							if ( !foundWallModifier && !foundObstacle )
-							{
-								int index = v * MAPLAYERS + (u - 1) * MAPLAYERS * map.height;
-								if ( !map.tiles[OBSTACLELAYER + index] && (pathMap == pathMapFlying 
-									|| (map.tiles[index] && !(swimmingtiles[map.tiles[index]] || lavatiles[map.tiles[index]])) ) )
-								{
-									pathMap[v + (u - 1)*map.height] = zone;
-									repeat = true;
-								}
-							}
-						}
-					}
-					if ( v < map.height - 1 )
+					std::vector<list_t*> entLists = TileEntityList.getEntitiesWithinRadiusAroundEntity(my, 0);
+					for ( std::vector<list_t*>::iterator it = entLists.begin(); it != entLists.end() && !standingOnTrap; ++it )
 					{
-						if ( !pathMap[(v + 1) + u * map.height] )
+						list_t* currentList = *it;
+						node_t* node;
+						if ( currentList )
 						{
-							bool foundObstacle = false;
-							bool foundWallModifier = false;
-							list_t* list = checkTileForEntity(u, v + 1);
-							if ( list )
-							{
-								node_t* node;
-								for ( node = list->first; node != NULL; node = node->next )
-								{
-									Entity* entity = (Entity*)node->element;
-									if ( entity )
-									{
-										if ( isPathObstacle(entity) )
-										{
-											foundObstacle = true;
-											break;
-										}
-										else if ( entity->behavior == &actWallBuilder || entity->behavior == &actWallBuster )
-										{
-											foundWallModifier = true;
-											break;
-										}
-									}
-								}
-								if ( foundWallModifier )
-								{
-									pathMap[(v + 1) + u * map.height] = zone;
-									repeat = true;
-								}
-								//list_FreeAll(list);
-								//free(list);
-							}
-							if ( !foundWallModifier && !foundObstacle )
+							for ( node = currentList->first; node != nullptr && !standingOnTrap; node = node->next )
 							{
-								int index = (v + 1) * MAPLAYERS + u * MAPLAYERS * map.height;
-								if ( !map.tiles[OBSTACLELAYER + index] && (pathMap == pathMapFlying 
-									|| (map.tiles[index] && !(swimmingtiles[map.tiles[index]] || lavatiles[map.tiles[index]])) ) )
+								Entity* entity = (Entity*)node->element;
+								if ( entity && entity->behavior == &actSpearTrap )
 								{
-									pathMap[(v + 1) + u * map.height] = zone;
-									repeat = true;
+									standingOnTrap = 1; // 1 - standing on the trap.
 								}
 							}
 						}
 					}
-					if ( v > 0 )
+					if ( standingOnTrap == 0 )
 					{
-						if ( !pathMap[(v - 1) + u * map.height] )
-						{
-							bool foundObstacle = false;
-							bool foundWallModifier = false;
-							list_t* list = checkTileForEntity(u, v - 1);
-							if ( list )
-							{
-								node_t* node;
-								for ( node = list->first; node != NULL; node = node->next )
-								{
-									Entity* entity = (Entity*)node->element;
-									if ( entity )
-									{
-										if ( isPathObstacle(entity) )
-										{
-											foundObstacle = true;
-											break;
-										}
-										else if ( entity->behavior == &actWallBuilder || entity->behavior == &actWallBuster )
-										{
-											foundWallModifier = true;
-											break;
-										}
-									}
-								}
-								if ( foundWallModifier )
-								{
-									pathMap[(v - 1) + u * map.height] = zone;
-									repeat = true;
-								}
-								//list_FreeAll(list);
-								//free(list);
-							}
-							if ( !foundWallModifier && !foundObstacle )
-							{
-								int index = (v - 1) * MAPLAYERS + u * MAPLAYERS * map.height;
-								if ( !map.tiles[OBSTACLELAYER + index] && (pathMap == pathMapFlying 
-									|| (map.tiles[index] && !(swimmingtiles[map.tiles[index]] || lavatiles[map.tiles[index]]) )) )
-								{
-									pathMap[(v - 1) + u * map.height] = zone;
-									repeat = true;
-								}
-							}
-						}
+						standingOnTrap = 2; // 2 - have run the check but failed.
 					}
 				}
+				if ( standingOnTrap == 1 )
+				{
+					continue;
+				}
+			}
+			else
+			{
+				continue;
 			}
 		}
+		if ( entity->behavior == &actDoorFrame || entity->behavior == &actDoor || entity->behavior == &actMagicMissile )
+		{
+			continue;
+		}
+		if ( playerCheckPathToExit && entity->behavior == &actGate )
+		{
+			continue;
+		}
+		if ( entity == target || entity == my )
+		{
+			continue;
+		}
+		if ( entity->behavior == &actMonster && !my->checkEnemy(entity) )
+		{
+			continue;
+		}
+		if ( entity->behavior == &actPlayer && my->monsterAllyIndex >= 0 
+			&& (my->monsterTarget == 0 || my->monsterAllyState == ALLY_STATE_MOVETO) )
+		{
+			continue;
+		}
+		if ( lavaIsPassable &&
+			(entity->sprite == 41
+			|| lavatiles[map.tiles[static_cast<int>(entity->y / 16) * MAPLAYERS + static_cast<int>(entity->x / 16) * MAPLAYERS * map.height]]
+			|| swimmingtiles[map.tiles[static_cast<int>(entity->y / 16) * MAPLAYERS + static_cast<int>(entity->x / 16) * MAPLAYERS * map.height]])
+			)
+		{
+			//Fix to make ladders generate in hell.
+			continue;
+		}
+		if ( playerCheckAchievement &&
+			(entity->behavior == &actMonster || entity->behavior == &actPlayer) )
+		{
+			continue;
+		}
+		int x = std::min<unsigned int>(std::max<int>(0, entity->x / 16), map.width - 1); //TODO: Why are int and double being compared? And why are int and unsigned int being compared?
+		int y = std::min<unsigned int>(std::max<int>(0, entity->y / 16), map.height - 1); //TODO: Why are int and double being compared? And why are int and unsigned int being compared?
+		pathMap[y + x * map.height] = 0;
 	}
-	while ( repeat );
-	pathMapZone++;
+
+	pathnode_t** binaryheap = (pathnode_t**) malloc(sizeof(pathnode_t*)*map.width * map.height);
+
+	// long routes are planned over the cluster graph and searched one leg at a time
+	list_t* path = NULL;
+	std::vector<std::pair<int, int>> waypoints;
+	if ( !loading && !playerCheckPathToExit
+		&& heuristic(x1, y1, x2, y2) >= PathGraphHandler::kMinRouteDistance * STRAIGHTCOST
+		&& PathGraph.findRoute(x1, y1, x2, y2, levitating, waypoints) )
+	{
+		path = searchRoute(pathMap, binaryheap, x1, y1, waypoints, my, target);
+	}
+	if ( !path )
+	{
+		path = searchPath(pathMap, binaryheap, x1, y1, x2, y2, my, target);
+	}
+
+	free(binaryheap);
+	free(pathMap);
+	return path;
 }
 
+/*-------------------------------------------------------------------------------
+
+	generateTerrainPath
 
+	the path generatePath() finds while a level is loading, when nothing
+	is in TileEntityList yet and only the terrain can block it, searched
+	over the given map instead of the global one. generateDungeon() uses
+	it to check the exit can be reached from the start
 
-bool isPathObstacle(Entity* entity)
+-------------------------------------------------------------------------------*/
+
+list_t* generateTerrainPath(const map_t& onMap, int x1, int y1, int x2, int y2)
 {
-	if ( entity->behavior == &actHeadstone )
+	x1 = std::min<unsigned int>(std::max(0, x1), onMap.width - 1);
+	y1 = std::min<unsigned int>(std::max(0, y1), onMap.height - 1);
+	x2 = std::min<unsigned int>(std::max(0, x2), onMap.width - 1);
+	y2 = std::min<unsigned int>(std::max(0, y2), onMap.height - 1);
+
+	pathnode_t** binaryheap = (pathnode_t**) malloc(sizeof(pathnode_t*)*onMap.width * onMap.height);
+	list_t* path = searchPath(nullptr, binaryheap, x1, y1, x2, y2, nullptr, nullptr, &onMap);
+	free(binaryheap);
+	return path;
+}
+
+/*-------------------------------------------------------------------------------
+
+	generatePathMaps
+
+	Maps out islands in the game map for the path generator
+
+-------------------------------------------------------------------------------*/
+
+void fillPathMap(int* pathMap, int x, int y, int zone);
+
+void generatePathMaps()
+{
+	int x, y;
+
+	if ( pathMapGrounded )
 	{
-		return true;
+		free(pathMapGrounded);
 	}
-	else if(entity->behavior == &actSink )
+	pathMapGrounded = (int*) calloc(map.width * map.height, sizeof(int));
+	if ( pathMapFlying )
 	{
-		return true;
+		free(pathMapFlying);
 	}
-	else if ( entity->behavior == &actFountain )
+	pathMapFlying = (int*) calloc(map.width * map.height, sizeof(int));
+	PathGraph.invalidate();
+
+	pathMapZone = 1;
+	for ( y = 0; y < map.height; y++ )
 	{
-		return true;
+		for ( x = 0; x < map.width; x++ )
+		{
+			if ( !pathMapGrounded[y + x * map.height] )
+			{
+				fillPathMap(pathMapGrounded, x, y, pathMapZone);
+			}
+			if ( !pathMapFlying[y + x * map.height] )
+			{
+				fillPathMap(pathMapFlying, x, y, pathMapZone);
+			}
+		}
 	}
-	else if ( entity->behavior == &actPowerCrystal || entity->behavior == &actPowerCrystalBase )
+}
+
+// whether the floor and walls of a tile let a walker (or flyer) through
+static bool pathMapTerrainOpen(const int* pathMap, int x, int y)
+{
+	int index = y * MAPLAYERS + x * MAPLAYERS * map.height;
+	return !map.tiles[OBSTACLELAYER + index] && (pathMap == pathMapFlying
+		|| (map.tiles[index] && !(swimmingtiles[map.tiles[index]] || lavatiles[map.tiles[index]])));
+}
+
+// whether a zone spreads into this tile from a neighbour. wall builders
+// and busters keep their tile open whatever the terrain is
+static bool pathMapTileOpen(const int* pathMap, int x, int y)
+{
+	list_t* list = checkTileForEntity(x, y);
+	if ( list )
 	{
-		return true;
+		node_t* node;
+		for ( node = list->first; node != NULL; node = node->next )
+		{
+			Entity* entity = (Entity*)node->element;
+			if ( entity )
+			{
+				if ( isPathObstacle(entity) )
+				{
+					return false;
+				}
+				else if ( entity->behavior == &actWallBuilder || entity->behavior == &actWallBuster )
+				{
+					return true;
+				}
+			}
+		}
 	}
-	else if ( entity->behavior == &actPedestalBase || entity->behavior == &actPedestalOrb )
+	return pathMapTerrainOpen(pathMap, x, y);
+}
+
+// labels every tile connected to x, y with zone, overwriting whatever
+// zone they had before
+static void floodPathMap(int* pathMap, int x, int y, int zone)
+{
+	std::vector<int> open;
+	pathMap[y + x * map.height] = zone;
+	open.push_back(y + x * map.height);
+	while ( !open.empty() )
 	{
-		return true;
-	}
+		int u = open.back() / map.height;
+		int v = open.back() % map.height;
+		open.pop_back();
 
-	return false;
+		const int neighbours[4][2] = { { u + 1, v }, { u - 1, v }, { u, v + 1 }, { u, v - 1 } };
+		for ( int c = 0; c < 4; ++c )
+		{
+			int nx = neighbours[c][0];
+			int ny = neighbours[c][1];
+			if ( nx < 0 || ny < 0 || nx >= map.width || ny >= map.height )
+			{
+				continue;
+			}
+			int index = ny + nx * map.height;
+			if ( pathMap[index] != zone && pathMapTileOpen(pathMap, nx, ny) )
+			{
+				pathMap[index] = zone;
+				open.push_back(index);
+			}
+		}
+	}
+}
+
+void fillPathMap(int* pathMap, int x, int y, int zone)
+{
+	if ( !pathMapTerrainOpen(pathMap, x, y) || !pathMapTileOpen(pathMap, x, y) )
+	{
+		return;
+	}
+
+	floodPathMap(pathMap, x, y, zone);
+	pathMapZone++;
+}
+
+/*-------------------------------------------------------------------------------
+
+	updatePathMaps
+
+	Brings the path maps up to date after the tile at x, y has changed
+	(a wall dug out or put up). Only the islands touching that tile are
+	flooded again, with fresh zone numbers, so a merge or a split costs
+	the size of the islands involved rather than the whole map
+
+-------------------------------------------------------------------------------*/
+
+void updatePathMaps(int x, int y)
+{
+	if ( !pathMapGrounded || !pathMapFlying
+		|| x < 0 || y < 0 || x >= map.width || y >= map.height )
+	{
+		generatePathMaps();
+		return;
+	}
+
+	PathGraph.invalidateTile(x, y);
+
+	int* pathMaps[2] = { pathMapGrounded, pathMapFlying };
+	for ( int* pathMap : pathMaps )
+	{
+		const int firstNewZone = pathMapZone;
+		pathMap[y + x * map.height] = 0;
+		fillPathMap(pathMap, x, y, pathMapZone);
+
+		// the tile may have been the only link between its neighbours, so
+		// each side that hasn't been reached yet gets its own zone
+		const int neighbours[4][2] = { { x + 1, y }, { x - 1, y }, { x, y + 1 }, { x, y - 1 } };
+		for ( int c = 0; c < 4; ++c )
+		{
+			int nx = neighbours[c][0];
+			int ny = neighbours[c][1];
+			if ( nx < 0 || ny < 0 || nx >= map.width || ny >= map.height )
+			{
+				continue;
+			}
+			int zone = pathMap[ny + nx * map.height];
+			if ( zone && zone < firstNewZone )
+			{
+				floodPathMap(pathMap, nx, ny, pathMapZone);
+				pathMapZone++;
+			}
+		}
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	pathMapsConnected
+
+	Returns true if x2, y2 lies on the same island as x1, y1. Cheap enough
+	to call before committing to a search
+
+-------------------------------------------------------------------------------*/
+
+bool pathMapsConnected(int x1, int y1, int x2, int y2, bool flying)
+{
+	const int* pathMap = flying ? pathMapFlying : pathMapGrounded;
+	if ( !pathMap
+		|| x1 < 0 || y1 < 0 || x1 >= map.width || y1 >= map.height
+		|| x2 < 0 || y2 < 0 || x2 >= map.width || y2 >= map.height )
+	{
+		return false;
+	}
+	int zone = pathMap[y1 + x1 * map.height];
+	return zone != 0 && zone == pathMap[y2 + x2 * map.height];
+}
+
+bool isPathObstacle(Entity* entity)
+{
+	if ( entity->behavior == &actHeadstone )
+	{
+		return true;
+	}
+	else if(entity->behavior == &actSink )
+	{
+		return true;
+	}
+	else if ( entity->behavior == &actFountain )
+	{
+		return true;
+	}
+	else if ( entity->behavior == &actPowerCrystal || entity->behavior == &actPowerCrystalBase )
+	{
+		return true;
+	}
+	else if ( entity->behavior == &actPedestalBase || entity->behavior == &actPedestalOrb )
+	{
+		return true;
+	}
+
+	return false;
+}
+
+/*-------------------------------------------------------------------------------
+
+	PathGraphHandler
+
+-------------------------------------------------------------------------------*/
+
+PathGraphHandler PathGraph;
+const int PathGraphHandler::kClusterSize;
+const int PathGraphHandler::kMinRouteDistance;
+const int PathGraphHandler::kWideEntrance;
+const int PathGraphHandler::kMaxClusterNodes;
+
+static bool pathGraphTileOpen(const int* pathMap, int x, int y)
+{
+	return pathMap[y + x * map.height] != 0;
+}
+
+void PathGraphHandler::invalidate()
+{
+	for ( auto& layer : layers )
+	{
+		layer.clusters.clear();
+		layer.dirtyClusters = 0;
+	}
+	mapWidth = 0;
+	mapHeight = 0;
+}
+
+void PathGraphHandler::markDirty(int cluster)
+{
+	for ( auto& layer : layers )
+	{
+		if ( cluster >= 0 && cluster < static_cast<int>(layer.clusters.size()) && !layer.clusters[cluster].dirty )
+		{
+			layer.clusters[cluster].dirty = true;
+			++layer.dirtyClusters;
+		}
+	}
+}
+
+void PathGraphHandler::invalidateTile(int x, int y)
+{
+	if ( mapWidth != map.width || mapHeight != map.height )
+	{
+		invalidate();
+		return;
+	}
+
+	// a changed tile can open up its neighbours too (see fillPathMap), and
+	// each of those can sit on a border shared with the next cluster over
+	for ( int u = std::max(0, x - 2); u <= std::min(mapWidth - 1, x + 2); ++u )
+	{
+		for ( int v = std::max(0, y - 2); v <= std::min(mapHeight - 1, y + 2); ++v )
+		{
+			markDirty(clusterAt(u, v));
+		}
+	}
+}
+
+void PathGraphHandler::clusterBounds(int cluster, int& x0, int& y0, int& x1, int& y1) const
+{
+	x0 = (cluster % clustersWide) * kClusterSize;
+	y0 = (cluster / clustersWide) * kClusterSize;
+	x1 = std::min(x0 + kClusterSize, mapWidth);
+	y1 = std::min(y0 + kClusterSize, mapHeight);
+}
+
+/*-------------------------------------------------------------------------------
+
+	PathGraphHandler::borderEntrances
+
+	walks length tiles from ax, ay along dx, dy, pairing each with the tile
+	at nx, ny across the border. every run of open pairs is an entrance;
+	the tiles on the near side are appended to out, or the far side if
+	far is set, so both clusters agree on where the entrances are
+
+-------------------------------------------------------------------------------*/
+
+void PathGraphHandler::borderEntrances(const int* pathMap, int ax, int ay, int nx, int ny, int dx, int dy, int length, bool far,
+	std::vector<std::pair<int, int>>& out) const
+{
+	int run = 0;
+	for ( int i = 0; i <= length; ++i )
+	{
+		if ( i < length )
+		{
+			int x = ax + dx * i;
+			int y = ay + dy * i;
+			if ( pathGraphTileOpen(pathMap, x, y) && pathGraphTileOpen(pathMap, x + nx, y + ny) )
+			{
+				++run;
+				continue;
+			}
+		}
+		if ( run > 0 )
+		{
+			int first = i - run;
+			int last = i - 1;
+			int picks[2] = { (first + last) / 2, -1 };
+			if ( run >= kWideEntrance )
+			{
+				picks[0] = first;
+				picks[1] = last;
+			}
+			for ( int pick : picks )
+			{
+				if ( pick >= 0 )
+				{
+					out.push_back(std::make_pair(ax + dx * pick + (far ? nx : 0), ay + dy * pick + (far ? ny : 0)));
+				}
+			}
+			run = 0;
+		}
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	PathGraphHandler::clusterCosts
+
+	Dijkstra from x, y over the open tiles of one cluster, with the same
+	moves generatePath() allows. costs is indexed by the tile's offset in
+	the cluster, (y - y0) + (x - x0) * kClusterSize
+
+-------------------------------------------------------------------------------*/
+
+void PathGraphHandler::clusterCosts(const int* pathMap, int cluster, int x, int y, std::vector<Uint32>& costs) const
+{
+	int x0, y0, x1, y1;
+	clusterBounds(cluster, x0, y0, x1, y1);
+	costs.assign(kClusterSize * kClusterSize, UINT32_MAX);
+
+	typedef std::pair<Uint32, int> Open_t;
+	std::priority_queue<Open_t, std::vector<Open_t>, std::greater<Open_t>> open;
+	costs[(y - y0) + (x - x0) * kClusterSize] = 0;
+	open.push(Open_t(0, (y - y0) + (x - x0) * kClusterSize));
+	while ( !open.empty() )
+	{
+		Open_t current = open.top();
+		open.pop();
+		if ( current.first > costs[current.second] )
+		{
+			continue;
+		}
+		int u = x0 + current.second / kClusterSize;
+		int v = y0 + current.second % kClusterSize;
+		for ( int dx = -1; dx <= 1; ++dx )
+		{
+			for ( int dy = -1; dy <= 1; ++dy )
+			{
+				int nx = u + dx;
+				int ny = v + dy;
+				if ( (!dx && !dy) || nx < x0 || ny < y0 || nx >= x1 || ny >= y1 )
+				{
+					continue;
+				}
+				if ( !pathGraphTileOpen(pathMap, nx, ny) )
+				{
+					continue;
+				}
+				if ( dx && dy && (!pathGraphTileOpen(pathMap, nx, v) || !pathGraphTileOpen(pathMap, u, ny)) )
+				{
+					continue;
+				}
+				Uint32 cost = current.first + ((dx && dy) ? DIAGONALCOST : STRAIGHTCOST);
+				int index = (ny - y0) + (nx - x0) * kClusterSize;
+				if ( cost < costs[index] )
+				{
+					costs[index] = cost;
+					open.push(Open_t(cost, index));
+				}
+			}
+		}
+	}
+}
+
+void PathGraphHandler::rebuildCluster(Cluster_t& cluster, int index, const int* pathMap)
+{
+	int x0, y0, x1, y1;
+	clusterBounds(index, x0, y0, x1, y1);
+
+	std::vector<std::pair<int, int>> entrances;
+	if ( x1 < mapWidth )
+	{
+		borderEntrances(pathMap, x1 - 1, y0, 1, 0, 0, 1, y1 - y0, false, entrances);
+	}
+	if ( y1 < mapHeight )
+	{
+		borderEntrances(pathMap, x0, y1 - 1, 0, 1, 1, 0, x1 - x0, false, entrances);
+	}
+	if ( x0 > 0 )
+	{
+		borderEntrances(pathMap, x0 - 1, y0, 1, 0, 0, 1, y1 - y0, true, entrances);
+	}
+	if ( y0 > 0 )
+	{
+		borderEntrances(pathMap, x0, y0 - 1, 0, 1, 1, 0, x1 - x0, true, entrances);
+	}
+	std::sort(entrances.begin(), entrances.end());
+	entrances.erase(std::unique(entrances.begin(), entrances.end()), entrances.end());
+	if ( static_cast<int>(entrances.size()) > kMaxClusterNodes )
+	{
+		entrances.resize(kMaxClusterNodes);
+	}
+
+	cluster.nodes.clear();
+	for ( auto& entrance : entrances )
+	{
+		Node_t node;
+		node.x = entrance.first;
+		node.y = entrance.second;
+		cluster.nodes.push_back(node);
+	}
+
+	std::vector<Uint32> costs;
+	for ( auto& node : cluster.nodes )
+	{
+		clusterCosts(pathMap, index, node.x, node.y, costs);
+		for ( size_t c = 0; c < cluster.nodes.size(); ++c )
+		{
+			const Node_t& other = cluster.nodes[c];
+			Uint32 cost = costs[(other.y - y0) + (other.x - x0) * kClusterSize];
+			if ( &other != &node && cost != UINT32_MAX )
+			{
+				Edge_t edge;
+				edge.node = static_cast<int>(c);
+				edge.cost = cost;
+				node.edges.push_back(edge);
+			}
+		}
+	}
+	cluster.dirty = false;
+	++clustersRebuilt;
+}
+
+void PathGraphHandler::prepareLayer(Layer_t& layer, const int* pathMap)
+{
+	if ( mapWidth != map.width || mapHeight != map.height )
+	{
+		invalidate();
+		mapWidth = map.width;
+		mapHeight = map.height;
+		clustersWide = (mapWidth + kClusterSize - 1) / kClusterSize;
+		clustersHigh = (mapHeight + kClusterSize - 1) / kClusterSize;
+	}
+	if ( layer.clusters.empty() )
+	{
+		layer.clusters.resize(clustersWide * clustersHigh);
+		layer.dirtyClusters = static_cast<int>(layer.clusters.size());
+	}
+	if ( layer.dirtyClusters == 0 )
+	{
+		return;
+	}
+	for ( size_t c = 0; c < layer.clusters.size(); ++c )
+	{
+		if ( layer.clusters[c].dirty )
+		{
+			rebuildCluster(layer.clusters[c], static_cast<int>(c), pathMap);
+		}
+	}
+	layer.dirtyClusters = 0;
+}
+
+int PathGraphHandler::findNode(const Layer_t& layer, int cluster, int x, int y) const
+{
+	const Cluster_t& c = layer.clusters[cluster];
+	for ( size_t i = 0; i < c.nodes.size(); ++i )
+	{
+		if ( c.nodes[i].x == x && c.nodes[i].y == y )
+		{
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+/*-------------------------------------------------------------------------------
+
+	PathGraphHandler::findRoute
+
+	A* over the entrance nodes. the start and goal are joined to the nodes
+	of their own clusters through clusterCosts(), and nodes facing each
+	other across a border are one straight step apart
+
+-------------------------------------------------------------------------------*/
+
+bool PathGraphHandler::findRoute(int x1, int y1, int x2, int y2, bool flying, std::vector<std::pair<int, int>>& waypoints)
+{
+	waypoints.clear();
+	const int* pathMap = flying ? pathMapFlying : pathMapGrounded;
+	if ( !enabled || !pathMap || !pathMapsConnected(x1, y1, x2, y2, flying) )
+	{
+		return false;
+	}
+
+	Layer_t& layer = layers[flying ? 1 : 0];
+	prepareLayer(layer, pathMap);
+
+	const int startCluster = clusterAt(x1, y1);
+	const int goalCluster = clusterAt(x2, y2);
+	if ( startCluster == goalCluster )
+	{
+		return false;
+	}
+
+	std::vector<Uint32> startCosts;
+	std::vector<Uint32> goalCosts;
+	int sx0, sy0, sx1, sy1;
+	int gx0, gy0, gx1, gy1;
+	clusterBounds(startCluster, sx0, sy0, sx1, sy1);
+	clusterBounds(goalCluster, gx0, gy0, gx1, gy1);
+	clusterCosts(pathMap, startCluster, x1, y1, startCosts);
+	clusterCosts(pathMap, goalCluster, x2, y2, goalCosts);
+
+	// node ids are cluster * kMaxClusterNodes + index, the goal gets its own
+	const int goalId = -1;
+	typedef std::pair<Uint32, int> Open_t;
+	std::priority_queue<Open_t, std::vector<Open_t>, std::greater<Open_t>> open;
+	std::unordered_map<int, Uint32> costs;
+	std::unordered_map<int, int> parents;
+
+	auto visit = [&](int id, int parent, Uint32 cost, int x, int y)
+	{
+		auto found = costs.find(id);
+		if ( found != costs.end() && found->second <= cost )
+		{
+			return;
+		}
+		costs[id] = cost;
+		parents[id] = parent;
+		open.push(Open_t(cost + heuristic(x, y, x2, y2), id));
+	};
+
+	const Cluster_t& start = layer.clusters[startCluster];
+	for ( size_t c = 0; c < start.nodes.size(); ++c )
+	{
+		Uint32 cost = startCosts[(start.nodes[c].y - sy0) + (start.nodes[c].x - sx0) * kClusterSize];
+		if ( cost != UINT32_MAX )
+		{
+			visit(startCluster * kMaxClusterNodes + static_cast<int>(c), -2, cost, start.nodes[c].x, start.nodes[c].y);
+		}
+	}
+
+	bool found = false;
+	while ( !open.empty() )
+	{
+		Open_t current = open.top();
+		open.pop();
+		if ( current.second == goalId )
+		{
+			found = true;
+			break;
+		}
+		const int cluster = current.second / kMaxClusterNodes;
+		const Node_t& node = layer.clusters[cluster].nodes[current.second % kMaxClusterNodes];
+		const Uint32 cost = costs[current.second];
+		if ( current.first > cost + heuristic(node.x, node.y, x2, y2) )
+		{
+			continue; // stale entry
+		}
+
+		if ( cluster == goalCluster )
+		{
+			Uint32 goalCost = goalCosts[(node.y - gy0) + (node.x - gx0) * kClusterSize];
+			if ( goalCost != UINT32_MAX )
+			{
+				visit(goalId, current.second, cost + goalCost, x2, y2);
+			}
+		}
+		for ( auto& edge : node.edges )
+		{
+			const Node_t& other = layer.clusters[cluster].nodes[edge.node];
+			visit(cluster * kMaxClusterNodes + edge.node, current.second, cost + edge.cost, other.x, other.y);
+		}
+		const int sides[4][2] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+		for ( auto& side : sides )
+		{
+			int nx = node.x + side[0];
+			int ny = node.y + side[1];
+			if ( nx < 0 || ny < 0 || nx >= mapWidth || ny >= mapHeight || clusterAt(nx, ny) == cluster )
+			{
+				continue;
+			}
+			int neighbour = findNode(layer, clusterAt(nx, ny), nx, ny);
+			if ( neighbour >= 0 )
+			{
+				visit(clusterAt(nx, ny) * kMaxClusterNodes + neighbour, current.second, cost + STRAIGHTCOST, nx, ny);
+			}
+		}
+	}
+	if ( !found )
+	{
+		return false;
+	}
+
+	waypoints.push_back(std::make_pair(x2, y2));
+	for ( int id = parents[goalId]; id >= 0; id = parents[id] )
+	{
+		const Node_t& node = layer.clusters[id / kMaxClusterNodes].nodes[id % kMaxClusterNodes];
+		waypoints.push_back(std::make_pair(node.x, node.y));
+	}
+	std::reverse(waypoints.begin(), waypoints.end());
+	return true;
+}
+
+/*-------------------------------------------------------------------------------
+
+	PathGraphHandler::benchmark
+
+	picks tile pairs at least kMinRouteDistance apart on the island under
+	my, then times generatePath() over all of them with the hierarchy
+	switched off and on. the pairs come from a private prng stream so the
+	game's own sequence is left alone
+
+-------------------------------------------------------------------------------*/
+
+PathGraphHandler::BenchmarkResult_t PathGraphHandler::benchmark(Entity* my, int queries)
+{
+	BenchmarkResult_t result;
+	if ( !my || !pathMapGrounded )
+	{
+		return result;
+	}
+	int x = std::min<int>(std::max<int>(0, my->x / 16), map.width - 1);
+	int y = std::min<int>(std::max<int>(0, my->y / 16), map.height - 1);
+	int zone = pathMapGrounded[y + x * map.height];
+	std::vector<std::pair<int, int>> tiles;
+	for ( int u = 0; u < map.width; ++u )
+	{
+		for ( int v = 0; v < map.height; ++v )
+		{
+			if ( zone && pathMapGrounded[v + u * map.height] == zone )
+			{
+				tiles.push_back(std::make_pair(u, v));
+			}
+		}
+	}
+	if ( tiles.size() < 2 )
+	{
+		return result;
+	}
+
+	PrngStream_t stream;
+	stream.seedBytes(&mapseed, sizeof(mapseed));
+	std::vector<std::pair<std::pair<int, int>, std::pair<int, int>>> pairs;
+	for ( int tries = 0; tries < queries * 100 && static_cast<int>(pairs.size()) < queries; ++tries )
+	{
+		auto& a = tiles[stream.getUint() % tiles.size()];
+		auto& b = tiles[stream.getUint() % tiles.size()];
+		if ( abs(a.first - b.first) + abs(a.second - b.second) >= kMinRouteDistance )
+		{
+			pairs.push_back(std::make_pair(a, b));
+		}
+	}
+	result.queries = static_cast<int>(pairs.size());
+
+	auto t0 = std::chrono::high_resolution_clock::now();
+	layers[0].clusters.clear();
+	prepareLayer(layers[0], pathMapGrounded);
+	auto t1 = std::chrono::high_resolution_clock::now();
+	result.msBuild = 1000 * std::chrono::duration_cast<std::chrono::duration<double>>(t1 - t0).count();
+
+	const bool wasEnabled = enabled;
+	for ( int pass = 0; pass < 2; ++pass )
+	{
+		enabled = (pass == 1);
+		int& found = enabled ? result.foundHierarchical : result.foundDirect;
+		auto start = std::chrono::high_resolution_clock::now();
+		for ( auto& pair : pairs )
+		{
+			list_t* path = generatePath(pair.first.first, pair.first.second, pair.second.first, pair.second.second, my, nullptr);
+			if ( path )
+			{
+				++found;
+				list_FreeAll(path);
+				free(path);
+			}
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		double& ms = enabled ? result.msHierarchical : result.msDirect;
+		ms = 1000 * std::chrono::duration_cast<std::chrono::duration<double>>(end - start).count();
+	}
+	enabled = wasEnabled;
+	return result;
+}
+
+void PathGraphHandler::logStatus() const
+{
+	const char* names[2] = { "grounded", "flying" };
+	for ( int c = 0; c < 2; ++c )
+	{
+		size_t nodes = 0;
+		size_t edges = 0;
+		for ( auto& cluster : layers[c].clusters )
+		{
+			nodes += cluster.nodes.size();
+			for ( auto& node : cluster.nodes )
+			{
+				edges += node.edges.size();
+			}
+		}
+		printlog("[PATHS]: %s graph: %d clusters (%d dirty), %d nodes, %d edges",
+			names[c], static_cast<int>(layers[c].clusters.size()), layers[c].dirtyClusters,
+			static_cast<int>(nodes), static_cast<int>(edges));
+	}
+	printlog("[PATHS]: %d clusters rebuilt since startup", clustersRebuilt);
 }
@@ -18,6 +18,97 @@ extern int pathMapZone;
 // function prototypes
 Uint32 heuristic(int x1, int y1, int x2, int y2);
 list_t* generatePath(int x1, int y1, int x2, int y2, Entity* my, Entity* target, bool lavaIsPassable = false);
+list_t* generateTerrainPath(const map_t& onMap, int x1, int y1, int x2, int y2);
 void generatePathMaps();
+void updatePathMaps(int x, int y); // call after the tile at x, y changes
+bool pathMapsConnected(int x1, int y1, int x2, int y2, bool flying);
 // return true if an entity is blocks pathing
 bool isPathObstacle(Entity* entity);
+
+/*-------------------------------------------------------------------------------
+
+	PathGraphHandler
+
+	coarse graph over the island maps for long routes (HPA*). the map is cut
+	into kClusterSize square clusters; every run of open tiles crossing a
+	cluster border gets an entrance node on each side, and the nodes of a
+	cluster are linked by their walking cost inside it. generatePath() finds
+	a route through these nodes first and then only has to search between
+	consecutive waypoints, which keeps each search well inside its budget.
+
+	clusters are rebuilt lazily: generatePathMaps() throws the whole graph
+	away and updatePathMaps() only the clusters around the changed tile.
+
+-------------------------------------------------------------------------------*/
+
+class PathGraphHandler
+{
+public:
+	static const int kClusterSize = 16;
+	static const int kMinRouteDistance = 2 * kClusterSize; // in tiles, shorter queries are searched directly
+
+	bool enabled = true;
+
+	// fills waypoints with the entrance tiles to walk through, ending with
+	// x2, y2. returns false if the hierarchy can't help with this query
+	bool findRoute(int x1, int y1, int x2, int y2, bool flying, std::vector<std::pair<int, int>>& waypoints);
+	void invalidate();
+	void invalidateTile(int x, int y);
+
+	struct BenchmarkResult_t
+	{
+		int queries = 0;
+		int foundDirect = 0;
+		int foundHierarchical = 0;
+		double msDirect = 0.0;
+		double msHierarchical = 0.0;
+		double msBuild = 0.0;
+	};
+	// times generatePath() with and without the hierarchy between random
+	// far apart tiles of the same island
+	BenchmarkResult_t benchmark(Entity* my, int queries);
+	void logStatus() const;
+private:
+	struct Edge_t
+	{
+		int node = 0; // index into the same cluster's nodes
+		Uint32 cost = 0;
+	};
+	struct Node_t
+	{
+		int x = 0;
+		int y = 0;
+		std::vector<Edge_t> edges;
+	};
+	struct Cluster_t
+	{
+		std::vector<Node_t> nodes;
+		bool dirty = true;
+	};
+	struct Layer_t
+	{
+		std::vector<Cluster_t> clusters;
+		int dirtyClusters = 0;
+	};
+
+	static const int kWideEntrance = 6; // runs this long get a node at both ends
+	static const int kMaxClusterNodes = 4 * kClusterSize;
+
+	Layer_t layers[2]; // grounded, flying
+	int mapWidth = 0;
+	int mapHeight = 0;
+	int clustersWide = 0;
+	int clustersHigh = 0;
+	int clustersRebuilt = 0;
+
+	int clusterAt(int x, int y) const { return (x / kClusterSize) + (y / kClusterSize) * clustersWide; }
+	void clusterBounds(int cluster, int& x0, int& y0, int& x1, int& y1) const;
+	void markDirty(int cluster);
+	void prepareLayer(Layer_t& layer, const int* pathMap);
+	void rebuildCluster(Cluster_t& cluster, int index, const int* pathMap);
+	void borderEntrances(const int* pathMap, int ax, int ay, int nx, int ny, int dx, int dy, int length, bool far,
+		std::vector<std::pair<int, int>>& out) const;
+	void clusterCosts(const int* pathMap, int cluster, int x, int y, std::vector<Uint32>& costs) const;
+	int findNode(const Layer_t& layer, int cluster, int x, int y) const;
+};
+extern PathGraphHandler PathGraph;
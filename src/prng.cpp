@@ -3,7 +3,8 @@
  * pseudo-random number generator based on the alleged RC4
  * cipher.  This PRNG should be suitable for most general-purpose
  * uses.  Not recommended for cryptographic or financial
- * purposes.  Not thread-safe.
+ * purposes.  Not thread-safe: each PrngStream_t is
+ * independent, but one stream must stay on one thread.
  */
 
 /*
@@ -39,20 +40,25 @@
  *
  */
 
+#include "main.hpp"
+#include "game.hpp"
+#include "entity.hpp"
+#include "paths.hpp"
+#include "scores.hpp"
+#include "files.hpp"
+#include "net.hpp"
+#include "json.hpp"
 #include "prng.hpp"
-#include "SDL.h"
+#include "level_prefetch.hpp"
 #include <assert.h>
+#include <atomic>
 #include <float.h>
 #include <limits.h>
 #include <math.h>
+#include <string.h>
 #include <time.h>
 
-/* RC4-based pseudo-random state. */
-static unsigned char s[256];
-static Sint32 s_i, s_j;
-
-/* Nonzero if PRNG has been seeded. */
-static int seeded;
+PrngStream_t prng_main;
 
 /* Swap bytes that A and B point to. */
 #define SWAP_BYTE(A, B)                         \
@@ -66,8 +72,8 @@ static int seeded;
    time.
 
    If the user calls neither this function nor prng_seed_bytes()
-   before any prng_get*() function, this function is called
-   automatically to obtain a time-based seed. */
+   before any prng_get*() function, a time-based seed is picked
+   automatically. */
 void
 prng_seed_time (void)
 {
@@ -121,38 +127,14 @@ get_octet (const void* bytes_, size_t n_bytes, size_t octet_idx)
 void
 prng_seed_bytes (const void* key, size_t size)
 {
-	Sint32 i, j;
-
-	assert (key != NULL && size > 0);
-
-	for (i = 0; i < 256; i++)
-	{
-		s[i] = i;
-	}
-	for (i = j = 0; i < 256; i++)
-	{
-		j = (j + s[i] + get_octet (key, size, i)) & 255;
-		SWAP_BYTE (s + i, s + j);
-	}
-
-	s_i = s_j = 0;
-	seeded = 1;
+	prng_main.seedBytes(key, size);
 }
 
 /* Returns a pseudo-random integer in the range [0, 255]. */
 unsigned char
 prng_get_octet (void)
 {
-	if (!seeded)
-	{
-		prng_seed_time ();
-	}
-
-	s_i = (s_i + 1) & 255;
-	s_j = (s_j + s[s_i]) & 255;
-	SWAP_BYTE (s + s_i, s + s_j);
-
-	return s[(s[s_i] + s[s_j]) & 255];
+	return prng_main.getOctet();
 }
 
 /* Returns a pseudo-random integer in the range [0, UCHAR_MAX]. */
@@ -162,24 +144,19 @@ prng_get_byte (void)
 	unsigned char byte;
 	Sint32 bits;
 
-	byte = prng_get_octet ();
+	byte = prng_main.getOctet ();
 	for (bits = 8; bits < CHAR_BIT; bits += 8)
 	{
-		byte = (byte << 8) | prng_get_octet ();
+		byte = (byte << 8) | prng_main.getOctet ();
 	}
 	return byte;
 }
 
 /* Fills BUF with SIZE pseudo-random bytes. */
 void
-prng_get_bytes (void* buf_, size_t size)
+prng_get_bytes (void* buf, size_t size)
 {
-	unsigned char* buf;
-
-	for (buf = static_cast<unsigned char* >(buf_); size-- > 0; buf++)
-	{
-		*buf = prng_get_byte ();
-	}
+	prng_main.getBytes(buf, size);
 }
 
 /* Returns a pseudo-random unsigned long in the range [0,
@@ -187,22 +164,14 @@ prng_get_bytes (void* buf_, size_t size)
 unsigned long
 prng_get_ulong (void)
 {
-	unsigned long ulng;
-	size_t bits;
-
-	ulng = prng_get_octet ();
-	for (bits = 8; bits < CHAR_BIT * sizeof ulng; bits += 8)
-	{
-		ulng = (ulng << 8) | prng_get_octet ();
-	}
-	return ulng;
+	return prng_main.getUlong();
 }
 
 /* Returns a pseudo-random long in the range [0, LONG_MAX]. */
 long
 prng_get_long (void)
 {
-	return prng_get_ulong () & LONG_MAX;
+	return prng_main.getLong();
 }
 
 /* Returns a pseudo-random unsigned int in the range [0,
@@ -210,32 +179,195 @@ prng_get_long (void)
 Uint32
 prng_get_uint (void)
 {
-	Uint32 uint;
-	size_t bits;
-
-	uint = prng_get_octet ();
-	for (bits = 8; bits < CHAR_BIT * sizeof uint; bits += 8)
-	{
-		uint = (uint << 8) | prng_get_octet ();
-	}
-	return uint;
+	return prng_main.getUint();
 }
 
 /* Returns a pseudo-random int in the range [0, INT_MAX]. */
 int
 prng_get_int (void)
 {
-	return prng_get_uint () & INT_MAX;
+	return prng_main.getInt();
 }
 
 /* Returns a pseudo-random floating-point number from the uniform
    distribution with range [0,1). */
 double
 prng_get_double (void)
+{
+	return prng_main.getDouble();
+}
+
+/* Returns a pseudo-random floating-point number from the
+   distribution with mean 0 and standard deviation 1.  (Multiply
+   the result by the desired standard deviation, then add the
+   desired mean.) */
+double
+prng_get_double_normal (void)
+{
+	return prng_main.getDoubleNormal();
+}
+
+/*-------------------------------------------------------------------------------
+
+	PrngStream_t
+
+-------------------------------------------------------------------------------*/
+
+PrngStream_t::PrngStream_t()
+{
+	for ( int i = 0; i < 256; ++i )
+	{
+		s[i] = i;
+	}
+	memset(buffer, 0, sizeof(buffer));
+}
+
+void PrngStream_t::seedBytes(const void* key, size_t size)
+{
+	Sint32 i, j;
+
+	assert (key != NULL && size > 0);
+
+	for (i = 0; i < 256; i++)
+	{
+		s[i] = i;
+	}
+	for (i = j = 0; i < 256; i++)
+	{
+		j = (j + s[i] + get_octet (key, size, i)) & 255;
+		SWAP_BYTE (s + i, s + j);
+	}
+
+	s_i = s_j = 0;
+	seeded = true;
+	bufferPos = kBlockSize; // anything generated under the old key is stale
+}
+
+void PrngStream_t::seedTime()
+{
+	// streams seeded in the same second still get different keys
+	static std::atomic<Uint32> counter(0);
+	struct
+	{
+		time_t t;
+		Uint32 n;
+	} key;
+	memset(&key, 0, sizeof(key));
+	key.t = time(NULL);
+	key.n = counter++;
+	seedBytes(&key, sizeof(key));
+}
+
+/* The RC4 output loop, run over SIZE bytes with the indices kept
+   in registers.  Byte for byte the same as one swap per call. */
+void PrngStream_t::generate(unsigned char* out, size_t size)
+{
+	if ( !seeded )
+	{
+		seedTime();
+	}
+
+	Sint32 i = s_i;
+	Sint32 j = s_j;
+	for ( size_t n = 0; n < size; ++n )
+	{
+		i = (i + 1) & 255;
+		j = (j + s[i]) & 255;
+		SWAP_BYTE (s + i, s + j);
+		out[n] = s[(s[i] + s[j]) & 255];
+	}
+	s_i = i;
+	s_j = j;
+}
+
+void PrngStream_t::refill()
+{
+	generate(buffer, kBlockSize);
+	bufferPos = 0;
+}
+
+void PrngStream_t::getBytes(void* buf_, size_t size)
+{
+	unsigned char* buf = static_cast<unsigned char*>(buf_);
+
+	// drain what's buffered first so the sequence stays in order
+	size_t buffered = kBlockSize - bufferPos;
+	if ( buffered > 0 )
+	{
+		size_t n = size < buffered ? size : buffered;
+		memcpy(buf, buffer + bufferPos, n);
+		bufferPos += n;
+		buf += n;
+		size -= n;
+	}
+	if ( size == 0 )
+	{
+		return;
+	}
+
+	// whole blocks go straight to the caller
+	size_t direct = size - (size % kBlockSize);
+	if ( direct > 0 )
+	{
+		generate(buf, direct);
+		buf += direct;
+		size -= direct;
+	}
+	if ( size > 0 )
+	{
+		refill();
+		memcpy(buf, buffer, size);
+		bufferPos = size;
+	}
+}
+
+/* Octets are taken most significant first, as prng_get_uint()
+   always has. */
+Uint32 PrngStream_t::getUint()
+{
+	if ( bufferPos + 4 <= kBlockSize )
+	{
+		const unsigned char* b = buffer + bufferPos;
+		bufferPos += 4;
+		return (static_cast<Uint32>(b[0]) << 24)
+			| (static_cast<Uint32>(b[1]) << 16)
+			| (static_cast<Uint32>(b[2]) << 8)
+			| static_cast<Uint32>(b[3]);
+	}
+
+	Uint32 uint = getOctet();
+	for ( size_t bits = 8; bits < CHAR_BIT * sizeof uint; bits += 8 )
+	{
+		uint = (uint << 8) | getOctet();
+	}
+	return uint;
+}
+
+int PrngStream_t::getInt()
+{
+	return getUint() & INT_MAX;
+}
+
+unsigned long PrngStream_t::getUlong()
+{
+	unsigned long ulng = getOctet();
+	for ( size_t bits = 8; bits < CHAR_BIT * sizeof ulng; bits += 8 )
+	{
+		ulng = (ulng << 8) | getOctet();
+	}
+	return ulng;
+}
+
+long PrngStream_t::getLong()
+{
+	return getUlong() & LONG_MAX;
+}
+
+double PrngStream_t::getDouble()
 {
 	for (;;)
 	{
-		double dbl = prng_get_ulong () / (ULONG_MAX + 1.0);
+		double dbl = getUlong() / (ULONG_MAX + 1.0);
 		if (dbl >= 0.0 && dbl < 1.0)
 		{
 			return dbl;
@@ -243,38 +375,26 @@ prng_get_double (void)
 	}
 }
 
-/* Returns a pseudo-random floating-point number from the
-   distribution with mean 0 and standard deviation 1.  (Multiply
-   the result by the desired standard deviation, then add the
-   desired mean.) */
-double
-prng_get_double_normal (void)
+double PrngStream_t::getDoubleNormal()
 {
 	/* Knuth, _The Art of Computer Programming_, Vol. 2, 3.4.1C,
 	   Algorithm P. */
-	static Sint32 has_next = 0;
-	static double next_normal;
 	double this_normal;
 
-	if (has_next)
+	if ( hasNextNormal )
 	{
-		this_normal = next_normal;
-		has_next = 0;
+		this_normal = nextNormal;
+		hasNextNormal = false;
 	}
 	else
 	{
-		static double limit;
+		static const double limit = log (DBL_MAX / 2) / (DBL_MAX / 2);
 		double v1, v2, s;
 
-		if (limit == 0.0)
-		{
-			limit = log (DBL_MAX / 2) / (DBL_MAX / 2);
-		}
-
 		for (;;)
 		{
-			double u1 = prng_get_double ();
-			double u2 = prng_get_double ();
+			double u1 = getDouble ();
+			double u2 = getDouble ();
 			v1 = 2.0 * u1 - 1.0;
 			v2 = 2.0 * u2 - 1.0;
 			s = v1 * v1 + v2 * v2;
@@ -285,9 +405,434 @@ prng_get_double_normal (void)
 		}
 
 		this_normal = v1 * sqrt (-2. * log (s) / s);
-		next_normal = v2 * sqrt (-2. * log (s) / s);
-		has_next = 1;
+		nextNormal = v2 * sqrt (-2. * log (s) / s);
+		hasNextNormal = true;
 	}
 
 	return this_normal;
 }
+
+/*-------------------------------------------------------------------------------
+
+	prng_selftest
+
+	compares PrngStream_t against the original one-byte-per-call RC4 with
+	the same key, reading through every getter in an interleaved order so
+	buffer boundaries land mid-value. dungeon generation only sees the
+	byte sequence, so matching bytes means existing seeds make the same
+	dungeons.
+
+-------------------------------------------------------------------------------*/
+
+namespace
+{
+	// the generator as it was before streams, kept as the reference
+	struct ReferenceRc4_t
+	{
+		unsigned char s[256];
+		Sint32 s_i = 0;
+		Sint32 s_j = 0;
+
+		ReferenceRc4_t(const void* key, size_t size)
+		{
+			Sint32 i, j;
+			for ( i = 0; i < 256; i++ )
+			{
+				s[i] = i;
+			}
+			for ( i = j = 0; i < 256; i++ )
+			{
+				j = (j + s[i] + get_octet(key, size, i)) & 255;
+				SWAP_BYTE(s + i, s + j);
+			}
+		}
+		unsigned char octet()
+		{
+			s_i = (s_i + 1) & 255;
+			s_j = (s_j + s[s_i]) & 255;
+			SWAP_BYTE(s + s_i, s + s_j);
+			return s[(s[s_i] + s[s_j]) & 255];
+		}
+		Uint32 uint()
+		{
+			Uint32 uint = octet();
+			for ( size_t bits = 8; bits < CHAR_BIT * sizeof uint; bits += 8 )
+			{
+				uint = (uint << 8) | octet();
+			}
+			return uint;
+		}
+		unsigned long ulong()
+		{
+			unsigned long ulng = octet();
+			for ( size_t bits = 8; bits < CHAR_BIT * sizeof ulng; bits += 8 )
+			{
+				ulng = (ulng << 8) | octet();
+			}
+			return ulng;
+		}
+	};
+}
+
+/*-------------------------------------------------------------------------------
+
+	dungeon hashes
+
+	the generator tests above only show the bytes haven't changed. these
+	hash what generateDungeon() builds from them, so a change to the
+	generator or to how map generation draws from it shows up as a
+	different dungeon. the hashes depend on the map data files, so they
+	are recorded beside them in data/prngtest_dungeons.json by
+	/prngtest record, and compared against by /prngtest. each level is
+	also built the way the level prefetch worker builds it, which has to
+	come out the same.
+
+-------------------------------------------------------------------------------*/
+
+namespace
+{
+	struct DungeonHash_t
+	{
+		std::string levelset;
+		Sint32 level = 1;
+		bool secret = false;
+		Uint32 seed = 0;
+		Uint32 tiles = 0;
+		Uint32 entities = 0;
+
+		void serialize(FileInterface* file)
+		{
+			file->property("levelset", levelset);
+			file->property("level", level);
+			file->property("secret", secret);
+			file->property("seed", seed);
+			file->property("tiles", tiles);
+			file->property("entities", entities);
+		}
+	};
+
+	struct DungeonHashes_t
+	{
+		std::vector<DungeonHash_t> dungeons;
+
+		void serialize(FileInterface* file)
+		{
+			int version = 1;
+			file->property("version", version);
+			file->property("dungeons", dungeons);
+		}
+	};
+
+	// fnv-1a, 32 bits so the values fit the json reader
+	void hashBytes(Uint32& hash, const void* data, size_t size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for ( size_t n = 0; n < size; ++n )
+		{
+			hash ^= bytes[n];
+			hash *= 16777619u;
+		}
+	}
+
+	// hashes a generated level's tiles and the sprite and position of each entity
+	void hashLevel(const map_t& level, Uint32& tiles, Uint32& entities, Uint32& rolls)
+	{
+		tiles = 2166136261u;
+		hashBytes(tiles, &level.width, sizeof(level.width));
+		hashBytes(tiles, &level.height, sizeof(level.height));
+		hashBytes(tiles, level.tiles, sizeof(Sint32) * level.width * level.height * MAPLAYERS);
+
+		entities = 2166136261u;
+		rolls = 2166136261u;
+		for ( node_t* node = level.entities->first; node != nullptr; node = node->next )
+		{
+			Entity* entity = static_cast<Entity*>(node->element);
+			Sint32 values[3] = { entity->sprite, static_cast<Sint32>(entity->x), static_cast<Sint32>(entity->y) };
+			hashBytes(entities, values, sizeof(values));
+
+			// creatures' stats roll from the stat stream, which isn't recorded
+			// but has to come out the same when staged
+			hashBytes(rolls, &entity->monsterStoreType, sizeof(entity->monsterStoreType));
+			node_t* statNode = entity->children.first ? entity->children.first->next : nullptr;
+			if ( statNode && statNode->element && statNode->deconstructor == &statDeconstructor )
+			{
+				Stat* stats = static_cast<Stat*>(statNode->element);
+				Sint32 statValues[3] = { static_cast<Sint32>(stats->sex), static_cast<Sint32>(stats->appearance), stats->HP };
+				hashBytes(rolls, statValues, sizeof(statValues));
+			}
+		}
+	}
+
+	// generates the recorded level into map and hashes it, then checks the level
+	// prefetch worker's staged generation builds the same level. returns false
+	// if the level couldn't be generated
+	bool hashDungeon(DungeonHash_t& dungeon, bool& stagedMatches)
+	{
+		currentlevel = dungeon.level;
+		secretlevel = dungeon.secret;
+		char levelset[64];
+		snprintf(levelset, sizeof(levelset), "%s", dungeon.levelset.c_str());
+		if ( generateDungeon(levelset, dungeon.seed) < 0 )
+		{
+			return false;
+		}
+		Uint32 rolls = 0;
+		hashLevel(map, dungeon.tiles, dungeon.entities, rolls);
+
+		StagedLevel_t staged;
+		staged.seed = dungeon.seed;
+		staged.level = dungeon.level;
+		staged.secret = dungeon.secret;
+		staged.svFlags = svFlags;
+		staged.obituary = language[1500];
+		for ( int c = 0; c < MAXPLAYERS; ++c )
+		{
+			if ( !client_disconnected[c] )
+			{
+				++staged.players;
+			}
+		}
+		Uint32 tiles = 0;
+		Uint32 entities = 0;
+		Uint32 stagedRolls = 0;
+		if ( generateDungeon(levelset, dungeon.seed, std::make_tuple(-1, -1, -1, 0), &staged) >= 0 )
+		{
+			hashLevel(staged.map, tiles, entities, stagedRolls);
+		}
+		stagedMatches = (tiles == dungeon.tiles && entities == dungeon.entities && stagedRolls == rolls);
+		return true;
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	prng_selftest_dungeons
+
+	generating a dungeon replaces the current level and the state that
+	goes with it, so this only runs from the title screen and puts a title
+	map back afterwards, the same way returning to the title does.
+
+-------------------------------------------------------------------------------*/
+
+static bool prng_selftest_dungeons(bool record)
+{
+	if ( !intro )
+	{
+		printlog("[PRNG]: dungeon hashes skipped, they can only be checked from the title screen");
+		return true;
+	}
+
+	DungeonHashes_t recorded;
+	if ( record )
+	{
+		// a floor from each level set, plus a secret level
+		static const struct
+		{
+			const char* levelset;
+			int level;
+			bool secret;
+		} cases[] = {
+			{ "mine", 1, false },
+			{ "mine", 3, false },
+			{ "swamp", 6, false },
+			{ "labyrinth", 11, false },
+			{ "ruins", 16, false },
+			{ "hell", 21, false },
+			{ "underworld", 3, true }
+		};
+		static const Uint32 seeds[] = { 1, 12345, 0xDEADBEEF };
+		for ( auto& c : cases )
+		{
+			for ( Uint32 seed : seeds )
+			{
+				DungeonHash_t dungeon;
+				dungeon.levelset = c.levelset;
+				dungeon.level = c.level;
+				dungeon.secret = c.secret;
+				dungeon.seed = seed;
+				recorded.dungeons.push_back(dungeon);
+			}
+		}
+	}
+	else
+	{
+		if ( !PHYSFS_getRealDir("/data/prngtest_dungeons.json") )
+		{
+			printlog("[PRNG]: dungeon hashes skipped, no data/prngtest_dungeons.json. /prngtest record writes one");
+			return true;
+		}
+		std::string inputPath = PHYSFS_getRealDir("/data/prngtest_dungeons.json");
+		inputPath.append("/data/prngtest_dungeons.json");
+		if ( !FileHelper::readObject(inputPath.c_str(), recorded) )
+		{
+			printlog("[PRNG]: self test failed, couldn't read %s", inputPath.c_str());
+			return false;
+		}
+	}
+
+	const int oldLevel = currentlevel;
+	const bool oldSecret = secretlevel;
+	const bool oldDarkmap = darkmap;
+	const int oldMinotaurLevel = minotaurlevel;
+	const Uint32 oldMapseed = mapseed;
+	const Uint32 oldEntityUids = entity_uids;
+	const Sint32 oldModded = conductGameChallenges[CONDUCT_MODDED];
+	const PrngStream_t oldPrng = prng_main;
+
+	bool ok = true;
+	for ( DungeonHash_t& expected : recorded.dungeons )
+	{
+		DungeonHash_t dungeon = expected;
+		bool stagedMatches = false;
+		if ( !hashDungeon(dungeon, stagedMatches) )
+		{
+			printlog("[PRNG]: self test failed, couldn't generate level set '%s'", dungeon.levelset.c_str());
+			ok = false;
+			continue;
+		}
+		if ( !stagedMatches )
+		{
+			printlog("[PRNG]: self test failed, level set '%s' floor %d seed %u came out differently when staged by the level prefetch",
+				dungeon.levelset.c_str(), dungeon.level, dungeon.seed);
+			ok = false;
+		}
+		if ( record )
+		{
+			expected = dungeon;
+		}
+		else if ( dungeon.tiles != expected.tiles || dungeon.entities != expected.entities )
+		{
+			printlog("[PRNG]: self test failed, level set '%s' floor %d seed %u made tiles %08x entities %08x, recorded %08x %08x",
+				dungeon.levelset.c_str(), dungeon.level, dungeon.seed, dungeon.tiles, dungeon.entities, expected.tiles, expected.entities);
+			ok = false;
+		}
+	}
+
+	currentlevel = oldLevel;
+	secretlevel = oldSecret;
+	darkmap = oldDarkmap;
+	minotaurlevel = oldMinotaurLevel;
+	mapseed = oldMapseed;
+	entity_uids = oldEntityUids;
+	conductGameChallenges[CONDUCT_MODDED] = oldModded;
+	prng_main = oldPrng;
+
+	loadMainMenuMap(false, false);
+	for ( int c = 0; c < MAXPLAYERS; ++c )
+	{
+		cameras[c].vang = 0;
+	}
+	numplayers = 0;
+	assignActions(&map);
+	generatePathMaps();
+
+	if ( record && ok )
+	{
+		std::string outputPath = outputdir;
+		outputPath.append("/data/prngtest_dungeons.json");
+		if ( FileHelper::writeObject(outputPath.c_str(), EFileFormat::Json, recorded) )
+		{
+			printlog("[PRNG]: recorded %d dungeon hashes to %s", static_cast<int>(recorded.dungeons.size()), outputPath.c_str());
+		}
+		else
+		{
+			printlog("[PRNG]: couldn't write %s", outputPath.c_str());
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+bool prng_selftest(bool recordDungeons)
+{
+	// published RC4 keystreams
+	static const struct
+	{
+		const char* key;
+		unsigned char stream[10];
+		size_t len;
+	} vectors[] = {
+		{ "Key", { 0xEB, 0x9F, 0x77, 0x81, 0xB7, 0x34, 0xCA, 0x72, 0xA7, 0x19 }, 10 },
+		{ "Wiki", { 0x60, 0x44, 0xDB, 0x6D, 0x41, 0xB7 }, 6 },
+		{ "Secret", { 0x04, 0xD4, 0x6B, 0x05, 0x3C, 0xA8, 0x7B, 0x59 }, 8 }
+	};
+	bool ok = true;
+	for ( auto& v : vectors )
+	{
+		PrngStream_t stream;
+		stream.seedBytes(v.key, strlen(v.key));
+		for ( size_t n = 0; n < v.len; ++n )
+		{
+			unsigned char octet = stream.getOctet();
+			if ( octet != v.stream[n] )
+			{
+				printlog("[PRNG]: self test failed, key \"%s\" byte %d is %02x, expected %02x", v.key, (int)n, octet, v.stream[n]);
+				ok = false;
+				break;
+			}
+		}
+	}
+
+	// map seeds are a Uint32 key, as in generateDungeon()
+	static const Uint32 seeds[] = { 0, 1, 12345, 0xDEADBEEF, 0xFFFFFFFF };
+	unsigned char bulk[1000];
+	unsigned char expected[sizeof(bulk)];
+	for ( Uint32 seed : seeds )
+	{
+		PrngStream_t stream;
+		stream.seedBytes(&seed, sizeof(seed));
+		ReferenceRc4_t reference(&seed, sizeof(seed));
+		for ( int round = 0; round < 200 && ok; ++round )
+		{
+			const char* what = nullptr;
+			switch ( round % 5 )
+			{
+				case 0:
+					if ( stream.getOctet() != reference.octet() )
+					{
+						what = "octet";
+					}
+					break;
+				case 1:
+				case 2:
+					if ( stream.getUint() != reference.uint() )
+					{
+						what = "uint";
+					}
+					break;
+				case 3:
+					if ( stream.getUlong() != reference.ulong() )
+					{
+						what = "ulong";
+					}
+					break;
+				case 4:
+				{
+					size_t size = (round * 37) % sizeof(bulk);
+					stream.getBytes(bulk, size);
+					for ( size_t n = 0; n < size; ++n )
+					{
+						expected[n] = reference.octet();
+					}
+					if ( memcmp(bulk, expected, size) )
+					{
+						what = "bytes";
+					}
+					break;
+				}
+			}
+			if ( what )
+			{
+				printlog("[PRNG]: self test failed, seed %u diverged at round %d (%s)", seed, round, what);
+				ok = false;
+			}
+		}
+	}
+
+	// only record dungeons from a generator that passed
+	if ( ok || !recordDungeons )
+	{
+		ok = prng_selftest_dungeons(recordDungeons && ok) && ok;
+	}
+	return ok;
+}
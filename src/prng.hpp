@@ -24,3 +24,70 @@ Uint32 prng_get_uint (void);
 int prng_get_int (void);
 double prng_get_double (void);
 double prng_get_double_normal (void);
+
+/*-------------------------------------------------------------------------------
+
+	PrngStream_t
+
+	an independent RC4 generator. each stream has its own state, so a
+	subsystem or worker thread can own one without touching the sequence
+	the others see. a stream seeded with the same key as the prng_*()
+	functions produces the same bytes, in the same order.
+
+	bytes are generated a block at a time into a small buffer, and the
+	getters read from it. this gives the same sequence as one swap per
+	call and is much cheaper for bulk requests. a stream must only be used
+	from one thread at a time.
+
+	the prng_*() functions above all read from prng_main.
+
+-------------------------------------------------------------------------------*/
+
+class PrngStream_t
+{
+public:
+	PrngStream_t();
+
+	void seedBytes(const void* key, size_t size);
+	void seedTime();
+	bool isSeeded() const { return seeded; }
+
+	unsigned char getOctet()
+	{
+		if ( bufferPos >= kBlockSize )
+		{
+			refill();
+		}
+		return buffer[bufferPos++];
+	}
+	void getBytes(void* buf, size_t size);
+	Uint32 getUint();
+	int getInt();
+	unsigned long getUlong();
+	long getLong();
+	double getDouble();
+	double getDoubleNormal();
+private:
+	static const size_t kBlockSize = 256;
+
+	unsigned char s[256];
+	Sint32 s_i = 0;
+	Sint32 s_j = 0;
+	bool seeded = false;
+
+	unsigned char buffer[kBlockSize];
+	size_t bufferPos = kBlockSize; // empty
+
+	bool hasNextNormal = false;
+	double nextNormal = 0.0;
+
+	void generate(unsigned char* out, size_t size);
+	void refill();
+};
+extern PrngStream_t prng_main;
+
+// checks RC4 known-answer vectors and that block generation matches the
+// byte at a time generator, then that generateDungeon() still builds the
+// dungeons recorded in data/prngtest_dungeons.json. returns false and logs
+// on a mismatch. recordDungeons rewrites that file instead of comparing
+bool prng_selftest(bool recordDungeons = false);
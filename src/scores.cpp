@@ -660,8 +660,8 @@ void saveAllScores(const std::string& scoresfilename)
 		}
 		for ( c = 0; c < NUMEFFECTS; c++ )
 		{
-			fp->write(&score->stats->EFFECTS[c], sizeof(bool), 1);
-			fp->write(&score->stats->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+			fp->write(score->stats->EFFECTS.data() + c, sizeof(bool), 1);
+			fp->write(score->stats->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 		}
 		for ( c = 0; c < NUM_CONDUCT_CHALLENGES; ++c )
 		{
@@ -1043,8 +1043,8 @@ void loadAllScores(const std::string& scoresfilename)
 			{
 				if ( c < 16 )
 				{
-					fp->read(&score->stats->EFFECTS[c], sizeof(bool), 1);
-					fp->read(&score->stats->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+					fp->read(score->stats->EFFECTS.data() + c, sizeof(bool), 1);
+					fp->read(score->stats->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 				}
 				else
 				{
@@ -1059,8 +1059,8 @@ void loadAllScores(const std::string& scoresfilename)
 			{
 				if ( c < 19 )
 				{
-					fp->read(&score->stats->EFFECTS[c], sizeof(bool), 1);
-					fp->read(&score->stats->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+					fp->read(score->stats->EFFECTS.data() + c, sizeof(bool), 1);
+					fp->read(score->stats->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 				}
 				else
 				{
@@ -1075,8 +1075,8 @@ void loadAllScores(const std::string& scoresfilename)
 			{
 				if ( c < 32 )
 				{
-					fp->read(&score->stats->EFFECTS[c], sizeof(bool), 1);
-					fp->read(&score->stats->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+					fp->read(score->stats->EFFECTS.data() + c, sizeof(bool), 1);
+					fp->read(score->stats->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 				}
 				else
 				{
@@ -1089,8 +1089,8 @@ void loadAllScores(const std::string& scoresfilename)
 		{
 			for ( c = 0; c < NUMEFFECTS; c++ )
 			{
-				fp->read(&score->stats->EFFECTS[c], sizeof(bool), 1);
-				fp->read(&score->stats->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+				fp->read(score->stats->EFFECTS.data() + c, sizeof(bool), 1);
+				fp->read(score->stats->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 			}
 		}
 
@@ -1422,8 +1422,8 @@ int saveGame(int saveIndex)
 		}
 		for ( c = 0; c < NUMEFFECTS; c++ )
 		{
-			fp->write(&stats[player]->EFFECTS[c], sizeof(bool), 1);
-			fp->write(&stats[player]->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+			fp->write(stats[player]->EFFECTS.data() + c, sizeof(bool), 1);
+			fp->write(stats[player]->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 		}
 		for ( c = 0; c < 32; c++ )
 		{
@@ -1782,8 +1782,8 @@ int saveGame(int saveIndex)
 					}
 					for ( j = 0; j < NUMEFFECTS; j++ )
 					{
-						fp->write(&followerStats->EFFECTS[j], sizeof(bool), 1);
-						fp->write(&followerStats->EFFECTS_TIMERS[j], sizeof(Sint32), 1);
+						fp->write(followerStats->EFFECTS.data() + j, sizeof(bool), 1);
+						fp->write(followerStats->EFFECTS_TIMERS.data() + j, sizeof(Sint32), 1);
 					}
 					for ( j = 0; j < 32; ++j )
 					{
@@ -2261,8 +2261,8 @@ int loadGame(int player, int saveIndex)
 		{
 			if ( c < 32 )
 			{
-				fp->read(&stats[player]->EFFECTS[c], sizeof(bool), 1);
-				fp->read(&stats[player]->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+				fp->read(stats[player]->EFFECTS.data() + c, sizeof(bool), 1);
+				fp->read(stats[player]->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 			}
 			else
 			{
@@ -2272,8 +2272,8 @@ int loadGame(int player, int saveIndex)
 		}
 		else
 		{
-			fp->read(&stats[player]->EFFECTS[c], sizeof(bool), 1);
-			fp->read(&stats[player]->EFFECTS_TIMERS[c], sizeof(Sint32), 1);
+			fp->read(stats[player]->EFFECTS.data() + c, sizeof(bool), 1);
+			fp->read(stats[player]->EFFECTS_TIMERS.data() + c, sizeof(Sint32), 1);
 		}
 	}
 	if ( versionNumber >= 323 )
@@ -2669,8 +2669,8 @@ list_t* loadGameFollowers(int saveIndex)
 				{
 					if ( c < 32 )
 					{
-						fp->read(&followerStats->EFFECTS[j], sizeof(bool), 1);
-						fp->read(&followerStats->EFFECTS_TIMERS[j], sizeof(Sint32), 1);
+						fp->read(followerStats->EFFECTS.data() + j, sizeof(bool), 1);
+						fp->read(followerStats->EFFECTS_TIMERS.data() + j, sizeof(Sint32), 1);
 					}
 					else
 					{
@@ -2680,8 +2680,8 @@ list_t* loadGameFollowers(int saveIndex)
 				}
 				else
 				{
-					fp->read(&followerStats->EFFECTS[j], sizeof(bool), 1);
-					fp->read(&followerStats->EFFECTS_TIMERS[j], sizeof(Sint32), 1);
+					fp->read(followerStats->EFFECTS.data() + j, sizeof(bool), 1);
+					fp->read(followerStats->EFFECTS_TIMERS.data() + j, sizeof(Sint32), 1);
 				}
 			}
 			if ( versionNumber >= 323 )
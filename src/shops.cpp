@@ -21,6 +21,7 @@
 #include "scores.hpp"
 
 list_t* shopInv[MAXPLAYERS] = { nullptr };
+InventoryIndex shopInvIndex[MAXPLAYERS]; // for the client's copies of shopInv, the server uses the shopkeeper's
 Uint32 shopkeeper[MAXPLAYERS] = { 0 };
 Uint32 shoptimer[MAXPLAYERS] = { 0 };
 char* shopspeech[MAXPLAYERS] = { nullptr };
@@ -92,6 +93,7 @@ void startTradingServer(Entity* entity, int player)
 		players[player]->closeAllGUIs(DONT_CHANGE_SHOOTMODE, CLOSEGUI_DONT_CLOSE_SHOP);
 		players[player]->openStatusScreen(GUI_MODE_SHOP, INVENTORY_MODE_ITEM);
 		shopInv[player] = &stats->inventory;
+		attachInventoryIndex(&stats->inventory, &stats->inventoryIndex); // stays attached until the shopkeeper's Stat is freed
 		shopkeeper[player] = entity->getUID();
 		shoptimer[player] = ticks - 1;
 		shopspeech[player] = language[194 + rand() % 3];
@@ -571,22 +573,33 @@ void buyItemFromMysteriousShopkeepConsumeOrb(const int player, Entity& entity, I
 	}
 	if ( inventory )
 	{
-		for ( auto orbCategories : shopkeeperMysteriousItems )
+		for ( auto& orbCategories : shopkeeperMysteriousItems )
 		{
 			if ( orbCategories.second.find(boughtItem.type) != orbCategories.second.end() )
 			{
 				// item is part of an orb set. need to consume the orb.
-				node_t* nextnode = nullptr;
-				for ( node_t* node = inventory->first; node; node = nextnode )
+				node_t* orbNode = nullptr;
+				if ( InventoryIndex* index = getInventoryIndex(inventory) )
 				{
-					nextnode = node->next;
-					Item* orb = (Item*)node->element;
-					if ( orb && orb->type == orbCategories.first )
+					orbNode = index->findFirst(*inventory, orbCategories.first, -1);
+				}
+				else
+				{
+					for ( node_t* node = inventory->first; node; node = node->next )
 					{
-						consumeItem(orb, -1);
-						break;
+						Item* orb = (Item*)node->element;
+						if ( orb && orb->type == orbCategories.first )
+						{
+							orbNode = node;
+							break;
+						}
 					}
 				}
+				if ( orbNode )
+				{
+					Item* orb = (Item*)orbNode->element;
+					consumeItem(orb, -1);
+				}
 				break;
 			}
 		}
@@ -18,6 +18,7 @@
 #define NUMCHITCHAT 20
 
 extern list_t* shopInv[MAXPLAYERS];
+extern InventoryIndex shopInvIndex[MAXPLAYERS];
 extern Uint32 shopkeeper[MAXPLAYERS];
 extern Uint32 shoptimer[MAXPLAYERS];
 extern char* shopspeech[MAXPLAYERS];
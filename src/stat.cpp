@@ -20,6 +20,7 @@
 #include "player.hpp"
 
 Stat* stats[MAXPLAYERS];
+bool Stat::debugCheckDerivedStats = false;
 
 
 //Destructor
@@ -157,12 +158,15 @@ Stat::~Stat()
 	}
 	list_FreeAll(&this->magic_effects);
 	list_FreeAll(&this->inventory);
+	detachInventoryIndex(&this->inventory);
 }
 
 void Stat::clearStats()
 {
 	int x;
 
+	invalidateDerivedStats();
+
 	strcpy(this->obituary, language[1500]);
 	this->poisonKiller = 0;
 	this->HP = DEFAULT_HP;
@@ -669,7 +673,7 @@ void Stat::printStats()
 	printlog("Effects & timers: ");
 	for (int i = 0; i < NUMEFFECTS; ++i)
 	{
-		printlog("[%d] = %s. timer[%d] = %d", i, (this->EFFECTS[i]) ? "true" : "false", i, this->EFFECTS_TIMERS[i]);
+		printlog("[%d] = %s. timer[%d] = %d", i, (this->EFFECTS[i]) ? "true" : "false", i, static_cast<int>(this->EFFECTS_TIMERS[i]));
 	}
 }
 
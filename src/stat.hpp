@@ -16,6 +16,7 @@
 #endif
 
 class Item;
+class Entity;
 enum Monster : int;
 //enum Item;
 //enum Status;
@@ -178,6 +179,98 @@ typedef enum
 	FEMALE
 } sex_t;
 
+// lookup tables over an inventory list, rebuilt on the next lookup after the list changes.
+// only kept up to date while attached to its list with attachInventoryIndex(): list.cpp marks attached lists dirty
+// on insert/remove, anything changing an item's uid or type in place must call markDirty().
+class InventoryIndex
+{
+	bool dirty = true;
+	node_t* builtFirst = nullptr;
+	node_t* builtLast = nullptr;
+	std::vector<node_t*> nodes; // list order
+	std::unordered_map<Uint32, node_t*> byUid;
+	std::unordered_map<int, std::vector<int>> byType; // indices into nodes, ascending
+	std::unordered_map<int, std::vector<int>> byCategory;
+
+	void update(list_t& inventory);
+public:
+	void markDirty() { dirty = true; }
+
+	node_t* findUid(list_t& inventory, Uint32 uid);
+	// first node in list order whose type is itemType, or whose category is cat (either may be -1 to skip)
+	node_t* findFirst(list_t& inventory, int itemType, int cat);
+	// first node in list order of the given category that passes check, position is set to its place in the list
+	node_t* findFirstInCategory(list_t& inventory, int cat, const std::function<bool(const Item&)>& check, int* position = nullptr);
+	// places in the list of every item of the given type or category, ascending. valid until the list next changes
+	const std::vector<int>& positionsOfType(list_t& inventory, int itemType);
+	const std::vector<int>& positionsInCategory(list_t& inventory, int cat);
+	node_t* nodeAt(int position) const { return nodes[position]; }
+};
+
+// EFFECTS[] and EFFECTS_TIMERS[] of a Stat. they index like the plain arrays
+// they replace, but every write that changes an entry counts up getVersion(),
+// so the derived stat cache can tell an effect was set or cleared since it
+// last computed a stat, whatever wrote it
+template <typename T>
+class StatEffectArray_t
+{
+public:
+	class Ref
+	{
+	public:
+		Ref(T& value, Uint32& version) : value(value), version(version) {}
+		operator T() const { return value; }
+		Ref& operator=(T newValue)
+		{
+			if ( value != newValue )
+			{
+				value = newValue;
+				++version;
+			}
+			return *this;
+		}
+		Ref& operator=(const Ref& other) { return *this = static_cast<T>(other); }
+		Ref& operator+=(T amount) { return *this = value + amount; }
+		Ref& operator-=(T amount) { return *this = value - amount; }
+		Ref& operator*=(T amount) { return *this = value * amount; }
+		Ref& operator/=(T amount) { return *this = value / amount; }
+		Ref& operator++() { return *this = value + 1; }
+		Ref& operator--() { return *this = value - 1; }
+		T operator++(int) { T old = value; *this = value + 1; return old; }
+		T operator--(int) { T old = value; *this = value - 1; return old; }
+	private:
+		T& value;
+		Uint32& version;
+	};
+
+	Ref operator[](int effect) { return Ref(values[effect], version); }
+	T operator[](int effect) const { return values[effect]; }
+	Uint32 getVersion() const { return version; }
+
+	// for reading and writing saves. writes through the pointer aren't seen,
+	// so asking for it counts as a change
+	T* data()
+	{
+		++version;
+		return values;
+	}
+private:
+	T values[NUMEFFECTS];
+	Uint32 version = 0;
+};
+
+// the random rolls a new Stat makes for its sex, appearance and default
+// stats, and the obituary it starts with. left empty they come from rand()
+// and language[1500]; a floor built by the level prefetch worker passes its
+// own stream and a copy of the obituary taken on the main thread
+struct StatRolls_t
+{
+	std::function<int()> rng; // 0 to RAND_MAX, like rand()
+	const char* obituary = nullptr;
+
+	int roll() const { return rng ? rng() : rand(); }
+};
+
 class Stat
 {
 public:
@@ -208,8 +301,8 @@ public:
 
 	// skills and effects
 	Sint32 PROFICIENCIES[NUMPROFICIENCIES];
-	bool EFFECTS[NUMEFFECTS];
-	Sint32 EFFECTS_TIMERS[NUMEFFECTS];
+	StatEffectArray_t<bool> EFFECTS;
+	StatEffectArray_t<Sint32> EFFECTS_TIMERS;
 	bool defending;
 	Sint32& sneaking; // MISC_FLAGS[1]
 	Sint32& allyItemPickup; // MISC_FLAGS[2]
@@ -239,6 +332,7 @@ public:
 
 	// equipment
 	list_t inventory;
+	InventoryIndex inventoryIndex; // only kept up to date while attached to inventory (players, and shopkeepers while trading)
 	Item* helmet;
 	Item* breastplate;
 	Item* gloves;
@@ -259,7 +353,43 @@ public:
 	int monster_idlevar;
 
 	list_t magic_effects; //Makes things like the invisibility spell work.
-	Stat(Sint32 sprite);
+
+	// cached results of statGetSTR() etc. and AC(). an entry is only reused within the tick it was computed in,
+	// for the same entity, base value and hunger, while EFFECTS[] and EFFECTS_TIMERS[] are unchanged.
+	// invalidateDerivedStats() drops all entries early, for equipment changes.
+	enum DerivedStatTypes : int
+	{
+		DERIVED_STR,
+		DERIVED_DEX,
+		DERIVED_CON,
+		DERIVED_INT,
+		DERIVED_PER,
+		DERIVED_CHR,
+		DERIVED_AC,
+		NUM_DERIVED_STATS
+	};
+	struct DerivedStatCache
+	{
+		bool valid = false;
+		Uint32 tick = 0;
+		Entity* entity = nullptr;
+		Sint32 base = 0;
+		Sint32 hunger = 0;
+		Uint32 effectsVersion = 0;
+		Uint32 timersVersion = 0;
+		Sint32 value = 0;
+	};
+	DerivedStatCache derivedStats[NUM_DERIVED_STATS];
+	void invalidateDerivedStats()
+	{
+		for ( int i = 0; i < NUM_DERIVED_STATS; ++i )
+		{
+			derivedStats[i].valid = false;
+		}
+	}
+	static bool debugCheckDerivedStats; // recompute on every cache hit and log any mismatch
+
+	Stat(Sint32 sprite, const StatRolls_t* rolls = nullptr);
 	~Stat();
 	void clearStats();
 	void freePlayerEquipment();
@@ -283,6 +413,6 @@ inline bool skillCapstoneUnlocked(int player, int proficiency)
 	return (stats[player]->PROFICIENCIES[proficiency] >= CAPSTONE_UNLOCK_LEVEL[proficiency]);
 }
 
-void setDefaultMonsterStats(Stat* stats, int sprite);
+void setDefaultMonsterStats(Stat* stats, int sprite, const StatRolls_t* rolls = nullptr);
 bool isMonsterStatsDefault(Stat& myStats);
 char* getSkillLangEntry(int skill);
\ No newline at end of file
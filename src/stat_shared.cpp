@@ -18,7 +18,7 @@ See LICENSE for details.
 #include "magic/magic.hpp"
 
 // Constructor
-Stat::Stat(Sint32 sprite) :
+Stat::Stat(Sint32 sprite, const StatRolls_t* statRolls) :
 	sneaking(MISC_FLAGS[1]),
 	allyItemPickup(MISC_FLAGS[2]),
 	allyClass(MISC_FLAGS[3]),
@@ -39,14 +39,17 @@ Stat::Stat(Sint32 sprite) :
 	monsterNoDropItems(MISC_FLAGS[19]),
 	monsterForceAllegiance(MISC_FLAGS[20])
 {
+	const StatRolls_t defaultRolls;
+	const StatRolls_t& rolls = statRolls ? *statRolls : defaultRolls;
+
 	this->type = NOTHING;
 	strcpy(this->name, "");
-	strcpy(this->obituary, language[1500]);
+	strcpy(this->obituary, rolls.obituary ? rolls.obituary : language[1500]);
 	this->defending = false;
 	this->poisonKiller = 0;
 	this->burningInflictedBy = 0;
 	this->bleedInflictedBy = 0;
-	this->sex = static_cast<sex_t>(rand() % 2);
+	this->sex = static_cast<sex_t>(rolls.roll() % 2);
 	this->appearance = 0;
 	this->HP = 10;
 	this->MAXHP = 10;
@@ -128,6 +131,7 @@ Stat::Stat(Sint32 sprite) :
 	this->stache_y2 = 0;
 	this->inventory.first = NULL;
 	this->inventory.last = NULL;
+	this->inventory.flags = 0;
 	this->helmet = NULL;
 	this->breastplate = NULL;
 	this->gloves = NULL;
@@ -147,18 +151,20 @@ Stat::Stat(Sint32 sprite) :
 
 	if ( multiplayer != CLIENT )
 	{
-		setDefaultMonsterStats(this, (int)sprite);
+		setDefaultMonsterStats(this, (int)sprite, statRolls);
 	}
 }
 
-void setDefaultMonsterStats(Stat* stats, int sprite)
+void setDefaultMonsterStats(Stat* stats, int sprite, const StatRolls_t* statRolls)
 {
+	const StatRolls_t defaultRolls;
+	const StatRolls_t& rolls = statRolls ? *statRolls : defaultRolls;
 	switch ( sprite )
 	{
 		case 70:
 		case (1000 + GNOME):
 			stats->type = GNOME;
-			stats->sex = static_cast<sex_t>(rand() % 2);
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
 			stats->appearance = 0;
 			stats->HP = 50;
 			stats->MAXHP = 50;
@@ -200,8 +206,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 71:
 		case (1000 + DEVIL):
 			stats->type = DEVIL;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			strcpy(stats->name, "Baphomet");
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
@@ -231,7 +237,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + LICH):
 			stats->type = LICH;
 			stats->sex = MALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			strcpy(stats->name, "Baron Herx");
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
@@ -256,8 +262,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 48:
 		case (1000 + SPIDER):
 			stats->type = SPIDER;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 50;
@@ -280,8 +286,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 36:
 		case (1000 + GOBLIN):
 			stats->type = GOBLIN;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 60;
@@ -297,7 +303,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 			stats->CHR = -1;
 			stats->EXP = 0;
 			stats->LVL = 6;
-			if ( rand() % 3 == 0 )
+			if ( rolls.roll() % 3 == 0 )
 			{
 				stats->GOLD = 10;
 				stats->RANDOM_GOLD = 20;
@@ -327,7 +333,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + SHOPKEEPER):
 			stats->type = SHOPKEEPER;
 			stats->sex = MALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 300;
@@ -361,8 +367,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 30:
 		case (1000 + TROLL):
 			stats->type = TROLL;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 100;
@@ -391,8 +397,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 27:
 		case (1000 + HUMAN):
 			stats->type = HUMAN;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand() % 18; //NUMAPPEARANCES = 18
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll() % 18; //NUMAPPEARANCES = 18
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 30;
@@ -418,7 +424,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 			stats->RANDOM_CHR = 3;
 			stats->EXP = 0;
 			stats->LVL = 3;
-			if ( rand() % 2 == 0 )
+			if ( rolls.roll() % 2 == 0 )
 			{
 				stats->GOLD = 20;
 				stats->RANDOM_GOLD = 20;
@@ -448,7 +454,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 84:
 		case (1000 + KOBOLD):
 			stats->type = KOBOLD;
-			stats->sex = static_cast<sex_t>(rand() % 2);
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
 			stats->appearance = 0;
 
 			stats->HP = 100;
@@ -496,8 +502,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 85:
 		case (1000 + SCARAB):
 			stats->type = SCARAB;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 60;
@@ -526,7 +532,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 86:
 		case (1000 + CRYSTALGOLEM):
 			stats->type = CRYSTALGOLEM;
-			stats->sex = static_cast<sex_t>(rand() % 2);
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
 			stats->appearance = 0;
 
 			stats->HP = 200;
@@ -566,7 +572,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + INCUBUS):
 			stats->type = INCUBUS;
 			stats->sex = sex_t::MALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
 			stats->MAXHP = 280;
@@ -618,7 +624,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + VAMPIRE):
 			stats->type = VAMPIRE;
 			stats->sex = MALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
 			stats->HP = 400;
@@ -675,10 +681,10 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 			stats->type = SHADOW;
 			stats->RANDOM_MAXHP = stats->RANDOM_HP;
 			stats->RANDOM_MAXMP = stats->RANDOM_MP;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
-			stats->sex = static_cast<sex_t>(rand() % 2);
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
 			stats->MAXHP = 170;
 			stats->HP = stats->MAXHP;
 			stats->MAXMP = 500;
@@ -713,7 +719,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 90:
 		case (1000 + COCKATRICE):
 			stats->type = COCKATRICE;
-			stats->sex = static_cast<sex_t>(rand() % 2);
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
 			stats->appearance = 0;
 
 			stats->HP = 500;
@@ -754,8 +760,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 91:
 		case (1000 + INSECTOID):
 			stats->type = INSECTOID;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
 			stats->MAXHP = 130;
@@ -809,8 +815,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 92:
 		case (1000 + GOATMAN):
 			stats->type = GOATMAN;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
 			stats->MAXHP = 220;
@@ -831,7 +837,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 			stats->CHR = -1;
 			stats->EXP = 0;
 			stats->LVL = 25;
-			if ( rand() % 3 > 0 )
+			if ( rolls.roll() % 3 > 0 )
 			{
 				stats->GOLD = 100;
 				stats->RANDOM_GOLD = 50;
@@ -865,8 +871,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 93:
 		case (1000 + AUTOMATON):
 			stats->type = AUTOMATON;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
 			stats->MAXHP = 115;
@@ -899,7 +905,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + LICH_ICE):
 			stats->type = LICH_ICE;
 			stats->sex = FEMALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			strcpy(stats->name, "Erudyce");
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
@@ -927,7 +933,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + LICH_FIRE):
 			stats->type = LICH_FIRE;
 			stats->sex = MALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			strcpy(stats->name, "Orpheus");
 			stats->inventory.first = nullptr;
 			stats->inventory.last = nullptr;
@@ -954,8 +960,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 83:
 		case (1000 + SKELETON):
 			stats->type = SKELETON;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->HP = 40;
 			stats->MAXHP = 40;
 			stats->MP = 30;
@@ -988,8 +994,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 75:
 		case (1000 + DEMON):
 			stats->type = DEMON;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 120;
@@ -1014,8 +1020,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 76:
 		case (1000 + CREATURE_IMP):
 			stats->type = CREATURE_IMP;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 80;
@@ -1031,7 +1037,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 			stats->CHR = -3;
 			stats->EXP = 0;
 			stats->LVL = 14;
-			if ( rand() % 10 )
+			if ( rolls.roll() % 10 )
 			{
 				stats->GOLD = 0;
 				stats->RANDOM_GOLD = 0;
@@ -1053,7 +1059,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + MINOTAUR):
 			stats->type = MINOTAUR;
 			stats->sex = MALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 400;
@@ -1078,8 +1084,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 78:
 		case (1000 + SCORPION):
 			stats->type = SCORPION;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 70;
@@ -1101,8 +1107,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 79:
 		case (1000 + SLIME):
 			stats->type = SLIME;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			if ( stats->LVL >= 7 )   // blue slime
@@ -1135,7 +1141,7 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case (1000 + SUCCUBUS):
 			stats->type = SUCCUBUS;
 			stats->sex = FEMALE;
-			stats->appearance = rand();
+			stats->appearance = rolls.roll();
 			stats->HP = 60;
 			stats->MAXHP = 60;
 			stats->MP = 40;
@@ -1161,8 +1167,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 81:
 		case (1000 + RAT):
 			stats->type = RAT;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 30;
@@ -1187,8 +1193,8 @@ void setDefaultMonsterStats(Stat* stats, int sprite)
 		case 82:
 		case (1000 + GHOUL):
 			stats->type = GHOUL;
-			stats->sex = static_cast<sex_t>(rand() % 2);
-			stats->appearance = rand();
+			stats->sex = static_cast<sex_t>(rolls.roll() % 2);
+			stats->appearance = rolls.roll();
 			stats->inventory.first = NULL;
 			stats->inventory.last = NULL;
 			stats->HP = 90;
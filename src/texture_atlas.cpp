@@ -0,0 +1,414 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: texture_atlas.cpp
+Desc: packs sprites, tiles and item icons into shared textures
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include "main.hpp"
+#include "files.hpp"
+#include "texture_atlas.hpp"
+#include "hud_cache.hpp"
+
+#include <algorithm>
+
+TextureAtlasHandler TextureAtlas;
+const int TextureAtlasHandler::kMaxPageSize;
+const int TextureAtlasHandler::kPadding;
+
+static void uploadTexture(GLuint texture, int w, int h, const void* pixels, GLint wrap)
+{
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+void TextureAtlasHandler::add(SDL_Surface** owner, const char* filename, bool keepPixels)
+{
+	if ( !owner || !(*owner) || !filename )
+	{
+		return;
+	}
+	Entry_t entry;
+	entry.owner = owner;
+	entry.surface = *owner;
+	entry.slot = (*owner)->refcount;
+	entry.surfaceIndex = imgref - 1; // loadImage() just filled this slot
+	entry.filename = filename;
+	entry.keepPixels = keepPixels;
+	entries.push_back(entry);
+}
+
+void TextureAtlasHandler::remove(SDL_Surface** owner)
+{
+	if ( !owner )
+	{
+		return;
+	}
+	for ( Entry_t& entry : entries )
+	{
+		if ( entry.owner == owner )
+		{
+			entry.owner = nullptr;
+		}
+	}
+}
+
+bool TextureAtlasHandler::isCurrent(const Entry_t& entry) const
+{
+	return entry.owner && *entry.owner == entry.surface;
+}
+
+int TextureAtlasHandler::pageSize() const
+{
+	GLint maxSize = 0;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+	if ( maxSize <= 0 )
+	{
+		return kMaxPageSize;
+	}
+	return std::min(static_cast<int>(maxSize), kMaxPageSize);
+}
+
+/*-------------------------------------------------------------------------------
+
+	TextureAtlasHandler::build
+
+	packs the images added since the last build into new pages. images
+	are sorted tallest first and laid out in shelves, each one surrounded
+	by a copy of its edge pixels so filtering at the border never picks up
+	a neighbour.
+
+-------------------------------------------------------------------------------*/
+
+void TextureAtlasHandler::build()
+{
+	if ( headless || firstPending >= entries.size() )
+	{
+		firstPending = entries.size();
+		return;
+	}
+
+	const int size = pageSize();
+	std::vector<size_t> order;
+	for ( size_t c = firstPending; c < entries.size(); ++c )
+	{
+		const Entry_t& entry = entries[c];
+		if ( !isCurrent(entry) || entry.slot <= 0 || entry.slot >= MAXTEXTURES )
+		{
+			continue;
+		}
+		if ( entry.surface->w + kPadding * 2 > size || entry.surface->h + kPadding * 2 > size )
+		{
+			continue; // keeps its own texture
+		}
+		order.push_back(c);
+	}
+	firstPending = entries.size();
+	if ( order.empty() )
+	{
+		return;
+	}
+	HudCache.invalidate(); // cached widgets may hold the old regions
+
+	size_t firstPage = pages.size();
+	pack(order);
+	for ( size_t p = firstPage; p < pages.size(); ++p )
+	{
+		uploadPage(p);
+	}
+	for ( size_t c : order )
+	{
+		if ( !entries[c].keepPixels )
+		{
+			releasePixels(entries[c]);
+		}
+	}
+	logStatus();
+}
+
+void TextureAtlasHandler::pack(std::vector<size_t>& order)
+{
+	std::sort(order.begin(), order.end(), [this](size_t lhs, size_t rhs) {
+		const SDL_Surface* a = entries[lhs].surface;
+		const SDL_Surface* b = entries[rhs].surface;
+		if ( a->h != b->h )
+		{
+			return a->h > b->h;
+		}
+		return a->w > b->w;
+	});
+
+	const int size = pageSize();
+	int cursorX = 0;
+	int shelfY = 0;
+	int shelfHeight = 0;
+	Page_t page;
+	page.width = size;
+	pages.push_back(page);
+	for ( size_t c : order )
+	{
+		Entry_t& entry = entries[c];
+		const int w = entry.surface->w + kPadding * 2;
+		const int h = entry.surface->h + kPadding * 2;
+		if ( cursorX + w > size )
+		{
+			shelfY += shelfHeight;
+			cursorX = 0;
+			shelfHeight = 0;
+		}
+		if ( shelfY + h > size )
+		{
+			pages.back().height = shelfY;
+			pages.push_back(page);
+			cursorX = 0;
+			shelfY = 0;
+			shelfHeight = 0;
+		}
+		entry.page = static_cast<int>(pages.size()) - 1;
+		entry.x = cursorX + kPadding;
+		entry.y = shelfY + kPadding;
+		cursorX += w;
+		shelfHeight = std::max(shelfHeight, h);
+	}
+	pages.back().height = shelfY + shelfHeight;
+}
+
+SDL_Surface* TextureAtlasHandler::loadPixels(const Entry_t& entry)
+{
+	if ( entry.surface && entry.surface->pixels )
+	{
+		return entry.surface;
+	}
+
+	// same conversion as loadImage(), without taking a texture slot
+	char full_path[PATH_MAX];
+	completePath(full_path, entry.filename.c_str());
+	SDL_Surface* originalSurface = IMG_Load(full_path);
+	if ( !originalSurface )
+	{
+		printlog("[ATLAS]: failed to reload image '%s'", full_path);
+		return nullptr;
+	}
+	SDL_Surface* newSurface = SDL_CreateRGBSurface(0, originalSurface->w, originalSurface->h, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+	SDL_BlitSurface(originalSurface, NULL, newSurface, NULL);
+	SDL_FreeSurface(originalSurface);
+	return newSurface;
+}
+
+void TextureAtlasHandler::uploadPage(size_t pageIndex)
+{
+	Page_t& page = pages[pageIndex];
+	std::vector<Uint8> pixels(static_cast<size_t>(page.width) * page.height * 4, 0);
+	const size_t pageStride = static_cast<size_t>(page.width) * 4;
+
+	for ( Entry_t& entry : entries )
+	{
+		if ( entry.page != static_cast<int>(pageIndex) || !isCurrent(entry) )
+		{
+			continue;
+		}
+		SDL_Surface* image = loadPixels(entry);
+		if ( !image )
+		{
+			continue;
+		}
+		if ( image->w != entry.surface->w || image->h != entry.surface->h )
+		{
+			// the file changed size under us, leave the cell blank
+			printlog("[ATLAS]: image '%s' changed size, not repacked", entry.filename.c_str());
+		}
+		else
+		{
+			SDL_LockSurface(image);
+			const int w = image->w;
+			const int h = image->h;
+			for ( int row = -kPadding; row < h + kPadding; ++row )
+			{
+				const int srcRow = std::min(std::max(row, 0), h - 1);
+				const Uint8* src = static_cast<const Uint8*>(image->pixels) + srcRow * image->pitch;
+				Uint8* dest = &pixels[(entry.y + row) * pageStride + entry.x * 4];
+				memcpy(dest, src, w * 4);
+				for ( int pad = 1; pad <= kPadding; ++pad )
+				{
+					memcpy(dest - pad * 4, src, 4);
+					memcpy(dest + (w - 1 + pad) * 4, src + (w - 1) * 4, 4);
+				}
+			}
+			SDL_UnlockSurface(image);
+		}
+		if ( image != entry.surface )
+		{
+			SDL_FreeSurface(image);
+		}
+	}
+
+	if ( !page.texture )
+	{
+		glGenTextures(1, &page.texture);
+	}
+	uploadTexture(page.texture, page.width, page.height, pixels.data(), GL_CLAMP_TO_EDGE);
+
+	// point the images at their page
+	for ( Entry_t& entry : entries )
+	{
+		if ( entry.page != static_cast<int>(pageIndex) || !isCurrent(entry) )
+		{
+			continue;
+		}
+		if ( entry.slot >= static_cast<int>(regions.size()) )
+		{
+			regions.resize(entry.slot + 1);
+		}
+		Region_t& region = regions[entry.slot];
+		region.u0 = entry.x / static_cast<GLfloat>(page.width);
+		region.v0 = entry.y / static_cast<GLfloat>(page.height);
+		region.u1 = (entry.x + entry.surface->w) / static_cast<GLfloat>(page.width);
+		region.v1 = (entry.y + entry.surface->h) / static_cast<GLfloat>(page.height);
+		if ( texid[entry.slot] != page.texture )
+		{
+			glDeleteTextures(1, &texid[entry.slot]);
+			texid[entry.slot] = page.texture;
+		}
+	}
+}
+
+void TextureAtlasHandler::releasePixels(Entry_t& entry)
+{
+	SDL_Surface* full = *entry.owner;
+	SDL_Surface* header = SDL_CreateRGBSurfaceFrom(nullptr, full->w, full->h, 32, full->w * 4, 0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
+	if ( !header )
+	{
+		return;
+	}
+	header->refcount = full->refcount;
+	releasedBytes += static_cast<size_t>(full->pitch) * full->h;
+
+	*entry.owner = header;
+	if ( entry.surfaceIndex >= 0 && entry.surfaceIndex < MAXTEXTURES && allsurfaces[entry.surfaceIndex] == full )
+	{
+		allsurfaces[entry.surfaceIndex] = header;
+	}
+	entry.surface = header;
+
+	full->refcount = 1; // refcount is doubling as the texture slot
+	SDL_FreeSurface(full);
+}
+
+/*-------------------------------------------------------------------------------
+
+	TextureAtlasHandler::rebuild
+
+	the old context took the pages with it. every page is generated again
+	with the same layout so the regions don't move, reading the released
+	images back from disk.
+
+-------------------------------------------------------------------------------*/
+
+void TextureAtlasHandler::rebuild()
+{
+	if ( headless )
+	{
+		return;
+	}
+	repeating.clear();
+	for ( size_t p = 0; p < pages.size(); ++p )
+	{
+		pages[p].texture = 0;
+		uploadPage(p);
+	}
+}
+
+void TextureAtlasHandler::clear()
+{
+	if ( !headless )
+	{
+		for ( Page_t& page : pages )
+		{
+			glDeleteTextures(1, &page.texture);
+		}
+		for ( auto& it : repeating )
+		{
+			glDeleteTextures(1, &it.second);
+		}
+	}
+	entries.clear();
+	firstPending = 0;
+	pages.clear();
+	regions.clear();
+	repeating.clear();
+	releasedBytes = 0;
+	HudCache.invalidate();
+}
+
+GLuint TextureAtlasHandler::repeatingTexture(SDL_Surface* image)
+{
+	if ( !image )
+	{
+		return 0;
+	}
+	const int slot = image->refcount;
+	if ( slot < 0 || slot >= MAXTEXTURES )
+	{
+		return 0;
+	}
+	const Region_t& found = region(image);
+	if ( &found == &wholeTexture
+		|| (found.u0 == 0.f && found.v0 == 0.f && found.u1 == 1.f && found.v1 == 1.f) )
+	{
+		return texid[slot]; // not packed, already repeats
+	}
+	auto cached = repeating.find(slot);
+	if ( cached != repeating.end() )
+	{
+		return cached->second;
+	}
+
+	GLuint texture = 0;
+	for ( const Entry_t& entry : entries )
+	{
+		if ( entry.slot != slot || !isCurrent(entry) )
+		{
+			continue;
+		}
+		SDL_Surface* pixels = loadPixels(entry);
+		if ( pixels )
+		{
+			glGenTextures(1, &texture);
+			SDL_LockSurface(pixels);
+			uploadTexture(texture, pixels->w, pixels->h, pixels->pixels, GL_REPEAT);
+			SDL_UnlockSurface(pixels);
+			if ( pixels != entry.surface )
+			{
+				SDL_FreeSurface(pixels);
+			}
+		}
+		break;
+	}
+	repeating[slot] = texture;
+	return texture;
+}
+
+void TextureAtlasHandler::logStatus() const
+{
+	size_t packed = 0;
+	for ( const Entry_t& entry : entries )
+	{
+		if ( entry.page >= 0 && isCurrent(entry) )
+		{
+			++packed;
+		}
+	}
+	printlog("[ATLAS]: %d images packed into %d pages, %d KB of surface pixels released",
+		static_cast<int>(packed), static_cast<int>(pages.size()), static_cast<int>(releasedBytes / 1024));
+}
@@ -0,0 +1,113 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: texture_atlas.hpp
+Desc: header for texture_atlas.cpp (packs sprites, tiles and item icons
+	into shared textures)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*-------------------------------------------------------------------------------
+
+	TextureAtlasHandler
+
+	images registered with add() after loadImage() are packed into a few
+	large page textures by build(). each packed image keeps its surface
+	and refcount, but texid[refcount] is pointed at its page, so the
+	existing glBindTexture(texid[image->refcount]) calls bind the page and
+	consecutive draws from the same page share a bind. anything that emits
+	texture coordinates for one of these images maps them through
+	region(image), which is the whole texture for images that aren't
+	packed.
+
+	unless an image is added with keepPixels, its converted RGBA surface is
+	replaced after packing by a header-only surface of the same size. the
+	pixels are read back from disk when the GL context is recreated, see
+	rebuild(), or when a repeating copy is needed for the sky.
+
+-------------------------------------------------------------------------------*/
+
+class TextureAtlasHandler
+{
+public:
+	struct Region_t
+	{
+		GLfloat u0 = 0.f;
+		GLfloat v0 = 0.f;
+		GLfloat u1 = 1.f;
+		GLfloat v1 = 1.f;
+
+		// map a coordinate in [0,1] across the image into the page
+		GLfloat u(real_t s) const { return u0 + (u1 - u0) * s; }
+		GLfloat v(real_t t) const { return v0 + (v1 - v0) * t; }
+	};
+
+	// owner is where the game keeps the surface (sprites[c], tiles[c]...),
+	// it's repointed at the header-only surface once the pixels are dropped
+	void add(SDL_Surface** owner, const char* filename, bool keepPixels);
+	void remove(SDL_Surface** owner); // call before freeing the owner itself
+	void build(); // packs everything added since the last build
+	void rebuild(); // call after glGenTextures() for a new GL context
+	void clear();
+
+	const Region_t& region(const SDL_Surface* image) const
+	{
+		if ( image && image->refcount >= 0 && image->refcount < static_cast<int>(regions.size()) )
+		{
+			return regions[image->refcount];
+		}
+		return wholeTexture;
+	}
+
+	// texture that can be drawn with coordinates outside [0,1]
+	GLuint repeatingTexture(SDL_Surface* image);
+
+	void logStatus() const;
+private:
+	struct Entry_t
+	{
+		SDL_Surface** owner = nullptr;
+		SDL_Surface* surface = nullptr; // what *owner held when packed, to spot mod reloads
+		int slot = 0; // refcount, index into texid[] and regions
+		int surfaceIndex = 0; // index into allsurfaces[]
+		std::string filename;
+		bool keepPixels = false;
+		int page = -1;
+		int x = 0;
+		int y = 0;
+	};
+	struct Page_t
+	{
+		GLuint texture = 0;
+		int width = 0;
+		int height = 0;
+	};
+
+	static const int kMaxPageSize = 2048;
+	static const int kPadding = 1; // edge pixels repeated around each image
+
+	std::vector<Entry_t> entries;
+	size_t firstPending = 0;
+	std::vector<Page_t> pages;
+	std::vector<Region_t> regions;
+	std::unordered_map<int, GLuint> repeating; // slot -> standalone texture
+	Region_t wholeTexture;
+	size_t releasedBytes = 0;
+
+	bool isCurrent(const Entry_t& entry) const;
+	int pageSize() const;
+	SDL_Surface* loadPixels(const Entry_t& entry); // caller frees if != entry.surface
+	void pack(std::vector<size_t>& order);
+	void uploadPage(size_t pageIndex);
+	void releasePixels(Entry_t& entry);
+};
+extern TextureAtlasHandler TextureAtlas;
@@ -0,0 +1,297 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: vismap.cpp
+Desc: one bit per map tile for what the current view can see
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#include <chrono>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISMAP_SSE2
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+#include "main.hpp"
+#include "vismap.hpp"
+
+static VisibilityMap viewVismaps[MAXPLAYERS + 1];
+
+VisibilityMap& viewVismap(const view_t* camera)
+{
+	for ( int c = 0; c < MAXPLAYERS; ++c )
+	{
+		if ( &cameras[c] == camera )
+		{
+			return viewVismaps[c];
+		}
+	}
+	return viewVismaps[MAXPLAYERS];
+}
+
+// index of the lowest set bit, bits must not be 0
+static inline int lowestBit(Uint64 bits)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, bits);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctzll(bits);
+#endif
+}
+
+void VisibilityMap::resize(Uint32 width, Uint32 height)
+{
+	this->width = width;
+	this->height = height;
+	rowWords = (height + 63) / 64;
+	words.assign(static_cast<size_t>(width) * rowWords, 0);
+}
+
+void VisibilityMap::clear()
+{
+	if ( !words.empty() )
+	{
+		memset(words.data(), 0, words.size() * sizeof(Uint64));
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	VisibilityMap::merge
+
+	ORs two 64 bit words per step with SSE2 or NEON where the target has
+	it. maps the same size have the same row padding, so the words line up
+	one for one and the padding bits stay clear.
+
+-------------------------------------------------------------------------------*/
+
+void VisibilityMap::merge(const VisibilityMap& other)
+{
+	if ( other.width != width || other.height != height || words.empty() )
+	{
+		return;
+	}
+	Uint64* dst = words.data();
+	const Uint64* src = other.words.data();
+	const size_t count = words.size();
+	size_t i = 0;
+#if defined(VISMAP_SSE2)
+	for ( ; i + 2 <= count; i += 2 )
+	{
+		__m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+		__m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_or_si128(a, b));
+	}
+#elif defined(__ARM_NEON__)
+	for ( ; i + 2 <= count; i += 2 )
+	{
+		vst1q_u64(dst + i, vorrq_u64(vld1q_u64(dst + i), vld1q_u64(src + i)));
+	}
+#endif
+	for ( ; i < count; ++i )
+	{
+		dst[i] |= src[i];
+	}
+}
+
+/*-------------------------------------------------------------------------------
+
+	VisibilityMap::nextSpan
+
+	skips whole words of hidden tiles to the first set bit, then skips
+	whole words of visible tiles to the first clear bit after it. the bits
+	past height in each row's last word are never set, so a run can't
+	spill over the end of the row.
+
+-------------------------------------------------------------------------------*/
+
+bool VisibilityMap::nextSpan(int x, int from, int& begin, int& end) const
+{
+	if ( from >= height )
+	{
+		return false;
+	}
+	const Uint64* row = &words[x * rowWords];
+	int word = from >> 6;
+	Uint64 bits = row[word] & (~static_cast<Uint64>(0) << (from & 63));
+	while ( !bits )
+	{
+		if ( ++word >= rowWords )
+		{
+			return false;
+		}
+		bits = row[word];
+	}
+	begin = word * 64 + lowestBit(bits);
+
+	bits = ~row[word] & (~static_cast<Uint64>(0) << (begin & 63));
+	while ( !bits )
+	{
+		if ( ++word >= rowWords )
+		{
+			end = height;
+			return true;
+		}
+		bits = ~row[word];
+	}
+	end = std::min(word * 64 + lowestBit(bits), height);
+	return true;
+}
+
+/*-------------------------------------------------------------------------------
+
+	VisibilityMap::benchmark
+
+	each simulated frame clears the map, marks what a view down a few
+	corridors might see, then visits every visible tile the way
+	glDrawWorld() does. the bool array is how vismap used to be stored.
+	then both are timed merging in the other views of a 4 player
+	split-screen frame and checked against each other.
+
+-------------------------------------------------------------------------------*/
+
+void VisibilityMap::benchmark(int iterations)
+{
+	auto timeMs = [](std::chrono::high_resolution_clock::time_point t1, std::chrono::high_resolution_clock::time_point t2)
+	{
+		return 1000.0 * std::chrono::duration_cast<std::chrono::duration<double>>(t2 - t1).count();
+	};
+
+	const int sizes[] = { 64, 256 };
+	for ( int size : sizes )
+	{
+		// simple lcg so the benchmark doesn't advance the game's rand().
+		// each x gets one run of visible tiles, about a third of the level
+		std::vector<std::pair<int, int>> runs(size);
+		Uint32 seed = 12345;
+		for ( auto& run : runs )
+		{
+			seed = seed * 1103515245 + 12345;
+			run.first = (seed >> 8) % size;
+			seed = seed * 1103515245 + 12345;
+			run.second = std::min(size, run.first + static_cast<int>((seed >> 8) % (size * 2 / 3 + 1)));
+		}
+
+		bool* tiles = static_cast<bool*>(malloc(sizeof(bool) * size * size));
+		VisibilityMap bits;
+		bits.resize(size, size);
+		Uint64 checksum[2] = { 0, 0 };
+
+		auto t1 = std::chrono::high_resolution_clock::now();
+		for ( int c = 0; c < iterations; ++c )
+		{
+			for ( int i = 0; i < size * size; ++i )
+			{
+				tiles[i] = false;
+			}
+			for ( int x = 0; x < size; ++x )
+			{
+				for ( int y = runs[x].first; y < runs[x].second; ++y )
+				{
+					tiles[y + x * size] = true;
+				}
+			}
+			for ( int x = 0; x < size; ++x )
+			{
+				for ( int y = 0; y < size; ++y )
+				{
+					if ( tiles[y + x * size] )
+					{
+						checksum[0] += x + y;
+					}
+				}
+			}
+		}
+		auto t2 = std::chrono::high_resolution_clock::now();
+		for ( int c = 0; c < iterations; ++c )
+		{
+			bits.clear();
+			for ( int x = 0; x < size; ++x )
+			{
+				for ( int y = runs[x].first; y < runs[x].second; ++y )
+				{
+					bits.set(x, y);
+				}
+			}
+			for ( int x = 0; x < size; ++x )
+			{
+				int begin, end;
+				for ( int from = 0; bits.nextSpan(x, from, begin, end); from = end )
+				{
+					for ( int y = begin; y < end; ++y )
+					{
+						checksum[1] += x + y;
+					}
+				}
+			}
+		}
+		auto t3 = std::chrono::high_resolution_clock::now();
+
+		// the other three views of a 4 player split-screen frame, merged into the first
+		bool* viewTiles = static_cast<bool*>(malloc(sizeof(bool) * size * size));
+		VisibilityMap viewBits;
+		viewBits.resize(size, size);
+		for ( int x = 0; x < size; ++x )
+		{
+			for ( int y = 0; y < size; ++y )
+			{
+				viewTiles[y + x * size] = (x + y) % 3 == 0;
+				if ( viewTiles[y + x * size] )
+				{
+					viewBits.set(x, y);
+				}
+			}
+		}
+		auto t4 = std::chrono::high_resolution_clock::now();
+		for ( int c = 0; c < iterations; ++c )
+		{
+			for ( int view = 1; view < 4; ++view )
+			{
+				for ( int i = 0; i < size * size; ++i )
+				{
+					tiles[i] = tiles[i] || viewTiles[i];
+				}
+			}
+		}
+		auto t5 = std::chrono::high_resolution_clock::now();
+		for ( int c = 0; c < iterations; ++c )
+		{
+			for ( int view = 1; view < 4; ++view )
+			{
+				bits.merge(viewBits);
+			}
+		}
+		auto t6 = std::chrono::high_resolution_clock::now();
+		for ( int x = 0; x < size; ++x )
+		{
+			for ( int y = 0; y < size; ++y )
+			{
+				if ( tiles[y + x * size] != bits.test(x, y) )
+				{
+					checksum[0] = ~checksum[1];
+				}
+			}
+		}
+
+		printlog("[VISMAP BENCHMARK]: %dx%d, %d frames", size, size, iterations);
+		printlog("[VISMAP BENCHMARK]: bool per tile: %.3fms (%d bytes), bit per tile: %.3fms (%d bytes)",
+			timeMs(t1, t2), size * size, timeMs(t2, t3), static_cast<int>(bits.words.size() * sizeof(Uint64)));
+		printlog("[VISMAP BENCHMARK]: merging 3 views, bool per tile: %.3fms, bit per tile: %.3fms",
+			timeMs(t4, t5), timeMs(t5, t6));
+		if ( checksum[0] != checksum[1] )
+		{
+			printlog("[VISMAP BENCHMARK]: error: results did not match!");
+		}
+		free(viewTiles);
+		free(tiles);
+	}
+}
@@ -0,0 +1,71 @@
+/*-------------------------------------------------------------------------------
+
+BARONY
+File: vismap.hpp
+Desc: header for vismap.cpp (which map tiles the current view can see)
+
+Copyright 2013-2021 (c) Turning Wheel LLC, all rights reserved.
+See LICENSE for details.
+
+-------------------------------------------------------------------------------*/
+
+#pragma once
+
+#include <vector>
+
+/*-------------------------------------------------------------------------------
+
+	VisibilityMap
+
+	one bit per map tile for the tiles a view can see. tiles are laid out
+	x-major like map.tiles, so y runs along a row of bits and each x starts
+	on a fresh 64 bit word. that lets clear() be a single memset, lets
+	merge() OR two maps a vector at a time, and lets glDrawWorld() jump from
+	one run of visible tiles to the next a word at a time instead of
+	testing every tile in the level.
+
+	raycast() fills the map of the view it's casting for (see viewVismap()).
+	glDrawWorld() and drawEntities3D() merge it into vismap, which
+	drawClearBuffers() clears once a frame, so in split-screen each view
+	draws what it and the views drawn before it this frame can see.
+
+-------------------------------------------------------------------------------*/
+
+class VisibilityMap
+{
+public:
+	// sizes the map for a level and clears it
+	void resize(Uint32 width, Uint32 height);
+	void clear();
+	// ORs in the tiles of another map the same size. does nothing if the
+	// sizes differ, i.e. the other map hasn't been filled since the level changed
+	void merge(const VisibilityMap& other);
+
+	void set(int x, int y)
+	{
+		words[x * rowWords + (y >> 6)] |= static_cast<Uint64>(1) << (y & 63);
+	}
+	bool test(int x, int y) const
+	{
+		return (words[x * rowWords + (y >> 6)] >> (y & 63)) & 1;
+	}
+
+	// finds the first run of visible tiles in row x at or after y = from.
+	// the run is [begin, end). returns false if the rest of the row is hidden
+	bool nextSpan(int x, int from, int& begin, int& end) const;
+
+	// times clearing, filling and walking a bool per tile against this, and
+	// merging split-screen views, for 64x64 and 256x256 levels
+	// @param iterations number of simulated frames per size
+	static void benchmark(int iterations);
+private:
+	std::vector<Uint64> words;
+	int width = 0;
+	int height = 0;
+	int rowWords = 0; // words per x
+};
+extern VisibilityMap vismap; // every view drawn so far this frame
+
+// the map raycast() fills for a view: one for each of cameras[], and one
+// shared by any other view (the editor's and the title screen's)
+VisibilityMap& viewVismap(const view_t* camera);